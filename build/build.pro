@@ -51,11 +51,16 @@ SOURCES += \
     $$PWD/../src/plugin/exchange/exchangeinterface.cpp \
     $$PWD/../src/plugin/exchange/exchangesimpleascii.cpp \
     $$PWD/../src/plugin/function/function.cpp \
+    $$PWD/../src/plugin/function/robustfit.cpp \
     $$PWD/../src/plugin/sensor/sensor.cpp \
     $$PWD/../src/plugin/sensor/sensorfacade.cpp \
+    $$PWD/../src/plugin/sensor/simulatedsensor.cpp \
     $$PWD/../src/plugin/simulation/simulationmodel.cpp \
     $$PWD/../src/plugin/tool/tool.cpp \
+    $$PWD/../src/util/readingconversion.cpp \
     $$PWD/../src/util/util.cpp \
+    $$PWD/../src/acquisitionmanager.cpp \
+    $$PWD/../src/confighandle.cpp \
     $$PWD/../src/coordinatesystem.cpp \
     $$PWD/../src/direction.cpp \
     $$PWD/../src/element.cpp \
@@ -65,12 +70,16 @@ SOURCES += \
     $$PWD/../src/geometry.cpp \
     $$PWD/../src/measurementconfig.cpp \
     $$PWD/../src/observation.cpp \
+    $$PWD/../src/observationsidecar.cpp \
+    $$PWD/../src/observationstore.cpp \
     $$PWD/../src/oijob.cpp \
     $$PWD/../src/position.cpp \
     $$PWD/../src/radius.cpp \
     $$PWD/../src/reading.cpp \
+    $$PWD/../src/recalcscheduler.cpp \
     $$PWD/../src/sensorconfiguration.cpp \
     $$PWD/../src/sensorcontrol.cpp \
+    $$PWD/../src/sensorstream.cpp \
     $$PWD/../src/sensorworker.cpp \
     $$PWD/../src/sensorworkermessage.cpp \
     $$PWD/../src/station.cpp \
@@ -110,16 +119,23 @@ HEADERS  += \
     $$PWD/../include/plugin/function/generatefeaturefunction.h \
     $$PWD/../include/plugin/function/geodeticfunction.h \
     $$PWD/../include/plugin/function/objecttransformation.h \
+    $$PWD/../include/plugin/function/robustfit.h \
     $$PWD/../include/plugin/function/systemtransformation.h \
     $$PWD/../include/plugin/function/specialfunction.h \
     $$PWD/../include/plugin/sensor/lasertracker.h \
     $$PWD/../include/plugin/sensor/sensor.h \
     $$PWD/../include/plugin/sensor/sensorfacade.h \
+    $$PWD/../include/plugin/sensor/simulatedsensor.h \
     $$PWD/../include/plugin/sensor/totalstation.h \
     $$PWD/../include/plugin/simulation/simulationmodel.h \
     $$PWD/../include/plugin/tool/tool.h \
+    $$PWD/../include/util/fixedmath.h \
+    $$PWD/../include/util/indexedlist.h \
+    $$PWD/../include/util/readingconversion.h \
     $$PWD/../include/util/types.h \
     $$PWD/../include/util/util.h \
+    $$PWD/../include/acquisitionmanager.h \
+    $$PWD/../include/confighandle.h \
     $$PWD/../include/coordinatesystem.h \
     $$PWD/../include/direction.h \
     $$PWD/../include/element.h \
@@ -130,13 +146,18 @@ HEADERS  += \
     $$PWD/../include/geometry.h \
     $$PWD/../include/measurementconfig.h \
     $$PWD/../include/observation.h \
+    $$PWD/../include/observationsidecar.h \
+    $$PWD/../include/observationstore.h \
     $$PWD/../include/oijob.h \
     $$PWD/../include/oirequestresponse.h \
     $$PWD/../include/position.h \
     $$PWD/../include/radius.h \
     $$PWD/../include/reading.h \
+    $$PWD/../include/recalcscheduler.h \
     $$PWD/../include/sensorconfiguration.h \
     $$PWD/../include/sensorcontrol.h \
+    $$PWD/../include/sensorstate.h \
+    $$PWD/../include/sensorstream.h \
     $$PWD/../include/sensorworker.h \
     $$PWD/../include/sensorworkermessage.h \
     $$PWD/../include/station.h \
@@ -0,0 +1,126 @@
+#ifndef ACQUISITIONMANAGER_H
+#define ACQUISITIONMANAGER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QThread>
+#include <QTimer>
+#include <QList>
+
+#include "oijob.h"
+#include "station.h"
+#include "reading.h"
+
+namespace oi{
+
+/*!
+ * \brief The AcquisitionResult class
+ * Readings of one measurement of a station that wait to be added to the job
+ */
+class OI_CORE_EXPORT AcquisitionResult{
+public:
+    AcquisitionResult() : geomId(-1), acquisitionTime(0){}
+
+    QPointer<Station> station;
+    int geomId;
+    QList<QPointer<Reading> > readings;
+    qint64 acquisitionTime; //[ns] earliest acquisition time of the readings (see AcquisitionClock)
+};
+
+/*!
+ * \brief The AcquisitionQueue class
+ * Owns the sensor thread of one station and queues the measurement results of that station
+ */
+class OI_CORE_EXPORT AcquisitionQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    AcquisitionQueue(const QPointer<Station> &station, QObject *parent = 0);
+
+    ~AcquisitionQueue();
+
+    const QPointer<Station> &getStation() const;
+    QThread &getThread();
+
+    QList<AcquisitionResult> takeResults();
+    int getNumResults() const;
+
+signals:
+
+    //emitted when the queue is no longer empty
+    void resultsAvailable();
+
+public slots:
+    void addResults(int geomId, QList<QPointer<Reading> > readings);
+
+private slots:
+    void stationDestroyed();
+
+private:
+    QPointer<Station> station;
+    QThread thread;
+
+    QList<AcquisitionResult> results; //only accessed in the thread of the queue
+
+};
+
+/*!
+ * \brief The AcquisitionManager class
+ * Lets several stations measure at the same time. Each station gets its own sensor thread with an event loop,
+ * the results of all stations are queued and added to the job in batches ordered by their acquisition time.
+ * The manager lives in the thread of the job (usually the GUI thread) and never waits for a sensor.
+ */
+class OI_CORE_EXPORT AcquisitionManager : public QObject
+{
+    Q_OBJECT
+
+public:
+    AcquisitionManager(const QPointer<OiJob> &job, QObject *parent = 0);
+
+    ~AcquisitionManager();
+
+    //######################
+    //add or remove stations
+    //######################
+
+    bool addStation(const QPointer<Station> &station);
+    void removeStation(const QPointer<Station> &station);
+
+    QList<QPointer<Station> > getStations() const;
+    bool hasStation(const QPointer<Station> &station) const;
+
+    //#############################
+    //get or set the merge interval
+    //#############################
+
+    int getMergeInterval() const;
+    void setMergeInterval(const int &interval);
+
+    int getNumPendingResults() const;
+
+signals:
+
+    //emitted after a batch of results was added to the job
+    void resultsMerged(int numResults, int numReadings);
+
+public slots:
+    void mergeResults();
+
+private slots:
+    void scheduleMerge();
+
+private:
+    int getQueueIndex(const QPointer<Station> &station) const;
+
+    QPointer<OiJob> job;
+
+    QList<AcquisitionQueue *> queues;
+
+    QTimer mergeTimer;
+
+};
+
+}
+
+#endif // ACQUISITIONMANAGER_H
@@ -0,0 +1,49 @@
+#ifndef CONFIGHANDLE_H
+#define CONFIGHANDLE_H
+
+#include <QSharedPointer>
+
+#include "measurementconfig.h"
+#include "sensorconfiguration.h"
+
+namespace oi{
+
+/*!
+ * \brief The ConfigHandle class
+ * Implicitly shared, immutable configuration. Configurations are interned: all handles of identical configurations
+ * refer to the same instance, so that the thousands of readings that were measured with the same configuration
+ * do not hold their own copies. A null handle refers to a default constructed configuration.
+ */
+template <class T>
+class ConfigHandle{
+public:
+    ConfigHandle();
+
+    static ConfigHandle<T> intern(const T &config);
+
+    bool getIsNull() const;
+    const T &get() const;
+
+    friend bool operator==(const ConfigHandle<T> &left, const ConfigHandle<T> &right){
+        return left.config == right.config;
+    }
+    friend bool operator!=(const ConfigHandle<T> &left, const ConfigHandle<T> &right){
+        return left.config != right.config;
+    }
+
+    static int getNumInterned();
+
+private:
+    QSharedPointer<const T> config;
+
+};
+
+typedef ConfigHandle<MeasurementConfig> MeasurementConfigHandle;
+typedef ConfigHandle<SensorConfiguration> SensorConfigurationHandle;
+
+extern template class OI_CORE_EXPORT ConfigHandle<MeasurementConfig>;
+extern template class OI_CORE_EXPORT ConfigHandle<SensorConfiguration>;
+
+}
+
+#endif // CONFIGHANDLE_H
@@ -5,10 +5,12 @@
 #include <QList>
 #include <QPointer>
 #include <QJsonObject>
+#include <QSharedPointer>
 
 #include "feature.h"
 #include "position.h"
 #include "direction.h"
+#include "observationstore.h"
 
 class TrafoController;
 class ProjectExchanger;
@@ -80,6 +82,8 @@ public:
     const QList<QPointer<Observation> > &getObservations() const;
     QPointer<Observation> getObservation(const int &observationId) const;
     bool addObservation(const QPointer<Observation> &observation);
+    int addObservations(const QList<QPointer<Observation> > &observations);
+    const QSharedPointer<ObservationStore> &getObservationStore() const;
 
     //transformation parameters
     const QList<QPointer<TrafoParam> > &getTransformationParameters() const;
@@ -115,6 +119,8 @@ public:
     QDomElement toOpenIndyXML(QDomDocument &xmlDoc);
     bool fromOpenIndyXML(QDomElement &xmlElem);
 
+    void toOpenIndyXML(QXmlStreamWriter &xmlWriter);
+
     //###############
     //display methods
     //###############
@@ -145,7 +151,8 @@ signals:
     //signals to inform about coordinate system changes
     //#################################################
 
-    void observationsChanged(const int &coordId, const int &obsId);
+    void observationsChanged(const int &coordId, const int &obsId); //emitted once per call of addObservation(s)
+    void observationsAdded(const int &coordId, const QList<int> &obsIds); //all observations added by addObservations
     void transformationParametersChanged(const int &coordId);
     void nominalsChanged(const int &coordId);
     void activeCoordinateSystemChanged(const int &coordId);
@@ -200,6 +207,7 @@ private:
     //observations
     QList< QPointer<Observation> > observationsList;
     QMap< int, QPointer<Observation> > observationsMap; //same observations but id as key
+    QSharedPointer<ObservationStore> observationStore; //coordinates and states of all observations of this station system
 
     //trafo params
     QList< QPointer<TrafoParam> > trafoParams;
@@ -5,6 +5,7 @@
 
 #include "element.h"
 #include "oivec.h"
+#include "fixedmath.h"
 
 namespace oi{
 
@@ -17,6 +18,7 @@ class OI_CORE_EXPORT Direction : public Element
 public:
     explicit Direction(QObject *parent = 0);
     explicit Direction(const OiVec &v, QObject *parent = 0);
+    explicit Direction(const Vec3 &v, QObject *parent = 0);
     explicit Direction(const double &x, const double &y, const double &z, const double &h = 1.0, QObject *parent = 0);
 
     Direction(const Direction &copy, QObject *parent = 0);
@@ -31,9 +33,11 @@ public:
 
     void setVector(const double &x, const double &y, const double &z, const double &h = 1.0);
     void setVector(const OiVec &v);
+    void setVector(const Vec3 &v);
 
     const OiVec &getVector() const;
     const OiVec &getVectorH() const;
+    Vec3 getVec3() const;
 
 private:
     OiVec ijk; //vector of size 3 (i, j, k)
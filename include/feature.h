@@ -6,6 +6,7 @@
 #include <QList>
 #include <QString>
 #include <QtXml>
+#include <QXmlStreamWriter>
 
 #include "element.h"
 
@@ -181,6 +182,13 @@ protected:
 
     virtual void setUpFeatureId();
 
+    //##############################################
+    //stream the parts of the XML shared by features
+    //##############################################
+
+    void writeOpenIndyXMLAttributes(QXmlStreamWriter &xmlWriter) const;
+    void writeOpenIndyXMLDependencies(QXmlStreamWriter &xmlWriter) const;
+
     //##################
     //feature attributes
     //##################
@@ -6,7 +6,9 @@
 #include <QList>
 #include <QStringList>
 #include <QMap>
-#include <QMultiMap>
+#include <QHash>
+#include <QSet>
+#include <QVector>
 
 #include "featurewrapper.h"
 #include "feature.h"
@@ -14,6 +16,7 @@
 #include "station.h"
 #include "trafoparam.h"
 #include "types.h"
+#include "indexedlist.h"
 
 namespace oi{
 
@@ -52,6 +55,7 @@ public:
     //getter to access features by id, name, group, type or mConfig
     QPointer<FeatureWrapper> getFeatureById(const int &featureId) const;
     QList<QPointer<FeatureWrapper> > getFeaturesByName(const QString &name, const bool startWith = false) const;
+    QStringList getFeatureNamesByPrefix(const QString &prefix) const;
     QList<QPointer<FeatureWrapper> > getFeaturesByGroup(const QString &group) const;
     QList<QPointer<FeatureWrapper> > getFeaturesByType(const FeatureTypes &type) const;
     QList<QPointer<Geometry> > getGeometriesByMConfig(const QPair<QString, bool> &mConfig) const;
@@ -72,6 +76,7 @@ public:
 
     bool addFeature(const QPointer<FeatureWrapper> &feature);
     bool removeFeature(const int &featureId);
+    bool removeFeatures(const QSet<int> &featureIds);
 
     void checkAndClean(const int &featureId, const QString &name, const QString &group, const FeatureTypes &type);
 
@@ -87,29 +92,66 @@ public:
 
 private:
 
+    //#############################
+    //slot of each feature in a job
+    //#############################
+
+    /*!
+     * \brief The FeatureSlot class
+     * Saves a feature together with the keys it is indexed with in the helper maps
+     */
+    class FeatureSlot{
+    public:
+        FeatureSlot() : id(-1), type(eUndefinedFeature), hasMConfig(false){}
+
+        int id;
+        QPointer<FeatureWrapper> feature;
+        QString name;
+        QString group;
+        FeatureTypes type;
+        bool hasMConfig;
+        QPair<QString, bool> mConfig;
+    };
+
+    QVector<FeatureSlot> featureSlots; //dense slot storage (slots of removed features are reused)
+    QVector<int> freeSlots;
+    QHash<int, int> slotIndices; //feature id -> slot
+
     //######################
     //feature lists and maps
     //######################
 
     //feature lists (useful to provide lists of features by category (geometries, stations etc.))
-    QList<QPointer<FeatureWrapper> > featuresList; //list of all features in OpenIndy
-    QList<QPointer<CoordinateSystem> > coordSystems; //list of all non-station coordinate systems
-    QList<QPointer<Station> > stationsList; //list of all stations (each station has pointer to its coordinate system)
-    QList<QPointer<TrafoParam> > trafoParamsList; //list of all trafo params
-    QList<QPointer<FeatureWrapper> > geometriesList; //list of all geometry features
+    IndexedList<int, QPointer<FeatureWrapper> > featuresList; //list of all features in OpenIndy
+    IndexedList<int, QPointer<CoordinateSystem> > coordSystems; //list of all non-station coordinate systems
+    IndexedList<int, QPointer<Station> > stationsList; //list of all stations (each station has pointer to its coordinate system)
+    IndexedList<int, QPointer<TrafoParam> > trafoParamsList; //list of all trafo params
+    IndexedList<int, QPointer<FeatureWrapper> > geometriesList; //list of all geometry features
 
     //feature maps (useful to quickly find a feature with a given id, name, group etc.)
     QMap<int, QPointer<FeatureWrapper> > featuresIdMap; //map of all features in OpenIndy with their id as key
-    QMultiMap<QString, QPointer<FeatureWrapper> > featuresNameMap; //map of all features in OpenIndy with their name as key
-    QMultiMap<QString, QPointer<FeatureWrapper> > featuresGroupMap; //map of all features in OpenIndy with their group as key
-    QMultiMap<FeatureTypes, QPointer<FeatureWrapper> > featuresTypeMap; // map of all features in OpenIndy with their type as key
-    QMultiMap<QPair<QString, bool>, QPointer<Geometry> > geometriesMConfigMap; //map of all geometries in OpenIndy with their measurement config name and saved state as key
+    QHash<QString, IndexedList<int, QPointer<FeatureWrapper> > > featuresNameMap; //all features in OpenIndy with their name as key
+    QHash<QString, IndexedList<int, QPointer<FeatureWrapper> > > featuresGroupMap; //all features in OpenIndy with their group as key
+    QMap<FeatureTypes, IndexedList<int, QPointer<FeatureWrapper> > > featuresTypeMap; //all features in OpenIndy with their type as key
+    QMap<QPair<QString, bool>, IndexedList<int, QPointer<Geometry> > > geometriesMConfigMap; //all geometries in OpenIndy with their measurement config name and saved state as key
+    QMap<QString, IndexedList<QString, QString, QStringList> > featureNamesIndex; //sorted case folded names with the feature names that fold to them (prefix search)
 
     //lists with ids, names, groups and measurement configs
-    QList<int> featureIds;
-    QStringList featureNames;
-    QStringList featureGroups;
-    QList<QPair<QString, bool> > usedMConfigs;
+    IndexedList<int, int> featureIds;
+    IndexedList<QString, QString, QStringList> featureNames;
+    IndexedList<QString, QString, QStringList> featureGroups;
+    IndexedList<QPair<QString, bool>, QPair<QString, bool> > usedMConfigs;
+
+    //##############
+    //helper methods
+    //##############
+
+    void addToIndices(FeatureSlot &slot);
+    void removeFromIndices(const FeatureSlot &slot);
+    void releaseSlot(const int &featureId);
+
+    void addToNameIndex(const QString &name);
+    void removeFromNameIndex(const QString &name);
 
 };
 
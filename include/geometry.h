@@ -4,6 +4,8 @@
 #include <QObject>
 #include <QPointer>
 #include <QList>
+#include <QHash>
+#include <QSet>
 #include <QtXml>
 
 #include "feature.h"
@@ -13,6 +15,7 @@
 #include "radius.h"
 #include "direction.h"
 #include "position.h"
+#include "indexedlist.h"
 
 namespace oi{
 
@@ -55,7 +58,10 @@ public:
 
     const QList<QPointer<Observation> > &getObservations() const;
     void addObservation(const QPointer<Observation> &obs);
+    void addObservations(const QList<QPointer<Observation> > &observations);
     void removeObservation(const QPointer<Observation> &obs);
+    void removeObservations(const QSet<int> &observationIds);
+    bool hasObservation(const QPointer<Observation> &obs) const;
 
     const QPointer<CoordinateSystem> &getNominalSystem() const;
     bool setNominalSystem(const QPointer<CoordinateSystem> &nomSys);
@@ -164,8 +170,8 @@ protected:
     QPointer<Geometry> actual;
     QPointer<CoordinateSystem> nominalSystem;
 
-    //observations
-    QList<QPointer<Observation> > observations;
+    //observations (indexed by their address because observations may not have an id yet)
+    IndexedList<Observation *, QPointer<Observation> > observations;
 
     //statistic
     Statistic statistic;
@@ -173,6 +179,7 @@ protected:
 
     //reading types
     QList<ReadingTypes> usedReadingTypes;
+    QHash<int, int> usedReadingTypeCounts; //reading type -> number of observations with a reading of that type
 
     //current measurement config that is used to create readings until the user selects another one
     MeasurementConfig activeMeasurementConfig; //only for this geometry instance
@@ -181,6 +188,15 @@ protected:
     Direction ijk;
     Radius radius;
 
+private:
+
+    //##############
+    //helper methods
+    //##############
+
+    void addUsedReadingType(const QPointer<Observation> &obs);
+    void removeUsedReadingType(const QPointer<Observation> &obs);
+
 };
 
 }
@@ -3,6 +3,8 @@
 
 #include <QObject>
 #include <QtXml>
+#include <QVector>
+#include <limits>
 
 #include "geometry.h"
 #include "position.h"
@@ -13,9 +15,11 @@ class FeatureWrapper;
 
 /*!
  * \brief The Point_PC class
+ * Single point of a point cloud (only used to pass points by value, the point cloud itself stores plain arrays)
  */
 class OI_CORE_EXPORT Point_PC{
-    Point_PC(){ this->isUsed = false; }
+public:
+    Point_PC(){ this->xyz[0] = 0.0f; this->xyz[1] = 0.0f; this->xyz[2] = 0.0f; this->isUsed = false; }
 
     float xyz[3];
     bool isUsed;
@@ -25,10 +29,52 @@ class OI_CORE_EXPORT Point_PC{
  * \brief The BoundingBox_PC class
  */
 class OI_CORE_EXPORT BoundingBox_PC{
+public:
+    BoundingBox_PC(){ this->reset(); }
+
+    //! reset to an empty (invalid) bounding box
+    void reset(){
+        for(int i = 0; i < 3; i++){
+            this->min[i] = std::numeric_limits<float>::max();
+            this->max[i] = -std::numeric_limits<float>::max();
+        }
+    }
+
+    //! true if at least one point has been added
+    bool isValid() const{
+        return this->min[0] <= this->max[0];
+    }
+
+    //! enlarge the bounding box so that it contains the given point
+    void extend(const float *xyz){
+        for(int i = 0; i < 3; i++){
+            if(xyz[i] < this->min[i]){
+                this->min[i] = xyz[i];
+            }
+            if(xyz[i] > this->max[i]){
+                this->max[i] = xyz[i];
+            }
+        }
+    }
+
     float min[3];
     float max[3];
 };
 
+/*!
+ * \brief The PointSpan_PC class
+ * Read only view on the point buffers of a point cloud (no copy is made).
+ * The view is only valid as long as no points are added to or removed from the point cloud.
+ */
+class OI_CORE_EXPORT PointSpan_PC{
+public:
+    PointSpan_PC() : xyz(NULL), isUsed(NULL), count(0){}
+
+    const float *xyz; //x, y and z of each point (3 * count values)
+    const quint8 *isUsed; //used state of each point (count values)
+    int count;
+};
+
 /*!
  * \brief The PointCloud class
  */
@@ -64,8 +110,18 @@ public:
     //get or set point cloud parameters
     //#################################
 
-    const QList<QPointer<Point_PC> > &getPointCloudPoints() const;
-    void addPointCloudPoint(const QPointer<Point_PC> &point);
+    void reservePoints(const int &count);
+    void clearPoints();
+
+    Point_PC getPointCloudPoint(const int &index) const;
+    void addPointCloudPoint(const Point_PC &point);
+    void addPointCloudPoint(const float &x, const float &y, const float &z, const bool &isUsed = false);
+    void addPointCloudPoints(const float *xyz, const int &count, const bool &isUsed = false);
+
+    bool getPointIsUsed(const int &index) const;
+    void setPointIsUsed(const int &index, const bool &isUsed);
+
+    PointSpan_PC getPoints() const;
 
     const BoundingBox_PC &getBoundingBox() const;
     void setBoundingBox(const BoundingBox_PC &bbox);
@@ -96,8 +152,9 @@ private:
     //point cloud attributes
     //######################
 
-    QList<QPointer<Point_PC> > points; //all points of the pointcloud
-    BoundingBox_PC bbox; //bounding box of the pointcloud
+    QVector<float> pointCoordinates; //x, y and z of all points of the pointcloud (contiguous)
+    QVector<quint8> pointIsUsed; //used state of all points of the pointcloud
+    BoundingBox_PC bbox; //bounding box of the pointcloud (updated incrementally when points are added)
 
     QList<QPointer<FeatureWrapper> > detectedSegments; //geometry-segments that were detected in the pointcloud
 
@@ -104,6 +104,9 @@ public:
     //compare two configs
     bool equals(const MeasurementConfig &other);
 
+    //compare all attributes of two configs (identical configs are shared by readings)
+    bool isIdentical(const MeasurementConfig &other) const;
+
 private:
 
     //#############################
@@ -3,13 +3,18 @@
 
 #include <QObject>
 #include <QList>
+#include <QHash>
 #include <math.h>
 #include <QPointer>
+#include <QSharedPointer>
 
 #include "element.h"
+#include "indexedlist.h"
 #include "geometry.h"
 #include "oivec.h"
 #include "statistic.h"
+#include "observationstore.h"
+#include "fixedmath.h"
 
 class TrafoController;
 
@@ -29,10 +34,13 @@ class OI_CORE_EXPORT Observation : public Element
     friend class Reading;
     friend class CoordinateSystem;
     friend class ::TrafoController;
+    friend class ObservationSidecar;
+    friend class Geometry;
     Q_OBJECT
 
 public:
     explicit Observation(QObject *parent = 0);
+    explicit Observation(const QSharedPointer<ObservationStore> &store, QObject *parent = 0);
 
     Observation(const Observation &copy, QObject *parent = 0);
     Observation(const OiVec &xyz, bool isValid, QObject *parent = 0);
@@ -46,25 +54,27 @@ public:
     //get or set observations attributes
     //##################################
 
-    const OiVec &getXYZ() const;
+    OiVec getXYZ() const;
     void setXYZ(const OiVec &xyz);
 
-    const OiVec &getOriginalXYZ() const;
+    OiVec getOriginalXYZ() const;
 
-    const OiVec &getSigmaXYZ() const;
+    OiVec getSigmaXYZ() const;
     void setSigmaXyz(const OiVec &sigmaXyz);
 
-    const OiVec &getOriginalSigmaXyz() const;
+    OiVec getOriginalSigmaXyz() const;
 
-    const OiVec &getIJK() const;
+    OiVec getIJK() const;
     void setIJK(const OiVec &ijk);
 
-    const OiVec &getOriginalIJK() const;
+    OiVec getOriginalIJK() const;
 
-    const OiVec &getSigmaIJK() const;
+    OiVec getSigmaIJK() const;
     void setSigmaIjk(const OiVec &sigmaIjk);
 
-    const OiVec &getOriginalSigmaIjk() const;
+    OiVec getOriginalSigmaIjk() const;
+
+    Vec4 getVector(const ObservationStore::ObservationVectors &vector) const;
 
     //##################################################
     //get and set station, reading and target geometries
@@ -86,14 +96,21 @@ public:
     //get and set state booleans
     //##########################
 
-    const bool &getIsValid() const;
+    bool getIsValid() const;
 
     void setIsSolved(const bool &isSolved);
-    const bool &getIsSolved() const;
+    bool getIsSolved() const;
+
+    bool getHasDirection() const;
+
+    bool getIsDummyPoint() const;
 
-    const bool &getHasDirection() const;
+    //##########################################################################
+    //get the store that holds the observation data (null until it has any data)
+    //##########################################################################
 
-    const bool &getIsDummyPoint() const;
+    const QSharedPointer<ObservationStore> &getStore() const;
+    int getStoreSlot() const;
 
     //###############
     //display methods
@@ -124,6 +141,9 @@ public:
     QDomElement toOpenIndyXML(QDomDocument &xmlDoc) const;
     bool fromOpenIndyXML(QDomElement &xmlElem);
 
+    void toOpenIndyXML(QXmlStreamWriter &xmlWriter) const;
+    bool fromOpenIndyXML(QXmlStreamReader &xmlReader);
+
 private:
 
     //####################################################
@@ -132,42 +152,38 @@ private:
 
     QPointer<Station> station;
 
-    QList< QPointer<Geometry> > targetGeometriesList;
-    QMap<int, QPointer<Geometry> > targetGeometriesMap;
+    IndexedList<Geometry *, QPointer<Geometry> > targetGeometriesList; //indexed by the address of the geometries
+    QHash<int, QPointer<Geometry> > targetGeometriesMap;
 
     QPointer<Geometry> measuredTargetGeometry;
 
     QPointer<Reading> reading;
 
-    //###################################################
-    //booleans that indicate the state of the observation
-    //###################################################
-
-    bool isValid; //defines if the reading can be transformed, without any function, to a xyz/ijk observation
-    bool isSolved; //defines wether this observation is valid in current coordinate system
-    bool hasDirection; //defines if the observation has a valid ijk direction
-
-    //#############################
-    //xyz coordinates and statistic
-    //#############################
+    //#############################################################
+    //coordinates, standard deviations and state of the observation
+    //#############################################################
 
-    OiVec xyz; //the homogeneous coordinate vector in the current display coordinate system
-    OiVec originalXyz; //the homogeneous coordinate vector in the station system that produced this observation
+    //the state booleans (isValid, isSolved, hasDirection, isDummyPoint) and the homogeneous
+    //xyz / ijk vectors (current, original and their stdev) are kept in a shared store
+    //(an observation that is created without a store gets a slot in the detached store when its data is set)
+    QSharedPointer<ObservationStore> store;
+    int slot;
 
-    OiVec sigmaXyz; //the homogeneous stdev vector in the current display coordinate system
-    OiVec originalSigmaXyz; //the homogeneous stdev vector in the station system that produced this observation
+    //##############
+    //helper methods
+    //##############
 
-    //###############################
-    //ijk - unit vector and statistic
-    //###############################
+    const double *getVectorData(const ObservationStore::ObservationVectors &vector) const;
+    bool getFlag(const ObservationStore::ObservationFlags &flag) const;
 
-    OiVec ijk; // unit vector
-    OiVec originalIjk; // orignal unit vector
+    void setVector(const ObservationStore::ObservationVectors &vector, const double &x, const double &y, const double &z, const double &h);
+    void setVector(const ObservationStore::ObservationVectors &vector, const OiVec &v);
+    void setFlag(const ObservationStore::ObservationFlags &flag, const bool &state);
 
-    OiVec sigmaIjk; // stdev unit vector
-    OiVec originalSigmaIjk; // orignal sigma unit vector
+    void ensureStore();
+    static const QSharedPointer<ObservationStore> &getDetachedStore();
 
-    bool isDummyPoint; // is dummy observation
+    void moveToStore(const QSharedPointer<ObservationStore> &store);
 
 };
 
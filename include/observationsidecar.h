@@ -0,0 +1,167 @@
+#ifndef OBSERVATIONSIDECAR_H
+#define OBSERVATIONSIDECAR_H
+
+#include <QList>
+#include <QMap>
+#include <QPointer>
+#include <QSharedPointer>
+#include <QFile>
+#include <QDir>
+#include <QtXml>
+
+#include "types.h"
+#include "observationstore.h"
+
+namespace oi{
+
+class Observation;
+class Station;
+
+/*!
+ * \brief The ObservationSidecar class
+ * Binary columnar file that is saved next to a job file and holds the observations and readings of the stations.
+ *
+ * The file starts with a versioned header and a directory of station blocks. Each station block holds one column per
+ * attribute (ids, time stamps, reading type, face, flags, observation vectors, reading values and their sigmas) followed
+ * by a table of the sensor and measurement config names. Every column starts at an 8 byte boundary so that a loaded file
+ * is memory mapped and the columns can be accessed in place. Each station block is protected by an Adler-32 checksum.
+ * The XML project references the sidecar and the observation id range of each station.
+ */
+class OI_CORE_EXPORT ObservationSidecar
+{
+
+public:
+    ObservationSidecar();
+    ~ObservationSidecar();
+
+    //! the format version that is written by save
+    static const quint32 version = 1;
+
+    //##################################
+    //columns that are saved per station
+    //##################################
+
+    enum SidecarColumns{
+        eObservationIds = 0, //qint32
+        eReadingIds, //qint32 (-1 if the observation has no reading)
+        eMeasuredAt, //qint64 milliseconds since epoch (UTC)
+        eReadingTypes, //quint8 (ReadingTypes)
+        eFaces, //quint8 (SensorFaces)
+        eObservationFlags, //quint8 (ObservationStore::ObservationFlags)
+        eReadingFlags, //quint8 (SidecarReadingFlags)
+        eSensorConfigs, //qint32 index into the config name table
+        eMeasurementConfigs, //qint32 index into the config name table
+        eX, eY, eZ, eI, eJ, eK, //double observation vectors
+        eSigmaX, eSigmaY, eSigmaZ, eSigmaI, eSigmaJ, eSigmaK,
+        eValue0, eValue1, eValue2, eValue3, eValue4, eValue5, //double reading values (ordered like the XML measurements)
+        eSigma0, eSigma1, eSigma2, eSigma3, eSigma4, eSigma5, //double reading sigmas
+        eNumSidecarColumns
+    };
+
+    enum SidecarReadingFlags{
+        eHasReading = 0x01,
+        eIsImported = 0x02
+    };
+
+    /*!
+     * \brief The StationBlock class
+     * Directory entry of a station block
+     */
+    class StationBlock{
+    public:
+        StationBlock() : stationId(-1), firstObservationId(-1), lastObservationId(-1), numObservations(0){}
+
+        int stationId;
+        int firstObservationId;
+        int lastObservationId;
+        int numObservations;
+    };
+
+    //##############
+    //save a sidecar
+    //##############
+
+    bool addStation(const QPointer<Station> &station);
+    bool addStation(const int &stationId, const QList<QPointer<Observation> > &observations);
+
+    bool save(const QString &fileName);
+
+    //##############
+    //load a sidecar
+    //##############
+
+    bool load(const QString &fileName, const bool &verifyChecksums = true);
+    void close();
+
+    bool getIsLoaded() const;
+
+    //######################
+    //access the loaded data
+    //######################
+
+    const QString &getFileName() const;
+    const QList<StationBlock> &getStationBlocks() const;
+
+    int getNumObservations(const int &stationId) const;
+
+    static int getColumnElementSize(const SidecarColumns &column);
+    const uchar *getColumnData(const int &stationId, const SidecarColumns &column) const;
+
+    template<class T> const T *getColumn(const int &stationId, const SidecarColumns &column) const{
+        if(sizeof(T) != ObservationSidecar::getColumnElementSize(column)){
+            return NULL;
+        }
+        return reinterpret_cast<const T *>(this->getColumnData(stationId, column));
+    }
+
+    QStringList getConfigNames(const int &stationId) const;
+
+    QList<QPointer<Observation> > createObservations(const int &stationId,
+                                                     const QSharedPointer<ObservationStore> &store = QSharedPointer<ObservationStore>()) const;
+
+    const QString &getErrorMessage() const;
+
+    //############################
+    //reference the sidecar in XML
+    //############################
+
+    QDomElement toOpenIndyXML(QDomDocument &xmlDoc) const;
+    bool fromOpenIndyXML(QDomElement &xmlElem, const QDir &jobDirectory, const bool &verifyChecksums = true);
+
+private:
+    Q_DISABLE_COPY(ObservationSidecar)
+
+    //#####################################
+    //observations that are written by save
+    //#####################################
+
+    QList<int> pendingStations;
+    QMap<int, QList<QPointer<Observation> > > pendingObservations;
+
+    //##########################
+    //memory mapped sidecar file
+    //##########################
+
+    QString fileName;
+    QFile file;
+    uchar *data;
+    qint64 size;
+
+    QList<StationBlock> stationBlocks;
+    QMap<int, qint64> stationOffsets; //station id -> offset of the station block
+    QMap<int, qint64> stationSizes; //station id -> size of the station block
+
+    QString errorMessage;
+
+    //##############
+    //helper methods
+    //##############
+
+    static qint64 getColumnOffset(const int &numObservations, const SidecarColumns &column);
+    bool setError(const QString &errorMessage);
+
+};
+
+}
+
+#endif // OBSERVATIONSIDECAR_H
@@ -0,0 +1,102 @@
+#ifndef OBSERVATIONSTORE_H
+#define OBSERVATIONSTORE_H
+
+#include <QVector>
+
+#include "oivec.h"
+#include "types.h"
+
+namespace oi{
+
+using namespace math;
+
+/*!
+ * \brief The ObservationStore class
+ * Contiguous (structure of arrays) storage of the coordinates, standard deviations, ids and state flags of observations.
+ * Each station system owns one store that is shared by all of its observations. An observation only holds its slot index.
+ */
+class OI_CORE_EXPORT ObservationStore
+{
+
+public:
+    ObservationStore();
+
+    //#########################################
+    //homogeneous vectors stored per observation
+    //#########################################
+
+    enum ObservationVectors{
+        eXyz = 0, //the homogeneous coordinate vector in the current display coordinate system
+        eOriginalXyz, //the homogeneous coordinate vector in the station system that produced the observation
+        eSigmaXyz, //the homogeneous stdev vector in the current display coordinate system
+        eOriginalSigmaXyz, //the homogeneous stdev vector in the station system that produced the observation
+        eIjk, //unit vector
+        eOriginalIjk, //original unit vector
+        eSigmaIjk, //stdev unit vector
+        eOriginalSigmaIjk, //original stdev unit vector
+        eNumObservationVectors
+    };
+
+    //###################################
+    //state booleans stored per observation
+    //###################################
+
+    enum ObservationFlags{
+        eIsValid = 0x01,
+        eIsSolved = 0x02,
+        eHasDirection = 0x04,
+        eIsDummyPoint = 0x08
+    };
+
+    //###############
+    //slot management
+    //###############
+
+    int allocate(const int &id = -1);
+    void release(const int &slot);
+
+    void reserve(const int &size);
+
+    int getSize() const;
+    int getCapacity() const;
+
+    //####################
+    //get or set slot data
+    //####################
+
+    int getId(const int &slot) const;
+    void setId(const int &slot, const int &id);
+
+    bool getFlag(const int &slot, const ObservationFlags &flag) const;
+    void setFlag(const int &slot, const ObservationFlags &flag, const bool &state);
+
+    const double *getVector(const int &slot, const ObservationVectors &vector) const;
+    OiVec getOiVec(const int &slot, const ObservationVectors &vector) const;
+    void setVector(const int &slot, const ObservationVectors &vector, const double &x, const double &y, const double &z, const double &h);
+    void setOiVec(const int &slot, const ObservationVectors &vector, const OiVec &v);
+
+    void copySlot(const int &slot, ObservationStore &destination, const int &destinationSlot) const;
+
+    //#################
+    //memory statistics
+    //#################
+
+    static qint64 getBytesPerObservation();
+    qint64 getMemoryUsage() const;
+
+private:
+
+    //four doubles per slot and vector type
+    QVector<double> vectors[eNumObservationVectors];
+
+    QVector<int> ids;
+    QVector<quint8> flags;
+
+    //slots of removed observations that can be reused
+    QVector<int> freeSlots;
+
+};
+
+}
+
+#endif // OBSERVATIONSTORE_H
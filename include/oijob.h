@@ -12,10 +12,14 @@
 #include <QSet>
 #include <QRegExp>
 #include <QStringRef>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 
 #include "featurecontainer.h"
+#include "recalcscheduler.h"
 #include "featureattributes.h"
 #include "function.h"
+#include "observationsidecar.h"
 #include "types.h"
 #include "util.h"
 
@@ -32,6 +36,16 @@ enum CompatibilyCheckResult{
     eCheckResult_job_lt_oi_22_1
 };
 
+//! kinds of feature changes that are collected by a change transaction of a job
+enum JobChangeKinds{
+    eFeatureAttributesChange = 0x01, //comment, solved state, functions, used for and previously needed features
+    eGeometryChange = 0x02, //common state, nominals, actual, nominal system, statistic and simulation data
+    eGeometryObservationsChange = 0x04,
+    eSystemChange = 0x08, //observations, trafo params and nominals of coordinate systems
+    eStationChange = 0x10, //sensor of stations
+    eTrafoParamChange = 0x20 //parameters, systems, use and datum state of trafo params
+};
+
 /*!
  * \brief The OiJob class
  * Represents an OpenIndy job (holds all features and active states)
@@ -63,10 +77,34 @@ public:
     void setLoadedProjectVersion(const QString &loadedVersion);
 
     int generateUniqueId();
+    int generateUniqueIds(const int &count);
+
+    //############################################################################
+    //save or load the observations of all stations (XML stream or binary sidecar)
+    //############################################################################
+
+    void writeObservationsXML(QXmlStreamWriter &xmlWriter) const;
+    static bool readObservationsXML(QXmlStreamReader &xmlReader, QList<QPointer<Observation> > &observations);
+
+    bool saveObservationSidecar(ObservationSidecar &sidecar, const QString &fileName) const;
+    bool loadObservationSidecar(const ObservationSidecar &sidecar, QList<QPointer<Observation> > &observations);
 
     bool validateFeatureName(const QString &name, const FeatureTypes &type, const bool &isNominal = false,
                              const QPointer<CoordinateSystem> &nominalSystem = QPointer<CoordinateSystem>(NULL));
 
+    //recalculate features incrementally within the job instead of emitting recalcFeature
+    bool getIncrementalRecalc() const;
+    void setIncrementalRecalc(const bool &incrementalRecalc);
+    bool getParallelRecalc() const;
+    void setParallelRecalc(const bool &parallelRecalc);
+    const RecalcScheduler &getRecalcScheduler() const;
+
+    //collect feature changes and emit them deduplicated when the (outermost) transaction is committed
+    void beginChanges();
+    void commitChanges();
+    bool getIsCollectingChanges() const;
+    int getSuppressedSignalCount() const;
+
     //###########################################
     //methods to access the current feature state
     //###########################################
@@ -116,6 +154,7 @@ public:
     //add features
     bool addFeature(const QPointer<FeatureWrapper> &feature);
     QList<QPointer<FeatureWrapper> > addFeatures(const FeatureAttributes &fAttr);
+    QList<QPointer<FeatureWrapper> > addFeatures(const QList<FeatureAttributes> &fAttrs);
     bool addFeatures(const QList<QPointer<FeatureWrapper> > &features, bool overwrite =false);
 
     //remove features
@@ -147,6 +186,8 @@ public:
 
     //add new observations
     void addMeasurementResults(const int &geomId, const QList<QPointer<Reading> > &readings);
+    void addMeasurementResults(const QPointer<Station> &station, const int &geomId, const QList<QPointer<Reading> > &readings);
+    void addMeasurementResults(const int &geomId, const QList<ReadingPolar> &readings);
 
     //remove existing observations
     void removeObservations(const int &featureId);
@@ -161,6 +202,8 @@ public:
 
     void setShouldBeUsed(const QPointer<FeatureWrapper> &target, const int &functionIndex, const int &neededElementIndex,
                          const int &elementId, const bool &use, const bool &recalc);
+    void setShouldBeUsed(const QPointer<FeatureWrapper> &target, const int &functionIndex, const int &neededElementIndex,
+                         const QSet<int> &elementIds, const bool &use, const bool &recalc);
 
     void createTemplateFromJob();
 
@@ -211,6 +254,7 @@ signals:
 
     //coordinate system specific attributes changed
     void systemObservationsChanged(const int &featureId, const int &obsId);
+    void systemObservationsAdded(const int &featureId, const QList<int> &obsIds);
     void systemTrafoParamsChanged(const int &featureId);
     void systemsNominalsChanged(const int &featureId);
 
@@ -225,6 +269,9 @@ signals:
     //void trafoParamIsMovementChanged(const int &featureId);
     void trafoParamIsDatumChanged(const int &featureId);
 
+    //feature changes collected by a change transaction (feature id -> JobChangeKinds)
+    void featuresChanged(const QMap<int, int> &changes);
+
     //###################################################
     //general signals to inform OpenIndy about job issues
     //###################################################
@@ -279,6 +326,7 @@ private slots:
 
     //coordinate system specific attributes changed
     void setSystemObservations(const int &featureId, const int &obsId);
+    void setSystemObservationsAdded(const int &featureId, const QList<int> &obsIds);
     void setSystemTrafoParams(const int &featureId);
     void setSystemsNominals(const int &featureId);
 
@@ -310,6 +358,13 @@ private:
     //##############
 
     QStringList createFeatureNames(const QString &name, const int &count) const;
+    bool validateBatchFeatureName(const FeatureAttributes &fAttr, const QPointer<CoordinateSystem> &nominalSystem,
+                                  const FeatureAttributes &other, const QPointer<CoordinateSystem> &otherNominalSystem) const;
+    bool validateFeatureAttributes(const FeatureAttributes &fAttr, QStringList &featureNames, QPointer<CoordinateSystem> &nominalSystem,
+                                   QPointer<CoordinateSystem> &startSystem, QPointer<CoordinateSystem> &destSystem);
+    QList<QPointer<FeatureWrapper> > createFeatures(const FeatureAttributes &fAttr, const QStringList &featureNames, const QPointer<CoordinateSystem> &nominalSystem,
+                                                    const QPointer<CoordinateSystem> &startSystem, const QPointer<CoordinateSystem> &destSystem, int &nextBlockId);
+    void setUpBlockFeatureId(const QPointer<FeatureWrapper> &feature, int &nextBlockId);
     QPointer<FeatureWrapper> createFeatureWrapper(const FeatureTypes &type, bool isNominal = false) const;
     bool checkAndSetUpNewFeature(const QPointer<FeatureWrapper> &feature, bool overwrite = false);
 
@@ -317,6 +372,8 @@ private:
 
     bool checkCircleWarning(const QPointer<Feature> &activeFeature, const QPointer<Feature> &usedForActiveFeature);
 
+    void requestRecalc(const QPointer<Feature> &feature);
+
     void setUpDependencies(const InputElement &element, const QPointer<Feature> &feature);
     void resetDependencies(const InputElement &element, const QPointer<Feature> &feature);
 
@@ -358,6 +415,51 @@ private:
 
     int nextId; //the next free id an element of this job could get
 
+    //#####################################
+    //incremental recalculation of features
+    //#####################################
+
+    RecalcScheduler recalcScheduler;
+    bool incrementalRecalc; //true if recalcScheduler is used instead of the external feature updater
+
+    //##################
+    //change transaction
+    //##################
+
+    //per feature change signals that are emitted (once per feature) when a transaction is committed
+    enum ChangeSignals{
+        eFeatureCommentSignal = 0x000001,
+        eFeatureIsUpdatedSignal = 0x000002,
+        eFeatureIsSolvedSignal = 0x000004,
+        eFeatureFunctionsSignal = 0x000008,
+        eFeatureUsedForSignal = 0x000010,
+        eFeaturePreviouslyNeededSignal = 0x000020,
+        eGeometryIsCommonSignal = 0x000040,
+        eGeometryNominalsSignal = 0x000080,
+        eGeometryActualSignal = 0x000100,
+        eGeometryObservationsSignal = 0x000200,
+        eGeometryNominalSystemSignal = 0x000400,
+        eGeometryStatisticSignal = 0x000800,
+        eGeometrySimulationDataSignal = 0x001000,
+        eSystemObservationsSignal = 0x002000,
+        eSystemTrafoParamsSignal = 0x004000,
+        eSystemsNominalsSignal = 0x008000,
+        eStationSensorSignal = 0x010000,
+        eTrafoParamParametersSignal = 0x020000,
+        eTrafoParamSystemsSignal = 0x040000,
+        eTrafoParamIsUsedSignal = 0x080000,
+        eTrafoParamIsDatumSignal = 0x100000
+    };
+
+    int changeTransactionDepth; //number of nested open transactions
+    QMap<int, int> pendingChanges; //feature id -> JobChangeKinds
+    QMap<int, int> pendingSignals; //feature id -> ChangeSignals
+    QMap<int, int> pendingObservationIds; //station system id -> id of the last changed observation
+    int suppressedSignalCount; //number of signals that were not emitted because of a transaction
+
+    bool collectChange(const int &featureId, const JobChangeKinds &kind, const ChangeSignals &signal, const int &numSignals);
+    int emitChangeSignals(const int &featureId, const int &changeSignals);
+
     void enableOrDisableObservations(const int &featureId, bool enable);
     void enableOrDisableStationObservations(QPointer<Station> station, bool enable);
     void enableOrDisableGeometryObservations(const int &featureId, bool enable, QPointer<Station> station);
@@ -366,6 +468,31 @@ private:
 
 };
 
+/*!
+ * \brief The JobChangeTransaction class
+ * Opens a change transaction of a job for the lifetime of the object
+ */
+class OI_CORE_EXPORT JobChangeTransaction
+{
+public:
+    explicit JobChangeTransaction(const QPointer<OiJob> &job) : job(job){
+        if(!this->job.isNull()){
+            this->job->beginChanges();
+        }
+    }
+
+    ~JobChangeTransaction(){
+        if(!this->job.isNull()){
+            this->job->commitChanges();
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(JobChangeTransaction)
+
+    QPointer<OiJob> job;
+};
+
 }
 
 #endif // OIJOB_H
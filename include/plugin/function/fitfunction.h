@@ -2,7 +2,10 @@
 #define FITFUNCTION_H
 
 #include "function.h"
+#include "fixedmath.h"
+#include "robustfit.h"
 #include <random>
+#include <algorithm>
 
 namespace oi{
 
@@ -42,6 +45,15 @@ enum ApproximationTypes{
     eFirstTwoDummyPoint
 };
 
+/*!
+ * \brief The NormalEquationSolverTypes enum
+ * Defines how the normal equation system of a Gauss-Helmert adjustment is solved
+ */
+enum NormalEquationSolverTypes{
+    eDenseNormalEquation = 0, //set up and solve the full (n+u)x(n+u) normal equation matrix
+    eReducedNormalEquation //eliminate the diagonal condition block and solve a u x u system
+};
+
 /*!
  * \brief The FitFunction class
  * Function that solves geometries by fitting them using observations
@@ -78,6 +90,74 @@ protected:
     bool exec(CoordinateSystem &coordinateSystem){ return Function::exec(coordinateSystem); }
     bool exec(TrafoParam &trafoParam){ return Function::exec(trafoParam); }
 
+    //############################################
+    //reject outliers before the least squares fit
+    //############################################
+
+    /*!
+     * \brief addRobustFitParameters
+     * Adds the scalar input parameters of the robust fit mode. Fit functions that fit circles or cylinders
+     * using BestFitCircleUtil or BestFitCylinderUtil call it in their init method.
+     * (the last inserted string parameter is the default, so that the robust fit is disabled by default)
+     */
+    void addRobustFitParameters(){
+        RobustFitOptions defaults;
+        this->stringParameters.insert("robust fit", "MSAC");
+        this->stringParameters.insert("robust fit", "RANSAC");
+        this->stringParameters.insert("robust fit", "none");
+        this->doubleParameters.insert("robust threshold", defaults.threshold);
+        this->doubleParameters.insert("robust confidence", defaults.confidence);
+        this->integerParameters.insert("robust iterations", defaults.maxIterations);
+        this->integerParameters.insert("robust threads", defaults.numThreads);
+        this->integerParameters.insert("robust seed", (int)defaults.seed);
+    }
+
+    /*!
+     * \brief rejectOutliers
+     * Removes the outliers of a robust estimation from points and marks them as not used.
+     * Does nothing if the robust fit mode is disabled.
+     * \param points
+     * \param model
+     * \return
+     */
+    bool rejectOutliers(QList<IdPoint> &points, const RobustFitModel &model){
+
+        RobustFitOptions options = RobustFitOptions::fromScalarInputParams(this->getScalarInputParams());
+        if(options.type == eNoRobustFit){
+            return true;
+        }
+
+        QVector<Vec3> xyz;
+        xyz.reserve(points.size());
+        foreach(const IdPoint &point, points){
+            xyz.append(Vec3(point.xyz));
+        }
+
+        RobustFitResult result = RobustEstimator::estimate(model, xyz, options);
+        if(!result.isValid || result.numInliers < model.getSampleSize()){
+            emit this->sendMessage(QString("Robust fit found no consensus within a threshold of %1").arg(options.threshold), eErrorMessage);
+            return false;
+        }
+
+        //keep the inliers and mark the outliers as not used
+        QList<IdPoint> inliers;
+        inliers.reserve(result.numInliers);
+        for(int i = 0; i < points.size(); i++){
+            if(result.inliers.at(i)){
+                inliers.append(points.at(i));
+            }else{
+                this->setIsUsed(InputElementKey::eDefault, points.at(i).id, false);
+            }
+        }
+
+        emit this->sendMessage(QString("Robust fit rejected %1 of %2 observations (%3 hypotheses)")
+                               .arg(points.size() - inliers.size()).arg(points.size()).arg(result.numHypotheses), eInformationMessage);
+
+        points = inliers;
+        return true;
+
+    }
+
 };
 
 
@@ -87,26 +167,29 @@ class OI_CORE_EXPORT BestFitCircleUtil
 protected:
 
     bool bestFitCircleInPlane(FitFunction *function, Circle &circle, QList<IdPoint> points, QList<IdPoint> usablePoints) {
+        //reject outliers (robust fit mode only)
+        if(!function->rejectOutliers(points, RobustFitCircleModel())){
+            return false;
+        }
+
         //calculate centroid
-        OiVec centroid(4);
+        Vec3 centroid;
         foreach(const IdPoint &point, points){
-            centroid = centroid + point.xyz;
+            centroid += Vec3(point.xyz);
         }
-        centroid = centroid / (double)points.size();
-        centroid.removeLast();
+        centroid /= (double)points.size();
 
         //principle component analysis
-        OiMat a(points.size(), 3);
-        for(int i = 0; i < points.size(); i++){
-            a.setAt(i, 0, points.at(i).xyz.getAt(0) - centroid.getAt(0));
-            a.setAt(i, 1, points.at(i).xyz.getAt(1) - centroid.getAt(1));
-            a.setAt(i, 2, points.at(i).xyz.getAt(2) - centroid.getAt(2));
+        Mat3 ata;
+        foreach(const IdPoint &point, points){
+            Vec3 reduced = Vec3(point.xyz) - centroid;
+            ata.addOuterProduct(reduced, reduced);
         }
-        OiMat ata = a.t() * a;
         OiMat u(3,3);
         OiVec d(3);
         OiMat v(3,3);
-        ata.svd(u, d, v);
+        ata.toOiMat().svd(u, d, v);
+        Mat3 U(u);
 
         //get smallest eigenvector which is n vector
         int eigenIndex = -1;
@@ -117,37 +200,40 @@ protected:
                 eigenIndex = i;
             }
         }
-        OiVec n(3);
-        u.getCol(n, eigenIndex);
+        Vec3 n = U.getCol(eigenIndex);
         n.normalize();
 
-        OiVec direction(3);
-        if(function->getInputElements().contains(InputElementKey::eDummyPoint) && function->getInputElements()[InputElementKey::eDummyPoint].size() > 0) {
+        //get the first dummy point (if any)
+        QPointer<Observation> dummyObservation;
+        foreach(const InputElement &element, function->getInputElements().value(InputElementKey::eDummyPoint)){
+            dummyObservation = element.getObservation();
+            if(!dummyObservation.isNull()){
+                break;
+            }
+        }
+
+        Vec3 direction;
+        if(!dummyObservation.isNull()) {
             // computing circle normale by dummy point
-            OiVec dummyPoint = function->getInputElements()[InputElementKey::eDummyPoint][0].observation->getXYZ(); // TODO Point
-            dummyPoint.removeLast();
-            double dot;
-            OiVec::dot(dot, dummyPoint - centroid, centroid);
+            Vec3 dummyPoint(dummyObservation->getXYZ()); // TODO Point
+            double dot = (dummyPoint - centroid).dot(centroid);
             direction = - dot * dummyPoint;
             direction.normalize();
         } else {
             //check that the normal vector of the plane is defined by the first three points A, B and C (cross product)
-            OiVec ab = points.at(1).xyz - points.at(0).xyz;
-            ab.removeLast();
-            OiVec ac = points.at(2).xyz - points.at(0).xyz;
-            ac.removeLast();
-            OiVec::cross(direction, ab, ac);
+            Vec3 ab = Vec3(points.at(1).xyz) - Vec3(points.at(0).xyz);
+            Vec3 ac = Vec3(points.at(2).xyz) - Vec3(points.at(0).xyz);
+            direction = ab.cross(ac);
             direction.normalize();
         }
-        double angle = 0.0; //angle between n and direction
-        OiVec::dot(angle, n, direction);
+        double angle = n.dot(direction); //angle between n and direction
         angle = qAbs(qAcos(angle));
         if(angle > (PI/2.0)){
             n = n * -1.0;
         }
 
         //calculate smallest distance of the plane from the origin
-        double dOrigin = n.getAt(0) * centroid.getAt(0) + n.getAt(1) * centroid.getAt(1) + n.getAt(2) * centroid.getAt(2);
+        double dOrigin = n.dot(centroid);
 
         //calculate the distances of each observation from the plane
         /*OiVec planeDistances;
@@ -162,109 +248,94 @@ protected:
         }*/
 
         //get transformation matrix
-        OiMat t = u.inv();
+        Mat3 t = U.inv();
+
+        //transform centroid into 2D space (the third component is the height of the plane)
+        Vec3 centroid2D = t * centroid;
 
-        //transform centroid into 2D space
-        OiVec centroid2D = t * centroid;
-        centroid2D.removeLast();
+        //ids of the used points (avoids a linear search per usable point)
+        QSet<int> pointIds;
+        pointIds.reserve(points.size());
+        foreach(const IdPoint &point, points){
+            pointIds.insert(point.id);
+        }
 
         //calculate centroid reduced coordinates in 2D space
-        QList<OiVec> centroidReducedCoordinates;
-        QList<OiVec> allCentroidReducedCoordinates;
-
-        foreach(const IdPoint point, usablePoints){
-            OiVec xyz(4);
-            xyz = point.xyz;
-            xyz.removeLast(); //remove the homogeneous item
-            xyz = t * xyz;
-            xyz.removeLast();
-            OiVec reduced = xyz - centroid2D;
+        QVector<Vec3> centroidReducedCoordinates;
+        QVector<Vec3> allCentroidReducedCoordinates;
+        centroidReducedCoordinates.reserve(points.size());
+        allCentroidReducedCoordinates.reserve(usablePoints.size());
+
+        foreach(const IdPoint &point, usablePoints){
+            Vec3 xyz = t * Vec3(point.xyz);
+            Vec3 reduced(xyz.x() - centroid2D.x(), xyz.y() - centroid2D.y(), 0.0);
             allCentroidReducedCoordinates.append(reduced);
-            if(points.contains(point)) {
+            if(pointIds.contains(point.id)) {
                 centroidReducedCoordinates.append(reduced);
             }
         }
 
-        //calculate best fit circle in 2D space
-        OiVec A1(points.size());
-        OiMat A2(points.size(), 3);
-        for(int i = 0; i < points.size(); i++){
-            A1.setAt(i, centroidReducedCoordinates.at(i).getAt(0)*centroidReducedCoordinates.at(i).getAt(0)
-                     + centroidReducedCoordinates.at(i).getAt(1)*centroidReducedCoordinates.at(i).getAt(1));
-
-            A2.setAt(i,0,centroidReducedCoordinates.at(i).getAt(0));
-            A2.setAt(i,1,centroidReducedCoordinates.at(i).getAt(1));
-            A2.setAt(i,2,1.0);
+        //calculate best fit circle in 2D space (the normal equations A2T * A2 and A2T * A1 are accumulated directly)
+        Mat3 A2TA2;
+        Vec3 A2TA1;
+        foreach(const Vec3 &reduced, centroidReducedCoordinates){
+            Vec3 a2(reduced.x(), reduced.y(), 1.0);
+            A2TA2.addOuterProduct(a2, a2);
+            A2TA1 += (reduced.x() * reduced.x() + reduced.y() * reduced.y()) * a2;
         }
-        OiVec s(3);
-        try{
-            if(!OiMat::solve(s, A2.t() * A2, -1.0 * A2.t() * A1)){
-                return false;
-            }
-        }catch(const exception &e){
-            emit function->sendMessage(e.what(), eErrorMessage);
+        Vec3 s;
+        if(!Mat3::solve(s, A2TA2, -1.0 * A2TA1)){
             return false;
         }
 
         //calculate center and radius in 2D space
-        OiVec xm(3);
-        xm.setAt(0, (-1.0 * s.getAt(0) / 2.0) + centroid2D.getAt(0));
-        xm.setAt(1, (-1.0 * s.getAt(1) / 2.0) + centroid2D.getAt(1));
-        xm.setAt(2, (t * centroid).getAt(2));
-        double radius = qSqrt(0.25 * (s.getAt(0) * s.getAt(0) + s.getAt(1) * s.getAt(1)) - s.getAt(2));
+        Vec3 xm((-1.0 * s.x() / 2.0) + centroid2D.x(), (-1.0 * s.y() / 2.0) + centroid2D.y(), centroid2D.z());
+        double radius = qSqrt(0.25 * (s.x() * s.x() + s.y() * s.y()) - s.z());
 
         //calculate distance of each observation from the 2D circle
-        OiVec circleDistances;
-        OiVec allCircleDistances;
-        int i=0;
-        foreach(const IdPoint &point, usablePoints){
-            OiVec reduced = allCentroidReducedCoordinates[i++];
-            OiVec diff(2);
-            diff.setAt(0, reduced.getAt(0) + centroid2D.getAt(0) - xm.getAt(0));
-            diff.setAt(1, reduced.getAt(1) + centroid2D.getAt(1) - xm.getAt(1));
+        QVector<double> circleDistances;
+        QVector<double> allCircleDistances;
+        circleDistances.reserve(points.size());
+        allCircleDistances.reserve(usablePoints.size());
+        for(int i = 0; i < usablePoints.size(); i++){
+            const Vec3 &reduced = allCentroidReducedCoordinates.at(i);
+            double dx = reduced.x() + centroid2D.x() - xm.x();
+            double dy = reduced.y() + centroid2D.y() - xm.y();
 
-            double dr = diff.length() - radius;
+            double dr = qSqrt(dx * dx + dy * dy) - radius;
 
-            allCircleDistances.add(dr);
-            if(points.contains(point)) {
-                circleDistances.add(dr);
+            allCircleDistances.append(dr);
+            if(pointIds.contains(usablePoints.at(i).id)) {
+                circleDistances.append(dr);
             }
         }
 
         //transform center into 3D space
-        OiMat t_inv = t.inv();
+        Mat3 t_inv = t.inv();
         xm = t_inv * xm;
 
         //calculate 3D residuals for each observation
         for(int i = 0; i < usablePoints.size(); i++){
-            const IdPoint point = usablePoints[i];
-            OiVec reduced = allCentroidReducedCoordinates[i];
-
-            OiVec v_circle(3);
-            OiVec v_plane(3);
-            OiVec v_all(3);
+            const IdPoint &point = usablePoints.at(i);
+            const Vec3 &reduced = allCentroidReducedCoordinates.at(i);
 
             //calculate residual vector of 2D circle fit
-            v_circle.setAt(0, reduced.getAt(0) + centroid2D.getAt(0) - xm.getAt(0));
-            v_circle.setAt(1, reduced.getAt(1) + centroid2D.getAt(1) - xm.getAt(1));
-            v_circle.setAt(2, 0.0);
+            Vec3 v_circle(reduced.x() + centroid2D.x() - xm.x(), reduced.y() + centroid2D.y() - xm.y(), 0.0);
             v_circle.normalize();
-            v_circle = allCircleDistances.getAt(i) * v_circle;
-            v_circle = t_inv * v_circle;
+            v_circle = t_inv * (allCircleDistances.at(i) * v_circle);
 
             //calculate residual vector of plane fit
-            double distance = n.getAt(0) * point.xyz.getAt(0) + n.getAt(1) * point.xyz.getAt(1)
-                    + n.getAt(2) * point.xyz.getAt(2) - dOrigin;
-            v_plane = distance * n;
+            double distance = n.dot(Vec3(point.xyz)) - dOrigin;
+            Vec3 v_plane = distance * n;
 
             //calculate the at all residual vector
-            v_all = v_circle + v_plane;
+            Vec3 v_all = v_circle + v_plane;
 
             //set up display residual
             if(false) {
-                function->addDisplayResidual(point.id, v_all.getAt(0), v_all.getAt(1), v_all.getAt(2), v_all.length());
+                function->addDisplayResidual(point.id, v_all.x(), v_all.y(), v_all.z(), v_all.length());
             } else {
-                function->addDisplayResidual(point.id, v_all.length() * sgn(allCircleDistances.getAt(i)));
+                function->addDisplayResidual(point.id, v_all.length() * sgn(allCircleDistances.at(i)));
             }
 
 
@@ -282,7 +353,7 @@ protected:
         //set statistic
         double stdev = 0.0;
         for(int i = 0; i < centroidReducedCoordinates.size(); i++){
-            double v_i = circleDistances.getAt(i);
+            double v_i = circleDistances.at(i);
             stdev += v_i*v_i;
         }
         stdev = qSqrt(stdev / (centroidReducedCoordinates.size() - 3.0));
@@ -298,9 +369,21 @@ protected:
 class OI_CORE_EXPORT BestFitCylinderUtil
 {
 
+public:
+    BestFitCylinderUtil() : normalEquationSolver(eReducedNormalEquation){}
+
+    const NormalEquationSolverTypes &getNormalEquationSolver() const{
+        return this->normalEquationSolver;
+    }
+    void setNormalEquationSolver(const NormalEquationSolverTypes &solver){
+        this->normalEquationSolver = solver;
+    }
+
 private:
     QList<CylinderApproximation> approximations;
 
+    NormalEquationSolverTypes normalEquationSolver;
+
 
 protected:
 
@@ -320,77 +403,24 @@ protected:
             }
         }
 
-        //calculate centroid of all observations
-        OiVec centroid(4);
-        foreach(const IdPoint &point, points){
-            centroid = centroid + point.xyz;
-        }
-        centroid = centroid / (double)points.size();
-
-        // calculate centroid reduced observations
-        QList<IdPoint> allReducedInputObservations;
-        QList<IdPoint> reducedInputObservations;
-        foreach(const IdPoint &obs, usablePoints){
-            IdPoint rObs;
-            rObs.id = obs.id;
-            rObs.xyz = obs.xyz - centroid;
-            allReducedInputObservations.append(rObs);
-            if(points.contains(obs)) {
-                reducedInputObservations.append(rObs);
-            }
-        }
-
-        // approximate cylinder by 2D circle fit
-        if(!this->approximateCylinder(function, cylinder, reducedInputObservations, approximationType)){
-            emit function->sendMessage(QString("Error while generating approximations for cylinder parameters of cylinder %1").arg(cylinder.getFeatureName()), eErrorMessage);
+        //reject outliers (robust fit mode only) before the axis is approximated
+        if(RobustFitOptions::fromScalarInputParams(function->getScalarInputParams()).type != eNoRobustFit
+                && !this->rejectCylinderOutliers(function, cylinder, points, approximationType)){
+            cylinder.setIsSolved(false);
             return false;
         }
 
-        // filter the best approximation
+        //reduce all observations by the centroid and rotate them so that the approximate axis is parallel to z
+        Vec4 centroid;
+        Mat4 Rall;
         CylinderApproximation bestApproximation;
-        double bestStdev  = numeric_limits<double>::max();
-        foreach (const CylinderApproximation &approximation, approximations) {
-            qDebug() << "approximation" << approximation;
-            if(approximation.stdev < bestStdev) {
-                bestStdev = approximation.stdev;
-                bestApproximation = approximation;
-            }
-        }
-
-
-        qDebug() << "bestApproximation" << bestApproximation;
-
-        OiMat Ralpha(4,4);
-        OiMat Rbeta(4,4);
-        OiMat Rall(4,4);
-
-        Ralpha.setAt(0, 0, 1.0);
-        Ralpha.setAt(1, 1, qCos(bestApproximation.approxAlpha));
-        Ralpha.setAt(1, 2, -qSin(bestApproximation.approxAlpha));
-        Ralpha.setAt(2, 1, qSin(bestApproximation.approxAlpha));
-        Ralpha.setAt(2, 2, qCos(bestApproximation.approxAlpha));
-        Rbeta.setAt(0, 0, qCos(bestApproximation.approxBeta));
-        Rbeta.setAt(0, 2, qSin(bestApproximation.approxBeta));
-        Rbeta.setAt(1, 1, 1.0);
-        Rbeta.setAt(2, 0, -qSin(bestApproximation.approxBeta));
-        Rbeta.setAt(2, 2, qCos(bestApproximation.approxBeta));
-
-        Rall = Rbeta * Ralpha;
-        Rall.setAt(3,3,1.0);
-
-        for (int i=0; i<reducedInputObservations.size(); i++) {
-            reducedInputObservations[i].xyz = Rall * reducedInputObservations[i].xyz;
-            reducedInputObservations[i].xyz.setAt(3, 1.0);
-        }
-        for (int i=0; i<allReducedInputObservations.size(); i++) {
-            allReducedInputObservations[i].xyz = Rall * allReducedInputObservations[i].xyz;
-            allReducedInputObservations[i].xyz.setAt(3, 1.0);
+        QList<IdPoint> reducedInputObservations;
+        QList<IdPoint> allReducedInputObservations;
+        if(!this->reduceAndRotate(function, cylinder, points, usablePoints, approximationType, centroid, Rall,
+                                  bestApproximation, reducedInputObservations, allReducedInputObservations)){
+            return false;
         }
 
-        bestApproximation.approxAlpha = 0.0;
-        bestApproximation.approxBeta = 0.0;
-
-
         if(!this->fitCylinder(function, cylinder, reducedInputObservations, allReducedInputObservations, bestApproximation)){
             emit function->sendMessage(QString("Error while fitting cylinder %1 with solution: %2").arg(cylinder.getFeatureName()).arg(bestApproximation.comment), eErrorMessage);
             cylinder.setIsSolved(false);
@@ -402,30 +432,31 @@ protected:
 
 
         //transform cylinder position (centroid + rotation)
+        Mat4 RallInv = Rall.inv();
         Position cylinderPosition = cylinder.getPosition();
-        OiVec pos = (Rall.inv() * cylinderPosition.getVectorH()) + centroid;
+        Vec4 pos = (RallInv * Vec4(cylinderPosition.getVectorH())) + centroid;
         pos.setAt(3, 1.0);
-        cylinderPosition.setVector(pos);
+        cylinderPosition.setVector(pos.xyz());
 
         //transform cylinder axis (centroid + rotation)
         Direction cylinderAxis = cylinder.getDirection();
-        OiVec axis = (Rall.inv() * cylinderAxis.getVectorH());
-        axis.removeLast();
+        Vec3 axis = (RallInv * Vec4(cylinderAxis.getVectorH())).xyz();
         axis.normalize();
         cylinderAxis.setVector(axis);
 
 
-        OiVec direction(3);
+        Vec3 direction;
         switch(approximationType) {
             case eGuessAxis: {
                 break;
             }
             case eDirection: {
                 foreach(const InputElement &element, function->getInputElements()[1]){
-                    if(!element.geometry.isNull()
-                            && element.geometry->getIsSolved()
-                            && element.geometry->hasDirection()) {
-                        direction = element.geometry->getDirection().getVector();
+                    QPointer<Geometry> geometry = element.getGeometry();
+                    if(!geometry.isNull()
+                            && geometry->getIsSolved()
+                            && geometry->hasDirection()) {
+                        direction = geometry->getDirection().getVec3();
                         break;
                     }
                 }
@@ -434,22 +465,21 @@ protected:
             case eFirstTwoDummyPoint: {
                 QList<QPointer<Observation> > dummyPoints;
                 foreach(const InputElement &element, function->getInputElements()[InputElementKey::eDummyPoint]){
-                    if(!element.observation.isNull()
-                            && element.observation->getIsSolved()) {
-                        dummyPoints.append(element.observation);
+                    QPointer<Observation> observation = element.getObservation();
+                    if(!observation.isNull()
+                            && observation->getIsSolved()) {
+                        dummyPoints.append(observation);
                     }
                 }
                 if(dummyPoints.size() >= 2){
-                    OiVec diff = dummyPoints.at(1)->getXYZ() - dummyPoints.at(0)->getXYZ();
-                    diff.removeLast();
+                    Vec3 diff = Vec3(dummyPoints.at(1)->getXYZ()) - Vec3(dummyPoints.at(0)->getXYZ());
                     diff.normalize();
                     direction = diff;
                 }
                 break;
             }
             case eFirstTwoPoints: {
-                OiVec diff = points.at(1).xyz - points.at(0).xyz;
-                diff.removeLast();
+                Vec3 diff = Vec3(points.at(1).xyz) - Vec3(points.at(0).xyz);
                 diff.normalize();
                 direction = diff;
                 break;
@@ -460,7 +490,7 @@ protected:
         if  (!(direction.getAt(0) == 0
             && direction.getAt(1) == 0
             && direction.getAt(2) == 0)) {
-            OiVec::dot(angle, axis, direction);
+            angle = axis.dot(direction);
             angle = qAbs(qAcos(angle));
         }
 
@@ -478,6 +508,214 @@ protected:
 
     }
 
+    /*!
+     * \brief reduceAndRotate
+     * Approximates the cylinder axis using points, reduces points and usablePoints by the centroid of points and rotates
+     * them so that the approximate axis is parallel to z
+     * \param function
+     * \param cylinder
+     * \param points
+     * \param usablePoints
+     * \param approximationType
+     * \param centroid
+     * \param Rall
+     * \param bestApproximation approximation in the rotated system (alpha and beta are 0)
+     * \param reducedPoints
+     * \param allReducedPoints
+     * \return
+     */
+    bool reduceAndRotate(FitFunction *function, Cylinder &cylinder, const QList<IdPoint> &points, const QList<IdPoint> &usablePoints,
+                         const ApproximationTypes &approximationType, Vec4 &centroid, Mat4 &Rall, CylinderApproximation &bestApproximation,
+                         QList<IdPoint> &reducedPoints, QList<IdPoint> &allReducedPoints){
+
+        //calculate centroid of all observations
+        centroid = Vec4();
+        foreach(const IdPoint &point, points){
+            centroid += Vec4(point.xyz);
+        }
+        centroid /= (double)points.size();
+
+        //ids of the used points (avoids a linear search per usable point)
+        QSet<int> pointIds;
+        pointIds.reserve(points.size());
+        foreach(const IdPoint &point, points){
+            pointIds.insert(point.id);
+        }
+
+        // calculate centroid reduced observations
+        reducedPoints.clear();
+        allReducedPoints.clear();
+        foreach(const IdPoint &obs, usablePoints){
+            IdPoint rObs;
+            rObs.id = obs.id;
+            rObs.xyz = (Vec4(obs.xyz) - centroid).toOiVec();
+            allReducedPoints.append(rObs);
+            if(pointIds.contains(obs.id)) {
+                reducedPoints.append(rObs);
+            }
+        }
+
+        // approximate cylinder by 2D circle fit
+        if(!this->approximateCylinder(function, cylinder, reducedPoints, approximationType)){
+            emit function->sendMessage(QString("Error while generating approximations for cylinder parameters of cylinder %1").arg(cylinder.getFeatureName()), eErrorMessage);
+            return false;
+        }
+
+        // filter the best approximation
+        double bestStdev  = numeric_limits<double>::max();
+        foreach (const CylinderApproximation &approximation, approximations) {
+            qDebug() << "approximation" << approximation;
+            if(approximation.stdev < bestStdev) {
+                bestStdev = approximation.stdev;
+                bestApproximation = approximation;
+            }
+        }
+
+
+        qDebug() << "bestApproximation" << bestApproximation;
+
+        Rall = Mat4(Mat3::rotationY(bestApproximation.approxBeta) * Mat3::rotationX(bestApproximation.approxAlpha));
+
+        //rotate the reduced observations in place
+        for (int i=0; i<reducedPoints.size(); i++) {
+            Vec4 rotated = Rall * Vec4(reducedPoints[i].xyz);
+            rotated.setAt(3, 1.0);
+            rotated.assignTo(reducedPoints[i].xyz);
+        }
+        for (int i=0; i<allReducedPoints.size(); i++) {
+            Vec4 rotated = Rall * Vec4(allReducedPoints[i].xyz);
+            rotated.setAt(3, 1.0);
+            rotated.assignTo(allReducedPoints[i].xyz);
+        }
+
+        bestApproximation.approxAlpha = 0.0;
+        bestApproximation.approxBeta = 0.0;
+
+        return true;
+
+    }
+
+    /*!
+     * \brief rejectCylinderOutliers
+     * Removes the outliers from points and marks them as not used (robust fit mode).
+     * Outliers may tilt the approximate axis so far that a robust 2D circle fit around it fails. That is why the cylinder
+     * is fitted (least squares) to the points that are consistent with the previous fit first, until these points do not
+     * change anymore (points farther than 2.5 robust standard deviations or the robust threshold are not consistent).
+     * The outliers are then rejected by the robust estimator around the axis of the last fit.
+     * \param function
+     * \param cylinder
+     * \param points
+     * \param approximationType
+     * \return
+     */
+    bool rejectCylinderOutliers(FitFunction *function, Cylinder &cylinder, QList<IdPoint> &points, const ApproximationTypes &approximationType){
+
+        const RobustFitOptions options = RobustFitOptions::fromScalarInputParams(function->getScalarInputParams());
+
+        QList<IdPoint> consistentPoints = points;
+        QList<IdPoint> allReducedPoints;
+        Vec3 position, axis;
+        for(int iteration = 0; iteration < 10; iteration++){
+
+            //fit the cylinder to the consistent points (in the system of its approximate axis)
+            Vec4 centroid;
+            Mat4 Rall;
+            CylinderApproximation approximation;
+            QList<IdPoint> reducedPoints;
+            if(!this->reduceAndRotate(function, cylinder, consistentPoints, points, approximationType, centroid, Rall,
+                                      approximation, reducedPoints, allReducedPoints)){
+                return false;
+            }
+            double radius = 0.0;
+            if(this->fitCylinder(function, cylinder, reducedPoints, reducedPoints, approximation)){
+                position = cylinder.getPosition().getVec3();
+                axis = cylinder.getDirection().getVec3();
+                axis.normalize();
+                radius = cylinder.getRadius().getRadius();
+            }else{
+
+                //use the approximation if the least squares fit does not converge (e.g. because of the outliers)
+                position = Vec3(-approximation.approxXm, -approximation.approxYm, 0.0);
+                axis = Vec3(0.0, 0.0, 1.0);
+                radius = approximation.approxRadius;
+
+            }
+
+            //distances of all points from the fitted cylinder
+            QVector<double> distances;
+            distances.reserve(allReducedPoints.size());
+            foreach(const IdPoint &point, allReducedPoints){
+                distances.append(qAbs((Vec3(point.xyz) - position).cross(axis).length() - radius));
+            }
+
+            //robust standard deviation (median of the absolute distances)
+            QVector<double> sortedDistances = distances;
+            std::nth_element(sortedDistances.begin(), sortedDistances.begin() + sortedDistances.size() / 2, sortedDistances.end());
+            const double sigma = 1.4826 * sortedDistances.at(sortedDistances.size() / 2);
+            const double limit = qMax(2.5 * sigma, options.threshold);
+
+            //get the points that are consistent with the fitted cylinder
+            QList<IdPoint> nextPoints;
+            nextPoints.reserve(points.size());
+            for(int i = 0; i < points.size(); i++){
+                if(distances.at(i) < limit){
+                    nextPoints.append(points.at(i));
+                }
+            }
+            if(nextPoints.size() < 5){
+                emit function->sendMessage(QString("Robust fit found no consensus within a threshold of %1").arg(options.threshold), eErrorMessage);
+                return false;
+            }
+
+            bool isConverged = (nextPoints.size() == consistentPoints.size());
+            for(int i = 0; isConverged && i < nextPoints.size(); i++){
+                isConverged = (nextPoints.at(i).id == consistentPoints.at(i).id);
+            }
+            consistentPoints = nextPoints;
+            if(isConverged){
+                break;
+            }
+
+        }
+
+        //rotate all points so that the axis of the last fit is parallel to z
+        Vec3 u = axis.cross(qAbs(axis.x()) < 0.9 ? Vec3(1.0, 0.0, 0.0) : Vec3(0.0, 1.0, 0.0));
+        u.normalize();
+        const Vec3 v = axis.cross(u);
+        const Mat3 R(u.x(), u.y(), u.z(),
+                     v.x(), v.y(), v.z(),
+                     axis.x(), axis.y(), axis.z());
+        QList<IdPoint> rotatedPoints;
+        rotatedPoints.reserve(allReducedPoints.size());
+        foreach(const IdPoint &point, allReducedPoints){
+            IdPoint rotated;
+            rotated.id = point.id;
+            rotated.xyz = (R * (Vec3(point.xyz) - position)).toOiVec();
+            rotatedPoints.append(rotated);
+        }
+
+        //reject the outliers around the axis
+        if(!function->rejectOutliers(rotatedPoints, RobustFitCircle2DModel())){
+            return false;
+        }
+        QSet<int> inlierIds;
+        inlierIds.reserve(rotatedPoints.size());
+        foreach(const IdPoint &point, rotatedPoints){
+            inlierIds.insert(point.id);
+        }
+        QList<IdPoint> inliers;
+        inliers.reserve(inlierIds.size());
+        foreach(const IdPoint &point, points){
+            if(inlierIds.contains(point.id)){
+                inliers.append(point);
+            }
+        }
+        points = inliers;
+
+        return true;
+
+    }
+
     /*!
      * \brief approximateCylinder
      * \param cylinder
@@ -495,22 +733,17 @@ protected:
                 int numPoints = inputObservations.size();
 
                 //calculate centroid of all observations
-                OiVec centroid3D(4);
+                Vec3 centroid3D;
                 foreach(const IdPoint &obs, inputObservations){
-                    centroid3D = centroid3D + obs.xyz;
+                    centroid3D += Vec3(obs.xyz);
                 }
-                centroid3D.removeLast();
-                centroid3D = centroid3D / numPoints;
+                centroid3D /= numPoints;
 
                 //set up covariance matrix of all observations
-                OiMat H(3, 3);
-                for (int k = 0; k < numPoints; k++) {
-                    IdPoint obs = inputObservations.at(k);
-                    for (int i = 0; i < 3; i++) {
-                        for (int j = 0; j < 3; j++) {
-                            H.setAt(i,j, H.getAt(i, j) + (obs.xyz.getAt(i) - centroid3D.getAt(i)) * (obs.xyz.getAt(j) - centroid3D.getAt(j)));
-                        }
-                    }
+                Mat3 H;
+                foreach(const IdPoint &obs, inputObservations){
+                    Vec3 reduced = Vec3(obs.xyz) - centroid3D;
+                    H.addOuterProduct(reduced, reduced);
                 }
 
                 //singular value decomposition of H to get the major axis direction of the cylinder observations
@@ -518,7 +751,7 @@ protected:
                 OiVec d(3);
                 OiMat V(3, 3);
                 try{
-                    H.svd(U, d, V);
+                    H.toOiMat().svd(U, d, V);
                 }catch(const exception &e){
                     emit function->sendMessage(QString("SVD error cylinder minimum solution: %1").arg(e.what()), eErrorMessage);
                     return false;
@@ -526,10 +759,9 @@ protected:
 
                 //one of the eigen-vectors is the approximate cylinder axis
                 bool foundOneVaildApproximation = false;
+                Mat3 eigenvectors(U);
                 for(int i = 0; i < 3; i++){
-                    OiVec pn; //possible normal vector
-
-                    U.getCol(pn, i); //get eigenvector i
+                    Vec3 pn = eigenvectors.getCol(i); //possible normal vector
 
                     if(approximateCylinder(function, pn, inputObservations, QString("eigenvector %1").arg(i))) {
                         foundOneVaildApproximation = true;
@@ -546,16 +778,17 @@ protected:
                 Direction approxAxis;
                 // find first direction
                 foreach(const InputElement &element, function->getInputElements()[1]){
-                    if(!element.geometry.isNull()
-                            && element.geometry->getIsSolved()
-                            && element.geometry->hasDirection()) {
-                        approxAxis = element.geometry->getDirection();
+                    QPointer<Geometry> geometry = element.getGeometry();
+                    if(!geometry.isNull()
+                            && geometry->getIsSolved()
+                            && geometry->hasDirection()) {
+                        approxAxis = geometry->getDirection();
                         break;
                     }
 
                 }
                 // valid direction found
-                OiVec an = approxAxis.getVector();
+                Vec3 an = approxAxis.getVec3();
                 if  (!(an.getAt(0) == 0
                     && an.getAt(1) == 0
                     && an.getAt(2) == 0)) {
@@ -570,16 +803,16 @@ protected:
         case eFirstTwoDummyPoint: {
             QList<QPointer<Observation> > dummyPoints;
             foreach(const InputElement &element, function->getInputElements()[InputElementKey::eDummyPoint]){
-                if(!element.observation.isNull()
-                        && element.observation->getIsSolved()) {
-                    dummyPoints.append(element.observation);
+                QPointer<Observation> observation = element.getObservation();
+                if(!observation.isNull()
+                        && observation->getIsSolved()) {
+                    dummyPoints.append(observation);
                 }
             }
             if(dummyPoints.size() < 2){
                 return false;
             }
-            OiVec diff = dummyPoints.at(1)->getXYZ() - dummyPoints.at(0)->getXYZ();
-            diff.removeLast();
+            Vec3 diff = Vec3(dummyPoints.at(1)->getXYZ()) - Vec3(dummyPoints.at(0)->getXYZ());
 
             return approximateCylinder(function, diff, inputObservations, "first two dummy points");
 
@@ -591,8 +824,7 @@ protected:
                 //another approximation comes from the first two cylinder points
                 //##############################################################
 
-                OiVec diff = inputObservations.at(1).xyz - inputObservations.at(0).xyz;
-                diff.removeLast();
+                Vec3 diff = Vec3(inputObservations.at(1).xyz) - Vec3(inputObservations.at(0).xyz);
 
                 return approximateCylinder(function, diff, inputObservations, "first two cylinder points");
 
@@ -604,12 +836,12 @@ protected:
 
     }
 
-    bool approximateCylinder(FitFunction *function, OiVec pn, const QList<IdPoint> &inputObservations, QString label) {
+    bool approximateCylinder(FitFunction *function, Vec3 pn, const QList<IdPoint> &inputObservations, QString label) {
         //get the number of observations
         int numPoints = inputObservations.size();
 
         //init helper variables
-        OiVec centroid2D(2); //centroid of 2D circle
+        Vec3 centroid2D; //centroid of 2D circle (x, y)
 
         double a = 0.0, b = 0.0; //sin + cos of rotation angles
         double a_alpha = 0.0, b_alpha = 0.0, a_beta = 0.0, b_beta = 0.0; //possible rotation angles (check acos + asin)
@@ -617,19 +849,13 @@ protected:
         double _y = 0.0, _z = 0.0;
         double tx = 0.0, ty = 0.0; //transformed 2D coordinates
         double x_m = 0.0, y_m = 0.0, radius = 0.0, sum_vv = 0.0; //result parameters in circle fit
-        OiVec v;
-
-        //rotation matrices
-        OiMat Ralpha(3, 3);
-        OiMat Rbeta(3, 3);
-        OiMat Rall(3, 3);
 
-        //a matrices for circle adjustment
-        OiVec A1(numPoints);
-        OiMat A2(numPoints,3);
+        //normal equations for circle adjustment (A2T * A2 and A2T * A1)
+        Mat3 A2TA2;
+        Vec3 A2TA1;
 
         //result vector for circle fit
-        OiVec s(3);
+        Vec3 s;
 
         //rotated 2D points
         QList<float> points2D_x;
@@ -700,19 +926,8 @@ protected:
             beta = this->getCorrespondingCos(b_beta);
         }
 
-        //set up rotation matrices
-        Ralpha.setAt(0, 0, 1.0);
-        Ralpha.setAt(1, 1, qCos(alpha));
-        Ralpha.setAt(1, 2, -qSin(alpha));
-        Ralpha.setAt(2, 1, qSin(alpha));
-        Ralpha.setAt(2, 2, qCos(alpha));
-        Rbeta.setAt(0, 0, qCos(beta));
-        Rbeta.setAt(0, 2, qSin(beta));
-        Rbeta.setAt(1, 1, 1.0);
-        Rbeta.setAt(2, 0, -qSin(beta));
-        Rbeta.setAt(2, 2, qCos(beta));
-
-        Rall = Rbeta * Ralpha;
+        //set up rotation matrix
+        Mat3 Rall = Mat3::rotationY(beta) * Mat3::rotationX(alpha);
 
         //###########################################
         //circle fit to determine midpoint and radius
@@ -725,7 +940,7 @@ protected:
         centroidreduced2D_y.clear();
 
         //reset 2D centroid and recalculate with new rotation
-        centroid2D = OiVec(2);
+        centroid2D = Vec3();
 
         //rotate observations in XY-plane and calculate 2D centroid
         for(int j = 0; j < numPoints; j++){
@@ -755,25 +970,19 @@ protected:
             centroidreduced2D_y.append( points2D_y.at(j) - centroid2D.getAt(1) );
         }
 
-        //fill a matrices
+        //accumulate normal equations
         for(int j = 0; j < numPoints; j++){
             tx = centroidreduced2D_x.at(j);
             ty = centroidreduced2D_y.at(j);
 
-            A1.setAt(j, tx*tx + ty*ty);
-
-            A2.setAt(j,0,tx);
-            A2.setAt(j,1,ty);
-            A2.setAt(j,2,1.0);
+            Vec3 a2(tx, ty, 1.0);
+            A2TA2.addOuterProduct(a2, a2);
+            A2TA1 += (tx*tx + ty*ty) * a2;
         }
 
         //solve equation system to get circle parameters
-        try{
-            if(!OiMat::solve(s, A2.t() * A2, -1.0 * A2.t() * A1)){
-                return false;
-            }
-        }catch(const exception &e){
-            emit function->sendMessage(QString("inv error cylinder minimum solution: %1").arg(e.what()), eErrorMessage);
+        if(!Mat3::solve(s, A2TA2, -1.0 * A2TA1)){
+            emit function->sendMessage(QString("inv error cylinder minimum solution: singular normal equation matrix"), eErrorMessage);
             return false;
         }
 
@@ -782,9 +991,14 @@ protected:
         y_m = (-1.0 * s.getAt(1) / 2.0) + centroid2D.getAt(1);
         radius = qSqrt(0.25 * (s.getAt(0) * s.getAt(0) + s.getAt(1) * s.getAt(1)) - s.getAt(2));
 
-        //calculate statistic
-        v = -1.0 * A1 - A2 * s;
-        OiVec::dot(sum_vv, v,v);
+        //calculate statistic (v = -A1 - A2 * s)
+        for(int j = 0; j < numPoints; j++){
+            tx = centroidreduced2D_x.at(j);
+            ty = centroidreduced2D_y.at(j);
+
+            double v_j = -1.0 * (tx*tx + ty*ty) - (tx * s.x() + ty * s.y() + s.z());
+            sum_vv += v_j * v_j;
+        }
         sum_vv = qSqrt(sum_vv / (numPoints-3.0));
 
         //add approximation
@@ -814,13 +1028,15 @@ protected:
         const int numPoints = inputObservations.size();
 
         //centroids of all points
-        OiVec centroid(4);
+        Vec4 centroid;
 
         //initialize variables
         OiVec v(numPoints*3); //approximation of corrections
         OiVec L0(numPoints*3); //L + v
         OiVec c(numPoints+5); //right side
-        OiMat N(numPoints+5, numPoints+5); //normal equation matrix
+        OiMat A(numPoints, 5); //design matrix of the unknowns
+        OiVec BBT(numPoints); //diagonal of BBT (one condition equation per point)
+        OiMat N; //normal equation matrix (only set up for the dense solver)
         OiVec res(numPoints+5); //adjustment result
         double _r = 0.0, _X0 = 0.0, _Y0 = 0.0, _alpha = 0.0, _beta = 0.0;
         double _r_armijo = 0.0, _X0_armijo = 0.0, _Y0_armijo = 0.0, _alpha_armijo = 0.0, _beta_armijo = 0.0;
@@ -830,12 +1046,15 @@ protected:
         OiVec b(numPoints);
         double _x = 0.0, _y = 0.0, _z = 0.0;
         double _x_armijo = 0.0, _y_armijo = 0.0, _z_armijo = 0.0;
-        double a1 = 0.0, a2 = 0.0;
+        double a1 = 0.0, a2 = 0.0, a12 = 0.0;
+        double b1 = 0.0, b2 = 0.0, b3 = 0.0;
         double diff = 0.0, _xr = 0.0, _yr = 0.0;
         double sigma = 2.0;
-        OiMat Ralpha(3, 3);
-        OiMat Rbeta(3, 3);
-        OiMat Rall(3, 3);
+        Mat3 Rall;
+
+        if(this->normalEquationSolver == eDenseNormalEquation){
+            N = OiMat(numPoints+5, numPoints+5);
+        }
 
         //set approximations of unknowns
         _r = approximation.approxRadius;
@@ -854,11 +1073,10 @@ protected:
             L0.setAt(i*3+1, obs.xyz.getAt(1));
             L0.setAt(i*3+2, obs.xyz.getAt(2));
 
-            centroid = centroid + obs.xyz;
+            centroid += Vec4(obs.xyz);
 
         }
-        centroid.removeLast();
-        centroid = centroid / (double)numPoints;
+        centroid /= (double)numPoints;
 
         int numIterations = 0;
 
@@ -875,19 +1093,8 @@ protected:
             //improve observations
             //L0 = L0 + v;
 
-            //build rotation matrices
-            Ralpha.setAt(0, 0, 1.0);
-            Ralpha.setAt(1, 1, qCos(_alpha));
-            Ralpha.setAt(1, 2, -qSin(_alpha));
-            Ralpha.setAt(2, 1, qSin(_alpha));
-            Ralpha.setAt(2, 2, qCos(_alpha));
-            Rbeta.setAt(0, 0, qCos(_beta));
-            Rbeta.setAt(0, 2, qSin(_beta));
-            Rbeta.setAt(1, 1, 1.0);
-            Rbeta.setAt(2, 0, -qSin(_beta));
-            Rbeta.setAt(2, 2, qCos(_beta));
-
-            Rall = Rbeta * Ralpha;
+            //build rotation matrix
+            Rall = Mat3::rotationY(_beta) * Mat3::rotationX(_alpha);
 
             //fill A and B matrix + w vector + right side
             for(int i = 0; i < numPoints; i++){
@@ -898,25 +1105,20 @@ protected:
 
                 a1 = _X0 + _x * qCos(_beta) + _y * qSin(_alpha) * qSin(_beta) + _z * qCos(_alpha) * qSin(_beta);
                 a2 = _Y0 + _y * qCos(_alpha) - _z * qSin(_alpha);
+                a12 = qSqrt(a1*a1 + a2*a2);
 
                 //A
-                N.setAt(i, numPoints, 1.0);
-                N.setAt(i, numPoints+1, -1.0 * a1 / qSqrt(a1*a1 + a2*a2));
-                N.setAt(i, numPoints+2, -1.0 * a2 / qSqrt(a1*a1 + a2*a2));
-                N.setAt(i, numPoints+3, -1.0 * ((_y * qSin(_beta) * qCos(_alpha) - _z * qSin(_beta) * qSin(_alpha)) * a1 - (_y * qSin(_alpha) + _z * qCos(_alpha)) * a2) / qSqrt(a1*a1 + a2*a2));
-                N.setAt(i, numPoints+4, -1.0 * (_y * qSin(_alpha) * qCos(_beta) - _x * qSin(_beta) + _z * qCos(_alpha) * qCos(_beta)) * a1 / qSqrt(a1*a1 + a2*a2));
-
-                //AT
-                N.setAt(numPoints, i, 1.0);
-                N.setAt(numPoints+1, i, -1.0 * a1 / qSqrt(a1*a1 + a2*a2));
-                N.setAt(numPoints+2, i, -1.0 * a2 / qSqrt(a1*a1 + a2*a2));
-                N.setAt(numPoints+3, i, -1.0 * ((_y * qSin(_beta) * qCos(_alpha) - _z * qSin(_beta) * qSin(_alpha)) * a1 - (_y * qSin(_alpha) + _z * qCos(_alpha)) * a2) / qSqrt(a1*a1 + a2*a2));
-                N.setAt(numPoints+4, i, -1.0 * (_y * qSin(_alpha) * qCos(_beta) - _x * qSin(_beta) + _z * qCos(_alpha) * qCos(_beta)) * a1 / qSqrt(a1*a1 + a2*a2));
+                A.setAt(i, 0, 1.0);
+                A.setAt(i, 1, -1.0 * a1 / a12);
+                A.setAt(i, 2, -1.0 * a2 / a12);
+                A.setAt(i, 3, -1.0 * ((_y * qSin(_beta) * qCos(_alpha) - _z * qSin(_beta) * qSin(_alpha)) * a1 - (_y * qSin(_alpha) + _z * qCos(_alpha)) * a2) / a12);
+                A.setAt(i, 4, -1.0 * (_y * qSin(_alpha) * qCos(_beta) - _x * qSin(_beta) + _z * qCos(_alpha) * qCos(_beta)) * a1 / a12);
 
                 //BBT
-                N.setAt(i, i, (-1.0 * qCos(_beta) * a1 / qSqrt(a1*a1 + a2*a2))*(-1.0 * qCos(_beta) * a1 / qSqrt(a1*a1 + a2*a2))
-                            + (-1.0 * (qSin(_alpha) * qSin(_beta) * a1 + qCos(_alpha) * a2) / qSqrt(a1*a1 + a2*a2))*(-1.0 * (qSin(_alpha) * qSin(_beta) * a1 + qCos(_alpha) * a2) / qSqrt(a1*a1 + a2*a2))
-                            + (-1.0 * (qCos(_alpha) * qSin(_beta) * a1 - qSin(_alpha) * a2) / qSqrt(a1*a1 + a2*a2))*(-1.0 * (qCos(_alpha) * qSin(_beta) * a1 - qSin(_alpha) * a2) / qSqrt(a1*a1 + a2*a2)));
+                b1 = -1.0 * qCos(_beta) * a1 / a12;
+                b2 = -1.0 * (qSin(_alpha) * qSin(_beta) * a1 + qCos(_alpha) * a2) / a12;
+                b3 = -1.0 * (qCos(_alpha) * qSin(_beta) * a1 - qSin(_alpha) * a2) / a12;
+                BBT.setAt(i, b1*b1 + b2*b2 + b3*b3);
 
                 _xr = Rall.getAt(0,0) * _x + Rall.getAt(0,1) * _y + Rall.getAt(0,2) * _z + _X0;
                 _yr = Rall.getAt(1,0) * _x + Rall.getAt(1,1) * _y + Rall.getAt(1,2) * _z + _Y0;
@@ -930,7 +1132,13 @@ protected:
 
             //solve the normal equation system
             try{
-                if(!OiMat::solve(res, N, -1.0*c)){
+                bool solved = false;
+                if(this->normalEquationSolver == eDenseNormalEquation){
+                    solved = this->solveDenseNormalEquation(res, N, A, BBT, c);
+                }else{
+                    solved = this->solveReducedNormalEquation(res, A, BBT, c);
+                }
+                if(!solved){
                     emit function->sendMessage(QString("solve error cylinder fit"), eErrorMessage);
                     return false;
                 }
@@ -1087,41 +1295,33 @@ protected:
         _alpha += x.getAt(3);
         _beta += x.getAt(4);
 
-        //calculate rotation matrices
-        Ralpha.setAt(0, 0, 1.0);
-        Ralpha.setAt(1, 1, qCos(_alpha));
-        Ralpha.setAt(1, 2, -qSin(_alpha));
-        Ralpha.setAt(2, 1, qSin(_alpha));
-        Ralpha.setAt(2, 2, qCos(_alpha));
-        Rbeta.setAt(0, 0, qCos(_beta));
-        Rbeta.setAt(0, 2, qSin(_beta));
-        Rbeta.setAt(1, 1, 1.0);
-        Rbeta.setAt(2, 0, -qSin(_beta));
-        Rbeta.setAt(2, 2, qCos(_beta));
-
-        Rall = Rbeta * Ralpha;
+        //calculate rotation matrix
+        Rall = Mat3::rotationY(_beta) * Mat3::rotationX(_alpha);
 
         //calculate point on cylinder axis
-        OiVec xyz(3);
-        xyz.setAt(0, _X0);
-        xyz.setAt(1, _Y0);
-        xyz.setAt(2, 0.0);
-        OiMat::solve(xyz, Rall, -1.0 * xyz);
+        Vec3 xyz(_X0, _Y0, 0.0);
+        Mat3::solve(xyz, Rall, -1.0 * xyz);
 
         //calculate cylinder axis
-        OiVec axis(3);
-        axis.setAt(2, 1.0);
-        OiMat::solve(axis, Rall, axis);
+        Vec3 axis(0.0, 0.0, 1.0);
+        Mat3::solve(axis, Rall, axis);
 
         // reset / clear statistic
         function->statistic.reset();
 
+        //ids of the used observations
+        QSet<int> inputIds;
+        inputIds.reserve(numPoints);
+        foreach(const IdPoint &observation, inputObservations){
+            inputIds.insert(observation.id);
+        }
+
         //calculate sum vv
         double sumVV = 0.0;
         float vrMin = numeric_limits<float>::max();
         float vrMax = numeric_limits<float>::min();
         foreach(const IdPoint &observation, allUsableObservations){
-            OiVec v_obs(3);
+            Vec3 v_obs;
             _x = observation.xyz.getAt(0);
             _y = observation.xyz.getAt(1);
             _z = observation.xyz.getAt(2);
@@ -1143,7 +1343,7 @@ protected:
             float distance = 0.0f;
 
             distance = radiusActual - _r; //distance error
-            if(inputObservations.contains(observation)) { // calculate form error from "used" observations
+            if(inputIds.contains(observation.id)) { // calculate form error from "used" observations
                 vrMin = min(vrMin, distance);
                 vrMax = max(vrMax, distance);
             }
@@ -1163,7 +1363,7 @@ protected:
                 function->addDisplayResidual(observation.id, distance);
             }
 
-            if(inputObservations.contains(observation)) {
+            if(inputIds.contains(observation.id)) {
                 sumVV += distance * distance;
             }
 
@@ -1184,6 +1384,109 @@ protected:
 
     }
 
+    /*!
+     * \brief solveDenseNormalEquation
+     * Sets up the full normal equation matrix [BBT A; AT 0] and solves it for the right side -c
+     * \param res correlates of the n condition equations followed by the 5 unknowns
+     * \param N normal equation matrix with (n+5)x(n+5) elements
+     * \param A design matrix of the unknowns (n x 5)
+     * \param BBT diagonal of the BBT block
+     * \param c contradictions (the last 5 elements are 0)
+     * \return
+     */
+    bool solveDenseNormalEquation(OiVec &res, OiMat &N, const OiMat &A, const OiVec &BBT, const OiVec &c){
+
+        const int numPoints = BBT.getSize();
+
+        for(int i = 0; i < numPoints; i++){
+
+            //A and AT
+            for(int j = 0; j < 5; j++){
+                N.setAt(i, numPoints+j, A.getAt(i, j));
+                N.setAt(numPoints+j, i, A.getAt(i, j));
+            }
+
+            //BBT
+            N.setAt(i, i, BBT.getAt(i));
+
+        }
+
+        return OiMat::solve(res, N, -1.0*c);
+
+    }
+
+    /*!
+     * \brief solveReducedNormalEquation
+     * Solves the same system as solveDenseNormalEquation without setting up the full matrix.
+     * Since BBT is diagonal the correlates k can be eliminated:
+     * k = BBT^-1 * (-c - A*x) and (AT * BBT^-1 * A) * x = -AT * BBT^-1 * c
+     * Thus only a 5x5 system has to be solved and the effort grows linearly with the number of points
+     * \param res correlates of the n condition equations followed by the 5 unknowns
+     * \param A design matrix of the unknowns (n x 5)
+     * \param BBT diagonal of the BBT block
+     * \param c contradictions (the last 5 elements are 0)
+     * \return
+     */
+    bool solveReducedNormalEquation(OiVec &res, const OiMat &A, const OiVec &BBT, const OiVec &c){
+
+        const int numPoints = BBT.getSize();
+
+        //accumulate reduced normal equation matrix and right side
+        double n[5][5] = {};
+        double r[5] = {};
+        double row[5];
+        for(int i = 0; i < numPoints; i++){
+
+            const double w = BBT.getAt(i);
+            if(w == 0.0){
+                return false;
+            }
+
+            for(int j = 0; j < 5; j++){
+                row[j] = A.getAt(i, j);
+            }
+            for(int j = 0; j < 5; j++){
+                const double rw = row[j] / w;
+                r[j] -= rw * c.getAt(i);
+                for(int k = j; k < 5; k++){
+                    n[j][k] += rw * row[k];
+                }
+            }
+
+        }
+
+        OiMat Nred(5, 5);
+        OiVec rred(5);
+        for(int j = 0; j < 5; j++){
+            rred.setAt(j, r[j]);
+            for(int k = j; k < 5; k++){
+                Nred.setAt(j, k, n[j][k]);
+                Nred.setAt(k, j, n[j][k]);
+            }
+        }
+
+        //solve for the unknowns
+        OiVec x(5);
+        if(!OiMat::solve(x, Nred, rred)){
+            return false;
+        }
+
+        //back substitution of the correlates
+        for(int i = 0; i < numPoints; i++){
+            double ax = 0.0;
+            for(int j = 0; j < 5; j++){
+                ax += A.getAt(i, j) * x.getAt(j);
+            }
+            res.setAt(i, (-1.0 * c.getAt(i) - ax) / BBT.getAt(i));
+        }
+        for(int j = 0; j < 5; j++){
+            res.setAt(numPoints+j, x.getAt(j));
+        }
+
+        return true;
+
+    }
+
     /*!
      * \brief getCorrespondingCos
      * \param a
@@ -2,6 +2,8 @@
 #define FUNCTION_H
 
 #include <QMap>
+#include <QHash>
+#include <QSet>
 #include <QMultiMap>
 #include <QStringList>
 #include <QtXml>
@@ -65,12 +67,14 @@ public:
 
 /*!
  * \brief The InputElement class
- * Save the input elements that are used to solve a function
+ * Save the input elements that are used to solve a function.
+ * The element itself is held by one guarded pointer and is accessed by the typed getters
+ * (only the getter that matches typeOfElement returns a valid pointer)
  */
 class InputElement{
 public:
-    InputElement() : isUsed(true), shouldBeUsed(true), id(-1){}
-    InputElement(const int &id) : isUsed(true), shouldBeUsed(true), id(id){}
+    InputElement() : isUsed(true), shouldBeUsed(true), id(-1), typeOfElement(eUndefinedElement){}
+    InputElement(const int &id) : isUsed(true), shouldBeUsed(true), id(id), typeOfElement(eUndefinedElement){}
 
     //! custom comparison operator to compare input elements by their id
     bool operator==(const InputElement &other){
@@ -92,41 +96,59 @@ public:
     bool shouldBeUsed; //true if this element should be used in function calculation (user specified)
     bool isUsed; //true if this element is used in function calculation (plugin specified)
 
-    //element pointers (only valid for the specified element type)
-    QPointer<Station> station;
-    QPointer<CoordinateSystem> coordSystem;
-    QPointer<TrafoParam> trafoParam;
-
-    QPointer<Circle> circle;
-    QPointer<Cone> cone;
-    QPointer<Cylinder> cylinder;
-    QPointer<Ellipse> ellipse;
-    QPointer<Ellipsoid> ellipsoid;
-    QPointer<Hyperboloid> hyperboloid;
-    QPointer<Line> line;
-    QPointer<Nurbs> nurbs;
-    QPointer<Paraboloid> paraboloid;
-    QPointer<Plane> plane;
-    QPointer<Point> point;
-    QPointer<PointCloud> pointCloud;
-    QPointer<ScalarEntityAngle> scalarEntityAngle;
-    QPointer<ScalarEntityDistance> scalarEntityDistance;
-    QPointer<ScalarEntityMeasurementSeries> scalarEntityMeasurementSeries;
-    QPointer<ScalarEntityTemperature> scalarEntityTemperature;
-    QPointer<SlottedHole> slottedHole;
-    QPointer<Sphere> sphere;
-    QPointer<Torus> torus;
-
-    QPointer<Geometry> geometry;
-
-    QPointer<Observation> observation;
-    QPointer<Reading> polarReading;
-    QPointer<Reading> directionReading;
-    QPointer<Reading> distanceReading;
-    QPointer<Reading> cartesianReading;
-    QPointer<Reading> temperatureReading;
-    QPointer<Reading> levelReading;
-    QPointer<Reading> undefinedReading;
+    //####################################################
+    //set the element (typeOfElement has to be set before)
+    //####################################################
+
+    template<class T> void setElement(const QPointer<T> &element){
+        this->element = element.data();
+    }
+
+    //##########################################################
+    //typed access to the element (only valid for typeOfElement)
+    //##########################################################
+
+    QPointer<Station> getStation() const{ return this->getElement<Station>(this->typeOfElement == eStationElement); }
+    QPointer<CoordinateSystem> getCoordinateSystem() const{ return this->getElement<CoordinateSystem>(this->typeOfElement == eCoordinateSystemElement); }
+    QPointer<TrafoParam> getTrafoParam() const{ return this->getElement<TrafoParam>(this->typeOfElement == eTrafoParamElement); }
+
+    QPointer<Circle> getCircle() const{ return this->getElement<Circle>(this->typeOfElement == eCircleElement); }
+    QPointer<Cone> getCone() const{ return this->getElement<Cone>(this->typeOfElement == eConeElement); }
+    QPointer<Cylinder> getCylinder() const{ return this->getElement<Cylinder>(this->typeOfElement == eCylinderElement); }
+    QPointer<Ellipse> getEllipse() const{ return this->getElement<Ellipse>(this->typeOfElement == eEllipseElement); }
+    QPointer<Ellipsoid> getEllipsoid() const{ return this->getElement<Ellipsoid>(this->typeOfElement == eEllipsoidElement); }
+    QPointer<Hyperboloid> getHyperboloid() const{ return this->getElement<Hyperboloid>(this->typeOfElement == eHyperboloidElement); }
+    QPointer<Line> getLine() const{ return this->getElement<Line>(this->typeOfElement == eLineElement); }
+    QPointer<Nurbs> getNurbs() const{ return this->getElement<Nurbs>(this->typeOfElement == eNurbsElement); }
+    QPointer<Paraboloid> getParaboloid() const{ return this->getElement<Paraboloid>(this->typeOfElement == eParaboloidElement); }
+    QPointer<Plane> getPlane() const{ return this->getElement<Plane>(this->typeOfElement == ePlaneElement); }
+    QPointer<Point> getPoint() const{ return this->getElement<Point>(this->typeOfElement == ePointElement); }
+    QPointer<PointCloud> getPointCloud() const{ return this->getElement<PointCloud>(this->typeOfElement == ePointCloudElement); }
+    QPointer<ScalarEntityAngle> getScalarEntityAngle() const{ return this->getElement<ScalarEntityAngle>(this->typeOfElement == eScalarEntityAngleElement); }
+    QPointer<ScalarEntityDistance> getScalarEntityDistance() const{ return this->getElement<ScalarEntityDistance>(this->typeOfElement == eScalarEntityDistanceElement); }
+    QPointer<ScalarEntityMeasurementSeries> getScalarEntityMeasurementSeries() const{ return this->getElement<ScalarEntityMeasurementSeries>(this->typeOfElement == eScalarEntityMeasurementSeriesElement); }
+    QPointer<ScalarEntityTemperature> getScalarEntityTemperature() const{ return this->getElement<ScalarEntityTemperature>(this->typeOfElement == eScalarEntityTemperatureElement); }
+    QPointer<SlottedHole> getSlottedHole() const{ return this->getElement<SlottedHole>(this->typeOfElement == eSlottedHoleElement); }
+    QPointer<Sphere> getSphere() const{ return this->getElement<Sphere>(this->typeOfElement == eSphereElement); }
+    QPointer<Torus> getTorus() const{ return this->getElement<Torus>(this->typeOfElement == eTorusElement); }
+
+    //valid for all geometry types and for direction, position and radius elements
+    QPointer<Geometry> getGeometry() const{ return this->getElement<Geometry>(this->typeOfElement >= eCircleElement && this->typeOfElement <= eRadiusElement); }
+
+    QPointer<Observation> getObservation() const{ return this->getElement<Observation>(this->typeOfElement == eObservationElement); }
+    QPointer<Reading> getReading() const{ return this->getElement<Reading>(getIsReading(this->typeOfElement)); }
+
+private:
+
+    template<class T> QPointer<T> getElement(const bool &isValidType) const{
+        if(!isValidType || this->element.isNull()){
+            return QPointer<T>();
+        }
+        return QPointer<T>(static_cast<T *>(this->element.data()));
+    }
+
+    QPointer<QObject> element; //the element of type typeOfElement
+
 };
 
 /*!
@@ -221,10 +243,11 @@ public:
     //###################
 
     const QMap<int, QList<InputElement> > &getInputElements() const;
-    InputElement getInputElement(const int &id) const;
-    InputElement getInputElement(const int &id, const int &position) const;
+    const InputElement &getInputElement(const int &id) const;
+    const InputElement &getInputElement(const int &id, const int &position) const;
     bool hasInputElement(const int &id) const;
     void addInputElement(const InputElement &element, const int &position);
+    void addInputElements(const QList<InputElement> &elements, const int &position);
     void removeInputElement(const int &id, const int &position);
     void removeInputElement(const int &id);
     void replaceInputElement(const InputElement &element, const int &position);
@@ -236,6 +259,7 @@ public:
     bool getIsUsed(const int &position, const int &id);
     bool getShouldBeUsed(const int &position, const int &id);
     void setShouldBeUsed(const int &position, const int &id, const bool &state);
+    int setShouldBeUsed(const int &position, const QSet<int> &ids, const bool &state);
 
     //#############
     //clear results
@@ -251,6 +275,8 @@ public:
     QDomElement toOpenIndyXML(QDomDocument &xmlDoc) const;
     bool fromOpenIndyXML(QDomElement &xmlElem);
 
+    void toOpenIndyXML(QXmlStreamWriter &xmlWriter, const int &executionIndex = -1) const;
+
 signals:
 
     //################################################
@@ -332,11 +358,23 @@ protected:
 
     QMap<int, QList<InputElement> > inputElements;
 
+    int getInputElementIndex(const int &position, const int &id) const;
+
     void filterObservations(QList<QPointer<Observation> > &allUsableObservations, QList<QPointer<Observation> > &inputObservations);
     void addDisplayResidual(int elementId, double vr);
     void addDisplayResidual(int elementId, double vx, double vy, double vz, double v);
     void addDisplayResidual(int elementId, double vx, double vy, double vz, double v, double vi, double vj, double vk);
 
+private:
+
+    //#########################################
+    //index of the input elements at a position
+    //#########################################
+
+    QMultiHash<int, int> &syncInputElementIndex(const int &position);
+
+    QHash<int, QMultiHash<int, int> > inputElementIndices; //position -> element id -> indices in inputElements[position]
+
 };
 
 }
@@ -0,0 +1,129 @@
+#ifndef ROBUSTFIT_H
+#define ROBUSTFIT_H
+
+#include <QVector>
+#include <QString>
+
+#include "fixedmath.h"
+#include "types.h"
+
+namespace oi{
+
+/*!
+ * \brief The RobustFitTypes enum
+ * Defines how outliers are rejected before a least squares fit
+ */
+enum RobustFitTypes{
+    eNoRobustFit = 0, //use all points
+    eRansacFit, //maximize the number of inliers
+    eMsacFit //minimize the truncated squared distances (inliers are scored by their distance)
+};
+
+/*!
+ * \brief The RobustFitOptions class
+ * Configuration of the robust estimator. Fit functions read it from their scalar input parameters:
+ * "robust fit" (none, RANSAC or MSAC), "robust threshold", "robust confidence", "robust iterations",
+ * "robust threads" and "robust seed"
+ */
+class OI_CORE_EXPORT RobustFitOptions{
+public:
+    RobustFitOptions();
+
+    static RobustFitOptions fromScalarInputParams(const ScalarInputParams &params);
+
+    RobustFitTypes type;
+    double threshold; //maximum distance of an inlier from the model
+    double confidence; //probability of having drawn at least one outlier free sample (early termination)
+    int maxIterations; //maximum number of hypotheses
+    int numThreads; //number of threads that evaluate hypotheses (0 = ideal thread count)
+    quint32 seed; //seed of the sampling (equal seeds lead to equal hypotheses)
+};
+
+/*!
+ * \brief The RobustFitParameters class
+ * Parameters of a model hypothesis
+ */
+class OI_CORE_EXPORT RobustFitParameters{
+public:
+    RobustFitParameters(){
+        for(int i = 0; i < 8; i++){
+            values[i] = 0.0;
+        }
+    }
+
+    double values[8];
+};
+
+/*!
+ * \brief The RobustFitModel class
+ * Geometry that can be estimated from a minimal sample of points
+ */
+class OI_CORE_EXPORT RobustFitModel{
+public:
+    virtual ~RobustFitModel(){}
+
+    //number of points needed to estimate a hypothesis
+    virtual int getSampleSize() const = 0;
+
+    //estimate a hypothesis from the sample (returns false for degenerate samples)
+    virtual bool estimate(const Vec3 *sample, RobustFitParameters &parameters) const = 0;
+
+    //distance of a point from the hypothesis
+    virtual double getDistance(const RobustFitParameters &parameters, const Vec3 &point) const = 0;
+};
+
+/*!
+ * \brief The RobustFitCircleModel class
+ * Circle in 3D space through three points (center, normal, radius)
+ */
+class OI_CORE_EXPORT RobustFitCircleModel : public RobustFitModel{
+public:
+    int getSampleSize() const;
+    bool estimate(const Vec3 *sample, RobustFitParameters &parameters) const;
+    double getDistance(const RobustFitParameters &parameters, const Vec3 &point) const;
+};
+
+/*!
+ * \brief The RobustFitCircle2DModel class
+ * Circle in the xy plane through three points, the z coordinate is ignored
+ * (a cylinder whose axis is parallel to z)
+ */
+class OI_CORE_EXPORT RobustFitCircle2DModel : public RobustFitModel{
+public:
+    int getSampleSize() const;
+    bool estimate(const Vec3 *sample, RobustFitParameters &parameters) const;
+    double getDistance(const RobustFitParameters &parameters, const Vec3 &point) const;
+};
+
+/*!
+ * \brief The RobustFitResult class
+ */
+class OI_CORE_EXPORT RobustFitResult{
+public:
+    RobustFitResult() : isValid(false), numInliers(0), numHypotheses(0), cost(0.0){}
+
+    bool isValid;
+    RobustFitParameters parameters; //best hypothesis
+    QVector<bool> inliers; //inlier flag of each point
+    int numInliers;
+    int numHypotheses; //number of evaluated hypotheses
+    double cost;
+};
+
+/*!
+ * \brief The RobustEstimator class
+ * RANSAC / MSAC estimator that evaluates hypotheses in parallel.
+ * Hypothesis i is always drawn from the same sample (depending on the seed only), so that the result does not depend
+ * on the number of threads. The number of hypotheses is reduced as soon as the inlier ratio of the best hypothesis
+ * guarantees an outlier free sample with the configured confidence.
+ */
+class OI_CORE_EXPORT RobustEstimator{
+public:
+    static RobustFitResult estimate(const RobustFitModel &model, const QVector<Vec3> &points, const RobustFitOptions &options);
+
+    static int getRequiredIterations(const double &inlierRatio, const int &sampleSize, const double &confidence, const int &maxIterations);
+};
+
+}
+
+#endif // ROBUSTFIT_H
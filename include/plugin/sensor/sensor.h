@@ -16,6 +16,7 @@
 #include "types.h"
 #include "util.h"
 #include "reading.h"
+#include "sensorstream.h"
 
 namespace oi{
 
@@ -103,6 +104,10 @@ public:
     virtual QList<QPointer<Reading> > measure(const MeasurementConfig &mConfig) = 0;
     virtual QVariantMap readingStream(const ReadingTypes &streamFormat) = 0;
 
+    //typed reading stream (optional): sensors that stream typed samples are not polled with readingStream
+    virtual bool isReadingStreamTyped() const;
+    virtual bool readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample);
+
     //status information
     virtual bool getConnectionState() = 0;
     virtual bool getIsReadyForMeasurement() = 0;
@@ -133,6 +138,7 @@ signals:
     void asyncSensorResponse(const QJsonObject &response);
     void asyncMeasurementResult(const int &geomId, const QList<QPointer<Reading> > &measurements);
     void asyncStreamResult(const QVariantMap &reading);
+    void asyncStreamSample(const RealTimeReading &sample);
     void asyncSensorNotification(const QJsonObject &response);
 };
 
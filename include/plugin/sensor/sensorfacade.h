@@ -81,6 +81,8 @@ public:
     //measurements
     QList<QPointer<Reading> > measure(const MeasurementConfig &mConfig);
     QVariantMap readingStream(const ReadingTypes &streamFormat);
+    bool isReadingStreamTyped() const;
+    bool readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample);
 
     //status information
     bool getConnectionState();
@@ -0,0 +1,259 @@
+#ifndef SIMULATEDSENSOR_H
+#define SIMULATEDSENSOR_H
+
+#include <QMutex>
+#include <QElapsedTimer>
+
+#include "lasertracker.h"
+#include "totalstation.h"
+#include "geometry.h"
+#include "fixedmath.h"
+
+namespace oi{
+
+/*!
+ * \brief The SimulatedNoise class
+ * SplitMix64 generator with Box-Muller transform. Each sample of a simulation uses its own sequence,
+ * so that a sample only depends on the seed and its index (and not on the samples that were drawn before).
+ */
+class OI_CORE_EXPORT SimulatedNoise{
+public:
+    SimulatedNoise(const quint64 &seed, const quint64 &sequence)
+        : state(seed * 0xD1B54A32D192ED03ULL + (sequence + 1) * 0x9E3779B97F4A7C15ULL), hasSpare(false), spare(0.0){}
+
+    //! returns a uniformly distributed number in [0, 1)
+    double uniform(){
+        quint64 z = (this->state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return (z >> 11) * (1.0 / 9007199254740992.0);
+    }
+
+    //! returns a standard normally distributed number
+    double normal(){
+        if(this->hasSpare){
+            this->hasSpare = false;
+            return this->spare;
+        }
+        double u = 1.0 - this->uniform(); //(0, 1]
+        double v = this->uniform();
+        double r = qSqrt(-2.0 * qLn(u));
+        this->spare = r * qSin(2.0 * PI * v);
+        this->hasSpare = true;
+        return r * qCos(2.0 * PI * v);
+    }
+
+private:
+    quint64 state;
+    bool hasSpare;
+    double spare;
+};
+
+/*!
+ * \brief The SimulatedSurface class
+ * Surface of a geometry that is measured by a simulated sensor (in the coordinate system of the station).
+ * The parameters are copied from the geometry, so that the sensor thread never accesses the geometry.
+ */
+class OI_CORE_EXPORT SimulatedSurface{
+public:
+    SimulatedSurface();
+
+    //! supports points, planes, spheres, cylinders and circles (planes and cylinders are limited by the extent [m])
+    static SimulatedSurface fromGeometry(const QPointer<Geometry> &geometry, const double &extent = 0.5);
+
+    bool getIsValid() const;
+    const FeatureTypes &getTypeOfFeature() const;
+
+    //! returns the surface point and its normal for the uniformly distributed surface coordinates u and v in [0, 1)
+    void sample(const double &u, const double &v, Vec3 &point, Vec3 &normal) const;
+
+private:
+    FeatureTypes typeOfFeature;
+
+    Vec3 position;
+    Vec3 direction;
+    Vec3 firstAxis; //first and second axis are perpendicular to the direction
+    Vec3 secondAxis;
+    double radius;
+    double extent;
+
+};
+
+/*!
+ * \brief The SensorSimulation class
+ * Produces the readings of a simulated sensor. Samples are deterministic functions of the seed and their index:
+ * measurements and stream samples are numbered separately, so two sensors with the same seed and configuration
+ * produce identical readings. The stream is paced to the configured stream rate (0 = as fast as it is polled).
+ */
+class OI_CORE_EXPORT SensorSimulation{
+public:
+    SensorSimulation();
+
+    //####################################
+    //get or set the simulation parameters
+    //####################################
+
+    SimulatedSurface getSurface() const;
+    void setSurface(const SimulatedSurface &surface);
+
+    void configure(const SensorConfiguration &sConfig);
+    bool getIsAsync() const;
+
+    static void addParameters(QMap<QString, int> &integerParameters, QMap<QString, double> &doubleParameters);
+    static ReadingTypes getReadingType(const ReadingTypes &requested, const QList<ReadingTypes> &supported);
+
+    //###################
+    //simulate the sensor
+    //###################
+
+    bool connectSensor();
+    bool disconnectSensor();
+    bool getIsConnected() const;
+
+    QList<QPointer<Reading> > measure(const ReadingTypes &type);
+    bool readingStreamSample(const ReadingTypes &type, RealTimeReading &sample);
+
+    QMap<QString, QString> getSensorStatus() const;
+
+    //! executes the request and emits the response by the signals of the given sensor
+    QJsonObject performAsyncSensorCommand(Sensor &sensor, const QJsonObject &request, const MeasurementConfig &mConfig);
+
+private:
+    bool simulate(const ReadingTypes &type, const quint64 &sequence, RealTimeReading &sample) const;
+    void waitUntil(const qint64 &time) const;
+
+    //surface (may be changed from another thread)
+    mutable QMutex surfaceMutex;
+    SimulatedSurface surface;
+
+    //parameters
+    quint64 seed;
+    int readingsPerMeasurement;
+    double streamRate; //[Hz]
+    bool isAsync;
+    double sigmaAzimuth, sigmaZenith, sigmaDistance; //[rad] [m]
+    double sigmaX, sigmaY, sigmaZ; //[m]
+
+    //state
+    bool isConnected;
+    quint64 numMeasured;
+    quint64 nextStreamSample;
+    QElapsedTimer streamClock;
+
+};
+
+/*!
+ * \brief The SimulatedLaserTracker class
+ * Laser tracker that measures a simulated surface (polar, cartesian and cartesian6D readings with seeded noise)
+ */
+class OI_CORE_EXPORT SimulatedLaserTracker : public LaserTracker
+{
+    Q_OBJECT
+
+public:
+    explicit SimulatedLaserTracker(QObject *parent = 0);
+
+    //get or set the simulated surface
+    SimulatedSurface getSurface() const;
+    void setSurface(const SimulatedSurface &surface);
+
+    //##################################
+    //sensor interface of the simulation
+    //##################################
+
+    void setSensorConfiguration(const SensorConfiguration &sConfig);
+    bool isSensorAsync() const;
+
+    QJsonObject performAsyncSensorCommand(const QJsonObject &request);
+
+    bool abortAction();
+    bool connectSensor();
+    bool disconnectSensor();
+
+    QList<QPointer<Reading> > measure(const MeasurementConfig &mConfig);
+    QVariantMap readingStream(const ReadingTypes &streamFormat);
+    bool isReadingStreamTyped() const;
+    bool readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample);
+
+    bool getConnectionState();
+    bool getIsReadyForMeasurement();
+    bool getIsBusy();
+    QMap<QString, QString> getSensorStatus();
+
+protected:
+
+    //#####################
+    //laser tracker methods
+    //#####################
+
+    bool initialize();
+    bool move(const double &azimuth, const double &zenith, const double &distance, const bool &isRelative);
+    bool move(const double &x, const double &y, const double &z);
+    bool home();
+    bool changeMotorState();
+    bool toggleSightOrientation();
+    bool compensation();
+    bool search();
+
+private:
+    SensorSimulation simulation;
+
+};
+
+/*!
+ * \brief The SimulatedTotalStation class
+ * Total station that measures a simulated surface (polar and cartesian readings with seeded noise)
+ */
+class OI_CORE_EXPORT SimulatedTotalStation : public TotalStation
+{
+    Q_OBJECT
+
+public:
+    explicit SimulatedTotalStation(QObject *parent = 0);
+
+    //get or set the simulated surface
+    SimulatedSurface getSurface() const;
+    void setSurface(const SimulatedSurface &surface);
+
+    //##################################
+    //sensor interface of the simulation
+    //##################################
+
+    void setSensorConfiguration(const SensorConfiguration &sConfig);
+    bool isSensorAsync() const;
+
+    QJsonObject performAsyncSensorCommand(const QJsonObject &request);
+
+    bool abortAction();
+    bool connectSensor();
+    bool disconnectSensor();
+
+    QList<QPointer<Reading> > measure(const MeasurementConfig &mConfig);
+    QVariantMap readingStream(const ReadingTypes &streamFormat);
+    bool isReadingStreamTyped() const;
+    bool readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample);
+
+    bool getConnectionState();
+    bool getIsReadyForMeasurement();
+    bool getIsBusy();
+    QMap<QString, QString> getSensorStatus();
+
+protected:
+
+    //#####################
+    //total station methods
+    //#####################
+
+    bool move(const double &azimuth, const double &zenith, const double &distance, const bool &isRelative);
+    bool move(const double &x, const double &y, const double &z);
+    bool toggleSightOrientation();
+
+private:
+    SensorSimulation simulation;
+
+};
+
+}
+
+#endif // SIMULATEDSENSOR_H
@@ -5,6 +5,7 @@
 
 #include "element.h"
 #include "oivec.h"
+#include "fixedmath.h"
 
 namespace oi{
 
@@ -21,6 +22,7 @@ public:
     explicit Position(QObject *parent = 0);
     explicit Position(bool isNullObject, QObject *parent = 0);
     explicit Position(const OiVec &v, QObject *parent = 0);
+    explicit Position(const Vec3 &v, QObject *parent = 0);
     explicit Position(const double &x, const double &y, const double &z, const double &h = 1.0, QObject *parent = 0);
 
     Position(const Position &copy, QObject *parent = 0);
@@ -34,10 +36,12 @@ public:
     //##########################
 
     void setVector(const OiVec &v);
+    void setVector(const Vec3 &v);
     void setVector(const double &x, const double &y, const double &z, const double &h = 1.0);
 
     const OiVec &getVector() const;
     const OiVec &getVectorH() const;
+    Vec3 getVec3() const;
 
     const static Position NullObject;
 
@@ -5,13 +5,18 @@
 #include <QDateTime>
 #include <QtCore/qmath.h>
 #include <QtXml>
+#include <QXmlStreamWriter>
+#include <QXmlStreamReader>
 #include <QPointer>
+#include <QScopedPointer>
 
 #include "element.h"
 #include "measurementconfig.h"
 #include "sensorconfiguration.h"
+#include "confighandle.h"
 #include "oivec.h"
 #include "oimat.h"
+#include "fixedmath.h"
 #include "types.h"
 #include "util.h"
 
@@ -137,6 +142,91 @@ public:
     bool isValid;
 };
 
+//####################################
+//storage of the active reading values
+//####################################
+
+/*!
+ * \brief The ReadingVariant class
+ * Holds the values of exactly one reading type in place. Polar readings carry their cartesian conversion as well.
+ * The get methods return an invalid reading for types that are not held. The modify methods switch the held type
+ * if necessary, so that they must only be used to fill the reading of the current type.
+ */
+class OI_CORE_EXPORT ReadingVariant{
+public:
+    ReadingVariant();
+    explicit ReadingVariant(const ReadingTypes &type);
+
+    ReadingVariant(const ReadingVariant &copy);
+
+    ReadingVariant &operator=(const ReadingVariant &copy);
+
+    ~ReadingVariant();
+
+    //#################
+    //get and set types
+    //#################
+
+    const ReadingTypes &getType() const;
+    void setType(const ReadingTypes &type);
+
+    //######################
+    //get values of the type
+    //######################
+
+    const ReadingPolar &getPolar() const;
+    const ReadingCartesian &getCartesian() const;
+    const ReadingCartesian6D &getCartesian6D() const;
+    const ReadingDirection &getDirection() const;
+    const ReadingDistance &getDistance() const;
+    const ReadingTemperature &getTemperature() const;
+    const ReadingLevel &getLevel() const;
+    const ReadingUndefined &getUndefined() const;
+
+    //#########################
+    //modify values of the type
+    //#########################
+
+    ReadingPolar &modifyPolar();
+    ReadingCartesian &modifyCartesian();
+    ReadingCartesian6D &modifyCartesian6D();
+    ReadingDirection &modifyDirection();
+    ReadingDistance &modifyDistance();
+    ReadingTemperature &modifyTemperature();
+    ReadingLevel &modifyLevel();
+    ReadingUndefined &modifyUndefined();
+
+private:
+
+    void construct(const ReadingTypes &type, const ReadingVariant *copy);
+    void destroy();
+
+    //a polar reading is always saved together with its cartesian conversion
+    class PolarAndCartesian{
+    public:
+        ReadingPolar polar;
+        ReadingCartesian cartesian;
+    };
+
+    union Payload{
+        Payload(){}
+        ~Payload(){}
+
+        PolarAndCartesian polar;
+        ReadingCartesian cartesian;
+        ReadingCartesian6D cartesian6D;
+        ReadingDirection direction;
+        ReadingDistance distance;
+        ReadingTemperature temperature;
+        ReadingLevel level;
+        ReadingUndefined undefined;
+    };
+
+    ReadingTypes type;
+    Payload payload;
+
+};
+
 //########################
 //the reading class itself
 //########################
@@ -150,6 +240,7 @@ class OI_CORE_EXPORT Reading : public Element
     friend class CoordinateSystem;
     friend class Observation;
     friend class ProjectExchanger;
+    friend class ObservationSidecar;
     Q_OBJECT
 
 private:
@@ -206,16 +297,26 @@ public:
     static OiVec toCartesian(const double &azimuth, const double &zenith, const double &distance);
     static OiVec toPolar(const double &x, const double &y, const double &z);
 
+    static Vec3 toCartesianVec3(const double &azimuth, const double &zenith, const double &distance);
+    static Vec3 toPolarVec3(const double &x, const double &y, const double &z);
+
+    static QList<QPointer<Reading> > createPolarReadings(const QList<ReadingPolar> &readings, const bool &convert = true);
+    static void convertPolarReadings(const QList<QPointer<Reading> > &readings);
+
     //#########################################
     //get general information about the reading
     //#########################################
 
     const MeasurementConfig &getMeasurementConfig();
     void setMeasurementConfig(const MeasurementConfig &mConfig);
+    void setMeasurementConfig(const MeasurementConfigHandle &mConfig);
 
     const QDateTime &getMeasuredAt() const;
     void setMeasuredAt(const QDateTime &measuredAt);
 
+    const qint64 &getAcquisitionTime() const;
+    void setAcquisitionTime(const qint64 &acquisitionTime);
+
     const SensorFaces &getFace() const;
     void setSensorFace(const SensorFaces &face);
 
@@ -228,6 +329,7 @@ public:
 
     const SensorConfiguration &getSensorConfiguration() const;
     void setSensorConfiguration(const SensorConfiguration &sConfig);
+    void setSensorConfiguration(const SensorConfigurationHandle &sConfig);
 
     const QPointer<Observation> &getObservation() const;
     void setObservation(const QPointer<Observation> &observation);
@@ -270,41 +372,30 @@ public:
     QDomElement toOpenIndyXML(QDomDocument &xmlDoc) const;
     bool fromOpenIndyXML(QDomElement &xmlElem);
 
+    void toOpenIndyXML(QXmlStreamWriter &xmlWriter) const;
+    bool fromOpenIndyXML(QXmlStreamReader &xmlReader);
+
 private:
 
     //#######################
     //reading type and values
     //#######################
 
-    ReadingTypes typeOfReading;
-
-    ReadingPolar rPolar;
-    ReadingCartesian rCartesian;
-    ReadingCartesian6D rCartesian6D;
-    ReadingDirection rDirection;
-    ReadingDistance rDistance;
-    ReadingTemperature rTemperature;
-    ReadingLevel rLevel;
-    ReadingUndefined rUndefined;
-
-    //###################################
-    //backup readings used for simulation
-    //###################################
-
-    ReadingPolar backupPolar;
-    ReadingCartesian backupCartesian;
-    ReadingDirection backupDirection;
-    ReadingDistance backupDistance;
-    ReadingTemperature backupTemperature;
-    ReadingLevel backupLevel;
-    ReadingUndefined backupUndefined;
+    ReadingVariant variant;
+
+    //####################################################################
+    //backup reading used for simulation (only allocated after makeBackup)
+    //####################################################################
+
+    QScopedPointer<ReadingVariant> backup;
 
     //##########################
     //general reading attributes
     //##########################
 
     QDateTime measuredAt;
-    MeasurementConfig mConfig; //the configuration that the sensor used to produce this reading
+    qint64 acquisitionTime; //[ns] see AcquisitionClock (used to order readings of concurrently measuring stations)
+    MeasurementConfigHandle mConfig; //the configuration that the sensor used to produce this reading (shared by all readings)
     QString measurementConfigName;
     SensorFaces face;
     bool imported; // indicate that "reading" was not measured but imported
@@ -313,16 +404,10 @@ private:
     //sensor and observation
     //######################
 
-    SensorConfiguration sConfig;
+    SensorConfigurationHandle sConfig; //shared by all readings of the same sensor configuration
     QString sensorConfigName;
     QPointer<Observation> observation;
 
-    //################
-    //helper variables
-    //################
-
-    bool hasBackup; //true if a backup was made using makeBackup
-
 private:
 
     //##############
@@ -332,7 +417,11 @@ private:
     void toCartesian();
     void toPolar();
 
-    OiVec errorPropagationPolarToCartesian();
+    Vec3 errorPropagationPolarToCartesian();
+
+    void getXMLMeasurements(QStringList &types, QList<double> &values, QList<double> &sigmas) const;
+    bool initXMLMeasurements();
+    void setXMLMeasurement(const QString &type, const double &value, const double &sigma);
 
 };
 
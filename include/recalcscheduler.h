@@ -0,0 +1,116 @@
+#ifndef RECALCSCHEDULER_H
+#define RECALCSCHEDULER_H
+
+#include <QObject>
+#include <QPointer>
+#include <QList>
+#include <QMap>
+#include <QThreadPool>
+#include <QMutex>
+
+#include "feature.h"
+#include "types.h"
+
+namespace oi{
+
+/*!
+ * \brief The RecalcScheduler class
+ * Recalculates features incrementally using the dependency graph spanned by usedFor / previouslyNeeded.
+ * Features are only marked as dirty when they are invalidated. All invalidations within one event loop turn
+ * are coalesced and on flush each affected feature (the dirty ones and all their dependents) is recalculated
+ * exactly once in topological order.
+ * In parallel mode the affected features are partitioned into dependency levels. Features of one level that do not
+ * share any inputs are recalculated concurrently on a thread pool. While a level is recalculated the signals of its
+ * features are blocked and function messages are buffered. Afterwards the changes are published on the owning thread.
+ */
+class OI_CORE_EXPORT RecalcScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit RecalcScheduler(QObject *parent = 0);
+
+    ~RecalcScheduler();
+
+    //############################
+    //mark features to be recalced
+    //############################
+
+    void invalidate(const QPointer<Feature> &feature);
+    void invalidate(const QList<QPointer<Feature> > &features);
+
+    bool getHasPendingRecalc() const;
+    int getLastRecalcCount() const;
+
+    //###############################
+    //get or set parallel recalc mode
+    //###############################
+
+    bool getParallelRecalc() const;
+    void setParallelRecalc(const bool &parallelRecalc);
+
+    int getMaxThreadCount() const;
+    void setMaxThreadCount(const int &maxThreadCount);
+
+    //######################################
+    //helper methods on the dependency graph
+    //######################################
+
+    static bool getIsPreviouslyNeeded(const QPointer<Feature> &feature, const QPointer<Feature> &neededFeature);
+    static QList<QPointer<Feature> > getAffectedFeatures(const QList<QPointer<Feature> > &features);
+    static QList<QPointer<Feature> > sortTopologically(const QList<QPointer<Feature> > &features);
+    static QList<QList<QPointer<Feature> > > getDependencyLevels(const QList<QPointer<Feature> > &features);
+    static QList<QList<QPointer<Feature> > > getIndependentGroups(const QList<QPointer<Feature> > &features);
+
+public slots:
+
+    //##########################################
+    //recalculate all dirty features immediately
+    //##########################################
+
+    void flush();
+
+    //###########################################################
+    //forward function messages (buffered while on a pool thread)
+    //###########################################################
+
+    void relayMessage(const QString &msg, const MessageTypes &msgType, const MessageDestinations &msgDest = eConsoleMessage);
+
+signals:
+
+    //#########################################
+    //signals to inform about recalced features
+    //#########################################
+
+    void featureRecalculated(const int &featureId);
+    void featuresRecalculated();
+
+    void sendMessage(const QString &msg, const MessageTypes &msgType, const MessageDestinations &msgDest = eConsoleMessage) const;
+
+private:
+
+    QMap<int, QPointer<Feature> > dirtyFeatures; //features that were invalidated since the last flush
+    bool isFlushScheduled;
+    int lastRecalcCount;
+
+    //thread pool used in parallel mode
+    bool parallelRecalc;
+    QThreadPool threadPool;
+
+    //messages sent by functions on pool threads
+    struct BufferedMessage{
+        QString msg;
+        MessageTypes msgType;
+        MessageDestinations msgDest;
+    };
+    QMutex messageMutex;
+    QList<BufferedMessage> bufferedMessages;
+
+    void recalcGroups(const QList<QList<QPointer<Feature> > > &groups);
+    void sendBufferedMessages();
+
+};
+
+}
+
+#endif // RECALCSCHEDULER_H
@@ -27,7 +27,9 @@ class Sensor;
  */
 class OI_CORE_EXPORT ConnectionConfig{
 public:
-    ConnectionConfig(){}
+    ConnectionConfig() : typeOfConnection(eNetworkConnection), baudRate(QSerialPort::Baud9600),
+        dataBits(QSerialPort::Data8), parity(QSerialPort::NoParity), stopBits(QSerialPort::OneStop),
+        flowControl(QSerialPort::NoFlowControl){}
 
     //type
     ConnectionTypes typeOfConnection;
@@ -148,6 +150,9 @@ public:
     QDomElement toOpenIndyXML(QDomDocument &xmlDoc) const;
     bool fromOpenIndyXML(QDomElement &xmlElem);
 
+    //compare all attributes of two configs (identical configs are shared by readings)
+    bool isIdentical(const SensorConfiguration &other) const;
+
 private:
 
     //###############################
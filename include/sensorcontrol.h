@@ -55,6 +55,9 @@ public slots:
     //get information about the currently connected sensor
     //####################################################
 
+    //the getters return the state that the sensor worker published after its last sensor action,
+    //so they never wait for the sensor thread
+
     //status information
     bool getIsSensorSet();
     bool getIsSensorConnected();
@@ -117,6 +120,12 @@ public slots:
     void startStatusMonitoringStream();
     void stopStatusMonitoringStream();
 
+    //stream rate, buffering and statistics
+    StreamSettings getStreamSettings(const SensorStreams &stream);
+    void setStreamSettings(const SensorStreams &stream, const StreamSettings &settings);
+    StreamStatistics getStreamStatistics(const SensorStreams &stream);
+    void resetStreamStatistics(const SensorStreams &stream);
+
     void finishMeasurement();
 signals:
 
@@ -126,6 +135,7 @@ signals:
 
     //real time data
     void realTimeReading(QVariantMap reading);
+    void realTimeReadingSamples(QVector<RealTimeReading> samples);
     void realTimeStatus(QMap<QString, QString> status);
 
     //connection information
@@ -150,6 +160,16 @@ signals:
 
     void sensorMessage(QString msg, MessageTypes msgType, MessageDestinations msgDest = eConsoleMessage);
 
+private slots:
+
+    //############################################
+    //take buffered stream samples from the worker
+    //############################################
+
+    void takeRealTimeReadings();
+    void takeRealTimeStatus();
+    void takeConnectionStatus();
+
 private:
 
     //##############
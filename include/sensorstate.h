@@ -0,0 +1,117 @@
+#ifndef SENSORSTATE_H
+#define SENSORSTATE_H
+
+#include <QList>
+#include <QMap>
+#include <QString>
+#include <QStringList>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QAtomicInt>
+#include <QThread>
+
+#include "types.h"
+#include "sensorconfiguration.h"
+
+namespace oi{
+
+/*!
+ * \brief The SensorState class
+ * Snapshot of the state of the current sensor that is published by the sensor worker after each change
+ */
+class OI_CORE_EXPORT SensorState{
+public:
+    SensorState() : isSensorSet(false), isConnected(false), isReadyForMeasurement(false), isBusy(false),
+        activeSensorType(eUndefinedSensor), streamFormat(eUndefinedReading){}
+
+    //status information
+    bool isSensorSet;
+    bool isConnected;
+    bool isReadyForMeasurement;
+    bool isBusy;
+    QMap<QString, QString> status;
+
+    //sensor meta information
+    SensorTypes activeSensorType;
+    QList<ReadingTypes> supportedReadingTypes;
+    QList<ConnectionTypes> supportedConnectionTypes;
+    QList<SensorFunctions> supportedSensorActions;
+    QStringList selfDefinedActions;
+    SensorConfiguration sensorConfiguration;
+
+    //reading stream format
+    ReadingTypes streamFormat;
+};
+
+/*!
+ * \brief The StatePublisher class
+ * Publishes immutable snapshots of a state that may be read from any thread without waiting for the writer.
+ * The writer fills the inactive one of two copies and switches the active copy atomically as soon as
+ * all readers have left the inactive copy. The index of the active copy and the number of readers of
+ * both copies are kept in one atomic integer.
+ */
+template<class T> class StatePublisher{
+public:
+    StatePublisher() : word(0){}
+
+    //! returns a copy of the latest published state (lock-free)
+    T get() const{
+
+        //register as reader of the active copy
+        int current = 0;
+        int index = 0;
+        do{
+            current = this->word.loadAcquire();
+            index = current & eActiveIndex;
+        }while(!this->word.testAndSetAcquire(current, current + StatePublisher<T>::getReader(index)));
+
+        T state = this->states[index];
+
+        this->word.fetchAndAddRelease(-StatePublisher<T>::getReader(index));
+
+        return state;
+
+    }
+
+    //! publishes a copy of the given state (only waits for readers that copy the previous state)
+    void publish(const T &state){
+
+        QMutexLocker locker(&this->writeMutex);
+
+        int inactive = 1 - (this->word.loadAcquire() & eActiveIndex);
+        while(this->word.loadAcquire() & StatePublisher<T>::getReaders(inactive)){
+            QThread::yieldCurrentThread();
+        }
+
+        this->states[inactive] = state;
+        this->word.fetchAndXorOrdered(eActiveIndex);
+
+    }
+
+private:
+
+    //bits of the atomic integer
+    enum StateBits{
+        eActiveIndex = 0x1, //index of the active copy
+        eFirstReader = 0x2, //bits 1 - 15: number of readers of the first copy
+        eSecondReader = 0x10000 //bits 16 - 30: number of readers of the second copy
+    };
+
+    static int getReader(const int &index){
+        return index == 0 ? eFirstReader : eSecondReader;
+    }
+
+    static int getReaders(const int &index){
+        return index == 0 ? 0x0000FFFE : 0x7FFF0000;
+    }
+
+    mutable QAtomicInt word;
+    QMutex writeMutex; //serializes writers
+
+    T states[2];
+
+};
+
+}
+
+#endif // SENSORSTATE_H
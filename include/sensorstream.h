@@ -0,0 +1,365 @@
+#ifndef SENSORSTREAM_H
+#define SENSORSTREAM_H
+
+#include <QList>
+#include <QVector>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QElapsedTimer>
+#include <QAtomicInteger>
+#include <QVariantMap>
+#include <QMetaType>
+
+#include "types.h"
+
+namespace oi{
+
+//##########################################
+//helper classes to configure sensor streams
+//##########################################
+
+//! the real time streams of a sensor worker
+enum SensorStreams{
+    eReadingStream = 0,
+    eStatusStream,
+    eConnectionStream
+};
+
+//! what happens to a new sample when the consumer falls behind and the buffer is full
+enum StreamOverflowPolicies{
+    eDropOldestSample = 0, //the oldest buffered sample is discarded
+    eDropNewestSample, //the new sample is discarded
+    eCoalesceSamples //the new sample replaces the newest buffered sample
+};
+
+/*!
+ * \brief The StreamSettings class
+ * Save the target rate and the buffer configuration of a sensor stream
+ */
+class OI_CORE_EXPORT StreamSettings{
+public:
+    StreamSettings() : targetRate(0.0), bufferSize(64), overflowPolicy(eDropOldestSample){}
+    StreamSettings(const double &targetRate, const int &bufferSize, const StreamOverflowPolicies &overflowPolicy)
+        : targetRate(targetRate), bufferSize(bufferSize), overflowPolicy(overflowPolicy){}
+
+    double targetRate; //[Hz] (0 = poll the sensor as fast as possible)
+    int bufferSize; //maximum number of samples that are buffered until the consumer takes them
+    StreamOverflowPolicies overflowPolicy;
+};
+
+/*!
+ * \brief The StreamStatistics class
+ * Save the number of produced, delivered and dropped samples of a sensor stream
+ */
+class OI_CORE_EXPORT StreamStatistics{
+public:
+    StreamStatistics() : produced(0), delivered(0), dropped(0), coalesced(0), meanLatency(0.0), maxLatency(0.0){}
+
+    qint64 produced; //samples received from the sensor
+    qint64 delivered; //samples taken by the consumer
+    qint64 dropped; //samples discarded because the buffer was full
+    qint64 coalesced; //samples that replaced a buffered sample
+
+    double meanLatency; //[ms] time between sampling and delivery
+    double maxLatency; //[ms]
+};
+
+/*!
+ * \brief The AcquisitionClock class
+ * Monotonic clock that is shared by all sensor threads of the process, so that the readings of
+ * concurrently measuring stations can be ordered by the time they were acquired at
+ */
+class OI_CORE_EXPORT AcquisitionClock{
+public:
+    static qint64 getTimestamp(); //[ns] since the first call
+};
+
+/*!
+ * \brief The StreamSample class
+ * A typed sample of a sensor stream with the (monotonic) time it was sampled at
+ */
+template<class T> class StreamSample{
+public:
+    StreamSample() : timestamp(0){}
+    StreamSample(const T &data, const qint64 &timestamp) : data(data), timestamp(timestamp){}
+
+    T data;
+    qint64 timestamp; //[ms] see StreamBuffer::getTimestamp
+};
+
+/*!
+ * \brief The StreamBuffer class
+ * Bounded ring buffer of typed stream samples that is filled by the sensor thread and emptied by the consumer.
+ * All methods are thread safe.
+ */
+template<class T> class StreamBuffer{
+public:
+    StreamBuffer(const StreamSettings &settings = StreamSettings()) : head(0), count(0){
+        this->setSettings(settings);
+    }
+
+    //! returns a monotonic time stamp [ms]
+    static qint64 getTimestamp(){
+        QElapsedTimer timer;
+        timer.start();
+        return timer.msecsSinceReference();
+    }
+
+    //###################################
+    //get or set the stream configuration
+    //###################################
+
+    StreamSettings getSettings() const{
+        QMutexLocker locker(&this->mutex);
+        return this->settings;
+    }
+
+    //! changing the settings discards all buffered samples
+    void setSettings(const StreamSettings &settings){
+        QMutexLocker locker(&this->mutex);
+        this->settings = settings;
+        this->settings.bufferSize = qMax(1, settings.bufferSize);
+        this->samples = QVector<StreamSample<T> >(this->settings.bufferSize);
+        this->head = 0;
+        this->count = 0;
+    }
+
+    StreamStatistics getStatistics() const{
+        QMutexLocker locker(&this->mutex);
+        return this->statistics;
+    }
+
+    void resetStatistics(){
+        QMutexLocker locker(&this->mutex);
+        this->statistics = StreamStatistics();
+    }
+
+    //#######################
+    //add or take the samples
+    //#######################
+
+    //! adds a sample and returns true if the buffer was empty before (so that the consumer has to be notified)
+    bool push(const T &data, const qint64 &timestamp = StreamBuffer<T>::getTimestamp()){
+
+        QMutexLocker locker(&this->mutex);
+
+        this->statistics.produced++;
+        bool wasEmpty = (this->count == 0);
+
+        //buffer is full
+        if(this->count == this->samples.size()){
+            switch(this->settings.overflowPolicy){
+            case eDropNewestSample:
+                this->statistics.dropped++;
+                return false;
+            case eCoalesceSamples:
+                this->samples[(this->head + this->count - 1) % this->samples.size()] = StreamSample<T>(data, timestamp);
+                this->statistics.coalesced++;
+                return false;
+            default:
+                this->head = (this->head + 1) % this->samples.size();
+                this->count--;
+                this->statistics.dropped++;
+                break;
+            }
+        }
+
+        this->samples[(this->head + this->count) % this->samples.size()] = StreamSample<T>(data, timestamp);
+        this->count++;
+
+        return wasEmpty;
+
+    }
+
+    //! takes all buffered samples (oldest first)
+    QList<StreamSample<T> > takeAll(){
+
+        QMutexLocker locker(&this->mutex);
+
+        QList<StreamSample<T> > result;
+        result.reserve(this->count);
+        qint64 now = StreamBuffer<T>::getTimestamp();
+        for(int i = 0; i < this->count; i++){
+            StreamSample<T> &sample = this->samples[(this->head + i) % this->samples.size()];
+            double latency = now - sample.timestamp;
+            this->statistics.meanLatency += (latency - this->statistics.meanLatency) / (this->statistics.delivered + 1);
+            this->statistics.maxLatency = qMax(this->statistics.maxLatency, latency);
+            this->statistics.delivered++;
+            result.append(sample);
+            sample = StreamSample<T>();
+        }
+        this->head = 0;
+        this->count = 0;
+
+        return result;
+
+    }
+
+    int getSize() const{
+        QMutexLocker locker(&this->mutex);
+        return this->count;
+    }
+
+private:
+
+    mutable QMutex mutex;
+
+    StreamSettings settings;
+    StreamStatistics statistics;
+
+    QVector<StreamSample<T> > samples;
+    int head; //index of the oldest sample
+    int count; //number of buffered samples
+
+};
+
+//###############################################
+//typed samples and channel of the reading stream
+//###############################################
+
+struct RealTimePolar{
+    double azimuth;
+    double zenith;
+    double distance;
+};
+
+struct RealTimeDirection{
+    double azimuth;
+    double zenith;
+};
+
+struct RealTimeDistance{
+    double distance;
+};
+
+struct RealTimeCartesian{
+    double x;
+    double y;
+    double z;
+};
+
+struct RealTimeCartesian6D{
+    double x;
+    double y;
+    double z;
+    double i;
+    double j;
+    double k;
+};
+
+struct RealTimeTemperature{
+    double temperature;
+};
+
+struct RealTimeLevel{
+    double i;
+    double j;
+    double k;
+};
+
+/*!
+ * \brief The RealTimeReading class
+ * Trivially copyable sample of the reading stream. Only the values of the reading type are valid
+ * (undefined readings have no values). The QVariantMap representation uses the keys of the XML measurements.
+ */
+class OI_CORE_EXPORT RealTimeReading{
+public:
+    RealTimeReading() : type(eUndefinedReading), timestamp(0){}
+
+    static bool fromVariantMap(const ReadingTypes &type, const QVariantMap &reading, RealTimeReading &sample);
+    QVariantMap toVariantMap() const;
+
+    ReadingTypes type;
+    qint64 timestamp; //[ms] see StreamBuffer::getTimestamp
+
+    union{
+        RealTimePolar polar;
+        RealTimeDirection direction;
+        RealTimeDistance distance;
+        RealTimeCartesian cartesian;
+        RealTimeCartesian6D cartesian6D;
+        RealTimeTemperature temperature;
+        RealTimeLevel level;
+    };
+};
+
+/*!
+ * \brief The RealTimeReadingChannel class
+ * Lock-free single producer / single consumer ring buffer of typed readings.
+ * The sensor thread pushes samples without locking or allocating memory and the consumer takes them in batches.
+ * push returns true only if the consumer has to be notified, which is once after each takeAll.
+ * Settings and statistics may be accessed from any thread. Changing the settings waits until neither push nor
+ * takeAll is running and samples that are pushed in the meantime are dropped.
+ * If the producer drops the oldest sample while the consumer copies it, the consumer discards its copy (like a seqlock).
+ * eCoalesceSamples behaves like eDropOldestSample, because a buffered sample cannot be replaced safely while the consumer reads it.
+ */
+class OI_CORE_EXPORT RealTimeReadingChannel{
+public:
+    RealTimeReadingChannel(const StreamSettings &settings = StreamSettings());
+
+    //###################################
+    //get or set the stream configuration
+    //###################################
+
+    StreamSettings getSettings() const;
+    void setSettings(const StreamSettings &settings);
+
+    StreamStatistics getStatistics() const;
+    void resetStatistics();
+
+    //#######################
+    //add or take the samples
+    //#######################
+
+    //! called by the producer only
+    bool push(const RealTimeReading &sample, const qint64 &timestamp = StreamBuffer<RealTimeReading>::getTimestamp());
+
+    //! called by the consumer only: appends all buffered samples (oldest first) and returns their number
+    int takeAll(QVector<RealTimeReading> &samples);
+
+    int getSize() const;
+
+private:
+    Q_DISABLE_COPY(RealTimeReadingChannel)
+
+    bool lock(const int &user);
+    void unlock(const int &user);
+    void lockExclusive();
+    void unlockExclusive();
+
+    //users of the channel (bits of state)
+    enum ChannelUsers{
+        eProducer = 1,
+        eConsumer = 2,
+        eExclusive = 4
+    };
+    QAtomicInt state;
+
+    //settings and ring (only changed while the channel is locked exclusively)
+    mutable QMutex settingsMutex;
+    StreamSettings settings;
+    QVector<RealTimeReading> samples;
+    RealTimeReading *buffer;
+    quint32 mask; //size of the ring - 1 (the size is a power of two)
+    quint32 bufferSize;
+
+    //head (next sample to write) and tail (next sample to read) on separate cache lines
+    alignas(64) QAtomicInteger<quint32> head;
+    alignas(64) QAtomicInteger<quint32> tail;
+    QAtomicInt isNotified;
+
+    //producer statistics
+    alignas(64) QAtomicInteger<qint64> produced;
+    QAtomicInteger<qint64> dropped;
+
+    //consumer statistics
+    mutable QMutex statisticsMutex;
+    StreamStatistics consumerStatistics;
+
+};
+
+}
+
+Q_DECLARE_METATYPE( oi::RealTimeReading )
+
+#endif // SENSORSTREAM_H
@@ -6,8 +6,12 @@
 #include <QTime>
 #include <QMap>
 #include <QVariantMap>
+#include <QTimer>
+#include <QElapsedTimer>
 
 #include "sensor.h"
+#include "sensorstream.h"
+#include "sensorstate.h"
 #include "sensorworkermessage.h"
 
 namespace oi{
@@ -25,19 +29,33 @@ public:
 
     ~SensorWorker();
 
+    //###################################################################
+    //thread safe access to the sensor state, stream settings and samples
+    //###################################################################
+
+    SensorState getState() const;
+
+    StreamSettings getStreamSettings(const SensorStreams &stream) const;
+    void setStreamSettings(const SensorStreams &stream, const StreamSettings &settings);
+
+    StreamStatistics getStreamStatistics(const SensorStreams &stream) const;
+    void resetStreamStatistics(const SensorStreams &stream);
+
+    QList<StreamSample<QVariantMap> > takeRealTimeReadings();
+    int takeRealTimeReadingSamples(QVector<RealTimeReading> &samples);
+    QList<StreamSample<QMap<QString, QString> > > takeRealTimeStatus();
+    QList<StreamSample<bool> > takeConnectionStatus();
+
 signals:
 
     //##############################
     //inform about streaming results
     //##############################
 
-    //real time data
-    void realTimeReading(QVariantMap reading);
-    void realTimeStatus(QMap<QString, QString> status);
-
-    //connection information
-    void connectionLost();
-    void connectionReceived();
+    //emitted when a stream buffer is no longer empty (the consumer has to take the samples)
+    void realTimeReadingAvailable();
+    void realTimeStatusAvailable();
+    void connectionStatusAvailable();
 
     //ready state
     void isReadyForMeasurement(bool isReady);
@@ -140,6 +158,9 @@ public slots:
 
     void finishMeasurement();
 
+    //moves the worker from the thread it currently runs in
+    void moveToWorkerThread(QThread *thread);
+
 private slots:
 
     //##############
@@ -152,9 +173,16 @@ private slots:
     void asyncSensorResponseReceived(const QJsonObject &response);
     void asyncSensorMeasurementReceived(const int &geomId, const QList<QPointer<Reading> > &measurements);
     void asyncSensorStreamDataReceived(const QVariantMap &reading);
+    void asyncSensorStreamSampleReceived(const RealTimeReading &sample);
 
 private:
 
+    void addRealTimeReading(const QVariantMap &reading);
+    void addRealTimeReading(const RealTimeReading &sample);
+    void publishState();
+    void publishBusyState();
+    void scheduleStream(QTimer &timer, const QElapsedTimer &cycle, const double &targetRate);
+
     //#################
     //helper attributes
     //#################
@@ -173,6 +201,23 @@ private:
     //connection status
     bool isSensorConnected;
 
+    //published sensor state (read by SensorControl from other threads)
+    StatePublisher<SensorState> sensorState;
+
+    //stream buffers (typed readings are passed lock-free, readings of untyped sensors as QVariantMap)
+    RealTimeReadingChannel readingStreamChannel;
+    StreamBuffer<QVariantMap> readingStreamBuffer;
+    StreamBuffer<QMap<QString, QString> > statusStreamBuffer;
+    StreamBuffer<bool> connectionStreamBuffer;
+
+    //stream timers (used to keep the target rate of each stream)
+    QTimer readingStreamTimer;
+    QTimer statusStreamTimer;
+    QTimer connectionStreamTimer;
+    QElapsedTimer readingStreamCycle;
+    QElapsedTimer statusStreamCycle;
+    QElapsedTimer connectionStreamCycle;
+
 };
 
 }
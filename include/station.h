@@ -180,6 +180,7 @@ signals:
 
     //real time data
     void realTimeReading(QVariantMap reading);
+    void realTimeReadingSamples(QVector<RealTimeReading> samples);
     void realTimeStatus(QMap<QString, QString> status);
 
     //connection information
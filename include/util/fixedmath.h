@@ -0,0 +1,561 @@
+#ifndef FIXEDMATH_H
+#define FIXEDMATH_H
+
+#include <QtMath>
+#include <stdexcept>
+
+#include "oivec.h"
+#include "oimat.h"
+
+namespace oi{
+
+using namespace math;
+
+/*!
+ * \brief invertFixedMatrix
+ * Inverts the N x N matrix a by Gauss-Jordan elimination with partial pivoting
+ * \param a
+ * \param inv
+ * \return false if a is singular
+ */
+template<int N> inline bool invertFixedMatrix(const double (&a)[N][N], double (&inv)[N][N]){
+
+    double m[N][N];
+    for(int i = 0; i < N; i++){
+        for(int j = 0; j < N; j++){
+            m[i][j] = a[i][j];
+            inv[i][j] = (i == j) ? 1.0 : 0.0;
+        }
+    }
+
+    for(int col = 0; col < N; col++){
+
+        //find pivot
+        int pivot = col;
+        for(int row = col + 1; row < N; row++){
+            if(qAbs(m[row][col]) > qAbs(m[pivot][col])){
+                pivot = row;
+            }
+        }
+        if(m[pivot][col] == 0.0){
+            return false;
+        }
+        if(pivot != col){
+            for(int j = 0; j < N; j++){
+                qSwap(m[pivot][j], m[col][j]);
+                qSwap(inv[pivot][j], inv[col][j]);
+            }
+        }
+
+        //normalize pivot row and eliminate the column in all other rows
+        const double p = m[col][col];
+        for(int j = 0; j < N; j++){
+            m[col][j] /= p;
+            inv[col][j] /= p;
+        }
+        for(int row = 0; row < N; row++){
+            if(row == col || m[row][col] == 0.0){
+                continue;
+            }
+            const double f = m[row][col];
+            for(int j = 0; j < N; j++){
+                m[row][j] -= f * m[col][j];
+                inv[row][j] -= f * inv[col][j];
+            }
+        }
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief The Vec3 class
+ * Stack allocated vector with 3 elements that can be used instead of OiVec(3) for temporaries in hot paths
+ */
+class Vec3{
+public:
+    constexpr Vec3() : v{0.0, 0.0, 0.0}{}
+    constexpr Vec3(const double &x, const double &y, const double &z) : v{x, y, z}{}
+
+    //! takes the first three elements (x, y, z) of a vector of size 3 or 4
+    explicit Vec3(const OiVec &vec) : v{getOrZero(vec, 0), getOrZero(vec, 1), getOrZero(vec, 2)}{}
+
+    //#####################
+    //access vector entries
+    //#####################
+
+    constexpr int getSize() const{ return 3; }
+
+    constexpr double getAt(const int &i) const{ return this->v[i]; }
+    void setAt(const int &i, const double &value){ this->v[i] = value; }
+
+    constexpr double x() const{ return this->v[0]; }
+    constexpr double y() const{ return this->v[1]; }
+    constexpr double z() const{ return this->v[2]; }
+
+    //###################
+    //conversion to OiVec
+    //###################
+
+    OiVec toOiVec() const{
+        OiVec result(3);
+        this->assignTo(result);
+        return result;
+    }
+
+    //! returns the homogeneous vector (x, y, z, h)
+    OiVec toOiVecH(const double &h = 1.0) const{
+        OiVec result(4);
+        this->assignTo(result);
+        result.setAt(3, h);
+        return result;
+    }
+
+    //! explicit so that hot paths do not allocate an OiVec by accident (use toOiVec)
+    explicit operator OiVec() const{
+        return this->toOiVec();
+    }
+
+    //! writes x, y, z into vec without reallocation if vec has 3 or 4 elements
+    void assignTo(OiVec &vec) const{
+        if(vec.getSize() != 3 && vec.getSize() != 4){
+            vec = OiVec(3);
+        }
+        vec.setAt(0, this->v[0]);
+        vec.setAt(1, this->v[1]);
+        vec.setAt(2, this->v[2]);
+    }
+
+    //#################
+    //vector operations
+    //#################
+
+    constexpr double dot(const Vec3 &o) const{
+        return this->v[0] * o.v[0] + this->v[1] * o.v[1] + this->v[2] * o.v[2];
+    }
+
+    constexpr Vec3 cross(const Vec3 &o) const{
+        return Vec3(this->v[1] * o.v[2] - this->v[2] * o.v[1],
+                    this->v[2] * o.v[0] - this->v[0] * o.v[2],
+                    this->v[0] * o.v[1] - this->v[1] * o.v[0]);
+    }
+
+    double length() const{
+        return qSqrt(this->dot(*this));
+    }
+
+    void normalize(){
+        const double l = this->length();
+        if(l > 0.0){
+            *this /= l;
+        }
+    }
+
+    Vec3 normalized() const{
+        Vec3 result(*this);
+        result.normalize();
+        return result;
+    }
+
+    Vec3 &operator+=(const Vec3 &o){
+        for(int i = 0; i < 3; i++){ this->v[i] += o.v[i]; }
+        return *this;
+    }
+    Vec3 &operator-=(const Vec3 &o){
+        for(int i = 0; i < 3; i++){ this->v[i] -= o.v[i]; }
+        return *this;
+    }
+    Vec3 &operator*=(const double &s){
+        for(int i = 0; i < 3; i++){ this->v[i] *= s; }
+        return *this;
+    }
+    Vec3 &operator/=(const double &s){
+        for(int i = 0; i < 3; i++){ this->v[i] /= s; }
+        return *this;
+    }
+
+    friend constexpr Vec3 operator+(const Vec3 &a, const Vec3 &b){
+        return Vec3(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2]);
+    }
+    friend constexpr Vec3 operator-(const Vec3 &a, const Vec3 &b){
+        return Vec3(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2]);
+    }
+    friend constexpr Vec3 operator-(const Vec3 &a){
+        return Vec3(-a.v[0], -a.v[1], -a.v[2]);
+    }
+    friend constexpr Vec3 operator*(const Vec3 &a, const double &s){
+        return Vec3(a.v[0] * s, a.v[1] * s, a.v[2] * s);
+    }
+    friend constexpr Vec3 operator*(const double &s, const Vec3 &a){
+        return Vec3(a.v[0] * s, a.v[1] * s, a.v[2] * s);
+    }
+    friend constexpr Vec3 operator/(const Vec3 &a, const double &s){
+        return Vec3(a.v[0] / s, a.v[1] / s, a.v[2] / s);
+    }
+    friend constexpr bool operator==(const Vec3 &a, const Vec3 &b){
+        return a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2];
+    }
+
+    static double getOrZero(const OiVec &vec, const int &i){
+        return i < vec.getSize() ? vec.getAt(i) : 0.0;
+    }
+
+private:
+    double v[3];
+
+};
+
+/*!
+ * \brief The Vec4 class
+ * Stack allocated homogeneous vector (x, y, z, h) that can be used instead of OiVec(4)
+ */
+class Vec4{
+public:
+    constexpr Vec4() : v{0.0, 0.0, 0.0, 0.0}{}
+    constexpr Vec4(const double &x, const double &y, const double &z, const double &h) : v{x, y, z, h}{}
+    constexpr Vec4(const Vec3 &xyz, const double &h) : v{xyz.x(), xyz.y(), xyz.z(), h}{}
+
+    //! takes the first four elements of vec (a vector of size 3 gets h = 1)
+    explicit Vec4(const OiVec &vec) : v{Vec3::getOrZero(vec, 0), Vec3::getOrZero(vec, 1), Vec3::getOrZero(vec, 2),
+                                        vec.getSize() > 3 ? vec.getAt(3) : 1.0}{}
+
+    //#####################
+    //access vector entries
+    //#####################
+
+    constexpr int getSize() const{ return 4; }
+
+    constexpr double getAt(const int &i) const{ return this->v[i]; }
+    void setAt(const int &i, const double &value){ this->v[i] = value; }
+
+    //! returns x, y, z without dividing by h
+    constexpr Vec3 xyz() const{ return Vec3(this->v[0], this->v[1], this->v[2]); }
+
+    //! returns x, y, z divided by h
+    constexpr Vec3 toCartesian() const{ return Vec3(this->v[0] / this->v[3], this->v[1] / this->v[3], this->v[2] / this->v[3]); }
+
+    //###################
+    //conversion to OiVec
+    //###################
+
+    OiVec toOiVec() const{
+        OiVec result(4);
+        this->assignTo(result);
+        return result;
+    }
+
+    //! explicit so that hot paths do not allocate an OiVec by accident (use toOiVec)
+    explicit operator OiVec() const{
+        return this->toOiVec();
+    }
+
+    //! writes all elements into vec without reallocation if vec has 4 elements
+    void assignTo(OiVec &vec) const{
+        if(vec.getSize() != 4){
+            vec = OiVec(4);
+        }
+        for(int i = 0; i < 4; i++){
+            vec.setAt(i, this->v[i]);
+        }
+    }
+
+    //#################
+    //vector operations
+    //#################
+
+    constexpr double dot(const Vec4 &o) const{
+        return this->v[0] * o.v[0] + this->v[1] * o.v[1] + this->v[2] * o.v[2] + this->v[3] * o.v[3];
+    }
+
+    Vec4 &operator+=(const Vec4 &o){
+        for(int i = 0; i < 4; i++){ this->v[i] += o.v[i]; }
+        return *this;
+    }
+    Vec4 &operator-=(const Vec4 &o){
+        for(int i = 0; i < 4; i++){ this->v[i] -= o.v[i]; }
+        return *this;
+    }
+    Vec4 &operator*=(const double &s){
+        for(int i = 0; i < 4; i++){ this->v[i] *= s; }
+        return *this;
+    }
+    Vec4 &operator/=(const double &s){
+        for(int i = 0; i < 4; i++){ this->v[i] /= s; }
+        return *this;
+    }
+
+    friend constexpr Vec4 operator+(const Vec4 &a, const Vec4 &b){
+        return Vec4(a.v[0] + b.v[0], a.v[1] + b.v[1], a.v[2] + b.v[2], a.v[3] + b.v[3]);
+    }
+    friend constexpr Vec4 operator-(const Vec4 &a, const Vec4 &b){
+        return Vec4(a.v[0] - b.v[0], a.v[1] - b.v[1], a.v[2] - b.v[2], a.v[3] - b.v[3]);
+    }
+    friend constexpr Vec4 operator*(const Vec4 &a, const double &s){
+        return Vec4(a.v[0] * s, a.v[1] * s, a.v[2] * s, a.v[3] * s);
+    }
+    friend constexpr Vec4 operator*(const double &s, const Vec4 &a){
+        return Vec4(a.v[0] * s, a.v[1] * s, a.v[2] * s, a.v[3] * s);
+    }
+    friend constexpr Vec4 operator/(const Vec4 &a, const double &s){
+        return Vec4(a.v[0] / s, a.v[1] / s, a.v[2] / s, a.v[3] / s);
+    }
+    friend constexpr bool operator==(const Vec4 &a, const Vec4 &b){
+        return a.v[0] == b.v[0] && a.v[1] == b.v[1] && a.v[2] == b.v[2] && a.v[3] == b.v[3];
+    }
+
+private:
+    double v[4];
+
+};
+
+/*!
+ * \brief The Mat3 class
+ * Stack allocated 3x3 matrix (e.g. rotations) that can be used instead of OiMat(3,3)
+ */
+class Mat3{
+public:
+    constexpr Mat3() : m{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}{}
+    constexpr Mat3(const double &m00, const double &m01, const double &m02,
+                   const double &m10, const double &m11, const double &m12,
+                   const double &m20, const double &m21, const double &m22)
+        : m{{m00, m01, m02}, {m10, m11, m12}, {m20, m21, m22}}{}
+
+    //! takes the upper left 3x3 block of mat
+    explicit Mat3(const OiMat &mat) : m{{0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}, {0.0, 0.0, 0.0}}{
+        for(int i = 0; i < 3 && i < mat.getRowCount(); i++){
+            for(int j = 0; j < 3 && j < mat.getColCount(); j++){
+                this->m[i][j] = mat.getAt(i, j);
+            }
+        }
+    }
+
+    static constexpr Mat3 identity(){
+        return Mat3(1.0, 0.0, 0.0, 0.0, 1.0, 0.0, 0.0, 0.0, 1.0);
+    }
+
+    //! rotation about the x-axis
+    static Mat3 rotationX(const double &angle){
+        const double c = qCos(angle), s = qSin(angle);
+        return Mat3(1.0, 0.0, 0.0, 0.0, c, -s, 0.0, s, c);
+    }
+
+    //! rotation about the y-axis
+    static Mat3 rotationY(const double &angle){
+        const double c = qCos(angle), s = qSin(angle);
+        return Mat3(c, 0.0, s, 0.0, 1.0, 0.0, -s, 0.0, c);
+    }
+
+    //#####################
+    //access matrix entries
+    //#####################
+
+    constexpr int getRowCount() const{ return 3; }
+    constexpr int getColCount() const{ return 3; }
+
+    constexpr double getAt(const int &i, const int &j) const{ return this->m[i][j]; }
+    void setAt(const int &i, const int &j, const double &value){ this->m[i][j] = value; }
+
+    constexpr Vec3 getCol(const int &j) const{ return Vec3(this->m[0][j], this->m[1][j], this->m[2][j]); }
+
+    //###################
+    //conversion to OiMat
+    //###################
+
+    OiMat toOiMat() const{
+        OiMat result(3, 3);
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                result.setAt(i, j, this->m[i][j]);
+            }
+        }
+        return result;
+    }
+
+    //#################
+    //matrix operations
+    //#################
+
+    constexpr Mat3 t() const{
+        return Mat3(this->m[0][0], this->m[1][0], this->m[2][0],
+                    this->m[0][1], this->m[1][1], this->m[2][1],
+                    this->m[0][2], this->m[1][2], this->m[2][2]);
+    }
+
+    constexpr double det() const{
+        return this->m[0][0] * (this->m[1][1] * this->m[2][2] - this->m[1][2] * this->m[2][1])
+                - this->m[0][1] * (this->m[1][0] * this->m[2][2] - this->m[1][2] * this->m[2][0])
+                + this->m[0][2] * (this->m[1][0] * this->m[2][1] - this->m[1][1] * this->m[2][0]);
+    }
+
+    //! throws a runtime_error if the matrix is singular
+    Mat3 inv() const{
+        Mat3 result;
+        if(!invertFixedMatrix<3>(this->m, result.m)){
+            throw std::runtime_error("Mat3::inv(): matrix is singular");
+        }
+        return result;
+    }
+
+    //! solves a * x = b (returns false if a is singular)
+    static bool solve(Vec3 &x, const Mat3 &a, const Vec3 &b){
+        Mat3 aInv;
+        if(!invertFixedMatrix<3>(a.m, aInv.m)){
+            return false;
+        }
+        x = aInv * b;
+        return true;
+    }
+
+    Mat3 &operator+=(const Mat3 &o){
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                this->m[i][j] += o.m[i][j];
+            }
+        }
+        return *this;
+    }
+
+    //! adds the dyadic product a * b^T
+    void addOuterProduct(const Vec3 &a, const Vec3 &b){
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                this->m[i][j] += a.getAt(i) * b.getAt(j);
+            }
+        }
+    }
+
+    friend Mat3 operator*(const Mat3 &a, const Mat3 &b){
+        Mat3 result;
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j];
+            }
+        }
+        return result;
+    }
+    friend constexpr Vec3 operator*(const Mat3 &a, const Vec3 &v){
+        return Vec3(a.m[0][0] * v.x() + a.m[0][1] * v.y() + a.m[0][2] * v.z(),
+                    a.m[1][0] * v.x() + a.m[1][1] * v.y() + a.m[1][2] * v.z(),
+                    a.m[2][0] * v.x() + a.m[2][1] * v.y() + a.m[2][2] * v.z());
+    }
+    friend Mat3 operator*(const Mat3 &a, const double &s){
+        Mat3 result(a);
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                result.m[i][j] *= s;
+            }
+        }
+        return result;
+    }
+
+private:
+    double m[3][3];
+
+};
+
+/*!
+ * \brief The Mat4 class
+ * Stack allocated 4x4 matrix (homogeneous transformations) that can be used instead of OiMat(4,4)
+ */
+class Mat4{
+public:
+    constexpr Mat4() : m{{0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}, {0.0, 0.0, 0.0, 0.0}}{}
+
+    //! homogeneous transformation with rotation r and translation t
+    explicit Mat4(const Mat3 &r, const Vec3 &t = Vec3()) : Mat4(){
+        for(int i = 0; i < 3; i++){
+            for(int j = 0; j < 3; j++){
+                this->m[i][j] = r.getAt(i, j);
+            }
+            this->m[i][3] = t.getAt(i);
+        }
+        this->m[3][3] = 1.0;
+    }
+
+    //! takes the upper left 4x4 block of mat
+    explicit Mat4(const OiMat &mat) : Mat4(){
+        for(int i = 0; i < 4 && i < mat.getRowCount(); i++){
+            for(int j = 0; j < 4 && j < mat.getColCount(); j++){
+                this->m[i][j] = mat.getAt(i, j);
+            }
+        }
+    }
+
+    static Mat4 identity(){
+        return Mat4(Mat3::identity());
+    }
+
+    //#####################
+    //access matrix entries
+    //#####################
+
+    constexpr int getRowCount() const{ return 4; }
+    constexpr int getColCount() const{ return 4; }
+
+    constexpr double getAt(const int &i, const int &j) const{ return this->m[i][j]; }
+    void setAt(const int &i, const int &j, const double &value){ this->m[i][j] = value; }
+
+    //###################
+    //conversion to OiMat
+    //###################
+
+    OiMat toOiMat() const{
+        OiMat result(4, 4);
+        for(int i = 0; i < 4; i++){
+            for(int j = 0; j < 4; j++){
+                result.setAt(i, j, this->m[i][j]);
+            }
+        }
+        return result;
+    }
+
+    //#################
+    //matrix operations
+    //#################
+
+    Mat4 t() const{
+        Mat4 result;
+        for(int i = 0; i < 4; i++){
+            for(int j = 0; j < 4; j++){
+                result.m[i][j] = this->m[j][i];
+            }
+        }
+        return result;
+    }
+
+    //! throws a runtime_error if the matrix is singular
+    Mat4 inv() const{
+        Mat4 result;
+        if(!invertFixedMatrix<4>(this->m, result.m)){
+            throw std::runtime_error("Mat4::inv(): matrix is singular");
+        }
+        return result;
+    }
+
+    friend Mat4 operator*(const Mat4 &a, const Mat4 &b){
+        Mat4 result;
+        for(int i = 0; i < 4; i++){
+            for(int j = 0; j < 4; j++){
+                result.m[i][j] = a.m[i][0] * b.m[0][j] + a.m[i][1] * b.m[1][j] + a.m[i][2] * b.m[2][j] + a.m[i][3] * b.m[3][j];
+            }
+        }
+        return result;
+    }
+    friend Vec4 operator*(const Mat4 &a, const Vec4 &v){
+        Vec4 result;
+        for(int i = 0; i < 4; i++){
+            result.setAt(i, a.m[i][0] * v.getAt(0) + a.m[i][1] * v.getAt(1) + a.m[i][2] * v.getAt(2) + a.m[i][3] * v.getAt(3));
+        }
+        return result;
+    }
+
+private:
+    double m[4][4];
+
+};
+
+}
+
+#endif // FIXEDMATH_H
@@ -0,0 +1,108 @@
+#ifndef INDEXEDLIST_H
+#define INDEXEDLIST_H
+
+#include <QList>
+#include <QHash>
+#include <QSet>
+
+namespace oi{
+
+/*!
+ * \brief The IndexedList class
+ * List of values with a unique key per value. The position of each key is indexed, so that a single value is removed
+ * in O(1) by moving the last value into its place (the order of the list is not stable).
+ */
+template<class Key, class T, class List = QList<T> > class IndexedList{
+public:
+
+    const List &getValues() const{
+        return this->values;
+    }
+
+    int size() const{
+        return this->values.size();
+    }
+
+    bool isEmpty() const{
+        return this->values.isEmpty();
+    }
+
+    void reserve(const int &size){
+        this->values.reserve(size);
+        this->keys.reserve(size);
+        this->positions.reserve(size);
+    }
+
+    bool contains(const Key &key) const{
+        return this->positions.contains(key);
+    }
+
+    T value(const Key &key) const{
+        typename QHash<Key, int>::const_iterator it = this->positions.constFind(key);
+        if(it == this->positions.constEnd()){
+            return T();
+        }
+        return this->values.at(it.value());
+    }
+
+    bool append(const Key &key, const T &value){
+        if(this->positions.contains(key)){
+            return false;
+        }
+        this->positions.insert(key, this->values.size());
+        this->keys.append(key);
+        this->values.append(value);
+        return true;
+    }
+
+    //! swap-remove
+    bool remove(const Key &key){
+        typename QHash<Key, int>::iterator it = this->positions.find(key);
+        if(it == this->positions.end()){
+            return false;
+        }
+        int position = it.value();
+        this->positions.erase(it);
+        int last = this->values.size() - 1;
+        if(position != last){
+            this->values[position] = this->values.at(last);
+            this->keys[position] = this->keys.at(last);
+            this->positions[this->keys.at(position)] = position;
+        }
+        this->values.removeLast();
+        this->keys.removeLast();
+        return true;
+    }
+
+    //! removes all values with one of the given keys in one pass (keeps the order of the remaining values)
+    void remove(const QSet<Key> &keys){
+        List values;
+        QList<Key> remainingKeys;
+        this->positions.clear();
+        for(int i = 0; i < this->keys.size(); i++){
+            if(!keys.contains(this->keys.at(i))){
+                this->positions.insert(this->keys.at(i), values.size());
+                values.append(this->values.at(i));
+                remainingKeys.append(this->keys.at(i));
+            }
+        }
+        this->values = values;
+        this->keys = remainingKeys;
+    }
+
+    void clear(){
+        this->values.clear();
+        this->keys.clear();
+        this->positions.clear();
+    }
+
+private:
+    List values;
+    QList<Key> keys;
+    QHash<Key, int> positions;
+
+};
+
+}
+
+#endif // INDEXEDLIST_H
@@ -0,0 +1,82 @@
+#ifndef READINGCONVERSION_H
+#define READINGCONVERSION_H
+
+#include <QString>
+#include <QVector>
+
+#include "types.h"
+
+namespace oi{
+
+/*!
+ * \brief The ConversionKernel enum
+ * Instruction sets used to convert batches of readings
+ */
+enum ConversionKernel{
+    eScalarKernel = 0,
+    eAvx2Kernel,
+    eNeonKernel
+};
+
+/*!
+ * \brief The PolarReadingBatch class
+ * Polar readings stored as structure of arrays (all angles in radiant)
+ */
+class OI_CORE_EXPORT PolarReadingBatch{
+public:
+    void resize(const int &size);
+    void reserve(const int &size);
+    int size() const;
+
+    void append(const double &azimuth, const double &zenith, const double &distance,
+                const double &sigmaAzimuth = 0.0, const double &sigmaZenith = 0.0, const double &sigmaDistance = 0.0);
+
+    QVector<double> azimuth;
+    QVector<double> zenith;
+    QVector<double> distance;
+    QVector<double> sigmaAzimuth;
+    QVector<double> sigmaZenith;
+    QVector<double> sigmaDistance;
+};
+
+/*!
+ * \brief The CartesianReadingBatch class
+ * Cartesian readings stored as structure of arrays
+ */
+class OI_CORE_EXPORT CartesianReadingBatch{
+public:
+    void resize(const int &size);
+    void reserve(const int &size);
+    int size() const;
+
+    void append(const double &x, const double &y, const double &z,
+                const double &sigmaX = 0.0, const double &sigmaY = 0.0, const double &sigmaZ = 0.0);
+
+    QVector<double> x;
+    QVector<double> y;
+    QVector<double> z;
+    QVector<double> sigmaX;
+    QVector<double> sigmaY;
+    QVector<double> sigmaZ;
+};
+
+//###############################################
+//convert batches of polar and cartesian readings
+//###############################################
+
+ConversionKernel OI_CORE_EXPORT getBestConversionKernel();
+bool OI_CORE_EXPORT getIsConversionKernelAvailable(const ConversionKernel &kernel);
+const QString OI_CORE_EXPORT &getConversionKernelName(const ConversionKernel &kernel);
+
+void OI_CORE_EXPORT polarToCartesian(const PolarReadingBatch &polar, CartesianReadingBatch &cartesian,
+                                     const ConversionKernel &kernel = getBestConversionKernel());
+void OI_CORE_EXPORT polarToCartesian(const double *azimuth, const double *zenith, const double *distance,
+                                     const double *sigmaAzimuth, const double *sigmaZenith, const double *sigmaDistance,
+                                     double *x, double *y, double *z, double *sigmaX, double *sigmaY, double *sigmaZ,
+                                     const int &count, const ConversionKernel &kernel = getBestConversionKernel());
+
+void OI_CORE_EXPORT cartesianToPolar(const CartesianReadingBatch &cartesian, PolarReadingBatch &polar);
+
+}
+
+#endif // READINGCONVERSION_H
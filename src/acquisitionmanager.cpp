@@ -0,0 +1,319 @@
+#include "acquisitionmanager.h"
+
+#include <QHash>
+#include <QPair>
+#include <algorithm>
+
+#include "featurewrapper.h"
+
+using namespace oi;
+
+namespace{
+
+bool isAcquiredBefore(const AcquisitionResult &left, const AcquisitionResult &right){
+    return left.acquisitionTime < right.acquisitionTime;
+}
+
+}
+
+/*!
+ * \brief AcquisitionQueue::AcquisitionQueue
+ * \param station
+ * \param parent
+ */
+AcquisitionQueue::AcquisitionQueue(const QPointer<Station> &station, QObject *parent) : QObject(parent), station(station){
+
+    this->thread.setObjectName(QString("sensor thread %1").arg(station->getFeatureName()));
+
+    QObject::connect(station.data(), &Station::measurementFinished, this, &AcquisitionQueue::addResults, Qt::AutoConnection);
+    QObject::connect(station.data(), &QObject::destroyed, this, &AcquisitionQueue::stationDestroyed, Qt::AutoConnection);
+
+}
+
+/*!
+ * \brief AcquisitionQueue::~AcquisitionQueue
+ */
+AcquisitionQueue::~AcquisitionQueue(){
+    this->thread.quit();
+    this->thread.wait();
+}
+
+/*!
+ * \brief AcquisitionQueue::getStation
+ * \return
+ */
+const QPointer<Station> &AcquisitionQueue::getStation() const{
+    return this->station;
+}
+
+/*!
+ * \brief AcquisitionQueue::getThread
+ * \return
+ */
+QThread &AcquisitionQueue::getThread(){
+    return this->thread;
+}
+
+/*!
+ * \brief AcquisitionQueue::takeResults
+ * \return
+ */
+QList<AcquisitionResult> AcquisitionQueue::takeResults(){
+    QList<AcquisitionResult> results;
+    results.swap(this->results);
+    return results;
+}
+
+/*!
+ * \brief AcquisitionQueue::getNumResults
+ * \return
+ */
+int AcquisitionQueue::getNumResults() const{
+    return this->results.size();
+}
+
+/*!
+ * \brief AcquisitionQueue::addResults
+ * Queues the readings of a finished measurement of the station
+ * \param geomId
+ * \param readings
+ */
+void AcquisitionQueue::addResults(int geomId, QList<QPointer<Reading> > readings){
+
+    AcquisitionResult result;
+    result.station = this->station;
+    result.geomId = geomId;
+    result.readings = readings;
+
+    //readings that were not acquired by a sensor worker are ordered by the time they arrived at
+    result.acquisitionTime = AcquisitionClock::getTimestamp();
+    foreach(const QPointer<Reading> &reading, readings){
+        if(!reading.isNull() && reading->getAcquisitionTime() > 0){
+            result.acquisitionTime = qMin(result.acquisitionTime, reading->getAcquisitionTime());
+        }
+    }
+
+    bool wasEmpty = this->results.isEmpty();
+    this->results.append(result);
+    if(wasEmpty){
+        emit this->resultsAvailable();
+    }
+
+}
+
+/*!
+ * \brief AcquisitionQueue::stationDestroyed
+ * Stops the sensor thread of a deleted station (the station deletes its sensor control)
+ */
+void AcquisitionQueue::stationDestroyed(){
+    this->thread.quit();
+    this->thread.wait();
+    this->results.clear();
+}
+
+/*!
+ * \brief AcquisitionManager::AcquisitionManager
+ * \param job
+ * \param parent
+ */
+AcquisitionManager::AcquisitionManager(const QPointer<OiJob> &job, QObject *parent) : QObject(parent), job(job), mergeTimer(this){
+
+    //results are merged once per interval after the first result of a batch arrived
+    this->mergeTimer.setSingleShot(true);
+    this->mergeTimer.setInterval(50);
+    QObject::connect(&this->mergeTimer, &QTimer::timeout, this, &AcquisitionManager::mergeResults, Qt::AutoConnection);
+
+}
+
+/*!
+ * \brief AcquisitionManager::~AcquisitionManager
+ */
+AcquisitionManager::~AcquisitionManager(){
+    foreach(const QPointer<Station> &station, this->getStations()){
+        this->removeStation(station);
+    }
+    qDeleteAll(this->queues);
+}
+
+/*!
+ * \brief AcquisitionManager::addStation
+ * Starts a sensor thread for the given station. The sensor worker of the station must still live in the thread
+ * of the manager, that is the station must not have been given a sensor thread by the application.
+ * \param station
+ * \return
+ */
+bool AcquisitionManager::addStation(const QPointer<Station> &station){
+
+    //check station
+    if(station.isNull() || this->hasStation(station)){
+        return false;
+    }
+
+    //move the sensor worker to its own thread and start its event loop
+    AcquisitionQueue *queue = new AcquisitionQueue(station);
+    station->setSensorWorkerThread(&queue->getThread());
+    queue->getThread().start();
+
+    QObject::connect(queue, &AcquisitionQueue::resultsAvailable, this, &AcquisitionManager::scheduleMerge, Qt::AutoConnection);
+    this->queues.append(queue);
+
+    return true;
+
+}
+
+/*!
+ * \brief AcquisitionManager::removeStation
+ * Merges the pending results, moves the sensor worker of the station back to the thread of the manager
+ * and stops the sensor thread of the station (waits until the current sensor action is finished)
+ * \param station
+ */
+void AcquisitionManager::removeStation(const QPointer<Station> &station){
+
+    if(!this->hasStation(station)){
+        return;
+    }
+
+    this->mergeResults();
+
+    AcquisitionQueue *queue = this->queues.takeAt(this->getQueueIndex(station));
+    station->setSensorWorkerThread(this->thread());
+    delete queue;
+
+}
+
+/*!
+ * \brief AcquisitionManager::getStations
+ * \return
+ */
+QList<QPointer<Station> > AcquisitionManager::getStations() const{
+    QList<QPointer<Station> > stations;
+    foreach(AcquisitionQueue *queue, this->queues){
+        if(!queue->getStation().isNull()){
+            stations.append(queue->getStation());
+        }
+    }
+    return stations;
+}
+
+/*!
+ * \brief AcquisitionManager::hasStation
+ * \param station
+ * \return
+ */
+bool AcquisitionManager::hasStation(const QPointer<Station> &station) const{
+    return this->getQueueIndex(station) >= 0;
+}
+
+/*!
+ * \brief AcquisitionManager::getMergeInterval
+ * \return
+ */
+int AcquisitionManager::getMergeInterval() const{
+    return this->mergeTimer.interval();
+}
+
+/*!
+ * \brief AcquisitionManager::setMergeInterval
+ * Sets the time [ms] that results are collected before they are added to the job
+ * \param interval
+ */
+void AcquisitionManager::setMergeInterval(const int &interval){
+    this->mergeTimer.setInterval(qMax(0, interval));
+}
+
+/*!
+ * \brief AcquisitionManager::getNumPendingResults
+ * \return
+ */
+int AcquisitionManager::getNumPendingResults() const{
+    int numResults = 0;
+    foreach(AcquisitionQueue *queue, this->queues){
+        numResults += queue->getNumResults();
+    }
+    return numResults;
+}
+
+/*!
+ * \brief AcquisitionManager::mergeResults
+ * Adds the pending results of all stations to the job. The results are ordered by their acquisition time and
+ * all results of the same station and geometry are added at once.
+ */
+void AcquisitionManager::mergeResults(){
+
+    this->mergeTimer.stop();
+
+    //take the pending results and release the queues of deleted stations
+    QList<AcquisitionResult> results;
+    for(int i = this->queues.size() - 1; i >= 0; i--){
+        if(this->queues.at(i)->getStation().isNull()){
+            delete this->queues.takeAt(i);
+            continue;
+        }
+        results.append(this->queues.at(i)->takeResults());
+    }
+    if(results.isEmpty() || this->job.isNull()){
+        return;
+    }
+
+    std::stable_sort(results.begin(), results.end(), isAcquiredBefore);
+
+    //group the results by station and geometry (in the order of their first result)
+    QList<AcquisitionResult> batches;
+    QHash<QPair<int, int>, int> batchIndices;
+    int numResults = 0, numReadings = 0;
+    foreach(const AcquisitionResult &result, results){
+
+        if(result.station.isNull()){
+            continue;
+        }
+
+        QPair<int, int> key(result.station->getId(), result.geomId);
+        QHash<QPair<int, int>, int>::const_iterator it = batchIndices.constFind(key);
+        if(it == batchIndices.constEnd()){
+            batchIndices.insert(key, batches.size());
+            batches.append(result);
+        }else{
+            batches[it.value()].readings.append(result.readings);
+        }
+        numResults++;
+        numReadings += result.readings.size();
+
+    }
+
+    //add the batches with one notification of the job
+    {
+        JobChangeTransaction transaction(this->job);
+        foreach(const AcquisitionResult &batch, batches){
+            this->job->addMeasurementResults(batch.station, batch.geomId, batch.readings);
+        }
+    }
+
+    emit this->resultsMerged(numResults, numReadings);
+
+}
+
+/*!
+ * \brief AcquisitionManager::scheduleMerge
+ */
+void AcquisitionManager::scheduleMerge(){
+    if(!this->mergeTimer.isActive()){
+        this->mergeTimer.start();
+    }
+}
+
+/*!
+ * \brief AcquisitionManager::getQueueIndex
+ * \param station
+ * \return
+ */
+int AcquisitionManager::getQueueIndex(const QPointer<Station> &station) const{
+    if(station.isNull()){
+        return -1;
+    }
+    for(int i = 0; i < this->queues.size(); i++){
+        if(this->queues.at(i)->getStation() == station){
+            return i;
+        }
+    }
+    return -1;
+}
@@ -0,0 +1,123 @@
+#include "confighandle.h"
+
+#include <QHash>
+#include <QList>
+#include <QMutex>
+#include <QWeakPointer>
+
+using namespace oi;
+
+namespace{
+
+/*!
+ * \brief The ConfigPool class
+ * All interned configurations of one type by name. The pool only holds weak references,
+ * so a configuration is released as soon as its last handle is gone.
+ */
+template <class T>
+class ConfigPool{
+public:
+    QMutex mutex;
+    QHash<QString, QList<QWeakPointer<const T> > > configs;
+};
+
+template <class T>
+ConfigPool<T> &getConfigPool(){
+    static ConfigPool<T> pool;
+    return pool;
+}
+
+}
+
+/*!
+ * \brief ConfigHandle::ConfigHandle
+ */
+template <class T>
+ConfigHandle<T>::ConfigHandle(){
+
+}
+
+/*!
+ * \brief ConfigHandle::intern
+ * Returns a handle to the interned configuration that is identical to the given one
+ * (a copy of the given configuration is interned if there is none yet)
+ * \param config
+ * \return
+ */
+template <class T>
+ConfigHandle<T> ConfigHandle<T>::intern(const T &config){
+
+    ConfigPool<T> &pool = getConfigPool<T>();
+    QMutexLocker locker(&pool.mutex);
+
+    ConfigHandle<T> handle;
+    QList<QWeakPointer<const T> > &candidates = pool.configs[config.getName()];
+    for(int i = candidates.size() - 1; i >= 0; i--){
+        QSharedPointer<const T> candidate = candidates.at(i).toStrongRef();
+        if(candidate.isNull()){
+            candidates.removeAt(i); //all handles of this configuration were released
+        }else if(handle.config.isNull() && candidate->isIdentical(config)){
+            handle.config = candidate;
+        }
+    }
+
+    if(handle.config.isNull()){
+        handle.config = QSharedPointer<const T>(new T(config));
+        candidates.append(handle.config.toWeakRef());
+    }
+
+    return handle;
+
+}
+
+/*!
+ * \brief ConfigHandle::getIsNull
+ * \return
+ */
+template <class T>
+bool ConfigHandle<T>::getIsNull() const{
+    return this->config.isNull();
+}
+
+/*!
+ * \brief ConfigHandle::get
+ * \return
+ */
+template <class T>
+const T &ConfigHandle<T>::get() const{
+    if(this->config.isNull()){
+        static const T defaultConfig;
+        return defaultConfig;
+    }
+    return *this->config;
+}
+
+/*!
+ * \brief ConfigHandle::getNumInterned
+ * Returns the number of interned configurations that are still referenced by a handle
+ * \return
+ */
+template <class T>
+int ConfigHandle<T>::getNumInterned(){
+
+    ConfigPool<T> &pool = getConfigPool<T>();
+    QMutexLocker locker(&pool.mutex);
+
+    int numInterned = 0;
+    foreach(const QList<QWeakPointer<const T> > &candidates, pool.configs){
+        foreach(const QWeakPointer<const T> &candidate, candidates){
+            if(!candidate.toStrongRef().isNull()){
+                numInterned++;
+            }
+        }
+    }
+    return numInterned;
+
+}
+
+namespace oi{
+
+template class OI_CORE_EXPORT ConfigHandle<MeasurementConfig>;
+template class OI_CORE_EXPORT ConfigHandle<SensorConfiguration>;
+
+}
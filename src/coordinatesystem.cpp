@@ -10,6 +10,52 @@
 using namespace oi;
 using namespace oi::math;
 
+namespace{
+
+/*!
+ * \brief writeDomElement
+ * Writes an element that was created by a QDomDocument based toOpenIndyXML method to the given stream
+ * \param xmlWriter
+ * \param element
+ */
+void writeDomElement(QXmlStreamWriter &xmlWriter, const QDomElement &element){
+
+    xmlWriter.writeStartElement(element.tagName());
+
+    QDomNamedNodeMap attributes = element.attributes();
+    for(int i = 0; i < attributes.count(); i++){
+        QDomAttr attribute = attributes.item(i).toAttr();
+        xmlWriter.writeAttribute(attribute.name(), attribute.value());
+    }
+
+    for(QDomNode child = element.firstChild(); !child.isNull(); child = child.nextSibling()){
+        if(child.isElement()){
+            writeDomElement(xmlWriter, child.toElement());
+        }else if(child.isText()){
+            xmlWriter.writeCharacters(child.toText().data());
+        }
+    }
+
+    xmlWriter.writeEndElement();
+
+}
+
+/*!
+ * \brief writeVector
+ * \param xmlWriter
+ * \param tagName
+ * \param names
+ * \param vector
+ */
+void writeVector(QXmlStreamWriter &xmlWriter, const QString &tagName, const QStringList &names, const OiVec &vector){
+    xmlWriter.writeEmptyElement(tagName);
+    for(int i = 0; i < names.size(); i++){
+        xmlWriter.writeAttribute(names.at(i), QString::number(vector.getAt(i), 'g', 17));
+    }
+}
+
+}
+
 /*!
  * \brief CoordinateSystem::CoordinateSystem
  * \param parent
@@ -42,7 +88,8 @@ CoordinateSystem::CoordinateSystem(bool isBundleSystem, QObject *parent) : Featu
  * \param station
  * \param parent
  */
-CoordinateSystem::CoordinateSystem(const QPointer<Station> &station, QObject *parent) : Feature(parent), isActiveCoordinateSystem(false), isBundleSystem(false){
+CoordinateSystem::CoordinateSystem(const QPointer<Station> &station, QObject *parent) : Feature(parent), isActiveCoordinateSystem(false), isBundleSystem(false),
+    observationStore(new ObservationStore()){
 
     //set up feature wrapper
     if(!this->selfFeature.isNull()){
@@ -296,6 +343,9 @@ bool CoordinateSystem::addObservation(const QPointer<Observation> &observation){
             observation->getReading()->id = this->job->generateUniqueId();
         }
 
+        //keep the observation data in the store of this station system
+        observation->moveToStore(this->observationStore);
+
         //add observation to the coordinate system
         this->observationsList.append(observation);
         this->observationsMap.insert(observation->getId(), observation);
@@ -310,6 +360,80 @@ bool CoordinateSystem::addObservation(const QPointer<Observation> &observation){
 
 }
 
+/*!
+ * \brief CoordinateSystem::addObservations
+ * Adds all given observations at once. The ids of the observations and their readings are allocated in one block
+ * and observationsChanged is emitted only once (with the id of the last added observation).
+ * Receivers that need the ids of all added observations have to use observationsAdded instead
+ * \param observations
+ * \return the number of added observations
+ */
+int CoordinateSystem::addObservations(const QList<QPointer<Observation> > &observations){
+
+    //check if this is a station system
+    if(!this->isStationSystem || this->station.isNull()){
+        return 0;
+    }
+
+    //get the observations that can be added
+    QList<QPointer<Observation> > added;
+    added.reserve(observations.size());
+    foreach(const QPointer<Observation> &observation, observations){
+        if(!observation.isNull() && !observation->getReading().isNull() && observation->getStation().isNull()){
+            added.append(observation);
+        }
+    }
+    if(added.isEmpty()){
+        return 0;
+    }
+
+    //generate unique ids for the observations and their corresponding readings
+    int nextId = -1;
+    if(!this->job.isNull()){
+        nextId = this->job->generateUniqueIds(2 * added.size());
+    }
+
+    this->observationStore->reserve(this->observationStore->getSize() + added.size());
+    this->observationsList.reserve(this->observationsList.size() + added.size());
+
+    QList<int> addedIds;
+    addedIds.reserve(added.size());
+    foreach(const QPointer<Observation> &observation, added){
+
+        //set observation's station
+        observation->setStation(this->station);
+
+        if(nextId >= 0){
+            observation->id = nextId++;
+            observation->getReading()->id = nextId++;
+        }
+
+        //keep the observation data in the store of this station system
+        observation->moveToStore(this->observationStore);
+
+        //add observation to the coordinate system
+        this->observationsList.append(observation);
+        this->observationsMap.insert(observation->getId(), observation);
+        addedIds.append(observation->getId());
+
+    }
+
+    emit this->observationsChanged(this->id, added.last()->getId());
+    emit this->observationsAdded(this->id, addedIds);
+
+    return added.size();
+
+}
+
+/*!
+ * \brief CoordinateSystem::getObservationStore
+ * Returns the store that holds the coordinates and states of all observations of this station system
+ * \return
+ */
+const QSharedPointer<ObservationStore> &CoordinateSystem::getObservationStore() const{
+    return this->observationStore;
+}
+
 /*!
  * \brief CoordinateSystem::getTransformationParameters
  * \return
@@ -702,6 +826,106 @@ QDomElement CoordinateSystem::toOpenIndyXML(QDomDocument &xmlDoc){
     return coordinateSystem;
 }
 
+/*!
+ * \brief CoordinateSystem::toOpenIndyXML
+ * Writes the same schema as the QDomDocument variant. The observation references and the input elements of the
+ * functions are written one after the other, so that the memory needed does not grow with the number of observations.
+ * \param xmlWriter
+ */
+void CoordinateSystem::toOpenIndyXML(QXmlStreamWriter &xmlWriter){
+
+    xmlWriter.writeStartElement("coordinateSystem");
+
+    //add coordinate system attributes
+    this->writeOpenIndyXMLAttributes(xmlWriter);
+    xmlWriter.writeAttribute("activeSystem", QString::number(this->getIsActiveCoordinateSystem()));
+    xmlWriter.writeAttribute("isBundleSystem", QString::number(this->getIsBundleSystem()));
+
+    //add functions and dependencies
+    this->writeOpenIndyXMLDependencies(xmlWriter);
+
+    //add system definition
+    QStringList xyz = QStringList() << "x" << "y" << "z";
+    QStringList ijk = QStringList() << "i" << "j" << "k";
+    writeVector(xmlWriter, "coordinates", xyz, this->origin.getVector());
+    writeVector(xmlWriter, "xAxis", ijk, this->xAxis.getVector());
+    writeVector(xmlWriter, "yAxis", ijk, this->yAxis.getVector());
+    writeVector(xmlWriter, "zAxis", ijk, this->zAxis.getVector());
+
+    //add trafo params
+    if(this->trafoParams.size() > 0){
+        xmlWriter.writeStartElement("transformationParameters");
+        foreach(const QPointer<TrafoParam> &tp, this->trafoParams){
+            if(!tp.isNull()){
+                xmlWriter.writeEmptyElement("transformationParameter");
+                xmlWriter.writeAttribute("ref", QString::number(tp->getId()));
+            }
+        }
+        xmlWriter.writeEndElement();
+    }
+
+    //add observations
+    if(this->observationsList.size() > 0){
+        xmlWriter.writeStartElement("observations");
+        foreach(const QPointer<Observation> &obs, this->observationsList){
+            if(!obs.isNull()){
+                xmlWriter.writeEmptyElement("observation");
+                xmlWriter.writeAttribute("ref", QString::number(obs->getId()));
+            }
+        }
+        xmlWriter.writeEndElement();
+    }
+
+    //add nominals
+    if(this->nominalsList.size() > 0){
+        xmlWriter.writeStartElement("nominalGeometries");
+        foreach(const QPointer<FeatureWrapper> &geom, this->nominalsList){
+            if(!geom.isNull() && !geom->getGeometry().isNull()){
+                xmlWriter.writeEmptyElement("geometry");
+                xmlWriter.writeAttribute("ref", QString::number(geom->getGeometry()->getId()));
+            }
+        }
+        xmlWriter.writeEndElement();
+    }
+
+    //add expansion origin
+    writeVector(xmlWriter, "expansionOrigin", xyz, this->expansionOrigin.getVector());
+
+    //add bundleTemplate
+    xmlWriter.writeStartElement("bundleTemplate");
+    xmlWriter.writeAttribute("name", this->bundleTemplate["name"].toString());
+    xmlWriter.writeAttribute("levelStation", this->bundleTemplate["levelStation"].toString());
+    xmlWriter.writeAttribute("maxIterations", this->bundleTemplate["maxIterations"].toString());
+
+    xmlWriter.writeEmptyElement("parameters");
+    QJsonArray tmpArray = this->bundleTemplate["parameters"].toArray();
+    QSet<QString> parameterNames;
+    for(int i=0; i<tmpArray.size();i++){
+        if(!parameterNames.contains(tmpArray.at(i).toString())){
+            parameterNames.insert(tmpArray.at(i).toString());
+            xmlWriter.writeAttribute(tmpArray.at(i).toString(), "");
+        }
+    }
+
+    xmlWriter.writeEmptyElement("plugin");
+    QJsonObject tmpPlugin = this->bundleTemplate["plugin"].toObject();
+    if(tmpPlugin.contains("name") && tmpPlugin.contains("pluginName")){
+        xmlWriter.writeAttribute("name", tmpPlugin.value("name").toString());
+        xmlWriter.writeAttribute("pluginName", tmpPlugin.value("pluginName").toString());
+    }
+
+    xmlWriter.writeEndElement();
+
+    //add bundle adjustment (its size does not depend on the number of observations)
+    if(!this->bundlePlugin.isNull()){
+        QDomDocument bundleDoc;
+        writeDomElement(xmlWriter, this->bundlePlugin->toOpenIndyXML(bundleDoc));
+    }
+
+    xmlWriter.writeEndElement();
+
+}
+
 /*!
  * \brief CoordinateSystem::fromOpenIndyXML
  * \param xmlElem
@@ -1013,6 +1237,9 @@ void CoordinateSystem::setUpFeatureId(){
     foreach(const QPointer<Observation> &obs, this->observationsList){
         if(!obs.isNull()){
             obs->id = this->job->generateUniqueId();
+            if(!obs->store.isNull()){
+                obs->store->setId(obs->slot, obs->id);
+            }
         }
     }
 
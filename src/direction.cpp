@@ -9,8 +9,8 @@ using namespace oi::math;
  */
 Direction::Direction(QObject *parent) : Element(parent){
     this->ijk = OiVec(3);
-    this->ijkH = OiVec(3);
-    this->ijkH.add(1.0);
+    this->ijkH = OiVec(4);
+    this->ijkH.setAt(3, 1.0);
 }
 
 /*!
@@ -21,20 +21,29 @@ Direction::Direction(QObject *parent) : Element(parent){
 Direction::Direction(const OiVec &v, QObject *parent) : Element(parent){
     if(v.getSize() == 3){
         this->ijk = v;
-        this->ijkH = v;
-        this->ijkH.add(1.0);
+        Vec4(Vec3(v), 1.0).assignTo(this->ijkH);
     }else if(v.getSize() == 4){
-        this->ijk.add(v.getAt(0) / v.getAt(3));
-        this->ijk.add(v.getAt(1) / v.getAt(3));
-        this->ijk.add(v.getAt(2) / v.getAt(3));
+        this->ijk = OiVec(3);
+        this->ijk.setAt(0, v.getAt(0) / v.getAt(3));
+        this->ijk.setAt(1, v.getAt(1) / v.getAt(3));
+        this->ijk.setAt(2, v.getAt(2) / v.getAt(3));
         this->ijkH = v;
     }else{
         this->ijk = OiVec(3);
-        this->ijkH = OiVec(3);
-        this->ijkH.add(1.0);
+        this->ijkH = OiVec(4);
+        this->ijkH.setAt(3, 1.0);
     }
 }
 
+/*!
+ * \brief Direction::Direction
+ * \param v
+ * \param parent
+ */
+Direction::Direction(const Vec3 &v, QObject *parent) : Element(parent), ijk(3), ijkH(4){
+    this->setVector(v);
+}
+
 /*!
  * \brief Direction::Direction
  * \param x
@@ -42,14 +51,8 @@ Direction::Direction(const OiVec &v, QObject *parent) : Element(parent){
  * \param z
  * \param parent
  */
-Direction::Direction(const double &x, const double &y, const double &z, const double &h, QObject *parent) : Element(parent){
-    this->ijk.add(x / h);
-    this->ijk.add(y / h);
-    this->ijk.add(z / h);
-    this->ijkH.add(x);
-    this->ijkH.add(y);
-    this->ijkH.add(z);
-    this->ijkH.add(h);
+Direction::Direction(const double &x, const double &y, const double &z, const double &h, QObject *parent) : Element(parent), ijk(3), ijkH(4){
+    this->setVector(x, y, z, h);
 }
 
 /*!
@@ -133,3 +136,21 @@ const OiVec &Direction::getVector() const{
 const OiVec &Direction::getVectorH() const{
     return ijkH;
 }
+
+/*!
+ * \brief Direction::setVector
+ * Sets the vector in place without reallocating the OiVec members
+ * \param v
+ */
+void Direction::setVector(const Vec3 &v){
+    v.assignTo(this->ijk);
+    Vec4(v, 1.0).assignTo(this->ijkH);
+}
+
+/*!
+ * \brief Direction::getVec3
+ * \return
+ */
+Vec3 Direction::getVec3() const{
+    return Vec3(this->ijk);
+}
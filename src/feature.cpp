@@ -591,6 +591,69 @@ bool Feature::fromOpenIndyXML(QDomElement &xmlElem){
 
 }
 
+/*!
+ * \brief Feature::writeOpenIndyXMLAttributes
+ * Writes the attributes that Element::toOpenIndyXML and Feature::toOpenIndyXML add.
+ * The writer has to be positioned directly after the start element of the feature.
+ * \param xmlWriter
+ */
+void Feature::writeOpenIndyXMLAttributes(QXmlStreamWriter &xmlWriter) const{
+
+    xmlWriter.writeAttribute("id", QString::number(this->getId()));
+    xmlWriter.writeAttribute("name", this->getFeatureName());
+    xmlWriter.writeAttribute("group", this->getGroupName());
+    xmlWriter.writeAttribute("solved", QString::number(this->getIsSolved()));
+    xmlWriter.writeAttribute("comment", this->getComment());
+    xmlWriter.writeAttribute("activeFeature", QString::number(this->getIsActiveFeature()));
+
+}
+
+/*!
+ * \brief Feature::writeOpenIndyXMLDependencies
+ * Writes the functions, usedFor and previouslyNeeded elements in the same order as Feature::toOpenIndyXML
+ * \param xmlWriter
+ */
+void Feature::writeOpenIndyXMLDependencies(QXmlStreamWriter &xmlWriter) const{
+
+    //add functions
+    if(this->functionList.size() > 0){
+        xmlWriter.writeStartElement("functions");
+        int index = 0;
+        foreach(Function *f, this->functionList){
+            if(f != NULL){
+                f->toOpenIndyXML(xmlWriter, index);
+            }
+            index++;
+        }
+        xmlWriter.writeEndElement();
+    }
+
+    //add usedFor features
+    if(this->usedForList.size() > 0){
+        xmlWriter.writeStartElement("usedFor");
+        foreach(FeatureWrapper *f, this->usedForList){
+            if(f != NULL && f->getFeature() != NULL){
+                xmlWriter.writeEmptyElement("feature");
+                xmlWriter.writeAttribute("ref", QString::number(f->getFeature()->getId()));
+            }
+        }
+        xmlWriter.writeEndElement();
+    }
+
+    //add previouslyNeeded features
+    if(this->previouslyNeededList.size() > 0){
+        xmlWriter.writeStartElement("previouslyNeeded");
+        foreach(FeatureWrapper *f, this->previouslyNeededList){
+            if(f != NULL && f->getFeature() != NULL){
+                xmlWriter.writeEmptyElement("feature");
+                xmlWriter.writeAttribute("ref", QString::number(f->getFeature()->getId()));
+            }
+        }
+        xmlWriter.writeEndElement();
+    }
+
+}
+
 /*!
  * \brief Feature::getDisplayType
  * \return
@@ -2,6 +2,53 @@
 
 using namespace oi;
 
+namespace{
+
+/*!
+ * \brief removeFromIndex
+ * Removes a feature from the list of the given key and removes the key if its list gets empty
+ * \return true if the key was removed
+ */
+template<class Index, class Key> bool removeFromIndex(Index &index, const Key &key, const int &featureId){
+
+    typename Index::iterator it = index.find(key);
+    if(it == index.end()){
+        return false;
+    }
+    it.value().remove(featureId);
+    if(!it.value().isEmpty()){
+        return false;
+    }
+    index.erase(it);
+    return true;
+
+}
+
+/*!
+ * \brief removeFromIndex
+ * Removes all given features (grouped by key) with one pass over the list of each key
+ * \return the keys that were removed because their list got empty
+ */
+template<class Index, class Key> QSet<Key> removeFromIndex(Index &index, const QHash<Key, QSet<int> > &featureIds){
+
+    QSet<Key> emptyKeys;
+    for(typename QHash<Key, QSet<int> >::const_iterator ids = featureIds.constBegin(); ids != featureIds.constEnd(); ++ids){
+        typename Index::iterator it = index.find(ids.key());
+        if(it == index.end()){
+            continue;
+        }
+        it.value().remove(ids.value());
+        if(it.value().isEmpty()){
+            index.erase(it);
+            emptyKeys.insert(ids.key());
+        }
+    }
+    return emptyKeys;
+
+}
+
+}
+
 /*!
  * \brief FeatureContainer::FeatureContainer
  */
@@ -21,7 +68,7 @@ FeatureContainer::~FeatureContainer(){
  * \return
  */
 const QList<QPointer<FeatureWrapper> > &FeatureContainer::getFeaturesList() const{
-    return this->featuresList;
+    return this->featuresList.getValues();
 }
 
 /*!
@@ -29,7 +76,7 @@ const QList<QPointer<FeatureWrapper> > &FeatureContainer::getFeaturesList() cons
  * \return
  */
 const QList<QPointer<CoordinateSystem> > &FeatureContainer::getCoordinateSystemsList() const{
-    return this->coordSystems;
+    return this->coordSystems.getValues();
 }
 
 /*!
@@ -38,7 +85,7 @@ const QList<QPointer<CoordinateSystem> > &FeatureContainer::getCoordinateSystems
  */
 QList<QPointer<CoordinateSystem> > FeatureContainer::getStationSystemsList() const{
     QList<QPointer<CoordinateSystem> > stationSystems;
-    foreach(const QPointer<Station> &station, this->stationsList){
+    foreach(const QPointer<Station> &station, this->stationsList.getValues()){
         if(!station.isNull() && !station->getCoordinateSystem().isNull()){
             stationSystems.append(station->getCoordinateSystem());
         }
@@ -52,7 +99,7 @@ QList<QPointer<CoordinateSystem> > FeatureContainer::getStationSystemsList() con
  */
 QList<QPointer<CoordinateSystem> > FeatureContainer::getBundleSystemList() const{
     QList<QPointer<CoordinateSystem> > bundleSystems;
-    foreach(const QPointer<CoordinateSystem> &system, this->coordSystems){
+    foreach(const QPointer<CoordinateSystem> &system, this->coordSystems.getValues()){
         if(!system.isNull() && system->getIsBundleSystem()){
             bundleSystems.append(system);
         }
@@ -65,7 +112,7 @@ QList<QPointer<CoordinateSystem> > FeatureContainer::getBundleSystemList() const
  * \return
  */
 const QList<QPointer<Station> > &FeatureContainer::getStationsList() const{
-    return this->stationsList;
+    return this->stationsList.getValues();
 }
 
 /*!
@@ -73,7 +120,7 @@ const QList<QPointer<Station> > &FeatureContainer::getStationsList() const{
  * \return
  */
 const QList<QPointer<TrafoParam> > &FeatureContainer::getTransformationParametersList() const{
-    return this->trafoParamsList;
+    return this->trafoParamsList.getValues();
 }
 
 /*!
@@ -81,7 +128,7 @@ const QList<QPointer<TrafoParam> > &FeatureContainer::getTransformationParameter
  * \return
  */
 const QList<QPointer<FeatureWrapper> > &FeatureContainer::getGeometriesList() const{
-    return this->geometriesList;
+    return this->geometriesList.getValues();
 }
 
 /*!
@@ -89,7 +136,7 @@ const QList<QPointer<FeatureWrapper> > &FeatureContainer::getGeometriesList() co
  * \return
  */
 const QList<int> &FeatureContainer::getFeatureIdList() const{
-    return this->featureIds;
+    return this->featureIds.getValues();
 }
 
 /*!
@@ -97,7 +144,7 @@ const QList<int> &FeatureContainer::getFeatureIdList() const{
  * \return
  */
 const QStringList &FeatureContainer::getFeatureNameList() const{
-    return this->featureNames;
+    return this->featureNames.getValues();
 }
 
 /*!
@@ -105,7 +152,7 @@ const QStringList &FeatureContainer::getFeatureNameList() const{
  * \return
  */
 const QStringList &FeatureContainer::getFeatureGroupList() const{
-    return this->featureGroups;
+    return this->featureGroups.getValues();
 }
 
 /*!
@@ -113,7 +160,7 @@ const QStringList &FeatureContainer::getFeatureGroupList() const{
  * \return
  */
 const QList<QPair<QString, bool> > &FeatureContainer::getUsedMeasurementConfigs() const{
-    return this->usedMConfigs;
+    return this->usedMConfigs.getValues();
 }
 
 /*!
@@ -134,24 +181,43 @@ QPointer<FeatureWrapper> FeatureContainer::getFeatureById(const int &featureId)
 QList<QPointer<FeatureWrapper> > FeatureContainer::getFeaturesByName(const QString &name, const bool startWith) const{
     if(startWith) {
         QList<QPointer<FeatureWrapper> > result;
-        foreach(const QPointer<FeatureWrapper> &feature, this->featuresList){
-            if(!feature.isNull() && !feature->getFeature().isNull() && feature->getFeature()->getFeatureName().startsWith(name, Qt::CaseInsensitive)){
-                result.append(feature);
-            }
+        foreach(const QString &featureName, this->getFeatureNamesByPrefix(name)){
+            result.append(this->featuresNameMap.value(featureName).getValues());
         }
         return result;
     } else {
-        return this->featuresNameMap.values(name);
+        return this->featuresNameMap.value(name).getValues();
     }
 }
 
+/*!
+ * \brief FeatureContainer::getFeatureNamesByPrefix
+ * Returns all feature names that start with the given prefix (case insensitive) sorted by their case folded name
+ * \param prefix
+ * \return
+ */
+QStringList FeatureContainer::getFeatureNamesByPrefix(const QString &prefix) const{
+
+    QStringList result;
+
+    //all names with the prefix are stored in one range of the sorted index
+    QString foldedPrefix = prefix.toCaseFolded();
+    QMap<QString, IndexedList<QString, QString, QStringList> >::const_iterator it = this->featureNamesIndex.lowerBound(foldedPrefix);
+    for(; it != this->featureNamesIndex.constEnd() && it.key().startsWith(foldedPrefix); ++it){
+        result.append(it.value().getValues());
+    }
+
+    return result;
+
+}
+
 /*!
  * \brief FeatureContainer::getFeaturesByGroup
  * \param group
  * \return
  */
 QList<QPointer<FeatureWrapper> > FeatureContainer::getFeaturesByGroup(const QString &group) const{
-    return this->featuresGroupMap.values(group);
+    return this->featuresGroupMap.value(group).getValues();
 }
 
 /*!
@@ -160,7 +226,7 @@ QList<QPointer<FeatureWrapper> > FeatureContainer::getFeaturesByGroup(const QStr
  * \return
  */
 QList<QPointer<FeatureWrapper> > FeatureContainer::getFeaturesByType(const FeatureTypes &type) const{
-    return this->featuresTypeMap.values(type);
+    return this->featuresTypeMap.value(type).getValues();
 }
 
 /*!
@@ -169,7 +235,7 @@ QList<QPointer<FeatureWrapper> > FeatureContainer::getFeaturesByType(const Featu
  * \return
  */
 QList<QPointer<Geometry> > FeatureContainer::getGeometriesByMConfig(const QPair<QString, bool> &mConfig) const{
-    return this->geometriesMConfigMap.values(mConfig);
+    return this->geometriesMConfigMap.value(mConfig).getValues();
 }
 
 /*!
@@ -194,7 +260,7 @@ int FeatureContainer::getGeometryCount() const{
  * \return
  */
 int FeatureContainer::getFeatureCount(const FeatureTypes &type) const{
-    return this->featuresTypeMap.count(type);
+    return this->featuresTypeMap.value(type).size();
 }
 
 /*!
@@ -203,7 +269,7 @@ int FeatureContainer::getFeatureCount(const FeatureTypes &type) const{
  * \return
  */
 int FeatureContainer::getFeatureCount(const QString &group) const{
-    return this->featuresGroupMap.count(group);
+    return this->featuresGroupMap.value(group).size();
 }
 
 /*!
@@ -212,7 +278,7 @@ int FeatureContainer::getFeatureCount(const QString &group) const{
  * \return
  */
 int FeatureContainer::getFeatureCount(const QPair<QString, bool> &mConfig) const{
-    return this->geometriesMConfigMap.count(mConfig);
+    return this->geometriesMConfigMap.value(mConfig).size();
 }
 
 /*!
@@ -228,59 +294,41 @@ bool FeatureContainer::addFeature(const QPointer<FeatureWrapper> &feature){
     }
 
     //if the feature already exists it is not added
-    if(this->featuresIdMap.contains(feature->getFeature()->getId())){
+    int featureId = feature->getFeature()->getId();
+    if(this->featuresIdMap.contains(featureId)){
         return false;
     }
 
-    //add the feature to the feature lists and maps
-    this->featuresList.append(feature);
-    this->featuresIdMap.insert(feature->getFeature()->getId(), feature);
-    this->featuresNameMap.insert(feature->getFeature()->getFeatureName(), feature);
-    this->featuresTypeMap.insert(feature->getFeatureTypeEnum(), feature);
-    if(feature->getFeature()->getGroupName().compare("") != 0){
-        this->featuresGroupMap.insert(feature->getFeature()->getGroupName(), feature);
-    }
-    switch(feature->getFeatureTypeEnum()){
-    case eCoordinateSystemFeature:
-        this->coordSystems.append(feature->getCoordinateSystem());
-        break;
-    case eStationFeature:
-        this->stationsList.append(feature->getStation());
-        if(!feature->getStation()->getCoordinateSystem().isNull()){
-            QPointer<FeatureWrapper> stationSystem = new FeatureWrapper();
-            stationSystem->setCoordinateSystem(feature->getStation()->getCoordinateSystem());
-            this->featuresIdMap.insert(feature->getStation()->getCoordinateSystem()->getId(), stationSystem);
-        }
-        break;
-    case eTrafoParamFeature:
-        this->trafoParamsList.append(feature->getTrafoParam());
-        break;
-    default: //geometry
-        if(!feature->getGeometry().isNull()){
-            this->geometriesList.append(feature);
-            if(feature->getGeometry()->getMeasurementConfig().getIsValid()){
-                QPair<QString, bool> key;
-                key.first = feature->getGeometry()->getMeasurementConfig().getName();
-                key.second = feature->getGeometry()->getMeasurementConfig().getIsSaved();
-                this->geometriesMConfigMap.insert(key, feature->getGeometry());
-            }
-        }
-        break;
+    //get a slot for the feature (reuse the slot of a removed feature first)
+    int slotIndex = -1;
+    if(!this->freeSlots.isEmpty()){
+        slotIndex = this->freeSlots.takeLast();
+    }else{
+        slotIndex = this->featureSlots.size();
+        this->featureSlots.append(FeatureSlot());
     }
+    this->slotIndices.insert(featureId, slotIndex);
 
-    //update lists with ids, names, groups and mConfigs
-    this->featureIds.append(feature->getFeature()->getId());
-    if(this->featuresNameMap.values(feature->getFeature()->getFeatureName()).size() == 1){
-        this->featureNames.append(feature->getFeature()->getFeatureName());
+    FeatureSlot &slot = this->featureSlots[slotIndex];
+    slot.id = featureId;
+    slot.feature = feature;
+    slot.name = feature->getFeature()->getFeatureName();
+    slot.group = feature->getFeature()->getGroupName();
+    slot.type = feature->getFeatureTypeEnum();
+    slot.hasMConfig = !feature->getGeometry().isNull() && feature->getGeometry()->getMeasurementConfig().getIsValid();
+    if(slot.hasMConfig){
+        slot.mConfig.first = feature->getGeometry()->getMeasurementConfig().getName();
+        slot.mConfig.second = feature->getGeometry()->getMeasurementConfig().getIsSaved();
     }
-    if(feature->getFeature()->getGroupName().compare("") != 0 &&
-            !this->featureGroups.contains(feature->getFeature()->getGroupName())){
-        this->featureGroups.append(feature->getFeature()->getGroupName());
-    }
-    if(!feature->getGeometry().isNull() && feature->getGeometry()->getMeasurementConfig().getIsValid()){
-        this->usedMConfigs.append(QPair<QString, bool>(feature->getGeometry()->getMeasurementConfig().getName(),
-                                        feature->getGeometry()->getMeasurementConfig().getIsSaved()));
+
+    //add the feature to the feature lists and maps
+    this->featuresIdMap.insert(featureId, feature);
+    if(slot.type == eStationFeature && !feature->getStation()->getCoordinateSystem().isNull()){
+        QPointer<FeatureWrapper> stationSystem = new FeatureWrapper();
+        stationSystem->setCoordinateSystem(feature->getStation()->getCoordinateSystem());
+        this->featuresIdMap.insert(feature->getStation()->getCoordinateSystem()->getId(), stationSystem);
     }
+    this->addToIndices(slot);
 
     return true;
 
@@ -294,12 +342,13 @@ bool FeatureContainer::addFeature(const QPointer<FeatureWrapper> &feature){
 bool FeatureContainer::removeFeature(const int &featureId){
 
     //check if the feature exists
-    if(!this->featuresIdMap.contains(featureId)){
+    if(!this->slotIndices.contains(featureId)){
         return false;
     }
 
     //get the feature pointer
-    QPointer<FeatureWrapper> feature = this->featuresIdMap.value(featureId, QPointer<FeatureWrapper>());
+    FeatureSlot slot = this->featureSlots.at(this->slotIndices.value(featureId));
+    QPointer<FeatureWrapper> feature = slot.feature;
 
     //check if the feature is valid
     if(feature.isNull() || feature->getFeature().isNull()){
@@ -307,61 +356,103 @@ bool FeatureContainer::removeFeature(const int &featureId){
     }
 
     //remove the feature from lists and map
-    this->featuresList.removeOne(feature);
     this->featuresIdMap.remove(featureId);
-    this->featuresNameMap.remove(feature->getFeature()->getFeatureName(), feature);
-    this->featuresTypeMap.remove(feature->getFeatureTypeEnum(), feature);
-    if(feature->getFeature()->getGroupName().compare("") != 0){
-        this->featuresGroupMap.remove(feature->getFeature()->getGroupName(), feature);
-    }
-    switch(feature->getFeatureTypeEnum()){
-    case eCoordinateSystemFeature:
-        this->coordSystems.removeOne(feature->getCoordinateSystem());
-        break;
-    case eStationFeature:
-        this->stationsList.removeOne(feature->getStation());
-        break;
-    case eTrafoParamFeature:
-        this->trafoParamsList.removeOne(feature->getTrafoParam());
-        break;
-    default: //geometry
-        if(!feature->getGeometry().isNull()){
-            this->geometriesList.removeOne(feature);
-            if(feature->getGeometry()->getMeasurementConfig().getIsValid()){
-                QPair<QString, bool> key;
-                key.first = feature->getGeometry()->getMeasurementConfig().getName();
-                key.second = feature->getGeometry()->getMeasurementConfig().getIsSaved();
-                this->geometriesMConfigMap.remove(key, feature->getGeometry());
-            }
+    this->removeFromIndices(slot);
+    this->releaseSlot(featureId);
+
+    //delete the feature
+    delete feature->getFeature().data();
+    delete feature.data();
+
+    return true;
+
+}
+
+/*!
+ * \brief FeatureContainer::removeFeatures
+ * Removes and deletes all given features. The lists and maps are rebuilt once instead of once per feature.
+ * \param featureIds
+ * \return false if one of the features could not be removed
+ */
+bool FeatureContainer::removeFeatures(const QSet<int> &featureIds){
+
+    bool success = true;
+
+    //collect the features and the keys they are indexed with
+    QSet<int> removedIds;
+    QList<QPointer<FeatureWrapper> > removedFeatures;
+    QHash<QString, QSet<int> > names, groups;
+    QHash<FeatureTypes, QSet<int> > types;
+    QHash<QPair<QString, bool>, QSet<int> > mConfigs;
+    foreach(const int &featureId, featureIds){
+
+        if(!this->slotIndices.contains(featureId)){
+            success = false;
+            continue;
         }
-        break;
+
+        const FeatureSlot &slot = this->featureSlots.at(this->slotIndices.value(featureId));
+        if(slot.feature.isNull() || slot.feature->getFeature().isNull()){
+            success = false;
+            continue;
+        }
+
+        removedIds.insert(featureId);
+        removedFeatures.append(slot.feature);
+        names[slot.name].insert(featureId);
+        if(!slot.group.isEmpty()){
+            groups[slot.group].insert(featureId);
+        }
+        types[slot.type].insert(featureId);
+        if(slot.hasMConfig){
+            mConfigs[slot.mConfig].insert(featureId);
+        }
+
     }
 
-    //update lists with ids, names and groups
-    this->featureIds.removeOne(feature->getFeature()->getId());
-    if(!this->featuresNameMap.contains(feature->getFeature()->getFeatureName())){
-        this->featureNames.removeOne(feature->getFeature()->getFeatureName());
+    if(removedIds.isEmpty()){
+        return success;
     }
-    if(feature->getFeature()->getGroupName().compare("") != 0 &&
-            !this->featuresGroupMap.contains(feature->getFeature()->getGroupName())){
-        this->featureGroups.removeOne(feature->getFeature()->getGroupName());
+
+    //rebuild the lists
+    this->featuresList.remove(removedIds);
+    this->featureIds.remove(removedIds);
+    this->coordSystems.remove(removedIds);
+    this->stationsList.remove(removedIds);
+    this->trafoParamsList.remove(removedIds);
+    this->geometriesList.remove(removedIds);
+
+    //rebuild the maps and the lists with names, groups and mConfigs
+    QSet<QString> removedNames = removeFromIndex(this->featuresNameMap, names);
+    this->featureNames.remove(removedNames);
+    foreach(const QString &name, removedNames){
+        this->removeFromNameIndex(name);
     }
-    if(!feature->getGeometry().isNull() && feature->getGeometry()->getMeasurementConfig().getIsValid()){
-        this->usedMConfigs.removeOne(QPair<QString, bool>(feature->getGeometry()->getMeasurementConfig().getName(),
-                                           feature->getGeometry()->getMeasurementConfig().getIsSaved()));
+    this->featureGroups.remove(removeFromIndex(this->featuresGroupMap, groups));
+    removeFromIndex(this->featuresTypeMap, types);
+    this->usedMConfigs.remove(removeFromIndex(this->geometriesMConfigMap, mConfigs));
+
+    foreach(const int &featureId, removedIds){
+        this->featuresIdMap.remove(featureId);
+        this->releaseSlot(featureId);
     }
 
-    //delete the feature
-    delete feature->getFeature().data();
-    delete feature.data();
+    //delete the features
+    foreach(const QPointer<FeatureWrapper> &feature, removedFeatures){
+        if(!feature.isNull()){
+            delete feature->getFeature().data();
+            delete feature.data();
+        }
+    }
 
-    return true;
+    return success;
 
 }
 
 /*!
  * \brief FeatureContainer::checkAndClean
  * Checks wether there is a feature with the given id and removes it
+ * (the feature is removed with the name, group and type it was indexed with)
  * \param featureId
  * \param name
  * \param group
@@ -369,65 +460,24 @@ bool FeatureContainer::removeFeature(const int &featureId){
  */
 void FeatureContainer::checkAndClean(const int &featureId, const QString &name, const QString &group, const FeatureTypes &type){
 
-    if(!this->featuresIdMap.contains(featureId)){
+    Q_UNUSED(name);
+    Q_UNUSED(group);
+    Q_UNUSED(type);
+
+    if(!this->slotIndices.contains(featureId)){
         return;
     }
 
     //get and check feature by id
-    QPointer<FeatureWrapper> feature = this->featuresIdMap.value(featureId);
-    if(feature.isNull() || feature->getFeature().isNull()){
+    FeatureSlot slot = this->featureSlots.at(this->slotIndices.value(featureId));
+    if(slot.feature.isNull() || slot.feature->getFeature().isNull()){
         return;
     }
 
-    //clean feature list
-    this->featuresList.removeOne(feature);
-
-    //clean coordinate system list
-    if(!feature->getCoordinateSystem().isNull()){
-        this->coordSystems.removeOne(feature->getCoordinateSystem());
-    }
-
-    //clean station list
-    if(!feature->getStation().isNull()){
-        this->stationsList.removeOne(feature->getStation());
-    }
-
-    //clean trafo param list
-    if(!feature->getTrafoParam().isNull()){
-        this->trafoParamsList.removeOne(feature->getTrafoParam());
-    }
-
-    //clean geometry list
-    if(!feature->getGeometry().isNull()){
-        this->geometriesList.removeOne(feature);
-    }
-
-    //clean feature maps
+    //clean lists and maps
     this->featuresIdMap.remove(featureId);
-    this->featuresNameMap.remove(name, feature);
-    this->featuresGroupMap.remove(group, feature);
-    this->featuresTypeMap.remove(type, feature);
-    if(!feature->getGeometry().isNull()){
-        this->geometriesMConfigMap.remove(QPair<QString, bool>(feature->getGeometry()->getMeasurementConfig().getName(),
-                                          feature->getGeometry()->getMeasurementConfig().getIsSaved()), feature->getGeometry());
-    }
-
-    //clean list with ids, names, groups and mConfigs
-    this->featureIds.removeOne(featureId);
-    if(!this->featuresNameMap.contains(name)){
-        this->featureNames.removeOne(name);
-    }
-    if(!this->featuresGroupMap.contains(group)){
-        this->featureGroups.removeOne(group);
-    }
-    if(!feature->getGeometry().isNull()){
-        QPair<QString, bool> mConfig;
-        mConfig.first = feature->getGeometry()->getMeasurementConfig().getName();
-        mConfig.second = feature->getGeometry()->getMeasurementConfig().getIsSaved();
-        if(!this->geometriesMConfigMap.contains(mConfig)){
-            this->usedMConfigs.removeOne(mConfig);
-        }
-    }
+    this->removeFromIndices(slot);
+    this->releaseSlot(featureId);
 
 }
 
@@ -438,7 +488,7 @@ void FeatureContainer::checkAndClean(const int &featureId, const QString &name,
 void FeatureContainer::removeAll(){
 
     //delete all features
-    foreach(const QPointer<FeatureWrapper> &feature, this->featuresList){
+    foreach(const QPointer<FeatureWrapper> &feature, this->featuresList.getValues()){
         if(!feature.isNull()){
             if(feature->getFeature().isNull()){
                 delete feature->getFeature().data();
@@ -448,6 +498,9 @@ void FeatureContainer::removeAll(){
     }
 
     //clear all lists and maps
+    this->featureSlots.clear();
+    this->freeSlots.clear();
+    this->slotIndices.clear();
     this->featuresList.clear();
     this->coordSystems.clear();
     this->stationsList.clear();
@@ -455,6 +508,7 @@ void FeatureContainer::removeAll(){
     this->geometriesList.clear();
     this->featuresIdMap.clear();
     this->featuresNameMap.clear();
+    this->featureNamesIndex.clear();
     this->featuresGroupMap.clear();
     this->featuresTypeMap.clear();
     this->geometriesMConfigMap.clear();
@@ -474,13 +528,16 @@ void FeatureContainer::removeAll(){
  */
 bool FeatureContainer::featureNameChanged(const int &featureId, const QString &oldName){
 
+    Q_UNUSED(oldName);
+
     //check if the feature exists
-    if(!this->featuresIdMap.contains(featureId)){
+    if(!this->slotIndices.contains(featureId)){
         return false;
     }
 
     //get the feature pointer
-    QPointer<FeatureWrapper> feature = this->featuresIdMap.value(featureId, QPointer<FeatureWrapper>());
+    FeatureSlot &slot = this->featureSlots[this->slotIndices.value(featureId)];
+    QPointer<FeatureWrapper> feature = slot.feature;
 
     //check if the feature is valid
     if(feature.isNull() || feature->getFeature().isNull()){
@@ -488,14 +545,18 @@ bool FeatureContainer::featureNameChanged(const int &featureId, const QString &o
     }
 
     //update lists and maps
-    if(this->featuresNameMap.contains(oldName)){
-        this->featuresNameMap.insert(feature->getFeature()->getFeatureName(), this->featuresNameMap.take(oldName));
+    QString name = feature->getFeature()->getFeatureName();
+    if(slot.name.compare(name) == 0){
+        return true;
     }
-    if(!this->featuresNameMap.contains(oldName)){
-        this->featureNames.removeOne(oldName);
+    if(removeFromIndex(this->featuresNameMap, slot.name, featureId)){
+        this->featureNames.remove(slot.name);
+        this->removeFromNameIndex(slot.name);
     }
-    if(!this->featureNames.contains(feature->getFeature()->getFeatureName())){
-        this->featureNames.append(feature->getFeature()->getFeatureName());
+    slot.name = name;
+    this->featuresNameMap[name].append(featureId, feature);
+    if(this->featureNames.append(name, name)){
+        this->addToNameIndex(name);
     }
 
     return true;
@@ -511,54 +572,36 @@ bool FeatureContainer::featureNameChanged(const int &featureId, const QString &o
  */
 bool FeatureContainer::featureGroupChanged(const int &featureId, const QString &oldGroup){
 
+    Q_UNUSED(oldGroup);
+
     //check if the feature exists
-    if(!this->featuresIdMap.contains(featureId)){
+    if(!this->slotIndices.contains(featureId)){
         return false;
     }
 
     //get the feature pointer
-    QPointer<FeatureWrapper> feature = this->featuresIdMap.value(featureId, QPointer<FeatureWrapper>());
+    FeatureSlot &slot = this->featureSlots[this->slotIndices.value(featureId)];
+    QPointer<FeatureWrapper> feature = slot.feature;
 
     //check if the feature is valid
     if(feature.isNull() || feature->getFeature().isNull()){
         return false;
     }
 
-    //check if the old group was empty
-    if(oldGroup.compare("") == 0){
-
-        //check if the new group is empty
-        if(feature->getFeature()->getGroupName().compare("") != 0){
-            this->featuresGroupMap.insert(feature->getFeature()->getGroupName(), feature);
-            if(!this->featureGroups.contains(feature->getFeature()->getGroupName())){
-                this->featureGroups.append(feature->getFeature()->getGroupName());
-            }
-        }
-
-    }else{
-
-        //check if the new group is empty
-        if(feature->getFeature()->getGroupName().compare("") != 0){
-
-            this->featuresGroupMap.remove(oldGroup, feature);
-            this->featuresGroupMap.insert(feature->getFeature()->getGroupName(), feature);
-
-            if(!this->featuresGroupMap.contains(oldGroup)){
-                this->featureGroups.removeOne(oldGroup);
-            }
-            if(!this->featureGroups.contains(feature->getFeature()->getGroupName())){
-                this->featureGroups.append(feature->getFeature()->getGroupName());
-            }
-
-        }else{
-
-            this->featuresGroupMap.remove(oldGroup, feature);
-            if(!this->featuresGroupMap.contains(oldGroup)){
-                this->featureGroups.removeOne(oldGroup);
-            }
-
-        }
+    //remove the old group (if it was not empty)
+    QString group = feature->getFeature()->getGroupName();
+    if(slot.group.compare(group) == 0){
+        return true;
+    }
+    if(!slot.group.isEmpty() && removeFromIndex(this->featuresGroupMap, slot.group, featureId)){
+        this->featureGroups.remove(slot.group);
+    }
+    slot.group = group;
 
+    //add the new group (if it is not empty)
+    if(!group.isEmpty()){
+        this->featuresGroupMap[group].append(featureId, feature);
+        this->featureGroups.append(group, group);
     }
 
     return true;
@@ -574,13 +617,17 @@ bool FeatureContainer::featureGroupChanged(const int &featureId, const QString &
  */
 bool FeatureContainer::geometryMeasurementConfigChanged(const int &featureId, const QString &oldMConfig, bool oldIsSaved){
 
+    Q_UNUSED(oldMConfig);
+    Q_UNUSED(oldIsSaved);
+
     //check if the feature exists
-    if(!this->featuresIdMap.contains(featureId)){
+    if(!this->slotIndices.contains(featureId)){
         return false;
     }
 
     //get the feature pointer
-    QPointer<FeatureWrapper> feature = this->featuresIdMap.value(featureId, QPointer<FeatureWrapper>());
+    FeatureSlot &slot = this->featureSlots[this->slotIndices.value(featureId)];
+    QPointer<FeatureWrapper> feature = slot.feature;
 
     //check if the feature is valid and is a geometry
     if(feature.isNull() || feature->getGeometry().isNull()){
@@ -588,46 +635,164 @@ bool FeatureContainer::geometryMeasurementConfigChanged(const int &featureId, co
     }
     QPointer<Geometry> geometry = feature->getGeometry();
 
-    //if both, old and new mConfig, are empty nothing should happen
-    if(oldMConfig.compare("") == 0 && !geometry->getMeasurementConfig().getIsValid()){
+    //get map-key for the new mConfig
+    bool hasMConfig = geometry->getMeasurementConfig().getIsValid();
+    QPair<QString, bool> key;
+    key.first = geometry->getMeasurementConfig().getName();
+    key.second = geometry->getMeasurementConfig().getIsSaved();
+
+    //if both, old and new mConfig, are empty or equal nothing should happen
+    if(slot.hasMConfig == hasMConfig && (!hasMConfig || slot.mConfig == key)){
         return true;
     }
 
-    //get map-keys for old and new mConfig
-    QPair<QString, bool> oldKey, newKey;
-    oldKey.first = oldMConfig;
-    oldKey.second = oldIsSaved;
-    newKey.first = geometry->getMeasurementConfig().getName();
-    newKey.second = geometry->getMeasurementConfig().getIsSaved();
+    //remove the old mConfig
+    if(slot.hasMConfig && removeFromIndex(this->geometriesMConfigMap, slot.mConfig, featureId)){
+        this->usedMConfigs.remove(slot.mConfig);
+    }
+    slot.hasMConfig = hasMConfig;
+    slot.mConfig = key;
 
-    //if the old mConfig was empty
-    if(oldMConfig.compare("") == 0){
-        this->geometriesMConfigMap.insert(newKey, geometry);
-        if(!this->usedMConfigs.contains(newKey)){
-            this->usedMConfigs.append(newKey);
-        }
-        return true;
+    //add the new mConfig
+    if(hasMConfig){
+        this->geometriesMConfigMap[key].append(featureId, geometry);
+        this->usedMConfigs.append(key, key);
     }
 
-    //if the new mConfig is empty
-    if(!geometry->getMeasurementConfig().getIsValid()){
-        this->geometriesMConfigMap.remove(oldKey, geometry);
-        if(!this->geometriesMConfigMap.contains(oldKey)){
-            this->usedMConfigs.removeOne(oldKey);
+    return true;
+
+}
+
+/*!
+ * \brief FeatureContainer::addToIndices
+ * Adds the feature of the given slot to all lists and maps (except the id map)
+ * \param slot
+ */
+void FeatureContainer::addToIndices(FeatureSlot &slot){
+
+    const QPointer<FeatureWrapper> &feature = slot.feature;
+
+    this->featuresList.append(slot.id, feature);
+    this->featureIds.append(slot.id, slot.id);
+
+    switch(slot.type){
+    case eCoordinateSystemFeature:
+        this->coordSystems.append(slot.id, feature->getCoordinateSystem());
+        break;
+    case eStationFeature:
+        this->stationsList.append(slot.id, feature->getStation());
+        break;
+    case eTrafoParamFeature:
+        this->trafoParamsList.append(slot.id, feature->getTrafoParam());
+        break;
+    default: //geometry
+        if(!feature->getGeometry().isNull()){
+            this->geometriesList.append(slot.id, feature);
         }
-        return true;
+        break;
     }
 
-    //if both mConfigs are non-empty
-    this->geometriesMConfigMap.remove(oldKey, geometry);
-    this->geometriesMConfigMap.insert(newKey, geometry);
-    if(!this->geometriesMConfigMap.contains(oldKey)){
-        this->usedMConfigs.removeOne(oldKey);
+    this->featuresNameMap[slot.name].append(slot.id, feature);
+    if(this->featureNames.append(slot.name, slot.name)){
+        this->addToNameIndex(slot.name);
     }
-    if(!this->usedMConfigs.contains(newKey)){
-        this->usedMConfigs.append(newKey);
+
+    if(!slot.group.isEmpty()){
+        this->featuresGroupMap[slot.group].append(slot.id, feature);
+        this->featureGroups.append(slot.group, slot.group);
     }
 
-    return true;
+    this->featuresTypeMap[slot.type].append(slot.id, feature);
+
+    if(slot.hasMConfig){
+        this->geometriesMConfigMap[slot.mConfig].append(slot.id, feature->getGeometry());
+        this->usedMConfigs.append(slot.mConfig, slot.mConfig);
+    }
+
+}
+
+/*!
+ * \brief FeatureContainer::removeFromIndices
+ * Removes the feature of the given slot from all lists and maps (except the id map)
+ * \param slot
+ */
+void FeatureContainer::removeFromIndices(const FeatureSlot &slot){
+
+    this->featuresList.remove(slot.id);
+    this->featureIds.remove(slot.id);
+
+    switch(slot.type){
+    case eCoordinateSystemFeature:
+        this->coordSystems.remove(slot.id);
+        break;
+    case eStationFeature:
+        this->stationsList.remove(slot.id);
+        break;
+    case eTrafoParamFeature:
+        this->trafoParamsList.remove(slot.id);
+        break;
+    default: //geometry
+        this->geometriesList.remove(slot.id);
+        break;
+    }
+
+    if(removeFromIndex(this->featuresNameMap, slot.name, slot.id)){
+        this->featureNames.remove(slot.name);
+        this->removeFromNameIndex(slot.name);
+    }
+
+    if(!slot.group.isEmpty() && removeFromIndex(this->featuresGroupMap, slot.group, slot.id)){
+        this->featureGroups.remove(slot.group);
+    }
+
+    removeFromIndex(this->featuresTypeMap, slot.type, slot.id);
+
+    if(slot.hasMConfig && removeFromIndex(this->geometriesMConfigMap, slot.mConfig, slot.id)){
+        this->usedMConfigs.remove(slot.mConfig);
+    }
+
+}
+
+/*!
+ * \brief FeatureContainer::releaseSlot
+ * Frees the slot of the given feature so that it can be reused
+ * \param featureId
+ */
+void FeatureContainer::releaseSlot(const int &featureId){
+
+    if(!this->slotIndices.contains(featureId)){
+        return;
+    }
+
+    int slotIndex = this->slotIndices.take(featureId);
+    this->featureSlots[slotIndex] = FeatureSlot();
+    this->freeSlots.append(slotIndex);
+
+}
+
+/*!
+ * \brief FeatureContainer::addToNameIndex
+ * Adds a new feature name to the sorted name index
+ * \param name
+ */
+void FeatureContainer::addToNameIndex(const QString &name){
+    this->featureNamesIndex[name.toCaseFolded()].append(name, name);
+}
+
+/*!
+ * \brief FeatureContainer::removeFromNameIndex
+ * Removes a feature name that is no longer used from the sorted name index
+ * \param name
+ */
+void FeatureContainer::removeFromNameIndex(const QString &name){
+
+    QMap<QString, IndexedList<QString, QString, QStringList> >::iterator it = this->featureNamesIndex.find(name.toCaseFolded());
+    if(it == this->featureNamesIndex.end()){
+        return;
+    }
+    it.value().remove(name);
+    if(it.value().isEmpty()){
+        this->featureNamesIndex.erase(it);
+    }
 
 }
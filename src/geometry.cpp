@@ -92,7 +92,7 @@ Geometry::~Geometry(){
     }else{
 
         //delete this geometry from target geometries list of the observations
-        foreach(const QPointer<Observation> &observation, this->observations){
+        foreach(const QPointer<Observation> &observation, this->observations.getValues()){
             if(!observation.isNull()){
                 observation->removeTargetGeometry(this->id);
             }
@@ -242,7 +242,7 @@ bool Geometry::setActual(const QPointer<Geometry> &actual){
  * \return
  */
 const QList<QPointer<Observation> > &Geometry::getObservations() const{
-    return this->observations;
+    return this->observations.getValues();
 }
 
 /*!
@@ -253,20 +253,21 @@ void Geometry::addObservation(const QPointer<Observation> &obs){
 
     if(!obs.isNull() && !this->isNominal){
 
-        //check if obs is already included
-        if(this->observations.contains(obs)){
-            return;
+        //check if obs is already included (an entry of a deleted observation at the same address is replaced)
+        if(this->observations.contains(obs.data())){
+            if(!this->observations.value(obs.data()).isNull()){
+                return;
+            }
+            this->observations.remove(obs.data());
         }
 
-        this->observations.append(obs);
+        this->observations.append(obs.data(), obs);
 
         //update target geometries
         obs->addTargetGeometry(this);
 
         //update used reading types
-        if(!obs->getReading().isNull() && !this->usedReadingTypes.contains(obs->getReading()->getTypeOfReading())){
-            this->usedReadingTypes.append(obs->getReading()->getTypeOfReading());
-        }
+        this->addUsedReadingType(obs);
 
         this->isUpdated = false;
 
@@ -276,6 +277,55 @@ void Geometry::addObservation(const QPointer<Observation> &obs){
 
 }
 
+/*!
+ * \brief Geometry::addObservations
+ * Adds all given observations and emits geomObservationsChanged only once
+ * \param observations
+ */
+void Geometry::addObservations(const QList<QPointer<Observation> > &observations){
+
+    if(this->isNominal || observations.isEmpty()){
+        return;
+    }
+
+    int oldSize = this->observations.size();
+    this->observations.reserve(oldSize + observations.size());
+    foreach(const QPointer<Observation> &obs, observations){
+
+        //check if obs is valid and not yet included
+        if(obs.isNull()){
+            continue;
+        }
+        if(this->observations.contains(obs.data())){
+            if(!this->observations.value(obs.data()).isNull()){
+                continue;
+            }
+            this->observations.remove(obs.data());
+        }
+
+        this->observations.append(obs.data(), obs);
+
+        //update target geometries (without calling addObservation again)
+        if(!obs->targetGeometriesList.contains(this)){
+            obs->targetGeometriesList.append(this, this);
+            obs->targetGeometriesMap.insert(this->id, this);
+            if(obs->measuredTargetGeometry.isNull()){
+                obs->measuredTargetGeometry = this;
+            }
+        }
+
+        //update used reading types
+        this->addUsedReadingType(obs);
+
+    }
+
+    if(this->observations.size() != oldSize){
+        this->isUpdated = false;
+        emit this->geomObservationsChanged(this->id);
+    }
+
+}
+
 /*!
  * \brief Geometry::removeObservation
  * \param obs
@@ -288,15 +338,13 @@ void Geometry::removeObservation(const QPointer<Observation> &obs){
     }
 
     //remove observation
-    if(this->observations.removeOne(obs)){
+    if(this->observations.remove(obs.data())){
 
         //update target geometries
         obs->removeTargetGeometry(this);
 
         //update used reading types
-        if(!obs->getReading().isNull() && this->usedReadingTypes.contains(obs->getReading()->getTypeOfReading())){
-            this->usedReadingTypes.removeOne(obs->getReading()->getTypeOfReading());
-        }
+        this->removeUsedReadingType(obs);
 
         this->isUpdated = false;
 
@@ -306,6 +354,54 @@ void Geometry::removeObservation(const QPointer<Observation> &obs){
 
 }
 
+/*!
+ * \brief Geometry::removeObservations
+ * Removes all observations with one of the given ids in one pass and emits geomObservationsChanged only once
+ * (the observations are not deleted)
+ * \param observationIds
+ */
+void Geometry::removeObservations(const QSet<int> &observationIds){
+
+    if(observationIds.isEmpty()){
+        return;
+    }
+
+    //get the observations to remove
+    QSet<Observation *> removed;
+    QList<QPointer<Observation> > removedObservations;
+    foreach(const QPointer<Observation> &obs, this->observations.getValues()){
+        if(!obs.isNull() && observationIds.contains(obs->getId())){
+            removed.insert(obs.data());
+            removedObservations.append(obs);
+        }
+    }
+    if(removed.isEmpty()){
+        return;
+    }
+
+    this->observations.remove(removed);
+
+    //update target geometries and used reading types
+    foreach(const QPointer<Observation> &obs, removedObservations){
+        obs->removeTargetGeometry(this);
+        this->removeUsedReadingType(obs);
+    }
+
+    this->isUpdated = false;
+
+    emit this->geomObservationsChanged(this->id);
+
+}
+
+/*!
+ * \brief Geometry::hasObservation
+ * \param obs
+ * \return
+ */
+bool Geometry::hasObservation(const QPointer<Observation> &obs) const{
+    return !obs.isNull() && this->observations.contains(obs.data());
+}
+
 /*!
  * \brief Geometry::getNominalSystem
  * \return
@@ -571,7 +667,7 @@ QDomElement Geometry::toOpenIndyXML(QDomDocument &xmlDoc) const{
     //add observations
     if(!this->getIsNominal() && this->observations.size() > 0){
         QDomElement observations = xmlDoc.createElement("observations");
-        foreach(const QPointer<Observation> &obs, this->observations){
+        foreach(const QPointer<Observation> &obs, this->observations.getValues()){
             QDomElement observation = xmlDoc.createElement("observation");
             observation.setAttribute("ref", obs->getId());
             observations.appendChild(observation);
@@ -861,3 +957,45 @@ QString Geometry::getDisplayRadiusA(const UnitType &type, const int &digits, con
     }
     return QString("");
 }
+
+/*!
+ * \brief Geometry::addUsedReadingType
+ * Counts the reading type of the given observation
+ * \param obs
+ */
+void Geometry::addUsedReadingType(const QPointer<Observation> &obs){
+
+    if(obs->getReading().isNull()){
+        return;
+    }
+
+    int &count = this->usedReadingTypeCounts[obs->getReading()->getTypeOfReading()];
+    if(count == 0){
+        this->usedReadingTypes.append(obs->getReading()->getTypeOfReading());
+    }
+    count++;
+
+}
+
+/*!
+ * \brief Geometry::removeUsedReadingType
+ * Removes the reading type of the given observation when no other observation has a reading of that type
+ * \param obs
+ */
+void Geometry::removeUsedReadingType(const QPointer<Observation> &obs){
+
+    if(obs->getReading().isNull()){
+        return;
+    }
+
+    QHash<int, int>::iterator it = this->usedReadingTypeCounts.find(obs->getReading()->getTypeOfReading());
+    if(it == this->usedReadingTypeCounts.end()){
+        return;
+    }
+    it.value()--;
+    if(it.value() <= 0){
+        this->usedReadingTypeCounts.erase(it);
+        this->usedReadingTypes.removeOne(obs->getReading()->getTypeOfReading());
+    }
+
+}
@@ -1,5 +1,7 @@
 #include "pointcloud.h"
 
+#include <cstring>
+
 #include "featurewrapper.h"
 
 using namespace oi;
@@ -31,6 +33,8 @@ PointCloud::PointCloud(const PointCloud &copy, QObject *parent) : Geometry(copy,
     }
 
     this->xyz = copy.xyz;
+    this->pointCoordinates = copy.pointCoordinates;
+    this->pointIsUsed = copy.pointIsUsed;
     this->setBoundingBox(copy.bbox);
 
 }
@@ -47,7 +51,9 @@ PointCloud &PointCloud::operator=(const PointCloud &copy){
         this->selfFeature->setPointCloud(this);
     }
 
-     this->xyz = copy.xyz;
+    this->xyz = copy.xyz;
+    this->pointCoordinates = copy.pointCoordinates;
+    this->pointIsUsed = copy.pointIsUsed;
     this->setBoundingBox(copy.bbox);
 
     return *this;
@@ -66,7 +72,7 @@ PointCloud::~PointCloud(){
  * \return
  */
 unsigned long PointCloud::getPointCount() const{
-    return this->points.size();
+    return this->pointIsUsed.size();
 }
 
 /*!
@@ -117,20 +123,139 @@ bool PointCloud::hasPosition() const{
 }
 
 /*!
- * \brief PointCloud::getPointCloudPoints
- * Returns a list of all point cloud points
+ * \brief PointCloud::reservePoints
+ * Reserves memory for the given number of points (call before adding many points)
+ * \param count
+ */
+void PointCloud::reservePoints(const int &count){
+    this->pointCoordinates.reserve(3 * count);
+    this->pointIsUsed.reserve(count);
+}
+
+/*!
+ * \brief PointCloud::clearPoints
+ */
+void PointCloud::clearPoints(){
+    this->pointCoordinates.clear();
+    this->pointIsUsed.clear();
+    this->bbox.reset();
+}
+
+/*!
+ * \brief PointCloud::getPointCloudPoint
+ * \param index
  * \return
  */
-const QList<QPointer<Point_PC> > &PointCloud::getPointCloudPoints() const{
-    return this->points;
+Point_PC PointCloud::getPointCloudPoint(const int &index) const{
+
+    Point_PC point;
+
+    //check index
+    if(index < 0 || index >= this->pointIsUsed.size()){
+        return point;
+    }
+
+    const float *xyz = this->pointCoordinates.constData() + 3 * index;
+    point.xyz[0] = xyz[0];
+    point.xyz[1] = xyz[1];
+    point.xyz[2] = xyz[2];
+    point.isUsed = this->pointIsUsed.at(index) != 0;
+
+    return point;
+
 }
 
 /*!
  * \brief PointCloud::addPointCloudPoint
  * \param point
  */
-void PointCloud::addPointCloudPoint(const QPointer<Point_PC> &point){
-    this->points.append(point);
+void PointCloud::addPointCloudPoint(const Point_PC &point){
+    this->addPointCloudPoint(point.xyz[0], point.xyz[1], point.xyz[2], point.isUsed);
+}
+
+/*!
+ * \brief PointCloud::addPointCloudPoint
+ * \param x
+ * \param y
+ * \param z
+ * \param isUsed
+ */
+void PointCloud::addPointCloudPoint(const float &x, const float &y, const float &z, const bool &isUsed){
+
+    const float xyz[3] = {x, y, z};
+
+    this->pointCoordinates.append(x);
+    this->pointCoordinates.append(y);
+    this->pointCoordinates.append(z);
+    this->pointIsUsed.append(isUsed ? 1 : 0);
+
+    this->bbox.extend(xyz);
+
+}
+
+/*!
+ * \brief PointCloud::addPointCloudPoints
+ * Appends count points at once
+ * \param xyz x, y and z of each point (3 * count values)
+ * \param count
+ * \param isUsed
+ */
+void PointCloud::addPointCloudPoints(const float *xyz, const int &count, const bool &isUsed){
+
+    //check input
+    if(xyz == NULL || count <= 0){
+        return;
+    }
+
+    const int oldCount = this->pointIsUsed.size();
+
+    //copy coordinates in one block
+    this->pointCoordinates.resize(3 * (oldCount + count));
+    memcpy(this->pointCoordinates.data() + 3 * oldCount, xyz, 3 * count * sizeof(float));
+    this->pointIsUsed.insert(oldCount, count, isUsed ? 1 : 0);
+
+    //update bounding box
+    for(int i = 0; i < count; i++){
+        this->bbox.extend(xyz + 3 * i);
+    }
+
+}
+
+/*!
+ * \brief PointCloud::getPointIsUsed
+ * \param index
+ * \return
+ */
+bool PointCloud::getPointIsUsed(const int &index) const{
+    if(index < 0 || index >= this->pointIsUsed.size()){
+        return false;
+    }
+    return this->pointIsUsed.at(index) != 0;
+}
+
+/*!
+ * \brief PointCloud::setPointIsUsed
+ * \param index
+ * \param isUsed
+ */
+void PointCloud::setPointIsUsed(const int &index, const bool &isUsed){
+    if(index < 0 || index >= this->pointIsUsed.size()){
+        return;
+    }
+    this->pointIsUsed[index] = isUsed ? 1 : 0;
+}
+
+/*!
+ * \brief PointCloud::getPoints
+ * Returns a view on all point cloud points without copying them
+ * \return
+ */
+PointSpan_PC PointCloud::getPoints() const{
+    PointSpan_PC span;
+    span.xyz = this->pointCoordinates.constData();
+    span.isUsed = this->pointIsUsed.constData();
+    span.count = this->pointIsUsed.size();
+    return span;
 }
 
 /*!
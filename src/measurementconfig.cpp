@@ -351,3 +351,25 @@ bool MeasurementConfig::equals(const MeasurementConfig &other){
             && almostEqual(getDistanceInterval(), other.getDistanceInterval(), 8);
             // TODO stablepoint properties
 }
+
+/*!
+ * \brief MeasurementConfig::isIdentical
+ * Compares all attributes of this and the other config
+ * \param other
+ * \return
+ */
+bool MeasurementConfig::isIdentical(const MeasurementConfig &other) const{
+    return this->name == other.name
+            && this->isSaved == other.isSaved
+            && this->measureTwoSides == other.measureTwoSides
+            && this->timeInterval == other.timeInterval
+            && this->distanceInterval == other.distanceInterval
+            && this->isStablePoint == other.isStablePoint
+            && this->stablePointMinDistance == other.stablePointMinDistance
+            && this->stablePointThresholdRange == other.stablePointThresholdRange
+            && this->stablePointThresholdTime == other.stablePointThresholdTime
+            && this->transientData == other.transientData
+            && this->measurementType == other.measurementType
+            && this->measurementMode == other.measurementMode
+            && this->maxObservations == other.maxObservations;
+}
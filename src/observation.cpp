@@ -9,10 +9,24 @@ using namespace oi::math;
 
 /*!
  * \brief Observation::Observation
+ * The observation gets a slot in a store when its data is set or when it is added to a station system
  * \param parent
  */
-Observation::Observation(QObject *parent) : Element(parent), xyz(4), originalXyz(4), sigmaXyz(4), originalSigmaXyz(4), ijk(4), originalIjk(4), sigmaIjk(4), originalSigmaIjk(4),
-    isValid(false), isSolved(false), hasDirection(false), isDummyPoint(false){
+Observation::Observation(QObject *parent) : Element(parent), slot(-1){
+
+}
+
+/*!
+ * \brief Observation::Observation
+ * Creates the observation directly in the given store (e.g. the store of the station system it will be added to)
+ * \param store
+ * \param parent
+ */
+Observation::Observation(const QSharedPointer<ObservationStore> &store, QObject *parent) : Element(parent), store(store), slot(-1){
+
+    if(!this->store.isNull()){
+        this->slot = this->store->allocate(this->id);
+    }
 
 }
 
@@ -21,22 +35,14 @@ Observation::Observation(QObject *parent) : Element(parent), xyz(4), originalXyz
  * \param copy
  * \param parent
  */
-Observation::Observation(const Observation &copy, QObject *parent) : Element(copy, parent){
+Observation::Observation(const Observation &copy, QObject *parent) : Element(copy, parent), slot(-1){
 
     //copy attributes
-    this->isValid = copy.isValid;
-    this->isSolved = copy.isSolved;
-    this->hasDirection = copy.hasDirection;
-    //this->isActiveCoordSys = copy.isActiveCoordSys;
-    this->xyz = copy.xyz;
-    this->originalXyz = copy.originalXyz;
-    this->sigmaXyz = copy.sigmaXyz;
-    this->originalSigmaXyz = copy.originalSigmaXyz;
-    this->ijk = copy.ijk;
-    this->originalIjk = copy.originalIjk;
-    this->sigmaIjk = copy.sigmaIjk;
-    this->originalSigmaIjk = copy.originalSigmaIjk;
-    this->isDummyPoint = copy.isDummyPoint;
+    if(!copy.store.isNull()){
+        this->ensureStore();
+        copy.store->copySlot(copy.slot, *this->store.data(), this->slot);
+        this->store->setId(this->slot, this->id);
+    }
 
     //copy reading and station
     this->reading = copy.reading;
@@ -50,13 +56,14 @@ Observation::Observation(const Observation &copy, QObject *parent) : Element(cop
  * \param isValid
  * \param parent
  */
-Observation::Observation(const OiVec &xyz, bool isValid, QObject *parent) : Element(parent), xyz(4), originalXyz(4), sigmaXyz(4), originalSigmaXyz(4), ijk(4), originalIjk(4), sigmaIjk(4), originalSigmaIjk(4),
-    isValid(isValid), isSolved(false) , hasDirection(false), isDummyPoint(false){
+Observation::Observation(const OiVec &xyz, bool isValid, QObject *parent) : Element(parent), slot(-1){
 
-    if(xyz.getSize() == this->xyz.getSize()){
-        this->xyz = xyz;
-        this->originalXyz = xyz;
-        this->isSolved = true;
+    this->setFlag(ObservationStore::eIsValid, isValid);
+
+    if(xyz.getSize() == 4){
+        this->setVector(ObservationStore::eXyz, xyz);
+        this->setVector(ObservationStore::eOriginalXyz, xyz);
+        this->setFlag(ObservationStore::eIsSolved, true);
     }
 
 }
@@ -68,15 +75,16 @@ Observation::Observation(const OiVec &xyz, bool isValid, QObject *parent) : Elem
  * \param isValid
  * \param parent
  */
-Observation::Observation(const OiVec &xyz, int id, bool isValid, QObject *parent) : Element(parent), xyz(4), originalXyz(4), sigmaXyz(4), originalSigmaXyz(4), ijk(4), originalIjk(4), sigmaIjk(4), originalSigmaIjk(4),
-    isValid(isValid), isSolved(false) , hasDirection(false), isDummyPoint(false) {
+Observation::Observation(const OiVec &xyz, int id, bool isValid, QObject *parent) : Element(parent), slot(-1){
 
     this->id = id;
 
-    if(xyz.getSize() == this->xyz.getSize()){
-        this->xyz = xyz;
-        this->originalXyz = xyz;
-        this->isSolved = true;
+    this->setFlag(ObservationStore::eIsValid, isValid);
+
+    if(xyz.getSize() == 4){
+        this->setVector(ObservationStore::eXyz, xyz);
+        this->setVector(ObservationStore::eOriginalXyz, xyz);
+        this->setFlag(ObservationStore::eIsSolved, true);
     }
 
 }
@@ -87,20 +95,17 @@ Observation::Observation(const OiVec &xyz, int id, bool isValid, QObject *parent
  */
 Observation &Observation::operator=(const Observation &copy){
 
-    //copy attributes
-    this->isValid = copy.isValid;
-    this->isSolved = copy.isSolved;
-    this->hasDirection = copy.hasDirection;
-    //this->isActiveCoordSys = copy.isActiveCoordSys;
-    this->xyz = copy.xyz;
-    this->originalXyz = copy.originalXyz;
-    this->sigmaXyz = copy.sigmaXyz;
-    this->originalSigmaXyz = copy.originalSigmaXyz;
-    this->ijk = copy.ijk;
-    this->originalIjk = copy.originalIjk;
-    this->sigmaIjk = copy.sigmaIjk;
-    this->originalSigmaIjk = copy.originalSigmaIjk;
-    this->isDummyPoint = copy.isDummyPoint;
+    //copy attributes (keep the own id)
+    if(this != &copy){
+        if(!copy.store.isNull()){
+            this->ensureStore();
+            copy.store->copySlot(copy.slot, *this->store.data(), this->slot);
+            this->store->setId(this->slot, this->id);
+        }else if(!this->store.isNull()){
+            this->store->release(this->slot);
+            this->slot = this->store->allocate(this->id);
+        }
+    }
 
     //copy reading and station
     this->reading = copy.reading;
@@ -115,6 +120,11 @@ Observation &Observation::operator=(const Observation &copy){
  */
 Observation::~Observation(){
 
+    //free the slot in the observation store
+    if(!this->store.isNull()){
+        this->store->release(this->slot);
+    }
+
     //check the corresponding reading
     if(this->getReading().isNull()){
         return;
@@ -123,7 +133,7 @@ Observation::~Observation(){
     QList<QPointer<Geometry> > targetGeometries;
 
     //remove observation and reading from its target geometries
-    foreach(const QPointer<Geometry> &geom, this->targetGeometriesList){
+    foreach(const QPointer<Geometry> &geom, this->targetGeometriesList.getValues()){
 
         //check target geometry
         if(geom.isNull()){
@@ -170,8 +180,8 @@ Observation::~Observation(){
  * \brief Observation::getXYZ
  * \return
  */
-const OiVec &Observation::getXYZ() const{
-    return this->xyz;
+OiVec Observation::getXYZ() const{
+    return this->getVector(ObservationStore::eXyz).toOiVec();
 }
 
 /*!
@@ -181,8 +191,8 @@ const OiVec &Observation::getXYZ() const{
 void Observation::setXYZ(const OiVec &xyz){
 
     //check vector
-    if(xyz.getSize() == this->xyz.getSize()){
-        this->xyz = xyz;
+    if(xyz.getSize() == 4){
+        this->setVector(ObservationStore::eXyz, xyz);
     }
 
 }
@@ -191,16 +201,16 @@ void Observation::setXYZ(const OiVec &xyz){
  * \brief Observation::getOriginalXYZ
  * \return
  */
-const OiVec &Observation::getOriginalXYZ() const{
-    return this->originalXyz;
+OiVec Observation::getOriginalXYZ() const{
+    return this->getVector(ObservationStore::eOriginalXyz).toOiVec();
 }
 
 /*!
  * \brief Observation::getSigmaXYZ
  * \return
  */
-const OiVec &Observation::getSigmaXYZ() const{
-    return this->sigmaXyz;
+OiVec Observation::getSigmaXYZ() const{
+    return this->getVector(ObservationStore::eSigmaXyz).toOiVec();
 }
 
 /*!
@@ -210,8 +220,8 @@ const OiVec &Observation::getSigmaXYZ() const{
 void Observation::setSigmaXyz(const OiVec &sigmaXyz){
 
     //check vector
-    if(sigmaXyz.getSize() == this->sigmaXyz.getSize()){
-        this->sigmaXyz = sigmaXyz;
+    if(sigmaXyz.getSize() == 4){
+        this->setVector(ObservationStore::eSigmaXyz, sigmaXyz);
     }
 
 }
@@ -220,16 +230,16 @@ void Observation::setSigmaXyz(const OiVec &sigmaXyz){
  * \brief Observation::getOriginalSigmaXyz
  * \return
  */
-const OiVec &Observation::getOriginalSigmaXyz() const{
-    return this->originalSigmaXyz;
+OiVec Observation::getOriginalSigmaXyz() const{
+    return this->getVector(ObservationStore::eOriginalSigmaXyz).toOiVec();
 }
 
 /*!
  * \brief Observation::getIJK
  * \return
  */
-const OiVec &Observation::getIJK() const{
-    return this->ijk;
+OiVec Observation::getIJK() const{
+    return this->getVector(ObservationStore::eIjk).toOiVec();
 }
 
 /*!
@@ -239,25 +249,26 @@ const OiVec &Observation::getIJK() const{
 void Observation::setIJK(const OiVec &ijk){
 
     //check vector
-    if(ijk.getSize() == this->ijk.getSize()){
-        this->ijk = ijk;
+    if(ijk.getSize() == 4){
+        this->setVector(ObservationStore::eIjk, ijk);
     }
+
 }
 
 /*!
  * \brief Observation::getOriginalIJK
  * \return
  */
-const OiVec &Observation::getOriginalIJK() const{
-    return this->originalIjk;
+OiVec Observation::getOriginalIJK() const{
+    return this->getVector(ObservationStore::eOriginalIjk).toOiVec();
 }
 
 /*!
  * \brief Observation::getSigmaIJK
  * \return
  */
-const OiVec &Observation::getSigmaIJK() const{
-    return this->sigmaIjk;
+OiVec Observation::getSigmaIJK() const{
+    return this->getVector(ObservationStore::eSigmaIjk).toOiVec();
 }
 
 /*!
@@ -267,17 +278,18 @@ const OiVec &Observation::getSigmaIJK() const{
 void Observation::setSigmaIjk(const OiVec &sigmaIjk){
 
     //check vector
-    if(sigmaIjk.getSize() == this->sigmaIjk.getSize()){
-        this->sigmaIjk = sigmaIjk;
+    if(sigmaIjk.getSize() == 4){
+        this->setVector(ObservationStore::eSigmaIjk, sigmaIjk);
     }
+
 }
 
 /*!
  * \brief Observation::getOriginalSigmaIjk
  * \return
  */
-const OiVec &Observation::getOriginalSigmaIjk() const{
-    return this->originalSigmaIjk;
+OiVec Observation::getOriginalSigmaIjk() const{
+    return this->getVector(ObservationStore::eOriginalSigmaIjk).toOiVec();
 }
 
 /*!
@@ -303,7 +315,7 @@ void Observation::setStation(const QPointer<Station> &station){
  * \return
  */
 const QList<QPointer<Geometry> > &Observation::getTargetGeometries() const{
-    return this->targetGeometriesList;
+    return this->targetGeometriesList.getValues();
 }
 
 /*!
@@ -315,11 +327,11 @@ void Observation::addTargetGeometry(const QPointer<Geometry> &targetGeometry){
     if(!targetGeometry.isNull()){
 
         //check if target geometry is already included
-        if(this->targetGeometriesList.contains(targetGeometry)){
+        if(this->targetGeometriesList.contains(targetGeometry.data())){
             return;
         }
 
-        this->targetGeometriesList.append(targetGeometry);
+        this->targetGeometriesList.append(targetGeometry.data(), targetGeometry);
         this->targetGeometriesMap.insert(targetGeometry->getId(), targetGeometry);
 
         targetGeometry->addObservation(this);
@@ -341,11 +353,11 @@ void Observation::removeTargetGeometry(const QPointer<Geometry> &targetGeometry)
     if(!targetGeometry.isNull()){
 
         //check if target geometry is included
-        if(!this->targetGeometriesList.contains(targetGeometry)){
+        if(!this->targetGeometriesList.contains(targetGeometry.data())){
             return;
         }
 
-        this->targetGeometriesList.removeOne(targetGeometry);
+        this->targetGeometriesList.remove(targetGeometry.data());
         this->targetGeometriesMap.remove(targetGeometry->getId());
 
         targetGeometry->removeObservation(this);
@@ -363,7 +375,7 @@ void Observation::removeTargetGeometry(const int &geomId){
     this->removeTargetGeometry(targetGeometry);
 
     if(this->measuredTargetGeometry.isNull() && this->targetGeometriesList.size() == 1){
-        this->measuredTargetGeometry = this->targetGeometriesList.at(0);
+        this->measuredTargetGeometry = this->targetGeometriesList.getValues().at(0);
     }
 }
 
@@ -417,8 +429,8 @@ const QPointer<Reading> &Observation::getReading() const{
  * \brief Observation::getIsValid
  * \return
  */
-const bool &Observation::getIsValid() const{
-    return this->isValid;
+bool Observation::getIsValid() const{
+    return this->getFlag(ObservationStore::eIsValid);
 }
 
 /*!
@@ -426,27 +438,47 @@ const bool &Observation::getIsValid() const{
  * \param isSolved
  */
 void Observation::setIsSolved(const bool &isSolved){
-    this->isSolved = isSolved;
+    this->setFlag(ObservationStore::eIsSolved, isSolved);
 }
 
 /*!
  * \brief Observation::getIsSolved
  * \return
  */
-const bool &Observation::getIsSolved() const{
-    return this->isSolved;
+bool Observation::getIsSolved() const{
+    return this->getFlag(ObservationStore::eIsSolved);
 }
 
 /*!
  * \brief Observation::getHasDirection
  * \return
  */
-const bool &Observation::getHasDirection() const{
-    return this->hasDirection;
+bool Observation::getHasDirection() const{
+    return this->getFlag(ObservationStore::eHasDirection);
 }
 
-const bool &Observation::getIsDummyPoint() const{
-    return this->isDummyPoint;
+/*!
+ * \brief Observation::getIsDummyPoint
+ * \return
+ */
+bool Observation::getIsDummyPoint() const{
+    return this->getFlag(ObservationStore::eIsDummyPoint);
+}
+
+/*!
+ * \brief Observation::getStore
+ * \return
+ */
+const QSharedPointer<ObservationStore> &Observation::getStore() const{
+    return this->store;
+}
+
+/*!
+ * \brief Observation::getStoreSlot
+ * \return
+ */
+int Observation::getStoreSlot() const{
+    return this->slot;
 }
 
 /*!
@@ -477,7 +509,7 @@ QString Observation::getDisplayStation() const{
 QString Observation::getDisplayTargetGeometries() const{
 
     QString result = "";
-    foreach(const QPointer<Geometry> &geometry, this->targetGeometriesList){
+    foreach(const QPointer<Geometry> &geometry, this->targetGeometriesList.getValues()){
 
         if(geometry.isNull()){
             continue;
@@ -501,8 +533,8 @@ QString Observation::getDisplayTargetGeometries() const{
  * \return
  */
 QString Observation::getDisplayX(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->xyz.getAt(0), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eXyz)[0], type), 'f', digits);
     }
     return QString("");
 }
@@ -514,8 +546,8 @@ QString Observation::getDisplayX(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Observation::getDisplayY(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->xyz.getAt(1), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eXyz)[1], type), 'f', digits);
     }
     return QString("");
 }
@@ -527,8 +559,8 @@ QString Observation::getDisplayY(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Observation::getDisplayZ(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->xyz.getAt(2), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eXyz)[2], type), 'f', digits);
     }
     return QString("");
 }
@@ -540,8 +572,8 @@ QString Observation::getDisplayZ(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Observation::getDisplaySigmaX(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->sigmaXyz.getAt(0), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eSigmaXyz)[0], type), 'f', digits);
     }
     return QString("");
 }
@@ -553,8 +585,8 @@ QString Observation::getDisplaySigmaX(const UnitType &type, const int &digits) c
  * \return
  */
 QString Observation::getDisplaySigmaY(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->sigmaXyz.getAt(1), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eSigmaXyz)[1], type), 'f', digits);
     }
     return QString("");
 }
@@ -566,8 +598,8 @@ QString Observation::getDisplaySigmaY(const UnitType &type, const int &digits) c
  * \return
  */
 QString Observation::getDisplaySigmaZ(const UnitType &type, const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(convertFromDefault(this->sigmaXyz.getAt(2), type), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(convertFromDefault(this->getVectorData(ObservationStore::eSigmaXyz)[2], type), 'f', digits);
     }
     return QString("");
 }
@@ -578,8 +610,8 @@ QString Observation::getDisplaySigmaZ(const UnitType &type, const int &digits) c
  * \return
  */
 QString Observation::getDisplayI(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->ijk.getAt(0), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eIjk)[0], 'f', digits);
     }
     return QString("");
 }
@@ -590,8 +622,8 @@ QString Observation::getDisplayI(const int &digits) const{
  * \return
  */
 QString Observation::getDisplayJ(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->ijk.getAt(1), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eIjk)[1], 'f', digits);
     }
     return QString("");
 }
@@ -602,8 +634,8 @@ QString Observation::getDisplayJ(const int &digits) const{
  * \return
  */
 QString Observation::getDisplayK(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->ijk.getAt(2), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eIjk)[2], 'f', digits);
     }
     return QString("");
 }
@@ -615,8 +647,8 @@ QString Observation::getDisplayK(const int &digits) const{
  * \return
  */
 QString Observation::getDisplaySigmaI(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->sigmaIjk.getAt(0), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eSigmaIjk)[0], 'f', digits);
     }
     return QString("");
 }
@@ -627,8 +659,8 @@ QString Observation::getDisplaySigmaI(const int &digits) const{
  * \return
  */
 QString Observation::getDisplaySigmaJ(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->sigmaIjk.getAt(1), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eSigmaIjk)[1], 'f', digits);
     }
     return QString("");
 }
@@ -639,8 +671,8 @@ QString Observation::getDisplaySigmaJ(const int &digits) const{
  * \return
  */
 QString Observation::getDisplaySigmaK(const int &digits) const{
-    if(this->isValid && this->isSolved){
-        return QString::number(this->sigmaIjk.getAt(2), 'f', digits);
+    if(this->getIsValid() && this->getIsSolved()){
+        return QString::number(this->getVectorData(ObservationStore::eSigmaIjk)[2], 'f', digits);
     }
     return QString("");
 }
@@ -650,7 +682,7 @@ QString Observation::getDisplaySigmaK(const int &digits) const{
  * \return
  */
 QString Observation::getDisplayIsValid() const{
-    return this->isValid?"true":"false";
+    return this->getIsValid()?"true":"false";
 }
 
 /*!
@@ -658,7 +690,7 @@ QString Observation::getDisplayIsValid() const{
  * \return
  */
 QString Observation::getDisplayIsSolved() const{
-    return this->isSolved?"true":"false";
+    return this->getIsSolved()?"true":"false";
 }
 
 /*!
@@ -677,49 +709,26 @@ QDomElement Observation::toOpenIndyXML(QDomDocument &xmlDoc) const{
     observation.setTagName("observation");
 
     //add observation attributes
-    if(this->xyz.getSize() >= 3){
-        observation.setAttribute("x", this->xyz.getAt(0));
-        observation.setAttribute("y", this->xyz.getAt(1));
-        observation.setAttribute("z", this->xyz.getAt(2));
-    }else{
-        observation.setAttribute("x", 0.0);
-        observation.setAttribute("y", 0.0);
-        observation.setAttribute("z", 0.0);
-    }
-    if(this->ijk.getSize() >= 3){
-        observation.setAttribute("i", this->ijk.getAt(0));
-        observation.setAttribute("j", this->ijk.getAt(1));
-        observation.setAttribute("k", this->ijk.getAt(2));
-    }else{
-        observation.setAttribute("i", 0.0);
-        observation.setAttribute("j", 0.0);
-        observation.setAttribute("k", 1.0);
-    }
-    if(this->sigmaXyz.getSize() >= 3){
-        observation.setAttribute("sigmaX", this->sigmaXyz.getAt(0));
-        observation.setAttribute("sigmaY", this->sigmaXyz.getAt(1));
-        observation.setAttribute("sigmaZ", this->sigmaXyz.getAt(2));
-    }else{
-        observation.setAttribute("sigmaX", 0.0);
-        observation.setAttribute("sigmaY", 0.0);
-        observation.setAttribute("sigmaZ", 0.0);
-    }
-    if(this->sigmaIjk.getSize() >= 3){
-        observation.setAttribute("sigmaI", this->sigmaIjk.getAt(0));
-        observation.setAttribute("sigmaJ", this->sigmaIjk.getAt(1));
-        observation.setAttribute("sigmaK", this->sigmaIjk.getAt(2));
-    }else{
-        observation.setAttribute("sigmaI", 0.0);
-        observation.setAttribute("sigmaJ", 0.0);
-        observation.setAttribute("sigmaK", 0.0);
-    }
-    /*observation.setAttribute("sigmaX", 0.0);
-    observation.setAttribute("sigmaY", 0.0);
-    observation.setAttribute("sigmaZ", 0.0);*/
-
-    observation.setAttribute("isValid", this->isValid);
-    observation.setAttribute("isSolved", this->isSolved);
-    observation.setAttribute("isDummyPoint", this->isDummyPoint);
+    const double *xyz = this->getVectorData(ObservationStore::eXyz);
+    const double *ijk = this->getVectorData(ObservationStore::eIjk);
+    const double *sigmaXyz = this->getVectorData(ObservationStore::eSigmaXyz);
+    const double *sigmaIjk = this->getVectorData(ObservationStore::eSigmaIjk);
+    observation.setAttribute("x", xyz[0]);
+    observation.setAttribute("y", xyz[1]);
+    observation.setAttribute("z", xyz[2]);
+    observation.setAttribute("i", ijk[0]);
+    observation.setAttribute("j", ijk[1]);
+    observation.setAttribute("k", ijk[2]);
+    observation.setAttribute("sigmaX", sigmaXyz[0]);
+    observation.setAttribute("sigmaY", sigmaXyz[1]);
+    observation.setAttribute("sigmaZ", sigmaXyz[2]);
+    observation.setAttribute("sigmaI", sigmaIjk[0]);
+    observation.setAttribute("sigmaJ", sigmaIjk[1]);
+    observation.setAttribute("sigmaK", sigmaIjk[2]);
+
+    observation.setAttribute("isValid", this->getIsValid());
+    observation.setAttribute("isSolved", this->getIsSolved());
+    observation.setAttribute("isDummyPoint", this->getIsDummyPoint());
 
     //add station
     if(!this->station.isNull()){
@@ -764,24 +773,20 @@ bool Observation::fromOpenIndyXML(QDomElement &xmlElem){
                 || !xmlElem.hasAttribute("sigmaZ")){
             return false;
         }
-        this->isValid = xmlElem.attribute("isValid").toInt();
-        this->isSolved = xmlElem.attribute("isSolved").toInt();
-        this->isDummyPoint = xmlElem.hasAttribute("isDummyPoint") ? xmlElem.attribute("isDummyPoint").toInt() : false;
-        this->xyz.setAt(0, xmlElem.attribute("x").toDouble());
-        this->xyz.setAt(1, xmlElem.attribute("y").toDouble());
-        this->xyz.setAt(2, xmlElem.attribute("z").toDouble());
-        this->xyz.setAt(3, 1.0);
-        this->sigmaXyz.setAt(0, xmlElem.attribute("sigmaX").toDouble());
-        this->sigmaXyz.setAt(1, xmlElem.attribute("sigmaY").toDouble());
-        this->sigmaXyz.setAt(2, xmlElem.attribute("sigmaZ").toDouble());
-
-        this->ijk.setAt(0, xmlElem.attribute("i").toDouble());
-        this->ijk.setAt(1, xmlElem.attribute("j").toDouble());
-        this->ijk.setAt(2, xmlElem.attribute("k").toDouble());
-        this->ijk.setAt(3, 1.0);
-        this->sigmaIjk.setAt(0, xmlElem.attribute("sigmaI").toDouble());
-        this->sigmaIjk.setAt(1, xmlElem.attribute("sigmaJ").toDouble());
-        this->sigmaIjk.setAt(2, xmlElem.attribute("sigmaK").toDouble());
+        this->setFlag(ObservationStore::eIsValid, xmlElem.attribute("isValid").toInt());
+        this->setFlag(ObservationStore::eIsSolved, xmlElem.attribute("isSolved").toInt());
+        this->setFlag(ObservationStore::eIsDummyPoint, xmlElem.hasAttribute("isDummyPoint") ? xmlElem.attribute("isDummyPoint").toInt() : false);
+        const double *sigmaXyz = this->getVectorData(ObservationStore::eSigmaXyz);
+        const double *sigmaIjk = this->getVectorData(ObservationStore::eSigmaIjk);
+        this->setVector(ObservationStore::eXyz, xmlElem.attribute("x").toDouble(), xmlElem.attribute("y").toDouble(),
+                        xmlElem.attribute("z").toDouble(), 1.0);
+        this->setVector(ObservationStore::eSigmaXyz, xmlElem.attribute("sigmaX").toDouble(), xmlElem.attribute("sigmaY").toDouble(),
+                        xmlElem.attribute("sigmaZ").toDouble(), sigmaXyz[3]);
+
+        this->setVector(ObservationStore::eIjk, xmlElem.attribute("i").toDouble(), xmlElem.attribute("j").toDouble(),
+                        xmlElem.attribute("k").toDouble(), 1.0);
+        this->setVector(ObservationStore::eSigmaIjk, xmlElem.attribute("sigmaI").toDouble(), xmlElem.attribute("sigmaJ").toDouble(),
+                        xmlElem.attribute("sigmaK").toDouble(), sigmaIjk[3]);
 
         //set reading
         QDomElement reading = xmlElem.firstChildElement("reading");
@@ -797,3 +802,241 @@ bool Observation::fromOpenIndyXML(QDomElement &xmlElem){
     return result;
 
 }
+
+/*!
+ * \brief Observation::toOpenIndyXML
+ * Writes the observation and its reading to the given stream using the same schema as the DOM variant
+ * \param xmlWriter
+ */
+void Observation::toOpenIndyXML(QXmlStreamWriter &xmlWriter) const{
+
+    xmlWriter.writeStartElement("observation");
+
+    //add observation attributes (numbers are formatted like QDomElement::setAttribute does)
+    const double *xyz = this->getVectorData(ObservationStore::eXyz);
+    const double *ijk = this->getVectorData(ObservationStore::eIjk);
+    const double *sigmaXyz = this->getVectorData(ObservationStore::eSigmaXyz);
+    const double *sigmaIjk = this->getVectorData(ObservationStore::eSigmaIjk);
+    xmlWriter.writeAttribute("id", QString::number(this->getId()));
+    xmlWriter.writeAttribute("x", QString::number(xyz[0], 'g', 17));
+    xmlWriter.writeAttribute("y", QString::number(xyz[1], 'g', 17));
+    xmlWriter.writeAttribute("z", QString::number(xyz[2], 'g', 17));
+    xmlWriter.writeAttribute("i", QString::number(ijk[0], 'g', 17));
+    xmlWriter.writeAttribute("j", QString::number(ijk[1], 'g', 17));
+    xmlWriter.writeAttribute("k", QString::number(ijk[2], 'g', 17));
+    xmlWriter.writeAttribute("sigmaX", QString::number(sigmaXyz[0], 'g', 17));
+    xmlWriter.writeAttribute("sigmaY", QString::number(sigmaXyz[1], 'g', 17));
+    xmlWriter.writeAttribute("sigmaZ", QString::number(sigmaXyz[2], 'g', 17));
+    xmlWriter.writeAttribute("sigmaI", QString::number(sigmaIjk[0], 'g', 17));
+    xmlWriter.writeAttribute("sigmaJ", QString::number(sigmaIjk[1], 'g', 17));
+    xmlWriter.writeAttribute("sigmaK", QString::number(sigmaIjk[2], 'g', 17));
+
+    xmlWriter.writeAttribute("isValid", QString::number(this->getIsValid()));
+    xmlWriter.writeAttribute("isSolved", QString::number(this->getIsSolved()));
+    xmlWriter.writeAttribute("isDummyPoint", QString::number(this->getIsDummyPoint()));
+
+    //add station
+    if(!this->station.isNull()){
+        xmlWriter.writeEmptyElement("station");
+        xmlWriter.writeAttribute("ref", QString::number(this->station->getId()));
+    }
+
+    //add reading
+    if(!this->reading.isNull()){
+        this->reading->toOpenIndyXML(xmlWriter);
+    }
+
+    //add measuredTargetGeometry
+    if(!this->measuredTargetGeometry.isNull()){
+        xmlWriter.writeEmptyElement("measuredTargetGeometry");
+        xmlWriter.writeAttribute("ref", QString::number(this->measuredTargetGeometry->getId()));
+    }
+
+    xmlWriter.writeEndElement();
+
+}
+
+/*!
+ * \brief Observation::fromOpenIndyXML
+ * Reads the observation and its reading from the given stream. The reader has to be positioned at the start element
+ * of the observation and is positioned at its end element afterwards.
+ * \param xmlReader
+ * \return
+ */
+bool Observation::fromOpenIndyXML(QXmlStreamReader &xmlReader){
+
+    if(!xmlReader.isStartElement()){
+        return false;
+    }
+
+    QXmlStreamAttributes attributes = xmlReader.attributes();
+    if(!attributes.hasAttribute("id")){
+        xmlReader.skipCurrentElement();
+        return false;
+    }
+    this->id = attributes.value("id").toInt();
+
+    //set observation attributes
+    if(!attributes.hasAttribute("isValid") || !attributes.hasAttribute("isSolved") || !attributes.hasAttribute("x") || !attributes.hasAttribute("y")
+            || !attributes.hasAttribute("z") || !attributes.hasAttribute("sigmaX") || !attributes.hasAttribute("sigmaY")
+            || !attributes.hasAttribute("sigmaZ")){
+        xmlReader.skipCurrentElement();
+        return false;
+    }
+    this->setFlag(ObservationStore::eIsValid, attributes.value("isValid").toInt());
+    this->setFlag(ObservationStore::eIsSolved, attributes.value("isSolved").toInt());
+    this->setFlag(ObservationStore::eIsDummyPoint, attributes.hasAttribute("isDummyPoint") ? attributes.value("isDummyPoint").toInt() : false);
+    const double *sigmaXyz = this->getVectorData(ObservationStore::eSigmaXyz);
+    const double *sigmaIjk = this->getVectorData(ObservationStore::eSigmaIjk);
+    this->setVector(ObservationStore::eXyz, attributes.value("x").toDouble(), attributes.value("y").toDouble(),
+                    attributes.value("z").toDouble(), 1.0);
+    this->setVector(ObservationStore::eSigmaXyz, attributes.value("sigmaX").toDouble(), attributes.value("sigmaY").toDouble(),
+                    attributes.value("sigmaZ").toDouble(), sigmaXyz[3]);
+
+    this->setVector(ObservationStore::eIjk, attributes.value("i").toDouble(), attributes.value("j").toDouble(),
+                    attributes.value("k").toDouble(), 1.0);
+    this->setVector(ObservationStore::eSigmaIjk, attributes.value("sigmaI").toDouble(), attributes.value("sigmaJ").toDouble(),
+                    attributes.value("sigmaK").toDouble(), sigmaIjk[3]);
+
+    //set reading (station and target geometries are resolved by their ref when the whole project is loaded)
+    bool hasReading = false;
+    bool result = false;
+    while(xmlReader.readNextStartElement()){
+        if(xmlReader.name() == QLatin1String("reading") && !hasReading){
+            hasReading = true;
+            this->reading = new Reading();
+            result = this->reading->fromOpenIndyXML(xmlReader);
+            this->reading->setObservation(this);
+            continue;
+        }
+        xmlReader.skipCurrentElement();
+    }
+
+    return result && !xmlReader.hasError();
+
+}
+
+/*!
+ * \brief Observation::getVector
+ * Returns the given vector without allocating an OiVec
+ * \param vector
+ * \return
+ */
+Vec4 Observation::getVector(const ObservationStore::ObservationVectors &vector) const{
+    const double *v = this->getVectorData(vector);
+    return Vec4(v[0], v[1], v[2], v[3]);
+}
+
+/*!
+ * \brief Observation::getVectorData
+ * \param vector
+ * \return the four doubles of the vector (zero if the observation has no data yet)
+ */
+const double *Observation::getVectorData(const ObservationStore::ObservationVectors &vector) const{
+    static const double zero[4] = {0.0, 0.0, 0.0, 0.0};
+    if(this->store.isNull()){
+        return zero;
+    }
+    return this->store->getVector(this->slot, vector);
+}
+
+/*!
+ * \brief Observation::getFlag
+ * \param flag
+ * \return
+ */
+bool Observation::getFlag(const ObservationStore::ObservationFlags &flag) const{
+    if(this->store.isNull()){
+        return false;
+    }
+    return this->store->getFlag(this->slot, flag);
+}
+
+/*!
+ * \brief Observation::setVector
+ * \param vector
+ * \param x
+ * \param y
+ * \param z
+ * \param h
+ */
+void Observation::setVector(const ObservationStore::ObservationVectors &vector, const double &x, const double &y, const double &z, const double &h){
+    this->ensureStore();
+    this->store->setVector(this->slot, vector, x, y, z, h);
+}
+
+/*!
+ * \brief Observation::setVector
+ * \param vector
+ * \param v
+ */
+void Observation::setVector(const ObservationStore::ObservationVectors &vector, const OiVec &v){
+    this->ensureStore();
+    this->store->setOiVec(this->slot, vector, v);
+}
+
+/*!
+ * \brief Observation::setFlag
+ * \param flag
+ * \param state
+ */
+void Observation::setFlag(const ObservationStore::ObservationFlags &flag, const bool &state){
+    this->ensureStore();
+    this->store->setFlag(this->slot, flag, state);
+}
+
+/*!
+ * \brief Observation::ensureStore
+ * Gives an observation that is not part of a station system yet a slot in the shared detached store
+ */
+void Observation::ensureStore(){
+    if(this->store.isNull()){
+        this->store = Observation::getDetachedStore();
+        this->slot = this->store->allocate(this->id);
+    }
+}
+
+/*!
+ * \brief Observation::getDetachedStore
+ * Returns the store that is shared by all observations which are not part of a station system yet.
+ * The store is created on first use. Its slots are released when the observations are moved to the store of
+ * a station system, so that it only holds the observations that are currently detached.
+ * \return
+ */
+const QSharedPointer<ObservationStore> &Observation::getDetachedStore(){
+    static const QSharedPointer<ObservationStore> detachedStore(new ObservationStore());
+    return detachedStore;
+}
+
+/*!
+ * \brief Observation::moveToStore
+ * Moves the observation data to the given store (e.g. the store of a station system) and frees the old slot
+ * \param store
+ */
+void Observation::moveToStore(const QSharedPointer<ObservationStore> &store){
+
+    //check store
+    if(store.isNull()){
+        return;
+    }
+
+    //the observation was created in the store or has no data yet
+    if(store == this->store){
+        this->store->setId(this->slot, this->id);
+        return;
+    }
+    if(this->store.isNull()){
+        this->store = store;
+        this->slot = store->allocate(this->id);
+        return;
+    }
+
+    int newSlot = store->allocate(this->id);
+    this->store->copySlot(this->slot, *store.data(), newSlot);
+    store->setId(newSlot, this->id);
+    this->store->release(this->slot);
+
+    this->store = store;
+    this->slot = newSlot;
+
+}
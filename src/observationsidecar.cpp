@@ -0,0 +1,846 @@
+#include "observationsidecar.h"
+
+#include <limits>
+#include <string.h>
+
+#include "observation.h"
+#include "reading.h"
+#include "station.h"
+#include "coordinatesystem.h"
+#include "readingconversion.h"
+
+using namespace oi;
+
+namespace{
+
+//############################
+//binary layout of the sidecar
+//############################
+
+const char sidecarMagic[4] = {'O', 'I', 'O', 'B'};
+const quint32 sidecarByteOrder = 0x01020304; //detects files that were written on a machine with another byte order
+const qint64 invalidTime = std::numeric_limits<qint64>::min();
+const int rowsPerChunk = 4096; //number of rows that are converted before they are written
+
+struct SidecarHeader{
+    char magic[4];
+    quint32 version;
+    quint32 byteOrder;
+    quint32 numStations;
+};
+
+struct SidecarDirectoryEntry{
+    qint32 stationId;
+    qint32 firstObservationId;
+    qint32 lastObservationId;
+    quint32 numObservations;
+    quint64 offset;
+    quint64 size;
+    quint32 checksum;
+    quint32 reserved;
+};
+
+Q_STATIC_ASSERT(sizeof(SidecarHeader) == 16);
+Q_STATIC_ASSERT(sizeof(SidecarDirectoryEntry) == 40);
+
+qint64 align8(const qint64 &size){
+    return (size + 7) & ~qint64(7);
+}
+
+/*!
+ * \brief updateAdler32
+ * Continues the Adler-32 checksum of a byte sequence
+ */
+quint32 updateAdler32(quint32 adler, const uchar *data, qint64 size){
+
+    quint32 a = adler & 0xffff;
+    quint32 b = (adler >> 16) & 0xffff;
+    while(size > 0){
+        //5552 is the largest number of bytes that cannot overflow b before the modulo
+        qint64 n = qMin(size, qint64(5552));
+        size -= n;
+        while(n-- > 0){
+            a += *data++;
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+
+}
+
+}
+
+const quint32 ObservationSidecar::version;
+
+/*!
+ * \brief ObservationSidecar::ObservationSidecar
+ */
+ObservationSidecar::ObservationSidecar() : data(NULL), size(0){
+
+}
+
+/*!
+ * \brief ObservationSidecar::~ObservationSidecar
+ */
+ObservationSidecar::~ObservationSidecar(){
+    this->close();
+}
+
+/*!
+ * \brief ObservationSidecar::addStation
+ * Adds all observations of the given station to the next save
+ * \param station
+ * \return
+ */
+bool ObservationSidecar::addStation(const QPointer<Station> &station){
+
+    if(station.isNull() || station->getCoordinateSystem().isNull()){
+        return this->setError("Cannot add an invalid station to the sidecar");
+    }
+
+    return this->addStation(station->getId(), station->getCoordinateSystem()->getObservations());
+
+}
+
+/*!
+ * \brief ObservationSidecar::addStation
+ * Adds the given observations of a station to the next save
+ * \param stationId
+ * \param observations
+ * \return false if the station was already added or an observation has an undefined reading (that has to stay in XML)
+ */
+bool ObservationSidecar::addStation(const int &stationId, const QList<QPointer<Observation> > &observations){
+
+    if(this->pendingObservations.contains(stationId)){
+        return this->setError(QString("The station %1 was already added to the sidecar").arg(stationId));
+    }
+
+    QList<QPointer<Observation> > validObservations;
+    validObservations.reserve(observations.size());
+    foreach(const QPointer<Observation> &observation, observations){
+        if(observation.isNull()){
+            continue;
+        }
+        if(!observation->getReading().isNull() && observation->getReading()->getTypeOfReading() == eUndefinedReading){
+            return this->setError(QString("The observation %1 has an undefined reading that cannot be saved in a sidecar")
+                                  .arg(observation->getId()));
+        }
+        validObservations.append(observation);
+    }
+
+    this->pendingStations.append(stationId);
+    this->pendingObservations.insert(stationId, validObservations);
+
+    return true;
+
+}
+
+/*!
+ * \brief ObservationSidecar::save
+ * Writes all added stations to the given file. Afterwards the sidecar can be referenced in XML.
+ * \param fileName
+ * \return
+ */
+bool ObservationSidecar::save(const QString &fileName){
+
+    this->close();
+    this->errorMessage = QString();
+
+    QFile out(fileName);
+    if(!out.open(QIODevice::ReadWrite | QIODevice::Truncate)){
+        return this->setError(QString("Cannot open the sidecar %1: %2").arg(fileName).arg(out.errorString()));
+    }
+
+    //write header and a placeholder for the directory
+    SidecarHeader header;
+    memcpy(header.magic, sidecarMagic, 4);
+    header.version = ObservationSidecar::version;
+    header.byteOrder = sidecarByteOrder;
+    header.numStations = this->pendingStations.size();
+    QByteArray directory(this->pendingStations.size() * sizeof(SidecarDirectoryEntry), 0);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(SidecarHeader));
+    out.write(directory);
+
+    QList<StationBlock> blocks;
+    qint64 offset = align8(out.pos());
+    for(int s = 0; s < this->pendingStations.size(); s++){
+
+        int stationId = this->pendingStations.at(s);
+        const QList<QPointer<Observation> > &observations = this->pendingObservations[stationId];
+        const int numObservations = observations.size();
+
+        SidecarDirectoryEntry entry;
+        memset(&entry, 0, sizeof(SidecarDirectoryEntry));
+        entry.stationId = stationId;
+        entry.firstObservationId = -1;
+        entry.lastObservationId = -1;
+        entry.numObservations = numObservations;
+        entry.offset = offset;
+
+        //write the columns chunk wise (each chunk of a column is written to its final position)
+        QStringList configNames;
+        QHash<QString, int> configIndices;
+        QVector<QByteArray> chunks(eNumSidecarColumns);
+        for(int first = 0; first < numObservations; first += rowsPerChunk){
+
+            int count = qMin(rowsPerChunk, numObservations - first);
+            for(int c = 0; c < eNumSidecarColumns; c++){
+                chunks[c].fill(0, count * ObservationSidecar::getColumnElementSize((SidecarColumns)c));
+            }
+
+            for(int row = 0; row < count; row++){
+
+                const QPointer<Observation> &observation = observations.at(first + row);
+
+                //observation id range of the station
+                int id = observation->getId();
+                if(entry.firstObservationId < 0 || id < entry.firstObservationId){
+                    entry.firstObservationId = id;
+                }
+                entry.lastObservationId = qMax(entry.lastObservationId, id);
+
+                reinterpret_cast<qint32 *>(chunks[eObservationIds].data())[row] = id;
+                quint8 observationFlags = 0;
+                if(observation->getIsValid()) observationFlags |= ObservationStore::eIsValid;
+                if(observation->getIsSolved()) observationFlags |= ObservationStore::eIsSolved;
+                if(observation->getHasDirection()) observationFlags |= ObservationStore::eHasDirection;
+                if(observation->getIsDummyPoint()) observationFlags |= ObservationStore::eIsDummyPoint;
+                reinterpret_cast<quint8 *>(chunks[eObservationFlags].data())[row] = observationFlags;
+
+                const double *xyz = observation->getVectorData(ObservationStore::eXyz);
+                const double *ijk = observation->getVectorData(ObservationStore::eIjk);
+                const double *sigmaXyz = observation->getVectorData(ObservationStore::eSigmaXyz);
+                const double *sigmaIjk = observation->getVectorData(ObservationStore::eSigmaIjk);
+                for(int i = 0; i < 3; i++){
+                    reinterpret_cast<double *>(chunks[eX + i].data())[row] = xyz[i];
+                    reinterpret_cast<double *>(chunks[eI + i].data())[row] = ijk[i];
+                    reinterpret_cast<double *>(chunks[eSigmaX + i].data())[row] = sigmaXyz[i];
+                    reinterpret_cast<double *>(chunks[eSigmaI + i].data())[row] = sigmaIjk[i];
+                }
+
+                //reading
+                const QPointer<Reading> &reading = observation->getReading();
+                if(reading.isNull()){
+                    reinterpret_cast<qint32 *>(chunks[eReadingIds].data())[row] = -1;
+                    reinterpret_cast<qint64 *>(chunks[eMeasuredAt].data())[row] = invalidTime;
+                    reinterpret_cast<qint32 *>(chunks[eSensorConfigs].data())[row] = -1;
+                    reinterpret_cast<qint32 *>(chunks[eMeasurementConfigs].data())[row] = -1;
+                    continue;
+                }
+
+                reinterpret_cast<qint32 *>(chunks[eReadingIds].data())[row] = reading->getId();
+                reinterpret_cast<qint64 *>(chunks[eMeasuredAt].data())[row] = reading->measuredAt.isValid() ?
+                            reading->measuredAt.toMSecsSinceEpoch() : invalidTime;
+                reinterpret_cast<quint8 *>(chunks[eReadingTypes].data())[row] = reading->getTypeOfReading();
+                reinterpret_cast<quint8 *>(chunks[eFaces].data())[row] = reading->getFace();
+                reinterpret_cast<quint8 *>(chunks[eReadingFlags].data())[row] = eHasReading | (reading->isImported() ? eIsImported : 0);
+
+                //config names are saved once per station
+                if(!configIndices.contains(reading->sensorConfigName)){
+                    configIndices.insert(reading->sensorConfigName, configNames.size());
+                    configNames.append(reading->sensorConfigName);
+                }
+                if(!configIndices.contains(reading->measurementConfigName)){
+                    configIndices.insert(reading->measurementConfigName, configNames.size());
+                    configNames.append(reading->measurementConfigName);
+                }
+                reinterpret_cast<qint32 *>(chunks[eSensorConfigs].data())[row] = configIndices.value(reading->sensorConfigName);
+                reinterpret_cast<qint32 *>(chunks[eMeasurementConfigs].data())[row] = configIndices.value(reading->measurementConfigName);
+
+                QStringList types;
+                QList<double> values, sigmas;
+                reading->getXMLMeasurements(types, values, sigmas);
+                for(int i = 0; i < values.size() && i < 6; i++){
+                    reinterpret_cast<double *>(chunks[eValue0 + i].data())[row] = values.at(i);
+                    reinterpret_cast<double *>(chunks[eSigma0 + i].data())[row] = sigmas.at(i);
+                }
+
+            }
+
+            for(int c = 0; c < eNumSidecarColumns; c++){
+                int elementSize = ObservationSidecar::getColumnElementSize((SidecarColumns)c);
+                out.seek(offset + ObservationSidecar::getColumnOffset(numObservations, (SidecarColumns)c) + first * elementSize);
+                out.write(chunks.at(c));
+            }
+
+        }
+
+        //write the config name table behind the (padded) columns
+        QByteArray configTable;
+        quint32 numConfigNames = configNames.size();
+        configTable.append(reinterpret_cast<const char *>(&numConfigNames), sizeof(quint32));
+        foreach(const QString &name, configNames){
+            QByteArray utf8 = name.toUtf8();
+            quint32 length = utf8.size();
+            configTable.append(reinterpret_cast<const char *>(&length), sizeof(quint32));
+            configTable.append(utf8);
+        }
+        qint64 tableOffset = ObservationSidecar::getColumnOffset(numObservations, eNumSidecarColumns);
+        out.seek(offset + tableOffset);
+        out.write(configTable);
+        entry.size = align8(tableOffset + configTable.size());
+        if(out.size() < offset + (qint64)entry.size){
+            out.resize(offset + entry.size);
+        }
+
+        //checksum of the written block
+        out.flush();
+        uchar *block = out.map(offset, entry.size);
+        if(block == NULL){
+            out.close();
+            return this->setError(QString("Cannot map the sidecar %1: %2").arg(fileName).arg(out.errorString()));
+        }
+        entry.checksum = updateAdler32(1, block, entry.size);
+        out.unmap(block);
+
+        memcpy(directory.data() + s * sizeof(SidecarDirectoryEntry), &entry, sizeof(SidecarDirectoryEntry));
+
+        StationBlock stationBlock;
+        stationBlock.stationId = stationId;
+        stationBlock.firstObservationId = entry.firstObservationId;
+        stationBlock.lastObservationId = entry.lastObservationId;
+        stationBlock.numObservations = numObservations;
+        blocks.append(stationBlock);
+
+        offset += entry.size;
+
+    }
+
+    //write the directory
+    out.seek(sizeof(SidecarHeader));
+    out.write(directory);
+    out.close();
+
+    if(out.error() != QFileDevice::NoError){
+        return this->setError(QString("Cannot write the sidecar %1: %2").arg(fileName).arg(out.errorString()));
+    }
+
+    this->pendingStations.clear();
+    this->pendingObservations.clear();
+    this->fileName = fileName;
+    this->stationBlocks = blocks;
+
+    return true;
+
+}
+
+/*!
+ * \brief ObservationSidecar::load
+ * Maps the given sidecar into memory and checks its header, directory and (optionally) the block checksums
+ * \param fileName
+ * \param verifyChecksums
+ * \return
+ */
+bool ObservationSidecar::load(const QString &fileName, const bool &verifyChecksums){
+
+    this->close();
+    this->errorMessage = QString();
+
+    this->file.setFileName(fileName);
+    if(!this->file.open(QIODevice::ReadOnly)){
+        return this->setError(QString("Cannot open the sidecar %1: %2").arg(fileName).arg(this->file.errorString()));
+    }
+
+    this->size = this->file.size();
+    if(this->size < (qint64)sizeof(SidecarHeader)){
+        this->close();
+        return this->setError(QString("The sidecar %1 is truncated").arg(fileName));
+    }
+    this->data = this->file.map(0, this->size);
+    if(this->data == NULL){
+        QString error = this->file.errorString();
+        this->close();
+        return this->setError(QString("Cannot map the sidecar %1: %2").arg(fileName).arg(error));
+    }
+
+    //check header
+    SidecarHeader header;
+    memcpy(&header, this->data, sizeof(SidecarHeader));
+    if(memcmp(header.magic, sidecarMagic, 4) != 0){
+        this->close();
+        return this->setError(QString("The file %1 is no observation sidecar").arg(fileName));
+    }
+    if(header.byteOrder != sidecarByteOrder){
+        this->close();
+        return this->setError(QString("The sidecar %1 was written with another byte order").arg(fileName));
+    }
+    if(header.version > ObservationSidecar::version){
+        this->close();
+        return this->setError(QString("The sidecar %1 has the unsupported version %2").arg(fileName).arg(header.version));
+    }
+    if((qint64)sizeof(SidecarHeader) + (qint64)header.numStations * (qint64)sizeof(SidecarDirectoryEntry) > this->size){
+        this->close();
+        return this->setError(QString("The sidecar %1 is truncated").arg(fileName));
+    }
+
+    //check directory and station blocks
+    for(quint32 s = 0; s < header.numStations; s++){
+
+        SidecarDirectoryEntry entry;
+        memcpy(&entry, this->data + sizeof(SidecarHeader) + s * sizeof(SidecarDirectoryEntry), sizeof(SidecarDirectoryEntry));
+
+        qint64 minimumSize = ObservationSidecar::getColumnOffset(entry.numObservations, eNumSidecarColumns) + sizeof(quint32);
+        if(entry.offset % 8 != 0 || (qint64)entry.size < minimumSize || (qint64)(entry.offset + entry.size) > this->size
+                || this->stationOffsets.contains(entry.stationId)){
+            this->close();
+            return this->setError(QString("The sidecar %1 has an invalid block for station %2").arg(fileName).arg(entry.stationId));
+        }
+        if(verifyChecksums && updateAdler32(1, this->data + entry.offset, entry.size) != entry.checksum){
+            this->close();
+            return this->setError(QString("The checksum of station %1 in the sidecar %2 does not match").arg(entry.stationId).arg(fileName));
+        }
+
+        StationBlock block;
+        block.stationId = entry.stationId;
+        block.firstObservationId = entry.firstObservationId;
+        block.lastObservationId = entry.lastObservationId;
+        block.numObservations = entry.numObservations;
+        this->stationBlocks.append(block);
+        this->stationOffsets.insert(entry.stationId, entry.offset);
+        this->stationSizes.insert(entry.stationId, entry.size);
+
+    }
+
+    this->fileName = fileName;
+
+    return true;
+
+}
+
+/*!
+ * \brief ObservationSidecar::close
+ * Unmaps a loaded sidecar
+ */
+void ObservationSidecar::close(){
+
+    if(this->data != NULL){
+        this->file.unmap(this->data);
+        this->data = NULL;
+    }
+    if(this->file.isOpen()){
+        this->file.close();
+    }
+    this->size = 0;
+    this->fileName = QString();
+    this->stationBlocks.clear();
+    this->stationOffsets.clear();
+    this->stationSizes.clear();
+
+}
+
+/*!
+ * \brief ObservationSidecar::getIsLoaded
+ * \return
+ */
+bool ObservationSidecar::getIsLoaded() const{
+    return this->data != NULL;
+}
+
+/*!
+ * \brief ObservationSidecar::getFileName
+ * \return
+ */
+const QString &ObservationSidecar::getFileName() const{
+    return this->fileName;
+}
+
+/*!
+ * \brief ObservationSidecar::getStationBlocks
+ * \return
+ */
+const QList<ObservationSidecar::StationBlock> &ObservationSidecar::getStationBlocks() const{
+    return this->stationBlocks;
+}
+
+/*!
+ * \brief ObservationSidecar::getNumObservations
+ * \param stationId
+ * \return
+ */
+int ObservationSidecar::getNumObservations(const int &stationId) const{
+    foreach(const StationBlock &block, this->stationBlocks){
+        if(block.stationId == stationId){
+            return block.numObservations;
+        }
+    }
+    return 0;
+}
+
+/*!
+ * \brief ObservationSidecar::getColumnElementSize
+ * Returns the number of bytes of one value of the given column
+ * \param column
+ * \return
+ */
+int ObservationSidecar::getColumnElementSize(const SidecarColumns &column){
+
+    switch(column){
+    case eObservationIds:
+    case eReadingIds:
+    case eSensorConfigs:
+    case eMeasurementConfigs:
+        return sizeof(qint32);
+    case eMeasuredAt:
+        return sizeof(qint64);
+    case eReadingTypes:
+    case eFaces:
+    case eObservationFlags:
+    case eReadingFlags:
+        return sizeof(quint8);
+    case eNumSidecarColumns:
+        return 0;
+    default:
+        return sizeof(double);
+    }
+
+}
+
+/*!
+ * \brief ObservationSidecar::getColumnData
+ * Returns a pointer to the first value of the given column in the mapped file (NULL if the station is not available)
+ * \param stationId
+ * \param column
+ * \return
+ */
+const uchar *ObservationSidecar::getColumnData(const int &stationId, const SidecarColumns &column) const{
+
+    if(this->data == NULL || column == eNumSidecarColumns || !this->stationOffsets.contains(stationId)){
+        return NULL;
+    }
+
+    return this->data + this->stationOffsets.value(stationId)
+            + ObservationSidecar::getColumnOffset(this->getNumObservations(stationId), column);
+
+}
+
+/*!
+ * \brief ObservationSidecar::getConfigNames
+ * Returns the sensor and measurement config names that are referenced by the config columns of a station
+ * \param stationId
+ * \return
+ */
+QStringList ObservationSidecar::getConfigNames(const int &stationId) const{
+
+    QStringList names;
+
+    if(this->data == NULL || !this->stationOffsets.contains(stationId)){
+        return names;
+    }
+
+    qint64 offset = this->stationOffsets.value(stationId);
+    qint64 end = offset + this->stationSizes.value(stationId);
+    offset += ObservationSidecar::getColumnOffset(this->getNumObservations(stationId), eNumSidecarColumns);
+
+    quint32 numNames = 0;
+    memcpy(&numNames, this->data + offset, sizeof(quint32));
+    offset += sizeof(quint32);
+    for(quint32 i = 0; i < numNames && offset + (qint64)sizeof(quint32) <= end; i++){
+        quint32 length = 0;
+        memcpy(&length, this->data + offset, sizeof(quint32));
+        offset += sizeof(quint32);
+        if(offset + length > end){
+            break;
+        }
+        names.append(QString::fromUtf8(reinterpret_cast<const char *>(this->data + offset), length));
+        offset += length;
+    }
+
+    return names;
+
+}
+
+/*!
+ * \brief ObservationSidecar::createObservations
+ * Creates the observations and readings of a station from the mapped columns.
+ * The observations are allocated in the given store (a new store shared by all of them if it is null).
+ * All polar readings are converted into cartesian coordinates at once. Like in fromOpenIndyXML the station and
+ * target geometries are not set.
+ * \param stationId
+ * \param store
+ * \return
+ */
+QList<QPointer<Observation> > ObservationSidecar::createObservations(const int &stationId, const QSharedPointer<ObservationStore> &store) const{
+
+    QList<QPointer<Observation> > observations;
+
+    const int numObservations = this->getNumObservations(stationId);
+    if(this->data == NULL || numObservations == 0){
+        return observations;
+    }
+
+    const qint32 *observationIds = this->getColumn<qint32>(stationId, eObservationIds);
+    const qint32 *readingIds = this->getColumn<qint32>(stationId, eReadingIds);
+    const qint64 *measuredAt = this->getColumn<qint64>(stationId, eMeasuredAt);
+    const quint8 *readingTypes = this->getColumn<quint8>(stationId, eReadingTypes);
+    const quint8 *faces = this->getColumn<quint8>(stationId, eFaces);
+    const quint8 *observationFlags = this->getColumn<quint8>(stationId, eObservationFlags);
+    const quint8 *readingFlags = this->getColumn<quint8>(stationId, eReadingFlags);
+    const qint32 *sensorConfigs = this->getColumn<qint32>(stationId, eSensorConfigs);
+    const qint32 *measurementConfigs = this->getColumn<qint32>(stationId, eMeasurementConfigs);
+    const double *vectors[12];
+    for(int i = 0; i < 12; i++){
+        vectors[i] = this->getColumn<double>(stationId, (SidecarColumns)(eX + i));
+    }
+    const double *values[6], *sigmas[6];
+    for(int i = 0; i < 6; i++){
+        values[i] = this->getColumn<double>(stationId, (SidecarColumns)(eValue0 + i));
+        sigmas[i] = this->getColumn<double>(stationId, (SidecarColumns)(eSigma0 + i));
+    }
+    QStringList configNames = this->getConfigNames(stationId);
+
+    //all observations of the station share one store
+    QSharedPointer<ObservationStore> observationStore = store;
+    if(observationStore.isNull()){
+        observationStore = QSharedPointer<ObservationStore>(new ObservationStore());
+    }
+    observationStore->reserve(observationStore->getSize() + numObservations);
+
+    //polar readings that are converted (and attached to their observation) after all rows were read
+    PolarReadingBatch polar;
+    QList<Reading *> polarReadings;
+    QList<Observation *> polarObservations;
+
+    observations.reserve(numObservations);
+    for(int row = 0; row < numObservations; row++){
+
+        Observation *observation = new Observation(observationStore);
+        observation->id = observationIds[row];
+        observationStore->setId(observation->slot, observation->id);
+        observationStore->setVector(observation->slot, ObservationStore::eXyz,
+                                    vectors[eX - eX][row], vectors[eY - eX][row], vectors[eZ - eX][row], 1.0);
+        observationStore->setVector(observation->slot, ObservationStore::eSigmaXyz,
+                                    vectors[eSigmaX - eX][row], vectors[eSigmaY - eX][row], vectors[eSigmaZ - eX][row], 0.0);
+        observationStore->setVector(observation->slot, ObservationStore::eIjk,
+                                    vectors[eI - eX][row], vectors[eJ - eX][row], vectors[eK - eX][row], 1.0);
+        observationStore->setVector(observation->slot, ObservationStore::eSigmaIjk,
+                                    vectors[eSigmaI - eX][row], vectors[eSigmaJ - eX][row], vectors[eSigmaK - eX][row], 0.0);
+        observations.append(observation);
+
+        if(!(readingFlags[row] & eHasReading)){
+            continue;
+        }
+
+        Reading *reading = new Reading();
+        reading->id = readingIds[row];
+        reading->variant.setType((ReadingTypes)readingTypes[row]);
+        reading->measuredAt = measuredAt[row] != invalidTime ? QDateTime::fromMSecsSinceEpoch(measuredAt[row]) : QDateTime();
+        reading->face = (SensorFaces)faces[row];
+        reading->imported = readingFlags[row] & eIsImported;
+        if(sensorConfigs[row] >= 0 && sensorConfigs[row] < configNames.size()){
+            reading->sensorConfigName = configNames.at(sensorConfigs[row]);
+        }
+        if(measurementConfigs[row] >= 0 && measurementConfigs[row] < configNames.size()){
+            reading->measurementConfigName = configNames.at(measurementConfigs[row]);
+        }
+
+        //set the values and sigmas in the order they are saved (like the measurements in XML)
+        switch(reading->variant.getType()){
+        case ePolarReading:{
+            ReadingPolar &rPolar = reading->variant.modifyPolar();
+            rPolar.azimuth = values[0][row];
+            rPolar.zenith = values[1][row];
+            rPolar.distance = values[2][row];
+            rPolar.sigmaAzimuth = sigmas[0][row];
+            rPolar.sigmaZenith = sigmas[1][row];
+            rPolar.sigmaDistance = sigmas[2][row];
+            rPolar.isValid = true;
+            polar.append(rPolar.azimuth, rPolar.zenith, rPolar.distance,
+                         rPolar.sigmaAzimuth, rPolar.sigmaZenith, rPolar.sigmaDistance);
+            polarReadings.append(reading);
+            polarObservations.append(observation);
+            continue;
+        }case eCartesianReading:{
+            ReadingCartesian &rCartesian = reading->variant.modifyCartesian();
+            for(int i = 0; i < 3; i++){
+                rCartesian.xyz.setAt(i, values[i][row]);
+                rCartesian.sigmaXyz.setAt(i, sigmas[i][row]);
+            }
+            rCartesian.isValid = true;
+            break;
+        }case eCartesianReading6D:{
+            ReadingCartesian6D &rCartesian6D = reading->variant.modifyCartesian6D();
+            for(int i = 0; i < 3; i++){
+                rCartesian6D.xyz.setAt(i, values[i][row]);
+                rCartesian6D.ijk.setAt(i, values[i + 3][row]);
+                rCartesian6D.sigmaXyz.setAt(i, sigmas[i][row]);
+            }
+            rCartesian6D.isValid = true;
+            break;
+        }case eDirectionReading:{
+            ReadingDirection &rDirection = reading->variant.modifyDirection();
+            rDirection.azimuth = values[0][row];
+            rDirection.zenith = values[1][row];
+            rDirection.sigmaAzimuth = sigmas[0][row];
+            rDirection.sigmaZenith = sigmas[1][row];
+            rDirection.isValid = true;
+            break;
+        }case eDistanceReading:{
+            ReadingDistance &rDistance = reading->variant.modifyDistance();
+            rDistance.distance = values[0][row];
+            rDistance.sigmaDistance = sigmas[0][row];
+            rDistance.isValid = true;
+            break;
+        }case eTemperatureReading:{
+            ReadingTemperature &rTemperature = reading->variant.modifyTemperature();
+            rTemperature.temperature = values[0][row];
+            rTemperature.sigmaTemperature = sigmas[0][row];
+            rTemperature.isValid = true;
+            break;
+        }case eLevelReading:{
+            ReadingLevel &rLevel = reading->variant.modifyLevel();
+            rLevel.i = values[0][row];
+            rLevel.j = values[1][row];
+            rLevel.k = values[2][row];
+            rLevel.sigmaI = sigmas[0][row];
+            rLevel.sigmaJ = sigmas[1][row];
+            rLevel.sigmaK = sigmas[2][row];
+            rLevel.isValid = true;
+            break;
+        }default:
+            break;
+        }
+
+        reading->setObservation(observation);
+
+    }
+
+    //convert all polar readings into cartesian coordinates
+    CartesianReadingBatch cartesian;
+    polarToCartesian(polar, cartesian);
+    for(int i = 0; i < polarReadings.size(); i++){
+        ReadingCartesian &rCartesian = polarReadings.at(i)->variant.modifyCartesian();
+        rCartesian.xyz.setAt(0, cartesian.x.at(i));
+        rCartesian.xyz.setAt(1, cartesian.y.at(i));
+        rCartesian.xyz.setAt(2, cartesian.z.at(i));
+        rCartesian.sigmaXyz.setAt(0, cartesian.sigmaX.at(i));
+        rCartesian.sigmaXyz.setAt(1, cartesian.sigmaY.at(i));
+        rCartesian.sigmaXyz.setAt(2, cartesian.sigmaZ.at(i));
+        rCartesian.isValid = true;
+        polarReadings.at(i)->setObservation(polarObservations.at(i));
+    }
+
+    //restore the saved observation flags (attaching a reading marks the observation as valid)
+    for(int row = 0; row < numObservations; row++){
+        const int slot = observations.at(row)->slot;
+        const quint8 flags = observationFlags[row];
+        observationStore->setFlag(slot, ObservationStore::eIsValid, flags & ObservationStore::eIsValid);
+        observationStore->setFlag(slot, ObservationStore::eIsSolved, flags & ObservationStore::eIsSolved);
+        observationStore->setFlag(slot, ObservationStore::eHasDirection, flags & ObservationStore::eHasDirection);
+        observationStore->setFlag(slot, ObservationStore::eIsDummyPoint, flags & ObservationStore::eIsDummyPoint);
+    }
+
+    return observations;
+
+}
+
+/*!
+ * \brief ObservationSidecar::getErrorMessage
+ * \return
+ */
+const QString &ObservationSidecar::getErrorMessage() const{
+    return this->errorMessage;
+}
+
+/*!
+ * \brief ObservationSidecar::toOpenIndyXML
+ * Returns the reference to the saved sidecar (file name relative to the job file and the observation id range per station)
+ * \param xmlDoc
+ * \return
+ */
+QDomElement ObservationSidecar::toOpenIndyXML(QDomDocument &xmlDoc) const{
+
+    if(xmlDoc.isNull() || this->fileName.isEmpty()){
+        return QDomElement();
+    }
+
+    QDomElement sidecar = xmlDoc.createElement("observationSidecar");
+    sidecar.setAttribute("file", QFileInfo(this->fileName).fileName());
+    sidecar.setAttribute("version", ObservationSidecar::version);
+
+    foreach(const StationBlock &block, this->stationBlocks){
+        QDomElement station = xmlDoc.createElement("station");
+        station.setAttribute("ref", block.stationId);
+        station.setAttribute("firstObservation", block.firstObservationId);
+        station.setAttribute("lastObservation", block.lastObservationId);
+        station.setAttribute("count", block.numObservations);
+        sidecar.appendChild(station);
+    }
+
+    return sidecar;
+
+}
+
+/*!
+ * \brief ObservationSidecar::fromOpenIndyXML
+ * Loads the referenced sidecar from the directory of the job file and checks that it holds the referenced id ranges
+ * \param xmlElem
+ * \param jobDirectory
+ * \param verifyChecksums
+ * \return
+ */
+bool ObservationSidecar::fromOpenIndyXML(QDomElement &xmlElem, const QDir &jobDirectory, const bool &verifyChecksums){
+
+    if(xmlElem.isNull() || !xmlElem.hasAttribute("file")){
+        return this->setError("Invalid observation sidecar reference");
+    }
+
+    if(!this->load(jobDirectory.filePath(xmlElem.attribute("file")), verifyChecksums)){
+        return false;
+    }
+
+    //compare the referenced station blocks with the loaded ones
+    QDomElement station = xmlElem.firstChildElement("station");
+    while(!station.isNull()){
+
+        int stationId = station.attribute("ref").toInt();
+        bool found = false;
+        foreach(const StationBlock &block, this->stationBlocks){
+            if(block.stationId == stationId){
+                found = block.numObservations == station.attribute("count").toInt()
+                        && block.firstObservationId == station.attribute("firstObservation").toInt()
+                        && block.lastObservationId == station.attribute("lastObservation").toInt();
+                break;
+            }
+        }
+        if(!found){
+            QString fileName = this->fileName;
+            this->close();
+            return this->setError(QString("The sidecar %1 does not match the observations of station %2").arg(fileName).arg(stationId));
+        }
+
+        station = station.nextSiblingElement("station");
+
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief ObservationSidecar::getColumnOffset
+ * Returns the offset of a column relative to the start of a station block (eNumSidecarColumns returns the offset of the config table)
+ * \param numObservations
+ * \param column
+ * \return
+ */
+qint64 ObservationSidecar::getColumnOffset(const int &numObservations, const SidecarColumns &column){
+
+    qint64 offset = 0;
+    for(int c = 0; c < column; c++){
+        offset += align8((qint64)numObservations * ObservationSidecar::getColumnElementSize((SidecarColumns)c));
+    }
+    return offset;
+
+}
+
+/*!
+ * \brief ObservationSidecar::setError
+ * \param errorMessage
+ * \return always false
+ */
+bool ObservationSidecar::setError(const QString &errorMessage){
+    this->errorMessage = errorMessage;
+    return false;
+}
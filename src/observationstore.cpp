@@ -0,0 +1,242 @@
+#include "observationstore.h"
+
+using namespace oi;
+using namespace oi::math;
+
+/*!
+ * \brief ObservationStore::ObservationStore
+ */
+ObservationStore::ObservationStore(){
+
+}
+
+/*!
+ * \brief ObservationStore::allocate
+ * Returns a zero initialized slot (reuses slots of removed observations first)
+ * \param id
+ * \return
+ */
+int ObservationStore::allocate(const int &id){
+
+    int slot = -1;
+
+    //reuse a free slot
+    if(!this->freeSlots.isEmpty()){
+        slot = this->freeSlots.takeLast();
+        for(int i = 0; i < eNumObservationVectors; i++){
+            double *v = this->vectors[i].data() + 4 * slot;
+            v[0] = 0.0;
+            v[1] = 0.0;
+            v[2] = 0.0;
+            v[3] = 0.0;
+        }
+        this->ids[slot] = id;
+        this->flags[slot] = 0;
+        return slot;
+    }
+
+    //append a new slot
+    slot = this->ids.size();
+    for(int i = 0; i < eNumObservationVectors; i++){
+        this->vectors[i].resize(4 * (slot + 1));
+    }
+    this->ids.append(id);
+    this->flags.append(0);
+
+    return slot;
+
+}
+
+/*!
+ * \brief ObservationStore::release
+ * \param slot
+ */
+void ObservationStore::release(const int &slot){
+
+    //check slot
+    if(slot < 0 || slot >= this->ids.size()){
+        return;
+    }
+
+    this->ids[slot] = -1;
+    this->flags[slot] = 0;
+    this->freeSlots.append(slot);
+
+}
+
+/*!
+ * \brief ObservationStore::reserve
+ * \param size
+ */
+void ObservationStore::reserve(const int &size){
+    for(int i = 0; i < eNumObservationVectors; i++){
+        this->vectors[i].reserve(4 * size);
+    }
+    this->ids.reserve(size);
+    this->flags.reserve(size);
+}
+
+/*!
+ * \brief ObservationStore::getSize
+ * Returns the number of used slots
+ * \return
+ */
+int ObservationStore::getSize() const{
+    return this->ids.size() - this->freeSlots.size();
+}
+
+/*!
+ * \brief ObservationStore::getCapacity
+ * \return
+ */
+int ObservationStore::getCapacity() const{
+    return this->ids.capacity();
+}
+
+/*!
+ * \brief ObservationStore::getId
+ * \param slot
+ * \return
+ */
+int ObservationStore::getId(const int &slot) const{
+    return this->ids.at(slot);
+}
+
+/*!
+ * \brief ObservationStore::setId
+ * \param slot
+ * \param id
+ */
+void ObservationStore::setId(const int &slot, const int &id){
+    this->ids[slot] = id;
+}
+
+/*!
+ * \brief ObservationStore::getFlag
+ * \param slot
+ * \param flag
+ * \return
+ */
+bool ObservationStore::getFlag(const int &slot, const ObservationFlags &flag) const{
+    return (this->flags.at(slot) & flag) != 0;
+}
+
+/*!
+ * \brief ObservationStore::setFlag
+ * \param slot
+ * \param flag
+ * \param state
+ */
+void ObservationStore::setFlag(const int &slot, const ObservationFlags &flag, const bool &state){
+    if(state){
+        this->flags[slot] |= flag;
+    }else{
+        this->flags[slot] &= ~flag;
+    }
+}
+
+/*!
+ * \brief ObservationStore::getVector
+ * Returns a pointer to the four components of the vector
+ * \param slot
+ * \param vector
+ * \return
+ */
+const double *ObservationStore::getVector(const int &slot, const ObservationVectors &vector) const{
+    return this->vectors[vector].constData() + 4 * slot;
+}
+
+/*!
+ * \brief ObservationStore::getOiVec
+ * \param slot
+ * \param vector
+ * \return
+ */
+OiVec ObservationStore::getOiVec(const int &slot, const ObservationVectors &vector) const{
+    const double *v = this->getVector(slot, vector);
+    OiVec result(4);
+    result.setAt(0, v[0]);
+    result.setAt(1, v[1]);
+    result.setAt(2, v[2]);
+    result.setAt(3, v[3]);
+    return result;
+}
+
+/*!
+ * \brief ObservationStore::setVector
+ * \param slot
+ * \param vector
+ * \param x
+ * \param y
+ * \param z
+ * \param h
+ */
+void ObservationStore::setVector(const int &slot, const ObservationVectors &vector, const double &x, const double &y, const double &z, const double &h){
+    double *v = this->vectors[vector].data() + 4 * slot;
+    v[0] = x;
+    v[1] = y;
+    v[2] = z;
+    v[3] = h;
+}
+
+/*!
+ * \brief ObservationStore::setOiVec
+ * \param slot
+ * \param vector
+ * \param v
+ */
+void ObservationStore::setOiVec(const int &slot, const ObservationVectors &vector, const OiVec &v){
+
+    //check vector
+    if(v.getSize() != 4){
+        return;
+    }
+
+    this->setVector(slot, vector, v.getAt(0), v.getAt(1), v.getAt(2), v.getAt(3));
+
+}
+
+/*!
+ * \brief ObservationStore::copySlot
+ * Copies all vectors, the id and the flags of a slot to a slot of another store
+ * \param slot
+ * \param destination
+ * \param destinationSlot
+ */
+void ObservationStore::copySlot(const int &slot, ObservationStore &destination, const int &destinationSlot) const{
+    for(int i = 0; i < eNumObservationVectors; i++){
+        const double *v = this->vectors[i].constData() + 4 * slot;
+        double *d = destination.vectors[i].data() + 4 * destinationSlot;
+        d[0] = v[0];
+        d[1] = v[1];
+        d[2] = v[2];
+        d[3] = v[3];
+    }
+    destination.ids[destinationSlot] = this->ids.at(slot);
+    destination.flags[destinationSlot] = this->flags.at(slot);
+}
+
+/*!
+ * \brief ObservationStore::getBytesPerObservation
+ * Returns the number of bytes one slot occupies in the store
+ * \return
+ */
+qint64 ObservationStore::getBytesPerObservation(){
+    return eNumObservationVectors * 4 * sizeof(double) + sizeof(int) + sizeof(quint8);
+}
+
+/*!
+ * \brief ObservationStore::getMemoryUsage
+ * Returns the number of bytes allocated by the store
+ * \return
+ */
+qint64 ObservationStore::getMemoryUsage() const{
+    qint64 bytes = sizeof(ObservationStore);
+    for(int i = 0; i < eNumObservationVectors; i++){
+        bytes += this->vectors[i].capacity() * sizeof(double);
+    }
+    bytes += this->ids.capacity() * sizeof(int);
+    bytes += this->flags.capacity() * sizeof(quint8);
+    bytes += this->freeSlots.capacity() * sizeof(int);
+    return bytes;
+}
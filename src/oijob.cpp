@@ -6,7 +6,16 @@ using namespace oi;
  * \brief OiJob::OiJob
  * \param parent
  */
-OiJob::OiJob(QObject *parent) : QObject(parent), nextId(1), activeGroup("All Groups"){
+OiJob::OiJob(QObject *parent) : QObject(parent), nextId(1), activeGroup("All Groups"), incrementalRecalc(false),
+    changeTransactionDepth(0), suppressedSignalCount(0){
+
+    //featuresChanged may be delivered through queued connections
+    qRegisterMetaType<QMap<int, int> >("QMap<int,int>");
+
+    //forward the signals of the recalc scheduler
+    QObject::connect(&this->recalcScheduler, &RecalcScheduler::featureRecalculated, this, &OiJob::featureRecalculated, Qt::AutoConnection);
+    QObject::connect(&this->recalcScheduler, &RecalcScheduler::featuresRecalculated, this, &OiJob::featuresRecalculated, Qt::AutoConnection);
+    QObject::connect(&this->recalcScheduler, &RecalcScheduler::sendMessage, this, &OiJob::sendMessage, Qt::AutoConnection);
 
 }
 
@@ -122,6 +131,394 @@ int OiJob::generateUniqueId(){
     return (this->nextId - 1);
 }
 
+/*!
+ * \brief OiJob::generateUniqueIds
+ * Allocates a block of count consecutive unique ids
+ * \param count
+ * \return the first id of the block
+ */
+int OiJob::generateUniqueIds(const int &count){
+    int firstId = this->nextId;
+    this->nextId += qMax(count, 0);
+    return firstId;
+}
+
+/*!
+ * \brief OiJob::writeObservationsXML
+ * Writes the observations element of a project with the observations of all stations.
+ * Each observation is streamed directly to the writer, so that saving does not build a DOM node per observation.
+ * \param xmlWriter
+ */
+void OiJob::writeObservationsXML(QXmlStreamWriter &xmlWriter) const{
+
+    xmlWriter.writeStartElement("observations");
+
+    foreach(const QPointer<Station> &station, this->featureContainer.getStationsList()){
+
+        //check station
+        if(station.isNull() || station->getCoordinateSystem().isNull()){
+            continue;
+        }
+
+        foreach(const QPointer<Observation> &observation, station->getCoordinateSystem()->getObservations()){
+            if(!observation.isNull()){
+                observation->toOpenIndyXML(xmlWriter);
+            }
+        }
+
+    }
+
+    xmlWriter.writeEndElement();
+
+}
+
+/*!
+ * \brief OiJob::readObservationsXML
+ * Reads the observations element of a project. The reader has to be positioned at its start element.
+ * The stations and target geometries of the observations are resolved by their ref when the whole project is loaded.
+ * \param xmlReader
+ * \param observations
+ * \return
+ */
+bool OiJob::readObservationsXML(QXmlStreamReader &xmlReader, QList<QPointer<Observation> > &observations){
+
+    if(!xmlReader.isStartElement() || xmlReader.name() != QLatin1String("observations")){
+        return false;
+    }
+
+    while(xmlReader.readNextStartElement()){
+
+        if(xmlReader.name() != QLatin1String("observation")){
+            xmlReader.skipCurrentElement();
+            continue;
+        }
+
+        QPointer<Observation> observation = new Observation();
+        if(!observation->fromOpenIndyXML(xmlReader)){
+            delete observation.data();
+            continue;
+        }
+        observations.append(observation);
+
+    }
+
+    return !xmlReader.hasError();
+
+}
+
+/*!
+ * \brief OiJob::saveObservationSidecar
+ * Saves the observations of all stations to a binary sidecar next to the job file.
+ * Afterwards the sidecar can be referenced in XML instead of writing the observations element.
+ * \param sidecar
+ * \param fileName
+ * \return
+ */
+bool OiJob::saveObservationSidecar(ObservationSidecar &sidecar, const QString &fileName) const{
+
+    foreach(const QPointer<Station> &station, this->featureContainer.getStationsList()){
+        if(!station.isNull() && !sidecar.addStation(station)){
+            emit this->sendMessage(sidecar.getErrorMessage(), eErrorMessage);
+            return false;
+        }
+    }
+
+    if(!sidecar.save(fileName)){
+        emit this->sendMessage(sidecar.getErrorMessage(), eErrorMessage);
+        return false;
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief OiJob::loadObservationSidecar
+ * Creates the observations of all station blocks of a loaded sidecar and adds them to the station systems of this job.
+ * The observations keep their saved ids and are allocated in the store of their station system.
+ * Target geometries are resolved by their ref when the whole project is loaded.
+ * \param sidecar
+ * \param observations the created observations
+ * \return
+ */
+bool OiJob::loadObservationSidecar(const ObservationSidecar &sidecar, QList<QPointer<Observation> > &observations){
+
+    if(!sidecar.getIsLoaded()){
+        return false;
+    }
+
+    int maxId = 0;
+    foreach(const ObservationSidecar::StationBlock &block, sidecar.getStationBlocks()){
+
+        //get the station of the block
+        QPointer<FeatureWrapper> feature = this->featureContainer.getFeatureById(block.stationId);
+        if(feature.isNull() || feature->getStation().isNull() || feature->getStation()->getCoordinateSystem().isNull()){
+            emit this->sendMessage(QString("The sidecar references the unknown station %1").arg(block.stationId), eErrorMessage);
+            return false;
+        }
+        QPointer<Station> station = feature->getStation();
+        QPointer<CoordinateSystem> stationSystem = station->getCoordinateSystem();
+
+        //create the observations in the store of the station system
+        QList<QPointer<Observation> > created = sidecar.createObservations(block.stationId, stationSystem->getObservationStore());
+        stationSystem->observationsList.reserve(stationSystem->observationsList.size() + created.size());
+        foreach(const QPointer<Observation> &observation, created){
+            observation->setStation(station);
+            stationSystem->observationsList.append(observation);
+            stationSystem->observationsMap.insert(observation->getId(), observation);
+            maxId = qMax(maxId, observation->getId());
+            if(!observation->getReading().isNull()){
+                maxId = qMax(maxId, observation->getReading()->getId());
+            }
+        }
+        observations.append(created);
+
+    }
+
+    //ids generated later must not collide with the loaded ones
+    this->nextId = qMax(this->nextId, maxId + 1);
+
+    return true;
+
+}
+
+/*!
+ * \brief OiJob::getIncrementalRecalc
+ * \return
+ */
+bool OiJob::getIncrementalRecalc() const{
+    return this->incrementalRecalc;
+}
+
+/*!
+ * \brief OiJob::setIncrementalRecalc
+ * If true features are recalculated by the job's recalc scheduler (each affected feature once per event loop turn
+ * in dependency order). Otherwise recalcFeature is emitted so that an external feature updater can handle recalculation.
+ * \param incrementalRecalc
+ */
+void OiJob::setIncrementalRecalc(const bool &incrementalRecalc){
+    if(this->incrementalRecalc && !incrementalRecalc){
+        this->recalcScheduler.flush();
+    }
+    this->incrementalRecalc = incrementalRecalc;
+}
+
+/*!
+ * \brief OiJob::getParallelRecalc
+ * \return
+ */
+bool OiJob::getParallelRecalc() const{
+    return this->recalcScheduler.getParallelRecalc();
+}
+
+/*!
+ * \brief OiJob::setParallelRecalc
+ * If true independent features are recalculated concurrently (only used in incremental recalculation mode)
+ * \param parallelRecalc
+ */
+void OiJob::setParallelRecalc(const bool &parallelRecalc){
+    this->recalcScheduler.setParallelRecalc(parallelRecalc);
+}
+
+/*!
+ * \brief OiJob::getRecalcScheduler
+ * \return
+ */
+const RecalcScheduler &OiJob::getRecalcScheduler() const{
+    return this->recalcScheduler;
+}
+
+/*!
+ * \brief OiJob::beginChanges
+ * Opens a change transaction. Until the transaction is committed the per feature change signals are not emitted
+ * but collected (and emitted once per feature on commit). Transactions may be nested
+ */
+void OiJob::beginChanges(){
+    this->changeTransactionDepth++;
+}
+
+/*!
+ * \brief OiJob::commitChanges
+ * Closes a change transaction. When the outermost transaction is committed the collected per feature signals are emitted
+ * once per feature and signal (featureAttributesChanged once for all features) followed by featuresChanged with all
+ * collected changes
+ */
+void OiJob::commitChanges(){
+
+    if(this->changeTransactionDepth <= 0){
+        return;
+    }
+    this->changeTransactionDepth--;
+    if(this->changeTransactionDepth > 0 || this->pendingChanges.isEmpty()){
+        return;
+    }
+
+    QMap<int, int> changes = this->pendingChanges;
+    QMap<int, int> signalsToEmit = this->pendingSignals;
+    this->pendingChanges.clear();
+    this->pendingSignals.clear();
+
+    bool attributesChanged = false;
+    foreach(const int &kinds, changes){
+        if(kinds & eFeatureAttributesChange){
+            attributesChanged = true;
+            break;
+        }
+    }
+
+    //emit the deduplicated per feature signals
+    if(attributesChanged){
+        emit this->featureAttributesChanged();
+        this->suppressedSignalCount--;
+    }
+    QMap<int, int>::const_iterator it;
+    for(it = signalsToEmit.constBegin(); it != signalsToEmit.constEnd(); ++it){
+        this->suppressedSignalCount -= this->emitChangeSignals(it.key(), it.value());
+    }
+    this->pendingObservationIds.clear();
+
+    emit this->featuresChanged(changes);
+
+}
+
+/*!
+ * \brief OiJob::getIsCollectingChanges
+ * \return true if a change transaction is open
+ */
+bool OiJob::getIsCollectingChanges() const{
+    return this->changeTransactionDepth > 0;
+}
+
+/*!
+ * \brief OiJob::getSuppressedSignalCount
+ * \return the number of change signals that were saved by transactions (collected signals that were not emitted on commit)
+ */
+int OiJob::getSuppressedSignalCount() const{
+    return this->suppressedSignalCount;
+}
+
+/*!
+ * \brief OiJob::collectChange
+ * Saves the change of a feature if a change transaction is open
+ * \param featureId
+ * \param kind
+ * \param signal the per feature signal that is emitted when the transaction is committed
+ * \param numSignals number of signals that would have been emitted for the change
+ * \return true if the change was collected and the signals must not be emitted
+ */
+bool OiJob::collectChange(const int &featureId, const JobChangeKinds &kind, const ChangeSignals &signal, const int &numSignals){
+
+    if(this->changeTransactionDepth <= 0){
+        return false;
+    }
+
+    this->pendingChanges[featureId] |= kind;
+    this->pendingSignals[featureId] |= signal;
+    this->suppressedSignalCount += numSignals;
+    return true;
+
+}
+
+/*!
+ * \brief OiJob::emitChangeSignals
+ * Emits the collected per feature signals of a feature
+ * \param featureId
+ * \param changeSignals combination of ChangeSignals
+ * \return the number of emitted signals
+ */
+int OiJob::emitChangeSignals(const int &featureId, const int &changeSignals){
+
+    int numSignals = 0;
+
+    if(changeSignals & eFeatureCommentSignal){
+        emit this->featureCommentChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eFeatureIsUpdatedSignal){
+        emit this->featureIsUpdatedChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eFeatureIsSolvedSignal){
+        emit this->featureIsSolvedChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eFeatureFunctionsSignal){
+        emit this->featureFunctionsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eFeatureUsedForSignal){
+        emit this->featureUsedForChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eFeaturePreviouslyNeededSignal){
+        emit this->featurePreviouslyNeededChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryIsCommonSignal){
+        emit this->geometryIsCommonChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryNominalsSignal){
+        emit this->geometryNominalsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryActualSignal){
+        emit this->geometryActualChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryObservationsSignal){
+        emit this->geometryObservationsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryNominalSystemSignal){
+        emit this->geometryNominalSystemChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometryStatisticSignal){
+        emit this->geometryStatisticChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eGeometrySimulationDataSignal){
+        emit this->geometrySimulationDataChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eSystemObservationsSignal){
+        emit this->systemObservationsChanged(featureId, this->pendingObservationIds.value(featureId, -1));
+        numSignals++;
+    }
+    if(changeSignals & eSystemTrafoParamsSignal){
+        emit this->systemTrafoParamsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eSystemsNominalsSignal){
+        emit this->systemsNominalsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eStationSensorSignal){
+        emit this->stationSensorChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eTrafoParamParametersSignal){
+        emit this->trafoParamParametersChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eTrafoParamSystemsSignal){
+        emit this->trafoParamSystemsChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eTrafoParamIsUsedSignal){
+        emit this->trafoParamIsUsedChanged(featureId);
+        numSignals++;
+    }
+    if(changeSignals & eTrafoParamIsDatumSignal){
+        emit this->trafoParamIsDatumChanged(featureId);
+        numSignals++;
+    }
+
+    return numSignals;
+
+}
+
 /*!
  * \brief OiJob::validateFeatureName
  * \param name
@@ -481,231 +878,94 @@ bool OiJob::addFeature(const QPointer<FeatureWrapper> &feature){
  * \return
  */
 QList<QPointer<FeatureWrapper> > OiJob::addFeatures(const FeatureAttributes &fAttr){
+    return this->addFeatures(QList<FeatureAttributes>() << fAttr);
+}
 
-    QList<QPointer<FeatureWrapper> > result;
-
-    //at least one feature should be created
-    if(fAttr.count <= 0){
-        return result;
-    }
-
-    //if type is a geometry then at least one of isNominal and isActual has to be true
-    if(getIsGeometry(fAttr.typeOfFeature) && !fAttr.isNominal && !fAttr.isActual){
-        return result;
-    }
+/*!
+ * \brief OiJob::addFeatures
+ * Creates the features of all given attributes in one transaction: either all features are created or none.
+ * The names are validated in bulk (equal names within the batch follow the rules of validateFeatureName),
+ * the feature ids are allocated in one block and the feature set signals are emitted once for the whole batch.
+ * Each feature is still connected to the job on its own, but only after all features have been created
+ * \param fAttrs
+ * \return
+ */
+QList<QPointer<FeatureWrapper> > OiJob::addFeatures(const QList<FeatureAttributes> &fAttrs){
 
-    //if isNominal is true there has to be a valid nominalSystem
-    QPointer<CoordinateSystem> nominalSystem;
-    if(fAttr.isNominal){
-        QList<QPointer<FeatureWrapper> > features = this->featureContainer.getFeaturesByName(fAttr.nominalSystem);
-        if(features.size() != 1){
-            emit this->sendMessage("No valid nominal system specified", eErrorMessage);
-            return result;
-        }
-        if(features.at(0).isNull() || features.at(0)->getCoordinateSystem().isNull() || features.at(0)->getCoordinateSystem()->getIsStationSystem()){
-            emit this->sendMessage("No valid nominal system specified", eErrorMessage);
-            return result;
-        }
-        nominalSystem = features.at(0)->getCoordinateSystem();
-    }
+    QList<QPointer<FeatureWrapper> > result;
 
-    //if type is a TrafoParam then start and destination system have to be in the job
-    QPointer<CoordinateSystem> startSystem, destSystem;
-    if(fAttr.typeOfFeature == eTrafoParamFeature){
-        QList<QPointer<FeatureWrapper> > startSystems = this->featureContainer.getFeaturesByName(fAttr.startSystem);
-        QList<QPointer<FeatureWrapper> > destinationSystems = this->featureContainer.getFeaturesByName(fAttr.destinationSystem);
-        if(startSystems.size() != 1 || destinationSystems.size() != 1
-                || startSystems.at(0).isNull() || destinationSystems.at(0).isNull()){
-            emit this->sendMessage("No valid start and/or destination system specified", eErrorMessage);
-            return result;
-        }
-        if(!startSystems.at(0)->getCoordinateSystem().isNull()){
-            startSystem = startSystems.at(0)->getCoordinateSystem();
-        }else if(!startSystems.at(0)->getStation().isNull() && !startSystems.at(0)->getStation()->getCoordinateSystem().isNull()){
-            startSystem = startSystems.at(0)->getStation()->getCoordinateSystem();
-        }
-        if(!destinationSystems.at(0)->getCoordinateSystem().isNull()){
-            destSystem = destinationSystems.at(0)->getCoordinateSystem();
-        }else if(!destinationSystems.at(0)->getStation().isNull() && !destinationSystems.at(0)->getStation()->getCoordinateSystem().isNull()){
-            destSystem = destinationSystems.at(0)->getStation()->getCoordinateSystem();
-        }
+    //validate all attributes before any feature is created
+    QList<QStringList> featureNames;
+    QList<QPointer<CoordinateSystem> > nominalSystems, startSystems, destSystems;
+    QMultiHash<QString, int> batchNames; //feature name -> index of the attributes that use it
+    int numFeatures = 0;
+    foreach(const FeatureAttributes &fAttr, fAttrs){
 
-        if(startSystem.isNull() || destSystem.isNull()){
-            emit this->sendMessage("No valid start and/or destination system specified", eErrorMessage);
+        QStringList names;
+        QPointer<CoordinateSystem> nominalSystem, startSystem, destSystem;
+        if(!this->validateFeatureAttributes(fAttr, names, nominalSystem, startSystem, destSystem)){
             return result;
         }
 
-    }
-
-    //create and validate feature names
-    QStringList featureNames = this->createFeatureNames(fAttr.name, fAttr.count);
-    if(getIsGeometry(fAttr.typeOfFeature)){
-        if(fAttr.isNominal){
-            foreach(const QString &name, featureNames){
-                if(!validateFeatureName(name, fAttr.typeOfFeature, true, nominalSystem)){
+        //the names of different attributes follow the same rules within the batch as in the job
+        const int index = featureNames.size();
+        foreach(const QString &name, names){
+            QMultiHash<QString, int>::const_iterator it = batchNames.constFind(name);
+            for(; it != batchNames.constEnd() && it.key() == name; ++it){
+                if(!this->validateBatchFeatureName(fAttr, nominalSystem, fAttrs.at(it.value()), nominalSystems.at(it.value()))){
                     emit this->sendMessage("No valid feature name specified", eErrorMessage);
                     return result;
                 }
             }
         }
-        if(fAttr.isActual){
-            foreach(const QString &name, featureNames){
-                if(!validateFeatureName(name, fAttr.typeOfFeature)){
-                    emit this->sendMessage("No valid feature name specified", eErrorMessage);
-                    return result;
-                }
-            }
+        foreach(const QString &name, names){
+            batchNames.insert(name, index);
         }
-    }else{
-        foreach(const QString &name, featureNames){
-            if(!validateFeatureName(name, fAttr.typeOfFeature)){
-                emit this->sendMessage("No valid feature name specified", eErrorMessage);
-                return result;
-            }
+
+        featureNames.append(names);
+        nominalSystems.append(nominalSystem);
+        startSystems.append(startSystem);
+        destSystems.append(destSystem);
+        if(getIsGeometry(fAttr.typeOfFeature) && fAttr.isNominal && fAttr.isActual){
+            numFeatures += 2 * names.size();
+        }else{
+            numFeatures += names.size();
         }
+
     }
 
-    //check if the group is a new group
+    if(numFeatures == 0){
+        return result;
+    }
+
+    //check which groups and feature sets are changed
     bool isNewGroup = false;
-    if(fAttr.group.compare("") != 0 && !this->featureContainer.getFeatureGroupList().contains(fAttr.group)){
-        isNewGroup = true;
+    bool coordSystemsChanged = false, stationsChanged = false, trafoParamsChanged = false, geometriesChanged = false;
+    foreach(const FeatureAttributes &fAttr, fAttrs){
+        if(fAttr.group.compare("") != 0 && !this->featureContainer.getFeatureGroupList().contains(fAttr.group)){
+            isNewGroup = true;
+        }
+        if(fAttr.typeOfFeature == eCoordinateSystemFeature){
+            coordSystemsChanged = true;
+        }else if(fAttr.typeOfFeature == eStationFeature){
+            stationsChanged = true;
+        }else if(fAttr.typeOfFeature == eTrafoParamFeature){
+            trafoParamsChanged = true;
+        }else{
+            geometriesChanged = true;
+        }
     }
 
-    //create the features and add them to OpenIndy
-    foreach(const QString &name, featureNames){
-
-        //create nominal
-        if(getIsGeometry(fAttr.typeOfFeature) && fAttr.isNominal){
-
-            //create and check feature
-            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
-            if(feature.isNull() || feature->getGeometry().isNull()){
-                continue;
-            }
-
-            //pass the job to the feature
-            feature->getFeature()->setJob(this);
-
-            //set feature attributes
-            feature->getFeature()->name = name;
-            feature->getFeature()->group = fAttr.group;
-            feature->getGeometry()->isNominal = true;
-
-            //set nominal system
-            feature->getGeometry()->nominalSystem = nominalSystem;
-            nominalSystem->nominalsList.append(feature);
-            nominalSystem->nominalsMap.insert(feature->getGeometry()->getId(), feature);
-
-            //set solved state
-            if(nominalSystem->getIsActiveCoordinateSystem()){
-                feature->getGeometry()->setIsSolved(true);
-            }
-
-            //search corresponding actual
-            QList<QPointer<FeatureWrapper> > equalNameFeatures = this->featureContainer.getFeaturesByName(name);
-            foreach(const QPointer<FeatureWrapper> &equal, equalNameFeatures){
-                if(!equal.isNull() && equal->getFeatureTypeEnum() == fAttr.typeOfFeature && !equal->getGeometry()->getIsNominal()){
-                    feature->getGeometry()->actual = equal->getGeometry();
-                    equal->getGeometry()->nominals.append(feature->getGeometry());
-                }
-            }
-
-            //add and connect feature
-            this->featureContainer.addFeature(feature);
-            this->connectFeature(feature);
-
-            //add feature to result list
-            result.append(feature);
-
-        }
-
-        //create actual
-        if(getIsGeometry(fAttr.typeOfFeature) && fAttr.isActual){
-
-            //create and check feature
-            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
-            if(feature.isNull() || feature->getGeometry().isNull()){
-                continue;
-            }
-
-            //pass the job to the feature
-            feature->getFeature()->setJob(this);
-
-            //set feature attributes
-            feature->getFeature()->name = name;
-            feature->getFeature()->group = fAttr.group;
-            feature->getGeometry()->isNominal = false;
-            feature->getGeometry()->isCommon = fAttr.isCommon;
-
-            //search corresponding nominal
-            QList<QPointer<FeatureWrapper> > equalNameFeatures = this->featureContainer.getFeaturesByName(name);
-            foreach(const QPointer<FeatureWrapper> &equal, equalNameFeatures){
-                if(!equal.isNull() && equal->getFeatureTypeEnum() == fAttr.typeOfFeature && equal->getGeometry()->getIsNominal()){
-                    equal->getGeometry()->actual = feature->getGeometry();
-                    feature->getGeometry()->nominals.append(equal->getGeometry());
-                }
-            }
-
-            //add and connect feature
-            this->featureContainer.addFeature(feature);
-            this->connectFeature(feature);
-
-            //add feature to result list
-            result.append(feature);
-
-        }
-
-        //create non-geometry feature
-        if(!getIsGeometry(fAttr.typeOfFeature)){
-
-            //create and check feature
-            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
-            if(feature.isNull() || feature->getFeature().isNull()){
-                continue;
-            }
-
-            //pass the job to the feature
-            feature->getFeature()->setJob(this);
-
-            //set feature attributes
-            feature->getFeature()->setFeatureName(name);
-            feature->getFeature()->group = fAttr.group;
-
-            //if type is trafo param set start and destination system
-            if(fAttr.typeOfFeature == eTrafoParamFeature){
-                feature->getTrafoParam()->from = startSystem;
-                feature->getTrafoParam()->to = destSystem;
-                startSystem->trafoParams.append(feature->getTrafoParam());
-                destSystem->trafoParams.append(feature->getTrafoParam());
-
-                //check if one system is station and one system is coordinate system, then set datum to true
-                if((startSystem->getIsStationSystem() || startSystem->getIsBundleSystem()) && (!destSystem->getIsBundleSystem()) && !destSystem->getIsStationSystem()){
-                    feature->getTrafoParam()->setIsDatumTrafo(true);
-                }else if((destSystem->getIsStationSystem() || destSystem->getIsBundleSystem()) && (!startSystem->getIsBundleSystem() && !startSystem->getIsStationSystem())){
-                    feature->getTrafoParam()->setIsDatumTrafo(true);
-                }else{
-                    feature->getTrafoParam()->setIsDatumTrafo(false);
-                }
-
-                //set used-state to "use" as default
-                feature->getTrafoParam()->setIsUsed(true);
-
-            }
-
-            //if type of feature is a coordinate system
-            if(fAttr.typeOfFeature == eCoordinateSystemFeature){
-                feature->getCoordinateSystem()->isBundleSystem = fAttr.isBundleSystem;
-            }
-
-            //add and connect feature
-            this->featureContainer.addFeature(feature);
-            this->connectFeature(feature);
-
-            //add feature to result list
-            result.append(feature);
-
-        }
+    //create the features and add them to OpenIndy (ids are taken from one block)
+    int nextBlockId = this->generateUniqueIds(numFeatures);
+    for(int i = 0; i < fAttrs.size(); i++){
+        result.append(this->createFeatures(fAttrs.at(i), featureNames.at(i), nominalSystems.at(i),
+                                           startSystems.at(i), destSystems.at(i), nextBlockId));
+    }
 
+    //connect the features one by one after all of them have been set up
+    foreach(const QPointer<FeatureWrapper> &feature, result){
+        this->connectFeature(feature);
     }
 
     //emit signals
@@ -713,13 +973,16 @@ QList<QPointer<FeatureWrapper> > OiJob::addFeatures(const FeatureAttributes &fAt
         emit this->availableGroupsChanged();
     }
     emit this->featureSetChanged();
-    if(fAttr.typeOfFeature == eCoordinateSystemFeature){
+    if(coordSystemsChanged){
         emit this->coordSystemSetChanged();
-    }else if(fAttr.typeOfFeature == eStationFeature){
+    }
+    if(stationsChanged){
         emit this->stationSetChanged();
-    }else if(fAttr.typeOfFeature == eTrafoParamFeature){
+    }
+    if(trafoParamsChanged){
         emit this->trafoParamSetChanged();
-    }else{
+    }
+    if(geometriesChanged){
         emit this->geometrySetChanged();
     }
 
@@ -855,6 +1118,7 @@ bool OiJob::removeFeature(const QPointer<FeatureWrapper> &feature){
 
 /*!
  * \brief OiJob::removeFeatures
+ * Removes all given features with one pass over the feature container and one notification
  * \param featureIds
  * \return
  */
@@ -863,29 +1127,37 @@ bool OiJob::removeFeatures(const QSet<int> &featureIds){
     bool success = true;
 
     //check all features wether they could be removed
+    QSet<int> removableIds;
     foreach(const int &id, featureIds){
 
         //get the feature by id
         QPointer<FeatureWrapper> feature = this->featureContainer.getFeatureById(id);
         if(feature.isNull() || feature->getFeature().isNull()){
+            success = false;
             continue;
         }
 
         //check wether the feature could be removed
         if(!this->canRemoveFeature(feature)){
+            emit this->sendMessage(QString("Cannot remove feature %1").arg(feature->getFeature()->getFeatureName()), eWarningMessage);
+            success = false;
             continue;
         }
 
+        this->disconnectFeature(feature);
+        removableIds.insert(id);
+
     }
 
     //remove features
-    this->blockSignals(true);
-    foreach(const int &id, featureIds){
-        if(!this->removeFeature(id)){
-            success = false;
-        }
+    if(!this->featureContainer.removeFeatures(removableIds)){
+        success = false;
+    }
+
+    //possibly reset active group
+    if(this->activeGroup.compare("") != 0 && this->featureContainer.getFeatureCount(this->activeGroup) == 0){
+        this->activeGroup = "";
     }
-    this->blockSignals(false);
 
     emit this->activeGroupChanged();
     emit this->featureSetChanged();
@@ -905,36 +1177,21 @@ bool OiJob::removeFeatures(const QList<QPointer<FeatureWrapper> > &features){
 
     bool success = true;
 
-    //check all features wether they could be removed
+    //get the ids of all features
+    QSet<int> featureIds;
     foreach(const QPointer<FeatureWrapper> &feature, features){
 
         //check feature
         if(feature.isNull() || feature->getFeature().isNull()){
+            success = false;
             continue;
         }
 
-        //check wether the feature could be removed
-        if(!this->canRemoveFeature(feature)){
-            continue;
-        }
-
-    }
+        featureIds.insert(feature->getFeature()->getId());
 
-    //remove features
-    this->blockSignals(true);
-    foreach(const QPointer<FeatureWrapper> &feature, features){
-        if(!this->removeFeature(feature)){
-            success = false;
-        }
     }
-    this->blockSignals(false);
-
-    emit this->activeGroupChanged();
-    emit this->featureSetChanged();
-
-    emit this->recalcFeatureSet();
 
-    return success;
+    return this->removeFeatures(featureIds) && success;
 
 }
 
@@ -963,7 +1220,7 @@ void OiJob::addFunction(const QPointer<Function> &function){
     }
 
     //connect the function
-    QObject::connect(function.data(), &Function::sendMessage, this, &OiJob::sendMessage, Qt::AutoConnection);
+    QObject::connect(function.data(), &Function::sendMessage, &this->recalcScheduler, &RecalcScheduler::relayMessage, Qt::DirectConnection);
 
     //add the function to the active feature
     this->activeFeature->getFeature()->addFunction(function);
@@ -1060,7 +1317,7 @@ void OiJob::addInputObservation(const QPointer<FeatureWrapper> &target, const in
     //create and add input element
     InputElement element(observation->getId());
     element.typeOfElement = eObservationElement;
-    element.observation = observation;
+    element.setElement(observation);
     target->getFeature()->getFunctions().at(functionPosition)->addInputElement(element, neededElementsIndex);
 
     //create dependencies
@@ -1095,26 +1352,7 @@ void OiJob::addInputReading(const QPointer<FeatureWrapper> &target, const int &f
     InputElement element(reading->getId());
     element.typeOfElement = getElementTypeEnum(reading->getTypeOfReading());
 
-    switch(reading->getTypeOfReading()){
-    case eDistanceReading:
-        element.distanceReading = reading;
-        break;
-    case eCartesianReading:
-        element.cartesianReading = reading;
-        break;
-    case ePolarReading:
-        element.polarReading = reading;
-        break;
-    case eDirectionReading:
-        element.directionReading = reading;
-        break;
-    case eTemperatureReading:
-        element.temperatureReading = reading;
-        break;
-    case eLevelReading:
-        element.levelReading = reading;
-        break;
-    }
+    element.setElement(reading);
 
     target->getFeature()->getFunctions().at(functionPosition)->addInputElement(element, neededElementsIndex);
 
@@ -1160,8 +1398,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.circle = feature->getCircle();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getCircle());
 
         break;
 
@@ -1173,8 +1410,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.cone = feature->getCone();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getCone());
 
         break;
 
@@ -1186,8 +1422,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.cylinder = feature->getCylinder();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getCylinder());
 
         break;
 
@@ -1199,8 +1434,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.ellipse = feature->getEllipse();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getEllipse());
 
         break;
 
@@ -1212,8 +1446,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.ellipsoid = feature->getEllipsoid();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getEllipsoid());
 
         break;
 
@@ -1225,8 +1458,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.hyperboloid = feature->getHyperboloid();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getHyperboloid());
 
         break;
 
@@ -1238,8 +1470,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.line = feature->getLine();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getLine());
 
         break;
 
@@ -1251,8 +1482,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.nurbs = feature->getNurbs();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getNurbs());
 
         break;
 
@@ -1264,8 +1494,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.paraboloid = feature->getParaboloid();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getParaboloid());
 
         break;
 
@@ -1277,8 +1506,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.plane = feature->getPlane();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getPlane());
 
         break;
 
@@ -1290,8 +1518,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.point = feature->getPoint();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getPoint());
 
         break;
 
@@ -1303,8 +1530,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.pointCloud = feature->getPointCloud();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getPointCloud());
 
         break;
 
@@ -1316,8 +1542,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.scalarEntityAngle = feature->getScalarEntityAngle();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getScalarEntityAngle());
 
         break;
 
@@ -1329,8 +1554,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.scalarEntityDistance = feature->getScalarEntityDistance();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getScalarEntityDistance());
 
         break;
 
@@ -1342,8 +1566,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.scalarEntityMeasurementSeries = feature->getScalarEntityMeasurementSeries();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getScalarEntityMeasurementSeries());
 
         break;
 
@@ -1355,8 +1578,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.scalarEntityTemperature = feature->getScalarEntityTemperature();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getScalarEntityTemperature());
 
         break;
 
@@ -1368,8 +1590,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.slottedHole = feature->getSlottedHole();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getSlottedHole());
 
         break;
 
@@ -1381,8 +1602,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.sphere = feature->getSphere();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getSphere());
 
         break;
 
@@ -1394,8 +1614,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.torus = feature->getTorus();
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getTorus());
 
         break;
 
@@ -1407,7 +1626,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getGeometry());
 
         break;
 
@@ -1419,7 +1638,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getGeometry());
 
         break;
 
@@ -1431,7 +1650,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.geometry = feature->getGeometry();
+        element.setElement(feature->getGeometry());
 
         break;
 
@@ -1443,7 +1662,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.coordSystem = feature->getCoordinateSystem();
+        element.setElement(feature->getCoordinateSystem());
 
         break;
 
@@ -1455,7 +1674,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.station = feature->getStation();
+        element.setElement(feature->getStation());
 
         break;
 
@@ -1467,7 +1686,7 @@ void OiJob::addInputFeature(const QPointer<FeatureWrapper> &target, const int &f
         }
 
         //set up input element
-        element.trafoParam = feature->getTrafoParam();
+        element.setElement(feature->getTrafoParam());
 
         break;
 
@@ -1536,15 +1755,30 @@ void OiJob::removeInputElement(const QPointer<FeatureWrapper> &target, const int
 
 /*!
  * \brief OiJob::addMeasurementResults
- * Creates and adds observations for the given readings
+ * Creates and adds observations of the active station for the given readings
  * \param geomId
  * \param readings
  */
 void OiJob::addMeasurementResults(const int &geomId, const QList<QPointer<Reading> > &readings){
+    this->addMeasurementResults(this->activeStation, geomId, readings);
+}
+
+/*!
+ * \brief OiJob::addMeasurementResults
+ * Creates and adds observations of the given station for the given readings
+ * (used to add the results of stations that measure concurrently to the active station)
+ * \param station
+ * \param geomId
+ * \param readings
+ */
+void OiJob::addMeasurementResults(const QPointer<Station> &station, const int &geomId, const QList<QPointer<Reading> > &readings){
 
-    //check active station
-    QPointer<Station> activeStation = this->activeStation;
-    if(activeStation.isNull() || activeStation->getCoordinateSystem().isNull()){
+    //check station
+    QPointer<FeatureWrapper> stationFeature;
+    if(!station.isNull()){
+        stationFeature = this->featureContainer.getFeatureById(station->getId());
+    }
+    if(stationFeature.isNull() || stationFeature->getStation() != station || station->getCoordinateSystem().isNull()){
         foreach(const QPointer<Reading> &reading, readings){
             if(!reading.isNull()){
                 delete reading.data();
@@ -1564,8 +1798,14 @@ void OiJob::addMeasurementResults(const int &geomId, const QList<QPointer<Readin
         return;
     }
 
-    //run through all readings
-    feature->getGeometry()->blockSignals(true);
+    //convert all polar readings, that were not converted by the sensor, at once
+    Reading::convertPolarReadings(readings);
+
+    //create the observations of all readings (directly in the store of the station system)
+    const QSharedPointer<ObservationStore> &store = station->getCoordinateSystem()->getObservationStore();
+    store->reserve(store->getSize() + readings.size());
+    QList<QPointer<Observation> > observations;
+    observations.reserve(readings.size());
     foreach(const QPointer<Reading> &reading, readings){
 
         //check reading
@@ -1574,28 +1814,55 @@ void OiJob::addMeasurementResults(const int &geomId, const QList<QPointer<Readin
         }
 
         //create and set up observation
-        QPointer<Observation> observation = new Observation();
+        QPointer<Observation> observation = new Observation(store);
         reading->setObservation(observation);
-        activeStation->getCoordinateSystem()->addObservation(observation);
-        observation->addTargetGeometry(feature->getGeometry());
+        observations.append(observation);
+
+    }
+
+    //add the observations to the station system and to the geometry at once
+    //(the geometry emits the observations changed signal only once)
+    station->getCoordinateSystem()->addObservations(observations);
+    feature->getGeometry()->addObservations(observations);
 
-        //add the observation to the first function of the feature (if it is a fit function)
-        if(feature->getGeometry()->getFunctions().size() >= 1
-                && !feature->getGeometry()->getFunctions().at(0).isNull()
-                && feature->getGeometry()->getFunctions().at(0)->getNeededElements().size() > 0
-                && feature->getGeometry()->getFunctions().at(0)->getNeededElements().at(0).typeOfElement == eObservationElement){
-            this->addInputObservation(feature, 0, observation->getIsDummyPoint() ? InputElementKey::eDummyPoint : InputElementKey::eDefault, observation);
+    //add the observations to the first function of the feature (if it is a fit function)
+    if(feature->getGeometry()->getFunctions().size() >= 1
+            && !feature->getGeometry()->getFunctions().at(0).isNull()
+            && feature->getGeometry()->getFunctions().at(0)->getNeededElements().size() > 0
+            && feature->getGeometry()->getFunctions().at(0)->getNeededElements().at(0).typeOfElement == eObservationElement){
+
+        QList<InputElement> elements, dummyElements;
+        elements.reserve(observations.size());
+        foreach(const QPointer<Observation> &observation, observations){
+            InputElement element(observation->getId());
+            element.typeOfElement = eObservationElement;
+            element.setElement(observation);
+            if(observation->getIsDummyPoint()){
+                dummyElements.append(element);
+            }else{
+                elements.append(element);
+            }
         }
 
-    }
-    feature->getGeometry()->blockSignals(false);
+        feature->getGeometry()->getFunctions().at(0)->addInputElements(elements, InputElementKey::eDefault);
+        feature->getGeometry()->getFunctions().at(0)->addInputElements(dummyElements, InputElementKey::eDummyPoint);
 
-    //emit the observations changed signal only once at the end
-    feature->getGeometry()->geomObservationsChanged(feature->getGeometry()->getId());
+    }
 
     //recalculate the feature
-    emit this->recalcFeature(feature->getFeature());
+    this->requestRecalc(feature->getFeature());
+
+}
 
+/*!
+ * \brief OiJob::addMeasurementResults
+ * Creates readings for the given polar measurements and adds them as observations
+ * (the readings are converted at once when they are added)
+ * \param geomId
+ * \param readings
+ */
+void OiJob::addMeasurementResults(const int &geomId, const QList<ReadingPolar> &readings){
+    this->addMeasurementResults(geomId, Reading::createPolarReadings(readings, false));
 }
 
 /*!
@@ -1604,6 +1871,9 @@ void OiJob::addMeasurementResults(const int &geomId, const QList<QPointer<Readin
  */
 void OiJob::removeObservations(const int &featureId){
 
+    //collect the observation changes of all deleted observations
+    JobChangeTransaction transaction(this);
+
     //get and check feature with the id featureId
     QPointer<FeatureWrapper> feature = this->featureContainer.getFeatureById(featureId);
     if(feature.isNull() || feature->getGeometry().isNull()){
@@ -1617,7 +1887,7 @@ void OiJob::removeObservations(const int &featureId){
     }
 
     //recalculate the feature
-    emit this->recalcFeature(feature->getFeature());
+    this->requestRecalc(feature->getFeature());
 
 }
 
@@ -1637,6 +1907,7 @@ void OiJob::enableOrDisableObservations(const int &featureId, bool enable) {
 }
 
 void OiJob::enableOrDisableStationObservations(QPointer<Station> station, bool enable) {
+    JobChangeTransaction transaction(this);
     foreach(int featureId, this->featureContainer.getFeatureIdList()) {
         enableOrDisableGeometryObservations(featureId, enable, station);
     }
@@ -1652,25 +1923,19 @@ void OiJob::enableOrDisableGeometryObservations(const int &featureId, bool enabl
         return;
     }
 
-    //run through all observations of the feature
+    //collect the ids of all observations of the feature (of the given station)
     QList<QPointer<Observation> > observations = feature->getGeometry()->getObservations();
+    QSet<int> elementIds;
+    elementIds.reserve(observations.size());
     foreach(const QPointer<Observation> &obs, observations){
         if(!station.isNull() && station->getId() != obs->getStation()->getId()) {
             continue; // skip
         }
-        int elementId = obs->getId();
-
-        //check if the current use state already equals the new use state
-        if(feature->getFeature()->getFunctions()[functionIndex]->getShouldBeUsed(neededElementIndex, elementId) == enable){
-            continue;
-        }
-
-        //set should use
-        feature->getFeature()->getFunctions()[functionIndex]->setShouldBeUsed(neededElementIndex, elementId, enable);
+        elementIds.insert(obs->getId());
     }
 
-    //recalculate the feature
-    emit this->recalcFeature(feature->getFeature());
+    //set should use and recalculate the feature
+    this->setShouldBeUsed(feature, functionIndex, neededElementIndex, elementIds, enable, true);
 }
 
 void OiJob::enableObservations(const int &featureId)
@@ -1688,6 +1953,8 @@ void OiJob::disableObservations(const int &featureId)
  */
 void OiJob::removeObservations(const int &featureId, const QList<int> selectedIds)
 {
+    JobChangeTransaction transaction(this);
+
     //get and check feature with the id featureId
     QPointer<FeatureWrapper> feature = this->featureContainer.getFeatureById(featureId);
     if(feature.isNull() || feature->getGeometry().isNull()){
@@ -1695,15 +1962,16 @@ void OiJob::removeObservations(const int &featureId, const QList<int> selectedId
     }
 
     //run through all observations of the feature
+    QSet<int> ids = selectedIds.toSet();
     QList<QPointer<Observation> > observations = feature->getGeometry()->getObservations();
     foreach(const QPointer<Observation> &obs, observations){
-        if (selectedIds.contains(obs->getId())) {
+        if(!obs.isNull() && ids.contains(obs->getId())){
             delete obs.data();
         }
     }
 
     //recalculate the feature
-    emit this->recalcFeature(feature->getFeature());
+    this->requestRecalc(feature->getFeature());
 }
 
 /*!
@@ -1711,6 +1979,9 @@ void OiJob::removeObservations(const int &featureId, const QList<int> selectedId
  */
 void OiJob::removeAllObservations(){
 
+    //one batched notification for all geometries
+    JobChangeTransaction transaction(this);
+
     //get a list of all geometries
     QList<QPointer<FeatureWrapper> > geometries = this->featureContainer.getGeometriesList();
 
@@ -1761,7 +2032,40 @@ void OiJob::setShouldBeUsed(const QPointer<FeatureWrapper> &target, const int &f
 
     //force recalculation if requested
     if(recalc){
-        emit this->recalcFeature(target->getFeature());
+        this->requestRecalc(target->getFeature());
+    }
+
+}
+
+/*!
+ * \brief OiJob::setShouldBeUsed
+ * Sets the use state of all given elements and recalculates the target only once
+ * \param target
+ * \param functionIndex
+ * \param neededElementIndex
+ * \param elementIds
+ * \param use
+ * \param recalc
+ */
+void OiJob::setShouldBeUsed(const QPointer<FeatureWrapper> &target, const int &functionIndex, const int &neededElementIndex, const QSet<int> &elementIds, const bool &use, const bool &recalc){
+
+    //check target feature
+    if(target.isNull() || target->getFeature().isNull()){
+        return;
+    }
+
+    //check function position
+    if(functionIndex < 0 || functionIndex >= target->getFeature()->getFunctions().size()
+            || target->getFeature()->getFunctions().at(functionIndex).isNull()){
+        return;
+    }
+
+    //set should use (only elements whose state differs are changed)
+    int numChanged = target->getFeature()->getFunctions()[functionIndex]->setShouldBeUsed(neededElementIndex, elementIds, use);
+
+    //force recalculation if requested and something has changed
+    if(recalc && numChanged > 0){
+        this->requestRecalc(target->getFeature());
     }
 
 }
@@ -2054,6 +2358,9 @@ void OiJob::setFeatureGroup(const int &featureId, const QString &oldGroup){
  * \param featureId
  */
 void OiJob::setFeatureComment(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeatureCommentSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featureCommentChanged(featureId);
 }
@@ -2063,6 +2370,9 @@ void OiJob::setFeatureComment(const int &featureId){
  * \param featureId
  */
 void OiJob::setFeatureIsUpdated(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeatureIsUpdatedSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featureIsUpdatedChanged(featureId);
 }
@@ -2072,6 +2382,9 @@ void OiJob::setFeatureIsUpdated(const int &featureId){
  * \param featureId
  */
 void OiJob::setFeatureIsSolved(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeatureIsSolvedSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featureIsSolvedChanged(featureId);
 }
@@ -2081,6 +2394,9 @@ void OiJob::setFeatureIsSolved(const int &featureId){
  * \param featureId
  */
 void OiJob::setFeatureFunctions(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeatureFunctionsSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featureFunctionsChanged(featureId);
 }
@@ -2090,6 +2406,9 @@ void OiJob::setFeatureFunctions(const int &featureId){
  * \param featureId
  */
 void OiJob::setFeatureUsedFor(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeatureUsedForSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featureUsedForChanged(featureId);
 }
@@ -2099,6 +2418,9 @@ void OiJob::setFeatureUsedFor(const int &featureId){
  * \param featureId
  */
 void OiJob::setFeaturePreviouslyNeeded(const int &featureId){
+    if(this->collectChange(featureId, eFeatureAttributesChange, eFeaturePreviouslyNeededSignal, 2)){
+        return;
+    }
     emit this->featureAttributesChanged();
     emit this->featurePreviouslyNeededChanged(featureId);
 }
@@ -2108,6 +2430,9 @@ void OiJob::setFeaturePreviouslyNeeded(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryIsCommon(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometryIsCommonSignal, 1)){
+        return;
+    }
     emit this->geometryIsCommonChanged(featureId);
 }
 
@@ -2116,6 +2441,9 @@ void OiJob::setGeometryIsCommon(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryNominals(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometryNominalsSignal, 1)){
+        return;
+    }
     emit this->geometryNominalsChanged(featureId);
 }
 
@@ -2124,6 +2452,9 @@ void OiJob::setGeometryNominals(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryActual(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometryActualSignal, 1)){
+        return;
+    }
     emit this->geometryActualChanged(featureId);
 }
 
@@ -2132,6 +2463,9 @@ void OiJob::setGeometryActual(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryObservations(const int &featureId){
+    if(this->collectChange(featureId, eGeometryObservationsChange, eGeometryObservationsSignal, 1)){
+        return;
+    }
     emit this->geometryObservationsChanged(featureId);
 }
 
@@ -2140,6 +2474,9 @@ void OiJob::setGeometryObservations(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryNominalSystem(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometryNominalSystemSignal, 1)){
+        return;
+    }
     emit this->geometryNominalSystemChanged(featureId);
 }
 
@@ -2148,6 +2485,9 @@ void OiJob::setGeometryNominalSystem(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometryStatistic(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometryStatisticSignal, 1)){
+        return;
+    }
     emit this->geometryStatisticChanged(featureId);
 }
 
@@ -2156,6 +2496,9 @@ void OiJob::setGeometryStatistic(const int &featureId){
  * \param featureId
  */
 void OiJob::setGeometrySimulationData(const int &featureId){
+    if(this->collectChange(featureId, eGeometryChange, eGeometrySimulationDataSignal, 1)){
+        return;
+    }
     emit this->geometrySimulationDataChanged(featureId);
 }
 
@@ -2180,14 +2523,32 @@ void OiJob::setGeometryMeasurementConfig(const int &featureId, const QString &ol
  * \param obsId
  */
 void OiJob::setSystemObservations(const int &featureId, const int &obsId){
+    if(this->collectChange(featureId, eSystemChange, eSystemObservationsSignal, 1)){
+        this->pendingObservationIds.insert(featureId, obsId);
+        return;
+    }
     emit this->systemObservationsChanged(featureId, obsId);
 }
 
+/*!
+ * \brief OiJob::setSystemObservationsAdded
+ * Forwards the ids of all observations that were added to a station system at once.
+ * Like the signals that carry old values this signal is not collected by change transactions
+ * \param featureId
+ * \param obsIds
+ */
+void OiJob::setSystemObservationsAdded(const int &featureId, const QList<int> &obsIds){
+    emit this->systemObservationsAdded(featureId, obsIds);
+}
+
 /*!
  * \brief OiJob::setSystemTrafoParams
  * \param featureId
  */
 void OiJob::setSystemTrafoParams(const int &featureId){
+    if(this->collectChange(featureId, eSystemChange, eSystemTrafoParamsSignal, 1)){
+        return;
+    }
     emit this->systemTrafoParamsChanged(featureId);
 }
 
@@ -2196,7 +2557,10 @@ void OiJob::setSystemTrafoParams(const int &featureId){
  * \param featureId
  */
 void OiJob::setSystemsNominals(const int &featureId){
-    emit this->systemsNominalsChanged(featureId);
+    if(this->collectChange(featureId, eSystemChange, eSystemsNominalsSignal, 1)){
+        return;
+    }
+    emit this->systemsNominalsChanged(featureId);
 }
 
 /*!
@@ -2204,6 +2568,9 @@ void OiJob::setSystemsNominals(const int &featureId){
  * \param featureId
  */
 void OiJob::setStationSensor(const int &featureId){
+    if(this->collectChange(featureId, eStationChange, eStationSensorSignal, 1)){
+        return;
+    }
     emit this->stationSensorChanged(featureId);
 }
 
@@ -2212,6 +2579,9 @@ void OiJob::setStationSensor(const int &featureId){
  * \param featureId
  */
 void OiJob::setTrafoParamParameters(const int &featureId){
+    if(this->collectChange(featureId, eTrafoParamChange, eTrafoParamParametersSignal, 1)){
+        return;
+    }
     emit this->trafoParamParametersChanged(featureId);
 }
 
@@ -2220,6 +2590,9 @@ void OiJob::setTrafoParamParameters(const int &featureId){
  * \param featureId
  */
 void OiJob::setTrafoParamSystems(const int &featureId){
+    if(this->collectChange(featureId, eTrafoParamChange, eTrafoParamSystemsSignal, 1)){
+        return;
+    }
     emit this->trafoParamSystemsChanged(featureId);
 }
 
@@ -2228,6 +2601,9 @@ void OiJob::setTrafoParamSystems(const int &featureId){
  * \param featureId
  */
 void OiJob::setTrafoParamIsUsed(const int &featureId){
+    if(this->collectChange(featureId, eTrafoParamChange, eTrafoParamIsUsedSignal, 1)){
+        return;
+    }
     emit this->trafoParamIsUsedChanged(featureId);
 }
 
@@ -2237,6 +2613,9 @@ void OiJob::setTrafoParamIsUsed(const int &featureId){
  */
 void OiJob::setTrafoParamIsDatum(const int &featureId)
 {
+    if(this->collectChange(featureId, eTrafoParamChange, eTrafoParamIsDatumSignal, 1)){
+        return;
+    }
     emit this->trafoParamIsDatumChanged(featureId);
 }
 
@@ -2350,6 +2729,8 @@ void OiJob::connectFeature(const QPointer<FeatureWrapper> &feature){
         if(!feature->getStation()->getCoordinateSystem().isNull()){
             QObject::connect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::observationsChanged,
                              this, &OiJob::setSystemObservations, Qt::AutoConnection);
+            QObject::connect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::observationsAdded,
+                             this, &OiJob::setSystemObservationsAdded, Qt::AutoConnection);
             QObject::connect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::transformationParametersChanged,
                              this, &OiJob::setSystemTrafoParams, Qt::AutoConnection);
             QObject::connect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::activeCoordinateSystemChanged,
@@ -2449,6 +2830,8 @@ void OiJob::disconnectFeature(const QPointer<FeatureWrapper> &feature){
         if(!feature->getStation()->getCoordinateSystem().isNull()){
             QObject::disconnect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::observationsChanged,
                              this, &OiJob::setSystemObservations);
+            QObject::disconnect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::observationsAdded,
+                             this, &OiJob::setSystemObservationsAdded);
             QObject::disconnect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::transformationParametersChanged,
                              this, &OiJob::setSystemTrafoParams);
             QObject::disconnect(feature->getStation()->getCoordinateSystem().data(), &CoordinateSystem::activeCoordinateSystemChanged,
@@ -2533,6 +2916,330 @@ QStringList OiJob::createFeatureNames(const QString &name, const int &count) con
 
 }
 
+/*!
+ * \brief OiJob::validateBatchFeatureName
+ * Checks wether the features of two attributes of one batch may share a name.
+ * Like in validateFeatureName equal names are only allowed for geometries and only if there is at most one actual
+ * and at most one nominal per nominal system of the same type
+ * \param fAttr
+ * \param nominalSystem
+ * \param other
+ * \param otherNominalSystem
+ * \return
+ */
+bool OiJob::validateBatchFeatureName(const FeatureAttributes &fAttr, const QPointer<CoordinateSystem> &nominalSystem,
+                                     const FeatureAttributes &other, const QPointer<CoordinateSystem> &otherNominalSystem) const{
+
+    //only geometries may share a name
+    if(!getIsGeometry(fAttr.typeOfFeature) || !getIsGeometry(other.typeOfFeature)){
+        return false;
+    }
+
+    //geometries of different types may share a name
+    if(fAttr.typeOfFeature != other.typeOfFeature){
+        return true;
+    }
+
+    //no two actuals with the same type
+    if(fAttr.isActual && other.isActual){
+        return false;
+    }
+
+    //no two nominals with the same type and nominal system
+    if(fAttr.isNominal && other.isNominal && nominalSystem == otherNominalSystem){
+        return false;
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief OiJob::validateFeatureAttributes
+ * Checks the given feature attributes and creates and validates the names of the features that shall be created
+ * \param fAttr
+ * \param featureNames
+ * \param nominalSystem
+ * \param startSystem
+ * \param destSystem
+ * \return
+ */
+bool OiJob::validateFeatureAttributes(const FeatureAttributes &fAttr, QStringList &featureNames, QPointer<CoordinateSystem> &nominalSystem,
+                                      QPointer<CoordinateSystem> &startSystem, QPointer<CoordinateSystem> &destSystem){
+
+    //at least one feature should be created
+    if(fAttr.count <= 0){
+        return false;
+    }
+
+    //if type is a geometry then at least one of isNominal and isActual has to be true
+    if(getIsGeometry(fAttr.typeOfFeature) && !fAttr.isNominal && !fAttr.isActual){
+        return false;
+    }
+
+    //if isNominal is true there has to be a valid nominalSystem
+    if(fAttr.isNominal){
+        QList<QPointer<FeatureWrapper> > features = this->featureContainer.getFeaturesByName(fAttr.nominalSystem);
+        if(features.size() != 1){
+            emit this->sendMessage("No valid nominal system specified", eErrorMessage);
+            return false;
+        }
+        if(features.at(0).isNull() || features.at(0)->getCoordinateSystem().isNull() || features.at(0)->getCoordinateSystem()->getIsStationSystem()){
+            emit this->sendMessage("No valid nominal system specified", eErrorMessage);
+            return false;
+        }
+        nominalSystem = features.at(0)->getCoordinateSystem();
+    }
+
+    //if type is a TrafoParam then start and destination system have to be in the job
+    if(fAttr.typeOfFeature == eTrafoParamFeature){
+        QList<QPointer<FeatureWrapper> > startSystems = this->featureContainer.getFeaturesByName(fAttr.startSystem);
+        QList<QPointer<FeatureWrapper> > destinationSystems = this->featureContainer.getFeaturesByName(fAttr.destinationSystem);
+        if(startSystems.size() != 1 || destinationSystems.size() != 1
+                || startSystems.at(0).isNull() || destinationSystems.at(0).isNull()){
+            emit this->sendMessage("No valid start and/or destination system specified", eErrorMessage);
+            return false;
+        }
+        if(!startSystems.at(0)->getCoordinateSystem().isNull()){
+            startSystem = startSystems.at(0)->getCoordinateSystem();
+        }else if(!startSystems.at(0)->getStation().isNull() && !startSystems.at(0)->getStation()->getCoordinateSystem().isNull()){
+            startSystem = startSystems.at(0)->getStation()->getCoordinateSystem();
+        }
+        if(!destinationSystems.at(0)->getCoordinateSystem().isNull()){
+            destSystem = destinationSystems.at(0)->getCoordinateSystem();
+        }else if(!destinationSystems.at(0)->getStation().isNull() && !destinationSystems.at(0)->getStation()->getCoordinateSystem().isNull()){
+            destSystem = destinationSystems.at(0)->getStation()->getCoordinateSystem();
+        }
+
+        if(startSystem.isNull() || destSystem.isNull()){
+            emit this->sendMessage("No valid start and/or destination system specified", eErrorMessage);
+            return false;
+        }
+
+    }
+
+    //create and validate feature names
+    featureNames = this->createFeatureNames(fAttr.name, fAttr.count);
+
+    //names that are not used yet are valid (all used names with the common prefix are looked up at once)
+    QString namePrefix = featureNames.isEmpty() ? QString() : featureNames.first();
+    foreach(const QString &name, featureNames){
+        int length = 0;
+        while(length < namePrefix.length() && length < name.length() && namePrefix.at(length) == name.at(length)){
+            length++;
+        }
+        namePrefix.truncate(length);
+    }
+    QSet<QString> usedNames = this->featureContainer.getFeatureNamesByPrefix(namePrefix).toSet();
+
+    if(getIsGeometry(fAttr.typeOfFeature)){
+        if(fAttr.isNominal){
+            foreach(const QString &name, featureNames){
+                if((name.isEmpty() || usedNames.contains(name))
+                        && !validateFeatureName(name, fAttr.typeOfFeature, true, nominalSystem)){
+                    emit this->sendMessage("No valid feature name specified", eErrorMessage);
+                    return false;
+                }
+            }
+        }
+        if(fAttr.isActual){
+            foreach(const QString &name, featureNames){
+                if((name.isEmpty() || usedNames.contains(name))
+                        && !validateFeatureName(name, fAttr.typeOfFeature)){
+                    emit this->sendMessage("No valid feature name specified", eErrorMessage);
+                    return false;
+                }
+            }
+        }
+    }else{
+        foreach(const QString &name, featureNames){
+            if((name.isEmpty() || usedNames.contains(name))
+                    && !validateFeatureName(name, fAttr.typeOfFeature)){
+                emit this->sendMessage("No valid feature name specified", eErrorMessage);
+                return false;
+            }
+        }
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief OiJob::createFeatures
+ * Creates the features of the given attributes and adds them to the feature container without connecting them
+ * \param fAttr
+ * \param featureNames validated feature names
+ * \param nominalSystem
+ * \param startSystem
+ * \param destSystem
+ * \param nextBlockId next free id of the id block that was allocated for the features
+ * \return
+ */
+QList<QPointer<FeatureWrapper> > OiJob::createFeatures(const FeatureAttributes &fAttr, const QStringList &featureNames, const QPointer<CoordinateSystem> &nominalSystem,
+                                                       const QPointer<CoordinateSystem> &startSystem, const QPointer<CoordinateSystem> &destSystem, int &nextBlockId){
+
+    QList<QPointer<FeatureWrapper> > result;
+
+    foreach(const QString &name, featureNames){
+
+        //create nominal
+        if(getIsGeometry(fAttr.typeOfFeature) && fAttr.isNominal){
+
+            //create and check feature
+            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
+            if(feature.isNull() || feature->getGeometry().isNull()){
+                nextBlockId++;
+                continue;
+            }
+
+            //pass the job to the feature
+            this->setUpBlockFeatureId(feature, nextBlockId);
+
+            //set feature attributes
+            feature->getFeature()->name = name;
+            feature->getFeature()->group = fAttr.group;
+            feature->getGeometry()->isNominal = true;
+
+            //set nominal system
+            feature->getGeometry()->nominalSystem = nominalSystem;
+            nominalSystem->nominalsList.append(feature);
+            nominalSystem->nominalsMap.insert(feature->getGeometry()->getId(), feature);
+
+            //set solved state
+            if(nominalSystem->getIsActiveCoordinateSystem()){
+                feature->getGeometry()->setIsSolved(true);
+            }
+
+            //search corresponding actual
+            QList<QPointer<FeatureWrapper> > equalNameFeatures = this->featureContainer.getFeaturesByName(name);
+            foreach(const QPointer<FeatureWrapper> &equal, equalNameFeatures){
+                if(!equal.isNull() && equal->getFeatureTypeEnum() == fAttr.typeOfFeature && !equal->getGeometry()->getIsNominal()){
+                    feature->getGeometry()->actual = equal->getGeometry();
+                    equal->getGeometry()->nominals.append(feature->getGeometry());
+                }
+            }
+
+            //add feature
+            this->featureContainer.addFeature(feature);
+
+            //add feature to result list
+            result.append(feature);
+
+        }
+
+        //create actual
+        if(getIsGeometry(fAttr.typeOfFeature) && fAttr.isActual){
+
+            //create and check feature
+            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
+            if(feature.isNull() || feature->getGeometry().isNull()){
+                nextBlockId++;
+                continue;
+            }
+
+            //pass the job to the feature
+            this->setUpBlockFeatureId(feature, nextBlockId);
+
+            //set feature attributes
+            feature->getFeature()->name = name;
+            feature->getFeature()->group = fAttr.group;
+            feature->getGeometry()->isNominal = false;
+            feature->getGeometry()->isCommon = fAttr.isCommon;
+
+            //search corresponding nominal
+            QList<QPointer<FeatureWrapper> > equalNameFeatures = this->featureContainer.getFeaturesByName(name);
+            foreach(const QPointer<FeatureWrapper> &equal, equalNameFeatures){
+                if(!equal.isNull() && equal->getFeatureTypeEnum() == fAttr.typeOfFeature && equal->getGeometry()->getIsNominal()){
+                    equal->getGeometry()->actual = feature->getGeometry();
+                    feature->getGeometry()->nominals.append(equal->getGeometry());
+                }
+            }
+
+            //add feature
+            this->featureContainer.addFeature(feature);
+
+            //add feature to result list
+            result.append(feature);
+
+        }
+
+        //create non-geometry feature
+        if(!getIsGeometry(fAttr.typeOfFeature)){
+
+            //create and check feature
+            QPointer<FeatureWrapper> feature = this->createFeatureWrapper(fAttr.typeOfFeature, true);
+            if(feature.isNull() || feature->getFeature().isNull()){
+                nextBlockId++;
+                continue;
+            }
+
+            //pass the job to the feature
+            this->setUpBlockFeatureId(feature, nextBlockId);
+
+            //set feature attributes
+            feature->getFeature()->setFeatureName(name);
+            feature->getFeature()->group = fAttr.group;
+
+            //if type is trafo param set start and destination system
+            if(fAttr.typeOfFeature == eTrafoParamFeature){
+                feature->getTrafoParam()->from = startSystem;
+                feature->getTrafoParam()->to = destSystem;
+                startSystem->trafoParams.append(feature->getTrafoParam());
+                destSystem->trafoParams.append(feature->getTrafoParam());
+
+                //check if one system is station and one system is coordinate system, then set datum to true
+                if((startSystem->getIsStationSystem() || startSystem->getIsBundleSystem()) && (!destSystem->getIsBundleSystem()) && !destSystem->getIsStationSystem()){
+                    feature->getTrafoParam()->setIsDatumTrafo(true);
+                }else if((destSystem->getIsStationSystem() || destSystem->getIsBundleSystem()) && (!startSystem->getIsBundleSystem() && !startSystem->getIsStationSystem())){
+                    feature->getTrafoParam()->setIsDatumTrafo(true);
+                }else{
+                    feature->getTrafoParam()->setIsDatumTrafo(false);
+                }
+
+                //set used-state to "use" as default
+                feature->getTrafoParam()->setIsUsed(true);
+
+            }
+
+            //if type of feature is a coordinate system
+            if(fAttr.typeOfFeature == eCoordinateSystemFeature){
+                feature->getCoordinateSystem()->isBundleSystem = fAttr.isBundleSystem;
+            }
+
+            //add feature
+            this->featureContainer.addFeature(feature);
+
+            //add feature to result list
+            result.append(feature);
+
+        }
+
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief OiJob::setUpBlockFeatureId
+ * Passes the job to a newly created feature and gives it the next id of an allocated id block
+ * (stations and features with functions need further ids and generate them on their own)
+ * \param feature
+ * \param nextBlockId
+ */
+void OiJob::setUpBlockFeatureId(const QPointer<FeatureWrapper> &feature, int &nextBlockId){
+
+    if(feature->getFeatureTypeEnum() == eStationFeature || !feature->getFeature()->getFunctions().isEmpty()){
+        feature->getFeature()->setJob(this);
+    }else{
+        feature->getFeature()->job = this;
+        feature->getFeature()->id = nextBlockId;
+    }
+    nextBlockId++;
+
+}
+
 /*!
  * \brief OiJob::createFeatureWrapper
  * Create a feature wrapper containing a feature of the given type
@@ -2888,24 +3595,28 @@ bool OiJob::checkCircleWarning(const QPointer<Feature> &activeFeature, const QPo
         return true;
     }
 
-    //check if active feature is in the list of previously needed features of usedForActiveFeature
-    foreach(const QPointer<FeatureWrapper> &feature, usedForActiveFeature->getPreviouslyNeeded()){
+    //check if active feature is (directly or indirectly) previously needed by usedForActiveFeature
+    return RecalcScheduler::getIsPreviouslyNeeded(usedForActiveFeature, activeFeature);
 
-        //check feature
-        if(feature.isNull() || feature->getFeature().isNull()){
-            continue;
-        }
+}
 
-        if(feature->getFeature()->getId() == activeFeature->getId()){
-            return true;
-        }else if(feature->getFeature()->getPreviouslyNeeded().size() > 0
-                 && this->checkCircleWarning(activeFeature, feature->getFeature())){
-            return true;
-        }
+/*!
+ * \brief OiJob::requestRecalc
+ * Either marks the feature as dirty (incremental recalculation) or asks the external feature updater to recalc it
+ * \param feature
+ */
+void OiJob::requestRecalc(const QPointer<Feature> &feature){
 
+    //check feature
+    if(feature.isNull()){
+        return;
     }
 
-    return false;
+    if(this->incrementalRecalc){
+        this->recalcScheduler.invalidate(feature);
+    }else{
+        emit this->recalcFeature(feature);
+    }
 
 }
 
@@ -2920,113 +3631,113 @@ void OiJob::setUpDependencies(const InputElement &element, const QPointer<Featur
 
         switch(element.typeOfElement){
         case eCircleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eConeElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eCylinderElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eEllipseElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eEllipsoidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eHyperboloidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eLineElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eNurbsElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eParaboloidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePlaneElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePointElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePointCloudElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityAngleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityDistanceElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityMeasurementSeriesElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityTemperatureElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eSlottedHoleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eSphereElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eTorusElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eCoordinateSystemElement:{
-            if(!element.coordSystem.isNull() && !element.coordSystem->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.coordSystem->getFeatureWrapper());
+            if(!element.getCoordinateSystem().isNull() && !element.getCoordinateSystem()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getCoordinateSystem()->getFeatureWrapper());
             }
             break;
         }case eStationElement:{
-            if(!element.station.isNull() && !element.station->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.station->getFeatureWrapper());
+            if(!element.getStation().isNull() && !element.getStation()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getStation()->getFeatureWrapper());
             }
             break;
         }case eTrafoParamElement:{
-            if(!element.trafoParam.isNull() && !element.trafoParam->getFeatureWrapper().isNull()){
-                feature->addPreviouslyNeeded(element.trafoParam->getFeatureWrapper());
+            if(!element.getTrafoParam().isNull() && !element.getTrafoParam()->getFeatureWrapper().isNull()){
+                feature->addPreviouslyNeeded(element.getTrafoParam()->getFeatureWrapper());
             }
             break;
         }
@@ -3034,8 +3745,8 @@ void OiJob::setUpDependencies(const InputElement &element, const QPointer<Featur
 
     }else if(getIsObservation(element.typeOfElement)){
 
-        if(!element.observation.isNull() && !feature->getFeatureWrapper().isNull() && !feature->getFeatureWrapper()->getGeometry().isNull()){
-            feature->getFeatureWrapper()->getGeometry()->addObservation(element.observation);
+        if(!element.getObservation().isNull() && !feature->getFeatureWrapper().isNull() && !feature->getFeatureWrapper()->getGeometry().isNull()){
+            feature->getFeatureWrapper()->getGeometry()->addObservation(element.getObservation());
         }
 
     }else if(getIsReading(element.typeOfElement)){
@@ -3044,8 +3755,8 @@ void OiJob::setUpDependencies(const InputElement &element, const QPointer<Featur
 
     }else if(element.typeOfElement != eUndefinedElement){
 
-        if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-            feature->addPreviouslyNeeded(element.geometry->getFeatureWrapper());
+        if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+            feature->addPreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
         }
 
     }
@@ -3063,113 +3774,113 @@ void OiJob::resetDependencies(const InputElement &element, const QPointer<Featur
 
         switch(element.typeOfElement){
         case eCircleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eConeElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eCylinderElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eEllipseElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eEllipsoidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eHyperboloidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eLineElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eNurbsElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eParaboloidElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePlaneElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePointElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case ePointCloudElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityAngleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityDistanceElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityMeasurementSeriesElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eScalarEntityTemperatureElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eSlottedHoleElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eSphereElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eTorusElement:{
-            if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+            if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
             }
             break;
         }case eCoordinateSystemElement:{
-            if(!element.coordSystem.isNull() && !element.coordSystem->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.coordSystem->getFeatureWrapper());
+            if(!element.getCoordinateSystem().isNull() && !element.getCoordinateSystem()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getCoordinateSystem()->getFeatureWrapper());
             }
             break;
         }case eStationElement:{
-            if(!element.station.isNull() && !element.station->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.station->getFeatureWrapper());
+            if(!element.getStation().isNull() && !element.getStation()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getStation()->getFeatureWrapper());
             }
             break;
         }case eTrafoParamElement:{
-            if(!element.trafoParam.isNull() && !element.trafoParam->getFeatureWrapper().isNull()){
-                feature->removePreviouslyNeeded(element.trafoParam->getFeatureWrapper());
+            if(!element.getTrafoParam().isNull() && !element.getTrafoParam()->getFeatureWrapper().isNull()){
+                feature->removePreviouslyNeeded(element.getTrafoParam()->getFeatureWrapper());
             }
             break;
         }
@@ -3177,8 +3888,8 @@ void OiJob::resetDependencies(const InputElement &element, const QPointer<Featur
 
     }else if(getIsObservation(element.typeOfElement)){
 
-        if(!element.observation.isNull() && !feature->getFeatureWrapper().isNull() && !feature->getFeatureWrapper()->getGeometry().isNull()){
-            element.observation->removeTargetGeometry(feature->getFeatureWrapper()->getGeometry());
+        if(!element.getObservation().isNull() && !feature->getFeatureWrapper().isNull() && !feature->getFeatureWrapper()->getGeometry().isNull()){
+            element.getObservation()->removeTargetGeometry(feature->getFeatureWrapper()->getGeometry());
         }
 
     }else if(getIsReading(element.typeOfElement)){
@@ -3187,8 +3898,8 @@ void OiJob::resetDependencies(const InputElement &element, const QPointer<Featur
 
     }else if(element.typeOfElement != eUndefinedElement){
 
-        if(!element.geometry.isNull() && !element.geometry->getFeatureWrapper().isNull()){
-            feature->removePreviouslyNeeded(element.geometry->getFeatureWrapper());
+        if(!element.getGeometry().isNull() && !element.getGeometry()->getFeatureWrapper().isNull()){
+            feature->removePreviouslyNeeded(element.getGeometry()->getFeatureWrapper());
         }
 
     }
@@ -3217,7 +3928,7 @@ void OiJob::addFeaturesFromXml(const QList<QPointer<FeatureWrapper> > &features)
         //pass the job instance to the feature
         feature->getFeature()->job = this;
         for(QPointer<Function> function : feature->getFeature()->getFunctions()) {
-            QObject::connect(function.data(), &Function::sendMessage, this, &OiJob::sendMessage, Qt::AutoConnection);
+            QObject::connect(function.data(), &Function::sendMessage, &this->recalcScheduler, &RecalcScheduler::relayMessage, Qt::DirectConnection);
         }
 
         if(!feature->getStation().isNull()){
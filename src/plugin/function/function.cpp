@@ -254,17 +254,18 @@ const QMap<int, QList<InputElement> > &Function::getInputElements() const{
  * \param id
  * \return
  */
-InputElement Function::getInputElement(const int &id) const{
+const InputElement &Function::getInputElement(const int &id) const{
 
-    QList<int> keys = this->inputElements.keys();
-    foreach(const int &key, keys){
-        foreach(const InputElement &element, this->inputElements[key]){
-            if(element.id == id){
-                return element;
-            }
+    static const InputElement emptyElement;
+
+    QMap<int, QList<InputElement> >::const_iterator it;
+    for(it = this->inputElements.constBegin(); it != this->inputElements.constEnd(); ++it){
+        int index = this->getInputElementIndex(it.key(), id);
+        if(index > -1){
+            return it.value().at(index);
         }
     }
-    return InputElement();
+    return emptyElement;
 
 }
 
@@ -275,16 +276,15 @@ InputElement Function::getInputElement(const int &id) const{
  * \param position
  * \return
  */
-InputElement Function::getInputElement(const int &id, const int &position) const{
+const InputElement &Function::getInputElement(const int &id, const int &position) const{
 
-    if(this->inputElements.contains(position)){
-        foreach(const InputElement &element, this->inputElements[position]){
-            if(element.id == id){
-                return element;
-            }
-        }
+    static const InputElement emptyElement;
+
+    int index = this->getInputElementIndex(position, id);
+    if(index > -1){
+        return this->inputElements.constFind(position).value().at(index);
     }
-    return InputElement();
+    return emptyElement;
 
 }
 
@@ -298,10 +298,8 @@ bool Function::hasInputElement(const int &id) const{
 
     QList<int> keys = this->inputElements.keys();
     foreach(const int &key, keys){
-        foreach(const InputElement &element, this->inputElements[key]){
-            if(element.id == id){
-                return true;
-            }
+        if(this->getInputElementIndex(key, id) > -1){
+            return true;
         }
     }
     return false;
@@ -315,13 +313,36 @@ bool Function::hasInputElement(const int &id) const{
  */
 void Function::addInputElement(const InputElement &element, const int &position){
 
-    //add the input element
-    if(this->inputElements.contains(position)){
-        this->inputElements[position].append(element);
-    }else{
-        QList<InputElement> elements;
-        elements.append(element);
-        this->inputElements.insert(position, elements);
+    //add and index the input element
+    QMultiHash<int, int> &indices = this->syncInputElementIndex(position);
+    QList<InputElement> &positionElements = this->inputElements[position];
+    positionElements.append(element);
+    indices.insert(element.id, positionElements.size() - 1);
+
+    emit this->inputElementsChanged();
+
+}
+
+/*!
+ * \brief Function::addInputElements
+ * Adds all given elements at the given position and emits inputElementsChanged only once
+ * \param elements
+ * \param position
+ */
+void Function::addInputElements(const QList<InputElement> &elements, const int &position){
+
+    if(elements.isEmpty()){
+        return;
+    }
+
+    //add and index the input elements
+    QMultiHash<int, int> &indices = this->syncInputElementIndex(position);
+    QList<InputElement> &positionElements = this->inputElements[position];
+    positionElements.reserve(positionElements.size() + elements.size());
+    indices.reserve(indices.size() + elements.size());
+    foreach(const InputElement &element, elements){
+        positionElements.append(element);
+        indices.insert(element.id, positionElements.size() - 1);
     }
 
     emit this->inputElementsChanged();
@@ -330,25 +351,55 @@ void Function::addInputElement(const InputElement &element, const int &position)
 
 /*!
  * \brief Function::removeInputElement
+ * Removes the (first) element with the given id at the given position. The order of the other elements is kept
  * \param id
  * \param position
  */
 void Function::removeInputElement(const int &id, const int &position){
-    if(this->inputElements.contains(position)){
-        this->inputElements[position].removeOne(InputElement(id));
-        emit this->inputElementsChanged();
+
+    QMultiHash<int, int> &indices = this->syncInputElementIndex(position);
+    int index = this->getInputElementIndex(position, id);
+    if(index < 0){
+        return;
     }
+
+    //remove the element and shift the indices of all following elements
+    this->inputElements[position].removeAt(index);
+    indices.remove(id, index);
+    QMultiHash<int, int>::iterator it;
+    for(it = indices.begin(); it != indices.end(); ++it){
+        if(it.value() > index){
+            it.value()--;
+        }
+    }
+
+    emit this->inputElementsChanged();
+
 }
 
 /*!
  * \brief Function::removeInputElement
+ * Removes the element with the given id from all positions
  * \param id
  */
 void Function::removeInputElement(const int &id){
-    for(int i = 0; i < this->inputElements.size(); i++){
-        this->inputElements[i].removeOne(InputElement(id));
+
+    //block signals so that inputElementsChanged is only emitted once
+    bool removed = false;
+    bool blocked = this->blockSignals(true);
+    QList<int> keys = this->inputElements.keys();
+    foreach(const int &key, keys){
+        if(this->getInputElementIndex(key, id) > -1){
+            this->removeInputElement(id, key);
+            removed = true;
+        }
+    }
+    this->blockSignals(blocked);
+
+    if(removed){
         emit this->inputElementsChanged();
     }
+
 }
 
 /*!
@@ -357,12 +408,10 @@ void Function::removeInputElement(const int &id){
  * \param position
  */
 void Function::replaceInputElement(const InputElement &element, const int &position){
-    if(this->inputElements.contains(position)){
-        int index = this->inputElements[position].indexOf(element);
-        if(index > -1){
-            this->inputElements[position].replace(index, element);
-            emit this->inputElementsChanged();
-        }
+    int index = this->getInputElementIndex(position, element.id);
+    if(index > -1){
+        this->inputElements[position].replace(index, element);
+        emit this->inputElementsChanged();
     }
 }
 
@@ -374,11 +423,9 @@ void Function::replaceInputElement(const InputElement &element, const int &posit
  */
 bool Function::getIsUsed(const int &position, const int &id){
 
-    if(this->inputElements.contains(position)){
-        int index = this->inputElements[position].indexOf(id);
-        if(index > -1){
-            return this->inputElements[position][index].isUsed;
-        }
+    int index = this->getInputElementIndex(position, id);
+    if(index > -1){
+        return this->inputElements[position][index].isUsed;
     }
 
     return false;
@@ -393,11 +440,9 @@ bool Function::getIsUsed(const int &position, const int &id){
  */
 bool Function::getShouldBeUsed(const int &position, const int &id){
 
-    if(this->inputElements.contains(position)){
-        int index = this->inputElements[position].indexOf(id);
-        if(index > -1){
-            return this->inputElements[position][index].shouldBeUsed;
-        }
+    int index = this->getInputElementIndex(position, id);
+    if(index > -1){
+        return this->inputElements[position][index].shouldBeUsed;
     }
 
     return false;
@@ -413,14 +458,44 @@ bool Function::getShouldBeUsed(const int &position, const int &id){
 void Function::setShouldBeUsed(const int &position, const int &id, const bool &state){
 
     //get the element at position with id and set shouldBeUsed to state
-    if(this->inputElements.contains(position)){
-        int index = this->inputElements[position].indexOf(id);
-        if(index > -1){
-            this->inputElements[position][index].shouldBeUsed = state;
-            emit this->inputElementsChanged();
+    int index = this->getInputElementIndex(position, id);
+    if(index > -1){
+        this->inputElements[position][index].shouldBeUsed = state;
+        emit this->inputElementsChanged();
+    }
+
+}
+
+/*!
+ * \brief Function::setShouldBeUsed
+ * Sets shouldBeUsed of all elements at position whose id is in ids and emits inputElementsChanged only once
+ * \param position
+ * \param ids
+ * \param state
+ * \return the number of elements whose state has changed
+ */
+int Function::setShouldBeUsed(const int &position, const QSet<int> &ids, const bool &state){
+
+    if(ids.isEmpty() || !this->inputElements.contains(position)){
+        return 0;
+    }
+
+    int numChanged = 0;
+    QList<InputElement> &positionElements = this->inputElements[position];
+    foreach(const int &id, ids){
+        int index = this->getInputElementIndex(position, id);
+        if(index > -1 && positionElements.at(index).shouldBeUsed != state){
+            positionElements[index].shouldBeUsed = state;
+            numChanged++;
         }
     }
 
+    if(numChanged > 0){
+        emit this->inputElementsChanged();
+    }
+
+    return numChanged;
+
 }
 
 /*!
@@ -428,6 +503,7 @@ void Function::setShouldBeUsed(const int &position, const int &id, const bool &s
  */
 void Function::clear(){
     this->inputElements.clear();
+    this->inputElementIndices.clear();
     this->fixedParameters.clear();
     this->scalarInputParams.isValid = false;
     this->resultProtocol.clear();
@@ -553,6 +629,99 @@ QDomElement Function::toOpenIndyXML(QDomDocument &xmlDoc) const{
 
 }
 
+/*!
+ * \brief Function::toOpenIndyXML
+ * Writes the same schema as the QDomDocument variant. The input elements are written one after the other,
+ * so that no DOM node is created per input observation.
+ * \param xmlWriter
+ * \param executionIndex the position of the function in the function list of its feature (not written if negative)
+ */
+void Function::toOpenIndyXML(QXmlStreamWriter &xmlWriter, const int &executionIndex) const{
+
+    //add function attributes
+    xmlWriter.writeStartElement("function");
+    xmlWriter.writeAttribute("name", this->getMetaData().name);
+    xmlWriter.writeAttribute("type", this->getMetaData().iid);
+    xmlWriter.writeAttribute("plugin", this->getMetaData().pluginName);
+    if(executionIndex >= 0){
+        xmlWriter.writeAttribute("executionIndex", QString::number(executionIndex));
+    }
+
+    //add used elements
+    xmlWriter.writeStartElement("inputElements");
+    QMapIterator<int, QList<InputElement> > inputIterator(this->getInputElements());
+    while (inputIterator.hasNext()) {
+        inputIterator.next();
+        foreach(const InputElement &input, inputIterator.value()){
+            xmlWriter.writeStartElement("element");
+            xmlWriter.writeAttribute("index", QString::number(inputIterator.key()));
+            xmlWriter.writeAttribute("type", QString::number(input.typeOfElement));
+            xmlWriter.writeAttribute("ref", QString::number(input.id));
+            xmlWriter.writeAttribute("isUsed", QString::number(input.isUsed));
+            xmlWriter.writeAttribute("shouldBeUsed", QString::number(input.shouldBeUsed));
+
+            //add ignored destination parameters of the input element
+            xmlWriter.writeStartElement("ignoredDestinationParams");
+            for(int i=0; i< input.ignoredDestinationParams.size();i++){
+                xmlWriter.writeEmptyElement("ignoredParam");
+                xmlWriter.writeAttribute("parameter", getGeometryParameterName(input.ignoredDestinationParams.at(i)));
+            }
+            xmlWriter.writeEndElement();
+
+            xmlWriter.writeEndElement();
+        }
+    }
+    xmlWriter.writeEndElement();
+
+    ScalarInputParams params;
+    if(!this->scalarInputParams.isValid){
+        params.doubleParameter = this->doubleParameters;
+        params.intParameter = this->integerParameters;
+        QStringList keys = this->stringParameters.keys();
+        foreach(const QString &key, keys){
+            params.stringParameter.insert(key, this->stringParameters.value(key));
+        }
+    }else{
+        params = this->scalarInputParams;
+    }
+
+    //add integer parameters
+    xmlWriter.writeStartElement("integerParameters");
+    QMapIterator<QString, int> intIterator(params.intParameter);
+    while (intIterator.hasNext()) {
+        intIterator.next();
+        xmlWriter.writeEmptyElement("parameter");
+        xmlWriter.writeAttribute("name", intIterator.key());
+        xmlWriter.writeAttribute("value", QString::number(intIterator.value()));
+    }
+    xmlWriter.writeEndElement();
+
+    //add double parameters (numbers are formatted like QDomElement::setAttribute does)
+    xmlWriter.writeStartElement("doubleParameters");
+    QMapIterator<QString, double> doubleIterator(params.doubleParameter);
+    while (doubleIterator.hasNext()) {
+        doubleIterator.next();
+        xmlWriter.writeEmptyElement("parameter");
+        xmlWriter.writeAttribute("name", doubleIterator.key());
+        xmlWriter.writeAttribute("value", QString::number(doubleIterator.value(), 'g', 17));
+    }
+    xmlWriter.writeEndElement();
+
+    //add string parameters
+    xmlWriter.writeStartElement("stringParameters");
+    QMapIterator<QString, QString> stringIterator(params.stringParameter);
+    while (stringIterator.hasNext()) {
+        stringIterator.next();
+        xmlWriter.writeEmptyElement("parameter");
+        xmlWriter.writeAttribute("name", stringIterator.key());
+        xmlWriter.writeAttribute("value", stringIterator.value());
+    }
+    xmlWriter.writeEndElement();
+
+    xmlWriter.writeEndElement();
+
+}
+
 /*!
  * \brief Function::fromOpenIndyXML
  * \param xmlElem
@@ -843,24 +1012,95 @@ bool Function::exec(Torus &torus){
 void Function::setIsUsed(const int &position, const int &id, const bool &state){
 
     //get the element at position with id and set isUsed to state
-    if(this->inputElements.contains(position)){
-        int index = this->inputElements[position].indexOf(id);
-        if(index > -1){
-            this->inputElements[position][index].isUsed = state;
+    int index = this->getInputElementIndex(position, id);
+    if(index > -1){
+        this->inputElements[position][index].isUsed = state;
+    }
+
+}
+
+/*!
+ * \brief Function::getInputElementIndex
+ * Returns the index of the (first) element with the given id in inputElements[position] or -1.
+ * The index is only read here. If derived functions have changed inputElements directly the elements are searched
+ * \param position
+ * \param id
+ * \return
+ */
+int Function::getInputElementIndex(const int &position, const int &id) const{
+
+    QMap<int, QList<InputElement> >::const_iterator elements = this->inputElements.constFind(position);
+    if(elements == this->inputElements.constEnd()){
+        return -1;
+    }
+    const QList<InputElement> &positionElements = elements.value();
+
+    //look up the index if it is in sync with the elements
+    QHash<int, QMultiHash<int, int> >::const_iterator indices = this->inputElementIndices.constFind(position);
+    if(indices != this->inputElementIndices.constEnd() && indices.value().size() == positionElements.size()){
+
+        int index = -1;
+        QMultiHash<int, int>::const_iterator it = indices.value().constFind(id);
+        for(; it != indices.value().constEnd() && it.key() == id; ++it){
+            if(index < 0 || it.value() < index){
+                index = it.value();
+            }
         }
+        if(index < 0){
+            return -1;
+        }
+        if(index < positionElements.size() && positionElements.at(index).id == id){
+            return index;
+        }
+
+    }
+
+    //the index is out of date
+    for(int i = 0; i < positionElements.size(); i++){
+        if(positionElements.at(i).id == id){
+            return i;
+        }
+    }
+    return -1;
+
+}
+
+/*!
+ * \brief Function::syncInputElementIndex
+ * Returns the index of the elements at the given position and rebuilds it if derived functions have changed
+ * inputElements directly
+ * \param position
+ * \return
+ */
+QMultiHash<int, int> &Function::syncInputElementIndex(const int &position){
+
+    QMultiHash<int, int> &indices = this->inputElementIndices[position];
+    const QList<InputElement> positionElements = this->inputElements.value(position);
+
+    //each element has exactly one entry in the index
+    if(indices.size() == positionElements.size()){
+        return indices;
+    }
+
+    indices.clear();
+    indices.reserve(positionElements.size());
+    for(int i = 0; i < positionElements.size(); i++){
+        indices.insert(positionElements.at(i).id, i);
     }
+    return indices;
 
 }
 
 void Function::filterObservations(QList<QPointer<Observation> > &allUsableObservations, QList<QPointer<Observation> > &inputObservations) {
     foreach(const InputElement &element, this->getInputElements()[0]){
-        if(!element.observation.isNull()
-                && element.observation->getIsSolved()
-                && element.observation->getIsValid()) {
-            allUsableObservations.append(element.observation);
+        QPointer<Observation> observation = element.getObservation();
+        if(!observation.isNull()
+                && observation->getIsSolved()
+                && observation->getIsValid()) {
+            allUsableObservations.append(observation);
             this->setIsUsed(0, element.id, element.shouldBeUsed);
             if(element.shouldBeUsed){
-                inputObservations.append(element.observation);
+                inputObservations.append(observation);
             }
             continue;
         }
@@ -0,0 +1,478 @@
+#include "robustfit.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+#include <QWaitCondition>
+#include <QSharedPointer>
+#include <QRunnable>
+#include <QThread>
+#include <QThreadPool>
+#include <limits>
+#include <cmath>
+
+using namespace oi;
+
+namespace{
+
+/*!
+ * \brief The SampleGenerator class
+ * SplitMix64 generator that is seeded per hypothesis, so that each hypothesis draws the same sample in each run
+ */
+class SampleGenerator{
+public:
+    SampleGenerator(const quint32 &seed, const int &hypothesis)
+        : state((quint64)seed * 0xD1B54A32D192ED03ULL + (quint64)(hypothesis + 1) * 0x9E3779B97F4A7C15ULL){}
+
+    int next(const int &bound){
+        quint64 z = (this->state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        z = z ^ (z >> 31);
+        return (int)(z % (quint64)bound);
+    }
+
+private:
+    quint64 state;
+};
+
+/*!
+ * \brief The RobustFitState class
+ * State shared by all threads that evaluate hypotheses.
+ * Hypotheses are handed out in ascending order. Finished hypotheses are merged in the same order (like a sequential
+ * estimator would do) so that the best hypothesis and the termination only depend on the seed.
+ * Tasks that are started after all required hypotheses are taken return immediately without touching the model.
+ * The state only references the model and the points of the caller, so that the estimator waits until no hypothesis
+ * is evaluated anymore (not only until all required hypotheses are merged) before it returns.
+ */
+class RobustFitState{
+public:
+    RobustFitState(const RobustFitModel &model, const QVector<Vec3> &points, const RobustFitOptions &options)
+        : model(model), points(points), options(options), nextHypothesis(0), requiredHypotheses(options.maxIterations),
+          costs(options.maxIterations, std::numeric_limits<double>::infinity()), numInliers(options.maxIterations, 0),
+          parameters(options.maxIterations), isFinished(options.maxIterations, false),
+          numEvaluating(0), numMerged(0), bestHypothesis(-1), bestCost(std::numeric_limits<double>::infinity()){}
+
+    const RobustFitModel &model;
+    const QVector<Vec3> points;
+    const RobustFitOptions options;
+
+    //hand out and results of all hypotheses (guarded by mutex)
+    QMutex mutex;
+    QWaitCondition allMerged;
+    int nextHypothesis;
+    int requiredHypotheses;
+    QVector<double> costs;
+    QVector<int> numInliers;
+    QVector<RobustFitParameters> parameters;
+    QVector<bool> isFinished;
+    int numEvaluating; //number of hypotheses that are taken but not merged yet
+
+    //best hypothesis of all merged hypotheses [0, numMerged) (guarded by mutex)
+    int numMerged;
+    int bestHypothesis;
+    double bestCost;
+
+    bool takeHypothesis(int &hypothesis);
+    void evaluate(const int &hypothesis);
+    void waitForAllMerged();
+    void merge(const int &hypothesis, const double &cost, const int &inliers, const RobustFitParameters &params);
+};
+
+/*!
+ * \brief RobustFitState::takeHypothesis
+ * Hands out the next hypothesis as long as the required number of hypotheses is not reached
+ * (each taken hypothesis must be evaluated and merged)
+ * \param hypothesis
+ * \return
+ */
+bool RobustFitState::takeHypothesis(int &hypothesis){
+
+    QMutexLocker locker(&this->mutex);
+    if(this->nextHypothesis >= this->requiredHypotheses){
+        return false;
+    }
+    hypothesis = this->nextHypothesis++;
+    this->numEvaluating++;
+    return true;
+
+}
+
+/*!
+ * \brief RobustFitState::evaluate
+ * Draws the sample of the given hypothesis, estimates the model and scores all points
+ * \param hypothesis
+ */
+void RobustFitState::evaluate(const int &hypothesis){
+
+    const int numPoints = this->points.size();
+    const int sampleSize = this->model.getSampleSize();
+
+    //draw sampleSize different points
+    Vec3 sample[8];
+    int indices[8];
+    SampleGenerator generator(this->options.seed, hypothesis);
+    for(int i = 0; i < sampleSize; i++){
+        bool isDuplicate = true;
+        while(isDuplicate){
+            indices[i] = generator.next(numPoints);
+            isDuplicate = false;
+            for(int j = 0; j < i; j++){
+                if(indices[j] == indices[i]){
+                    isDuplicate = true;
+                    break;
+                }
+            }
+        }
+        sample[i] = this->points.at(indices[i]);
+    }
+
+    RobustFitParameters params;
+    if(!this->model.estimate(sample, params)){
+        this->merge(hypothesis, std::numeric_limits<double>::infinity(), 0, params);
+        return;
+    }
+
+    //a hypothesis that is worse than the best merged one cannot win anymore (stop scoring early)
+    double bound;
+    {
+        QMutexLocker locker(&this->mutex);
+        bound = this->bestCost;
+    }
+
+    //score all points (RANSAC counts outliers, MSAC sums truncated squared distances)
+    const double threshold2 = this->options.threshold * this->options.threshold;
+    double cost = 0.0;
+    int inliers = 0;
+    for(int i = 0; i < numPoints; i++){
+        const double distance = this->model.getDistance(params, this->points.at(i));
+        const double distance2 = distance * distance;
+        if(distance2 < threshold2){
+            inliers++;
+            if(this->options.type == eMsacFit){
+                cost += distance2;
+            }
+        }else{
+            cost += threshold2;
+        }
+        if(cost > bound){
+            cost = std::numeric_limits<double>::infinity();
+            break;
+        }
+    }
+
+    this->merge(hypothesis, cost, inliers, params);
+
+}
+
+/*!
+ * \brief RobustFitState::merge
+ * Stores the result of a hypothesis and merges all finished hypotheses in ascending order
+ * \param hypothesis
+ * \param cost
+ * \param inliers
+ * \param params
+ */
+void RobustFitState::merge(const int &hypothesis, const double &cost, const int &inliers, const RobustFitParameters &params){
+
+    QMutexLocker locker(&this->mutex);
+
+    this->costs[hypothesis] = cost;
+    this->numInliers[hypothesis] = inliers;
+    this->parameters[hypothesis] = params;
+    this->isFinished[hypothesis] = true;
+    this->numEvaluating--;
+
+    while(this->numMerged < this->requiredHypotheses && this->isFinished.at(this->numMerged)){
+
+        //update the best hypothesis (the lowest index wins on equal costs)
+        if(this->costs.at(this->numMerged) < this->bestCost){
+            this->bestCost = this->costs.at(this->numMerged);
+            this->bestHypothesis = this->numMerged;
+            double inlierRatio = (double)this->numInliers.at(this->numMerged) / (double)this->points.size();
+            int required = RobustEstimator::getRequiredIterations(inlierRatio, this->model.getSampleSize(),
+                                                                  this->options.confidence, this->options.maxIterations);
+            if(required < this->requiredHypotheses){
+                this->requiredHypotheses = required;
+            }
+        }
+        this->numMerged++;
+
+    }
+
+    if(this->numMerged >= this->requiredHypotheses && this->numEvaluating == 0){
+        this->allMerged.wakeAll();
+    }
+
+}
+
+/*!
+ * \brief RobustFitState::waitForAllMerged
+ * Blocks until all required hypotheses are evaluated and merged and no other thread evaluates a hypothesis anymore
+ * (hypotheses that were taken before the required number was reduced are still evaluated by other threads)
+ */
+void RobustFitState::waitForAllMerged(){
+
+    QMutexLocker locker(&this->mutex);
+    while(this->numMerged < this->requiredHypotheses || this->numEvaluating > 0){
+        this->allMerged.wait(&this->mutex);
+    }
+
+}
+
+/*!
+ * \brief The RobustFitTask class
+ * Evaluates hypotheses until the required number of hypotheses is reached
+ */
+class RobustFitTask : public QRunnable
+{
+public:
+    RobustFitTask(const QSharedPointer<RobustFitState> &state) : state(state){}
+
+    void run(){
+        int hypothesis;
+        while(this->state->takeHypothesis(hypothesis)){
+            this->state->evaluate(hypothesis);
+        }
+    }
+
+private:
+    QSharedPointer<RobustFitState> state;
+};
+
+}
+
+/*!
+ * \brief RobustFitOptions::RobustFitOptions
+ */
+RobustFitOptions::RobustFitOptions() : type(eNoRobustFit), threshold(0.001), confidence(0.99),
+    maxIterations(1000), numThreads(0), seed(0){
+
+}
+
+/*!
+ * \brief RobustFitOptions::fromScalarInputParams
+ * \param params
+ * \return
+ */
+RobustFitOptions RobustFitOptions::fromScalarInputParams(const ScalarInputParams &params){
+
+    RobustFitOptions options;
+
+    QString type = params.stringParameter.value("robust fit");
+    if(type.compare("RANSAC", Qt::CaseInsensitive) == 0){
+        options.type = eRansacFit;
+    }else if(type.compare("MSAC", Qt::CaseInsensitive) == 0){
+        options.type = eMsacFit;
+    }
+
+    options.threshold = params.doubleParameter.value("robust threshold", options.threshold);
+    options.confidence = params.doubleParameter.value("robust confidence", options.confidence);
+    options.maxIterations = params.intParameter.value("robust iterations", options.maxIterations);
+    options.numThreads = params.intParameter.value("robust threads", options.numThreads);
+    options.seed = (quint32)params.intParameter.value("robust seed", (int)options.seed);
+
+    return options;
+
+}
+
+/*!
+ * \brief RobustFitCircleModel::getSampleSize
+ * \return
+ */
+int RobustFitCircleModel::getSampleSize() const{
+    return 3;
+}
+
+/*!
+ * \brief RobustFitCircleModel::estimate
+ * Circumscribed circle of the three sample points (parameters: center, normal, radius)
+ * \param sample
+ * \param parameters
+ * \return
+ */
+bool RobustFitCircleModel::estimate(const Vec3 *sample, RobustFitParameters &parameters) const{
+
+    const Vec3 u = sample[1] - sample[0];
+    const Vec3 v = sample[2] - sample[0];
+    const Vec3 w = u.cross(v);
+    const double w2 = w.dot(w);
+    if(w2 < 1.0e-12 * u.dot(u) * v.dot(v)){
+        return false;
+    }
+
+    const Vec3 center = sample[0] + (u.dot(u) * v.cross(w) + v.dot(v) * w.cross(u)) / (2.0 * w2);
+    const Vec3 normal = w / std::sqrt(w2);
+
+    parameters.values[0] = center.x();
+    parameters.values[1] = center.y();
+    parameters.values[2] = center.z();
+    parameters.values[3] = normal.x();
+    parameters.values[4] = normal.y();
+    parameters.values[5] = normal.z();
+    parameters.values[6] = (center - sample[0]).length();
+
+    return true;
+
+}
+
+/*!
+ * \brief RobustFitCircleModel::getDistance
+ * \param parameters
+ * \param point
+ * \return
+ */
+double RobustFitCircleModel::getDistance(const RobustFitParameters &parameters, const Vec3 &point) const{
+
+    const Vec3 reduced = point - Vec3(parameters.values[0], parameters.values[1], parameters.values[2]);
+    const Vec3 normal(parameters.values[3], parameters.values[4], parameters.values[5]);
+
+    const double height = reduced.dot(normal);
+    const double radial = (reduced - height * normal).length() - parameters.values[6];
+    return std::sqrt(height * height + radial * radial);
+
+}
+
+/*!
+ * \brief RobustFitCircle2DModel::getSampleSize
+ * \return
+ */
+int RobustFitCircle2DModel::getSampleSize() const{
+    return 3;
+}
+
+/*!
+ * \brief RobustFitCircle2DModel::estimate
+ * Circumscribed circle of the three sample points in the xy plane (parameters: center x, center y, radius)
+ * \param sample
+ * \param parameters
+ * \return
+ */
+bool RobustFitCircle2DModel::estimate(const Vec3 *sample, RobustFitParameters &parameters) const{
+
+    const double ux = sample[1].x() - sample[0].x(), uy = sample[1].y() - sample[0].y();
+    const double vx = sample[2].x() - sample[0].x(), vy = sample[2].y() - sample[0].y();
+    const double u2 = ux * ux + uy * uy;
+    const double v2 = vx * vx + vy * vy;
+    const double d = 2.0 * (ux * vy - uy * vx);
+    if(d * d < 1.0e-12 * u2 * v2){
+        return false;
+    }
+
+    const double cx = (vy * u2 - uy * v2) / d;
+    const double cy = (ux * v2 - vx * u2) / d;
+
+    parameters.values[0] = sample[0].x() + cx;
+    parameters.values[1] = sample[0].y() + cy;
+    parameters.values[2] = std::sqrt(cx * cx + cy * cy);
+
+    return true;
+
+}
+
+/*!
+ * \brief RobustFitCircle2DModel::getDistance
+ * \param parameters
+ * \param point
+ * \return
+ */
+double RobustFitCircle2DModel::getDistance(const RobustFitParameters &parameters, const Vec3 &point) const{
+
+    const double dx = point.x() - parameters.values[0];
+    const double dy = point.y() - parameters.values[1];
+    return std::abs(std::sqrt(dx * dx + dy * dy) - parameters.values[2]);
+
+}
+
+/*!
+ * \brief RobustEstimator::estimate
+ * Returns the best hypothesis and the inliers of all points
+ * \param model
+ * \param points
+ * \param options
+ * \return
+ */
+RobustFitResult RobustEstimator::estimate(const RobustFitModel &model, const QVector<Vec3> &points, const RobustFitOptions &options){
+
+    RobustFitResult result;
+
+    //check the input
+    if(model.getSampleSize() > 8 || points.size() < model.getSampleSize()
+            || options.maxIterations <= 0 || options.threshold <= 0.0){
+        return result;
+    }
+
+    QSharedPointer<RobustFitState> state(new RobustFitState(model, points, options));
+
+    //start one task per additional thread (the calling thread takes part as well, so that the estimation
+    //does not depend on idle threads of the global pool)
+    int numThreads = options.numThreads > 0 ? options.numThreads : QThread::idealThreadCount();
+    numThreads = qMin(numThreads, options.maxIterations);
+    for(int i = 1; i < numThreads; i++){
+        RobustFitTask *task = new RobustFitTask(state);
+        task->setAutoDelete(true);
+        QThreadPool::globalInstance()->start(task);
+    }
+
+    RobustFitTask task(state);
+    task.run();
+
+    //wait for hypotheses that are still evaluated by other threads
+    state->waitForAllMerged();
+
+    if(state->bestHypothesis < 0 || state->bestCost == std::numeric_limits<double>::infinity()){
+        return result;
+    }
+
+    //get the inliers of the best hypothesis
+    result.isValid = true;
+    result.parameters = state->parameters.at(state->bestHypothesis);
+    result.cost = state->bestCost;
+    result.numHypotheses = state->numMerged;
+    result.inliers.resize(points.size());
+    for(int i = 0; i < points.size(); i++){
+        bool isInlier = model.getDistance(result.parameters, points.at(i)) < options.threshold;
+        result.inliers[i] = isInlier;
+        if(isInlier){
+            result.numInliers++;
+        }
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief RobustEstimator::getRequiredIterations
+ * Returns the number of hypotheses needed to draw an outlier free sample with the given confidence
+ * \param inlierRatio
+ * \param sampleSize
+ * \param confidence
+ * \param maxIterations
+ * \return
+ */
+int RobustEstimator::getRequiredIterations(const double &inlierRatio, const int &sampleSize, const double &confidence, const int &maxIterations){
+
+    if(inlierRatio <= 0.0 || confidence <= 0.0){
+        return maxIterations;
+    }
+    if(confidence >= 1.0){
+        return maxIterations;
+    }
+
+    const double outlierFreeProbability = std::pow(inlierRatio, sampleSize);
+    if(outlierFreeProbability >= 1.0){
+        return 1;
+    }
+
+    const double denominator = std::log(1.0 - outlierFreeProbability);
+    if(denominator >= 0.0){
+        return maxIterations;
+    }
+
+    double required = std::ceil(std::log(1.0 - confidence) / denominator);
+    if(required >= (double)maxIterations){
+        return maxIterations;
+    }
+    return qMax(1, (int)required);
+
+}
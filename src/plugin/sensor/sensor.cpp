@@ -8,6 +8,28 @@ using namespace oi;
 
 SensorInterface::SensorInterface(QObject *parent): QObject(parent) {}
 
+/*!
+ * \brief SensorInterface::isReadingStreamTyped
+ * Returns true if the sensor streams typed samples (see readingStreamSample and asyncStreamSample)
+ * \return
+ */
+bool SensorInterface::isReadingStreamTyped() const{
+    return false;
+}
+
+/*!
+ * \brief SensorInterface::readingStreamSample
+ * Reads a typed sample of the reading stream without allocating memory
+ * \param streamFormat
+ * \param sample
+ * \return false if no sample could be read
+ */
+bool SensorInterface::readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample){
+    Q_UNUSED(streamFormat);
+    Q_UNUSED(sample);
+    return false;
+}
+
 /*!
  * \brief Sensor::Sensor
  * \param parent
@@ -29,6 +29,7 @@ void SensorFacade::init() {
     connect(this, &SensorInterface::asyncSensorResponse, inner, &SensorInterface::asyncSensorResponse);
     connect(this, &SensorInterface::asyncMeasurementResult, inner, &SensorInterface::asyncMeasurementResult);
     connect(this, &SensorInterface::asyncStreamResult, inner, &SensorInterface::asyncStreamResult);
+    connect(this, &SensorInterface::asyncStreamSample, inner, &SensorInterface::asyncStreamSample);
     connect(this, &SensorInterface::asyncSensorNotification, inner, &SensorInterface::asyncSensorNotification);
 
 }
@@ -130,6 +131,12 @@ QList<QPointer<Reading> > SensorFacade::measure(const MeasurementConfig &mConfig
 QVariantMap SensorFacade::readingStream(const ReadingTypes &streamFormat){
     return this->inner->readingStream(streamFormat);
 }
+bool SensorFacade::isReadingStreamTyped() const{
+    return this->inner->isReadingStreamTyped();
+}
+bool SensorFacade::readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample){
+    return this->inner->readingStreamSample(streamFormat, sample);
+}
 
 //status information
 bool SensorFacade::getConnectionState(){
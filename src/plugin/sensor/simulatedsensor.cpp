@@ -0,0 +1,993 @@
+#include "simulatedsensor.h"
+
+#include <QThread>
+
+#include "point.h"
+#include "plane.h"
+#include "sphere.h"
+#include "cylinder.h"
+#include "circle.h"
+
+using namespace oi;
+
+namespace{
+
+//! returns the response to an asynchronous request
+QJsonObject createResponse(const QJsonObject &request, const bool &success, const QString &message){
+    QJsonObject response;
+    response.insert("jsonrpc", "2.0");
+    response.insert("id", request.value("id"));
+    if(success){
+        response.insert("result", message);
+    }else{
+        QJsonObject error;
+        error.insert("code", -32000);
+        error.insert("message", message);
+        response.insert("error", error);
+    }
+    return response;
+}
+
+}
+
+/*!
+ * \brief SimulatedSurface::SimulatedSurface
+ */
+SimulatedSurface::SimulatedSurface() : typeOfFeature(eUndefinedFeature), direction(0.0, 0.0, 1.0),
+    firstAxis(1.0, 0.0, 0.0), secondAxis(0.0, 1.0, 0.0), radius(0.0), extent(0.0){
+
+}
+
+/*!
+ * \brief SimulatedSurface::fromGeometry
+ * \param geometry
+ * \param extent
+ * \return an invalid surface if the type of the geometry is not supported
+ */
+SimulatedSurface SimulatedSurface::fromGeometry(const QPointer<Geometry> &geometry, const double &extent){
+
+    SimulatedSurface surface;
+    if(geometry.isNull()){
+        return surface;
+    }
+
+    if(qobject_cast<Point *>(geometry.data()) != NULL){
+        surface.typeOfFeature = ePointFeature;
+    }else if(qobject_cast<Plane *>(geometry.data()) != NULL){
+        surface.typeOfFeature = ePlaneFeature;
+    }else if(qobject_cast<Sphere *>(geometry.data()) != NULL){
+        surface.typeOfFeature = eSphereFeature;
+    }else if(qobject_cast<Cylinder *>(geometry.data()) != NULL){
+        surface.typeOfFeature = eCylinderFeature;
+    }else if(qobject_cast<Circle *>(geometry.data()) != NULL){
+        surface.typeOfFeature = eCircleFeature;
+    }else{
+        return surface;
+    }
+
+    surface.position = Vec3(geometry->getPosition().getVector());
+    surface.extent = extent;
+    if(geometry->hasRadius()){
+        surface.radius = geometry->getRadius().getRadius();
+    }
+
+    //set up two axes perpendicular to the direction
+    if(geometry->hasDirection()){
+        surface.direction = Vec3(geometry->getDirection().getVector()).normalized();
+        Vec3 helper = qAbs(surface.direction.x()) < 0.9 ? Vec3(1.0, 0.0, 0.0) : Vec3(0.0, 1.0, 0.0);
+        surface.firstAxis = surface.direction.cross(helper).normalized();
+        surface.secondAxis = surface.direction.cross(surface.firstAxis);
+    }
+
+    return surface;
+
+}
+
+/*!
+ * \brief SimulatedSurface::getIsValid
+ * \return
+ */
+bool SimulatedSurface::getIsValid() const{
+    return this->typeOfFeature != eUndefinedFeature;
+}
+
+/*!
+ * \brief SimulatedSurface::getTypeOfFeature
+ * \return
+ */
+const FeatureTypes &SimulatedSurface::getTypeOfFeature() const{
+    return this->typeOfFeature;
+}
+
+/*!
+ * \brief SimulatedSurface::sample
+ * \param u
+ * \param v
+ * \param point
+ * \param normal
+ */
+void SimulatedSurface::sample(const double &u, const double &v, Vec3 &point, Vec3 &normal) const{
+
+    switch(this->typeOfFeature){
+    case ePlaneFeature:
+        point = this->position + (2.0 * u - 1.0) * this->extent * this->firstAxis
+                + (2.0 * v - 1.0) * this->extent * this->secondAxis;
+        normal = this->direction;
+        break;
+    case eSphereFeature:{
+        //uniformly distributed on the sphere
+        double z = 2.0 * u - 1.0;
+        double r = qSqrt(qMax(0.0, 1.0 - z * z));
+        normal = Vec3(r * qCos(2.0 * PI * v), r * qSin(2.0 * PI * v), z);
+        point = this->position + this->radius * normal;
+        break;
+    }
+    case eCylinderFeature:
+        normal = qCos(2.0 * PI * v) * this->firstAxis + qSin(2.0 * PI * v) * this->secondAxis;
+        point = this->position + (2.0 * u - 1.0) * this->extent * this->direction + this->radius * normal;
+        break;
+    case eCircleFeature:
+        point = this->position + this->radius * (qCos(2.0 * PI * u) * this->firstAxis + qSin(2.0 * PI * u) * this->secondAxis);
+        normal = this->direction;
+        break;
+    default:
+        point = this->position;
+        normal = this->direction;
+        break;
+    }
+
+}
+
+/*!
+ * \brief SensorSimulation::SensorSimulation
+ */
+SensorSimulation::SensorSimulation() : seed(0), readingsPerMeasurement(1), streamRate(0.0), isAsync(false),
+    sigmaAzimuth(0.0), sigmaZenith(0.0), sigmaDistance(0.0), sigmaX(0.0), sigmaY(0.0), sigmaZ(0.0),
+    isConnected(false), numMeasured(0), nextStreamSample(0){
+
+}
+
+/*!
+ * \brief SensorSimulation::getSurface
+ * \return
+ */
+SimulatedSurface SensorSimulation::getSurface() const{
+    QMutexLocker locker(&this->surfaceMutex);
+    return this->surface;
+}
+
+/*!
+ * \brief SensorSimulation::setSurface
+ * \param surface
+ */
+void SensorSimulation::setSurface(const SimulatedSurface &surface){
+    QMutexLocker locker(&this->surfaceMutex);
+    this->surface = surface;
+}
+
+/*!
+ * \brief SensorSimulation::configure
+ * Takes the parameters of the simulation from the sensor configuration (the accuracy is the simulated noise)
+ * \param sConfig
+ */
+void SensorSimulation::configure(const SensorConfiguration &sConfig){
+
+    this->seed = (quint64)qMax(0, sConfig.getIntegerParameter().value("seed", 0));
+    this->readingsPerMeasurement = qMax(1, sConfig.getIntegerParameter().value("readings per measurement", 1));
+    this->isAsync = sConfig.getIntegerParameter().value("asynchronous", 0) != 0;
+    this->streamRate = qMax(0.0, sConfig.getDoubleParameter().value("stream rate", 0.0));
+
+    const Accuracy &accuracy = sConfig.getAccuracy();
+    this->sigmaAzimuth = accuracy.sigmaAzimuth;
+    this->sigmaZenith = accuracy.sigmaZenith;
+    this->sigmaDistance = accuracy.sigmaDistance;
+    this->sigmaX = accuracy.sigmaXyz.getSize() == 3 ? accuracy.sigmaXyz.getAt(0) : 0.0;
+    this->sigmaY = accuracy.sigmaXyz.getSize() == 3 ? accuracy.sigmaXyz.getAt(1) : 0.0;
+    this->sigmaZ = accuracy.sigmaXyz.getSize() == 3 ? accuracy.sigmaXyz.getAt(2) : 0.0;
+
+    //the stream is restarted with the new rate
+    this->nextStreamSample = 0;
+    this->streamClock.start();
+
+}
+
+/*!
+ * \brief SensorSimulation::getIsAsync
+ * \return
+ */
+bool SensorSimulation::getIsAsync() const{
+    return this->isAsync;
+}
+
+/*!
+ * \brief SensorSimulation::addParameters
+ * Adds the parameters of the simulation including their default values
+ * \param integerParameters
+ * \param doubleParameters
+ */
+void SensorSimulation::addParameters(QMap<QString, int> &integerParameters, QMap<QString, double> &doubleParameters){
+    integerParameters.insert("seed", 0);
+    integerParameters.insert("readings per measurement", 1);
+    integerParameters.insert("asynchronous", 0);
+    doubleParameters.insert("stream rate", 0.0);
+}
+
+/*!
+ * \brief SensorSimulation::getReadingType
+ * \param requested
+ * \param supported
+ * \return the requested type or the first supported type if the requested type is not supported
+ */
+ReadingTypes SensorSimulation::getReadingType(const ReadingTypes &requested, const QList<ReadingTypes> &supported){
+    if(supported.contains(requested) || supported.isEmpty()){
+        return requested;
+    }
+    return supported.first();
+}
+
+/*!
+ * \brief SensorSimulation::connectSensor
+ * \return
+ */
+bool SensorSimulation::connectSensor(){
+    this->isConnected = true;
+    this->nextStreamSample = 0;
+    this->streamClock.start();
+    return true;
+}
+
+/*!
+ * \brief SensorSimulation::disconnectSensor
+ * \return
+ */
+bool SensorSimulation::disconnectSensor(){
+    this->isConnected = false;
+    return true;
+}
+
+/*!
+ * \brief SensorSimulation::getIsConnected
+ * \return
+ */
+bool SensorSimulation::getIsConnected() const{
+    return this->isConnected;
+}
+
+/*!
+ * \brief SensorSimulation::measure
+ * \param type
+ * \return
+ */
+QList<QPointer<Reading> > SensorSimulation::measure(const ReadingTypes &type){
+
+    QList<QPointer<Reading> > readings;
+    if(!this->isConnected){
+        return readings;
+    }
+
+    //polar readings are converted into cartesian coordinates at once
+    QList<ReadingPolar> polarReadings;
+
+    readings.reserve(this->readingsPerMeasurement);
+    for(int i = 0; i < this->readingsPerMeasurement; i++){
+
+        RealTimeReading sample;
+        if(!this->simulate(type, 2 * this->numMeasured++, sample)){
+            return readings;
+        }
+
+        switch(type){
+        case ePolarReading:{
+            ReadingPolar polar;
+            polar.azimuth = sample.polar.azimuth;
+            polar.zenith = sample.polar.zenith;
+            polar.distance = sample.polar.distance;
+            polar.sigmaAzimuth = this->sigmaAzimuth;
+            polar.sigmaZenith = this->sigmaZenith;
+            polar.sigmaDistance = this->sigmaDistance;
+            polar.isValid = true;
+            polarReadings.append(polar);
+            break;
+        }
+        case eDirectionReading:{
+            ReadingDirection direction;
+            direction.azimuth = sample.direction.azimuth;
+            direction.zenith = sample.direction.zenith;
+            direction.sigmaAzimuth = this->sigmaAzimuth;
+            direction.sigmaZenith = this->sigmaZenith;
+            direction.isValid = true;
+            readings.append(new Reading(direction));
+            break;
+        }
+        case eDistanceReading:{
+            ReadingDistance distance;
+            distance.distance = sample.distance.distance;
+            distance.sigmaDistance = this->sigmaDistance;
+            distance.isValid = true;
+            readings.append(new Reading(distance));
+            break;
+        }
+        case eCartesianReading:{
+            ReadingCartesian cartesian;
+            Vec3(sample.cartesian.x, sample.cartesian.y, sample.cartesian.z).assignTo(cartesian.xyz);
+            Vec3(this->sigmaX, this->sigmaY, this->sigmaZ).assignTo(cartesian.sigmaXyz);
+            cartesian.isValid = true;
+            readings.append(new Reading(cartesian));
+            break;
+        }
+        case eCartesianReading6D:{
+            ReadingCartesian6D cartesian;
+            Vec3(sample.cartesian6D.x, sample.cartesian6D.y, sample.cartesian6D.z).assignTo(cartesian.xyz);
+            Vec3(sample.cartesian6D.i, sample.cartesian6D.j, sample.cartesian6D.k).assignTo(cartesian.ijk);
+            Vec3(this->sigmaX, this->sigmaY, this->sigmaZ).assignTo(cartesian.sigmaXyz);
+            cartesian.isValid = true;
+            readings.append(new Reading(cartesian));
+            break;
+        }
+        default:
+            break;
+        }
+
+    }
+
+    if(!polarReadings.isEmpty()){
+        readings.append(Reading::createPolarReadings(polarReadings));
+    }
+
+    return readings;
+
+}
+
+/*!
+ * \brief SensorSimulation::readingStreamSample
+ * Waits until the next sample is due (if a stream rate is set) and simulates it. A stream that is polled slower than
+ * the stream rate skips the samples in between, like a sensor that only reports its latest sample.
+ * \param type
+ * \param sample
+ * \return
+ */
+bool SensorSimulation::readingStreamSample(const ReadingTypes &type, RealTimeReading &sample){
+
+    if(!this->isConnected){
+        return false;
+    }
+
+    quint64 index = this->nextStreamSample;
+    if(this->streamRate > 0.0){
+        double period = 1.0e9 / this->streamRate; //[ns]
+        index = qMax(index, (quint64)(this->streamClock.nsecsElapsed() / period));
+        this->waitUntil((qint64)(index * period));
+    }
+    this->nextStreamSample = index + 1;
+
+    return this->simulate(type, 2 * index + 1, sample);
+
+}
+
+/*!
+ * \brief SensorSimulation::getSensorStatus
+ * \return
+ */
+QMap<QString, QString> SensorSimulation::getSensorStatus() const{
+    QMap<QString, QString> status;
+    status.insert("simulated surface", getFeatureTypeName(this->getSurface().getTypeOfFeature()));
+    status.insert("measured readings", QString::number(this->numMeasured));
+    status.insert("stream samples", QString::number(this->nextStreamSample));
+    return status;
+}
+
+/*!
+ * \brief SensorSimulation::performAsyncSensorCommand
+ * The response is emitted before this method returns. It is delivered by the same signals as the responses of
+ * sensors that answer later, so that the asynchronous path of the sensor worker can be tested without hardware.
+ * \param sensor
+ * \param request
+ * \param mConfig
+ * \return
+ */
+QJsonObject SensorSimulation::performAsyncSensorCommand(Sensor &sensor, const QJsonObject &request, const MeasurementConfig &mConfig){
+
+    QJsonObject status;
+    status.insert("status", "accepted");
+
+    QString method = request.value("method").toString();
+    if(method.compare("connect") == 0){
+        this->connectSensor();
+        emit sensor.asyncSensorResponse(createResponse(request, true, "sensor connected"));
+        return status;
+    }
+
+    if(!this->isConnected){
+        emit sensor.asyncSensorResponse(createResponse(request, false, "sensor is not connected"));
+        return status;
+    }
+
+    if(method.compare("disconnect") == 0){
+        this->disconnectSensor();
+        emit sensor.asyncSensorResponse(createResponse(request, true, "sensor disconnected"));
+    }else if(method.compare("measure") == 0){
+        ReadingTypes type = SensorSimulation::getReadingType(sensor.getReadingType(mConfig), sensor.getSupportedReadingTypes());
+        emit sensor.asyncMeasurementResult(request.value("geomId").toInt(), this->measure(type));
+    }else if(method.compare("stream") == 0){
+        ReadingTypes type = SensorSimulation::getReadingType(getReadingTypeEnum(request.value("format").toString()), sensor.getSupportedReadingTypes());
+        RealTimeReading sample;
+        if(this->readingStreamSample(type, sample)){
+            emit sensor.asyncStreamSample(sample);
+        }
+    }else{
+
+        //sensor actions
+        SensorAttributes attributes;
+        SensorFunctions function;
+        if(method.compare("initialize") == 0){
+            function = eInitialize;
+        }else if(method.compare("toggle sight orientation") == 0){
+            function = eToggleSight;
+        }else if(method.compare("move (cartesian)") == 0){
+            function = eMoveXYZ;
+            attributes.moveX = request.value("x").toDouble();
+            attributes.moveY = request.value("y").toDouble();
+            attributes.moveZ = request.value("z").toDouble();
+            attributes.moveIsRelative = false;
+        }else{
+            emit sensor.asyncSensorResponse(createResponse(request, false, QString("unknown method %1").arg(method)));
+            return status;
+        }
+
+        bool success = sensor.accept(function, attributes);
+        emit sensor.asyncSensorResponse(createResponse(request, success, success ? QString("%1 finished").arg(method)
+                                                                                 : QString("%1 not supported").arg(method)));
+
+    }
+
+    return status;
+
+}
+
+/*!
+ * \brief SensorSimulation::simulate
+ * \param type
+ * \param sequence
+ * \param sample
+ * \return false if the reading type or the surface is not supported
+ */
+bool SensorSimulation::simulate(const ReadingTypes &type, const quint64 &sequence, RealTimeReading &sample) const{
+
+    //sample the surface
+    SimulatedNoise noise(this->seed, sequence);
+    Vec3 point, normal;
+    {
+        QMutexLocker locker(&this->surfaceMutex);
+        if(!this->surface.getIsValid()){
+            return false;
+        }
+        double u = noise.uniform();
+        double v = noise.uniform();
+        this->surface.sample(u, v, point, normal);
+    }
+
+    //add the measurement noise
+    sample = RealTimeReading();
+    sample.type = type;
+    switch(type){
+    case ePolarReading:{
+        Vec3 polar = Reading::toPolarVec3(point.x(), point.y(), point.z());
+        sample.polar.azimuth = polar.x() + this->sigmaAzimuth * noise.normal();
+        sample.polar.zenith = polar.y() + this->sigmaZenith * noise.normal();
+        sample.polar.distance = polar.z() + this->sigmaDistance * noise.normal();
+        return true;
+    }
+    case eDirectionReading:{
+        Vec3 polar = Reading::toPolarVec3(point.x(), point.y(), point.z());
+        sample.direction.azimuth = polar.x() + this->sigmaAzimuth * noise.normal();
+        sample.direction.zenith = polar.y() + this->sigmaZenith * noise.normal();
+        return true;
+    }
+    case eDistanceReading:
+        sample.distance.distance = point.length() + this->sigmaDistance * noise.normal();
+        return true;
+    case eCartesianReading:
+        sample.cartesian.x = point.x() + this->sigmaX * noise.normal();
+        sample.cartesian.y = point.y() + this->sigmaY * noise.normal();
+        sample.cartesian.z = point.z() + this->sigmaZ * noise.normal();
+        return true;
+    case eCartesianReading6D:
+        sample.cartesian6D.x = point.x() + this->sigmaX * noise.normal();
+        sample.cartesian6D.y = point.y() + this->sigmaY * noise.normal();
+        sample.cartesian6D.z = point.z() + this->sigmaZ * noise.normal();
+        sample.cartesian6D.i = normal.x();
+        sample.cartesian6D.j = normal.y();
+        sample.cartesian6D.k = normal.z();
+        return true;
+    default:
+        sample.type = eUndefinedReading;
+        return false;
+    }
+
+}
+
+/*!
+ * \brief SensorSimulation::waitUntil
+ * Sleeps (or yields for the last millisecond) until the stream clock reaches the given time [ns]
+ * \param time
+ */
+void SensorSimulation::waitUntil(const qint64 &time) const{
+    forever{
+        qint64 remaining = time - this->streamClock.nsecsElapsed();
+        if(remaining <= 0){
+            return;
+        }
+        if(remaining > 2000000){
+            QThread::usleep((remaining - 1000000) / 1000);
+        }else{
+            QThread::yieldCurrentThread();
+        }
+    }
+}
+
+/*!
+ * \brief SimulatedLaserTracker::SimulatedLaserTracker
+ * \param parent
+ */
+SimulatedLaserTracker::SimulatedLaserTracker(QObject *parent) : LaserTracker(parent){
+
+    //meta information
+    this->metaData.name = "Simulated Laser Tracker";
+    this->metaData.pluginName = "OpenIndy";
+    this->metaData.description = "Laser tracker that measures a simulated surface";
+    this->supportedReadingTypes << ePolarReading << eCartesianReading << eCartesianReading6D << eDirectionReading << eDistanceReading;
+    this->supportedConnectionTypes << eNetworkConnection;
+    this->supportedSensorActions << eMoveAngle << eMoveXYZ << eMotorState << eToggleSight << eInitialize
+                                 << eHome << eCompensation << eSearch;
+    SensorSimulation::addParameters(this->integerParameters, this->doubleParameters);
+    foreach(const ReadingTypes &type, this->supportedReadingTypes){
+        this->stringParameters.insert("reading type", getReadingTypeName(type));
+    }
+
+    //typical accuracy of a laser tracker
+    this->defaultAccuracy.sigmaAzimuth = 2.5e-6;
+    this->defaultAccuracy.sigmaZenith = 2.5e-6;
+    this->defaultAccuracy.sigmaDistance = 1.0e-5;
+    Vec3(1.5e-5, 1.5e-5, 1.5e-5).assignTo(this->defaultAccuracy.sigmaXyz);
+
+    SensorConfiguration sConfig;
+    sConfig.setTypeOfSensor(eLaserTracker);
+    sConfig.setAccuracy(this->defaultAccuracy);
+    sConfig.setIntegerParameter(this->integerParameters);
+    sConfig.setDoubleParameter(this->doubleParameters);
+    sConfig.setAvailableStringParameter(this->stringParameters);
+    QMap<QString, QString> stringParameter;
+    stringParameter.insert("reading type", getReadingTypeName(ePolarReading));
+    sConfig.setStringParameter(stringParameter);
+    this->setSensorConfiguration(sConfig);
+
+}
+
+/*!
+ * \brief SimulatedLaserTracker::getSurface
+ * \return
+ */
+SimulatedSurface SimulatedLaserTracker::getSurface() const{
+    return this->simulation.getSurface();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::setSurface
+ * \param surface
+ */
+void SimulatedLaserTracker::setSurface(const SimulatedSurface &surface){
+    this->simulation.setSurface(surface);
+}
+
+/*!
+ * \brief SimulatedLaserTracker::setSensorConfiguration
+ * \param sConfig
+ */
+void SimulatedLaserTracker::setSensorConfiguration(const SensorConfiguration &sConfig){
+    LaserTracker::setSensorConfiguration(sConfig);
+    this->simulation.configure(sConfig);
+}
+
+/*!
+ * \brief SimulatedLaserTracker::isSensorAsync
+ * \return
+ */
+bool SimulatedLaserTracker::isSensorAsync() const{
+    return this->simulation.getIsAsync();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::performAsyncSensorCommand
+ * \param request
+ * \return
+ */
+QJsonObject SimulatedLaserTracker::performAsyncSensorCommand(const QJsonObject &request){
+    return this->simulation.performAsyncSensorCommand(*this, request, this->actualMeasurementConfig);
+}
+
+/*!
+ * \brief SimulatedLaserTracker::abortAction
+ * \return
+ */
+bool SimulatedLaserTracker::abortAction(){
+    return true;
+}
+
+/*!
+ * \brief SimulatedLaserTracker::connectSensor
+ * \return
+ */
+bool SimulatedLaserTracker::connectSensor(){
+    return this->simulation.connectSensor();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::disconnectSensor
+ * \return
+ */
+bool SimulatedLaserTracker::disconnectSensor(){
+    return this->simulation.disconnectSensor();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::measure
+ * \param mConfig
+ * \return
+ */
+QList<QPointer<Reading> > SimulatedLaserTracker::measure(const MeasurementConfig &mConfig){
+    return this->simulation.measure(SensorSimulation::getReadingType(this->getReadingType(mConfig), this->supportedReadingTypes));
+}
+
+/*!
+ * \brief SimulatedLaserTracker::readingStream
+ * \param streamFormat
+ * \return
+ */
+QVariantMap SimulatedLaserTracker::readingStream(const ReadingTypes &streamFormat){
+    RealTimeReading sample;
+    if(!this->readingStreamSample(streamFormat, sample)){
+        return QVariantMap();
+    }
+    return sample.toVariantMap();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::isReadingStreamTyped
+ * \return
+ */
+bool SimulatedLaserTracker::isReadingStreamTyped() const{
+    return true;
+}
+
+/*!
+ * \brief SimulatedLaserTracker::readingStreamSample
+ * \param streamFormat
+ * \param sample
+ * \return
+ */
+bool SimulatedLaserTracker::readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample){
+    return this->simulation.readingStreamSample(SensorSimulation::getReadingType(streamFormat, this->supportedReadingTypes), sample);
+}
+
+/*!
+ * \brief SimulatedLaserTracker::getConnectionState
+ * \return
+ */
+bool SimulatedLaserTracker::getConnectionState(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::getIsReadyForMeasurement
+ * \return
+ */
+bool SimulatedLaserTracker::getIsReadyForMeasurement(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::getIsBusy
+ * \return
+ */
+bool SimulatedLaserTracker::getIsBusy(){
+    return false;
+}
+
+/*!
+ * \brief SimulatedLaserTracker::getSensorStatus
+ * \return
+ */
+QMap<QString, QString> SimulatedLaserTracker::getSensorStatus(){
+    return this->simulation.getSensorStatus();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::initialize
+ * \return
+ */
+bool SimulatedLaserTracker::initialize(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::move
+ * \param azimuth
+ * \param zenith
+ * \param distance
+ * \param isRelative
+ * \return
+ */
+bool SimulatedLaserTracker::move(const double &azimuth, const double &zenith, const double &distance, const bool &isRelative){
+    Q_UNUSED(azimuth);
+    Q_UNUSED(zenith);
+    Q_UNUSED(distance);
+    Q_UNUSED(isRelative);
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::move
+ * \param x
+ * \param y
+ * \param z
+ * \return
+ */
+bool SimulatedLaserTracker::move(const double &x, const double &y, const double &z){
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(z);
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::home
+ * \return
+ */
+bool SimulatedLaserTracker::home(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::changeMotorState
+ * \return
+ */
+bool SimulatedLaserTracker::changeMotorState(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::toggleSightOrientation
+ * \return
+ */
+bool SimulatedLaserTracker::toggleSightOrientation(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::compensation
+ * \return
+ */
+bool SimulatedLaserTracker::compensation(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedLaserTracker::search
+ * \return
+ */
+bool SimulatedLaserTracker::search(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedTotalStation::SimulatedTotalStation
+ * \param parent
+ */
+SimulatedTotalStation::SimulatedTotalStation(QObject *parent) : TotalStation(parent){
+
+    //meta information
+    this->metaData.name = "Simulated Total Station";
+    this->metaData.pluginName = "OpenIndy";
+    this->metaData.description = "Total station that measures a simulated surface";
+    this->supportedReadingTypes << ePolarReading << eCartesianReading << eDirectionReading << eDistanceReading;
+    this->supportedConnectionTypes << eSerialConnection;
+    this->supportedSensorActions << eMoveAngle << eMoveXYZ << eToggleSight;
+    SensorSimulation::addParameters(this->integerParameters, this->doubleParameters);
+    foreach(const ReadingTypes &type, this->supportedReadingTypes){
+        this->stringParameters.insert("reading type", getReadingTypeName(type));
+    }
+
+    //typical accuracy of a total station
+    this->defaultAccuracy.sigmaAzimuth = 5.0e-6;
+    this->defaultAccuracy.sigmaZenith = 5.0e-6;
+    this->defaultAccuracy.sigmaDistance = 1.0e-3;
+    Vec3(1.0e-3, 1.0e-3, 1.0e-3).assignTo(this->defaultAccuracy.sigmaXyz);
+
+    SensorConfiguration sConfig;
+    sConfig.setTypeOfSensor(eTotalStation);
+    sConfig.setAccuracy(this->defaultAccuracy);
+    sConfig.setIntegerParameter(this->integerParameters);
+    sConfig.setDoubleParameter(this->doubleParameters);
+    sConfig.setAvailableStringParameter(this->stringParameters);
+    QMap<QString, QString> stringParameter;
+    stringParameter.insert("reading type", getReadingTypeName(ePolarReading));
+    sConfig.setStringParameter(stringParameter);
+    this->setSensorConfiguration(sConfig);
+
+}
+
+/*!
+ * \brief SimulatedTotalStation::getSurface
+ * \return
+ */
+SimulatedSurface SimulatedTotalStation::getSurface() const{
+    return this->simulation.getSurface();
+}
+
+/*!
+ * \brief SimulatedTotalStation::setSurface
+ * \param surface
+ */
+void SimulatedTotalStation::setSurface(const SimulatedSurface &surface){
+    this->simulation.setSurface(surface);
+}
+
+/*!
+ * \brief SimulatedTotalStation::setSensorConfiguration
+ * \param sConfig
+ */
+void SimulatedTotalStation::setSensorConfiguration(const SensorConfiguration &sConfig){
+    TotalStation::setSensorConfiguration(sConfig);
+    this->simulation.configure(sConfig);
+}
+
+/*!
+ * \brief SimulatedTotalStation::isSensorAsync
+ * \return
+ */
+bool SimulatedTotalStation::isSensorAsync() const{
+    return this->simulation.getIsAsync();
+}
+
+/*!
+ * \brief SimulatedTotalStation::performAsyncSensorCommand
+ * \param request
+ * \return
+ */
+QJsonObject SimulatedTotalStation::performAsyncSensorCommand(const QJsonObject &request){
+    return this->simulation.performAsyncSensorCommand(*this, request, this->actualMeasurementConfig);
+}
+
+/*!
+ * \brief SimulatedTotalStation::abortAction
+ * \return
+ */
+bool SimulatedTotalStation::abortAction(){
+    return true;
+}
+
+/*!
+ * \brief SimulatedTotalStation::connectSensor
+ * \return
+ */
+bool SimulatedTotalStation::connectSensor(){
+    return this->simulation.connectSensor();
+}
+
+/*!
+ * \brief SimulatedTotalStation::disconnectSensor
+ * \return
+ */
+bool SimulatedTotalStation::disconnectSensor(){
+    return this->simulation.disconnectSensor();
+}
+
+/*!
+ * \brief SimulatedTotalStation::measure
+ * \param mConfig
+ * \return
+ */
+QList<QPointer<Reading> > SimulatedTotalStation::measure(const MeasurementConfig &mConfig){
+    return this->simulation.measure(SensorSimulation::getReadingType(this->getReadingType(mConfig), this->supportedReadingTypes));
+}
+
+/*!
+ * \brief SimulatedTotalStation::readingStream
+ * \param streamFormat
+ * \return
+ */
+QVariantMap SimulatedTotalStation::readingStream(const ReadingTypes &streamFormat){
+    RealTimeReading sample;
+    if(!this->readingStreamSample(streamFormat, sample)){
+        return QVariantMap();
+    }
+    return sample.toVariantMap();
+}
+
+/*!
+ * \brief SimulatedTotalStation::isReadingStreamTyped
+ * \return
+ */
+bool SimulatedTotalStation::isReadingStreamTyped() const{
+    return true;
+}
+
+/*!
+ * \brief SimulatedTotalStation::readingStreamSample
+ * \param streamFormat
+ * \param sample
+ * \return
+ */
+bool SimulatedTotalStation::readingStreamSample(const ReadingTypes &streamFormat, RealTimeReading &sample){
+    return this->simulation.readingStreamSample(SensorSimulation::getReadingType(streamFormat, this->supportedReadingTypes), sample);
+}
+
+/*!
+ * \brief SimulatedTotalStation::getConnectionState
+ * \return
+ */
+bool SimulatedTotalStation::getConnectionState(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedTotalStation::getIsReadyForMeasurement
+ * \return
+ */
+bool SimulatedTotalStation::getIsReadyForMeasurement(){
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedTotalStation::getIsBusy
+ * \return
+ */
+bool SimulatedTotalStation::getIsBusy(){
+    return false;
+}
+
+/*!
+ * \brief SimulatedTotalStation::getSensorStatus
+ * \return
+ */
+QMap<QString, QString> SimulatedTotalStation::getSensorStatus(){
+    return this->simulation.getSensorStatus();
+}
+
+/*!
+ * \brief SimulatedTotalStation::move
+ * \param azimuth
+ * \param zenith
+ * \param distance
+ * \param isRelative
+ * \return
+ */
+bool SimulatedTotalStation::move(const double &azimuth, const double &zenith, const double &distance, const bool &isRelative){
+    Q_UNUSED(azimuth);
+    Q_UNUSED(zenith);
+    Q_UNUSED(distance);
+    Q_UNUSED(isRelative);
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedTotalStation::move
+ * \param x
+ * \param y
+ * \param z
+ * \return
+ */
+bool SimulatedTotalStation::move(const double &x, const double &y, const double &z){
+    Q_UNUSED(x);
+    Q_UNUSED(y);
+    Q_UNUSED(z);
+    return this->simulation.getIsConnected();
+}
+
+/*!
+ * \brief SimulatedTotalStation::toggleSightOrientation
+ * \return
+ */
+bool SimulatedTotalStation::toggleSightOrientation(){
+    return this->simulation.getIsConnected();
+}
@@ -9,14 +9,14 @@ using namespace oi::math;
  */
 Position::Position(QObject *parent) : Element(parent){
     this->xyz = OiVec(3);
-    this->xyzH = OiVec(3);
-    this->xyzH.add(1.0);
+    this->xyzH = OiVec(4);
+    this->xyzH.setAt(3, 1.0);
 }
 
 Position::Position(bool isNullObject, QObject *parent) : Element(parent){
     this->xyz = OiVec(3);
-    this->xyzH = OiVec(3);
-    this->xyzH.add(1.0);
+    this->xyzH = OiVec(4);
+    this->xyzH.setAt(3, 1.0);
     this->isNullObject = isNullObject;
 }
 
@@ -28,20 +28,29 @@ Position::Position(bool isNullObject, QObject *parent) : Element(parent){
 Position::Position(const OiVec &v, QObject *parent) : Element(parent){
     if(v.getSize() == 3){
         this->xyz = v;
-        this->xyzH = v;
-        this->xyzH.add(1.0);
+        Vec4(Vec3(v), 1.0).assignTo(this->xyzH);
     }else if(v.getSize() == 4){
-        this->xyz.add(v.getAt(0) / v.getAt(3));
-        this->xyz.add(v.getAt(1) / v.getAt(3));
-        this->xyz.add(v.getAt(2) / v.getAt(3));
+        this->xyz = OiVec(3);
+        this->xyz.setAt(0, v.getAt(0) / v.getAt(3));
+        this->xyz.setAt(1, v.getAt(1) / v.getAt(3));
+        this->xyz.setAt(2, v.getAt(2) / v.getAt(3));
         this->xyzH = v;
     }else{
         this->xyz = OiVec(3);
-        this->xyzH = OiVec(3);
-        this->xyzH.add(1.0);
+        this->xyzH = OiVec(4);
+        this->xyzH.setAt(3, 1.0);
     }
 }
 
+/*!
+ * \brief Position::Position
+ * \param v
+ * \param parent
+ */
+Position::Position(const Vec3 &v, QObject *parent) : Element(parent), xyz(3), xyzH(4){
+    this->setVector(v);
+}
+
 /*!
  * \brief Position::Position
  * \param x
@@ -49,14 +58,8 @@ Position::Position(const OiVec &v, QObject *parent) : Element(parent){
  * \param z
  * \param parent
  */
-Position::Position(const double &x, const double &y, const double &z, const double &h, QObject *parent) : Element(parent){
-    this->xyz.add(x / h);
-    this->xyz.add(y / h);
-    this->xyz.add(z / h);
-    this->xyzH.add(x);
-    this->xyzH.add(y);
-    this->xyzH.add(z);
-    this->xyzH.add(h);
+Position::Position(const double &x, const double &y, const double &z, const double &h, QObject *parent) : Element(parent), xyz(3), xyzH(4){
+    this->setVector(x, y, z, h);
 }
 
 /*!
@@ -143,4 +146,22 @@ const OiVec &Position::getVectorH() const{
     return this->xyzH;
 }
 
+/*!
+ * \brief Position::setVector
+ * Sets the vector in place without reallocating the OiVec members
+ * \param v
+ */
+void Position::setVector(const Vec3 &v){
+    v.assignTo(this->xyz);
+    Vec4(v, 1.0).assignTo(this->xyzH);
+}
+
+/*!
+ * \brief Position::getVec3
+ * \return
+ */
+Vec3 Position::getVec3() const{
+    return Vec3(this->xyz);
+}
+
 const Position Position::NullObject = Position(true);
@@ -1,16 +1,362 @@
 #include "reading.h"
 
+#include <new>
+
 #include "observation.h"
 #include "sensor.h"
+#include "readingconversion.h"
 
 using namespace oi;
 using namespace oi::math;
 
+namespace{
+
+template <class T>
+void constructValue(T &value, const T *copy){
+    if(copy != NULL){
+        new (&value) T(*copy);
+    }else{
+        new (&value) T();
+    }
+}
+
+template <class T>
+void destroyValue(T &value){
+    value.~T();
+}
+
+}
+
+/*!
+ * \brief ReadingVariant::ReadingVariant
+ */
+ReadingVariant::ReadingVariant(){
+    this->construct(eUndefinedReading, NULL);
+}
+
+/*!
+ * \brief ReadingVariant::ReadingVariant
+ * \param type
+ */
+ReadingVariant::ReadingVariant(const ReadingTypes &type){
+    this->construct(type, NULL);
+}
+
+/*!
+ * \brief ReadingVariant::ReadingVariant
+ * \param copy
+ */
+ReadingVariant::ReadingVariant(const ReadingVariant &copy){
+    this->construct(copy.type, &copy);
+}
+
+/*!
+ * \brief ReadingVariant::operator =
+ * \param copy
+ * \return
+ */
+ReadingVariant &ReadingVariant::operator=(const ReadingVariant &copy){
+    if(this != &copy){
+        this->destroy();
+        this->construct(copy.type, &copy);
+    }
+    return *this;
+}
+
+/*!
+ * \brief ReadingVariant::~ReadingVariant
+ */
+ReadingVariant::~ReadingVariant(){
+    this->destroy();
+}
+
+/*!
+ * \brief ReadingVariant::getType
+ * \return
+ */
+const ReadingTypes &ReadingVariant::getType() const{
+    return this->type;
+}
+
+/*!
+ * \brief ReadingVariant::setType
+ * Switches to the given type. The reading of the new type is invalid.
+ * \param type
+ */
+void ReadingVariant::setType(const ReadingTypes &type){
+    this->destroy();
+    this->construct(type, NULL);
+}
+
+/*!
+ * \brief ReadingVariant::getPolar
+ * \return
+ */
+const ReadingPolar &ReadingVariant::getPolar() const{
+    if(this->type == ePolarReading){
+        return this->payload.polar.polar;
+    }
+    static const ReadingPolar invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getCartesian
+ * \return
+ */
+const ReadingCartesian &ReadingVariant::getCartesian() const{
+    if(this->type == ePolarReading){
+        return this->payload.polar.cartesian;
+    }else if(this->type == eCartesianReading){
+        return this->payload.cartesian;
+    }
+    static const ReadingCartesian invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getCartesian6D
+ * \return
+ */
+const ReadingCartesian6D &ReadingVariant::getCartesian6D() const{
+    if(this->type == eCartesianReading6D){
+        return this->payload.cartesian6D;
+    }
+    static const ReadingCartesian6D invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getDirection
+ * \return
+ */
+const ReadingDirection &ReadingVariant::getDirection() const{
+    if(this->type == eDirectionReading){
+        return this->payload.direction;
+    }
+    static const ReadingDirection invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getDistance
+ * \return
+ */
+const ReadingDistance &ReadingVariant::getDistance() const{
+    if(this->type == eDistanceReading){
+        return this->payload.distance;
+    }
+    static const ReadingDistance invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getTemperature
+ * \return
+ */
+const ReadingTemperature &ReadingVariant::getTemperature() const{
+    if(this->type == eTemperatureReading){
+        return this->payload.temperature;
+    }
+    static const ReadingTemperature invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getLevel
+ * \return
+ */
+const ReadingLevel &ReadingVariant::getLevel() const{
+    if(this->type == eLevelReading){
+        return this->payload.level;
+    }
+    static const ReadingLevel invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::getUndefined
+ * \return
+ */
+const ReadingUndefined &ReadingVariant::getUndefined() const{
+    if(this->type == eUndefinedReading){
+        return this->payload.undefined;
+    }
+    static const ReadingUndefined invalid;
+    return invalid;
+}
+
+/*!
+ * \brief ReadingVariant::modifyPolar
+ * \return
+ */
+ReadingPolar &ReadingVariant::modifyPolar(){
+    if(this->type != ePolarReading){
+        this->setType(ePolarReading);
+    }
+    return this->payload.polar.polar;
+}
+
+/*!
+ * \brief ReadingVariant::modifyCartesian
+ * Returns the cartesian conversion of a polar reading or the cartesian reading itself
+ * \return
+ */
+ReadingCartesian &ReadingVariant::modifyCartesian(){
+    if(this->type == ePolarReading){
+        return this->payload.polar.cartesian;
+    }else if(this->type != eCartesianReading){
+        this->setType(eCartesianReading);
+    }
+    return this->payload.cartesian;
+}
+
+/*!
+ * \brief ReadingVariant::modifyCartesian6D
+ * \return
+ */
+ReadingCartesian6D &ReadingVariant::modifyCartesian6D(){
+    if(this->type != eCartesianReading6D){
+        this->setType(eCartesianReading6D);
+    }
+    return this->payload.cartesian6D;
+}
+
+/*!
+ * \brief ReadingVariant::modifyDirection
+ * \return
+ */
+ReadingDirection &ReadingVariant::modifyDirection(){
+    if(this->type != eDirectionReading){
+        this->setType(eDirectionReading);
+    }
+    return this->payload.direction;
+}
+
+/*!
+ * \brief ReadingVariant::modifyDistance
+ * \return
+ */
+ReadingDistance &ReadingVariant::modifyDistance(){
+    if(this->type != eDistanceReading){
+        this->setType(eDistanceReading);
+    }
+    return this->payload.distance;
+}
+
+/*!
+ * \brief ReadingVariant::modifyTemperature
+ * \return
+ */
+ReadingTemperature &ReadingVariant::modifyTemperature(){
+    if(this->type != eTemperatureReading){
+        this->setType(eTemperatureReading);
+    }
+    return this->payload.temperature;
+}
+
+/*!
+ * \brief ReadingVariant::modifyLevel
+ * \return
+ */
+ReadingLevel &ReadingVariant::modifyLevel(){
+    if(this->type != eLevelReading){
+        this->setType(eLevelReading);
+    }
+    return this->payload.level;
+}
+
+/*!
+ * \brief ReadingVariant::modifyUndefined
+ * \return
+ */
+ReadingUndefined &ReadingVariant::modifyUndefined(){
+    if(this->type != eUndefinedReading){
+        this->setType(eUndefinedReading);
+    }
+    return this->payload.undefined;
+}
+
+/*!
+ * \brief ReadingVariant::construct
+ * Constructs the reading of the given type in place (as a copy of the reading of copy if specified)
+ * \param type
+ * \param copy
+ */
+void ReadingVariant::construct(const ReadingTypes &type, const ReadingVariant *copy){
+
+    switch(type){
+    case ePolarReading:
+        constructValue(this->payload.polar, copy != NULL ? &copy->payload.polar : NULL);
+        break;
+    case eCartesianReading:
+        constructValue(this->payload.cartesian, copy != NULL ? &copy->payload.cartesian : NULL);
+        break;
+    case eCartesianReading6D:
+        constructValue(this->payload.cartesian6D, copy != NULL ? &copy->payload.cartesian6D : NULL);
+        break;
+    case eDirectionReading:
+        constructValue(this->payload.direction, copy != NULL ? &copy->payload.direction : NULL);
+        break;
+    case eDistanceReading:
+        constructValue(this->payload.distance, copy != NULL ? &copy->payload.distance : NULL);
+        break;
+    case eTemperatureReading:
+        constructValue(this->payload.temperature, copy != NULL ? &copy->payload.temperature : NULL);
+        break;
+    case eLevelReading:
+        constructValue(this->payload.level, copy != NULL ? &copy->payload.level : NULL);
+        break;
+    case eUndefinedReading:
+    default:
+        //unknown types (e.g. from corrupt files) are undefined readings
+        constructValue(this->payload.undefined, copy != NULL ? &copy->payload.undefined : NULL);
+        this->type = eUndefinedReading;
+        return;
+    }
+    this->type = type;
+
+}
+
+/*!
+ * \brief ReadingVariant::destroy
+ */
+void ReadingVariant::destroy(){
+
+    switch(this->type){
+    case ePolarReading:
+        destroyValue(this->payload.polar);
+        break;
+    case eCartesianReading:
+        destroyValue(this->payload.cartesian);
+        break;
+    case eCartesianReading6D:
+        destroyValue(this->payload.cartesian6D);
+        break;
+    case eDirectionReading:
+        destroyValue(this->payload.direction);
+        break;
+    case eDistanceReading:
+        destroyValue(this->payload.distance);
+        break;
+    case eTemperatureReading:
+        destroyValue(this->payload.temperature);
+        break;
+    case eLevelReading:
+        destroyValue(this->payload.level);
+        break;
+    case eUndefinedReading:
+        destroyValue(this->payload.undefined);
+        break;
+    }
+
+}
+
 /*!
  * \brief Reading::Reading
  * \param parent
  */
-Reading::Reading(QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -23,13 +369,13 @@ Reading::Reading(QObject *parent) : Element(parent), hasBackup(false){
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingPolar &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingPolar &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading and transform into cartesian
-    this->typeOfReading = ePolarReading;
-    this->rPolar = reading;
+    this->variant.setType(ePolarReading);
+    this->variant.modifyPolar() = reading;
     this->toCartesian();
-    this->rCartesian.sigmaXyz = this->errorPropagationPolarToCartesian();
+    this->errorPropagationPolarToCartesian().assignTo(this->variant.modifyCartesian().sigmaXyz);
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -43,16 +389,16 @@ Reading::Reading(const ReadingPolar &reading, QObject *parent) : Element(parent)
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingCartesian &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingCartesian &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     if(reading.xyz.getSize() != 3 || reading.sigmaXyz.getSize() != 3){
-        this->typeOfReading = eCartesianReading;
+        this->variant.setType(eCartesianReading);
         return;
     }
 
     //set the reading and transform into polar
-    this->typeOfReading = eCartesianReading;
-    this->rCartesian = reading;
+    this->variant.setType(eCartesianReading);
+    this->variant.modifyCartesian() = reading;
     this->toPolar();
 
     //set default attributes
@@ -61,16 +407,16 @@ Reading::Reading(const ReadingCartesian &reading, QObject *parent) : Element(par
     this->imported = false;
 
 }
-Reading::Reading(const ReadingCartesian6D &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingCartesian6D &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     if(reading.xyz.getSize() != 3 || reading.ijk.getSize() != 3 || reading.sigmaXyz.getSize() != 3){
-        this->typeOfReading = eCartesianReading6D;
+        this->variant.setType(eCartesianReading6D);
         return;
     }
 
     //set the reading and transform into polar
-    this->typeOfReading = eCartesianReading6D;
-    this->rCartesian6D = reading;
+    this->variant.setType(eCartesianReading6D);
+    this->variant.modifyCartesian6D() = reading;
     this->toPolar();
 
     //set default attributes
@@ -84,11 +430,11 @@ Reading::Reading(const ReadingCartesian6D &reading, QObject *parent) : Element(p
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingDirection &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingDirection &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading
-    this->typeOfReading = eDirectionReading;
-    this->rDirection = reading;
+    this->variant.setType(eDirectionReading);
+    this->variant.modifyDirection() = reading;
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -102,11 +448,11 @@ Reading::Reading(const ReadingDirection &reading, QObject *parent) : Element(par
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingDistance &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingDistance &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading and
-    this->typeOfReading = eDistanceReading;
-    this->rDistance = reading;
+    this->variant.setType(eDistanceReading);
+    this->variant.modifyDistance() = reading;
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -120,11 +466,11 @@ Reading::Reading(const ReadingDistance &reading, QObject *parent) : Element(pare
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingTemperature &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingTemperature &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading
-    this->typeOfReading = eTemperatureReading;
-    this->rTemperature = reading;
+    this->variant.setType(eTemperatureReading);
+    this->variant.modifyTemperature() = reading;
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -138,11 +484,11 @@ Reading::Reading(const ReadingTemperature &reading, QObject *parent) : Element(p
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingLevel &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingLevel &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading
-    this->typeOfReading = eLevelReading;
-    this->rLevel = reading;
+    this->variant.setType(eLevelReading);
+    this->variant.modifyLevel() = reading;
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -156,11 +502,11 @@ Reading::Reading(const ReadingLevel &reading, QObject *parent) : Element(parent)
  * \param reading
  * \param parent
  */
-Reading::Reading(const ReadingUndefined &reading, QObject *parent) : Element(parent), hasBackup(false){
+Reading::Reading(const ReadingUndefined &reading, QObject *parent) : Element(parent), acquisitionTime(0){
 
     //set the reading
-    this->typeOfReading = eUndefinedReading;
-    this->rUndefined = reading;
+    this->variant.setType(eUndefinedReading);
+    this->variant.modifyUndefined() = reading;
 
     //set default attributes
     this->measuredAt = QDateTime::currentDateTime();
@@ -178,29 +524,16 @@ Reading::Reading(const Reading &copy, QObject *parent) : Element(copy, parent){
 
     //copy reading attributes
     this->measuredAt = copy.measuredAt;
+    this->acquisitionTime = copy.acquisitionTime;
     this->mConfig = copy.mConfig;
     this->face = copy.face;
     this->sConfig = copy.sConfig;
     this->observation = copy.observation;
-    this->hasBackup = copy.hasBackup;
     this->imported = copy.imported;
 
     //copy readings
-    this->typeOfReading = copy.typeOfReading;
-    this->rPolar = copy.rPolar;
-    this->backupPolar = copy.backupPolar;
-    this->rCartesian = copy.rCartesian;
-    this->backupCartesian = copy.backupCartesian;
-    this->rDirection = copy.rDirection;
-    this->backupDirection = copy.backupDirection;
-    this->rDistance = copy.rDistance;
-    this->backupDistance = copy.backupDistance;
-    this->rTemperature = copy.rTemperature;
-    this->backupTemperature = copy.backupTemperature;
-    this->rLevel = copy.rLevel;
-    this->backupLevel = copy.backupLevel;
-    this->rUndefined = copy.rUndefined;
-    this->backupUndefined = copy.backupUndefined;
+    this->variant = copy.variant;
+    this->backup.reset(copy.backup.isNull() ? NULL : new ReadingVariant(*copy.backup));
 
 }
 
@@ -213,29 +546,16 @@ Reading &Reading::operator=(const Reading &copy){
 
     //copy reading attributes
     this->measuredAt = copy.measuredAt;
+    this->acquisitionTime = copy.acquisitionTime;
     this->mConfig = copy.mConfig;
     this->face = copy.face;
     this->sConfig = copy.sConfig;
     this->observation = copy.observation;
-    this->hasBackup = copy.hasBackup;
     this->imported = copy.imported;
 
     //copy readings
-    this->typeOfReading = copy.typeOfReading;
-    this->rPolar = copy.rPolar;
-    this->backupPolar = copy.backupPolar;
-    this->rCartesian = copy.rCartesian;
-    this->backupCartesian = copy.backupCartesian;
-    this->rDirection = copy.rDirection;
-    this->backupDirection = copy.backupDirection;
-    this->rDistance = copy.rDistance;
-    this->backupDistance = copy.backupDistance;
-    this->rTemperature = copy.rTemperature;
-    this->backupTemperature = copy.backupTemperature;
-    this->rLevel = copy.rLevel;
-    this->backupLevel = copy.backupLevel;
-    this->rUndefined = copy.rUndefined;
-    this->backupUndefined = copy.backupUndefined;
+    this->variant = copy.variant;
+    this->backup.reset(copy.backup.isNull() ? NULL : new ReadingVariant(*copy.backup));
 
     return *this;
 
@@ -253,7 +573,7 @@ Reading::~Reading(){
  * \return
  */
 const ReadingTypes &Reading::getTypeOfReading() const{
-    return this->typeOfReading;
+    return this->variant.getType();
 }
 
 /*!
@@ -261,7 +581,7 @@ const ReadingTypes &Reading::getTypeOfReading() const{
  * \return
  */
 const ReadingPolar &Reading::getPolarReading() const{
-    return this->rPolar;
+    return this->variant.getPolar();
 }
 
 /*!
@@ -269,11 +589,11 @@ const ReadingPolar &Reading::getPolarReading() const{
  * \return
  */
 const ReadingCartesian &Reading::getCartesianReading() const{
-    return this->rCartesian;
+    return this->variant.getCartesian();
 }
 
 const ReadingCartesian6D &Reading::getCartesianReading6D() const{
-    return this->rCartesian6D;
+    return this->variant.getCartesian6D();
 }
 
 /*!
@@ -281,7 +601,7 @@ const ReadingCartesian6D &Reading::getCartesianReading6D() const{
  * \return
  */
 const ReadingDirection &Reading::getDirectionReading() const{
-    return this->rDirection;
+    return this->variant.getDirection();
 }
 
 /*!
@@ -289,7 +609,7 @@ const ReadingDirection &Reading::getDirectionReading() const{
  * \return
  */
 const ReadingDistance &Reading::getDistanceReading() const{
-    return this->rDistance;
+    return this->variant.getDistance();
 }
 
 /*!
@@ -297,7 +617,7 @@ const ReadingDistance &Reading::getDistanceReading() const{
  * \return
  */
 const ReadingTemperature &Reading::getTemperatureReading() const{
-    return this->rTemperature;
+    return this->variant.getTemperature();
 }
 
 /*!
@@ -305,7 +625,7 @@ const ReadingTemperature &Reading::getTemperatureReading() const{
  * \return
  */
 const ReadingLevel &Reading::getLevelReading() const{
-    return this->rLevel;
+    return this->variant.getLevel();
 }
 
 /*!
@@ -313,7 +633,7 @@ const ReadingLevel &Reading::getLevelReading() const{
  * \return
  */
 const ReadingUndefined &Reading::getUndefinedReading() const{
-    return this->rUndefined;
+    return this->variant.getUndefined();
 }
 
 /*!
@@ -321,8 +641,8 @@ const ReadingUndefined &Reading::getUndefinedReading() const{
  * \param rPolar
  */
 void Reading::setPolarReading(const ReadingPolar &rPolar){
-    if(this->rPolar.isValid && rPolar.isValid){
-        this->rPolar = rPolar;
+    if(this->variant.getPolar().isValid && rPolar.isValid){
+        this->variant.modifyPolar() = rPolar;
     }
 }
 
@@ -331,15 +651,12 @@ void Reading::setPolarReading(const ReadingPolar &rPolar){
  */
 void Reading::makeBackup(){
 
-    this->backupPolar = this->rPolar;
-    this->backupCartesian = this->rCartesian;
-    this->backupDirection = this->rDirection;
-    this->backupDistance = this->rDistance;
-    this->backupTemperature = this->rTemperature;
-    this->backupUndefined = this->rUndefined;
-    this->backupLevel = this->rLevel;
-
-    this->hasBackup = true;
+    //the backup is only allocated for readings that are used for simulation
+    if(this->backup.isNull()){
+        this->backup.reset(new ReadingVariant(this->variant));
+    }else{
+        *this->backup = this->variant;
+    }
 
 }
 
@@ -349,17 +666,11 @@ void Reading::makeBackup(){
 void Reading::restoreBackup(){
 
     //do not restore backup if no backup was made
-    if(!this->hasBackup){
+    if(this->backup.isNull()){
         return;
     }
 
-    this->rPolar = this->backupPolar;
-    this->rCartesian = this->backupCartesian;
-    this->rDirection = this->backupDirection;
-    this->rDistance = this->backupDistance;
-    this->rTemperature = this->backupTemperature;
-    this->rUndefined = this->backupUndefined;
-    this->rLevel = this->backupLevel;
+    this->variant = *this->backup;
 
 }
 
@@ -372,15 +683,7 @@ void Reading::restoreBackup(){
  * \return
  */
 OiVec Reading::toCartesian(const double &azimuth, const double &zenith, const double &distance){
-
-    OiVec xyz(3);
-
-    xyz.setAt(0, distance * qSin(zenith) * qCos(azimuth) );
-    xyz.setAt(1, distance * qSin(zenith) * qSin(azimuth) );
-    xyz.setAt(2, distance * qCos(zenith) );
-
-    return xyz;
-
+    return Reading::toCartesianVec3(azimuth, zenith, distance).toOiVec();
 }
 
 /*!
@@ -392,18 +695,120 @@ OiVec Reading::toCartesian(const double &azimuth, const double &zenith, const do
  * \return
  */
 OiVec Reading::toPolar(const double &x, const double &y, const double &z){
+    return Reading::toPolarVec3(x, y, z).toOiVec();
+}
 
-    OiVec polar(3);
+/*!
+ * \brief Reading::toCartesianVec3
+ * Same as toCartesian but returns a fixed-size vector (no heap allocation)
+ * \param azimuth
+ * \param zenith
+ * \param distance
+ * \return
+ */
+Vec3 Reading::toCartesianVec3(const double &azimuth, const double &zenith, const double &distance){
+
+    const double sinZenith = qSin(zenith);
+    return Vec3(distance * sinZenith * qCos(azimuth),
+                distance * sinZenith * qSin(azimuth),
+                distance * qCos(zenith));
+
+}
+
+/*!
+ * \brief Reading::toPolarVec3
+ * Same as toPolar but returns a fixed-size vector (no heap allocation)
+ * \param x
+ * \param y
+ * \param z
+ * \return
+ */
+Vec3 Reading::toPolarVec3(const double &x, const double &y, const double &z){
 
     double azimuth = qAtan2(y,x);
     double s = qSqrt(x*x+y*y+z*z);
     double zenith = acos(z/s);
 
-    polar.setAt( 0, azimuth);
-    polar.setAt( 1, zenith);
-    polar.setAt( 2, s);
+    return Vec3(azimuth, zenith, s);
+
+}
+
+/*!
+ * \brief Reading::createPolarReadings
+ * Creates readings for all the given polar readings and converts them into cartesian coordinates at once
+ * (the conversion uses the vectorized kernels of readingconversion.h and is equal to Reading(ReadingPolar)).
+ * Sensors may pass convert = false to leave the conversion to the sensor worker or to OiJob::addMeasurementResults,
+ * which convert all readings of a measurement at once (see convertPolarReadings)
+ * \param readings
+ * \param convert
+ * \return
+ */
+QList<QPointer<Reading> > Reading::createPolarReadings(const QList<ReadingPolar> &readings, const bool &convert){
+
+    //create the readings
+    QList<QPointer<Reading> > result;
+    result.reserve(readings.size());
+    const QDateTime measuredAt = QDateTime::currentDateTime();
+    foreach(const ReadingPolar &rPolar, readings){
+        Reading *reading = new Reading();
+        reading->variant.setType(ePolarReading);
+        reading->variant.modifyPolar() = rPolar;
+        reading->measuredAt = measuredAt;
+        result.append(reading);
+    }
+
+    //convert them into cartesian coordinates
+    if(convert){
+        Reading::convertPolarReadings(result);
+    }
+
+    return result;
 
-    return polar;
+}
+
+/*!
+ * \brief Reading::convertPolarReadings
+ * Converts all valid polar readings of the given list, that have no cartesian conversion yet, into cartesian
+ * coordinates at once (including the standard deviations). All other readings are left untouched.
+ * \param readings
+ */
+void Reading::convertPolarReadings(const QList<QPointer<Reading> > &readings){
+
+    //collect all polar readings that still need to be converted
+    QList<Reading *> unconverted;
+    PolarReadingBatch polar;
+    polar.reserve(readings.size());
+    foreach(const QPointer<Reading> &reading, readings){
+        if(reading.isNull() || reading->variant.getType() != ePolarReading){
+            continue;
+        }
+        const ReadingPolar &rPolar = reading->variant.getPolar();
+        if(!rPolar.isValid || reading->variant.getCartesian().isValid){
+            continue;
+        }
+        polar.append(rPolar.azimuth, rPolar.zenith, rPolar.distance,
+                     rPolar.sigmaAzimuth, rPolar.sigmaZenith, rPolar.sigmaDistance);
+        unconverted.append(reading.data());
+    }
+    if(unconverted.isEmpty()){
+        return;
+    }
+
+    //convert them into cartesian coordinates
+    CartesianReadingBatch cartesian;
+    polarToCartesian(polar, cartesian);
+
+    //set the cartesian part of the readings
+    for(int i = 0; i < unconverted.size(); i++){
+        ReadingCartesian &rCartesian = unconverted.at(i)->variant.modifyCartesian();
+        rCartesian.xyz.setAt(0, cartesian.x.at(i));
+        rCartesian.xyz.setAt(1, cartesian.y.at(i));
+        rCartesian.xyz.setAt(2, cartesian.z.at(i));
+        rCartesian.sigmaXyz.setAt(0, cartesian.sigmaX.at(i));
+        rCartesian.sigmaXyz.setAt(1, cartesian.sigmaY.at(i));
+        rCartesian.sigmaXyz.setAt(2, cartesian.sigmaZ.at(i));
+        rCartesian.isValid = true;
+    }
 
 }
 
@@ -412,7 +817,7 @@ OiVec Reading::toPolar(const double &x, const double &y, const double &z){
  * \return
  */
 const MeasurementConfig &Reading::getMeasurementConfig(){
-    return this->mConfig;
+    return this->mConfig.get();
 }
 
 /*!
@@ -420,8 +825,17 @@ const MeasurementConfig &Reading::getMeasurementConfig(){
  * \param mConfig
  */
 void Reading::setMeasurementConfig(const MeasurementConfig &mConfig){
+    this->setMeasurementConfig(MeasurementConfigHandle::intern(mConfig));
+}
+
+/*!
+ * \brief Reading::setMeasurementConfig
+ * Sets the shared measurement config (use this overload to set the same config for many readings)
+ * \param mConfig
+ */
+void Reading::setMeasurementConfig(const MeasurementConfigHandle &mConfig){
     this->mConfig = mConfig;
-    this->measurementConfigName = mConfig.getName();
+    this->measurementConfigName = mConfig.get().getName();
 }
 
 /*!
@@ -440,6 +854,23 @@ void Reading::setMeasuredAt(const QDateTime &measuredAt){
     this->measuredAt = measuredAt;
 }
 
+/*!
+ * \brief Reading::getAcquisitionTime
+ * Returns the time stamp of the shared monotonic acquisition clock [ns] (0 if the reading was not acquired by a sensor worker)
+ * \return
+ */
+const qint64 &Reading::getAcquisitionTime() const{
+    return this->acquisitionTime;
+}
+
+/*!
+ * \brief Reading::setAcquisitionTime
+ * \param acquisitionTime
+ */
+void Reading::setAcquisitionTime(const qint64 &acquisitionTime){
+    this->acquisitionTime = acquisitionTime;
+}
+
 /*!
  * \brief Reading::getFace
  * \return
@@ -477,7 +908,7 @@ void Reading::setImported(const bool &imported){
  * \return
  */
 const SensorConfiguration &Reading::getSensorConfiguration() const{
-    return this->sConfig;
+    return this->sConfig.get();
 }
 
 /*!
@@ -485,8 +916,17 @@ const SensorConfiguration &Reading::getSensorConfiguration() const{
  * \param sensor
  */
 void Reading::setSensorConfiguration(const SensorConfiguration &sConfig){
+    this->setSensorConfiguration(SensorConfigurationHandle::intern(sConfig));
+}
+
+/*!
+ * \brief Reading::setSensorConfiguration
+ * Sets the shared sensor configuration (use this overload to set the same configuration for many readings)
+ * \param sConfig
+ */
+void Reading::setSensorConfiguration(const SensorConfigurationHandle &sConfig){
     this->sConfig = sConfig;
-    this->sensorConfigName = sConfig.getName();
+    this->sensorConfigName = sConfig.get().getName();
 }
 
 /*!
@@ -509,85 +949,66 @@ void Reading::setObservation(const QPointer<Observation> &observation){
     }
 
     //set observation position and standard deviation
-    if(this->rCartesian.isValid){
+    const ReadingCartesian &rCartesian = this->variant.getCartesian();
+    const ReadingCartesian6D &rCartesian6D = this->variant.getCartesian6D();
+    const ReadingLevel &rLevel = this->variant.getLevel();
+    if(rCartesian.isValid){
 
         //set position
-        observation->originalXyz.setAt(0, this->rCartesian.xyz.getAt(0));
-        observation->originalXyz.setAt(1, this->rCartesian.xyz.getAt(1));
-        observation->originalXyz.setAt(2, this->rCartesian.xyz.getAt(2));
-        observation->originalXyz.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalXyz, rCartesian.xyz.getAt(0), rCartesian.xyz.getAt(1),
+                               rCartesian.xyz.getAt(2), 1.0);
 
         //set standard deviation
-        observation->originalSigmaXyz.setAt(0, this->rCartesian.sigmaXyz.getAt(0));
-        observation->originalSigmaXyz.setAt(1, this->rCartesian.sigmaXyz.getAt(1));
-        observation->originalSigmaXyz.setAt(2, this->rCartesian.sigmaXyz.getAt(2));
-        observation->originalSigmaXyz.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalSigmaXyz, rCartesian.sigmaXyz.getAt(0), rCartesian.sigmaXyz.getAt(1),
+                               rCartesian.sigmaXyz.getAt(2), 1.0);
 
         //set ijk
-        observation->originalIjk.setAt(0, 0.0);
-        observation->originalIjk.setAt(1, 0.0);
-        observation->originalIjk.setAt(2, 0.0);
-        observation->originalIjk.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalIjk, 0.0, 0.0, 0.0, 1.0);
 
         if(this->property("isDummyPoint").isValid()) { // set only if property is available
-            observation->isDummyPoint = this->property("isDummyPoint").toBool();
+            observation->setFlag(ObservationStore::eIsDummyPoint, this->property("isDummyPoint").toBool());
         }
 
         //set observation to valid
-        observation->isValid = true;
+        observation->setFlag(ObservationStore::eIsValid, true);
 
-    } else if(this->rCartesian6D.isValid){
+    } else if(rCartesian6D.isValid){
 
             //set position
-            observation->originalXyz.setAt(0, this->rCartesian6D.xyz.getAt(0));
-            observation->originalXyz.setAt(1, this->rCartesian6D.xyz.getAt(1));
-            observation->originalXyz.setAt(2, this->rCartesian6D.xyz.getAt(2));
-            observation->originalXyz.setAt(3, 1.0);
+            observation->setVector(ObservationStore::eOriginalXyz, rCartesian6D.xyz.getAt(0), rCartesian6D.xyz.getAt(1),
+                                   rCartesian6D.xyz.getAt(2), 1.0);
 
             //set standard deviation
-            observation->originalSigmaXyz.setAt(0, this->rCartesian6D.sigmaXyz.getAt(0));
-            observation->originalSigmaXyz.setAt(1, this->rCartesian6D.sigmaXyz.getAt(1));
-            observation->originalSigmaXyz.setAt(2, this->rCartesian6D.sigmaXyz.getAt(2));
-            observation->originalSigmaXyz.setAt(3, 1.0);
+            observation->setVector(ObservationStore::eOriginalSigmaXyz, rCartesian6D.sigmaXyz.getAt(0), rCartesian6D.sigmaXyz.getAt(1),
+                                   rCartesian6D.sigmaXyz.getAt(2), 1.0);
 
             //set ijk
-            observation->originalIjk.setAt(0, this->rCartesian6D.ijk.getAt(0));
-            observation->originalIjk.setAt(1, this->rCartesian6D.ijk.getAt(1));
-            observation->originalIjk.setAt(2, this->rCartesian6D.ijk.getAt(2));
-            observation->originalIjk.setAt(3, 1.0);
+            observation->setVector(ObservationStore::eOriginalIjk, rCartesian6D.ijk.getAt(0), rCartesian6D.ijk.getAt(1),
+                                   rCartesian6D.ijk.getAt(2), 1.0);
 
             if(this->property("isDummyPoint").isValid()) { // set only if property is available
-                observation->isDummyPoint = this->property("isDummyPoint").toBool();
+                observation->setFlag(ObservationStore::eIsDummyPoint, this->property("isDummyPoint").toBool());
             }
 
             //set observation to valid
-            observation->isValid = true;
+            observation->setFlag(ObservationStore::eIsValid, true);
 
-    }else if(this->rLevel.isValid){
+    }else if(rLevel.isValid){
 
         //set ijk
-        observation->originalIjk.setAt(0, this->rLevel.i);
-        observation->originalIjk.setAt(1, this->rLevel.j);
-        observation->originalIjk.setAt(2, this->rLevel.k);
-        observation->originalIjk.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalIjk, rLevel.i, rLevel.j, rLevel.k, 1.0);
 
         //set standard deviation
-        observation->originalSigmaIjk.setAt(0, this->rLevel.sigmaI);
-        observation->originalSigmaIjk.setAt(1, this->rLevel.sigmaJ);
-        observation->originalSigmaIjk.setAt(2, this->rLevel.sigmaK);
-        observation->originalSigmaIjk.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalSigmaIjk, rLevel.sigmaI, rLevel.sigmaJ, rLevel.sigmaK, 1.0);
 
         //set position
-        observation->originalXyz.setAt(0, 0.0);
-        observation->originalXyz.setAt(1, 0.0);
-        observation->originalXyz.setAt(2, 0.0);
-        observation->originalXyz.setAt(3, 1.0);
+        observation->setVector(ObservationStore::eOriginalXyz, 0.0, 0.0, 0.0, 1.0);
 
         //set observation to valid
-        observation->isValid = true;
+        observation->setFlag(ObservationStore::eIsValid, true);
 
         //set observation direction valid
-        observation->hasDirection = true;
+        observation->setFlag(ObservationStore::eHasDirection, true);
 
     }
 
@@ -610,7 +1031,7 @@ QString Reading::getDisplayId() const{
  * \return
  */
 QString Reading::getDisplayType() const{
-    return getReadingTypeName(this->typeOfReading);
+    return getReadingTypeName(this->variant.getType());
 }
 
 /*!
@@ -661,10 +1082,10 @@ QString Reading::getDisplaySide() const{
  * \return
  */
 QString Reading::getDisplayAzimuth(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.azimuth, type), 'f', digits);
-    }else if(this->rDirection.isValid){
-        return QString::number(convertFromDefault(this->rDirection.azimuth, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().azimuth, type), 'f', digits);
+    }else if(this->variant.getDirection().isValid){
+        return QString::number(convertFromDefault(this->variant.getDirection().azimuth, type), 'f', digits);
     }
     return QString("");
 }
@@ -676,10 +1097,10 @@ QString Reading::getDisplayAzimuth(const UnitType &type, const int &digits) cons
  * \return
  */
 QString Reading::getDisplayZenith(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.zenith, type), 'f', digits);
-    }else if(this->rDirection.isValid){
-        return QString::number(convertFromDefault(this->rDirection.zenith, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().zenith, type), 'f', digits);
+    }else if(this->variant.getDirection().isValid){
+        return QString::number(convertFromDefault(this->variant.getDirection().zenith, type), 'f', digits);
     }
     return QString("");
 }
@@ -691,10 +1112,10 @@ QString Reading::getDisplayZenith(const UnitType &type, const int &digits) const
  * \return
  */
 QString Reading::getDisplayDistance(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.distance, type), 'f', digits);
-    }else if(this->rDistance.isValid){
-        return QString::number(convertFromDefault(this->rDistance.distance, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().distance, type), 'f', digits);
+    }else if(this->variant.getDistance().isValid){
+        return QString::number(convertFromDefault(this->variant.getDistance().distance, type), 'f', digits);
     }
     return QString("");
 }
@@ -706,10 +1127,10 @@ QString Reading::getDisplayDistance(const UnitType &type, const int &digits) con
  * \return
  */
 QString Reading::getDisplayX(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.xyz.getAt(0), type), 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(convertFromDefault(this->rCartesian6D.xyz.getAt(0), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().xyz.getAt(0), type), 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian6D().xyz.getAt(0), type), 'f', digits);
     }
     return QString("");
 }
@@ -721,10 +1142,10 @@ QString Reading::getDisplayX(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Reading::getDisplayY(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.xyz.getAt(1), type), 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(convertFromDefault(this->rCartesian6D.xyz.getAt(1), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().xyz.getAt(1), type), 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian6D().xyz.getAt(1), type), 'f', digits);
     }
     return QString("");
 }
@@ -736,10 +1157,10 @@ QString Reading::getDisplayY(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Reading::getDisplayZ(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.xyz.getAt(2), type), 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(convertFromDefault(this->rCartesian6D.xyz.getAt(2), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().xyz.getAt(2), type), 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian6D().xyz.getAt(2), type), 'f', digits);
     }
     return QString("");
 }
@@ -751,10 +1172,10 @@ QString Reading::getDisplayZ(const UnitType &type, const int &digits) const{
  * \return
  */
 QString Reading::getDisplayI(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(rLevel.i, 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(this->rCartesian6D.ijk.getAt(0), 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().i, 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(this->variant.getCartesian6D().ijk.getAt(0), 'f', digits);
     }
     return QString("");
 }
@@ -766,10 +1187,10 @@ QString Reading::getDisplayI(const int &digits) const{
  * \return
  */
 QString Reading::getDisplayJ(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(this->rLevel.j, 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(this->rCartesian6D.ijk.getAt(1), 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().j, 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(this->variant.getCartesian6D().ijk.getAt(1), 'f', digits);
     }
     return QString("");
 }
@@ -781,10 +1202,10 @@ QString Reading::getDisplayJ(const int &digits) const{
  * \return
  */
 QString Reading::getDisplayK(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(this->rLevel.k, 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(this->rCartesian6D.ijk.getAt(2), 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().k, 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(this->variant.getCartesian6D().ijk.getAt(2), 'f', digits);
     }
     return QString("");
 }
@@ -796,8 +1217,8 @@ QString Reading::getDisplayK(const int &digits) const{
  * \return
  */
 QString Reading::getDisplayTemperature(const UnitType &type, const int &digits) const{
-    if(this->rTemperature.isValid){
-        return QString::number(convertFromDefault(this->rTemperature.temperature, type), 'f', digits);
+    if(this->variant.getTemperature().isValid){
+        return QString::number(convertFromDefault(this->variant.getTemperature().temperature, type), 'f', digits);
     }
     return QString("");
 }
@@ -809,10 +1230,10 @@ QString Reading::getDisplayTemperature(const UnitType &type, const int &digits)
  * \return
  */
 QString Reading::getDisplaySigmaAzimuth(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.sigmaAzimuth, type), 'f', digits);
-    }else if(this->rDirection.isValid){
-        return QString::number(convertFromDefault(this->rDirection.sigmaAzimuth, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().sigmaAzimuth, type), 'f', digits);
+    }else if(this->variant.getDirection().isValid){
+        return QString::number(convertFromDefault(this->variant.getDirection().sigmaAzimuth, type), 'f', digits);
     }
     return QString("");
 }
@@ -824,10 +1245,10 @@ QString Reading::getDisplaySigmaAzimuth(const UnitType &type, const int &digits)
  * \return
  */
 QString Reading::getDisplaySigmaZenith(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.sigmaZenith, type), 'f', digits);
-    }else if(this->rDirection.isValid){
-        return QString::number(convertFromDefault(this->rDirection.sigmaZenith, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().sigmaZenith, type), 'f', digits);
+    }else if(this->variant.getDirection().isValid){
+        return QString::number(convertFromDefault(this->variant.getDirection().sigmaZenith, type), 'f', digits);
     }
     return QString("");
 }
@@ -839,10 +1260,10 @@ QString Reading::getDisplaySigmaZenith(const UnitType &type, const int &digits)
  * \return
  */
 QString Reading::getDisplaySigmaDistance(const UnitType &type, const int &digits) const{
-    if(this->rPolar.isValid){
-        return QString::number(convertFromDefault(this->rPolar.sigmaDistance, type), 'f', digits);
-    }else if(this->rDistance.isValid){
-        return QString::number(convertFromDefault(this->rDistance.sigmaDistance, type), 'f', digits);
+    if(this->variant.getPolar().isValid){
+        return QString::number(convertFromDefault(this->variant.getPolar().sigmaDistance, type), 'f', digits);
+    }else if(this->variant.getDistance().isValid){
+        return QString::number(convertFromDefault(this->variant.getDistance().sigmaDistance, type), 'f', digits);
     }
     return QString("");
 }
@@ -854,10 +1275,10 @@ QString Reading::getDisplaySigmaDistance(const UnitType &type, const int &digits
  * \return
  */
 QString Reading::getDisplaySigmaX(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.sigmaXyz.getAt(0), type), 'f', digits);
-    } else if(this->rCartesian6D.isValid){
-        return QString::number(convertFromDefault(this->rCartesian6D.sigmaXyz.getAt(0), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().sigmaXyz.getAt(0), type), 'f', digits);
+    } else if(this->variant.getCartesian6D().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian6D().sigmaXyz.getAt(0), type), 'f', digits);
     }
     return QString("");
 }
@@ -869,8 +1290,8 @@ QString Reading::getDisplaySigmaX(const UnitType &type, const int &digits) const
  * \return
  */
 QString Reading::getDisplaySigmaY(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.sigmaXyz.getAt(1), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().sigmaXyz.getAt(1), type), 'f', digits);
     }
     return QString("");
 }
@@ -882,8 +1303,8 @@ QString Reading::getDisplaySigmaY(const UnitType &type, const int &digits) const
  * \return
  */
 QString Reading::getDisplaySigmaZ(const UnitType &type, const int &digits) const{
-    if(this->rCartesian.isValid){
-        return QString::number(convertFromDefault(this->rCartesian.sigmaXyz.getAt(2), type), 'f', digits);
+    if(this->variant.getCartesian().isValid){
+        return QString::number(convertFromDefault(this->variant.getCartesian().sigmaXyz.getAt(2), type), 'f', digits);
     }
     return QString("");
 }
@@ -895,8 +1316,8 @@ QString Reading::getDisplaySigmaZ(const UnitType &type, const int &digits) const
  * \return
  */
 QString Reading::getDisplaySigmaI(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(this->rLevel.sigmaI, 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().sigmaI, 'f', digits);
     }
     return QString("");
 }
@@ -908,8 +1329,8 @@ QString Reading::getDisplaySigmaI(const int &digits) const{
  * \return
  */
 QString Reading::getDisplaySigmaJ(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(this->rLevel.sigmaJ, 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().sigmaJ, 'f', digits);
     }
     return QString("");
 }
@@ -921,8 +1342,8 @@ QString Reading::getDisplaySigmaJ(const int &digits) const{
  * \return
  */
 QString Reading::getDisplaySigmaK(const int &digits) const{
-    if(this->rLevel.isValid){
-        return QString::number(this->rLevel.sigmaK, 'f', digits);
+    if(this->variant.getLevel().isValid){
+        return QString::number(this->variant.getLevel().sigmaK, 'f', digits);
     }
     return QString("");
 }
@@ -934,8 +1355,8 @@ QString Reading::getDisplaySigmaK(const int &digits) const{
  * \return
  */
 QString Reading::getDisplaySigmaTemperature(const UnitType &type, const int &digits) const{
-    if(this->rTemperature.isValid){
-        return QString::number(convertFromDefault(this->rTemperature.temperature, type), 'f', digits);
+    if(this->variant.getTemperature().isValid){
+        return QString::number(convertFromDefault(this->variant.getTemperature().temperature, type), 'f', digits);
     }
     return QString("");
 }
@@ -956,7 +1377,7 @@ QDomElement Reading::toOpenIndyXML(QDomDocument &xmlDoc) const{
     //add reading attributes
     reading.setAttribute("id", this->id);
     reading.setAttribute("time", this->measuredAt.toString(Qt::ISODate));
-    reading.setAttribute("type", getReadingTypeName(this->typeOfReading));
+    reading.setAttribute("type", getReadingTypeName(this->variant.getType()));
     reading.setAttribute("imported", this->isImported());
     reading.setAttribute("face", (int)this->getFace());
 
@@ -969,145 +1390,16 @@ QDomElement Reading::toOpenIndyXML(QDomDocument &xmlDoc) const{
     reading.appendChild(measurementConfig);
 
     //add measurements
+    QStringList types;
+    QList<double> values, sigmas;
+    this->getXMLMeasurements(types, values, sigmas);
     QDomElement measurements = xmlDoc.createElement("measurements");
-    switch(this->typeOfReading){
-    case eCartesianReading:
-        if(this->rCartesian.isValid && this->rCartesian.xyz.getSize() >= 3 && this->rCartesian.sigmaXyz.getSize() >= 3){
-            QDomElement x = xmlDoc.createElement("measurement");
-            x.setAttribute("type", "x");
-            x.setAttribute("value", this->rCartesian.xyz.getAt(0));
-            x.setAttribute("sigma", this->rCartesian.sigmaXyz.getAt(0));
-            measurements.appendChild(x);
-            QDomElement y = xmlDoc.createElement("measurement");
-            y.setAttribute("type", "y");
-            y.setAttribute("value", this->rCartesian.xyz.getAt(1));
-            y.setAttribute("sigma", this->rCartesian.sigmaXyz.getAt(1));
-            measurements.appendChild(y);
-            QDomElement z = xmlDoc.createElement("measurement");
-            z.setAttribute("type", "z");
-            z.setAttribute("value", this->rCartesian.xyz.getAt(2));
-            z.setAttribute("sigma", this->rCartesian.sigmaXyz.getAt(2));
-            measurements.appendChild(z);
-        }
-        break;
-    case eCartesianReading6D:
-        if(this->rCartesian6D.isValid && this->rCartesian6D.xyz.getSize() >= 3 && this->rCartesian6D.sigmaXyz.getSize() >= 3){
-            QDomElement x = xmlDoc.createElement("measurement");
-            x.setAttribute("type", "x");
-            x.setAttribute("value", this->rCartesian6D.xyz.getAt(0));
-            x.setAttribute("sigma", this->rCartesian6D.sigmaXyz.getAt(0));
-            measurements.appendChild(x);
-            QDomElement y = xmlDoc.createElement("measurement");
-            y.setAttribute("type", "y");
-            y.setAttribute("value", this->rCartesian6D.xyz.getAt(1));
-            y.setAttribute("sigma", this->rCartesian6D.sigmaXyz.getAt(1));
-            measurements.appendChild(y);
-            QDomElement z = xmlDoc.createElement("measurement");
-            z.setAttribute("type", "z");
-            z.setAttribute("value", this->rCartesian6D.xyz.getAt(2));
-            z.setAttribute("sigma", this->rCartesian6D.sigmaXyz.getAt(2));
-            measurements.appendChild(z);
-            QDomElement i = xmlDoc.createElement("measurement");
-            i.setAttribute("type", "i");
-            i.setAttribute("value", this->rCartesian6D.ijk.getAt(0));
-            i.setAttribute("sigma", -1);
-            measurements.appendChild(i);
-            QDomElement j = xmlDoc.createElement("measurement");
-            j.setAttribute("type", "j");
-            j.setAttribute("value", this->rCartesian6D.ijk.getAt(1));
-            j.setAttribute("sigma", -1);
-            measurements.appendChild(j);
-            QDomElement k = xmlDoc.createElement("measurement");
-            k.setAttribute("type", "k");
-            k.setAttribute("value", this->rCartesian6D.ijk.getAt(2));
-            k.setAttribute("sigma", -1);
-            measurements.appendChild(k);
-        }
-        break;
-    case eDirectionReading:
-        if(this->rDirection.isValid){
-            QDomElement azimuth = xmlDoc.createElement("measurement");
-            azimuth.setAttribute("type", "azimuth");
-            azimuth.setAttribute("value", this->rDirection.azimuth);
-            azimuth.setAttribute("sigma", this->rDirection.sigmaAzimuth);
-            measurements.appendChild(azimuth);
-            QDomElement zenith = xmlDoc.createElement("measurement");
-            zenith.setAttribute("type", "zenith");
-            zenith.setAttribute("value", this->rDirection.zenith);
-            zenith.setAttribute("sigma", this->rDirection.sigmaZenith);
-            measurements.appendChild(zenith);
-        }
-        break;
-    case eDistanceReading:
-        if(this->rDistance.isValid){
-            QDomElement distance = xmlDoc.createElement("measurement");
-            distance.setAttribute("type", "distance");
-            distance.setAttribute("value", this->rDistance.distance);
-            distance.setAttribute("sigma", this->rDistance.sigmaDistance);
-            measurements.appendChild(distance);
-        }
-        break;
-    case ePolarReading:
-        if(this->rPolar.isValid){
-            QDomElement azimuth = xmlDoc.createElement("measurement");
-            azimuth.setAttribute("type", "azimuth");
-            azimuth.setAttribute("value", this->rPolar.azimuth);
-            azimuth.setAttribute("sigma", this->rPolar.sigmaAzimuth);
-            measurements.appendChild(azimuth);
-            QDomElement zenith = xmlDoc.createElement("measurement");
-            zenith.setAttribute("type", "zenith");
-            zenith.setAttribute("value", this->rPolar.zenith);
-            zenith.setAttribute("sigma", this->rPolar.sigmaZenith);
-            measurements.appendChild(zenith);
-            QDomElement distance = xmlDoc.createElement("measurement");
-            distance.setAttribute("type", "distance");
-            distance.setAttribute("value", this->rPolar.distance);
-            distance.setAttribute("sigma", this->rPolar.sigmaDistance);
-            measurements.appendChild(distance);
-        }
-        break;
-    case eTemperatureReading:
-        if(this->rTemperature.isValid){
-            QDomElement temperature = xmlDoc.createElement("measurement");
-            temperature.setAttribute("type", "temperature");
-            temperature.setAttribute("value", this->rTemperature.temperature);
-            temperature.setAttribute("sigma", this->rTemperature.sigmaTemperature);
-            measurements.appendChild(temperature);
-        }
-        break;
-    case eLevelReading:
-        if(this->rLevel.isValid){
-            QDomElement i = xmlDoc.createElement("measurement");
-            i.setAttribute("type", "i");
-            i.setAttribute("value", this->rLevel.i);
-            i.setAttribute("sigma", this->rLevel.sigmaI);
-            measurements.appendChild(i);
-            QDomElement j = xmlDoc.createElement("measurement");
-            j.setAttribute("type", "j");
-            j.setAttribute("value", this->rLevel.j);
-            j.setAttribute("sigma", this->rLevel.sigmaJ);
-            measurements.appendChild(j);
-            QDomElement k = xmlDoc.createElement("measurement");
-            k.setAttribute("type", "k");
-            k.setAttribute("value", this->rLevel.k);
-            k.setAttribute("sigma", this->rLevel.sigmaK);
-            measurements.appendChild(k);
-        }
-        break;
-    case eUndefinedReading:
-        if(this->rUndefined.isValid && this->rUndefined.values.size() == this->rUndefined.sigmaValues.size()){
-            QList<QString> measurementTypes = this->rUndefined.values.keys();
-            foreach(QString type, measurementTypes){
-                if(this->rUndefined.sigmaValues.contains(type)){
-                    QDomElement measurement = xmlDoc.createElement("measurement");
-                    measurement.setAttribute("type", type);
-                    measurement.setAttribute("value", this->rUndefined.values.value(type));
-                    measurement.setAttribute("sigma", this->rUndefined.sigmaValues.value(type));
-                    measurements.appendChild(measurement);
-                }
-            }
-        }
-        break;
+    for(int i = 0; i < types.size(); i++){
+        QDomElement measurement = xmlDoc.createElement("measurement");
+        measurement.setAttribute("type", types.at(i));
+        measurement.setAttribute("value", values.at(i));
+        measurement.setAttribute("sigma", sigmas.at(i));
+        measurements.appendChild(measurement);
     }
     reading.appendChild(measurements);
 
@@ -1132,7 +1424,7 @@ bool Reading::fromOpenIndyXML(QDomElement &xmlElem){
     }
     this->id = xmlElem.attribute("id").toInt();
     this->measuredAt = QDateTime::fromString(xmlElem.attribute("time"), Qt::ISODate);
-    this->typeOfReading = getReadingTypeEnum(xmlElem.attribute("type"));
+    this->variant.setType(getReadingTypeEnum(xmlElem.attribute("type")));
     this->setImported(xmlElem.attribute("imported").toInt());
     this->setSensorFace(xmlElem.attribute("face").isEmpty() ? eUndefinedSide : (SensorFaces)(xmlElem.attribute("face").toInt()));
 
@@ -1157,94 +1449,140 @@ bool Reading::fromOpenIndyXML(QDomElement &xmlElem){
     }
 
     // set isValid
-    switch(typeOfReading) {
-    case eDistanceReading:
-        this->rDistance.isValid = true;
-        break;
-    case eCartesianReading:
-        this->rCartesian.isValid = true;
-        //initialize measurement variables
-        this->rCartesian.xyz = OiVec(3);
-        this->rCartesian.sigmaXyz = OiVec(3);
-        break;
-    case ePolarReading:
-        this->rPolar.isValid = true;
-        break;
-    case eDirectionReading:
-        this->rDirection.isValid = true;
-        break;
-    case eTemperatureReading:
-        this->rTemperature.isValid = true;
-        break;
-    case eLevelReading:
-        this->rLevel.isValid = true;
-        break;
-    case eCartesianReading6D:
-        this->rCartesian6D.isValid = true;
-        break;
-    case eUndefinedReading:
-    default:
+    if(!this->initXMLMeasurements()){
         return false;
     }
 
-
     //fill measurement values
     for(int i = 0; i < measurementList.size(); i++){
         QDomElement measurement = measurementList.at(i).toElement();
         if(!measurement.hasAttribute("type") || !measurement.hasAttribute("value") || !measurement.hasAttribute("sigma")){
             continue;
         }
+        this->setXMLMeasurement(measurement.attribute("type"), measurement.attribute("value").toDouble(),
+                                measurement.attribute("sigma").toDouble());
+    }
 
-        double value = measurement.attribute("value").toDouble();
-        if(measurement.attribute("type").compare("x") == 0){
-            if(this->rCartesian.isValid) this->rCartesian.xyz.setAt(0, value);
-            if(this->rCartesian6D.isValid) this->rCartesian6D.xyz.setAt(0, value);
-        }else if(measurement.attribute("type").compare("y") == 0){
-            if(this->rCartesian.isValid) this->rCartesian.xyz.setAt(1, value);
-            if(this->rCartesian6D.isValid) this->rCartesian6D.xyz.setAt(1, value);
-        }else if(measurement.attribute("type").compare("z") == 0){
-            if(this->rCartesian.isValid) this->rCartesian.xyz.setAt(2, value);
-            if(this->rCartesian6D.isValid) this->rCartesian6D.xyz.setAt(2, value);
-        }else if(measurement.attribute("type").compare("azimuth") == 0){
-            if(this->rPolar.isValid) this->rPolar.azimuth = value;
-            if(this->rDirection.isValid) this->rDirection.azimuth = value;
-        }else if(measurement.attribute("type").compare("zenith") == 0){
-            if(this->rPolar.isValid) this->rPolar.zenith = value;
-            if(this->rDirection.isValid) this->rDirection.zenith = value;
-        }else if(measurement.attribute("type").compare("distance") == 0){
-            if(this->rPolar.isValid) this->rPolar.distance = value;
-            if(this->rDistance.isValid) this->rDistance.distance = value;
-        }else if(measurement.attribute("type").compare("i") == 0){
-            if(this->rCartesian6D.isValid) {
-                this->rCartesian6D.ijk.setAt(0, value);
-            } else if(this->rLevel.isValid) {
-                this->rLevel.i = value;
-                this->rLevel.sigmaI = measurement.attribute("sigma").toDouble();
-            }
-        }else if(measurement.attribute("type").compare("j") == 0){
-            if(this->rCartesian6D.isValid) {
-                this->rCartesian6D.ijk.setAt(1, value);
-            } else if(this->rLevel.isValid) {
-                this->rLevel.j = value;
-                this->rLevel.sigmaJ = measurement.attribute("sigma").toDouble();
-            }
-        }else if(measurement.attribute("type").compare("k") == 0){
-            if(this->rCartesian6D.isValid) {
-                this->rCartesian6D.ijk.setAt(2, value);
-            } else if(this->rLevel.isValid) {
-                this->rLevel.k = value;
-                this->rLevel.sigmaK = measurement.attribute("sigma").toDouble();
+    this->toCartesian(); // if necessary and posible
+    this->toPolar(); // if necessary and posible
+
+    return true;
+}
+
+/*!
+ * \brief Reading::toOpenIndyXML
+ * Writes the reading to the given stream using the same schema as the DOM variant
+ * \param xmlWriter
+ */
+void Reading::toOpenIndyXML(QXmlStreamWriter &xmlWriter) const{
+
+    xmlWriter.writeStartElement("reading");
+
+    //add reading attributes (numbers are formatted like QDomElement::setAttribute does)
+    xmlWriter.writeAttribute("id", QString::number(this->id));
+    xmlWriter.writeAttribute("time", this->measuredAt.toString(Qt::ISODate));
+    xmlWriter.writeAttribute("type", getReadingTypeName(this->variant.getType()));
+    xmlWriter.writeAttribute("imported", QString::number(this->isImported()));
+    xmlWriter.writeAttribute("face", QString::number((int)this->getFace()));
+
+    xmlWriter.writeEmptyElement("sensorConfig");
+    xmlWriter.writeAttribute("name", this->sensorConfigName);
+
+    xmlWriter.writeEmptyElement("measurementConfig");
+    xmlWriter.writeAttribute("name", this->measurementConfigName);
+
+    //add measurements
+    QStringList types;
+    QList<double> values, sigmas;
+    this->getXMLMeasurements(types, values, sigmas);
+    xmlWriter.writeStartElement("measurements");
+    for(int i = 0; i < types.size(); i++){
+        xmlWriter.writeEmptyElement("measurement");
+        xmlWriter.writeAttribute("type", types.at(i));
+        xmlWriter.writeAttribute("value", QString::number(values.at(i), 'g', 17));
+        xmlWriter.writeAttribute("sigma", QString::number(sigmas.at(i), 'g', 17));
+    }
+    xmlWriter.writeEndElement();
+
+    xmlWriter.writeEndElement();
+
+}
+
+/*!
+ * \brief Reading::fromOpenIndyXML
+ * Reads the reading from the given stream. The reader has to be positioned at the start element of the reading
+ * and is positioned at its end element afterwards.
+ * \param xmlReader
+ * \return
+ */
+bool Reading::fromOpenIndyXML(QXmlStreamReader &xmlReader){
+
+    if(!xmlReader.isStartElement()){
+        return false;
+    }
+
+    //set reading attributes
+    QXmlStreamAttributes attributes = xmlReader.attributes();
+    if(!attributes.hasAttribute("id") || !attributes.hasAttribute("time") || !attributes.hasAttribute("type")){
+        xmlReader.skipCurrentElement();
+        return false;
+    }
+    this->id = attributes.value("id").toInt();
+    this->measuredAt = QDateTime::fromString(attributes.value("time").toString(), Qt::ISODate);
+    this->variant.setType(getReadingTypeEnum(attributes.value("type").toString()));
+    this->setImported(attributes.value("imported").toInt());
+    this->setSensorFace(attributes.value("face").isEmpty() ? eUndefinedSide : (SensorFaces)(attributes.value("face").toInt()));
+
+    //get list of measurements
+    bool hasMeasurements = false;
+    int numMeasurements = 0;
+    QStringList types;
+    QList<double> values, sigmas;
+    while(xmlReader.readNextStartElement()){
+
+        if(xmlReader.name() == QLatin1String("sensorConfig")){
+            this->sensorConfigName = xmlReader.attributes().value("name").toString();
+        }else if(xmlReader.name() == QLatin1String("measurementConfig")){
+            this->measurementConfigName = xmlReader.attributes().value("name").toString();
+        }else if(xmlReader.name() == QLatin1String("measurements") && !hasMeasurements){
+            hasMeasurements = true;
+            while(xmlReader.readNextStartElement()){
+                if(xmlReader.name() == QLatin1String("measurement")){
+                    numMeasurements++;
+                    QXmlStreamAttributes measurement = xmlReader.attributes();
+                    if(measurement.hasAttribute("type") && measurement.hasAttribute("value") && measurement.hasAttribute("sigma")){
+                        types.append(measurement.value("type").toString());
+                        values.append(measurement.value("value").toDouble());
+                        sigmas.append(measurement.value("sigma").toDouble());
+                    }
+                }
+                xmlReader.skipCurrentElement();
             }
-        }else if(measurement.attribute("type").compare("temperature") == 0){
-            if(this->rTemperature.isValid) this->rTemperature.temperature = value;
+            continue;
         }
+        xmlReader.skipCurrentElement();
 
     }
 
+    if(xmlReader.hasError() || !hasMeasurements || numMeasurements == 0){
+        return false;
+    }
+
+    // set isValid
+    if(!this->initXMLMeasurements()){
+        return false;
+    }
+
+    //fill measurement values
+    for(int i = 0; i < types.size(); i++){
+        this->setXMLMeasurement(types.at(i), values.at(i), sigmas.at(i));
+    }
+
     this->toCartesian(); // if necessary and posible
     this->toPolar(); // if necessary and posible
 
     return true;
+
 }
 
 /*!
@@ -1252,16 +1590,16 @@ bool Reading::fromOpenIndyXML(QDomElement &xmlElem){
  */
 void Reading::toCartesian(){
 
-    if(!this->rPolar.isValid //check if the polar reading is not valid
-        || this->rCartesian.isValid){ //cartesian reading available
+    const ReadingPolar &rPolar = this->variant.getPolar();
+    if(!rPolar.isValid //check if the polar reading is not valid
+        || this->variant.getCartesian().isValid){ //cartesian reading available
         return;
     }
 
     //transform polar to cartesian
-    this->rCartesian.xyz.setAt( 0, this->rPolar.distance * qSin(this->rPolar.zenith) * qCos(this->rPolar.azimuth) );
-    this->rCartesian.xyz.setAt( 1, this->rPolar.distance * qSin(this->rPolar.zenith) * qSin(this->rPolar.azimuth) );
-    this->rCartesian.xyz.setAt( 2, this->rPolar.distance * qCos(this->rPolar.zenith) );
-    this->rCartesian.isValid = true;
+    ReadingCartesian &rCartesian = this->variant.modifyCartesian();
+    Reading::toCartesianVec3(rPolar.azimuth, rPolar.zenith, rPolar.distance).assignTo(rCartesian.xyz);
+    rCartesian.isValid = true;
 
 }
 
@@ -1270,19 +1608,19 @@ void Reading::toCartesian(){
  */
 void Reading::toPolar(){
 
-    if(!this->rPolar.isValid //check if the polar reading is not valid
-        || this->rCartesian.isValid){ //cartesian reading available
+    const ReadingCartesian &rCartesian = this->variant.getCartesian();
+    if(!this->variant.getPolar().isValid //check if the polar reading is not valid
+        || rCartesian.isValid){ //cartesian reading available
         return;
     }
 
     //transform cartesian to polar
-    double x = this->rCartesian.xyz.getAt(0);
-    double y = this->rCartesian.xyz.getAt(1);
-    double z = this->rCartesian.xyz.getAt(2);
-    this->rPolar.azimuth = qAtan2(y,x);
-    this->rPolar.distance = qSqrt(x*x+y*y+z*z);
-    this->rPolar.zenith = acos(z/this->rPolar.distance);
-    this->rPolar.isValid = true;
+    Vec3 polar = Reading::toPolarVec3(rCartesian.xyz.getAt(0), rCartesian.xyz.getAt(1), rCartesian.xyz.getAt(2));
+    ReadingPolar &rPolar = this->variant.modifyPolar();
+    rPolar.azimuth = polar.getAt(0);
+    rPolar.zenith = polar.getAt(1);
+    rPolar.distance = polar.getAt(2);
+    rPolar.isValid = true;
 
 }
 
@@ -1290,37 +1628,218 @@ void Reading::toPolar(){
  * \brief Reading::errorPropagationPolarToCartesian
  * \return
  */
-OiVec Reading::errorPropagationPolarToCartesian(){
+Vec3 Reading::errorPropagationPolarToCartesian(){
 
     //check if polar reading is valid
+    const ReadingPolar &rPolar = this->variant.getPolar();
     if(!rPolar.isValid){
-        return OiVec(3);
+        return Vec3();
     }
 
-    OiVec sigmaXyz;
+    const double sinZenith = qSin(rPolar.zenith);
+    const double cosZenith = qCos(rPolar.zenith);
+    const double sinAzimuth = qSin(rPolar.azimuth);
+    const double cosAzimuth = qCos(rPolar.azimuth);
+
+    Mat3 F(sinZenith * cosAzimuth, rPolar.distance * sinZenith * -sinAzimuth, rPolar.distance * cosZenith * cosAzimuth,
+           sinZenith * sinAzimuth, rPolar.distance * sinZenith * cosAzimuth, rPolar.distance * cosZenith * sinAzimuth,
+           cosZenith, 0.0, rPolar.distance * -sinZenith);
 
-    OiMat F(3,3);
-    F.setAt(0, 0, qSin(this->rPolar.zenith) * qCos(this->rPolar.azimuth));
-    F.setAt(0, 1, this->rPolar.distance * qSin(this->rPolar.zenith) * -qSin(this->rPolar.azimuth));
-    F.setAt(0, 2, this->rPolar.distance * qCos(this->rPolar.zenith) * qCos(this->rPolar.azimuth));
-    F.setAt(1, 0, qSin(this->rPolar.zenith) * qSin(this->rPolar.azimuth));
-    F.setAt(1, 1, this->rPolar.distance * qSin(this->rPolar.zenith) * qCos(this->rPolar.azimuth));
-    F.setAt(1, 2, this->rPolar.distance * qCos(this->rPolar.zenith) * qSin(this->rPolar.azimuth));
-    F.setAt(2, 0, qCos(this->rPolar.zenith));
-    F.setAt(2, 1, 0.0);
-    F.setAt(2, 2, this->rPolar.distance * -qSin(this->rPolar.zenith));
+    Mat3 Sll;
+    Sll.setAt(0, 0, rPolar.sigmaDistance * rPolar.sigmaDistance);
+    Sll.setAt(1, 1, rPolar.sigmaAzimuth * rPolar.sigmaAzimuth);
+    Sll.setAt(2, 2, rPolar.sigmaZenith * rPolar.sigmaZenith);
 
-    OiMat Sll(3,3);
-    Sll.setAt(0, 0, this->rPolar.sigmaDistance * this->rPolar.sigmaDistance);
-    Sll.setAt(1, 1, this->rPolar.sigmaAzimuth * this->rPolar.sigmaAzimuth);
-    Sll.setAt(2, 2, this->rPolar.sigmaZenith * this->rPolar.sigmaZenith);
+    Mat3 Qxx = F * Sll * F.t();
 
-    OiMat Qxx = F * Sll * F.t();
+    return Vec3(qSqrt(Qxx.getAt(0,0)), qSqrt(Qxx.getAt(1,1)), qSqrt(Qxx.getAt(2,2)));
 
-    sigmaXyz.add(qSqrt(Qxx.getAt(0,0)));
-    sigmaXyz.add(qSqrt(Qxx.getAt(1,1)));
-    sigmaXyz.add(qSqrt(Qxx.getAt(2,2)));
+}
+
+/*!
+ * \brief Reading::getXMLMeasurements
+ * Returns the measurements of this reading as they are saved in an OpenIndy XML file
+ * \param types
+ * \param values
+ * \param sigmas
+ */
+void Reading::getXMLMeasurements(QStringList &types, QList<double> &values, QList<double> &sigmas) const{
 
-    return sigmaXyz;
+    switch(this->variant.getType()){
+    case eCartesianReading:{
+        const ReadingCartesian &rCartesian = this->variant.getCartesian();
+        if(rCartesian.isValid && rCartesian.xyz.getSize() >= 3 && rCartesian.sigmaXyz.getSize() >= 3){
+            types << "x" << "y" << "z";
+            values << rCartesian.xyz.getAt(0) << rCartesian.xyz.getAt(1) << rCartesian.xyz.getAt(2);
+            sigmas << rCartesian.sigmaXyz.getAt(0) << rCartesian.sigmaXyz.getAt(1) << rCartesian.sigmaXyz.getAt(2);
+        }
+        break;
+    }
+    case eCartesianReading6D:{
+        const ReadingCartesian6D &rCartesian6D = this->variant.getCartesian6D();
+        if(rCartesian6D.isValid && rCartesian6D.xyz.getSize() >= 3 && rCartesian6D.sigmaXyz.getSize() >= 3){
+            types << "x" << "y" << "z" << "i" << "j" << "k";
+            values << rCartesian6D.xyz.getAt(0) << rCartesian6D.xyz.getAt(1) << rCartesian6D.xyz.getAt(2)
+                   << rCartesian6D.ijk.getAt(0) << rCartesian6D.ijk.getAt(1) << rCartesian6D.ijk.getAt(2);
+            sigmas << rCartesian6D.sigmaXyz.getAt(0) << rCartesian6D.sigmaXyz.getAt(1) << rCartesian6D.sigmaXyz.getAt(2)
+                   << -1 << -1 << -1;
+        }
+        break;
+    }
+    case eDirectionReading:{
+        const ReadingDirection &rDirection = this->variant.getDirection();
+        if(rDirection.isValid){
+            types << "azimuth" << "zenith";
+            values << rDirection.azimuth << rDirection.zenith;
+            sigmas << rDirection.sigmaAzimuth << rDirection.sigmaZenith;
+        }
+        break;
+    }
+    case eDistanceReading:{
+        const ReadingDistance &rDistance = this->variant.getDistance();
+        if(rDistance.isValid){
+            types << "distance";
+            values << rDistance.distance;
+            sigmas << rDistance.sigmaDistance;
+        }
+        break;
+    }
+    case ePolarReading:{
+        const ReadingPolar &rPolar = this->variant.getPolar();
+        if(rPolar.isValid){
+            types << "azimuth" << "zenith" << "distance";
+            values << rPolar.azimuth << rPolar.zenith << rPolar.distance;
+            sigmas << rPolar.sigmaAzimuth << rPolar.sigmaZenith << rPolar.sigmaDistance;
+        }
+        break;
+    }
+    case eTemperatureReading:{
+        const ReadingTemperature &rTemperature = this->variant.getTemperature();
+        if(rTemperature.isValid){
+            types << "temperature";
+            values << rTemperature.temperature;
+            sigmas << rTemperature.sigmaTemperature;
+        }
+        break;
+    }
+    case eLevelReading:{
+        const ReadingLevel &rLevel = this->variant.getLevel();
+        if(rLevel.isValid){
+            types << "i" << "j" << "k";
+            values << rLevel.i << rLevel.j << rLevel.k;
+            sigmas << rLevel.sigmaI << rLevel.sigmaJ << rLevel.sigmaK;
+        }
+        break;
+    }
+    case eUndefinedReading:{
+        const ReadingUndefined &rUndefined = this->variant.getUndefined();
+        if(rUndefined.isValid && rUndefined.values.size() == rUndefined.sigmaValues.size()){
+            QList<QString> measurementTypes = rUndefined.values.keys();
+            foreach(QString type, measurementTypes){
+                if(rUndefined.sigmaValues.contains(type)){
+                    types << type;
+                    values << rUndefined.values.value(type);
+                    sigmas << rUndefined.sigmaValues.value(type);
+                }
+            }
+        }
+        break;
+    }
+    }
+
+}
+
+/*!
+ * \brief Reading::initXMLMeasurements
+ * Marks the reading of the current type as valid before its measurements are loaded from XML
+ * \return false if the reading type cannot be loaded
+ */
+bool Reading::initXMLMeasurements(){
+
+    switch(this->variant.getType()) {
+    case eDistanceReading:
+        this->variant.modifyDistance().isValid = true;
+        break;
+    case eCartesianReading:
+        this->variant.modifyCartesian().isValid = true;
+        //initialize measurement variables
+        this->variant.modifyCartesian().xyz = OiVec(3);
+        this->variant.modifyCartesian().sigmaXyz = OiVec(3);
+        break;
+    case ePolarReading:
+        this->variant.modifyPolar().isValid = true;
+        break;
+    case eDirectionReading:
+        this->variant.modifyDirection().isValid = true;
+        break;
+    case eTemperatureReading:
+        this->variant.modifyTemperature().isValid = true;
+        break;
+    case eLevelReading:
+        this->variant.modifyLevel().isValid = true;
+        break;
+    case eCartesianReading6D:
+        this->variant.modifyCartesian6D().isValid = true;
+        break;
+    case eUndefinedReading:
+    default:
+        return false;
+    }
+
+    return true;
+
+}
+
+/*!
+ * \brief Reading::setXMLMeasurement
+ * Sets a single measurement that was loaded from XML
+ * \param type
+ * \param value
+ * \param sigma
+ */
+void Reading::setXMLMeasurement(const QString &type, const double &value, const double &sigma){
+
+    if(type.compare("x") == 0){
+        if(this->variant.getCartesian().isValid) this->variant.modifyCartesian().xyz.setAt(0, value);
+        if(this->variant.getCartesian6D().isValid) this->variant.modifyCartesian6D().xyz.setAt(0, value);
+    }else if(type.compare("y") == 0){
+        if(this->variant.getCartesian().isValid) this->variant.modifyCartesian().xyz.setAt(1, value);
+        if(this->variant.getCartesian6D().isValid) this->variant.modifyCartesian6D().xyz.setAt(1, value);
+    }else if(type.compare("z") == 0){
+        if(this->variant.getCartesian().isValid) this->variant.modifyCartesian().xyz.setAt(2, value);
+        if(this->variant.getCartesian6D().isValid) this->variant.modifyCartesian6D().xyz.setAt(2, value);
+    }else if(type.compare("azimuth") == 0){
+        if(this->variant.getPolar().isValid) this->variant.modifyPolar().azimuth = value;
+        if(this->variant.getDirection().isValid) this->variant.modifyDirection().azimuth = value;
+    }else if(type.compare("zenith") == 0){
+        if(this->variant.getPolar().isValid) this->variant.modifyPolar().zenith = value;
+        if(this->variant.getDirection().isValid) this->variant.modifyDirection().zenith = value;
+    }else if(type.compare("distance") == 0){
+        if(this->variant.getPolar().isValid) this->variant.modifyPolar().distance = value;
+        if(this->variant.getDistance().isValid) this->variant.modifyDistance().distance = value;
+    }else if(type.compare("i") == 0){
+        if(this->variant.getCartesian6D().isValid) {
+            this->variant.modifyCartesian6D().ijk.setAt(0, value);
+        } else if(this->variant.getLevel().isValid) {
+            this->variant.modifyLevel().i = value;
+            this->variant.modifyLevel().sigmaI = sigma;
+        }
+    }else if(type.compare("j") == 0){
+        if(this->variant.getCartesian6D().isValid) {
+            this->variant.modifyCartesian6D().ijk.setAt(1, value);
+        } else if(this->variant.getLevel().isValid) {
+            this->variant.modifyLevel().j = value;
+            this->variant.modifyLevel().sigmaJ = sigma;
+        }
+    }else if(type.compare("k") == 0){
+        if(this->variant.getCartesian6D().isValid) {
+            this->variant.modifyCartesian6D().ijk.setAt(2, value);
+        } else if(this->variant.getLevel().isValid) {
+            this->variant.modifyLevel().k = value;
+            this->variant.modifyLevel().sigmaK = sigma;
+        }
+    }else if(type.compare("temperature") == 0){
+        if(this->variant.getTemperature().isValid) this->variant.modifyTemperature().temperature = value;
+    }
 
 }
@@ -0,0 +1,584 @@
+#include "recalcscheduler.h"
+
+#include <QHash>
+#include <QSet>
+#include <QQueue>
+#include <QRunnable>
+#include <QAtomicInt>
+#include <QThread>
+#include <QMutexLocker>
+#include <QVector>
+#include <algorithm>
+
+#include "featurewrapper.h"
+#include "geometry.h"
+#include "observation.h"
+
+using namespace oi;
+
+namespace{
+
+/*!
+ * \brief The RecalcTask class
+ * Recalculates groups of features until all groups of a dependency level are taken.
+ * All tasks of a level share the index of the next group, so that idle threads pick up the remaining work.
+ */
+class RecalcTask : public QRunnable
+{
+public:
+    RecalcTask(const QList<QList<QPointer<Feature> > > &groups, QAtomicInt &nextGroup) : groups(groups), nextGroup(nextGroup){}
+
+    void run(){
+        int index = this->nextGroup.fetchAndAddOrdered(1);
+        while(index < this->groups.size()){
+            foreach(const QPointer<Feature> &feature, this->groups.at(index)){
+                if(!feature.isNull()){
+                    feature->recalc();
+                }
+            }
+            index = this->nextGroup.fetchAndAddOrdered(1);
+        }
+    }
+
+private:
+    const QList<QList<QPointer<Feature> > > &groups;
+    QAtomicInt &nextGroup;
+};
+
+/*!
+ * \brief findRoot
+ * Returns the representative of the union find set that contains key
+ * \param parents
+ * \param key
+ * \return
+ */
+int findRoot(QHash<int, int> &parents, const int &key){
+    int root = key;
+    while(parents.value(root, root) != root){
+        root = parents.value(root);
+    }
+    parents.insert(key, root);
+    return root;
+}
+
+}
+
+/*!
+ * \brief RecalcScheduler::RecalcScheduler
+ * \param parent
+ */
+RecalcScheduler::RecalcScheduler(QObject *parent) : QObject(parent), isFlushScheduled(false), lastRecalcCount(0), parallelRecalc(false){
+
+}
+
+/*!
+ * \brief RecalcScheduler::~RecalcScheduler
+ */
+RecalcScheduler::~RecalcScheduler(){
+
+}
+
+/*!
+ * \brief RecalcScheduler::invalidate
+ * Marks the given feature as dirty and schedules a recalculation at the end of the current event loop turn
+ * \param feature
+ */
+void RecalcScheduler::invalidate(const QPointer<Feature> &feature){
+
+    //check feature
+    if(feature.isNull()){
+        return;
+    }
+
+    this->dirtyFeatures.insert(feature->getId(), feature);
+
+    //schedule only one flush per event loop turn
+    if(!this->isFlushScheduled){
+        this->isFlushScheduled = true;
+        QMetaObject::invokeMethod(this, "flush", Qt::QueuedConnection);
+    }
+
+}
+
+/*!
+ * \brief RecalcScheduler::invalidate
+ * \param features
+ */
+void RecalcScheduler::invalidate(const QList<QPointer<Feature> > &features){
+    foreach(const QPointer<Feature> &feature, features){
+        this->invalidate(feature);
+    }
+}
+
+/*!
+ * \brief RecalcScheduler::getHasPendingRecalc
+ * \return
+ */
+bool RecalcScheduler::getHasPendingRecalc() const{
+    return !this->dirtyFeatures.isEmpty();
+}
+
+/*!
+ * \brief RecalcScheduler::getLastRecalcCount
+ * Returns the number of features that were recalculated by the last flush
+ * \return
+ */
+int RecalcScheduler::getLastRecalcCount() const{
+    return this->lastRecalcCount;
+}
+
+/*!
+ * \brief RecalcScheduler::getParallelRecalc
+ * \return
+ */
+bool RecalcScheduler::getParallelRecalc() const{
+    return this->parallelRecalc;
+}
+
+/*!
+ * \brief RecalcScheduler::setParallelRecalc
+ * If true independent features of one dependency level are recalculated concurrently.
+ * Functions used by the features have to be reentrant.
+ * \param parallelRecalc
+ */
+void RecalcScheduler::setParallelRecalc(const bool &parallelRecalc){
+    this->parallelRecalc = parallelRecalc;
+}
+
+/*!
+ * \brief RecalcScheduler::getMaxThreadCount
+ * \return
+ */
+int RecalcScheduler::getMaxThreadCount() const{
+    return this->threadPool.maxThreadCount();
+}
+
+/*!
+ * \brief RecalcScheduler::setMaxThreadCount
+ * \param maxThreadCount
+ */
+void RecalcScheduler::setMaxThreadCount(const int &maxThreadCount){
+    this->threadPool.setMaxThreadCount(maxThreadCount);
+}
+
+/*!
+ * \brief RecalcScheduler::getIsPreviouslyNeeded
+ * Checks whether neededFeature is directly or indirectly needed by feature.
+ * Each feature of the dependency graph is visited at most once (O(V+E)).
+ * \param feature
+ * \param neededFeature
+ * \return
+ */
+bool RecalcScheduler::getIsPreviouslyNeeded(const QPointer<Feature> &feature, const QPointer<Feature> &neededFeature){
+
+    //check features
+    if(feature.isNull() || neededFeature.isNull()){
+        return false;
+    }
+
+    //depth first search along the previouslyNeeded edges
+    QSet<int> visited;
+    QList<QPointer<Feature> > stack;
+    visited.insert(feature->getId());
+    stack.append(feature);
+    while(!stack.isEmpty()){
+
+        QPointer<Feature> current = stack.takeLast();
+
+        foreach(const QPointer<FeatureWrapper> &needed, current->getPreviouslyNeeded()){
+
+            //check feature
+            if(needed.isNull() || needed->getFeature().isNull()){
+                continue;
+            }
+
+            int id = needed->getFeature()->getId();
+            if(id == neededFeature->getId()){
+                return true;
+            }
+            if(!visited.contains(id)){
+                visited.insert(id);
+                stack.append(needed->getFeature());
+            }
+
+        }
+
+    }
+
+    return false;
+
+}
+
+/*!
+ * \brief RecalcScheduler::getAffectedFeatures
+ * Returns the given features and all features that depend on them (directly or indirectly).
+ * Each feature is contained only once.
+ * \param features
+ * \return
+ */
+QList<QPointer<Feature> > RecalcScheduler::getAffectedFeatures(const QList<QPointer<Feature> > &features){
+
+    QList<QPointer<Feature> > result;
+    QSet<int> visited;
+
+    //breadth first search along the usedFor edges
+    QQueue<QPointer<Feature> > queue;
+    foreach(const QPointer<Feature> &feature, features){
+        if(!feature.isNull() && !visited.contains(feature->getId())){
+            visited.insert(feature->getId());
+            queue.enqueue(feature);
+        }
+    }
+    while(!queue.isEmpty()){
+
+        QPointer<Feature> feature = queue.dequeue();
+        result.append(feature);
+
+        foreach(const QPointer<FeatureWrapper> &usedFor, feature->getUsedFor()){
+            if(usedFor.isNull() || usedFor->getFeature().isNull() || visited.contains(usedFor->getFeature()->getId())){
+                continue;
+            }
+            visited.insert(usedFor->getFeature()->getId());
+            queue.enqueue(usedFor->getFeature());
+        }
+
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief RecalcScheduler::sortTopologically
+ * Sorts the given features so that each feature comes after all features of the list it previously needs.
+ * Features that are part of a cycle are appended at the end in their input order.
+ * \param features
+ * \return
+ */
+QList<QPointer<Feature> > RecalcScheduler::sortTopologically(const QList<QPointer<Feature> > &features){
+
+    QList<QPointer<Feature> > result;
+
+    foreach(const QList<QPointer<Feature> > &level, RecalcScheduler::getDependencyLevels(features)){
+        result.append(level);
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief RecalcScheduler::getDependencyLevels
+ * Partitions the given features into levels. Each feature only needs features of previous levels.
+ * Within a level features keep their input order. Features that are part of a cycle form the last level.
+ * \param features
+ * \return
+ */
+QList<QList<QPointer<Feature> > > RecalcScheduler::getDependencyLevels(const QList<QPointer<Feature> > &features){
+
+    QList<QList<QPointer<Feature> > > result;
+
+    //remember the input position of each feature
+    QHash<int, int> positions;
+    QList<QPointer<Feature> > uniqueFeatures;
+    foreach(const QPointer<Feature> &feature, features){
+        if(!feature.isNull() && !positions.contains(feature->getId())){
+            positions.insert(feature->getId(), uniqueFeatures.size());
+            uniqueFeatures.append(feature);
+        }
+    }
+
+    //count the edges inside the given feature set
+    QVector<int> inDegree(uniqueFeatures.size(), 0);
+    for(int i = 0; i < uniqueFeatures.size(); i++){
+        foreach(const QPointer<FeatureWrapper> &needed, uniqueFeatures.at(i)->getPreviouslyNeeded()){
+            if(!needed.isNull() && !needed->getFeature().isNull() && positions.contains(needed->getFeature()->getId())){
+                inDegree[i]++;
+            }
+        }
+    }
+
+    //Kahn's algorithm processed level by level
+    QVector<bool> done(uniqueFeatures.size(), false);
+    QList<int> level;
+    for(int i = 0; i < uniqueFeatures.size(); i++){
+        if(inDegree.at(i) == 0){
+            level.append(i);
+            done[i] = true;
+        }
+    }
+    while(!level.isEmpty()){
+
+        QList<QPointer<Feature> > levelFeatures;
+        QList<int> nextLevel;
+        foreach(const int &i, level){
+
+            levelFeatures.append(uniqueFeatures.at(i));
+
+            foreach(const QPointer<FeatureWrapper> &usedFor, uniqueFeatures.at(i)->getUsedFor()){
+                if(usedFor.isNull() || usedFor->getFeature().isNull() || !positions.contains(usedFor->getFeature()->getId())){
+                    continue;
+                }
+                int position = positions.value(usedFor->getFeature()->getId());
+                if(done.at(position)){
+                    continue;
+                }
+                inDegree[position]--;
+                if(inDegree.at(position) == 0){
+                    done[position] = true;
+                    nextLevel.append(position);
+                }
+            }
+
+        }
+        result.append(levelFeatures);
+
+        std::sort(nextLevel.begin(), nextLevel.end());
+        level = nextLevel;
+
+    }
+
+    //features that are part of a cycle
+    QList<QPointer<Feature> > remaining;
+    for(int i = 0; i < uniqueFeatures.size(); i++){
+        if(!done.at(i)){
+            remaining.append(uniqueFeatures.at(i));
+        }
+    }
+    if(!remaining.isEmpty()){
+        result.append(remaining);
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief RecalcScheduler::getIndependentGroups
+ * Partitions the given features (usually one dependency level) into groups that can be recalculated concurrently.
+ * Two features are in the same group if they share an observation or if one needs the other. Needed features
+ * that are not part of the given features (e.g. the station of a level of bore circles) are only read and
+ * therefore do not connect the features that need them.
+ * \param features
+ * \return
+ */
+QList<QList<QPointer<Feature> > > RecalcScheduler::getIndependentGroups(const QList<QPointer<Feature> > &features){
+
+    QList<QList<QPointer<Feature> > > result;
+
+    //ids of the features to be grouped
+    QSet<int> featureIds;
+    foreach(const QPointer<Feature> &feature, features){
+        if(!feature.isNull()){
+            featureIds.insert(feature->getId());
+        }
+    }
+
+    //union the id of each feature with the ids of its inputs (ids are unique within a job)
+    QHash<int, int> parents;
+    foreach(const QPointer<Feature> &feature, features){
+
+        if(feature.isNull()){
+            continue;
+        }
+
+        int root = findRoot(parents, feature->getId());
+
+        QList<int> inputIds;
+        foreach(const QPointer<FeatureWrapper> &needed, feature->getPreviouslyNeeded()){
+            if(!needed.isNull() && !needed->getFeature().isNull() && featureIds.contains(needed->getFeature()->getId())){
+                inputIds.append(needed->getFeature()->getId());
+            }
+        }
+        if(!feature->getFeatureWrapper().isNull() && !feature->getFeatureWrapper()->getGeometry().isNull()){
+            foreach(const QPointer<Observation> &observation, feature->getFeatureWrapper()->getGeometry()->getObservations()){
+                if(!observation.isNull()){
+                    inputIds.append(observation->getId());
+                }
+            }
+        }
+
+        foreach(const int &id, inputIds){
+            int inputRoot = findRoot(parents, id);
+            if(inputRoot != root){
+                parents.insert(inputRoot, root);
+            }
+        }
+
+    }
+
+    //collect the groups in input order
+    QHash<int, int> groupIndices;
+    foreach(const QPointer<Feature> &feature, features){
+
+        if(feature.isNull()){
+            continue;
+        }
+
+        int root = findRoot(parents, feature->getId());
+        if(!groupIndices.contains(root)){
+            groupIndices.insert(root, result.size());
+            result.append(QList<QPointer<Feature> >());
+        }
+        result[groupIndices.value(root)].append(feature);
+
+    }
+
+    return result;
+
+}
+
+/*!
+ * \brief RecalcScheduler::flush
+ * Recalculates all dirty features and their dependents once in dependency order
+ */
+void RecalcScheduler::flush(){
+
+    this->isFlushScheduled = false;
+
+    //check if there is anything to do
+    if(this->dirtyFeatures.isEmpty()){
+        return;
+    }
+
+    //take the current dirty features (invalidations during recalculation are handled by the next flush)
+    QList<QPointer<Feature> > dirty = this->dirtyFeatures.values();
+    this->dirtyFeatures.clear();
+
+    //get all affected features partitioned into dependency levels
+    QList<QList<QPointer<Feature> > > levels = RecalcScheduler::getDependencyLevels(RecalcScheduler::getAffectedFeatures(dirty));
+
+    //recalculate each feature once
+    this->lastRecalcCount = 0;
+    foreach(const QList<QPointer<Feature> > &level, levels){
+
+        if(this->parallelRecalc && level.size() > 1){
+            this->recalcGroups(RecalcScheduler::getIndependentGroups(level));
+        }else{
+            foreach(const QPointer<Feature> &feature, level){
+                if(!feature.isNull()){
+                    feature->recalc();
+                }
+            }
+        }
+
+        //inform about recalculated features on the owning thread
+        foreach(const QPointer<Feature> &feature, level){
+            if(feature.isNull()){
+                continue;
+            }
+            this->lastRecalcCount++;
+            emit this->featureRecalculated(feature->getId());
+        }
+
+    }
+
+    emit this->featuresRecalculated();
+
+}
+
+/*!
+ * \brief RecalcScheduler::relayMessage
+ * Forwards a message of a function. Functions are connected directly, so that this slot is called on the thread that
+ * executes the function. Messages sent on a pool thread are buffered and sent after the level on the owning thread.
+ * \param msg
+ * \param msgType
+ * \param msgDest
+ */
+void RecalcScheduler::relayMessage(const QString &msg, const MessageTypes &msgType, const MessageDestinations &msgDest){
+
+    //send the message immediately on the owning thread
+    if(QThread::currentThread() == this->thread()){
+        emit this->sendMessage(msg, msgType, msgDest);
+        return;
+    }
+
+    BufferedMessage message;
+    message.msg = msg;
+    message.msgType = msgType;
+    message.msgDest = msgDest;
+
+    QMutexLocker locker(&this->messageMutex);
+    this->bufferedMessages.append(message);
+
+}
+
+/*!
+ * \brief RecalcScheduler::recalcGroups
+ * Recalculates the given groups concurrently and blocks until all of them are done.
+ * The signals of the features are blocked while the functions run on the pool threads. Afterwards the changed
+ * parameters and solved states are signaled on the owning thread.
+ * \param groups
+ */
+void RecalcScheduler::recalcGroups(const QList<QList<QPointer<Feature> > > &groups){
+
+    //isolate the features so that no signal is emitted on a pool thread
+    QList<QPointer<Feature> > features;
+    QList<bool> wasBlocked;
+    QList<bool> wasSolved;
+    foreach(const QList<QPointer<Feature> > &group, groups){
+        foreach(const QPointer<Feature> &feature, group){
+            if(feature.isNull()){
+                continue;
+            }
+            features.append(feature);
+            wasSolved.append(feature->getIsSolved());
+            wasBlocked.append(feature->blockSignals(true));
+        }
+    }
+
+    QAtomicInt nextGroup(0);
+
+    //start one task per idle thread (the calling thread takes part as well)
+    int numTasks = qMin(groups.size() - 1, this->threadPool.maxThreadCount());
+    for(int i = 0; i < numTasks; i++){
+        RecalcTask *task = new RecalcTask(groups, nextGroup);
+        task->setAutoDelete(true);
+        this->threadPool.start(task);
+    }
+
+    RecalcTask task(groups, nextGroup);
+    task.run();
+
+    this->threadPool.waitForDone();
+
+    //publish the results on the owning thread
+    for(int i = 0; i < features.size(); i++){
+
+        const QPointer<Feature> &feature = features.at(i);
+        if(feature.isNull()){
+            continue;
+        }
+        feature->blockSignals(wasBlocked.at(i));
+
+        Geometry *geometry = qobject_cast<Geometry *>(feature.data());
+        if(geometry != NULL){
+            emit geometry->geomParametersChanged(geometry->getId());
+        }
+        if(feature->getIsSolved() != wasSolved.at(i)){
+            emit feature->featureIsSolvedChanged(feature->getId());
+        }
+
+    }
+
+    this->sendBufferedMessages();
+
+}
+
+/*!
+ * \brief RecalcScheduler::sendBufferedMessages
+ * Sends the messages that functions sent on pool threads in the order they were received
+ */
+void RecalcScheduler::sendBufferedMessages(){
+
+    QList<BufferedMessage> messages;
+    {
+        QMutexLocker locker(&this->messageMutex);
+        messages.swap(this->bufferedMessages);
+    }
+
+    foreach(const BufferedMessage &message, messages){
+        emit this->sendMessage(message.msg, message.msgType, message.msgDest);
+    }
+
+}
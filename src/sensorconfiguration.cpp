@@ -7,7 +7,7 @@ using namespace oi;
 /*!
  * \brief SensorConfiguration::SensorConfiguration
  */
-SensorConfiguration::SensorConfiguration() : isSaved(false){
+SensorConfiguration::SensorConfiguration() : isSaved(false), typeOfSensor(eUndefinedSensor){
 
 }
 
@@ -499,3 +499,42 @@ bool SensorConfiguration::fromOpenIndyXML(QDomElement &xmlElem){
     return true;
 
 }
+
+/*!
+ * \brief SensorConfiguration::isIdentical
+ * Compares all attributes of this and the other config
+ * \param other
+ * \return
+ */
+bool SensorConfiguration::isIdentical(const SensorConfiguration &other) const{
+
+    //compare general attributes and parameters
+    if(this->name != other.name || this->isSaved != other.isSaved || this->pluginName != other.pluginName
+            || this->sensorName != other.sensorName || this->typeOfSensor != other.typeOfSensor
+            || this->integerParameter != other.integerParameter || this->doubleParameter != other.doubleParameter
+            || this->stringParameter != other.stringParameter || this->availableStringParameter != other.availableStringParameter){
+        return false;
+    }
+
+    //compare accuracy
+    if(this->accuracy.sigmaAzimuth != other.accuracy.sigmaAzimuth || this->accuracy.sigmaZenith != other.accuracy.sigmaZenith
+            || this->accuracy.sigmaDistance != other.accuracy.sigmaDistance || this->accuracy.sigmaTemp != other.accuracy.sigmaTemp
+            || this->accuracy.sigmaI != other.accuracy.sigmaI || this->accuracy.sigmaJ != other.accuracy.sigmaJ
+            || this->accuracy.sigmaK != other.accuracy.sigmaK || this->accuracy.sigmaUndefined != other.accuracy.sigmaUndefined
+            || this->accuracy.sigmaXyz.getSize() != other.accuracy.sigmaXyz.getSize()){
+        return false;
+    }
+    for(int i = 0; i < this->accuracy.sigmaXyz.getSize(); i++){
+        if(this->accuracy.sigmaXyz.getAt(i) != other.accuracy.sigmaXyz.getAt(i)){
+            return false;
+        }
+    }
+
+    //compare connection
+    return this->cConfig.typeOfConnection == other.cConfig.typeOfConnection && this->cConfig.ip == other.cConfig.ip
+            && this->cConfig.port == other.cConfig.port && this->cConfig.comPort == other.cConfig.comPort
+            && this->cConfig.baudRate == other.cConfig.baudRate && this->cConfig.dataBits == other.cConfig.dataBits
+            && this->cConfig.parity == other.cConfig.parity && this->cConfig.stopBits == other.cConfig.stopBits
+            && this->cConfig.flowControl == other.cConfig.flowControl;
+
+}
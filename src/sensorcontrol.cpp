@@ -1,5 +1,7 @@
 #include "sensorcontrol.h"
 
+#include <QMetaMethod>
+
 using namespace oi;
 
 /*!
@@ -138,17 +140,7 @@ void SensorControl::setUsedSensors(const QList<Sensor> &sensors){
  * \return
  */
 ReadingTypes SensorControl::getStreamFormat(){
-
-    //call method of sensor worker
-    ReadingTypes type = eUndefinedReading;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getStreamFormat", Qt::DirectConnection,
-                                                Q_RETURN_ARG(ReadingTypes, type));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return type;
-
+    return this->worker->getState().streamFormat;
 }
 
 /*!
@@ -179,17 +171,7 @@ bool SensorControl::getIsSensorSet(){
  * \return
  */
 bool SensorControl::getIsSensorConnected(){
-
-    //call method of sensor worker
-    bool isConnected = false;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getIsSensorConnected", Qt::DirectConnection,
-                                                Q_RETURN_ARG(bool, isConnected));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return isConnected;
-
+    return this->worker->getState().isConnected;
 }
 
 /*!
@@ -197,17 +179,7 @@ bool SensorControl::getIsSensorConnected(){
  * \return
  */
 bool SensorControl::getIsReadyForMeasurement(){
-
-    //call method of sensor worker
-    bool isReady = false;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getIsReadyForMeasurement", Qt::DirectConnection,
-                                                Q_RETURN_ARG(bool, isReady));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return isReady;
-
+    return this->worker->getState().isReadyForMeasurement;
 }
 
 /*!
@@ -215,17 +187,7 @@ bool SensorControl::getIsReadyForMeasurement(){
  * \return
  */
 bool SensorControl::getIsBusy(){
-
-    //call method of sensor worker
-    bool isBusy = false;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getIsBusy", Qt::DirectConnection,
-                                                Q_RETURN_ARG(bool, isBusy));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return isBusy;
-
+    return this->worker->getState().isBusy;
 }
 
 /*!
@@ -233,17 +195,7 @@ bool SensorControl::getIsBusy(){
  * \return
  */
 QMap<QString, QString> SensorControl::getSensorStatus(){
-
-    //call method of sensor worker
-    QMap<QString, QString> status;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSensorStatus", Qt::DirectConnection,
-                                                Q_RETURN_ARG(StringStringMap, status));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return status;
-
+    return this->worker->getState().status;
 }
 
 /*!
@@ -251,17 +203,7 @@ QMap<QString, QString> SensorControl::getSensorStatus(){
  * \return
  */
 SensorTypes SensorControl::getActiveSensorType(){
-
-    //call method of sensor worker
-    SensorTypes type;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getActiveSensorType", Qt::DirectConnection,
-                                                Q_RETURN_ARG(SensorTypes, type));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return type;
-
+    return this->worker->getState().activeSensorType;
 }
 
 /*!
@@ -269,17 +211,7 @@ SensorTypes SensorControl::getActiveSensorType(){
  * \return
  */
 QList<ReadingTypes> SensorControl::getSupportedReadingTypes(){
-
-    //call method of sensor worker
-    QList<ReadingTypes> types;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSupportedReadingTypes", Qt::DirectConnection,
-                                                Q_RETURN_ARG(QList<ReadingTypes>, types));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return types;
-
+    return this->worker->getState().supportedReadingTypes;
 }
 
 /*!
@@ -287,17 +219,7 @@ QList<ReadingTypes> SensorControl::getSupportedReadingTypes(){
  * \return
  */
 QList<ConnectionTypes> SensorControl::getSupportedConnectionTypes(){
-
-    //call method of sensor worker
-    QList<ConnectionTypes> types;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSupportedConnectionTypes", Qt::DirectConnection,
-                                                Q_RETURN_ARG(QList<ConnectionTypes>, types));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return types;
-
+    return this->worker->getState().supportedConnectionTypes;
 }
 
 /*!
@@ -305,17 +227,7 @@ QList<ConnectionTypes> SensorControl::getSupportedConnectionTypes(){
  * \return
  */
 QList<SensorFunctions> SensorControl::getSupportedSensorActions(){
-
-    //call method of sensor worker
-    QList<SensorFunctions> actions;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSupportedSensorActions", Qt::DirectConnection,
-                                                Q_RETURN_ARG(QList<SensorFunctions>, actions));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return actions;
-
+    return this->worker->getState().supportedSensorActions;
 }
 
 /*!
@@ -323,17 +235,7 @@ QList<SensorFunctions> SensorControl::getSupportedSensorActions(){
  * \return
  */
 QStringList SensorControl::getSelfDefinedActions(){
-
-    //call method of sensor worker
-    QStringList actions;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSelfDefinedActions", Qt::DirectConnection,
-                                                Q_RETURN_ARG(QStringList, actions));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return actions;
-
+    return this->worker->getState().selfDefinedActions;
 }
 
 /*!
@@ -341,17 +243,7 @@ QStringList SensorControl::getSelfDefinedActions(){
  * \return
  */
 SensorConfiguration SensorControl::getSensorConfiguration(){
-
-    //call method of sensor worker
-    SensorConfiguration sConfig;
-    bool hasInvoked = QMetaObject::invokeMethod(this->worker, "getSensorConfiguration", Qt::DirectConnection,
-                                                Q_RETURN_ARG(SensorConfiguration, sConfig));
-    if(!hasInvoked){
-        emit this->sensorMessage("Cannot invoke getSensor method of sensor worker", eErrorMessage, eConsoleMessage);
-    }
-
-    return sConfig;
-
+    return this->worker->getState().sensorConfiguration;
 }
 
 /*!
@@ -623,6 +515,42 @@ void SensorControl::stopStatusMonitoringStream(){
 
 }
 
+/*!
+ * \brief SensorControl::getStreamSettings
+ * \param stream
+ * \return
+ */
+StreamSettings SensorControl::getStreamSettings(const SensorStreams &stream){
+    return this->worker->getStreamSettings(stream);
+}
+
+/*!
+ * \brief SensorControl::setStreamSettings
+ * Sets the target rate, the buffer size and the overflow policy of the given stream
+ * \param stream
+ * \param settings
+ */
+void SensorControl::setStreamSettings(const SensorStreams &stream, const StreamSettings &settings){
+    this->worker->setStreamSettings(stream, settings);
+}
+
+/*!
+ * \brief SensorControl::getStreamStatistics
+ * \param stream
+ * \return
+ */
+StreamStatistics SensorControl::getStreamStatistics(const SensorStreams &stream){
+    return this->worker->getStreamStatistics(stream);
+}
+
+/*!
+ * \brief SensorControl::resetStreamStatistics
+ * \param stream
+ */
+void SensorControl::resetStreamStatistics(const SensorStreams &stream){
+    this->worker->resetStreamStatistics(stream);
+}
+
 void SensorControl::finishMeasurement(){
 
     //call method of sensor worker
@@ -646,10 +574,9 @@ void SensorControl::connectSensorWorker(){
     QObject::connect(this->worker, &SensorWorker::measurementDone, this, &SensorControl::measurementDone, Qt::QueuedConnection);
 
     //connect streaming results
-    QObject::connect(this->worker, &SensorWorker::realTimeReading, this, &SensorControl::realTimeReading, Qt::QueuedConnection);
-    QObject::connect(this->worker, &SensorWorker::realTimeStatus, this, &SensorControl::realTimeStatus, Qt::QueuedConnection);
-    QObject::connect(this->worker, &SensorWorker::connectionLost, this, &SensorControl::connectionLost, Qt::QueuedConnection);
-    QObject::connect(this->worker, &SensorWorker::connectionReceived, this, &SensorControl::connectionReceived, Qt::QueuedConnection);
+    QObject::connect(this->worker, &SensorWorker::realTimeReadingAvailable, this, &SensorControl::takeRealTimeReadings, Qt::QueuedConnection);
+    QObject::connect(this->worker, &SensorWorker::realTimeStatusAvailable, this, &SensorControl::takeRealTimeStatus, Qt::QueuedConnection);
+    QObject::connect(this->worker, &SensorWorker::connectionStatusAvailable, this, &SensorControl::takeConnectionStatus, Qt::QueuedConnection);
     QObject::connect(this->worker, &SensorWorker::isReadyForMeasurement, this, &SensorControl::isReadyForMeasurement, Qt::QueuedConnection);
 
     //connect sensor messages
@@ -657,6 +584,53 @@ void SensorControl::connectSensorWorker(){
 
 }
 
+/*!
+ * \brief SensorControl::takeRealTimeReadings
+ * Emits all readings that were buffered since the worker's last notification.
+ * Typed readings are emitted as one batch and are only converted to QVariantMap if realTimeReading is connected.
+ */
+void SensorControl::takeRealTimeReadings(){
+
+    //readings of sensors that stream typed samples
+    QVector<RealTimeReading> samples;
+    if(this->worker->takeRealTimeReadingSamples(samples) > 0){
+        emit this->realTimeReadingSamples(samples);
+        if(this->isSignalConnected(QMetaMethod::fromSignal(&SensorControl::realTimeReading))){
+            foreach(const RealTimeReading &sample, samples){
+                emit this->realTimeReading(sample.toVariantMap());
+            }
+        }
+    }
+
+    //readings of sensors that stream QVariantMap
+    foreach(const StreamSample<QVariantMap> &sample, this->worker->takeRealTimeReadings()){
+        emit this->realTimeReading(sample.data);
+    }
+
+}
+
+/*!
+ * \brief SensorControl::takeRealTimeStatus
+ */
+void SensorControl::takeRealTimeStatus(){
+    foreach(const StreamSample<StringStringMap> &sample, this->worker->takeRealTimeStatus()){
+        emit this->realTimeStatus(sample.data);
+    }
+}
+
+/*!
+ * \brief SensorControl::takeConnectionStatus
+ */
+void SensorControl::takeConnectionStatus(){
+    foreach(const StreamSample<bool> &sample, this->worker->takeConnectionStatus()){
+        if(sample.data){
+            emit this->connectionReceived();
+        }else{
+            emit this->connectionLost();
+        }
+    }
+}
+
 /*!
  * \brief SensorControl::disconnectSensorWorker
  */
@@ -664,6 +638,18 @@ void SensorControl::disconnectSensorWorker(){
 
 }
 
+/*!
+ * \brief SensorControl::setSensorWorkerThread
+ * Moves the sensor worker to the given thread. A worker that already lives in another running thread
+ * can only be pushed by that thread, so the caller waits until the worker has finished its current action.
+ * \param t
+ */
 void SensorControl::setSensorWorkerThread(QPointer<QThread> t) {
+    QThread *current = this->worker->thread();
+    if(current != QThread::currentThread() && current != NULL && current->isRunning()){
+        QMetaObject::invokeMethod(this->worker, "moveToWorkerThread", Qt::BlockingQueuedConnection,
+                                  Q_ARG(QThread*, t.data()));
+        return;
+    }
     this->worker->moveToThread(t);
 }
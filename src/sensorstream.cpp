@@ -0,0 +1,354 @@
+#include "sensorstream.h"
+
+#include <QThread>
+
+using namespace oi;
+
+namespace{
+
+bool getValue(const QVariantMap &reading, const QString &key, double &value){
+    QVariantMap::const_iterator it = reading.constFind(key);
+    if(it == reading.constEnd()){
+        return false;
+    }
+    bool isNumber = false;
+    value = it.value().toDouble(&isNumber);
+    return isNumber;
+}
+
+QElapsedTimer startAcquisitionClock(){
+    QElapsedTimer clock;
+    clock.start();
+    return clock;
+}
+
+}
+
+/*!
+ * \brief AcquisitionClock::getTimestamp
+ * \return
+ */
+qint64 AcquisitionClock::getTimestamp(){
+    static const QElapsedTimer clock = startAcquisitionClock();
+    return clock.nsecsElapsed();
+}
+
+/*!
+ * \brief RealTimeReading::fromVariantMap
+ * Converts a reading of the given type that was streamed as QVariantMap
+ * \param type
+ * \param reading
+ * \param sample
+ * \return false if a value of the reading type is missing
+ */
+bool RealTimeReading::fromVariantMap(const ReadingTypes &type, const QVariantMap &reading, RealTimeReading &sample){
+
+    sample = RealTimeReading();
+    sample.type = type;
+
+    switch(type){
+    case ePolarReading:
+        return getValue(reading, "azimuth", sample.polar.azimuth)
+                && getValue(reading, "zenith", sample.polar.zenith)
+                && getValue(reading, "distance", sample.polar.distance);
+    case eDirectionReading:
+        return getValue(reading, "azimuth", sample.direction.azimuth)
+                && getValue(reading, "zenith", sample.direction.zenith);
+    case eDistanceReading:
+        return getValue(reading, "distance", sample.distance.distance);
+    case eCartesianReading:
+        return getValue(reading, "x", sample.cartesian.x)
+                && getValue(reading, "y", sample.cartesian.y)
+                && getValue(reading, "z", sample.cartesian.z);
+    case eCartesianReading6D:
+        return getValue(reading, "x", sample.cartesian6D.x)
+                && getValue(reading, "y", sample.cartesian6D.y)
+                && getValue(reading, "z", sample.cartesian6D.z)
+                && getValue(reading, "i", sample.cartesian6D.i)
+                && getValue(reading, "j", sample.cartesian6D.j)
+                && getValue(reading, "k", sample.cartesian6D.k);
+    case eTemperatureReading:
+        return getValue(reading, "temperature", sample.temperature.temperature);
+    case eLevelReading:
+        return getValue(reading, "i", sample.level.i)
+                && getValue(reading, "j", sample.level.j)
+                && getValue(reading, "k", sample.level.k);
+    default:
+        sample.type = eUndefinedReading;
+        return false;
+    }
+
+}
+
+/*!
+ * \brief RealTimeReading::toVariantMap
+ * \return
+ */
+QVariantMap RealTimeReading::toVariantMap() const{
+
+    QVariantMap reading;
+
+    switch(this->type){
+    case ePolarReading:
+        reading.insert("azimuth", this->polar.azimuth);
+        reading.insert("zenith", this->polar.zenith);
+        reading.insert("distance", this->polar.distance);
+        break;
+    case eDirectionReading:
+        reading.insert("azimuth", this->direction.azimuth);
+        reading.insert("zenith", this->direction.zenith);
+        break;
+    case eDistanceReading:
+        reading.insert("distance", this->distance.distance);
+        break;
+    case eCartesianReading:
+        reading.insert("x", this->cartesian.x);
+        reading.insert("y", this->cartesian.y);
+        reading.insert("z", this->cartesian.z);
+        break;
+    case eCartesianReading6D:
+        reading.insert("x", this->cartesian6D.x);
+        reading.insert("y", this->cartesian6D.y);
+        reading.insert("z", this->cartesian6D.z);
+        reading.insert("i", this->cartesian6D.i);
+        reading.insert("j", this->cartesian6D.j);
+        reading.insert("k", this->cartesian6D.k);
+        break;
+    case eTemperatureReading:
+        reading.insert("temperature", this->temperature.temperature);
+        break;
+    case eLevelReading:
+        reading.insert("i", this->level.i);
+        reading.insert("j", this->level.j);
+        reading.insert("k", this->level.k);
+        break;
+    default:
+        break;
+    }
+
+    return reading;
+
+}
+
+/*!
+ * \brief RealTimeReadingChannel::RealTimeReadingChannel
+ * \param settings
+ */
+RealTimeReadingChannel::RealTimeReadingChannel(const StreamSettings &settings) : state(0), buffer(NULL), mask(0), bufferSize(0),
+    head(0), tail(0), isNotified(0), produced(0), dropped(0){
+    this->setSettings(settings);
+}
+
+/*!
+ * \brief RealTimeReadingChannel::getSettings
+ * \return
+ */
+StreamSettings RealTimeReadingChannel::getSettings() const{
+    QMutexLocker locker(&this->settingsMutex);
+    return this->settings;
+}
+
+/*!
+ * \brief RealTimeReadingChannel::setSettings
+ * Changing the settings discards all buffered samples
+ * \param settings
+ */
+void RealTimeReadingChannel::setSettings(const StreamSettings &settings){
+
+    this->lockExclusive();
+
+    QMutexLocker locker(&this->settingsMutex);
+    this->settings = settings;
+    this->settings.bufferSize = qMax(1, settings.bufferSize);
+    this->bufferSize = this->settings.bufferSize;
+    locker.unlock();
+
+    //the ring has the next power of two size, so that indices are wrapped by a mask
+    quint32 size = 1;
+    while(size < this->bufferSize){
+        size <<= 1;
+    }
+    this->samples = QVector<RealTimeReading>(size);
+    this->buffer = this->samples.data();
+    this->mask = size - 1;
+    this->head.store(0);
+    this->tail.store(0);
+    this->isNotified.store(0);
+
+    this->unlockExclusive();
+
+}
+
+/*!
+ * \brief RealTimeReadingChannel::getStatistics
+ * \return
+ */
+StreamStatistics RealTimeReadingChannel::getStatistics() const{
+
+    QMutexLocker locker(&this->statisticsMutex);
+    StreamStatistics statistics = this->consumerStatistics;
+    locker.unlock();
+
+    statistics.produced = this->produced.load();
+    statistics.dropped = this->dropped.load();
+    return statistics;
+
+}
+
+/*!
+ * \brief RealTimeReadingChannel::resetStatistics
+ */
+void RealTimeReadingChannel::resetStatistics(){
+    QMutexLocker locker(&this->statisticsMutex);
+    this->consumerStatistics = StreamStatistics();
+    this->produced.store(0);
+    this->dropped.store(0);
+}
+
+/*!
+ * \brief RealTimeReadingChannel::push
+ * Adds a sample and returns true if the consumer has to be notified
+ * \param sample
+ * \param timestamp
+ * \return
+ */
+bool RealTimeReadingChannel::push(const RealTimeReading &sample, const qint64 &timestamp){
+
+    this->produced.fetchAndAddRelaxed(1);
+
+    //the settings are changed at the moment
+    if(!this->lock(eProducer)){
+        this->dropped.fetchAndAddRelaxed(1);
+        return false;
+    }
+
+    quint32 currentHead = this->head.load();
+    quint32 currentTail = this->tail.loadAcquire();
+
+    //buffer is full
+    if(currentHead - currentTail >= this->bufferSize){
+        if(this->settings.overflowPolicy == eDropNewestSample){
+            this->dropped.fetchAndAddRelaxed(1);
+            this->unlock(eProducer);
+            return false;
+        }
+
+        //discard the oldest sample (unless the consumer has taken it in the meantime)
+        if(this->tail.testAndSetOrdered(currentTail, currentTail + 1)){
+            this->dropped.fetchAndAddRelaxed(1);
+        }
+    }
+
+    //publish the sample
+    RealTimeReading &slot = this->buffer[currentHead & this->mask];
+    slot = sample;
+    slot.timestamp = timestamp;
+    this->head.storeRelease(currentHead + 1);
+
+    //notify the consumer once until it takes the samples
+    bool notify = (this->isNotified.fetchAndStoreOrdered(1) == 0);
+
+    this->unlock(eProducer);
+
+    return notify;
+
+}
+
+/*!
+ * \brief RealTimeReadingChannel::takeAll
+ * \param samples
+ * \return
+ */
+int RealTimeReadingChannel::takeAll(QVector<RealTimeReading> &samples){
+
+    //the settings are changed at the moment
+    if(!this->lock(eConsumer)){
+        return 0;
+    }
+
+    //samples that are pushed from now on require a new notification
+    this->isNotified.fetchAndStoreOrdered(0);
+
+    int first = samples.size();
+    forever{
+
+        quint32 currentTail = this->tail.loadAcquire();
+        if(currentTail == this->head.loadAcquire()){
+            break;
+        }
+
+        //the copy is only valid if the producer did not drop the sample while it was copied
+        RealTimeReading sample = this->buffer[currentTail & this->mask];
+        if(this->tail.testAndSetOrdered(currentTail, currentTail + 1)){
+            samples.append(sample);
+        }
+
+    }
+
+    this->unlock(eConsumer);
+
+    //update latency statistics
+    QMutexLocker locker(&this->statisticsMutex);
+    qint64 now = StreamBuffer<RealTimeReading>::getTimestamp();
+    for(int i = first; i < samples.size(); i++){
+        double latency = now - samples.at(i).timestamp;
+        this->consumerStatistics.meanLatency += (latency - this->consumerStatistics.meanLatency) / (this->consumerStatistics.delivered + 1);
+        this->consumerStatistics.maxLatency = qMax(this->consumerStatistics.maxLatency, latency);
+        this->consumerStatistics.delivered++;
+    }
+
+    return samples.size() - first;
+
+}
+
+/*!
+ * \brief RealTimeReadingChannel::getSize
+ * \return
+ */
+int RealTimeReadingChannel::getSize() const{
+    quint32 currentTail = this->tail.loadAcquire();
+    return this->head.loadAcquire() - currentTail;
+}
+
+/*!
+ * \brief RealTimeReadingChannel::lock
+ * Registers the producer or the consumer unless the settings are changed at the moment
+ * \param user
+ * \return
+ */
+bool RealTimeReadingChannel::lock(const int &user){
+    forever{
+        int current = this->state.loadAcquire();
+        if(current & eExclusive){
+            return false;
+        }
+        if(this->state.testAndSetAcquire(current, current | user)){
+            return true;
+        }
+    }
+}
+
+/*!
+ * \brief RealTimeReadingChannel::unlock
+ * \param user
+ */
+void RealTimeReadingChannel::unlock(const int &user){
+    this->state.fetchAndAddRelease(-user);
+}
+
+/*!
+ * \brief RealTimeReadingChannel::lockExclusive
+ * Waits until neither the producer nor the consumer accesses the ring
+ */
+void RealTimeReadingChannel::lockExclusive(){
+    while(!this->state.testAndSetAcquire(0, eExclusive)){
+        QThread::yieldCurrentThread();
+    }
+}
+
+/*!
+ * \brief RealTimeReadingChannel::unlockExclusive
+ */
+void RealTimeReadingChannel::unlockExclusive(){
+    this->state.fetchAndAddRelease(-eExclusive);
+}
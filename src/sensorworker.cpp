@@ -2,6 +2,36 @@
 
 using namespace oi;
 
+namespace{
+
+//! statistics of the reading stream of typed and untyped sensors
+StreamStatistics mergeStreamStatistics(const StreamStatistics &first, const StreamStatistics &second){
+    StreamStatistics statistics;
+    statistics.produced = first.produced + second.produced;
+    statistics.delivered = first.delivered + second.delivered;
+    statistics.dropped = first.dropped + second.dropped;
+    statistics.coalesced = first.coalesced + second.coalesced;
+    if(statistics.delivered > 0){
+        statistics.meanLatency = (first.meanLatency * first.delivered + second.meanLatency * second.delivered) / statistics.delivered;
+    }
+    statistics.maxLatency = qMax(first.maxLatency, second.maxLatency);
+    return statistics;
+}
+
+//! stamps the readings that were not stamped by the sensor itself with the shared acquisition clock
+//! and converts the polar readings, that were not converted by the sensor, at once
+void prepareReadings(const QList<QPointer<Reading> > &readings){
+    Reading::convertPolarReadings(readings);
+    qint64 timestamp = AcquisitionClock::getTimestamp();
+    foreach(const QPointer<Reading> &reading, readings){
+        if(!reading.isNull() && reading->getAcquisitionTime() == 0){
+            reading->setAcquisitionTime(timestamp);
+        }
+    }
+}
+
+}
+
 /*!
  * \brief SensorWorker::SensorWorker
  * \param locker
@@ -9,7 +39,21 @@ using namespace oi;
  */
 SensorWorker::SensorWorker(QObject *parent) : QObject(parent), isSensorConnected(false),
     isReadingStreamStarted(false), isConnectionStreamStarted(false), isStatusStreamStarted(false),
-    streamFormat(eUndefinedReading){
+    streamFormat(eUndefinedReading),
+    statusStreamBuffer(StreamSettings(0.0, 1, eCoalesceSamples)),
+    connectionStreamBuffer(StreamSettings(0.0, 16, eDropOldestSample)),
+    readingStreamTimer(this), statusStreamTimer(this), connectionStreamTimer(this){
+
+    //the stream timers are restarted after each stream cycle
+    this->readingStreamTimer.setSingleShot(true);
+    this->readingStreamTimer.setTimerType(Qt::PreciseTimer);
+    this->statusStreamTimer.setSingleShot(true);
+    this->connectionStreamTimer.setSingleShot(true);
+    QObject::connect(&this->readingStreamTimer, &QTimer::timeout, this, &SensorWorker::streamReading, Qt::AutoConnection);
+    QObject::connect(&this->statusStreamTimer, &QTimer::timeout, this, &SensorWorker::streamStatus, Qt::AutoConnection);
+    QObject::connect(&this->connectionStreamTimer, &QTimer::timeout, this, &SensorWorker::monitorConnectionStatus, Qt::AutoConnection);
+
+    this->publishState();
 
 }
 
@@ -20,6 +64,124 @@ SensorWorker::~SensorWorker(){
 
 }
 
+/*!
+ * \brief SensorWorker::getStreamSettings
+ * \param stream
+ * \return
+ */
+StreamSettings SensorWorker::getStreamSettings(const SensorStreams &stream) const{
+    switch(stream){
+    case eReadingStream:
+        return this->readingStreamChannel.getSettings();
+    case eStatusStream:
+        return this->statusStreamBuffer.getSettings();
+    case eConnectionStream:
+        return this->connectionStreamBuffer.getSettings();
+    }
+    return StreamSettings();
+}
+
+/*!
+ * \brief SensorWorker::setStreamSettings
+ * Sets the target rate and the buffer configuration of the given stream (discards buffered samples)
+ * \param stream
+ * \param settings
+ */
+void SensorWorker::setStreamSettings(const SensorStreams &stream, const StreamSettings &settings){
+    switch(stream){
+    case eReadingStream:
+        this->readingStreamChannel.setSettings(settings);
+        this->readingStreamBuffer.setSettings(settings);
+        break;
+    case eStatusStream:
+        this->statusStreamBuffer.setSettings(settings);
+        break;
+    case eConnectionStream:
+        this->connectionStreamBuffer.setSettings(settings);
+        break;
+    }
+}
+
+/*!
+ * \brief SensorWorker::getStreamStatistics
+ * \param stream
+ * \return
+ */
+StreamStatistics SensorWorker::getStreamStatistics(const SensorStreams &stream) const{
+    switch(stream){
+    case eReadingStream:
+        return mergeStreamStatistics(this->readingStreamChannel.getStatistics(), this->readingStreamBuffer.getStatistics());
+    case eStatusStream:
+        return this->statusStreamBuffer.getStatistics();
+    case eConnectionStream:
+        return this->connectionStreamBuffer.getStatistics();
+    }
+    return StreamStatistics();
+}
+
+/*!
+ * \brief SensorWorker::resetStreamStatistics
+ * \param stream
+ */
+void SensorWorker::resetStreamStatistics(const SensorStreams &stream){
+    switch(stream){
+    case eReadingStream:
+        this->readingStreamChannel.resetStatistics();
+        this->readingStreamBuffer.resetStatistics();
+        break;
+    case eStatusStream:
+        this->statusStreamBuffer.resetStatistics();
+        break;
+    case eConnectionStream:
+        this->connectionStreamBuffer.resetStatistics();
+        break;
+    }
+}
+
+/*!
+ * \brief SensorWorker::takeRealTimeReadings
+ * Takes all buffered readings (called by the consumer after realTimeReadingAvailable was emitted)
+ * \return
+ */
+QList<StreamSample<QVariantMap> > SensorWorker::takeRealTimeReadings(){
+    return this->readingStreamBuffer.takeAll();
+}
+
+/*!
+ * \brief SensorWorker::takeRealTimeReadingSamples
+ * Appends all buffered typed readings (must only be called by one consumer)
+ * \param samples
+ * \return number of taken samples
+ */
+int SensorWorker::takeRealTimeReadingSamples(QVector<RealTimeReading> &samples){
+    return this->readingStreamChannel.takeAll(samples);
+}
+
+/*!
+ * \brief SensorWorker::getState
+ * Returns the latest published state of the current sensor without accessing the sensor (may be called from any thread)
+ * \return
+ */
+SensorState SensorWorker::getState() const{
+    return this->sensorState.get();
+}
+
+/*!
+ * \brief SensorWorker::takeRealTimeStatus
+ * \return
+ */
+QList<StreamSample<QMap<QString, QString> > > SensorWorker::takeRealTimeStatus(){
+    return this->statusStreamBuffer.takeAll();
+}
+
+/*!
+ * \brief SensorWorker::takeConnectionStatus
+ * \return
+ */
+QList<StreamSample<bool> > SensorWorker::takeConnectionStatus(){
+    return this->connectionStreamBuffer.takeAll();
+}
+
 /*!
  * \brief SensorWorker::getSensor
  * \return
@@ -51,8 +213,11 @@ void SensorWorker::setSensor(QPointer<Sensor> sensor){
         QObject::connect(sensor, &Sensor::asyncSensorResponse, this, &SensorWorker::asyncSensorResponseReceived, Qt::AutoConnection);
         QObject::connect(sensor, &Sensor::asyncMeasurementResult, this, &SensorWorker::asyncSensorMeasurementReceived, Qt::AutoConnection);
         QObject::connect(sensor, &Sensor::asyncStreamResult, this, &SensorWorker::asyncSensorStreamDataReceived, Qt::AutoConnection);
+        QObject::connect(sensor, &Sensor::asyncStreamSample, this, &SensorWorker::asyncSensorStreamSampleReceived, Qt::AutoConnection);
     }
 
+    this->publishState();
+
 }
 
 /*!
@@ -70,10 +235,12 @@ QPointer<Sensor> SensorWorker::takeSensor(){
         QObject::disconnect(sensor, &Sensor::asyncSensorResponse, this, &SensorWorker::asyncSensorResponseReceived);
         QObject::disconnect(sensor, &Sensor::asyncMeasurementResult, this, &SensorWorker::asyncSensorMeasurementReceived);
         QObject::disconnect(sensor, &Sensor::asyncStreamResult, this, &SensorWorker::asyncSensorStreamDataReceived);
+        QObject::disconnect(sensor, &Sensor::asyncStreamSample, this, &SensorWorker::asyncSensorStreamSampleReceived);
     }
 
     //set sensor pointer to NULL pointer
     this->sensor = QPointer<Sensor>(NULL);
+    this->publishState();
 
     return sensor;
 
@@ -94,12 +261,15 @@ void SensorWorker::resetSensor(){
         QObject::disconnect(sensor, &Sensor::asyncSensorResponse, this, &SensorWorker::asyncSensorResponseReceived);
         QObject::disconnect(sensor, &Sensor::asyncMeasurementResult, this, &SensorWorker::asyncSensorMeasurementReceived);
         QObject::disconnect(sensor, &Sensor::asyncStreamResult, this, &SensorWorker::asyncSensorStreamDataReceived);
+        QObject::disconnect(sensor, &Sensor::asyncStreamSample, this, &SensorWorker::asyncSensorStreamSampleReceived);
 
         //delete sensor
         delete this->sensor.data();
 
     }
 
+    this->publishState();
+
 }
 
 /*!
@@ -247,7 +417,11 @@ void SensorWorker::search() {
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     const bool success = this->sensor->search();
+    this->publishState();
 
     emit this->commandFinished(success, success ? SensorWorkerMessage::SEARCH_FINISHED : SensorWorkerMessage::FAILED_TO_SEARCH);
 }
@@ -280,6 +454,7 @@ void SensorWorker::setSensorConfiguration(SensorConfiguration sConfig){
     }
 
     this->sensor->setSensorConfiguration(sConfig);
+    this->publishState();
 
 }
 
@@ -294,6 +469,9 @@ void SensorWorker::connectSensor(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::SENSOR_CONNECTED;
     bool success = false;
@@ -312,12 +490,14 @@ void SensorWorker::connectSensor(){
             }
 
         }
+        this->publishState();
         emit this->commandFinished(success, msg);
     }else{
         QJsonObject request;
         request.insert("method", "connect");
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -335,6 +515,9 @@ void SensorWorker::disconnectSensor(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::SENSOR_DISCONNECTED;
     bool success = false;
@@ -358,11 +541,13 @@ void SensorWorker::disconnectSensor(){
         request.insert("method", "disconnect");
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
 
 
+    this->publishState();
     emit this->commandFinished(success, msg);
 
 }
@@ -380,6 +565,9 @@ void SensorWorker::measure(int geomId, MeasurementConfig mConfig){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_MEASURE;
     bool success = false;
@@ -392,6 +580,7 @@ void SensorWorker::measure(int geomId, MeasurementConfig mConfig){
 
             //measure
             readings = this->sensor->measure(mConfig);
+            prepareReadings(readings);
             if(readings.size() > 0){
                 msg = SensorWorkerMessage::MEASUREMENT_FINISHED;
                 success = true;
@@ -399,6 +588,8 @@ void SensorWorker::measure(int geomId, MeasurementConfig mConfig){
 
         }
 
+        this->publishState();
+
         // same logic like SensorWorker::asyncSensorMeasurementReceived
         emit this->measurementDone(success);
 
@@ -414,6 +605,7 @@ void SensorWorker::measure(int geomId, MeasurementConfig mConfig){
         this->sensor->setMeasurementConfig(mConfig);
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -438,6 +630,9 @@ void SensorWorker::move(double azimuth, double zenith, double distance, bool isR
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_MOVE_SENSOR;
     bool success = false;
@@ -464,6 +659,7 @@ void SensorWorker::move(double azimuth, double zenith, double distance, bool isR
 
                 //start measure
                 readings = this->sensor->measure(mConfig);
+                prepareReadings(readings);
                 if(readings.size() > 0){
                     msg.append(", measurement finished");
                 }else{
@@ -477,6 +673,7 @@ void SensorWorker::move(double azimuth, double zenith, double distance, bool isR
 
     }
 
+    this->publishState();
     emit this->commandFinished(success, msg);
     if(success && measure){
         emit this->measurementFinished(geomId, readings);
@@ -501,6 +698,9 @@ void SensorWorker::move(double x, double y, double z, bool measure, int geomId,
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     if(!this->sensor->isSensorAsync()){
         //check wether the sensor is already connected
         QString msg = SensorWorkerMessage::FAILED_TO_MOVE_SENSOR;
@@ -528,6 +728,7 @@ void SensorWorker::move(double x, double y, double z, bool measure, int geomId,
 
                     //start measure
                     readings = this->sensor->measure(mConfig);
+                    prepareReadings(readings);
                     if(readings.size() > 0){
                         msg = SensorWorkerMessage::MOVING_SENSOR_FINISHED_MEASUREMENT_FINISHED;
                     }else{
@@ -541,6 +742,7 @@ void SensorWorker::move(double x, double y, double z, bool measure, int geomId,
 
         }
 
+        this->publishState();
         emit this->commandFinished(success, msg);
         if(success && measure){
             emit this->measurementFinished(geomId, readings);
@@ -553,6 +755,7 @@ void SensorWorker::move(double x, double y, double z, bool measure, int geomId,
         request.insert("z", z);
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -571,6 +774,9 @@ void SensorWorker::initialize(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     if(!this->sensor->isSensorAsync()){
         QString msg = SensorWorkerMessage::FAILED_TO_INITIALIZE_SENSOR;
@@ -587,12 +793,14 @@ void SensorWorker::initialize(){
 
         }
 
+        this->publishState();
         emit this->commandFinished(success, msg);
     }else{
         QJsonObject request;
         request.insert("method", "initialize");
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -610,6 +818,9 @@ void SensorWorker::motorState(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_CHANGE_MOTOR_STATE;
     bool success = false;
@@ -625,6 +836,7 @@ void SensorWorker::motorState(){
 
     }
 
+    this->publishState();
     emit this->commandFinished(success, msg);
 
 }
@@ -640,6 +852,9 @@ void SensorWorker::home(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_SET_SENSOR_TO_HOME_POSITION;
     bool success = false;
@@ -655,6 +870,7 @@ void SensorWorker::home(){
 
     }
 
+    this->publishState();
     emit this->commandFinished(success, msg);
 
 }
@@ -670,6 +886,9 @@ void SensorWorker::toggleSight(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_TOGGLE_SIGHT_ORIENTATION;
     bool success = false;
@@ -687,12 +906,14 @@ void SensorWorker::toggleSight(){
 
         }
 
+        this->publishState();
         emit this->commandFinished(success, msg);
     }else{
         QJsonObject request;
         request.insert("method", "toggle sight orientation");
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -711,6 +932,9 @@ void SensorWorker::compensation(){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_START_COMPENSATION;
     bool success = false;
@@ -726,6 +950,7 @@ void SensorWorker::compensation(){
 
     }
 
+    this->publishState();
     emit this->commandFinished(success, msg);
 
 }
@@ -742,6 +967,9 @@ void SensorWorker::selfDefinedAction(QString action){
         return;
     }
 
+    //the sensor is busy until the command is finished
+    this->publishBusyState();
+
     //check wether the sensor is already connected
     QString msg = SensorWorkerMessage::FAILED_TO_DO_SELF_DEFINED_ACTION;
     bool success = false;
@@ -757,6 +985,7 @@ void SensorWorker::selfDefinedAction(QString action){
 
     }
 
+    this->publishState();
     emit this->commandFinished(success, msg);
 
 }
@@ -775,6 +1004,7 @@ ReadingTypes SensorWorker::getStreamFormat(){
  */
 void SensorWorker::setStreamFormat(ReadingTypes streamFormat){
     this->streamFormat = streamFormat;
+    this->publishState();
 }
 
 /*!
@@ -796,7 +1026,7 @@ void SensorWorker::startReadingStream(){
 
     //call streaming method
     this->isReadingStreamStarted = true;
-    QMetaObject::invokeMethod(this, "streamReading", Qt::QueuedConnection);
+    this->readingStreamTimer.start(0);
 
 
 }
@@ -806,6 +1036,7 @@ void SensorWorker::startReadingStream(){
  */
 void SensorWorker::stopReadingStream(){
     this->isReadingStreamStarted = false;
+    this->readingStreamTimer.stop();
 }
 
 /*!
@@ -827,7 +1058,7 @@ void SensorWorker::startConnectionMonitoringStream(){
 
     //call streaming method
     this->isConnectionStreamStarted = true;
-    QMetaObject::invokeMethod(this, "monitorConnectionStatus", Qt::QueuedConnection);
+    this->connectionStreamTimer.start(0);
 
 }
 
@@ -836,6 +1067,7 @@ void SensorWorker::startConnectionMonitoringStream(){
  */
 void SensorWorker::stopConnectionMonitoringStream(){
     this->isConnectionStreamStarted = false;
+    this->connectionStreamTimer.stop();
 }
 
 /*!
@@ -857,7 +1089,7 @@ void SensorWorker::startStatusMonitoringStream(){
 
     //call streaming method
     this->isStatusStreamStarted = true;
-    QMetaObject::invokeMethod(this, "streamStatus", Qt::QueuedConnection);
+    this->statusStreamTimer.start(0);
 
 }
 
@@ -866,6 +1098,7 @@ void SensorWorker::startStatusMonitoringStream(){
  */
 void SensorWorker::stopStatusMonitoringStream(){
     this->isStatusStreamStarted = false;
+    this->statusStreamTimer.stop();
 }
 
 /*!
@@ -884,18 +1117,29 @@ void SensorWorker::streamReading(){
         return;
     }
 
+    this->readingStreamCycle.start();
+
     if(!this->sensor->isSensorAsync()){
         //get real time reading
-        QVariantMap reading = this->sensor->readingStream(this->streamFormat);
-        emit this->realTimeReading(reading);
+        if(this->sensor->isReadingStreamTyped()){
+            RealTimeReading sample;
+            if(this->sensor->readingStreamSample(this->streamFormat, sample)){
+                this->addRealTimeReading(sample);
+            }
+        }else{
+            QVariantMap reading = this->sensor->readingStream(this->streamFormat);
+            this->addRealTimeReading(reading);
+        }
 
         //put reading stream into event queue again
-        QMetaObject::invokeMethod(this, "streamReading", Qt::QueuedConnection);
+        this->scheduleStream(this->readingStreamTimer, this->readingStreamCycle, this->readingStreamChannel.getSettings().targetRate);
     }else{
         QJsonObject request;
         request.insert("method", "stream");
+        request.insert("format", getReadingTypeName(this->streamFormat));
         QJsonObject status = this->sensor->performAsyncSensorCommand(request);
         if(status.value("status").toString().compare("blocked") == 0) {
+            this->publishState();
             emit this->commandFinished(false, SensorWorkerMessage::CONNECTION_WAS_BLOCKED);
         }
     }
@@ -919,18 +1163,20 @@ void SensorWorker::monitorConnectionStatus(){
         return;
     }
 
+    this->connectionStreamCycle.start();
+
     //get and compare connection status
     bool isConnected = this->sensor->getConnectionState();
-    if(isConnected == false && this->isSensorConnected == true){
-        this->isSensorConnected = false;
-        emit this->connectionLost();
-    }else if(isConnected == true && this->isSensorConnected == false){
-        this->isSensorConnected = true;
-        emit this->connectionReceived();
+    if(isConnected != this->isSensorConnected){
+        this->isSensorConnected = isConnected;
+        this->publishState();
+        if(this->connectionStreamBuffer.push(isConnected)){
+            emit this->connectionStatusAvailable();
+        }
     }
 
     //put connection stream into event queue again
-    QMetaObject::invokeMethod(this, "monitorConnectionStatus", Qt::QueuedConnection);
+    this->scheduleStream(this->connectionStreamTimer, this->connectionStreamCycle, this->connectionStreamBuffer.getSettings().targetRate);
 
 }
 
@@ -950,12 +1196,19 @@ void SensorWorker::streamStatus(){
         return;
     }
 
+    this->statusStreamCycle.start();
+
     //get sensor status
     QMap<QString, QString> status = this->sensor->getSensorStatus();
-    emit this->realTimeStatus(status);
+    SensorState state = this->sensorState.get();
+    state.status = status;
+    this->sensorState.publish(state);
+    if(this->statusStreamBuffer.push(status)){
+        emit this->realTimeStatusAvailable();
+    }
 
-    //put connection stream into event queue again
-    QMetaObject::invokeMethod(this, "streamStatus", Qt::QueuedConnection);
+    //put status stream into event queue again
+    this->scheduleStream(this->statusStreamTimer, this->statusStreamCycle, this->statusStreamBuffer.getSettings().targetRate);
 
 }
 
@@ -969,6 +1222,7 @@ void SensorWorker::asyncSensorResponseReceived(const QJsonObject &response)
         msg = response.value("result").toString();
         success = true;
     }
+    this->publishState();
     emit this->commandFinished(success, msg);
 }
 
@@ -976,6 +1230,8 @@ void SensorWorker::asyncSensorMeasurementReceived(const int &geomId, const QList
 {
     // same logic like SensorWorker::measure
     const bool success = measurements.size() > 0;
+    prepareReadings(measurements);
+    this->publishState();
 
     emit this->measurementDone(success);
 
@@ -989,10 +1245,109 @@ void SensorWorker::asyncSensorMeasurementReceived(const int &geomId, const QList
 
 void SensorWorker::asyncSensorStreamDataReceived(const QVariantMap &reading)
 {
-    emit this->realTimeReading(reading);
+    this->addRealTimeReading(reading);
 
     //put reading stream into event queue again
-    QMetaObject::invokeMethod(this, "streamReading", Qt::QueuedConnection);
+    this->scheduleStream(this->readingStreamTimer, this->readingStreamCycle, this->readingStreamChannel.getSettings().targetRate);
+}
+
+void SensorWorker::asyncSensorStreamSampleReceived(const RealTimeReading &sample)
+{
+    this->addRealTimeReading(sample);
+
+    //put reading stream into event queue again
+    this->scheduleStream(this->readingStreamTimer, this->readingStreamCycle, this->readingStreamChannel.getSettings().targetRate);
+}
+
+/*!
+ * \brief SensorWorker::addRealTimeReading
+ * Buffers the reading and notifies the consumer if the buffer was empty before
+ * \param reading
+ */
+void SensorWorker::addRealTimeReading(const QVariantMap &reading){
+    if(this->readingStreamBuffer.push(reading)){
+        emit this->realTimeReadingAvailable();
+    }
+}
+
+/*!
+ * \brief SensorWorker::addRealTimeReading
+ * Passes the typed reading to the consumer without locking and notifies it if it has taken all readings before
+ * \param sample
+ */
+void SensorWorker::addRealTimeReading(const RealTimeReading &sample){
+    if(this->readingStreamChannel.push(sample)){
+        emit this->realTimeReadingAvailable();
+    }
+}
+
+/*!
+ * \brief SensorWorker::publishState
+ * Reads the state of the current sensor and publishes it (called after every sensor action)
+ */
+void SensorWorker::publishState(){
+
+    SensorState state;
+    state.streamFormat = this->streamFormat;
+
+    if(!this->sensor.isNull()){
+
+        //sensor meta information
+        state.isSensorSet = true;
+        state.sensorConfiguration = this->sensor->getSensorConfiguration();
+        state.activeSensorType = state.sensorConfiguration.getTypeOfSensor();
+        state.supportedReadingTypes = this->sensor->getSupportedReadingTypes();
+        state.supportedConnectionTypes = this->sensor->getSupportedConnectionTypes();
+        state.supportedSensorActions = this->sensor->getSupportedSensorActions();
+        state.selfDefinedActions = this->sensor->getSelfDefinedActions();
+
+        //status information
+        state.isConnected = this->sensor->getConnectionState();
+        if(state.isConnected){
+            state.isReadyForMeasurement = this->sensor->getIsReadyForMeasurement();
+            state.isBusy = this->sensor->getIsBusy();
+            state.status = this->sensor->getSensorStatus();
+        }
+
+    }
+
+    this->sensorState.publish(state);
+
+}
+
+/*!
+ * \brief SensorWorker::publishBusyState
+ * Publishes the latest state as busy and not ready for measurement before a sensor command is dispatched
+ * (the state of the sensor is published again when the command is finished)
+ */
+void SensorWorker::publishBusyState(){
+
+    SensorState state = this->sensorState.get();
+    state.isBusy = true;
+    state.isReadyForMeasurement = false;
+    this->sensorState.publish(state);
+
+}
+
+/*!
+ * \brief SensorWorker::scheduleStream
+ * Restarts the stream timer so that the next stream cycle starts one period (1 / targetRate) after the current one
+ * \param timer
+ * \param cycle time since the current stream cycle started
+ * \param targetRate
+ */
+void SensorWorker::scheduleStream(QTimer &timer, const QElapsedTimer &cycle, const double &targetRate){
+
+    //poll as fast as possible
+    int interval = 0;
+
+    //wait for the rest of the current period
+    if(targetRate > 0.0 && cycle.isValid()){
+        interval = qMax(0, qRound(1000.0 / targetRate - cycle.elapsed()));
+    }
+
+    timer.start(interval);
+
 }
 
 
@@ -1002,3 +1357,12 @@ void SensorWorker::finishMeasurement(){
     this->selfDefinedAction("stopMeasure");
 
 }
+
+/*!
+ * \brief SensorWorker::moveToWorkerThread
+ * Pushes the worker to the given thread (must be invoked in the thread the worker lives in)
+ * \param thread
+ */
+void SensorWorker::moveToWorkerThread(QThread *thread){
+    this->moveToThread(thread);
+}
@@ -848,6 +848,7 @@ void Station::connectSensorControl(){
 
     //connect sensor streaming results
     QObject::connect(this->sensorControl.data(), &SensorControl::realTimeReading, this, &Station::realTimeReading, Qt::AutoConnection);
+    QObject::connect(this->sensorControl.data(), &SensorControl::realTimeReadingSamples, this, &Station::realTimeReadingSamples, Qt::AutoConnection);
     QObject::connect(this->sensorControl.data(), &SensorControl::realTimeStatus, this, &Station::realTimeStatus, Qt::AutoConnection);
     QObject::connect(this->sensorControl.data(), &SensorControl::connectionLost, this, &Station::connectionLost, Qt::AutoConnection);
     QObject::connect(this->sensorControl.data(), &SensorControl::connectionReceived, this, &Station::connectionReceived, Qt::AutoConnection);
@@ -902,6 +903,7 @@ void Station::disconnectSensorControl(){
 
     //disconnect sensor streaming results
     QObject::disconnect(this->sensorControl.data(), &SensorControl::realTimeReading, this, &Station::realTimeReading);
+    QObject::disconnect(this->sensorControl.data(), &SensorControl::realTimeReadingSamples, this, &Station::realTimeReadingSamples);
     QObject::disconnect(this->sensorControl.data(), &SensorControl::realTimeStatus, this, &Station::realTimeStatus);
     QObject::disconnect(this->sensorControl.data(), &SensorControl::connectionLost, this, &Station::connectionLost);
     QObject::disconnect(this->sensorControl.data(), &SensorControl::connectionReceived, this, &Station::connectionReceived);
@@ -922,7 +924,10 @@ void Station::disconnectSensorControl(){
  */
 void Station::addReadings(const int &geomId, const QList<QPointer<Reading> > &readings){
 
-    MeasurementConfig measurementConfig = this->job->getFeatureById(geomId)->getGeometry()->getMeasurementConfig();
+    //all readings share the same configs
+    MeasurementConfigHandle measurementConfig = MeasurementConfigHandle::intern(
+                this->job->getFeatureById(geomId)->getGeometry()->getMeasurementConfig());
+    SensorConfigurationHandle sensorConfig = SensorConfigurationHandle::intern(this->getSensorConfiguration());
     foreach(const QPointer<Reading> &reading, readings){
 
         //check reading
@@ -931,7 +936,7 @@ void Station::addReadings(const int &geomId, const QList<QPointer<Reading> > &re
         }
 
         //set sensor configuration of reading
-        reading->setSensorConfiguration(this->getSensorConfiguration());
+        reading->setSensorConfiguration(sensorConfig);
         reading->setMeasurementConfig(measurementConfig);
 
         switch(reading->getTypeOfReading()){
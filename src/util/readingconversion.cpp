@@ -0,0 +1,551 @@
+#include "readingconversion.h"
+
+#include <cmath>
+
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define OI_CONVERSION_AVX2
+#include <immintrin.h>
+#endif
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+#define OI_CONVERSION_NEON
+#include <arm_neon.h>
+#endif
+
+namespace oi{
+
+namespace internal{
+
+//#########################################################
+//constants of the vectorized sine and cosine approximation
+//#########################################################
+
+//pi/2 split into three parts (Cody-Waite) so that n * pi/2 is exact for the range of measured angles
+const double twoOverPi = 0.63661977236758134308;
+const double piOverTwo1 = 1.57079625129699707031;
+const double piOverTwo2 = 7.54978941586159635335E-8;
+const double piOverTwo3 = 5.39030285815811905290E-15;
+
+//minimax coefficients for sin and cos on [-pi/4, pi/4] (Cephes)
+const double sinCoefficients[6] = {1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+                                   -1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1};
+const double cosCoefficients[6] = {-1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+                                   2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2};
+
+const QString scalarKernelName = "scalar";
+const QString avx2KernelName = "AVX2";
+const QString neonKernelName = "NEON";
+
+/*!
+ * \brief polarToCartesianScalar
+ * Reference implementation that converts the readings [begin, end) with the standard library
+ */
+void polarToCartesianScalar(const double *azimuth, const double *zenith, const double *distance,
+                            const double *sigmaAzimuth, const double *sigmaZenith, const double *sigmaDistance,
+                            double *x, double *y, double *z, double *sigmaX, double *sigmaY, double *sigmaZ,
+                            const int &begin, const int &end){
+
+    for(int i = begin; i < end; i++){
+
+        const double sinAzimuth = std::sin(azimuth[i]);
+        const double cosAzimuth = std::cos(azimuth[i]);
+        const double sinZenith = std::sin(zenith[i]);
+        const double cosZenith = std::cos(zenith[i]);
+        const double d = distance[i];
+
+        x[i] = d * sinZenith * cosAzimuth;
+        y[i] = d * sinZenith * sinAzimuth;
+        z[i] = d * cosZenith;
+
+        //variance propagation F * Sll * F^T (only the diagonal is needed)
+        const double varAzimuth = sigmaAzimuth[i] * sigmaAzimuth[i];
+        const double varZenith = sigmaZenith[i] * sigmaZenith[i];
+        const double varDistance = sigmaDistance[i] * sigmaDistance[i];
+
+        const double fxd = sinZenith * cosAzimuth, fxa = d * sinZenith * sinAzimuth, fxz = d * cosZenith * cosAzimuth;
+        const double fyd = sinZenith * sinAzimuth, fya = d * sinZenith * cosAzimuth, fyz = d * cosZenith * sinAzimuth;
+        const double fzd = cosZenith, fzz = d * sinZenith;
+
+        sigmaX[i] = std::sqrt(fxd * fxd * varDistance + fxa * fxa * varAzimuth + fxz * fxz * varZenith);
+        sigmaY[i] = std::sqrt(fyd * fyd * varDistance + fya * fya * varAzimuth + fyz * fyz * varZenith);
+        sigmaZ[i] = std::sqrt(fzd * fzd * varDistance + fzz * fzz * varZenith);
+
+    }
+
+}
+
+#ifdef OI_CONVERSION_AVX2
+
+/*!
+ * \brief sinCosAvx2
+ * Computes sine and cosine of four angles at once
+ */
+__attribute__((target("avx2,fma"))) inline void sinCosAvx2(const __m256d &angle, __m256d &sine, __m256d &cosine){
+
+    //reduce the angle to r = angle - n * pi/2 with |r| <= pi/4
+    const __m256d n = _mm256_round_pd(_mm256_mul_pd(angle, _mm256_set1_pd(twoOverPi)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+    __m256d r = _mm256_fnmadd_pd(n, _mm256_set1_pd(piOverTwo1), angle);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(piOverTwo2), r);
+    r = _mm256_fnmadd_pd(n, _mm256_set1_pd(piOverTwo3), r);
+    const __m256d r2 = _mm256_mul_pd(r, r);
+
+    //evaluate both polynomials
+    __m256d ps = _mm256_set1_pd(sinCoefficients[0]);
+    __m256d pc = _mm256_set1_pd(cosCoefficients[0]);
+    for(int i = 1; i < 6; i++){
+        ps = _mm256_fmadd_pd(ps, r2, _mm256_set1_pd(sinCoefficients[i]));
+        pc = _mm256_fmadd_pd(pc, r2, _mm256_set1_pd(cosCoefficients[i]));
+    }
+    const __m256d sinR = _mm256_fmadd_pd(_mm256_mul_pd(r, r2), ps, r);
+    const __m256d cosR = _mm256_fmadd_pd(_mm256_mul_pd(r2, r2), pc, _mm256_fnmadd_pd(_mm256_set1_pd(0.5), r2, _mm256_set1_pd(1.0)));
+
+    //select and sign the results depending on the quadrant n mod 4
+    const __m256i quadrant = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(n));
+    const __m256i one = _mm256_set1_epi64x(1);
+    const __m256i two = _mm256_set1_epi64x(2);
+    const __m256d swap = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, one), one));
+    const __m256d negateSin = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, two), two));
+    const __m256d negateCos = _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(_mm256_add_epi64(quadrant, one), two), two));
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+
+    sine = _mm256_xor_pd(_mm256_blendv_pd(sinR, cosR, swap), _mm256_and_pd(negateSin, signBit));
+    cosine = _mm256_xor_pd(_mm256_blendv_pd(cosR, sinR, swap), _mm256_and_pd(negateCos, signBit));
+
+}
+
+/*!
+ * \brief polarToCartesianAvx2
+ * Converts four readings per iteration and returns the number of converted readings
+ */
+__attribute__((target("avx2,fma"))) int polarToCartesianAvx2(const double *azimuth, const double *zenith, const double *distance,
+                                                             const double *sigmaAzimuth, const double *sigmaZenith, const double *sigmaDistance,
+                                                             double *x, double *y, double *z, double *sigmaX, double *sigmaY, double *sigmaZ,
+                                                             const int &count){
+
+    int i = 0;
+    for(; i + 4 <= count; i += 4){
+
+        __m256d sinAzimuth, cosAzimuth, sinZenith, cosZenith;
+        sinCosAvx2(_mm256_loadu_pd(azimuth + i), sinAzimuth, cosAzimuth);
+        sinCosAvx2(_mm256_loadu_pd(zenith + i), sinZenith, cosZenith);
+        const __m256d d = _mm256_loadu_pd(distance + i);
+
+        const __m256d fxd = _mm256_mul_pd(sinZenith, cosAzimuth);
+        const __m256d fyd = _mm256_mul_pd(sinZenith, sinAzimuth);
+        const __m256d dSinZenith = _mm256_mul_pd(d, sinZenith);
+        const __m256d dCosZenith = _mm256_mul_pd(d, cosZenith);
+
+        _mm256_storeu_pd(x + i, _mm256_mul_pd(d, fxd));
+        _mm256_storeu_pd(y + i, _mm256_mul_pd(d, fyd));
+        _mm256_storeu_pd(z + i, dCosZenith);
+
+        //variance propagation F * Sll * F^T (only the diagonal is needed)
+        const __m256d sa = _mm256_loadu_pd(sigmaAzimuth + i);
+        const __m256d sz = _mm256_loadu_pd(sigmaZenith + i);
+        const __m256d sd = _mm256_loadu_pd(sigmaDistance + i);
+        const __m256d varAzimuth = _mm256_mul_pd(sa, sa);
+        const __m256d varZenith = _mm256_mul_pd(sz, sz);
+        const __m256d varDistance = _mm256_mul_pd(sd, sd);
+
+        const __m256d fxa = _mm256_mul_pd(dSinZenith, sinAzimuth);
+        const __m256d fxz = _mm256_mul_pd(dCosZenith, cosAzimuth);
+        const __m256d fya = _mm256_mul_pd(dSinZenith, cosAzimuth);
+        const __m256d fyz = _mm256_mul_pd(dCosZenith, sinAzimuth);
+
+        __m256d varX = _mm256_mul_pd(_mm256_mul_pd(fxd, fxd), varDistance);
+        varX = _mm256_fmadd_pd(_mm256_mul_pd(fxa, fxa), varAzimuth, varX);
+        varX = _mm256_fmadd_pd(_mm256_mul_pd(fxz, fxz), varZenith, varX);
+        __m256d varY = _mm256_mul_pd(_mm256_mul_pd(fyd, fyd), varDistance);
+        varY = _mm256_fmadd_pd(_mm256_mul_pd(fya, fya), varAzimuth, varY);
+        varY = _mm256_fmadd_pd(_mm256_mul_pd(fyz, fyz), varZenith, varY);
+        __m256d varZ = _mm256_mul_pd(_mm256_mul_pd(cosZenith, cosZenith), varDistance);
+        varZ = _mm256_fmadd_pd(_mm256_mul_pd(dSinZenith, dSinZenith), varZenith, varZ);
+
+        _mm256_storeu_pd(sigmaX + i, _mm256_sqrt_pd(varX));
+        _mm256_storeu_pd(sigmaY + i, _mm256_sqrt_pd(varY));
+        _mm256_storeu_pd(sigmaZ + i, _mm256_sqrt_pd(varZ));
+
+    }
+    return i;
+
+}
+
+#endif
+
+#ifdef OI_CONVERSION_NEON
+
+/*!
+ * \brief sinCosNeon
+ * Computes sine and cosine of two angles at once
+ */
+inline void sinCosNeon(const float64x2_t &angle, float64x2_t &sine, float64x2_t &cosine){
+
+    //reduce the angle to r = angle - n * pi/2 with |r| <= pi/4
+    const float64x2_t n = vrndnq_f64(vmulq_f64(angle, vdupq_n_f64(twoOverPi)));
+    float64x2_t r = vfmsq_f64(angle, n, vdupq_n_f64(piOverTwo1));
+    r = vfmsq_f64(r, n, vdupq_n_f64(piOverTwo2));
+    r = vfmsq_f64(r, n, vdupq_n_f64(piOverTwo3));
+    const float64x2_t r2 = vmulq_f64(r, r);
+
+    //evaluate both polynomials
+    float64x2_t ps = vdupq_n_f64(sinCoefficients[0]);
+    float64x2_t pc = vdupq_n_f64(cosCoefficients[0]);
+    for(int i = 1; i < 6; i++){
+        ps = vfmaq_f64(vdupq_n_f64(sinCoefficients[i]), ps, r2);
+        pc = vfmaq_f64(vdupq_n_f64(cosCoefficients[i]), pc, r2);
+    }
+    const float64x2_t sinR = vfmaq_f64(r, vmulq_f64(r, r2), ps);
+    const float64x2_t cosR = vfmaq_f64(vfmsq_f64(vdupq_n_f64(1.0), vdupq_n_f64(0.5), r2), vmulq_f64(r2, r2), pc);
+
+    //select and sign the results depending on the quadrant n mod 4
+    const int64x2_t quadrant = vcvtq_s64_f64(n);
+    const int64x2_t one = vdupq_n_s64(1);
+    const int64x2_t two = vdupq_n_s64(2);
+    const uint64x2_t swap = vceqq_s64(vandq_s64(quadrant, one), one);
+    const uint64x2_t negateSin = vceqq_s64(vandq_s64(quadrant, two), two);
+    const uint64x2_t negateCos = vceqq_s64(vandq_s64(vaddq_s64(quadrant, one), two), two);
+    const uint64x2_t signBit = vdupq_n_u64(0x8000000000000000ULL);
+
+    sine = vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(vbslq_f64(swap, cosR, sinR)), vandq_u64(negateSin, signBit)));
+    cosine = vreinterpretq_f64_u64(veorq_u64(vreinterpretq_u64_f64(vbslq_f64(swap, sinR, cosR)), vandq_u64(negateCos, signBit)));
+
+}
+
+/*!
+ * \brief polarToCartesianNeon
+ * Converts two readings per iteration and returns the number of converted readings
+ */
+int polarToCartesianNeon(const double *azimuth, const double *zenith, const double *distance,
+                         const double *sigmaAzimuth, const double *sigmaZenith, const double *sigmaDistance,
+                         double *x, double *y, double *z, double *sigmaX, double *sigmaY, double *sigmaZ,
+                         const int &count){
+
+    int i = 0;
+    for(; i + 2 <= count; i += 2){
+
+        float64x2_t sinAzimuth, cosAzimuth, sinZenith, cosZenith;
+        sinCosNeon(vld1q_f64(azimuth + i), sinAzimuth, cosAzimuth);
+        sinCosNeon(vld1q_f64(zenith + i), sinZenith, cosZenith);
+        const float64x2_t d = vld1q_f64(distance + i);
+
+        const float64x2_t fxd = vmulq_f64(sinZenith, cosAzimuth);
+        const float64x2_t fyd = vmulq_f64(sinZenith, sinAzimuth);
+        const float64x2_t dSinZenith = vmulq_f64(d, sinZenith);
+        const float64x2_t dCosZenith = vmulq_f64(d, cosZenith);
+
+        vst1q_f64(x + i, vmulq_f64(d, fxd));
+        vst1q_f64(y + i, vmulq_f64(d, fyd));
+        vst1q_f64(z + i, dCosZenith);
+
+        //variance propagation F * Sll * F^T (only the diagonal is needed)
+        const float64x2_t sa = vld1q_f64(sigmaAzimuth + i);
+        const float64x2_t sz = vld1q_f64(sigmaZenith + i);
+        const float64x2_t sd = vld1q_f64(sigmaDistance + i);
+        const float64x2_t varAzimuth = vmulq_f64(sa, sa);
+        const float64x2_t varZenith = vmulq_f64(sz, sz);
+        const float64x2_t varDistance = vmulq_f64(sd, sd);
+
+        const float64x2_t fxa = vmulq_f64(dSinZenith, sinAzimuth);
+        const float64x2_t fxz = vmulq_f64(dCosZenith, cosAzimuth);
+        const float64x2_t fya = vmulq_f64(dSinZenith, cosAzimuth);
+        const float64x2_t fyz = vmulq_f64(dCosZenith, sinAzimuth);
+
+        float64x2_t varX = vmulq_f64(vmulq_f64(fxd, fxd), varDistance);
+        varX = vfmaq_f64(varX, vmulq_f64(fxa, fxa), varAzimuth);
+        varX = vfmaq_f64(varX, vmulq_f64(fxz, fxz), varZenith);
+        float64x2_t varY = vmulq_f64(vmulq_f64(fyd, fyd), varDistance);
+        varY = vfmaq_f64(varY, vmulq_f64(fya, fya), varAzimuth);
+        varY = vfmaq_f64(varY, vmulq_f64(fyz, fyz), varZenith);
+        float64x2_t varZ = vmulq_f64(vmulq_f64(cosZenith, cosZenith), varDistance);
+        varZ = vfmaq_f64(varZ, vmulq_f64(dSinZenith, dSinZenith), varZenith);
+
+        vst1q_f64(sigmaX + i, vsqrtq_f64(varX));
+        vst1q_f64(sigmaY + i, vsqrtq_f64(varY));
+        vst1q_f64(sigmaZ + i, vsqrtq_f64(varZ));
+
+    }
+    return i;
+
+}
+
+#endif
+
+}
+
+//################################
+//batch container helper functions
+//################################
+
+/*!
+ * \brief PolarReadingBatch::resize
+ * \param size
+ */
+void PolarReadingBatch::resize(const int &size){
+    this->azimuth.resize(size);
+    this->zenith.resize(size);
+    this->distance.resize(size);
+    this->sigmaAzimuth.resize(size);
+    this->sigmaZenith.resize(size);
+    this->sigmaDistance.resize(size);
+}
+
+/*!
+ * \brief PolarReadingBatch::reserve
+ * \param size
+ */
+void PolarReadingBatch::reserve(const int &size){
+    this->azimuth.reserve(size);
+    this->zenith.reserve(size);
+    this->distance.reserve(size);
+    this->sigmaAzimuth.reserve(size);
+    this->sigmaZenith.reserve(size);
+    this->sigmaDistance.reserve(size);
+}
+
+/*!
+ * \brief PolarReadingBatch::size
+ * \return
+ */
+int PolarReadingBatch::size() const{
+    return this->azimuth.size();
+}
+
+/*!
+ * \brief PolarReadingBatch::append
+ * \param azimuth
+ * \param zenith
+ * \param distance
+ * \param sigmaAzimuth
+ * \param sigmaZenith
+ * \param sigmaDistance
+ */
+void PolarReadingBatch::append(const double &azimuth, const double &zenith, const double &distance,
+                               const double &sigmaAzimuth, const double &sigmaZenith, const double &sigmaDistance){
+    this->azimuth.append(azimuth);
+    this->zenith.append(zenith);
+    this->distance.append(distance);
+    this->sigmaAzimuth.append(sigmaAzimuth);
+    this->sigmaZenith.append(sigmaZenith);
+    this->sigmaDistance.append(sigmaDistance);
+}
+
+/*!
+ * \brief CartesianReadingBatch::resize
+ * \param size
+ */
+void CartesianReadingBatch::resize(const int &size){
+    this->x.resize(size);
+    this->y.resize(size);
+    this->z.resize(size);
+    this->sigmaX.resize(size);
+    this->sigmaY.resize(size);
+    this->sigmaZ.resize(size);
+}
+
+/*!
+ * \brief CartesianReadingBatch::reserve
+ * \param size
+ */
+void CartesianReadingBatch::reserve(const int &size){
+    this->x.reserve(size);
+    this->y.reserve(size);
+    this->z.reserve(size);
+    this->sigmaX.reserve(size);
+    this->sigmaY.reserve(size);
+    this->sigmaZ.reserve(size);
+}
+
+/*!
+ * \brief CartesianReadingBatch::size
+ * \return
+ */
+int CartesianReadingBatch::size() const{
+    return this->x.size();
+}
+
+/*!
+ * \brief CartesianReadingBatch::append
+ * \param x
+ * \param y
+ * \param z
+ * \param sigmaX
+ * \param sigmaY
+ * \param sigmaZ
+ */
+void CartesianReadingBatch::append(const double &x, const double &y, const double &z,
+                                   const double &sigmaX, const double &sigmaY, const double &sigmaZ){
+    this->x.append(x);
+    this->y.append(y);
+    this->z.append(z);
+    this->sigmaX.append(sigmaX);
+    this->sigmaY.append(sigmaY);
+    this->sigmaZ.append(sigmaZ);
+}
+
+//##################
+//conversion kernels
+//##################
+
+/*!
+ * \brief getBestConversionKernel
+ * Returns the fastest kernel supported by the cpu the application is running on
+ * \return
+ */
+ConversionKernel getBestConversionKernel(){
+    if(getIsConversionKernelAvailable(eAvx2Kernel)){
+        return eAvx2Kernel;
+    }else if(getIsConversionKernelAvailable(eNeonKernel)){
+        return eNeonKernel;
+    }
+    return eScalarKernel;
+}
+
+/*!
+ * \brief getIsConversionKernelAvailable
+ * \param kernel
+ * \return
+ */
+bool getIsConversionKernelAvailable(const ConversionKernel &kernel){
+
+    switch(kernel){
+    case eScalarKernel:
+        return true;
+    case eAvx2Kernel:{
+#ifdef OI_CONVERSION_AVX2
+        static const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+        return avx2;
+#else
+        return false;
+#endif
+    }
+    case eNeonKernel:
+#ifdef OI_CONVERSION_NEON
+        return true;
+#else
+        return false;
+#endif
+    }
+    return false;
+
+}
+
+/*!
+ * \brief getConversionKernelName
+ * \param kernel
+ * \return
+ */
+const QString &getConversionKernelName(const ConversionKernel &kernel){
+
+    switch(kernel){
+    case eAvx2Kernel:
+        return internal::avx2KernelName;
+    case eNeonKernel:
+        return internal::neonKernelName;
+    default:
+        return internal::scalarKernelName;
+    }
+
+}
+
+/*!
+ * \brief polarToCartesian
+ * Converts all polar readings into cartesian coordinates including the propagation of their sigmas
+ * \param polar
+ * \param cartesian
+ * \param kernel
+ */
+void polarToCartesian(const PolarReadingBatch &polar, CartesianReadingBatch &cartesian, const ConversionKernel &kernel){
+
+    const int count = polar.size();
+    cartesian.resize(count);
+    if(count == 0){
+        return;
+    }
+
+    //readings without sigmas are converted with zero sigmas
+    const QVector<double> zeros = (polar.sigmaAzimuth.size() == count && polar.sigmaZenith.size() == count
+                                   && polar.sigmaDistance.size() == count) ? QVector<double>() : QVector<double>(count, 0.0);
+    const double *sigmaAzimuth = zeros.isEmpty() ? polar.sigmaAzimuth.constData() : zeros.constData();
+    const double *sigmaZenith = zeros.isEmpty() ? polar.sigmaZenith.constData() : zeros.constData();
+    const double *sigmaDistance = zeros.isEmpty() ? polar.sigmaDistance.constData() : zeros.constData();
+
+    polarToCartesian(polar.azimuth.constData(), polar.zenith.constData(), polar.distance.constData(),
+                     sigmaAzimuth, sigmaZenith, sigmaDistance,
+                     cartesian.x.data(), cartesian.y.data(), cartesian.z.data(),
+                     cartesian.sigmaX.data(), cartesian.sigmaY.data(), cartesian.sigmaZ.data(),
+                     count, kernel);
+
+}
+
+/*!
+ * \brief polarToCartesian
+ * Converts count polar readings into cartesian coordinates including the propagation of their sigmas.
+ * The output arrays must be able to hold count values. Unavailable kernels fall back to the scalar implementation.
+ */
+void polarToCartesian(const double *azimuth, const double *zenith, const double *distance,
+                      const double *sigmaAzimuth, const double *sigmaZenith, const double *sigmaDistance,
+                      double *x, double *y, double *z, double *sigmaX, double *sigmaY, double *sigmaZ,
+                      const int &count, const ConversionKernel &kernel){
+
+    int converted = 0;
+
+    //convert as many readings as possible with the vectorized kernel
+    if(getIsConversionKernelAvailable(kernel)){
+        switch(kernel){
+#ifdef OI_CONVERSION_AVX2
+        case eAvx2Kernel:
+            converted = internal::polarToCartesianAvx2(azimuth, zenith, distance, sigmaAzimuth, sigmaZenith, sigmaDistance,
+                                                       x, y, z, sigmaX, sigmaY, sigmaZ, count);
+            break;
+#endif
+#ifdef OI_CONVERSION_NEON
+        case eNeonKernel:
+            converted = internal::polarToCartesianNeon(azimuth, zenith, distance, sigmaAzimuth, sigmaZenith, sigmaDistance,
+                                                       x, y, z, sigmaX, sigmaY, sigmaZ, count);
+            break;
+#endif
+        default:
+            break;
+        }
+    }
+
+    //convert the remaining readings
+    internal::polarToCartesianScalar(azimuth, zenith, distance, sigmaAzimuth, sigmaZenith, sigmaDistance,
+                                     x, y, z, sigmaX, sigmaY, sigmaZ, converted, count);
+
+}
+
+/*!
+ * \brief cartesianToPolar
+ * Converts all cartesian readings into polar elements (sigmas are not propagated and set to zero)
+ * \param cartesian
+ * \param polar
+ */
+void cartesianToPolar(const CartesianReadingBatch &cartesian, PolarReadingBatch &polar){
+
+    const int count = cartesian.size();
+    polar.resize(count);
+
+    const double *x = cartesian.x.constData();
+    const double *y = cartesian.y.constData();
+    const double *z = cartesian.z.constData();
+    double *azimuth = polar.azimuth.data();
+    double *zenith = polar.zenith.data();
+    double *distance = polar.distance.data();
+    double *sigmaAzimuth = polar.sigmaAzimuth.data();
+    double *sigmaZenith = polar.sigmaZenith.data();
+    double *sigmaDistance = polar.sigmaDistance.data();
+
+    for(int i = 0; i < count; i++){
+        const double s = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+        azimuth[i] = std::atan2(y[i], x[i]);
+        zenith[i] = std::acos(z[i] / s);
+        distance[i] = s;
+        sigmaAzimuth[i] = 0.0;
+        sigmaZenith[i] = 0.0;
+        sigmaDistance[i] = 0.0;
+    }
+
+}
+
+}
@@ -0,0 +1,255 @@
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+#include "acquisitionmanager.h"
+#include "chooselalib.h"
+#include "featureattributes.h"
+#include "observation.h"
+#include "oijob.h"
+#include "reading.h"
+
+using namespace oi;
+
+/*!
+ * \brief The SimulatedSensor class
+ * Local sensor that measures one cartesian reading after a short settling time
+ */
+class SimulatedSensor : public Sensor
+{
+public:
+    SimulatedSensor(const double &x) : x(x), isConnected(false), measureThread(NULL){
+        this->supportedReadingTypes.append(eCartesianReading);
+        this->supportedConnectionTypes.append(eSerialConnection);
+    }
+
+    bool connectSensor(){
+        this->isConnected = true;
+        return true;
+    }
+    bool disconnectSensor(){
+        this->isConnected = false;
+        return true;
+    }
+
+    bool getConnectionState(){
+        return this->isConnected;
+    }
+    bool getIsReadyForMeasurement(){
+        return true;
+    }
+    bool getIsBusy(){
+        return false;
+    }
+    QMap<QString, QString> getSensorStatus(){
+        return QMap<QString, QString>();
+    }
+
+    QList<QPointer<Reading> > measure(const MeasurementConfig &mConfig){
+        Q_UNUSED(mConfig);
+        QThread::msleep(5);
+        this->measureThread.storeRelease(QThread::currentThread());
+
+        ReadingCartesian cartesian;
+        cartesian.xyz.setAt(0, this->x);
+        cartesian.isValid = true;
+        QList<QPointer<Reading> > readings;
+        readings.append(new Reading(cartesian));
+        return readings;
+    }
+
+    double x;
+    volatile bool isConnected;
+    QAtomicPointer<QThread> measureThread;
+};
+
+/*!
+ * \brief The ObservationFitFunction class
+ * Fit function that only needs observations
+ */
+class ObservationFitFunction : public Function
+{
+public:
+    ObservationFitFunction(){
+        NeededElement element;
+        element.typeOfElement = eObservationElement;
+        element.infinite = true;
+        this->neededElements.append(element);
+    }
+};
+
+class AcquisitionManagerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    AcquisitionManagerTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testConcurrentMeasurements();
+    void testRemoveStation();
+
+private:
+    QPointer<FeatureWrapper> createJob(QPointer<OiJob> &job, QList<QPointer<Station> > &stations, const int &numStations);
+};
+
+AcquisitionManagerTest::AcquisitionManagerTest()
+{
+}
+
+void AcquisitionManagerTest::initTestCase(){
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+    qRegisterMetaType<MeasurementConfig>("MeasurementConfig");
+    qRegisterMetaType<QList<QPointer<Reading> > >("QList<QPointer<Reading> >");
+}
+
+QPointer<FeatureWrapper> AcquisitionManagerTest::createJob(QPointer<OiJob> &job, QList<QPointer<Station> > &stations, const int &numStations){
+
+    job = new OiJob();
+
+    //stations with simulated sensors
+    FeatureAttributes stationAttributes;
+    stationAttributes.typeOfFeature = eStationFeature;
+    stationAttributes.name = "STATION";
+    stationAttributes.count = numStations;
+    foreach(const QPointer<FeatureWrapper> &station, job->addFeatures(stationAttributes)){
+        stations.append(station->getStation());
+    }
+    stations.first()->setActiveStationState(true);
+
+    //geometry with a fit function
+    FeatureAttributes geometryAttributes;
+    geometryAttributes.typeOfFeature = ePlaneFeature;
+    geometryAttributes.name = "SCAN";
+    geometryAttributes.count = 1;
+    geometryAttributes.isActual = true;
+    QPointer<FeatureWrapper> feature = job->addFeatures(geometryAttributes).first();
+    feature->getFeature()->addFunction(new ObservationFitFunction());
+    return feature;
+
+}
+
+void AcquisitionManagerTest::testConcurrentMeasurements(){
+
+    QPointer<OiJob> job;
+    QList<QPointer<Station> > stations;
+    QPointer<FeatureWrapper> feature = this->createJob(job, stations, 3);
+    int geomId = feature->getFeature()->getId();
+
+    AcquisitionManager manager(job);
+    manager.setMergeInterval(20);
+    QSignalSpy mergedSpy(&manager, SIGNAL(resultsMerged(int,int)));
+
+    QList<SimulatedSensor *> sensors;
+    for(int i = 0; i < stations.size(); i++){
+        QVERIFY(manager.addStation(stations.at(i)));
+        sensors.append(new SimulatedSensor(i));
+        stations.at(i)->setSensor(sensors.last());
+        emit stations.at(i)->connectSensor();
+    }
+    QVERIFY(!manager.addStation(stations.first()));
+    QCOMPARE(manager.getStations().size(), 3);
+    foreach(const QPointer<Station> &station, stations){
+        QTRY_VERIFY(station->getIsSensorConnected());
+    }
+
+    //starting the measurements does not wait for the sensors
+    const int numMeasurements = 20;
+    QElapsedTimer timer;
+    timer.start();
+    for(int i = 0; i < numMeasurements; i++){
+        foreach(const QPointer<Station> &station, stations){
+            emit station->measure(geomId, MeasurementConfig());
+        }
+    }
+    QVERIFY(timer.elapsed() < numMeasurements * 5);
+
+    QTRY_COMPARE(feature->getGeometry()->getObservations().size(), stations.size() * numMeasurements);
+    QCOMPARE(manager.getNumPendingResults(), 0);
+
+    //each sensor measured in its own thread
+    QSet<QThread *> threads;
+    foreach(SimulatedSensor *sensor, sensors){
+        QThread *thread = sensor->measureThread.loadAcquire();
+        QVERIFY(thread != NULL);
+        QVERIFY(thread != QThread::currentThread());
+        threads.insert(thread);
+    }
+    QCOMPARE(threads.size(), stations.size());
+
+    //the results were merged in batches
+    int numReadings = 0;
+    for(int i = 0; i < mergedSpy.count(); i++){
+        numReadings += mergedSpy.at(i).at(1).toInt();
+    }
+    QCOMPARE(numReadings, stations.size() * numMeasurements);
+    QVERIFY(mergedSpy.count() < stations.size() * numMeasurements);
+
+    //the observations were added to the station that measured them in the order they were acquired
+    for(int i = 0; i < stations.size(); i++){
+        QList<QPointer<Observation> > observations = stations.at(i)->getCoordinateSystem()->getObservations();
+        QCOMPARE(observations.size(), numMeasurements);
+        qint64 lastTime = 0;
+        foreach(const QPointer<Observation> &observation, observations){
+            QCOMPARE(observation->getStation(), stations.at(i));
+            QCOMPARE(observation->getReading()->getCartesianReading().xyz.getAt(0), (double)i);
+            QVERIFY(observation->getReading()->getAcquisitionTime() > lastTime);
+            lastTime = observation->getReading()->getAcquisitionTime();
+        }
+    }
+
+    foreach(const QPointer<Station> &station, stations){
+        manager.removeStation(station);
+        station->resetSensor();
+    }
+    delete job.data();
+
+}
+
+void AcquisitionManagerTest::testRemoveStation(){
+
+    QPointer<OiJob> job;
+    QList<QPointer<Station> > stations;
+    QPointer<FeatureWrapper> feature = this->createJob(job, stations, 2);
+    int geomId = feature->getFeature()->getId();
+
+    AcquisitionManager manager(job);
+    manager.setMergeInterval(60000);
+    SimulatedSensor *sensor = new SimulatedSensor(1.0);
+    QVERIFY(manager.addStation(stations.first()));
+    QVERIFY(manager.addStation(stations.last()));
+    stations.first()->setSensor(sensor);
+    emit stations.first()->connectSensor();
+    QTRY_VERIFY(stations.first()->getIsSensorConnected());
+
+    //pending results are merged when the station is removed
+    QSignalSpy measuredSpy(stations.first().data(), SIGNAL(measurementFinished(int,QList<QPointer<Reading> >)));
+    emit stations.first()->measure(geomId, MeasurementConfig());
+    QTRY_COMPARE(measuredSpy.count(), 1);
+    QCOMPARE(manager.getNumPendingResults(), 1);
+    manager.removeStation(stations.first());
+    QCOMPARE(manager.getNumPendingResults(), 0);
+    QCOMPARE(feature->getGeometry()->getObservations().size(), 1);
+    QCOMPARE(manager.getStations(), QList<QPointer<Station> >() << stations.last());
+    QVERIFY(!manager.hasStation(stations.first()));
+
+    //the sensor worker of the removed station runs in the thread of the manager again
+    emit stations.first()->measure(geomId, MeasurementConfig());
+    QTRY_COMPARE(measuredSpy.count(), 2);
+    QCOMPARE(sensor->measureThread.loadAcquire(), QThread::currentThread());
+    QCOMPARE(manager.getNumPendingResults(), 0);
+
+    //the queue of a deleted station is released
+    QVERIFY(job->removeFeature(stations.last()->getId()));
+    manager.mergeResults();
+    QVERIFY(manager.getStations().isEmpty());
+
+    stations.first()->resetSensor();
+    delete job.data();
+
+}
+
+QTEST_GUILESS_MAIN(AcquisitionManagerTest)
+
+#include "tst_acquisitionmanager.moc"
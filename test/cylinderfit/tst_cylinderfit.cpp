@@ -0,0 +1,203 @@
+#include <QString>
+#include <QtTest>
+#include <random>
+
+#include "chooselalib.h"
+#include "fitfunction.h"
+
+#define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
+
+using namespace oi;
+
+/*!
+ * \brief The CylinderFitter class
+ * Makes the protected cylinder fit of BestFitCylinderUtil accessible
+ */
+class CylinderFitter : public FitFunction, public BestFitCylinderUtil
+{
+public:
+    bool fit(Cylinder &cylinder, const QList<IdPoint> &points){
+        return this->bestFitCylinder(this, cylinder, points, points);
+    }
+};
+
+class CylinderFitTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    CylinderFitTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testDenseAndReducedSolverMatch();
+    void testDenseAndReducedSolverMatchNoisy_data();
+    void testDenseAndReducedSolverMatchNoisy();
+    void benchmarkDenseSolver_data();
+    void benchmarkDenseSolver();
+    void benchmarkReducedSolver_data();
+    void benchmarkReducedSolver();
+
+private:
+    QList<IdPoint> createCylinderPoints(const int &numPoints, const double &sigma = 0.0001);
+    void benchmark(const NormalEquationSolverTypes &solver);
+
+};
+
+CylinderFitTest::CylinderFitTest()
+{
+}
+
+void CylinderFitTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+/*!
+ * \brief CylinderFitTest::createCylinderPoints
+ * Creates noisy points on a cylinder with radius 5 and an axis parallel to z through (1, 2).
+ * The first two points lie on the same generatrix so that they define the approximate axis.
+ * \param numPoints
+ * \param sigma standard deviation of the radial noise
+ * \return
+ */
+QList<IdPoint> CylinderFitTest::createCylinderPoints(const int &numPoints, const double &sigma){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * PI);
+    std::uniform_real_distribution<double> height(-10.0, 10.0);
+    std::normal_distribution<double> noise(0.0, sigma);
+
+    QList<IdPoint> points;
+    points.reserve(numPoints);
+    for(int i = 0; i < numPoints; i++){
+        double a = i < 2 ? 0.3 : angle(generator);
+        double r = 5.0 + noise(generator);
+
+        IdPoint point;
+        point.id = i + 1;
+        point.xyz = OiVec(4);
+        point.xyz.setAt(0, 1.0 + r * qCos(a));
+        point.xyz.setAt(1, 2.0 + r * qSin(a));
+        point.xyz.setAt(2, i == 0 ? -10.0 : (i == 1 ? 10.0 : height(generator)));
+        point.xyz.setAt(3, 1.0);
+        points.append(point);
+    }
+    return points;
+
+}
+
+void CylinderFitTest::testDenseAndReducedSolverMatch(){
+
+    QList<IdPoint> points = this->createCylinderPoints(200);
+
+    CylinderFitter denseFitter;
+    denseFitter.setNormalEquationSolver(eDenseNormalEquation);
+    Cylinder denseCylinder(false);
+    QVERIFY(denseFitter.fit(denseCylinder, points));
+
+    CylinderFitter reducedFitter;
+    reducedFitter.setNormalEquationSolver(eReducedNormalEquation);
+    Cylinder reducedCylinder(false);
+    QVERIFY(reducedFitter.fit(reducedCylinder, points));
+
+    COMPARE_DOUBLE(reducedCylinder.getRadius().getRadius(), 5.0, 0.001);
+    COMPARE_DOUBLE(reducedCylinder.getRadius().getRadius(), denseCylinder.getRadius().getRadius(), 1.0e-9);
+    for(int i = 0; i < 3; i++){
+        COMPARE_DOUBLE(reducedCylinder.getPosition().getVector().getAt(i), denseCylinder.getPosition().getVector().getAt(i), 1.0e-6);
+        COMPARE_DOUBLE(reducedCylinder.getDirection().getVector().getAt(i), denseCylinder.getDirection().getVector().getAt(i), 1.0e-9);
+    }
+    COMPARE_DOUBLE(reducedCylinder.getStatistic().getStdev(), denseCylinder.getStatistic().getStdev(), 1.0e-9);
+
+}
+
+void CylinderFitTest::testDenseAndReducedSolverMatchNoisy_data(){
+    QTest::addColumn<int>("numPoints");
+    QTest::addColumn<double>("sigma");
+    QTest::newRow("50 points, 1 mm") << 50 << 0.001;
+    QTest::newRow("200 points, 1 cm") << 200 << 0.01;
+    QTest::newRow("500 points, 5 cm") << 500 << 0.05;
+}
+
+/*!
+ * \brief CylinderFitTest::testDenseAndReducedSolverMatchNoisy
+ * Both solvers linearize the same model, so they have to converge to the same cylinder even if the
+ * noise is large compared to the default test data. The reduced result is also checked against
+ * the true cylinder to make sure that both did not converge to the same wrong solution.
+ */
+void CylinderFitTest::testDenseAndReducedSolverMatchNoisy(){
+
+    QFETCH(int, numPoints);
+    QFETCH(double, sigma);
+
+    QList<IdPoint> points = this->createCylinderPoints(numPoints, sigma);
+
+    CylinderFitter denseFitter;
+    denseFitter.setNormalEquationSolver(eDenseNormalEquation);
+    Cylinder denseCylinder(false);
+    QVERIFY(denseFitter.fit(denseCylinder, points));
+
+    CylinderFitter reducedFitter;
+    reducedFitter.setNormalEquationSolver(eReducedNormalEquation);
+    Cylinder reducedCylinder(false);
+    QVERIFY(reducedFitter.fit(reducedCylinder, points));
+
+    //compare against the true cylinder
+    COMPARE_DOUBLE(reducedCylinder.getRadius().getRadius(), 5.0, 5.0 * sigma);
+    COMPARE_DOUBLE(std::abs(reducedCylinder.getDirection().getVector().getAt(2)), 1.0, sigma);
+    COMPARE_DOUBLE(reducedCylinder.getStatistic().getStdev(), sigma, 0.5 * sigma);
+
+    //compare dense and reduced solution
+    COMPARE_DOUBLE(reducedCylinder.getRadius().getRadius(), denseCylinder.getRadius().getRadius(), 1.0e-8);
+    for(int i = 0; i < 3; i++){
+        COMPARE_DOUBLE(reducedCylinder.getPosition().getVector().getAt(i), denseCylinder.getPosition().getVector().getAt(i), 1.0e-6);
+        COMPARE_DOUBLE(reducedCylinder.getDirection().getVector().getAt(i), denseCylinder.getDirection().getVector().getAt(i), 1.0e-8);
+    }
+    COMPARE_DOUBLE(reducedCylinder.getStatistic().getStdev(), denseCylinder.getStatistic().getStdev(), 1.0e-8);
+
+}
+
+void CylinderFitTest::benchmark(const NormalEquationSolverTypes &solver){
+
+    QFETCH(int, numPoints);
+
+    QList<IdPoint> points = this->createCylinderPoints(numPoints);
+
+    CylinderFitter fitter;
+    fitter.setNormalEquationSolver(solver);
+    Cylinder cylinder(false);
+
+    bool solved = false;
+    QBENCHMARK{
+        solved = fitter.fit(cylinder, points);
+    }
+    QVERIFY(solved);
+    COMPARE_DOUBLE(cylinder.getRadius().getRadius(), 5.0, 0.001);
+
+}
+
+//the dense normal equation matrix needs (n+5)^2 doubles, so it is only benchmarked for small point counts
+void CylinderFitTest::benchmarkDenseSolver_data(){
+    QTest::addColumn<int>("numPoints");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void CylinderFitTest::benchmarkDenseSolver(){
+    this->benchmark(eDenseNormalEquation);
+}
+
+void CylinderFitTest::benchmarkReducedSolver_data(){
+    QTest::addColumn<int>("numPoints");
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+    QTest::newRow("10000") << 10000;
+    QTest::newRow("100000") << 100000;
+}
+
+void CylinderFitTest::benchmarkReducedSolver(){
+    this->benchmark(eReducedNormalEquation);
+}
+
+QTEST_APPLESS_MAIN(CylinderFitTest)
+
+#include "tst_cylinderfit.moc"
@@ -0,0 +1,293 @@
+#include <QString>
+#include <QtTest>
+
+#include "chooselalib.h"
+#include "featurecontainer.h"
+
+using namespace oi;
+
+class FeatureContainerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    FeatureContainerTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testIndexedList();
+    void testRemoveFeature();
+    void testRemoveFeatures();
+    void testNameAndGroupChanged();
+    void testFeaturesByPrefix();
+    void benchmarkRemoveFeatures_data();
+    void benchmarkRemoveFeatures();
+    void benchmarkFeaturesByPrefix();
+
+private:
+    QList<int> addPoints(FeatureContainer &container, const int &numPoints, const QString &group);
+    void verifyConsistency(const FeatureContainer &container);
+};
+
+FeatureContainerTest::FeatureContainerTest()
+{
+}
+
+void FeatureContainerTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QList<int> FeatureContainerTest::addPoints(FeatureContainer &container, const int &numPoints, const QString &group){
+
+    QList<int> ids;
+    for(int i = 0; i < numPoints; i++){
+        QPointer<Point> point = new Point(false);
+        point->setFeatureName(QString("%1_%2").arg(group).arg(i));
+        point->setGroupName(group);
+        QPointer<FeatureWrapper> feature = new FeatureWrapper();
+        feature->setPoint(point);
+        container.addFeature(feature);
+        ids.append(point->getId());
+    }
+    return ids;
+
+}
+
+void FeatureContainerTest::verifyConsistency(const FeatureContainer &container){
+
+    QCOMPARE(container.getFeaturesList().size(), container.getFeatureCount());
+    QCOMPARE(container.getFeatureIdList().size(), container.getFeatureCount());
+    QCOMPARE(container.getGeometriesList().size(), container.getGeometryCount());
+    QCOMPARE(container.getFeatureCount(ePointFeature), container.getFeaturesList().size());
+
+    int groupCount = 0;
+    foreach(const QString &group, container.getFeatureGroupList()){
+        QVERIFY(container.getFeatureCount(group) > 0);
+        groupCount += container.getFeatureCount(group);
+    }
+    QCOMPARE(groupCount, container.getFeatureCount());
+
+    foreach(const QPointer<FeatureWrapper> &feature, container.getFeaturesList()){
+        QVERIFY(!feature.isNull());
+        int id = feature->getFeature()->getId();
+        QVERIFY(container.getFeatureIdList().contains(id));
+        QVERIFY(container.getFeatureById(id) == feature);
+        QVERIFY(container.getFeatureNameList().contains(feature->getFeature()->getFeatureName()));
+        QVERIFY(container.getFeaturesByName(feature->getFeature()->getFeatureName()).contains(feature));
+        QVERIFY(container.getFeaturesByGroup(feature->getFeature()->getGroupName()).contains(feature));
+    }
+
+}
+
+void FeatureContainerTest::testIndexedList(){
+
+    IndexedList<int, QString> list;
+    QVERIFY(list.append(1, "a"));
+    QVERIFY(list.append(2, "b"));
+    QVERIFY(list.append(3, "c"));
+    QVERIFY(list.append(4, "d"));
+    QVERIFY(!list.append(4, "e"));
+
+    //the last value is moved into the removed position
+    QVERIFY(list.remove(2));
+    QVERIFY(!list.remove(2));
+    QCOMPARE(list.getValues(), QList<QString>() << "a" << "d" << "c");
+    QVERIFY(list.remove(4));
+    QCOMPARE(list.getValues(), QList<QString>() << "a" << "c");
+
+    //bulk removal keeps the order
+    list.append(5, "e");
+    list.append(6, "f");
+    list.remove(QSet<int>() << 1 << 5);
+    QCOMPARE(list.getValues(), QList<QString>() << "c" << "f");
+    QVERIFY(list.contains(6));
+    QVERIFY(list.remove(6));
+    QCOMPARE(list.getValues(), QList<QString>() << "c");
+
+}
+
+void FeatureContainerTest::testRemoveFeature(){
+
+    FeatureContainer container;
+    QList<int> a = this->addPoints(container, 10, "a");
+    QList<int> b = this->addPoints(container, 5, "b");
+
+    QCOMPARE(container.getFeatureCount(), 15);
+    QCOMPARE(container.getFeatureGroupList().size(), 2);
+    this->verifyConsistency(container);
+
+    QVERIFY(container.removeFeature(a.at(3)));
+    QVERIFY(!container.removeFeature(a.at(3)));
+    QCOMPARE(container.getFeatureCount(), 14);
+    QCOMPARE(container.getFeatureCount(QString("a")), 9);
+    QVERIFY(!container.getFeatureNameList().contains("a_3"));
+    this->verifyConsistency(container);
+
+    //the last feature of a group removes the group
+    foreach(const int &id, b){
+        QVERIFY(container.removeFeature(id));
+    }
+    QCOMPARE(container.getFeatureGroupList(), QStringList() << "a");
+    this->verifyConsistency(container);
+
+    //slots of removed features are reused
+    this->addPoints(container, 3, "c");
+    QCOMPARE(container.getFeatureCount(), 12);
+    this->verifyConsistency(container);
+
+    container.removeAll();
+
+}
+
+void FeatureContainerTest::testRemoveFeatures(){
+
+    FeatureContainer container;
+    QList<int> a = this->addPoints(container, 100, "a");
+    QList<int> b = this->addPoints(container, 100, "b");
+
+    //remove every second feature of a and all features of b
+    QSet<int> removed;
+    for(int i = 0; i < a.size(); i += 2){
+        removed.insert(a.at(i));
+    }
+    removed.unite(b.toSet());
+    removed.insert(-1);
+    QVERIFY(!container.removeFeatures(removed));
+
+    QCOMPARE(container.getFeatureCount(), 50);
+    QCOMPARE(container.getFeatureGroupList(), QStringList() << "a");
+    QCOMPARE(container.getFeatureCount(QString("b")), 0);
+    this->verifyConsistency(container);
+
+    //the order of the remaining features is kept
+    for(int i = 0; i < container.getFeatureIdList().size(); i++){
+        QCOMPARE(container.getFeatureIdList().at(i), a.at(2 * i + 1));
+    }
+
+    container.removeAll();
+
+}
+
+void FeatureContainerTest::testNameAndGroupChanged(){
+
+    FeatureContainer container;
+    QList<int> ids = this->addPoints(container, 3, "a");
+
+    QPointer<FeatureWrapper> feature = container.getFeatureById(ids.at(0));
+    feature->getFeature()->setFeatureName("renamed");
+    QVERIFY(container.featureNameChanged(ids.at(0), "a_0"));
+    QVERIFY(container.getFeaturesByName("a_0").isEmpty());
+    QCOMPARE(container.getFeaturesByName("renamed").size(), 1);
+    QVERIFY(!container.getFeatureNameList().contains("a_0"));
+
+    feature->getFeature()->setGroupName("");
+    QVERIFY(container.featureGroupChanged(ids.at(0), "a"));
+    QCOMPARE(container.getFeatureCount(QString("a")), 2);
+    feature->getFeature()->setGroupName("b");
+    QVERIFY(container.featureGroupChanged(ids.at(0), ""));
+    QCOMPARE(container.getFeatureGroupList().size(), 2);
+    QCOMPARE(container.getFeaturesByGroup("b").size(), 1);
+
+    container.removeAll();
+
+}
+
+void FeatureContainerTest::testFeaturesByPrefix(){
+
+    FeatureContainer container;
+    QList<int> a = this->addPoints(container, 20, "a");
+    this->addPoints(container, 5, "ab");
+    this->addPoints(container, 3, "B");
+
+    //case insensitive prefix search
+    QCOMPARE(container.getFeaturesByName("a_1", true).size(), 11);
+    QCOMPARE(container.getFeaturesByName("A_1", true).size(), 11);
+    QCOMPARE(container.getFeaturesByName("a", true).size(), 25);
+    QCOMPARE(container.getFeaturesByName("b_", true).size(), 3);
+    QCOMPARE(container.getFeaturesByName("", true).size(), 28);
+    QVERIFY(container.getFeaturesByName("c", true).isEmpty());
+    QCOMPARE(container.getFeatureNamesByPrefix("ab_"), QStringList() << "ab_0" << "ab_1" << "ab_2" << "ab_3" << "ab_4");
+
+    //renamed features are found with the new name only
+    QPointer<FeatureWrapper> feature = container.getFeatureById(a.at(1));
+    feature->getFeature()->setFeatureName("C_1");
+    QVERIFY(container.featureNameChanged(a.at(1), "a_1"));
+    QCOMPARE(container.getFeaturesByName("a_1", true).size(), 10);
+    QCOMPARE(container.getFeaturesByName("c", true).size(), 1);
+
+    //names that only differ in case are both found
+    feature = container.getFeatureById(a.at(2));
+    feature->getFeature()->setFeatureName("c_1");
+    QVERIFY(container.featureNameChanged(a.at(2), "a_2"));
+    QCOMPARE(container.getFeaturesByName("C_1", true).size(), 2);
+    QCOMPARE(container.getFeatureNamesByPrefix("c").size(), 2);
+
+    //removed features are removed from the index
+    QVERIFY(container.removeFeature(a.at(1)));
+    QCOMPARE(container.getFeaturesByName("c", true).size(), 1);
+    QVERIFY(container.removeFeatures(a.mid(10).toSet()));
+    QCOMPARE(container.getFeaturesByName("a_1", true).size(), 0);
+    QCOMPARE(container.getFeaturesByName("a", true).size(), 13);
+    this->verifyConsistency(container);
+
+    container.removeAll();
+    QVERIFY(container.getFeaturesByName("", true).isEmpty());
+
+}
+
+void FeatureContainerTest::benchmarkRemoveFeatures_data(){
+
+    QTest::addColumn<int>("numFeatures");
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("1k single") << 1000 << false;
+    QTest::newRow("1k bulk") << 1000 << true;
+    QTest::newRow("10k single") << 10000 << false;
+    QTest::newRow("10k bulk") << 10000 << true;
+    QTest::newRow("100k single") << 100000 << false;
+    QTest::newRow("100k bulk") << 100000 << true;
+
+}
+
+void FeatureContainerTest::benchmarkRemoveFeatures(){
+
+    QFETCH(int, numFeatures);
+    QFETCH(bool, bulk);
+
+    //imported nominals in one group
+    FeatureContainer container;
+    QList<int> ids = this->addPoints(container, numFeatures, "nominals");
+
+    QBENCHMARK_ONCE{
+        if(bulk){
+            container.removeFeatures(ids.toSet());
+        }else{
+            foreach(const int &id, ids){
+                container.removeFeature(id);
+            }
+        }
+    }
+
+    QCOMPARE(container.getFeatureCount(), 0);
+
+}
+
+void FeatureContainerTest::benchmarkFeaturesByPrefix(){
+
+    FeatureContainer container;
+    this->addPoints(container, 50000, "nominals");
+    this->addPoints(container, 50, "actuals");
+
+    QList<QPointer<FeatureWrapper> > features;
+    QBENCHMARK{
+        features = container.getFeaturesByName("ACTUALS_", true);
+    }
+
+    QCOMPARE(features.size(), 50);
+    container.removeAll();
+
+}
+
+QTEST_APPLESS_MAIN(FeatureContainerTest)
+
+#include "tst_featurecontainer.moc"
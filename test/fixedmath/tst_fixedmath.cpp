@@ -0,0 +1,324 @@
+#include <QString>
+#include <QtTest>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#include "chooselalib.h"
+#include "fixedmath.h"
+#include "position.h"
+#include "reading.h"
+
+#define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
+
+using namespace oi;
+
+//##########################################
+//count heap allocations made by this binary
+//##########################################
+
+static long allocationCount = 0;
+
+void *operator new(std::size_t size){
+    ++allocationCount;
+    void *p = std::malloc(size ? size : 1);
+    if(!p){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept{
+    std::free(p);
+}
+
+class FixedMathTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    FixedMathTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testConversion();
+    void testMatrixOperations();
+    void testReadingConversion();
+    void testNoAllocations();
+    void benchmarkTransformPoints_data();
+    void benchmarkTransformPoints();
+
+private:
+    QList<OiVec> createPoints(const int &numPoints);
+    Vec3 transformFixed(const QList<OiVec> &points);
+    Vec3 transformOiVec(const QList<OiVec> &points);
+
+};
+
+FixedMathTest::FixedMathTest()
+{
+}
+
+void FixedMathTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QList<OiVec> FixedMathTest::createPoints(const int &numPoints){
+
+    QList<OiVec> points;
+    for(int i = 0; i < numPoints; i++){
+        OiVec xyz(4);
+        xyz.setAt(0, qCos(0.001 * i) * 5.0);
+        xyz.setAt(1, qSin(0.001 * i) * 5.0);
+        xyz.setAt(2, 0.01 * i);
+        xyz.setAt(3, 1.0);
+        points.append(xyz);
+    }
+    return points;
+
+}
+
+/*!
+ * \brief FixedMathTest::transformFixed
+ * Reduces all points by their centroid and rotates them (as done in the fit utilities)
+ * \param points
+ * \return
+ */
+Vec3 FixedMathTest::transformFixed(const QList<OiVec> &points){
+
+    Vec3 centroid;
+    foreach(const OiVec &point, points){
+        centroid += Vec3(point);
+    }
+    centroid /= (double)points.size();
+
+    Mat3 r = Mat3::rotationY(0.2) * Mat3::rotationX(0.1);
+    Vec3 sum;
+    foreach(const OiVec &point, points){
+        sum += r * (Vec3(point) - centroid);
+    }
+    return sum;
+
+}
+
+/*!
+ * \brief FixedMathTest::transformOiVec
+ * Same as transformFixed but with OiVec and OiMat temporaries
+ * \param points
+ * \return
+ */
+Vec3 FixedMathTest::transformOiVec(const QList<OiVec> &points){
+
+    OiVec centroid(4);
+    foreach(const OiVec &point, points){
+        centroid = centroid + point;
+    }
+    centroid = centroid / (double)points.size();
+
+    OiMat r = (Mat3::rotationY(0.2) * Mat3::rotationX(0.1)).toOiMat();
+    OiVec sum(3);
+    foreach(const OiVec &point, points){
+        OiVec reduced = point - centroid;
+        reduced.removeLast();
+        sum = sum + r * reduced;
+    }
+    return Vec3(sum);
+
+}
+
+void FixedMathTest::testConversion(){
+
+    OiVec xyzH(4);
+    xyzH.setAt(0, 1.0);
+    xyzH.setAt(1, 2.0);
+    xyzH.setAt(2, 3.0);
+    xyzH.setAt(3, 2.0);
+
+    //vectors
+    Vec3 xyz(xyzH);
+    QVERIFY(xyz == Vec3(1.0, 2.0, 3.0));
+    QVERIFY(Vec4(xyzH).toCartesian() == Vec3(0.5, 1.0, 1.5));
+    QVERIFY(Vec4(xyz.toOiVec()) == Vec4(1.0, 2.0, 3.0, 1.0));
+    QCOMPARE(xyz.toOiVecH().getSize(), 4);
+    QVERIFY(Vec4(xyz.toOiVecH(2.0)) == Vec4(xyzH));
+
+    //writing into an existing vector keeps its size
+    xyz.setAt(2, 7.0);
+    xyz.assignTo(xyzH);
+    QCOMPARE(xyzH.getSize(), 4);
+    QCOMPARE(xyzH.getAt(2), 7.0);
+    QCOMPARE(xyzH.getAt(3), 2.0);
+
+    //compile time evaluation
+    constexpr Vec3 ez = Vec3(1.0, 0.0, 0.0).cross(Vec3(0.0, 1.0, 0.0));
+    static_assert(ez.z() == 1.0 && ez.dot(ez) == 1.0, "constexpr cross product");
+    static_assert(Mat3::identity().det() == 1.0, "constexpr determinant");
+
+    //positions
+    Position position(Vec3(1.0, 2.0, 3.0));
+    QCOMPARE(position.getVector().getSize(), 3);
+    QCOMPARE(position.getVectorH().getSize(), 4);
+    QCOMPARE(position.getVectorH().getAt(3), 1.0);
+    position.setVector(Vec3(4.0, 5.0, 6.0));
+    QVERIFY(position.getVec3() == Vec3(4.0, 5.0, 6.0));
+    QVERIFY(Vec4(position.getVectorH()) == Vec4(4.0, 5.0, 6.0, 1.0));
+
+}
+
+void FixedMathTest::testMatrixOperations(){
+
+    Mat3 r = Mat3::rotationY(0.3) * Mat3::rotationX(-0.7);
+    OiMat rx(3, 3), ry(3, 3);
+    rx.setAt(0, 0, 1.0);
+    rx.setAt(1, 1, qCos(-0.7));
+    rx.setAt(1, 2, -qSin(-0.7));
+    rx.setAt(2, 1, qSin(-0.7));
+    rx.setAt(2, 2, qCos(-0.7));
+    ry.setAt(0, 0, qCos(0.3));
+    ry.setAt(0, 2, qSin(0.3));
+    ry.setAt(1, 1, 1.0);
+    ry.setAt(2, 0, -qSin(0.3));
+    ry.setAt(2, 2, qCos(0.3));
+    OiMat reference = ry * rx;
+
+    //rotation, transposition and inversion match OiMat
+    Mat3 rInv = r.inv();
+    OiMat referenceInv = reference.inv();
+    for(int i = 0; i < 3; i++){
+        for(int j = 0; j < 3; j++){
+            COMPARE_DOUBLE(r.getAt(i, j), reference.getAt(i, j), 1e-15);
+            COMPARE_DOUBLE(rInv.getAt(i, j), referenceInv.getAt(i, j), 1e-12);
+            COMPARE_DOUBLE(r.t().getAt(i, j), rInv.getAt(i, j), 1e-12);
+        }
+    }
+    COMPARE_DOUBLE(r.det(), 1.0, 1e-12);
+
+    //solve
+    Vec3 b(1.0, -2.0, 0.5);
+    Vec3 x;
+    QVERIFY(Mat3::solve(x, r, b));
+    COMPARE_DOUBLE((r * x - b).length(), 0.0, 1e-12);
+    QVERIFY(!Mat3::solve(x, Mat3(), b));
+    QVERIFY_EXCEPTION_THROWN(Mat3().inv(), std::runtime_error);
+
+    //homogeneous transformation
+    Mat4 trafo(r, Vec3(1.0, 2.0, 3.0));
+    Vec4 p = trafo * Vec4(b, 1.0);
+    Vec4 back = trafo.inv() * p;
+    COMPARE_DOUBLE((back.xyz() - b).length(), 0.0, 1e-12);
+    COMPARE_DOUBLE(back.getAt(3), 1.0, 1e-15);
+    Mat4 product = trafo * trafo.inv();
+    for(int i = 0; i < 4; i++){
+        for(int j = 0; j < 4; j++){
+            COMPARE_DOUBLE(product.getAt(i, j), (i == j) ? 1.0 : 0.0, 1e-12);
+        }
+    }
+
+}
+
+void FixedMathTest::testReadingConversion(){
+
+    Vec3 xyz = Reading::toCartesianVec3(0.5, 1.2, 10.0);
+    Vec3 polar = Reading::toPolarVec3(xyz.x(), xyz.y(), xyz.z());
+    COMPARE_DOUBLE(polar.getAt(0), 0.5, 1e-12);
+    COMPARE_DOUBLE(polar.getAt(1), 1.2, 1e-12);
+    COMPARE_DOUBLE(polar.getAt(2), 10.0, 1e-12);
+
+    //the OiVec variants of the plugin API return the same values
+    OiVec xyzOiVec = Reading::toCartesian(0.5, 1.2, 10.0);
+    QCOMPARE(xyzOiVec.getSize(), 3);
+    QCOMPARE(xyzOiVec.getAt(2), xyz.z());
+    OiVec polarOiVec = Reading::toPolar(xyz.x(), xyz.y(), xyz.z());
+    QCOMPARE(polarOiVec.getSize(), 3);
+    QCOMPARE(polarOiVec.getAt(0), polar.getAt(0));
+    QCOMPARE(polarOiVec.getAt(2), polar.getAt(2));
+    static_assert(!std::is_convertible<Vec3, OiVec>::value && !std::is_convertible<Vec4, OiVec>::value,
+                  "fixed-size vectors must not convert to OiVec implicitly");
+
+    //error propagation matches the OiMat implementation
+    ReadingPolar rPolar;
+    rPolar.azimuth = 0.5;
+    rPolar.zenith = 1.2;
+    rPolar.distance = 10.0;
+    rPolar.sigmaAzimuth = 0.0001;
+    rPolar.sigmaZenith = 0.0002;
+    rPolar.sigmaDistance = 0.00005;
+    rPolar.isValid = true;
+    Reading reading(rPolar);
+
+    OiMat F(3,3);
+    F.setAt(0, 0, qSin(rPolar.zenith) * qCos(rPolar.azimuth));
+    F.setAt(0, 1, rPolar.distance * qSin(rPolar.zenith) * -qSin(rPolar.azimuth));
+    F.setAt(0, 2, rPolar.distance * qCos(rPolar.zenith) * qCos(rPolar.azimuth));
+    F.setAt(1, 0, qSin(rPolar.zenith) * qSin(rPolar.azimuth));
+    F.setAt(1, 1, rPolar.distance * qSin(rPolar.zenith) * qCos(rPolar.azimuth));
+    F.setAt(1, 2, rPolar.distance * qCos(rPolar.zenith) * qSin(rPolar.azimuth));
+    F.setAt(2, 0, qCos(rPolar.zenith));
+    F.setAt(2, 2, rPolar.distance * -qSin(rPolar.zenith));
+    OiMat Sll(3,3);
+    Sll.setAt(0, 0, rPolar.sigmaDistance * rPolar.sigmaDistance);
+    Sll.setAt(1, 1, rPolar.sigmaAzimuth * rPolar.sigmaAzimuth);
+    Sll.setAt(2, 2, rPolar.sigmaZenith * rPolar.sigmaZenith);
+    OiMat Qxx = F * Sll * F.t();
+
+    const ReadingCartesian &cartesian = reading.getCartesianReading();
+    QVERIFY(cartesian.isValid);
+    QCOMPARE(cartesian.sigmaXyz.getSize(), 3);
+    for(int i = 0; i < 3; i++){
+        COMPARE_DOUBLE(cartesian.xyz.getAt(i), xyz.getAt(i), 1e-12);
+        COMPARE_DOUBLE(cartesian.sigmaXyz.getAt(i), qSqrt(Qxx.getAt(i, i)), 1e-15);
+    }
+
+}
+
+void FixedMathTest::testNoAllocations(){
+
+    QList<OiVec> points = this->createPoints(1000);
+
+    long before = allocationCount;
+    Vec3 fixed = this->transformFixed(points);
+    long fixedAllocations = allocationCount - before;
+
+    before = allocationCount;
+    Vec3 reference = this->transformOiVec(points);
+    long oiVecAllocations = allocationCount - before;
+
+    qDebug() << "allocations for 1000 points:" << fixedAllocations << "(fixed size)" << oiVecAllocations << "(OiVec)";
+
+    //the fixed size types never allocate
+    QCOMPARE(fixedAllocations, 0L);
+    COMPARE_DOUBLE((fixed - reference).length(), 0.0, 1e-9);
+
+}
+
+void FixedMathTest::benchmarkTransformPoints_data(){
+
+    QTest::addColumn<bool>("fixedSize");
+
+    QTest::newRow("OiVec") << false;
+    QTest::newRow("fixed size") << true;
+
+}
+
+void FixedMathTest::benchmarkTransformPoints(){
+
+    QFETCH(bool, fixedSize);
+
+    QList<OiVec> points = this->createPoints(10000);
+
+    Vec3 result;
+    QBENCHMARK{
+        if(fixedSize){
+            result = this->transformFixed(points);
+        }else{
+            result = this->transformOiVec(points);
+        }
+    }
+
+    QVERIFY(result.length() < 1e-6);
+
+}
+
+QTEST_APPLESS_MAIN(FixedMathTest)
+
+#include "tst_fixedmath.moc"
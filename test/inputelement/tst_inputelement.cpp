@@ -0,0 +1,211 @@
+#include <QString>
+#include <QtTest>
+
+#include "chooselalib.h"
+#include "function.h"
+#include "oijob.h"
+
+using namespace oi;
+
+/*!
+ * \brief The LegacyInputElement class
+ * The previous layout of InputElement that held one guarded pointer per element type
+ */
+class LegacyInputElement{
+public:
+    LegacyInputElement() : isUsed(true), shouldBeUsed(true), id(-1){}
+    LegacyInputElement(const int &id) : isUsed(true), shouldBeUsed(true), id(id){}
+
+    int id;
+    QString label;
+    ElementTypes typeOfElement;
+
+    QList<GeometryParameters> ignoredDestinationParams;
+    QList<GeometryParameters> ignoredTargetParams;
+
+    bool shouldBeUsed;
+    bool isUsed;
+
+    QPointer<Station> station;
+    QPointer<CoordinateSystem> coordSystem;
+    QPointer<TrafoParam> trafoParam;
+
+    QPointer<Circle> circle;
+    QPointer<Cone> cone;
+    QPointer<Cylinder> cylinder;
+    QPointer<Ellipse> ellipse;
+    QPointer<Ellipsoid> ellipsoid;
+    QPointer<Hyperboloid> hyperboloid;
+    QPointer<Line> line;
+    QPointer<Nurbs> nurbs;
+    QPointer<Paraboloid> paraboloid;
+    QPointer<Plane> plane;
+    QPointer<Point> point;
+    QPointer<PointCloud> pointCloud;
+    QPointer<ScalarEntityAngle> scalarEntityAngle;
+    QPointer<ScalarEntityDistance> scalarEntityDistance;
+    QPointer<ScalarEntityMeasurementSeries> scalarEntityMeasurementSeries;
+    QPointer<ScalarEntityTemperature> scalarEntityTemperature;
+    QPointer<SlottedHole> slottedHole;
+    QPointer<Sphere> sphere;
+    QPointer<Torus> torus;
+
+    QPointer<Geometry> geometry;
+
+    QPointer<Observation> observation;
+    QPointer<Reading> polarReading;
+    QPointer<Reading> directionReading;
+    QPointer<Reading> distanceReading;
+    QPointer<Reading> cartesianReading;
+    QPointer<Reading> temperatureReading;
+    QPointer<Reading> levelReading;
+    QPointer<Reading> undefinedReading;
+};
+
+class InputElementTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    InputElementTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testTypedAccessors();
+    void testMemoryPerInput();
+    void benchmarkCreateElements_data();
+    void benchmarkCreateElements();
+    void benchmarkAttachObservations();
+
+};
+
+InputElementTest::InputElementTest()
+{
+}
+
+void InputElementTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+void InputElementTest::testTypedAccessors(){
+
+    QPointer<Observation> observation = new Observation();
+    InputElement observationElement(observation->getId());
+    observationElement.typeOfElement = eObservationElement;
+    observationElement.setElement(observation);
+
+    QVERIFY(observationElement.getObservation() == observation);
+    QVERIFY(observationElement.getGeometry().isNull());
+    QVERIFY(observationElement.getReading().isNull());
+
+    QPointer<Point> point = new Point(false);
+    InputElement pointElement(point->getId());
+    pointElement.typeOfElement = ePointElement;
+    pointElement.setElement(point);
+
+    QVERIFY(pointElement.getPoint() == point);
+    QVERIFY(pointElement.getGeometry().data() == point.data());
+    QVERIFY(pointElement.getPlane().isNull());
+    QVERIFY(pointElement.getObservation().isNull());
+
+    //the guarded pointer is reset when the element is deleted
+    delete point.data();
+    QVERIFY(pointElement.getPoint().isNull());
+    QVERIFY(pointElement.getGeometry().isNull());
+
+    delete observation.data();
+
+}
+
+void InputElementTest::testMemoryPerInput(){
+
+    //both layouts are measured the same way (the guarded pointers share the weak reference data of the element)
+    const qint64 before = sizeof(LegacyInputElement);
+    const qint64 after = sizeof(InputElement);
+
+    qDebug() << "bytes per input element before:" << before << "after:" << after;
+    QVERIFY(after < before);
+
+}
+
+void InputElementTest::benchmarkCreateElements_data(){
+
+    QTest::addColumn<bool>("legacy");
+
+    QTest::newRow("legacy layout") << true;
+    QTest::newRow("guarded pointer") << false;
+
+}
+
+void InputElementTest::benchmarkCreateElements(){
+
+    QFETCH(bool, legacy);
+
+    QList<QPointer<Observation> > observations;
+    for(int i = 0; i < 100000; i++){
+        observations.append(new Observation());
+    }
+
+    //the part of attaching an observation that depends on the layout: create the element and append it to the list
+    QBENCHMARK{
+        if(legacy){
+            QList<LegacyInputElement> elements;
+            foreach(const QPointer<Observation> &observation, observations){
+                LegacyInputElement element(observation->getId());
+                element.typeOfElement = eObservationElement;
+                element.observation = observation;
+                elements.append(element);
+            }
+            QCOMPARE(elements.size(), 100000);
+        }else{
+            QList<InputElement> elements;
+            foreach(const QPointer<Observation> &observation, observations){
+                InputElement element(observation->getId());
+                element.typeOfElement = eObservationElement;
+                element.setElement(observation);
+                elements.append(element);
+            }
+            QCOMPARE(elements.size(), 100000);
+        }
+    }
+
+    foreach(const QPointer<Observation> &observation, observations){
+        delete observation.data();
+    }
+
+}
+
+void InputElementTest::benchmarkAttachObservations(){
+
+    QList<QPointer<Observation> > observations;
+    for(int i = 0; i < 100000; i++){
+        observations.append(new Observation());
+    }
+
+    QBENCHMARK_ONCE{
+
+        OiJob job;
+        QPointer<Point> point = new Point(false);
+        QPointer<FeatureWrapper> target = new FeatureWrapper();
+        target->setPoint(point);
+        point->addFunction(new Function());
+
+        foreach(const QPointer<Observation> &observation, observations){
+            job.addInputObservation(target, 0, 0, observation);
+        }
+        QCOMPARE(point->getFunctions().first()->getInputElements()[0].size(), 100000);
+
+        delete point.data();
+        delete target.data();
+
+    }
+
+    foreach(const QPointer<Observation> &observation, observations){
+        delete observation.data();
+    }
+
+}
+
+QTEST_APPLESS_MAIN(InputElementTest)
+
+#include "tst_inputelement.moc"
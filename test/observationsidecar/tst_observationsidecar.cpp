@@ -0,0 +1,345 @@
+#include <QString>
+#include <QtTest>
+
+#include "chooselalib.h"
+#include "observation.h"
+#include "observationsidecar.h"
+#include "oijob.h"
+#include "reading.h"
+
+using namespace oi;
+
+class ObservationSidecarTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ObservationSidecarTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testRoundTrip();
+    void testColumns();
+    void testChecksum();
+    void testXmlReference();
+    void testJobSaveAndLoad();
+    void benchmarkLoad();
+
+private:
+    QList<QPointer<Observation> > createObservations(const int &count);
+    void deleteObservations(const QList<QPointer<Observation> > &observations);
+};
+
+ObservationSidecarTest::ObservationSidecarTest()
+{
+}
+
+void ObservationSidecarTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QList<QPointer<Observation> > ObservationSidecarTest::createObservations(const int &count){
+
+    QList<QPointer<Observation> > observations;
+    for(int i = 0; i < count; i++){
+
+        QPointer<Observation> observation = new Observation();
+        QPointer<Reading> reading;
+        if(i % 2 == 0){
+            ReadingPolar polar;
+            polar.isValid = true;
+            polar.azimuth = 0.001 * i;
+            polar.zenith = 1.5;
+            polar.distance = 2.0 + i;
+            polar.sigmaDistance = 0.00002;
+            reading = new Reading(polar);
+        }else{
+            ReadingCartesian cartesian;
+            cartesian.isValid = true;
+            cartesian.xyz.setAt(0, i);
+            cartesian.xyz.setAt(1, -i);
+            cartesian.xyz.setAt(2, 0.5 * i);
+            cartesian.sigmaXyz.setAt(2, 0.001);
+            reading = new Reading(cartesian);
+        }
+        reading->setSensorFace(i % 3 == 0 ? eBackSide : eFrontSide);
+        reading->setMeasuredAt(QDateTime::fromMSecsSinceEpoch(1700000000000LL + i));
+        reading->setObservation(observation);
+        observations.append(observation);
+
+    }
+    return observations;
+
+}
+
+void ObservationSidecarTest::deleteObservations(const QList<QPointer<Observation> > &observations){
+    foreach(const QPointer<Observation> &observation, observations){
+        delete observation.data();
+    }
+}
+
+void ObservationSidecarTest::testRoundTrip(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    QList<QPointer<Observation> > observations = this->createObservations(10);
+    observations.at(1)->setIsSolved(true);
+    observations.at(2)->setIsSolved(true);
+
+    //a level reading gives its observation a direction
+    ReadingLevel level;
+    level.isValid = true;
+    level.i = 0.001;
+    level.j = -0.002;
+    level.k = 1.0;
+    level.sigmaK = 0.0001;
+    QPointer<Reading> levelReading = new Reading(level);
+    QPointer<Observation> levelObservation = new Observation();
+    levelReading->setObservation(levelObservation);
+    observations.append(levelObservation);
+    QVERIFY(levelObservation->getHasDirection());
+
+    ObservationSidecar out;
+    QVERIFY(out.addStation(5, observations.mid(0, 6)));
+    QVERIFY(out.addStation(7, observations.mid(6)));
+    QVERIFY(!out.addStation(7, observations.mid(6)));
+    QVERIFY(out.save(fileName));
+
+    ObservationSidecar in;
+    QVERIFY2(in.load(fileName), qPrintable(in.getErrorMessage()));
+    QCOMPARE(in.getStationBlocks().size(), 2);
+    QCOMPARE(in.getNumObservations(5), 6);
+    QCOMPARE(in.getNumObservations(7), 5);
+
+    QList<QPointer<Observation> > loaded = in.createObservations(5);
+    loaded.append(in.createObservations(7));
+    QCOMPARE(loaded.size(), observations.size());
+
+    for(int i = 0; i < observations.size(); i++){
+
+        QPointer<Reading> expected = observations.at(i)->getReading();
+        QPointer<Reading> actual = loaded.at(i)->getReading();
+
+        QCOMPARE(loaded.at(i)->getId(), observations.at(i)->getId());
+        QCOMPARE(loaded.at(i)->getIsValid(), observations.at(i)->getIsValid());
+        QCOMPARE(loaded.at(i)->getIsSolved(), observations.at(i)->getIsSolved());
+        QCOMPARE(loaded.at(i)->getHasDirection(), observations.at(i)->getHasDirection());
+        QCOMPARE(loaded.at(i)->getIsDummyPoint(), observations.at(i)->getIsDummyPoint());
+        QCOMPARE(loaded.at(i)->getXYZ().getAt(0), observations.at(i)->getXYZ().getAt(0));
+        QVERIFY(!actual.isNull());
+        QCOMPARE(actual->getId(), expected->getId());
+        QCOMPARE(actual->getTypeOfReading(), expected->getTypeOfReading());
+        QCOMPARE(actual->getFace(), expected->getFace());
+        QCOMPARE(actual->getMeasuredAt(), expected->getMeasuredAt());
+        if(expected->getTypeOfReading() == ePolarReading){
+            QCOMPARE(actual->getPolarReading().azimuth, expected->getPolarReading().azimuth);
+            QCOMPARE(actual->getPolarReading().distance, expected->getPolarReading().distance);
+            QCOMPARE(actual->getPolarReading().sigmaDistance, expected->getPolarReading().sigmaDistance);
+            QCOMPARE(actual->getCartesianReading().xyz.getAt(0), expected->getCartesianReading().xyz.getAt(0));
+        }else if(expected->getTypeOfReading() == eLevelReading){
+            QCOMPARE(actual->getLevelReading().j, expected->getLevelReading().j);
+            QCOMPARE(actual->getLevelReading().sigmaK, expected->getLevelReading().sigmaK);
+        }else{
+            QCOMPARE(actual->getCartesianReading().xyz.getAt(1), expected->getCartesianReading().xyz.getAt(1));
+            QCOMPARE(actual->getCartesianReading().sigmaXyz.getAt(2), expected->getCartesianReading().sigmaXyz.getAt(2));
+        }
+
+    }
+
+    this->deleteObservations(observations);
+    this->deleteObservations(loaded);
+
+}
+
+void ObservationSidecarTest::testColumns(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    QList<QPointer<Observation> > observations = this->createObservations(5);
+    ObservationSidecar out;
+    QVERIFY(out.addStation(1, observations));
+    QVERIFY(out.save(fileName));
+
+    //the columns are accessed in place
+    ObservationSidecar in;
+    QVERIFY(in.load(fileName));
+    const qint32 *ids = in.getColumn<qint32>(1, ObservationSidecar::eObservationIds);
+    const double *distances = in.getColumn<double>(1, ObservationSidecar::eValue2);
+    QVERIFY(ids != NULL);
+    QVERIFY(distances != NULL);
+    QCOMPARE((quintptr)distances % 8, quintptr(0));
+    for(int i = 0; i < observations.size(); i++){
+        QCOMPARE(ids[i], observations.at(i)->getId());
+    }
+    QCOMPARE(distances[0], 2.0);
+    QCOMPARE(distances[4], 6.0);
+
+    //wrong value type or unknown station
+    QVERIFY(in.getColumn<float>(1, ObservationSidecar::eValue2) == NULL);
+    QVERIFY(in.getColumn<qint32>(2, ObservationSidecar::eObservationIds) == NULL);
+
+    this->deleteObservations(observations);
+
+}
+
+void ObservationSidecarTest::testChecksum(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    QList<QPointer<Observation> > observations = this->createObservations(100);
+    ObservationSidecar out;
+    QVERIFY(out.addStation(1, observations));
+    QVERIFY(out.save(fileName));
+
+    //flip a byte of the last column
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    file.seek(file.size() - 64);
+    char byte = 0;
+    file.getChar(&byte);
+    file.seek(file.size() - 64);
+    file.putChar(byte ^ 0x10);
+    file.close();
+
+    ObservationSidecar in;
+    QVERIFY(!in.load(fileName));
+    QVERIFY(!in.getErrorMessage().isEmpty());
+    QVERIFY(!in.getIsLoaded());
+    QVERIFY(in.load(fileName, false));
+
+    this->deleteObservations(observations);
+
+}
+
+void ObservationSidecarTest::testXmlReference(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    QList<QPointer<Observation> > observations = this->createObservations(20);
+    ObservationSidecar out;
+    QVERIFY(out.addStation(3, observations));
+    QVERIFY(out.save(fileName));
+
+    QDomDocument document;
+    QDomElement reference = out.toOpenIndyXML(document);
+    QCOMPARE(reference.attribute("file"), QString("job.oiobs"));
+    QDomElement station = reference.firstChildElement("station");
+    QCOMPARE(station.attribute("ref").toInt(), 3);
+    QCOMPARE(station.attribute("count").toInt(), 20);
+    QCOMPARE(station.attribute("firstObservation").toInt(), observations.first()->getId());
+    QCOMPARE(station.attribute("lastObservation").toInt(), observations.last()->getId());
+
+    ObservationSidecar in;
+    QVERIFY2(in.fromOpenIndyXML(reference, QDir(directory.path())), qPrintable(in.getErrorMessage()));
+    QCOMPARE(in.getNumObservations(3), 20);
+
+    //the referenced id range does not match the sidecar
+    station.setAttribute("count", 21);
+    QVERIFY(!in.fromOpenIndyXML(reference, QDir(directory.path())));
+    QVERIFY(!in.getIsLoaded());
+
+    this->deleteObservations(observations);
+
+}
+
+void ObservationSidecarTest::testJobSaveAndLoad(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    //job with a station whose system holds the observations of a point
+    QPointer<OiJob> job = new OiJob();
+    FeatureAttributes stationAttributes;
+    stationAttributes.typeOfFeature = eStationFeature;
+    stationAttributes.name = "STATION";
+    QPointer<Station> station = job->addFeatures(stationAttributes).first()->getStation();
+    station->setActiveStationState(true);
+    FeatureAttributes pointAttributes;
+    pointAttributes.typeOfFeature = ePointFeature;
+    pointAttributes.name = "POINT";
+    pointAttributes.isActual = true;
+    QPointer<FeatureWrapper> point = job->addFeatures(pointAttributes).first();
+
+    QList<QPointer<Reading> > readings;
+    for(int i = 0; i < 20; i++){
+        ReadingPolar polar;
+        polar.isValid = true;
+        polar.azimuth = 0.01 * i;
+        polar.zenith = 1.5;
+        polar.distance = 5.0;
+        readings.append(new Reading(polar));
+    }
+    job->addMeasurementResults(point->getFeature()->getId(), readings);
+    QList<QPointer<Observation> > observations = station->getCoordinateSystem()->getObservations();
+    QCOMPARE(observations.size(), 20);
+
+    ObservationSidecar out;
+    QVERIFY(job->saveObservationSidecar(out, fileName));
+    QCOMPARE(out.getStationBlocks().size(), 1);
+    QCOMPARE(out.getNumObservations(station->getId()), 20);
+
+    //a fresh job generates the same station id
+    QPointer<OiJob> loadedJob = new OiJob();
+    QPointer<Station> loadedStation = loadedJob->addFeatures(stationAttributes).first()->getStation();
+    QCOMPARE(loadedStation->getId(), station->getId());
+
+    ObservationSidecar in;
+    QVERIFY2(in.load(fileName), qPrintable(in.getErrorMessage()));
+    QList<QPointer<Observation> > loaded;
+    QVERIFY(loadedJob->loadObservationSidecar(in, loaded));
+    QCOMPARE(loaded.size(), 20);
+
+    //the observations are part of the station system and keep their ids
+    QPointer<CoordinateSystem> loadedSystem = loadedStation->getCoordinateSystem();
+    QCOMPARE(loadedSystem->getObservations().size(), 20);
+    for(int i = 0; i < observations.size(); i++){
+        QCOMPARE(loadedSystem->getObservations().at(i)->getId(), observations.at(i)->getId());
+        QVERIFY(!loadedSystem->getObservation(observations.at(i)->getId()).isNull());
+        QVERIFY(loaded.at(i)->getStation() == loadedStation);
+        QCOMPARE(loaded.at(i)->getXYZ().getAt(1), observations.at(i)->getXYZ().getAt(1));
+    }
+
+    //ids generated after loading do not collide with the loaded ones
+    QVERIFY(loadedJob->generateUniqueId() > observations.last()->getReading()->getId());
+
+    //unknown stations are rejected
+    QPointer<OiJob> emptyJob = new OiJob();
+    QList<QPointer<Observation> > rejected;
+    QVERIFY(!emptyJob->loadObservationSidecar(in, rejected));
+
+    delete job.data();
+    delete loadedJob.data();
+    delete emptyJob.data();
+
+}
+
+void ObservationSidecarTest::benchmarkLoad(){
+
+    QTemporaryDir directory;
+    QString fileName = directory.path() + "/job.oiobs";
+
+    QList<QPointer<Observation> > observations = this->createObservations(200000);
+    ObservationSidecar out;
+    QVERIFY(out.addStation(1, observations));
+    QVERIFY(out.save(fileName));
+    this->deleteObservations(observations);
+
+    //map the file and create the observations and readings in one store (the load path of a job)
+    QBENCHMARK{
+        ObservationSidecar in;
+        QVERIFY(in.load(fileName, false));
+        QSharedPointer<ObservationStore> store(new ObservationStore());
+        QList<QPointer<Observation> > loaded = in.createObservations(1, store);
+        QCOMPARE(loaded.size(), 200000);
+        this->deleteObservations(loaded);
+    }
+
+}
+
+QTEST_APPLESS_MAIN(ObservationSidecarTest)
+
+#include "tst_observationsidecar.moc"
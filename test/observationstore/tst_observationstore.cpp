@@ -0,0 +1,279 @@
+#include <QString>
+#include <QtTest>
+#include <cstdlib>
+#include <new>
+
+#include "chooselalib.h"
+#include "observation.h"
+#include "observationstore.h"
+#include "reading.h"
+#include "station.h"
+#include "coordinatesystem.h"
+
+#define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
+
+using namespace oi;
+
+//counts the bytes that are requested from the heap (used to measure the memory of both observation layouts)
+static qint64 allocatedBytes = 0;
+
+void *operator new(std::size_t size){
+    allocatedBytes += size;
+    void *p = std::malloc(size == 0 ? 1 : size);
+    if(p == NULL){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept{
+    std::free(p);
+}
+
+/*!
+ * \brief The LegacyObservationData class
+ * Coordinates and states of an observation as they were held before the observation store
+ */
+class LegacyObservationData{
+public:
+    LegacyObservationData() : xyz(4), originalXyz(4), sigmaXyz(4), originalSigmaXyz(4), ijk(4), originalIjk(4),
+        sigmaIjk(4), originalSigmaIjk(4), isValid(false), isSolved(false), hasDirection(false), isDummyPoint(false){}
+
+    OiVec xyz, originalXyz, sigmaXyz, originalSigmaXyz;
+    OiVec ijk, originalIjk, sigmaIjk, originalSigmaIjk;
+    bool isValid, isSolved, hasDirection, isDummyPoint;
+};
+
+/*!
+ * \brief The StoredObservationData class
+ * Members that an observation keeps to reference its data in the observation store
+ */
+class StoredObservationData{
+public:
+    StoredObservationData() : slot(-1){}
+
+    QSharedPointer<ObservationStore> store;
+    int slot;
+};
+
+class ObservationStoreTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ObservationStoreTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testSlotReuse();
+    void testObservationInStationSystem();
+    void testStoreOnAttach();
+    void testDetachedStore();
+    void testBytesPerObservation();
+    void benchmarkAddObservations();
+
+private:
+    QPointer<Observation> createObservation(const double &x, const double &y, const double &z);
+
+};
+
+ObservationStoreTest::ObservationStoreTest()
+{
+}
+
+void ObservationStoreTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QPointer<Observation> ObservationStoreTest::createObservation(const double &x, const double &y, const double &z){
+
+    ReadingCartesian rCartesian;
+    rCartesian.isValid = true;
+    rCartesian.xyz.setAt(0, x);
+    rCartesian.xyz.setAt(1, y);
+    rCartesian.xyz.setAt(2, z);
+
+    QPointer<Reading> reading = new Reading(rCartesian);
+    QPointer<Observation> observation = new Observation();
+    reading->setObservation(observation);
+    return observation;
+
+}
+
+void ObservationStoreTest::testSlotReuse(){
+
+    ObservationStore store;
+    int a = store.allocate(1);
+    int b = store.allocate(2);
+    store.setVector(b, ObservationStore::eXyz, 1.0, 2.0, 3.0, 1.0);
+    store.setFlag(b, ObservationStore::eIsSolved, true);
+    QCOMPARE(store.getSize(), 2);
+
+    store.release(b);
+    QCOMPARE(store.getSize(), 1);
+
+    //the released slot is reused and zero initialized
+    int c = store.allocate(3);
+    QCOMPARE(c, b);
+    QCOMPARE(store.getId(c), 3);
+    QVERIFY(!store.getFlag(c, ObservationStore::eIsSolved));
+    COMPARE_DOUBLE(store.getVector(c, ObservationStore::eXyz)[0], 0.0, 1.0e-12);
+    QCOMPARE(store.getId(a), 1);
+
+}
+
+void ObservationStoreTest::testObservationInStationSystem(){
+
+    QPointer<Station> station = new Station("station");
+    QPointer<CoordinateSystem> stationSystem = station->getCoordinateSystem();
+
+    QPointer<Observation> observation = this->createObservation(1.0, 2.0, 3.0);
+    QVERIFY(observation->getIsValid());
+    COMPARE_DOUBLE(observation->getOriginalXYZ().getAt(2), 3.0, 1.0e-12);
+
+    QVERIFY(stationSystem->addObservation(observation));
+
+    //the observation data was moved to the store of the station system
+    QVERIFY(observation->getStore() == stationSystem->getObservationStore());
+    QCOMPARE(stationSystem->getObservationStore()->getSize(), 1);
+    QVERIFY(observation->getIsValid());
+    COMPARE_DOUBLE(observation->getOriginalXYZ().getAt(0), 1.0, 1.0e-12);
+    COMPARE_DOUBLE(observation->getOriginalXYZ().getAt(1), 2.0, 1.0e-12);
+    COMPARE_DOUBLE(observation->getOriginalXYZ().getAt(2), 3.0, 1.0e-12);
+
+    OiVec xyz(4);
+    xyz.setAt(0, 4.0);
+    xyz.setAt(1, 5.0);
+    xyz.setAt(2, 6.0);
+    xyz.setAt(3, 1.0);
+    observation->setXYZ(xyz);
+    observation->setIsSolved(true);
+    QVERIFY(observation->getIsSolved());
+    COMPARE_DOUBLE(observation->getXYZ().getAt(1), 5.0, 1.0e-12);
+
+    delete station.data();
+
+}
+
+void ObservationStoreTest::testStoreOnAttach(){
+
+    QPointer<Station> station = new Station("station");
+    QPointer<CoordinateSystem> stationSystem = station->getCoordinateSystem();
+    const QSharedPointer<ObservationStore> &store = stationSystem->getObservationStore();
+
+    //an observation without data has no store
+    QPointer<Observation> observation = new Observation();
+    QVERIFY(observation->getStore().isNull());
+    QVERIFY(!observation->getIsValid());
+    QCOMPARE(observation->getVector(ObservationStore::eXyz).getAt(0), 0.0);
+    delete observation.data();
+
+    //an observation that is created in the store of the station system keeps its slot when it is added
+    ReadingCartesian rCartesian;
+    rCartesian.isValid = true;
+    rCartesian.xyz.setAt(0, 7.0);
+    QPointer<Reading> reading = new Reading(rCartesian);
+    observation = new Observation(store);
+    int slot = observation->getStoreSlot();
+    reading->setObservation(observation);
+    QVERIFY(observation->getStore() == store);
+
+    QVERIFY(stationSystem->addObservation(observation));
+    QVERIFY(observation->getStore() == store);
+    QCOMPARE(observation->getStoreSlot(), slot);
+    QCOMPARE(store->getSize(), 1);
+    QCOMPARE(store->getId(slot), observation->getId());
+    QCOMPARE(observation->getVector(ObservationStore::eOriginalXyz).getAt(0), 7.0);
+
+    delete station.data();
+
+}
+
+void ObservationStoreTest::testDetachedStore(){
+
+    //observations that are not part of a station system share one store
+    QPointer<Observation> first = this->createObservation(1.0, 2.0, 3.0);
+    QPointer<Observation> second = this->createObservation(4.0, 5.0, 6.0);
+    QSharedPointer<ObservationStore> detachedStore = first->getStore();
+    QVERIFY(!detachedStore.isNull());
+    QVERIFY(second->getStore() == detachedStore);
+    QVERIFY(first->getStoreSlot() != second->getStoreSlot());
+    COMPARE_DOUBLE(first->getOriginalXYZ().getAt(0), 1.0, 1.0e-12);
+    COMPARE_DOUBLE(second->getOriginalXYZ().getAt(0), 4.0, 1.0e-12);
+    const int detachedSize = detachedStore->getSize();
+
+    //the slot in the detached store is released when the observation is added to a station system
+    QPointer<Station> station = new Station("station");
+    QPointer<CoordinateSystem> stationSystem = station->getCoordinateSystem();
+    QVERIFY(stationSystem->addObservation(first));
+    QVERIFY(first->getStore() == stationSystem->getObservationStore());
+    QCOMPARE(detachedStore->getSize(), detachedSize - 1);
+    COMPARE_DOUBLE(first->getOriginalXYZ().getAt(0), 1.0, 1.0e-12);
+    COMPARE_DOUBLE(second->getOriginalXYZ().getAt(0), 4.0, 1.0e-12);
+
+    //and when a detached observation is deleted
+    delete second.data();
+    QCOMPARE(detachedStore->getSize(), detachedSize - 2);
+
+    delete station.data();
+
+}
+
+void ObservationStoreTest::testBytesPerObservation(){
+
+    const int numObservations = 10000;
+
+    //measure the heap memory of the previous layout
+    QList<LegacyObservationData *> legacy;
+    legacy.reserve(numObservations);
+    qint64 start = allocatedBytes;
+    for(int i = 0; i < numObservations; i++){
+        legacy.append(new LegacyObservationData());
+    }
+    const qint64 before = (allocatedBytes - start) / numObservations;
+    qDeleteAll(legacy);
+
+    //measure the heap memory of the store and the members that reference it
+    QList<StoredObservationData *> stored;
+    stored.reserve(numObservations);
+    QSharedPointer<ObservationStore> store(new ObservationStore());
+    start = allocatedBytes;
+    store->reserve(numObservations);
+    for(int i = 0; i < numObservations; i++){
+        StoredObservationData *data = new StoredObservationData();
+        data->store = store;
+        data->slot = store->allocate(i);
+        stored.append(data);
+    }
+    const qint64 after = (allocatedBytes - start) / numObservations;
+    qDeleteAll(stored);
+
+    qDebug() << "bytes per observation (coordinates and states) before:" << before << "after:" << after;
+    QVERIFY(after < before);
+
+    //reading the data of an observation does not allocate
+    QPointer<Observation> observation = new Observation(store);
+    start = allocatedBytes;
+    Vec4 xyz = observation->getVector(ObservationStore::eXyz);
+    QCOMPARE(allocatedBytes, start);
+    QCOMPARE(xyz.getAt(3), 0.0);
+    delete observation.data();
+
+}
+
+void ObservationStoreTest::benchmarkAddObservations(){
+
+    QBENCHMARK_ONCE{
+        QPointer<Station> station = new Station("station");
+        for(int i = 0; i < 100000; i++){
+            station->getCoordinateSystem()->addObservation(this->createObservation(i, i, i));
+        }
+        QCOMPARE(station->getCoordinateSystem()->getObservationStore()->getSize(), 100000);
+        delete station.data();
+    }
+
+}
+
+QTEST_APPLESS_MAIN(ObservationStoreTest)
+
+#include "tst_observationstore.moc"
@@ -0,0 +1,669 @@
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+#include "chooselalib.h"
+#include "featureattributes.h"
+#include "observation.h"
+#include "oijob.h"
+#include "reading.h"
+
+using namespace oi;
+
+/*!
+ * \brief The ObservationFitFunction class
+ * Fit function that only needs observations
+ */
+class ObservationFitFunction : public Function
+{
+public:
+    ObservationFitFunction(){
+        NeededElement element;
+        element.typeOfElement = eObservationElement;
+        element.infinite = true;
+        this->neededElements.append(element);
+    }
+
+    //derived functions may change their input elements directly
+    void prependInputElement(const InputElement &element, const int &position){
+        this->inputElements[position].prepend(element);
+    }
+};
+
+class OiJobTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    OiJobTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testAddFeaturesBatch();
+    void testAddFeaturesTransactional();
+    void testChangeTransaction();
+    void testAddMeasurementResults();
+    void testGeometryObservations();
+    void testInputElements();
+    void testSetShouldBeUsed();
+    void testRemoveFeatures();
+    void benchmarkAddFeatures_data();
+    void benchmarkAddFeatures();
+    void benchmarkAddMeasurementResults();
+    void benchmarkRemoveObservations_data();
+    void benchmarkRemoveObservations();
+    void benchmarkSetShouldBeUsed_data();
+    void benchmarkSetShouldBeUsed();
+
+private:
+    FeatureAttributes createAttributes(const FeatureTypes &type, const QString &name, const int &count);
+    QPointer<FeatureWrapper> createScanJob(QPointer<OiJob> &job);
+    QList<QPointer<Reading> > createReadings(const int &count);
+};
+
+OiJobTest::OiJobTest()
+{
+}
+
+void OiJobTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+    qRegisterMetaType<QMap<int, int> >("QMap<int,int>");
+    qRegisterMetaType<QPointer<Feature> >("QPointer<Feature>");
+    qRegisterMetaType<QList<int> >("QList<int>");
+    qRegisterMetaType<MessageTypes>("MessageTypes");
+    qRegisterMetaType<MessageDestinations>("MessageDestinations");
+}
+
+FeatureAttributes OiJobTest::createAttributes(const FeatureTypes &type, const QString &name, const int &count){
+
+    FeatureAttributes fAttr;
+    fAttr.typeOfFeature = type;
+    fAttr.name = name;
+    fAttr.count = count;
+    if(getIsGeometry(type)){
+        fAttr.isActual = true;
+    }
+    return fAttr;
+
+}
+
+QPointer<FeatureWrapper> OiJobTest::createScanJob(QPointer<OiJob> &job){
+
+    job = new OiJob();
+
+    //active station
+    QList<QPointer<FeatureWrapper> > stations = job->addFeatures(this->createAttributes(eStationFeature, "STATION", 1));
+    stations.first()->getStation()->setActiveStationState(true);
+
+    //geometry with a fit function
+    QPointer<FeatureWrapper> feature = job->addFeatures(this->createAttributes(ePlaneFeature, "SCAN", 1)).first();
+    feature->getFeature()->addFunction(new ObservationFitFunction());
+    return feature;
+
+}
+
+QList<QPointer<Reading> > OiJobTest::createReadings(const int &count){
+
+    QList<QPointer<Reading> > readings;
+    for(int i = 0; i < count; i++){
+        ReadingPolar polar;
+        polar.isValid = true;
+        polar.azimuth = 0.0001 * i;
+        polar.zenith = 1.5;
+        polar.distance = 5.0;
+        readings.append(new Reading(polar));
+    }
+    return readings;
+
+}
+
+void OiJobTest::testAddFeaturesBatch(){
+
+    QPointer<OiJob> job = new OiJob();
+    QCOMPARE(job->addFeatures(this->createAttributes(eCoordinateSystemFeature, "PART", 1)).size(), 1);
+
+    FeatureAttributes points = this->createAttributes(ePointFeature, "P01", 10);
+    points.isNominal = true;
+    points.nominalSystem = "PART";
+    points.group = "grid";
+    FeatureAttributes planes = this->createAttributes(ePlaneFeature, "PL1", 5);
+    planes.group = "grid";
+
+    QSignalSpy featureSetSpy(job.data(), SIGNAL(featureSetChanged()));
+    QSignalSpy geometrySetSpy(job.data(), SIGNAL(geometrySetChanged()));
+    QSignalSpy groupsSpy(job.data(), SIGNAL(availableGroupsChanged()));
+
+    QList<QPointer<FeatureWrapper> > features = job->addFeatures(QList<FeatureAttributes>() << points << planes);
+    QCOMPARE(features.size(), 25);
+    QCOMPARE(job->getFeatureCount(), 26);
+
+    //one notification for the whole batch
+    QCOMPARE(featureSetSpy.count(), 1);
+    QCOMPARE(geometrySetSpy.count(), 1);
+    QCOMPARE(groupsSpy.count(), 1);
+
+    //the ids are taken from one block
+    for(int i = 1; i < features.size(); i++){
+        QCOMPARE(features.at(i)->getFeature()->getId(), features.at(i - 1)->getFeature()->getId() + 1);
+    }
+    QVERIFY(job->generateUniqueId() > features.last()->getFeature()->getId());
+
+    //nominals and actuals are linked
+    QCOMPARE(job->getFeaturesByName("P10").size(), 2);
+    foreach(const QPointer<FeatureWrapper> &feature, job->getFeaturesByType(ePointFeature)){
+        if(feature->getGeometry()->getIsNominal()){
+            QVERIFY(!feature->getGeometry()->getActual().isNull());
+            QCOMPARE(feature->getGeometry()->getNominalSystem()->getFeatureName(), QString("PART"));
+        }else{
+            QCOMPARE(feature->getGeometry()->getNominals().size(), 1);
+        }
+    }
+
+    //the features are connected to the job
+    features.first()->getFeature()->setFeatureName("renamed");
+    QCOMPARE(job->getFeaturesByName("renamed").size(), 1);
+
+    delete job.data();
+
+}
+
+void OiJobTest::testAddFeaturesTransactional(){
+
+    QPointer<OiJob> job = new OiJob();
+    QCOMPARE(job->addFeatures(this->createAttributes(ePointFeature, "P", 3)).size(), 3);
+
+    //one invalid attribute rejects the whole batch
+    QList<FeatureAttributes> fAttrs;
+    fAttrs.append(this->createAttributes(ePlaneFeature, "PL", 3));
+    fAttrs.append(this->createAttributes(ePointFeature, "P02", 1));
+    QVERIFY(job->addFeatures(fAttrs).isEmpty());
+    QCOMPARE(job->getFeatureCount(), 3);
+
+    //two actuals of the same type must not share a name within the batch
+    fAttrs.clear();
+    fAttrs.append(this->createAttributes(eCircleFeature, "C01", 2));
+    fAttrs.append(this->createAttributes(eCircleFeature, "C02", 1));
+    QVERIFY(job->addFeatures(fAttrs).isEmpty());
+    QCOMPARE(job->getFeatureCount(), 3);
+
+    //neither may non-geometries
+    fAttrs.clear();
+    fAttrs.append(this->createAttributes(eCoordinateSystemFeature, "PART", 1));
+    fAttrs.append(this->createAttributes(eCoordinateSystemFeature, "PART", 1));
+    QVERIFY(job->addFeatures(fAttrs).isEmpty());
+    QCOMPARE(job->getFeatureCount(), 3);
+
+    //geometries of different types and a nominal and an actual of one type may share a name (like in validateFeatureName)
+    QCOMPARE(job->addFeatures(this->createAttributes(eCoordinateSystemFeature, "PART", 1)).size(), 1);
+    FeatureAttributes nominal = this->createAttributes(eCircleFeature, "C10", 1);
+    nominal.isActual = false;
+    nominal.isNominal = true;
+    nominal.nominalSystem = "PART";
+    fAttrs.clear();
+    fAttrs.append(this->createAttributes(eCircleFeature, "C10", 1));
+    fAttrs.append(this->createAttributes(ePlaneFeature, "C10", 1));
+    fAttrs.append(nominal);
+    QCOMPARE(job->addFeatures(fAttrs).size(), 3);
+    QCOMPARE(job->getFeaturesByName("C10").size(), 3);
+
+    //but not two nominals of one type in the same nominal system
+    fAttrs.clear();
+    nominal.name = "C20";
+    fAttrs.append(nominal);
+    fAttrs.append(nominal);
+    QVERIFY(job->addFeatures(fAttrs).isEmpty());
+
+    delete job.data();
+
+}
+
+void OiJobTest::testChangeTransaction(){
+
+    QPointer<OiJob> job = new OiJob();
+    QList<QPointer<FeatureWrapper> > features = job->addFeatures(this->createAttributes(ePointFeature, "P", 100));
+    QCOMPARE(features.size(), 100);
+
+    QSignalSpy attributesSpy(job.data(), SIGNAL(featureAttributesChanged()));
+    QSignalSpy commentSpy(job.data(), SIGNAL(featureCommentChanged(int)));
+    QSignalSpy commonSpy(job.data(), SIGNAL(geometryIsCommonChanged(int)));
+    QSignalSpy changesSpy(job.data(), SIGNAL(featuresChanged(QMap<int,int>)));
+
+    //without a transaction each change is emitted
+    features.at(0)->getFeature()->setComment("first");
+    QCOMPARE(attributesSpy.count(), 1);
+    QCOMPARE(commentSpy.count(), 1);
+    QCOMPARE(changesSpy.count(), 0);
+    attributesSpy.clear();
+    commentSpy.clear();
+
+    //nested transactions emit once on the outermost commit
+    job->beginChanges();
+    {
+        JobChangeTransaction transaction(job);
+        foreach(const QPointer<FeatureWrapper> &feature, features){
+            feature->getFeature()->setComment("changed");
+            feature->getFeature()->setComment("changed again");
+            feature->getGeometry()->setCommonState(true);
+        }
+    }
+    QVERIFY(job->getIsCollectingChanges());
+    QCOMPARE(commentSpy.count(), 0);
+    QCOMPARE(changesSpy.count(), 0);
+    job->commitChanges();
+    QVERIFY(!job->getIsCollectingChanges());
+
+    //the legacy signals are emitted once per feature
+    QCOMPARE(commentSpy.count(), 100);
+    QCOMPARE(commonSpy.count(), 100);
+    QCOMPARE(commentSpy.at(5).at(0).toInt(), features.at(5)->getFeature()->getId());
+    QCOMPARE(attributesSpy.count(), 1);
+    QCOMPARE(changesSpy.count(), 1);
+    QCOMPARE(job->getSuppressedSignalCount(), 500 - 201);
+
+    QMap<int, int> changes = changesSpy.at(0).at(0).value<QMap<int, int> >();
+    QCOMPARE(changes.size(), 100);
+    QCOMPARE(changes.value(features.at(5)->getFeature()->getId()), (int)(eFeatureAttributesChange | eGeometryChange));
+
+    //an empty transaction emits nothing
+    job->beginChanges();
+    job->commitChanges();
+    QCOMPARE(changesSpy.count(), 1);
+
+    delete job.data();
+
+}
+
+void OiJobTest::testAddMeasurementResults(){
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+    QVERIFY(!job->getActiveStation().isNull());
+    QPointer<CoordinateSystem> stationSystem = job->getActiveStation()->getCoordinateSystem();
+
+    QSignalSpy observationsSpy(job.data(), SIGNAL(geometryObservationsChanged(int)));
+    QSignalSpy systemSpy(job.data(), SIGNAL(systemObservationsChanged(int,int)));
+    QSignalSpy addedSpy(job.data(), SIGNAL(systemObservationsAdded(int,QList<int>)));
+
+    QList<QPointer<Reading> > readings = this->createReadings(1000);
+    readings.append(QPointer<Reading>());
+    job->addMeasurementResults(feature->getFeature()->getId(), readings);
+
+    //all observations are added with one notification
+    QCOMPARE(observationsSpy.count(), 1);
+    QCOMPARE(feature->getGeometry()->getObservations().size(), 1000);
+    QCOMPARE(stationSystem->getObservations().size(), 1000);
+    QCOMPARE(feature->getGeometry()->getUsedReadingTypes(), QList<ReadingTypes>() << ePolarReading);
+
+    //the ids of observations and readings are unique
+    QSet<int> ids;
+    foreach(const QPointer<Observation> &observation, feature->getGeometry()->getObservations()){
+        QVERIFY(!ids.contains(observation->getId()));
+        ids.insert(observation->getId());
+        QVERIFY(!ids.contains(observation->getReading()->getId()));
+        ids.insert(observation->getReading()->getId());
+        QCOMPARE(observation->getStation(), job->getActiveStation());
+        QVERIFY(stationSystem->getObservation(observation->getId()) == observation);
+        QCOMPARE(observation->getTargetGeometries().size(), 1);
+    }
+
+    //the station system reports the last added observation and the ids of all added observations
+    QCOMPARE(systemSpy.count(), 1);
+    QCOMPARE(systemSpy.at(0).at(1).toInt(), stationSystem->getObservations().last()->getId());
+    QCOMPARE(addedSpy.count(), 1);
+    QList<int> addedIds = addedSpy.at(0).at(1).value<QList<int> >();
+    QCOMPARE(addedIds.size(), 1000);
+    for(int i = 0; i < addedIds.size(); i++){
+        QCOMPARE(addedIds.at(i), stationSystem->getObservations().at(i)->getId());
+    }
+
+    //all observations are inputs of the fit function
+    QCOMPARE(feature->getFeature()->getFunctions().first()->getInputElements().value(InputElementKey::eDefault).size(), 1000);
+
+    //adding the observations again does not duplicate them
+    feature->getGeometry()->addObservations(feature->getGeometry()->getObservations());
+    QCOMPARE(feature->getGeometry()->getObservations().size(), 1000);
+
+    //within a transaction the legacy signal is emitted once on commit
+    observationsSpy.clear();
+    job->beginChanges();
+    job->addMeasurementResults(feature->getFeature()->getId(), this->createReadings(10));
+    job->addMeasurementResults(feature->getFeature()->getId(), this->createReadings(10));
+    QCOMPARE(observationsSpy.count(), 0);
+    job->commitChanges();
+    QCOMPARE(observationsSpy.count(), 1);
+    QCOMPARE(observationsSpy.at(0).at(0).toInt(), feature->getFeature()->getId());
+
+    delete job.data();
+
+}
+
+void OiJobTest::testGeometryObservations(){
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+    QPointer<Geometry> geometry = feature->getGeometry();
+
+    QList<QPointer<Reading> > readings = this->createReadings(10);
+    ReadingCartesian cartesian;
+    cartesian.isValid = true;
+    readings.append(new Reading(cartesian));
+    job->addMeasurementResults(feature->getFeature()->getId(), readings);
+
+    QList<QPointer<Observation> > observations = geometry->getObservations();
+    QCOMPARE(observations.size(), 11);
+    QCOMPARE(geometry->getUsedReadingTypes().size(), 2);
+    foreach(const QPointer<Observation> &observation, observations){
+        QVERIFY(geometry->hasObservation(observation));
+    }
+
+    //single add and remove keep both sides in sync
+    QPointer<Observation> first = observations.first();
+    geometry->removeObservation(first);
+    QVERIFY(!geometry->hasObservation(first));
+    QVERIFY(first->getTargetGeometries().isEmpty());
+    QCOMPARE(geometry->getObservations().size(), 10);
+    geometry->addObservation(first);
+    geometry->addObservation(first);
+    QCOMPARE(geometry->getObservations().size(), 11);
+    QCOMPARE(first->getTargetGeometries().size(), 1);
+
+    //a reading type is used as long as one observation has it
+    geometry->removeObservation(observations.last());
+    QCOMPARE(geometry->getUsedReadingTypes(), QList<ReadingTypes>() << ePolarReading);
+    geometry->removeObservation(observations.at(1));
+    QCOMPARE(geometry->getUsedReadingTypes(), QList<ReadingTypes>() << ePolarReading);
+
+    //bulk removal by id
+    QSignalSpy observationsSpy(geometry.data(), SIGNAL(geomObservationsChanged(int)));
+    QSet<int> ids;
+    for(int i = 2; i < 6; i++){
+        ids.insert(observations.at(i)->getId());
+    }
+    ids.insert(-5);
+    geometry->removeObservations(ids);
+    QCOMPARE(observationsSpy.count(), 1);
+    QCOMPARE(geometry->getObservations().size(), 5);
+    for(int i = 2; i < 6; i++){
+        QVERIFY(!geometry->hasObservation(observations.at(i)));
+        QVERIFY(observations.at(i)->getTargetGeometries().isEmpty());
+    }
+
+    //deleted observations are removed from the geometry
+    delete observations.at(6).data();
+    QCOMPARE(geometry->getObservations().size(), 4);
+
+    delete job.data();
+
+}
+
+void OiJobTest::testInputElements(){
+
+    ObservationFitFunction function;
+    QSignalSpy elementsSpy(&function, SIGNAL(inputElementsChanged()));
+
+    QList<InputElement> elements;
+    for(int i = 0; i < 10; i++){
+        InputElement element(i);
+        element.typeOfElement = eObservationElement;
+        elements.append(element);
+    }
+    function.addInputElements(elements, 0);
+    function.addInputElement(InputElement(3), 1);
+    QCOMPARE(elementsSpy.count(), 2);
+
+    //lookup by id
+    QVERIFY(function.hasInputElement(7));
+    QVERIFY(!function.hasInputElement(10));
+    QCOMPARE(function.getInputElement(7).id, 7);
+    QCOMPARE(function.getInputElement(7, 0).typeOfElement, eObservationElement);
+    QCOMPARE(function.getInputElement(7, 1).id, -1);
+    QCOMPARE(function.getInputElement(10).id, -1);
+
+    //removing an element keeps the order and the remaining ones accessible
+    function.removeInputElement(0, 0);
+    function.removeInputElement(5, 0);
+    QCOMPARE(function.getInputElements().value(0).size(), 8);
+    QList<int> ids;
+    foreach(const InputElement &element, function.getInputElements().value(0)){
+        ids.append(element.id);
+    }
+    QCOMPARE(ids, QList<int>() << 1 << 2 << 3 << 4 << 6 << 7 << 8 << 9);
+    for(int i = 1; i < 10; i++){
+        QCOMPARE(function.getInputElement(i, 0).id, i == 5 ? -1 : i);
+    }
+    function.addInputElement(InputElement(5), 0);
+    QCOMPARE(function.getInputElements().value(0).last().id, 5);
+    QCOMPARE(function.getInputElement(5, 0).id, 5);
+
+    //duplicate ids are indexed and removed one by one (the first one first)
+    InputElement duplicate(-1);
+    duplicate.shouldBeUsed = false;
+    function.addInputElement(duplicate, 2);
+    function.addInputElement(InputElement(-1), 2);
+    function.addInputElement(InputElement(11), 2);
+    QVERIFY(!function.getInputElement(-1, 2).shouldBeUsed);
+    function.removeInputElement(-1, 2);
+    QCOMPARE(function.getInputElements().value(2).size(), 2);
+    QVERIFY(function.getInputElement(-1, 2).shouldBeUsed);
+    QCOMPARE(function.getInputElement(11, 2).id, 11);
+    QCOMPARE(function.getInputElement(12, 2).id, -1);
+
+    //elements added directly by derived functions are found as well
+    function.prependInputElement(InputElement(20), 2);
+    QCOMPARE(function.getInputElement(20, 2).id, 20);
+    QCOMPARE(function.getInputElement(11, 2).id, 11);
+    function.removeInputElement(-1, 2);
+    QCOMPARE(function.getInputElements().value(2).size(), 2);
+    QCOMPARE(function.getInputElement(20, 2).id, 20);
+    QCOMPARE(function.getInputElement(11, 2).id, 11);
+
+    //removing an element from all positions emits only once
+    elementsSpy.clear();
+    function.removeInputElement(3);
+    QCOMPARE(elementsSpy.count(), 1);
+    QVERIFY(!function.hasInputElement(3));
+    function.removeInputElement(3);
+    QCOMPARE(elementsSpy.count(), 1);
+
+    //bulk use state
+    elementsSpy.clear();
+    QCOMPARE(function.setShouldBeUsed(0, QSet<int>() << 1 << 2 << 4 << 42, false), 3);
+    QCOMPARE(elementsSpy.count(), 1);
+    QVERIFY(!function.getShouldBeUsed(0, 1));
+    QVERIFY(function.getShouldBeUsed(0, 5));
+    QCOMPARE(function.setShouldBeUsed(0, QSet<int>() << 1 << 2, false), 0);
+    QCOMPARE(elementsSpy.count(), 1);
+
+}
+
+void OiJobTest::testSetShouldBeUsed(){
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+    job->addMeasurementResults(feature->getFeature()->getId(), this->createReadings(100));
+    QPointer<Function> function = feature->getFeature()->getFunctions().first();
+
+    QSignalSpy recalcSpy(job.data(), SIGNAL(recalcFeature(QPointer<Feature>)));
+    QSignalSpy elementsSpy(function.data(), SIGNAL(inputElementsChanged()));
+
+    //disabling all observations recalculates the feature once
+    job->disableObservations(feature->getFeature()->getId());
+    QCOMPARE(recalcSpy.count(), 1);
+    QCOMPARE(elementsSpy.count(), 1);
+    foreach(const InputElement &element, function->getInputElements().value(0)){
+        QVERIFY(!element.shouldBeUsed);
+    }
+
+    //nothing changes if the state is already set
+    job->disableObservations(feature->getFeature()->getId());
+    QCOMPARE(recalcSpy.count(), 1);
+
+    //bulk enable a subset
+    QSet<int> ids;
+    QList<QPointer<Observation> > observations = feature->getGeometry()->getObservations();
+    for(int i = 0; i < 10; i++){
+        ids.insert(observations.at(i)->getId());
+    }
+    job->setShouldBeUsed(feature, 0, 0, ids, true, true);
+    QCOMPARE(recalcSpy.count(), 2);
+    QVERIFY(function->getShouldBeUsed(0, observations.at(0)->getId()));
+    QVERIFY(!function->getShouldBeUsed(0, observations.at(10)->getId()));
+
+    delete job.data();
+
+}
+
+void OiJobTest::testRemoveFeatures(){
+
+    QPointer<OiJob> job = new OiJob();
+    QPointer<FeatureWrapper> station = job->addFeatures(this->createAttributes(eStationFeature, "STATION", 1)).first();
+    station->getStation()->setActiveStationState(true);
+    QList<QPointer<FeatureWrapper> > points = job->addFeatures(this->createAttributes(ePointFeature, "P01", 3));
+
+    int numFeatures = job->getFeatureCount();
+    QSignalSpy messageSpy(job.data(), SIGNAL(sendMessage(QString,MessageTypes,MessageDestinations)));
+
+    //the active station is kept and reported, the points are removed
+    QList<QPointer<FeatureWrapper> > features = points;
+    features.append(station);
+    QVERIFY(!job->removeFeatures(features));
+    QCOMPARE(job->getFeatureCount(), numFeatures - 3);
+    QVERIFY(!job->getFeatureById(station->getFeature()->getId()).isNull());
+
+    bool reported = false;
+    for(int i = 0; i < messageSpy.count(); i++){
+        if(messageSpy.at(i).first().toString() == QString("Cannot remove feature STATION")){
+            reported = true;
+        }
+    }
+    QVERIFY(reported);
+
+    delete job.data();
+
+}
+
+void OiJobTest::benchmarkAddFeatures_data(){
+
+    QTest::addColumn<int>("numFeatures");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+
+}
+
+void OiJobTest::benchmarkAddFeatures(){
+
+    QFETCH(int, numFeatures);
+
+    //grid points from a template
+    QPointer<OiJob> job = new OiJob();
+    FeatureAttributes fAttr = this->createAttributes(ePointFeature, "GRID", numFeatures);
+
+    QList<QPointer<FeatureWrapper> > features;
+    QBENCHMARK_ONCE{
+        features = job->addFeatures(fAttr);
+    }
+
+    QCOMPARE(features.size(), numFeatures);
+    delete job.data();
+
+}
+
+void OiJobTest::benchmarkAddMeasurementResults(){
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+
+    //scan burst of a laser tracker
+    QList<QPointer<Reading> > readings = this->createReadings(100000);
+    QBENCHMARK_ONCE{
+        job->addMeasurementResults(feature->getFeature()->getId(), readings);
+    }
+
+    QCOMPARE(feature->getGeometry()->getObservations().size(), 100000);
+    delete job.data();
+
+}
+
+void OiJobTest::benchmarkRemoveObservations_data(){
+
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("single") << false;
+    QTest::newRow("bulk") << true;
+
+}
+
+void OiJobTest::benchmarkRemoveObservations(){
+
+    QFETCH(bool, bulk);
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+    job->addMeasurementResults(feature->getFeature()->getId(), this->createReadings(50000));
+
+    //remove every second observation of a 50k point plane
+    QList<QPointer<Observation> > observations = feature->getGeometry()->getObservations();
+    QSet<int> ids;
+    for(int i = 0; i < observations.size(); i += 2){
+        ids.insert(observations.at(i)->getId());
+    }
+
+    QBENCHMARK_ONCE{
+        if(bulk){
+            feature->getGeometry()->removeObservations(ids);
+        }else{
+            for(int i = 0; i < observations.size(); i += 2){
+                feature->getGeometry()->removeObservation(observations.at(i));
+            }
+        }
+    }
+
+    QCOMPARE(feature->getGeometry()->getObservations().size(), 25000);
+    delete job.data();
+
+}
+
+void OiJobTest::benchmarkSetShouldBeUsed_data(){
+
+    QTest::addColumn<bool>("bulk");
+
+    QTest::newRow("single") << false;
+    QTest::newRow("bulk") << true;
+
+}
+
+void OiJobTest::benchmarkSetShouldBeUsed(){
+
+    QFETCH(bool, bulk);
+
+    QPointer<OiJob> job;
+    QPointer<FeatureWrapper> feature = this->createScanJob(job);
+    job->addMeasurementResults(feature->getFeature()->getId(), this->createReadings(50000));
+
+    //disable every second observation of a 50k point plane
+    QList<QPointer<Observation> > observations = feature->getGeometry()->getObservations();
+    QSet<int> ids;
+    for(int i = 0; i < observations.size(); i += 2){
+        ids.insert(observations.at(i)->getId());
+    }
+
+    QBENCHMARK_ONCE{
+        if(bulk){
+            job->setShouldBeUsed(feature, 0, 0, ids, false, true);
+        }else{
+            foreach(const int &id, ids){
+                job->setShouldBeUsed(feature, 0, 0, id, false, true);
+            }
+        }
+    }
+
+    QVERIFY(!feature->getFeature()->getFunctions().first()->getShouldBeUsed(0, observations.first()->getId()));
+    delete job.data();
+
+}
+
+QTEST_APPLESS_MAIN(OiJobTest)
+
+#include "tst_oijob.moc"
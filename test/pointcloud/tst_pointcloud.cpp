@@ -0,0 +1,232 @@
+#include <QString>
+#include <QtTest>
+#include <cstdlib>
+#include <new>
+
+#include "chooselalib.h"
+#include "pointcloud.h"
+
+using namespace oi;
+
+//##########################################
+//count heap allocations made by this binary
+//##########################################
+
+static long allocationCount = 0;
+
+void *operator new(std::size_t size){
+    ++allocationCount;
+    void *p = std::malloc(size ? size : 1);
+    if(!p){
+        throw std::bad_alloc();
+    }
+    return p;
+}
+
+void operator delete(void *p) noexcept{
+    std::free(p);
+}
+
+class PointCloudTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    PointCloudTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testAddPoints();
+    void testAddPointsInBulk();
+    void testBoundingBox();
+    void testPointSpan();
+    void testCopy();
+    void benchmarkAddPointsInBulk();
+};
+
+PointCloudTest::PointCloudTest()
+{
+}
+
+void PointCloudTest::initTestCase(){
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+void PointCloudTest::testAddPoints(){
+
+    PointCloud pointCloud(false);
+    QCOMPARE(pointCloud.getPointCount(), 0ul);
+
+    Point_PC point;
+    point.xyz[0] = 1.0f;
+    point.xyz[1] = 2.0f;
+    point.xyz[2] = 3.0f;
+    point.isUsed = true;
+    pointCloud.addPointCloudPoint(point);
+    pointCloud.addPointCloudPoint(4.0f, 5.0f, 6.0f);
+    QCOMPARE(pointCloud.getPointCount(), 2ul);
+
+    Point_PC first = pointCloud.getPointCloudPoint(0);
+    QCOMPARE(first.xyz[0], 1.0f);
+    QCOMPARE(first.xyz[1], 2.0f);
+    QCOMPARE(first.xyz[2], 3.0f);
+    QVERIFY(first.isUsed);
+
+    Point_PC second = pointCloud.getPointCloudPoint(1);
+    QCOMPARE(second.xyz[2], 6.0f);
+    QVERIFY(!second.isUsed);
+
+    //used state
+    pointCloud.setPointIsUsed(1, true);
+    QVERIFY(pointCloud.getPointIsUsed(1));
+    pointCloud.setPointIsUsed(0, false);
+    QVERIFY(!pointCloud.getPointIsUsed(0));
+
+    //invalid indices are ignored
+    pointCloud.setPointIsUsed(2, true);
+    QVERIFY(!pointCloud.getPointIsUsed(2));
+    QVERIFY(!pointCloud.getPointIsUsed(-1));
+    QCOMPARE(pointCloud.getPointCloudPoint(5).xyz[0], 0.0f);
+
+    //clear
+    pointCloud.clearPoints();
+    QCOMPARE(pointCloud.getPointCount(), 0ul);
+    QVERIFY(!pointCloud.getBoundingBox().isValid());
+
+}
+
+void PointCloudTest::testAddPointsInBulk(){
+
+    PointCloud pointCloud(false);
+    pointCloud.addPointCloudPoint(-1.0f, -1.0f, -1.0f, true);
+
+    const float xyz[] = {0.0f, 0.5f, 1.0f,
+                         2.0f, 2.5f, 3.0f,
+                         4.0f, 4.5f, 5.0f};
+    pointCloud.addPointCloudPoints(xyz, 3, false);
+    QCOMPARE(pointCloud.getPointCount(), 4ul);
+
+    //the points are appended in order behind the existing points
+    QCOMPARE(pointCloud.getPointCloudPoint(0).xyz[0], -1.0f);
+    QVERIFY(pointCloud.getPointIsUsed(0));
+    for(int i = 0; i < 3; i++){
+        Point_PC point = pointCloud.getPointCloudPoint(i + 1);
+        QCOMPARE(point.xyz[0], xyz[3 * i]);
+        QCOMPARE(point.xyz[1], xyz[3 * i + 1]);
+        QCOMPARE(point.xyz[2], xyz[3 * i + 2]);
+        QVERIFY(!point.isUsed);
+    }
+
+    //invalid input is ignored
+    pointCloud.addPointCloudPoints(NULL, 3);
+    pointCloud.addPointCloudPoints(xyz, 0);
+    QCOMPARE(pointCloud.getPointCount(), 4ul);
+
+    //reserved point clouds do not allocate while points are added
+    PointCloud reserved(false);
+    reserved.reservePoints(1000);
+    long allocations = allocationCount;
+    for(int i = 0; i < 1000; i++){
+        reserved.addPointCloudPoint(i, i, i);
+    }
+    QCOMPARE(allocationCount, allocations);
+    QCOMPARE(reserved.getPointCount(), 1000ul);
+
+}
+
+void PointCloudTest::testBoundingBox(){
+
+    PointCloud pointCloud(false);
+    QVERIFY(!pointCloud.getBoundingBox().isValid());
+
+    pointCloud.addPointCloudPoint(1.0f, -2.0f, 3.0f);
+    QVERIFY(pointCloud.getBoundingBox().isValid());
+    QCOMPARE(pointCloud.getBoundingBox().min[1], -2.0f);
+    QCOMPARE(pointCloud.getBoundingBox().max[1], -2.0f);
+
+    //the bounding box is extended by single and bulk points
+    const float xyz[] = {-5.0f, 0.0f, 10.0f,
+                          7.0f, 1.0f, -3.0f};
+    pointCloud.addPointCloudPoints(xyz, 2);
+    pointCloud.addPointCloudPoint(0.0f, 8.0f, 0.0f);
+
+    const BoundingBox_PC &bbox = pointCloud.getBoundingBox();
+    QCOMPARE(bbox.min[0], -5.0f);
+    QCOMPARE(bbox.max[0], 7.0f);
+    QCOMPARE(bbox.min[1], -2.0f);
+    QCOMPARE(bbox.max[1], 8.0f);
+    QCOMPARE(bbox.min[2], -3.0f);
+    QCOMPARE(bbox.max[2], 10.0f);
+
+    //reset
+    BoundingBox_PC empty;
+    QVERIFY(!empty.isValid());
+    pointCloud.setBoundingBox(empty);
+    QVERIFY(!pointCloud.getBoundingBox().isValid());
+
+}
+
+void PointCloudTest::testPointSpan(){
+
+    PointCloud pointCloud(false);
+    PointSpan_PC span = pointCloud.getPoints();
+    QCOMPARE(span.count, 0);
+
+    pointCloud.addPointCloudPoint(1.0f, 2.0f, 3.0f, true);
+    pointCloud.addPointCloudPoint(4.0f, 5.0f, 6.0f, false);
+
+    //the span is a view on the buffers of the point cloud
+    long allocations = allocationCount;
+    span = pointCloud.getPoints();
+    QCOMPARE(allocationCount, allocations);
+    QCOMPARE(span.count, 2);
+    QCOMPARE(span.xyz[0], 1.0f);
+    QCOMPARE(span.xyz[5], 6.0f);
+    QCOMPARE(span.isUsed[0], (quint8)1);
+    QCOMPARE(span.isUsed[1], (quint8)0);
+
+    //changes of the used state are visible in the span
+    pointCloud.setPointIsUsed(1, true);
+    QCOMPARE(span.isUsed[1], (quint8)1);
+
+}
+
+void PointCloudTest::testCopy(){
+
+    PointCloud pointCloud(false);
+    const float xyz[] = {1.0f, 2.0f, 3.0f,
+                         -1.0f, -2.0f, -3.0f};
+    pointCloud.addPointCloudPoints(xyz, 2, true);
+
+    PointCloud copy(pointCloud);
+    QCOMPARE(copy.getPointCount(), 2ul);
+    QCOMPARE(copy.getPointCloudPoint(1).xyz[2], -3.0f);
+    QVERIFY(copy.getPointIsUsed(1));
+    QCOMPARE(copy.getBoundingBox().min[0], -1.0f);
+    QCOMPARE(copy.getBoundingBox().max[0], 1.0f);
+
+    //the copy has its own buffers
+    copy.setPointIsUsed(1, false);
+    QVERIFY(pointCloud.getPointIsUsed(1));
+
+}
+
+void PointCloudTest::benchmarkAddPointsInBulk(){
+
+    const int numPoints = 1000000;
+    QVector<float> xyz(3 * numPoints);
+    for(int i = 0; i < xyz.size(); i++){
+        xyz[i] = (float)(i % 1000) * 0.001f;
+    }
+
+    QBENCHMARK{
+        PointCloud pointCloud(false);
+        pointCloud.addPointCloudPoints(xyz.constData(), numPoints);
+        QCOMPARE(pointCloud.getPointCount(), (unsigned long)numPoints);
+    }
+
+}
+
+QTEST_APPLESS_MAIN(PointCloudTest)
+
+#include "tst_pointcloud.moc"
@@ -4,10 +4,55 @@
 #include "chooselalib.h"
 #include "reading.h"
 
+#if defined(Q_OS_LINUX) && defined(__GLIBC__)
+#include <malloc.h>
+#define HAS_HEAP_USAGE
+#endif
+
 #define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
 
 using namespace oi;
 
+/*!
+ * \brief The LegacyReading class
+ * Layout of a reading that holds all reading types, all backups and copies of its configs
+ * (used as reference for the memory usage of Reading)
+ */
+class LegacyReading : public Element
+{
+public:
+    ReadingTypes typeOfReading;
+
+    ReadingPolar rPolar;
+    ReadingCartesian rCartesian;
+    ReadingCartesian6D rCartesian6D;
+    ReadingDirection rDirection;
+    ReadingDistance rDistance;
+    ReadingTemperature rTemperature;
+    ReadingLevel rLevel;
+    ReadingUndefined rUndefined;
+
+    ReadingPolar backupPolar;
+    ReadingCartesian backupCartesian;
+    ReadingDirection backupDirection;
+    ReadingDistance backupDistance;
+    ReadingTemperature backupTemperature;
+    ReadingLevel backupLevel;
+    ReadingUndefined backupUndefined;
+
+    QDateTime measuredAt;
+    MeasurementConfig mConfig;
+    QString measurementConfigName;
+    SensorFaces face;
+    bool imported;
+
+    SensorConfiguration sConfig;
+    QString sensorConfigName;
+    QPointer<Observation> observation;
+
+    bool hasBackup;
+};
+
 class ReadingTest : public QObject
 {
     Q_OBJECT
@@ -24,9 +69,16 @@ private Q_SLOTS:
     void testDirectionReading();
     void testTemperatureReading();
     void testLevelReading();
+    void testBackup();
+    void testSharedConfigs();
+    void testMemoryUsage();
 
 private:
     QPointer<Reading> writeReadXml(QPointer<Reading> r);
+
+    static qint64 getHeapUsage();
+    static SensorConfiguration createSensorConfig(const QString &name);
+    static MeasurementConfig createMeasurementConfig(const QString &name);
 };
 
 void ReadingTest::initTestCase() {
@@ -204,6 +256,214 @@ void ReadingTest::testLevelReading(){
 
 }
 
+void ReadingTest::testBackup(){
+
+    ReadingPolar reading;
+    reading.isValid = true;
+    reading.azimuth = 1.2;
+    reading.zenith = 0.8;
+    reading.distance = 10.0;
+
+    //restoring without a backup does nothing
+    Reading polar(reading);
+    polar.restoreBackup();
+    COMPARE_DOUBLE(polar.getPolarReading().azimuth, 1.2, 1e-12);
+
+    //a reading only holds the values of its type
+    QVERIFY(polar.getCartesianReading().isValid);
+    QVERIFY(!polar.getDistanceReading().isValid);
+    QVERIFY(!polar.getCartesianReading6D().isValid);
+
+    polar.makeBackup();
+    ReadingPolar simulated = reading;
+    simulated.azimuth = 1.3;
+    polar.setPolarReading(simulated);
+    COMPARE_DOUBLE(polar.getPolarReading().azimuth, 1.3, 1e-12);
+
+    //copies keep their own backup
+    Reading copy(polar);
+    polar.restoreBackup();
+    COMPARE_DOUBLE(polar.getPolarReading().azimuth, 1.2, 1e-12);
+    COMPARE_DOUBLE(copy.getPolarReading().azimuth, 1.3, 1e-12);
+    copy.restoreBackup();
+    COMPARE_DOUBLE(copy.getPolarReading().azimuth, 1.2, 1e-12);
+    QCOMPARE(copy.getTypeOfReading(), ePolarReading);
+
+    //simulated values cannot be set for other reading types
+    ReadingDistance distance;
+    distance.isValid = true;
+    distance.distance = 5.0;
+    Reading distanceReading(distance);
+    distanceReading.setPolarReading(simulated);
+    QCOMPARE(distanceReading.getTypeOfReading(), eDistanceReading);
+    QVERIFY(!distanceReading.getPolarReading().isValid);
+    COMPARE_DOUBLE(distanceReading.getDistanceReading().distance, 5.0, 1e-12);
+
+}
+
+void ReadingTest::testSharedConfigs(){
+
+    ReadingDistance distance;
+    distance.isValid = true;
+    distance.distance = 5.0;
+
+    const int numInterned = SensorConfigurationHandle::getNumInterned();
+    {
+        Reading first(distance), second(distance), third(distance);
+        first.setSensorConfiguration(this->createSensorConfig("tracker"));
+        second.setSensorConfiguration(this->createSensorConfig("tracker"));
+
+        //identical configs are shared
+        QVERIFY(&first.getSensorConfiguration() == &second.getSensorConfiguration());
+        QCOMPARE(first.getDisplaySensorConfigName(), QString("tracker"));
+        QCOMPARE(SensorConfigurationHandle::getNumInterned(), numInterned + 1);
+
+        //configs with the same name but other attributes are not
+        SensorConfiguration other = this->createSensorConfig("tracker");
+        Accuracy accuracy = other.getAccuracy();
+        accuracy.sigmaDistance = 0.0001;
+        other.setAccuracy(accuracy);
+        third.setSensorConfiguration(other);
+        QVERIFY(&first.getSensorConfiguration() != &third.getSensorConfiguration());
+        COMPARE_DOUBLE(third.getSensorConfiguration().getAccuracy().sigmaDistance, 0.0001, 1e-12);
+        QCOMPARE(SensorConfigurationHandle::getNumInterned(), numInterned + 2);
+
+        //copies share the config
+        Reading copy(first);
+        QVERIFY(&copy.getSensorConfiguration() == &first.getSensorConfiguration());
+
+        first.setMeasurementConfig(this->createMeasurementConfig("fast"));
+        second.setMeasurementConfig(MeasurementConfigHandle::intern(this->createMeasurementConfig("fast")));
+        QVERIFY(&first.getMeasurementConfig() == &second.getMeasurementConfig());
+        QCOMPARE(second.getDisplayMeasurementConfigName(), QString("fast"));
+    }
+
+    //configs are released with their last reading
+    QCOMPARE(SensorConfigurationHandle::getNumInterned(), numInterned);
+
+    //readings without config return a default config
+    Reading reading(distance);
+    QVERIFY(reading.getSensorConfiguration().getName().isEmpty());
+
+}
+
+/*!
+ * \brief ReadingTest::testMemoryUsage
+ * Reports the memory usage of a reading compared to a reading that holds all reading types, all backups
+ * and copies of its configs (the heap usage is only available for glibc)
+ */
+void ReadingTest::testMemoryUsage(){
+
+    const int numReadings = 10000;
+    const SensorConfiguration sConfig = this->createSensorConfig("tracker");
+    const MeasurementConfig mConfig = this->createMeasurementConfig("fast");
+
+    ReadingPolar polar;
+    polar.isValid = true;
+    polar.azimuth = 1.2;
+    polar.zenith = 0.8;
+    polar.distance = 10.0;
+    polar.sigmaAzimuth = 0.0001;
+    polar.sigmaZenith = 0.0001;
+    polar.sigmaDistance = 0.00005;
+
+    //legacy layout
+    QList<LegacyReading *> legacyReadings;
+    legacyReadings.reserve(numReadings);
+    qint64 heap = this->getHeapUsage();
+    for(int i = 0; i < numReadings; i++){
+        LegacyReading *reading = new LegacyReading();
+        reading->typeOfReading = ePolarReading;
+        reading->rPolar = polar;
+        reading->rCartesian.isValid = true;
+        reading->mConfig = mConfig;
+        reading->measurementConfigName = mConfig.getName();
+        reading->sConfig = sConfig;
+        reading->sensorConfigName = sConfig.getName();
+        reading->hasBackup = false;
+        legacyReadings.append(reading);
+    }
+    const qint64 legacyHeap = (this->getHeapUsage() - heap) / numReadings;
+    qDeleteAll(legacyReadings);
+
+    //variant layout
+    QList<Reading *> readings;
+    readings.reserve(numReadings);
+    heap = this->getHeapUsage();
+    for(int i = 0; i < numReadings; i++){
+        Reading *reading = new Reading(polar);
+        reading->setMeasurementConfig(mConfig);
+        reading->setSensorConfiguration(sConfig);
+        readings.append(reading);
+    }
+    const qint64 readingHeap = (this->getHeapUsage() - heap) / numReadings;
+
+    //backups are allocated on demand
+    heap = this->getHeapUsage();
+    foreach(Reading *reading, readings){
+        reading->makeBackup();
+    }
+    const qint64 backupHeap = (this->getHeapUsage() - heap) / numReadings;
+    qDeleteAll(readings);
+
+    qDebug() << "polar reading before:" << sizeof(LegacyReading) << "bytes," << legacyHeap << "bytes incl. heap";
+    qDebug() << "polar reading after:" << sizeof(Reading) << "bytes," << readingHeap << "bytes incl. heap,"
+             << backupHeap << "bytes per backup";
+
+    QVERIFY(sizeof(Reading) < sizeof(LegacyReading));
+#if defined(HAS_HEAP_USAGE)
+    QVERIFY(readingHeap < legacyHeap);
+#endif
+
+}
+
+/*!
+ * \brief ReadingTest::getHeapUsage
+ * \return
+ */
+qint64 ReadingTest::getHeapUsage(){
+#if defined(HAS_HEAP_USAGE) && __GLIBC_PREREQ(2, 33)
+    return (qint64)mallinfo2().uordblks;
+#elif defined(HAS_HEAP_USAGE)
+    return (qint64)mallinfo().uordblks;
+#else
+    return 0;
+#endif
+}
+
+SensorConfiguration ReadingTest::createSensorConfig(const QString &name){
+
+    SensorConfiguration sConfig;
+    sConfig.setName(name);
+    sConfig.setTypeOfSensor(eLaserTracker);
+    sConfig.setPluginName("OpenIndy Default Plugin");
+    sConfig.setSensorName("LaserTracker Simulator");
+
+    Accuracy accuracy;
+    accuracy.sigmaAzimuth = 0.00001;
+    accuracy.sigmaZenith = 0.00001;
+    accuracy.sigmaDistance = 0.00002;
+    sConfig.setAccuracy(accuracy);
+
+    QMap<QString, double> doubleParameter;
+    doubleParameter.insert("temperature", 20.0);
+    doubleParameter.insert("pressure", 1013.25);
+    sConfig.setDoubleParameter(doubleParameter);
+
+    return sConfig;
+
+}
+
+MeasurementConfig ReadingTest::createMeasurementConfig(const QString &name){
+
+    MeasurementConfig mConfig;
+    mConfig.setName(name);
+    mConfig.setMeasurementMode(eFast_MeasurementMode);
+    mConfig.setMaxObservations(100);
+    return mConfig;
+
+}
+
 QTEST_APPLESS_MAIN(ReadingTest)
 
 #include "tst_reading.moc"
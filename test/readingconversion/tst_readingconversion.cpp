@@ -0,0 +1,292 @@
+#include <QString>
+#include <QtTest>
+
+#include "chooselalib.h"
+#include "readingconversion.h"
+#include "reading.h"
+
+#define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
+
+using namespace oi;
+
+Q_DECLARE_METATYPE(oi::ConversionKernel)
+
+class ReadingConversionTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    ReadingConversionTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testPolarToCartesian();
+    void testSpecialAngles();
+    void testCartesianToPolar();
+    void testCreatePolarReadings();
+    void testConvertPolarReadings();
+    void benchmarkPolarToCartesian_data();
+    void benchmarkPolarToCartesian();
+
+private:
+    PolarReadingBatch createReadings(const int &numReadings);
+
+};
+
+ReadingConversionTest::ReadingConversionTest()
+{
+}
+
+void ReadingConversionTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+    qDebug() << "best conversion kernel:" << getConversionKernelName(getBestConversionKernel());
+}
+
+/*!
+ * \brief ReadingConversionTest::createReadings
+ * Creates pseudo random readings with angles outside of [-pi, pi] and distances up to 100 m
+ * \param numReadings
+ * \return
+ */
+PolarReadingBatch ReadingConversionTest::createReadings(const int &numReadings){
+
+    PolarReadingBatch polar;
+    polar.reserve(numReadings);
+    quint32 seed = 4711;
+    for(int i = 0; i < numReadings; i++){
+        seed = seed * 1664525u + 1013904223u;
+        const double r1 = (double)(seed >> 8) / (double)(1 << 24);
+        seed = seed * 1664525u + 1013904223u;
+        const double r2 = (double)(seed >> 8) / (double)(1 << 24);
+        polar.append(-10.0 + 20.0 * r1, 3.2 * r2, 0.1 + 100.0 * r1 * r2,
+                     0.0001 * r2, 0.0002 * r1, 0.00005 + 0.00001 * r1);
+    }
+    return polar;
+
+}
+
+void ReadingConversionTest::testPolarToCartesian(){
+
+    //odd size to check the scalar tail of the vectorized kernels
+    PolarReadingBatch polar = this->createReadings(10007);
+
+    CartesianReadingBatch scalar, vectorized;
+    polarToCartesian(polar, scalar, eScalarKernel);
+    polarToCartesian(polar, vectorized, getBestConversionKernel());
+
+    QCOMPARE(scalar.size(), polar.size());
+    QCOMPARE(vectorized.size(), polar.size());
+    for(int i = 0; i < polar.size(); i++){
+        COMPARE_DOUBLE(vectorized.x.at(i), scalar.x.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.y.at(i), scalar.y.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.z.at(i), scalar.z.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaX.at(i), scalar.sigmaX.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaY.at(i), scalar.sigmaY.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaZ.at(i), scalar.sigmaZ.at(i), 1e-12);
+    }
+
+    //the scalar kernel equals the conversion of a single reading
+    for(int i = 0; i < polar.size(); i += 101){
+        ReadingPolar rPolar;
+        rPolar.azimuth = polar.azimuth.at(i);
+        rPolar.zenith = polar.zenith.at(i);
+        rPolar.distance = polar.distance.at(i);
+        rPolar.sigmaAzimuth = polar.sigmaAzimuth.at(i);
+        rPolar.sigmaZenith = polar.sigmaZenith.at(i);
+        rPolar.sigmaDistance = polar.sigmaDistance.at(i);
+        rPolar.isValid = true;
+        Reading reading(rPolar);
+        const ReadingCartesian &cartesian = reading.getCartesianReading();
+        COMPARE_DOUBLE(scalar.x.at(i), cartesian.xyz.getAt(0), 1e-12);
+        COMPARE_DOUBLE(scalar.y.at(i), cartesian.xyz.getAt(1), 1e-12);
+        COMPARE_DOUBLE(scalar.z.at(i), cartesian.xyz.getAt(2), 1e-12);
+        COMPARE_DOUBLE(scalar.sigmaX.at(i), cartesian.sigmaXyz.getAt(0), 1e-15);
+        COMPARE_DOUBLE(scalar.sigmaY.at(i), cartesian.sigmaXyz.getAt(1), 1e-15);
+        COMPARE_DOUBLE(scalar.sigmaZ.at(i), cartesian.sigmaXyz.getAt(2), 1e-15);
+    }
+
+}
+
+void ReadingConversionTest::testSpecialAngles(){
+
+    //angles at the boundaries of the quadrants of the vectorized sine and cosine
+    QList<double> angles;
+    angles << 0.0 << M_PI / 4.0 << M_PI / 2.0 << 3.0 * M_PI / 4.0 << M_PI << -M_PI << -M_PI / 2.0
+           << 2.0 * M_PI << 1e-300 << -0.0 << 100.0 << -100.0;
+
+    PolarReadingBatch polar;
+    foreach(const double &azimuth, angles){
+        foreach(const double &zenith, angles){
+            polar.append(azimuth, zenith, 10.0, 0.0001, 0.0001, 0.0001);
+        }
+    }
+
+    CartesianReadingBatch scalar, vectorized;
+    polarToCartesian(polar, scalar, eScalarKernel);
+    polarToCartesian(polar, vectorized, getBestConversionKernel());
+    for(int i = 0; i < polar.size(); i++){
+        COMPARE_DOUBLE(vectorized.x.at(i), scalar.x.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.y.at(i), scalar.y.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.z.at(i), scalar.z.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaX.at(i), scalar.sigmaX.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaY.at(i), scalar.sigmaY.at(i), 1e-12);
+        COMPARE_DOUBLE(vectorized.sigmaZ.at(i), scalar.sigmaZ.at(i), 1e-12);
+    }
+
+    //readings without sigmas are converted with zero sigmas
+    PolarReadingBatch withoutSigmas;
+    withoutSigmas.azimuth << 0.5 << 0.7;
+    withoutSigmas.zenith << 1.2 << 1.3;
+    withoutSigmas.distance << 10.0 << 20.0;
+    CartesianReadingBatch cartesian;
+    polarToCartesian(withoutSigmas, cartesian);
+    QCOMPARE(cartesian.size(), 2);
+    QCOMPARE(cartesian.sigmaX.at(1), 0.0);
+    COMPARE_DOUBLE(cartesian.z.at(1), 20.0 * qCos(1.3), 1e-12);
+
+}
+
+void ReadingConversionTest::testCartesianToPolar(){
+
+    PolarReadingBatch polar = this->createReadings(1001);
+    CartesianReadingBatch cartesian;
+    polarToCartesian(polar, cartesian);
+
+    PolarReadingBatch back;
+    cartesianToPolar(cartesian, back);
+    QCOMPARE(back.size(), polar.size());
+    for(int i = 0; i < polar.size(); i++){
+        Vec3 xyz = Reading::toCartesianVec3(back.azimuth.at(i), back.zenith.at(i), back.distance.at(i));
+        COMPARE_DOUBLE(back.distance.at(i), polar.distance.at(i), 1e-12);
+        COMPARE_DOUBLE(xyz.x(), cartesian.x.at(i), 1e-12);
+        COMPARE_DOUBLE(xyz.y(), cartesian.y.at(i), 1e-12);
+        COMPARE_DOUBLE(xyz.z(), cartesian.z.at(i), 1e-12);
+        QCOMPARE(back.sigmaDistance.at(i), 0.0);
+    }
+
+}
+
+void ReadingConversionTest::testCreatePolarReadings(){
+
+    QList<ReadingPolar> polarReadings;
+    for(int i = 0; i < 11; i++){
+        ReadingPolar rPolar;
+        rPolar.azimuth = 0.1 * i;
+        rPolar.zenith = 0.5 + 0.05 * i;
+        rPolar.distance = 1.0 + i;
+        rPolar.sigmaAzimuth = 0.0001;
+        rPolar.sigmaZenith = 0.0002;
+        rPolar.sigmaDistance = 0.00005;
+        rPolar.isValid = (i != 5);
+        polarReadings.append(rPolar);
+    }
+
+    QList<QPointer<Reading> > readings = Reading::createPolarReadings(polarReadings);
+    QCOMPARE(readings.size(), polarReadings.size());
+    for(int i = 0; i < readings.size(); i++){
+
+        Reading reference(polarReadings.at(i));
+        QVERIFY(!readings.at(i).isNull());
+        QCOMPARE(readings.at(i)->getTypeOfReading(), ePolarReading);
+        QCOMPARE(readings.at(i)->getPolarReading().isValid, polarReadings.at(i).isValid);
+        QCOMPARE(readings.at(i)->getCartesianReading().isValid, reference.getCartesianReading().isValid);
+        for(int j = 0; j < 3; j++){
+            COMPARE_DOUBLE(readings.at(i)->getCartesianReading().xyz.getAt(j), reference.getCartesianReading().xyz.getAt(j), 1e-12);
+            COMPARE_DOUBLE(readings.at(i)->getCartesianReading().sigmaXyz.getAt(j), reference.getCartesianReading().sigmaXyz.getAt(j), 1e-12);
+        }
+
+    }
+
+    foreach(const QPointer<Reading> &reading, readings){
+        delete reading.data();
+    }
+
+}
+
+void ReadingConversionTest::testConvertPolarReadings(){
+
+    QList<ReadingPolar> polarReadings;
+    for(int i = 0; i < 7; i++){
+        ReadingPolar rPolar;
+        rPolar.azimuth = 0.3 * i;
+        rPolar.zenith = 0.2 + 0.1 * i;
+        rPolar.distance = 2.0 + i;
+        rPolar.sigmaAzimuth = 0.0001;
+        rPolar.sigmaZenith = 0.0002;
+        rPolar.sigmaDistance = 0.00005;
+        rPolar.isValid = (i != 3);
+        polarReadings.append(rPolar);
+    }
+
+    //deferred readings are not converted until convertPolarReadings is called
+    QList<QPointer<Reading> > readings = Reading::createPolarReadings(polarReadings, false);
+    QCOMPARE(readings.size(), polarReadings.size());
+    foreach(const QPointer<Reading> &reading, readings){
+        QVERIFY(!reading->getCartesianReading().isValid);
+    }
+
+    //mix in readings of other types and a reading that was converted already
+    ReadingCartesian rCartesian;
+    Vec3(1.0, 2.0, 3.0).assignTo(rCartesian.xyz);
+    Vec3(0.1, 0.1, 0.1).assignTo(rCartesian.sigmaXyz);
+    rCartesian.isValid = true;
+    readings.append(new Reading(rCartesian));
+    readings.append(new Reading(polarReadings.first()));
+    readings.append(QPointer<Reading>());
+
+    Reading::convertPolarReadings(readings);
+
+    for(int i = 0; i < polarReadings.size(); i++){
+
+        Reading reference(polarReadings.at(i));
+        QCOMPARE(readings.at(i)->getTypeOfReading(), ePolarReading);
+        QCOMPARE(readings.at(i)->getCartesianReading().isValid, reference.getCartesianReading().isValid);
+        for(int j = 0; j < 3; j++){
+            COMPARE_DOUBLE(readings.at(i)->getCartesianReading().xyz.getAt(j), reference.getCartesianReading().xyz.getAt(j), 1e-12);
+            COMPARE_DOUBLE(readings.at(i)->getCartesianReading().sigmaXyz.getAt(j), reference.getCartesianReading().sigmaXyz.getAt(j), 1e-12);
+        }
+
+    }
+    QCOMPARE(readings.at(polarReadings.size())->getTypeOfReading(), eCartesianReading);
+    COMPARE_DOUBLE(readings.at(polarReadings.size())->getCartesianReading().xyz.getAt(2), 3.0, 1e-12);
+
+    foreach(const QPointer<Reading> &reading, readings){
+        if(!reading.isNull()){
+            delete reading.data();
+        }
+    }
+
+}
+
+void ReadingConversionTest::benchmarkPolarToCartesian_data(){
+
+    QTest::addColumn<oi::ConversionKernel>("kernel");
+
+    QTest::newRow("scalar") << eScalarKernel;
+    if(getIsConversionKernelAvailable(eAvx2Kernel)){
+        QTest::newRow("AVX2") << eAvx2Kernel;
+    }
+    if(getIsConversionKernelAvailable(eNeonKernel)){
+        QTest::newRow("NEON") << eNeonKernel;
+    }
+
+}
+
+void ReadingConversionTest::benchmarkPolarToCartesian(){
+
+    QFETCH(oi::ConversionKernel, kernel);
+
+    PolarReadingBatch polar = this->createReadings(100000);
+    CartesianReadingBatch cartesian;
+
+    QBENCHMARK{
+        polarToCartesian(polar, cartesian, kernel);
+    }
+
+    QCOMPARE(cartesian.size(), polar.size());
+
+}
+
+QTEST_APPLESS_MAIN(ReadingConversionTest)
+
+#include "tst_readingconversion.moc"
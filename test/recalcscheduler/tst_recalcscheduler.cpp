@@ -0,0 +1,513 @@
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+#include <cmath>
+
+#include "chooselalib.h"
+#include "featurewrapper.h"
+#include "fitfunction.h"
+#include "point.h"
+#include "recalcscheduler.h"
+
+using namespace oi;
+
+/*!
+ * \brief The ValuePoint class
+ * Point whose recalc derives a value from the values of the features it needs
+ */
+class ValuePoint : public Point
+{
+public:
+    ValuePoint(const int &id) : Point(id, false, Position()), value(id){}
+
+    void recalc(){
+        double result = this->getId();
+        foreach(const QPointer<FeatureWrapper> &needed, this->getPreviouslyNeeded()){
+            ValuePoint *point = dynamic_cast<ValuePoint *>(needed->getFeature().data());
+            if(point != NULL){
+                result += point->value;
+            }
+        }
+        for(int i = 0; i < 2000; i++){
+            result = std::sqrt(result * result + 1.0);
+        }
+        this->value = result;
+    }
+
+    double value;
+};
+
+/*!
+ * \brief The MeanPointFunction class
+ * Fits a point as the mean of its input observations and reports the result
+ */
+class MeanPointFunction : public FitFunction
+{
+public:
+    MeanPointFunction() : FitFunction(){}
+
+protected:
+    bool exec(Point &point){
+        double x = 0.0, y = 0.0, z = 0.0;
+        int count = 0;
+        foreach(const InputElement &element, this->inputElements.value(0)){
+            if(!element.getObservation().isNull()){
+                OiVec xyz = element.getObservation()->getXYZ();
+                x += xyz.getAt(0);
+                y += xyz.getAt(1);
+                z += xyz.getAt(2);
+                count++;
+            }
+        }
+        if(count == 0){
+            return false;
+        }
+        Position position(x / count, y / count, z / count);
+        point.setPoint(position);
+        emit this->sendMessage(QString("point %1 fitted").arg(point.getId()), eInformationMessage);
+        return true;
+    }
+};
+
+/*!
+ * \brief The SignalRecorder class
+ * Counts signals and checks on which thread they are delivered
+ */
+class SignalRecorder : public QObject
+{
+    Q_OBJECT
+
+public:
+    SignalRecorder() : QObject(), numParametersChanged(0), numSolvedChanged(0), numForeignThread(0){}
+
+    int numParametersChanged;
+    int numSolvedChanged;
+    int numForeignThread;
+    QStringList messages;
+
+public slots:
+    void parametersChanged(const int &featureId){
+        Q_UNUSED(featureId);
+        this->numParametersChanged++;
+        this->checkThread();
+    }
+    void solvedChanged(const int &featureId){
+        Q_UNUSED(featureId);
+        this->numSolvedChanged++;
+        this->checkThread();
+    }
+    void message(const QString &msg, const MessageTypes &msgType, const MessageDestinations &msgDest){
+        Q_UNUSED(msgType);
+        Q_UNUSED(msgDest);
+        this->messages.append(msg);
+        this->checkThread();
+    }
+
+private:
+    void checkThread(){
+        if(QThread::currentThread() != this->thread()){
+            this->numForeignThread++;
+        }
+    }
+};
+
+class RecalcSchedulerTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    RecalcSchedulerTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testDiamondRecalculatedOnce();
+    void testInvalidationsAreCoalesced();
+    void testCycleDoesNotBlock();
+    void testParallelMatchesSerial();
+    void testParallelSignalsOnOwningThread();
+    void benchmarkChain();
+    void benchmarkCycleCheck_data();
+    void benchmarkCycleCheck();
+
+private:
+    QPointer<FeatureWrapper> createPoint(const int &id);
+    QList<QPointer<FeatureWrapper> > createBoreCircles(const int &numCircles);
+    void connectFeatures(const QPointer<FeatureWrapper> &needed, const QPointer<FeatureWrapper> &usedFor);
+    void deleteFeatures(QList<QPointer<FeatureWrapper> > &features);
+    QList<QPointer<FeatureWrapper> > createLayeredGraph(const int &numLayers, const int &layerWidth);
+    bool recursiveCycleCheck(const QPointer<Feature> &activeFeature, const QPointer<Feature> &usedForActiveFeature);
+
+};
+
+RecalcSchedulerTest::RecalcSchedulerTest()
+{
+}
+
+void RecalcSchedulerTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QPointer<FeatureWrapper> RecalcSchedulerTest::createPoint(const int &id){
+    QPointer<Point> point = new Point(id, false, Position());
+    QPointer<FeatureWrapper> feature = new FeatureWrapper();
+    feature->setPoint(point);
+    return feature;
+}
+
+QList<QPointer<FeatureWrapper> > RecalcSchedulerTest::createBoreCircles(const int &numCircles){
+
+    //one station feature that is needed by numCircles independent features, which are combined in pairs
+    QList<QPointer<FeatureWrapper> > features;
+    int id = 1;
+    QPointer<FeatureWrapper> station = new FeatureWrapper();
+    station->setPoint(new ValuePoint(id++));
+    features.append(station);
+    for(int i = 0; i < numCircles; i++){
+        QPointer<FeatureWrapper> circle = new FeatureWrapper();
+        circle->setPoint(new ValuePoint(id++));
+        this->connectFeatures(station, circle);
+        features.append(circle);
+    }
+    for(int i = 1; i + 1 < features.size(); i += 2){
+        QPointer<FeatureWrapper> pair = new FeatureWrapper();
+        pair->setPoint(new ValuePoint(id++));
+        this->connectFeatures(features.at(i), pair);
+        this->connectFeatures(features.at(i+1), pair);
+        features.append(pair);
+    }
+    return features;
+
+}
+
+void RecalcSchedulerTest::connectFeatures(const QPointer<FeatureWrapper> &needed, const QPointer<FeatureWrapper> &usedFor){
+    needed->getFeature()->addUsedFor(usedFor);
+    usedFor->getFeature()->addPreviouslyNeeded(needed);
+}
+
+void RecalcSchedulerTest::deleteFeatures(QList<QPointer<FeatureWrapper> > &features){
+    foreach(const QPointer<FeatureWrapper> &feature, features){
+        if(!feature.isNull() && !feature->getFeature().isNull()){
+            delete feature->getFeature().data();
+        }
+        if(!feature.isNull()){
+            delete feature.data();
+        }
+    }
+    features.clear();
+}
+
+QList<QPointer<FeatureWrapper> > RecalcSchedulerTest::createLayeredGraph(const int &numLayers, const int &layerWidth){
+
+    //each feature needs all features of the previous layer
+    QList<QPointer<FeatureWrapper> > features;
+    int id = 1;
+    for(int layer = 0; layer < numLayers; layer++){
+        for(int i = 0; i < layerWidth; i++){
+            QPointer<FeatureWrapper> feature = this->createPoint(id++);
+            if(layer > 0){
+                for(int j = (layer - 1) * layerWidth; j < layer * layerWidth; j++){
+                    this->connectFeatures(features.at(j), feature);
+                }
+            }
+            features.append(feature);
+        }
+    }
+    return features;
+
+}
+
+bool RecalcSchedulerTest::recursiveCycleCheck(const QPointer<Feature> &activeFeature, const QPointer<Feature> &usedForActiveFeature){
+
+    //the previous implementation of OiJob::checkCircleWarning (no visited set)
+    foreach(const QPointer<FeatureWrapper> &feature, usedForActiveFeature->getPreviouslyNeeded()){
+        if(feature->getFeature()->getId() == activeFeature->getId()){
+            return true;
+        }else if(feature->getFeature()->getPreviouslyNeeded().size() > 0
+                 && this->recursiveCycleCheck(activeFeature, feature->getFeature())){
+            return true;
+        }
+    }
+    return false;
+
+}
+
+void RecalcSchedulerTest::testDiamondRecalculatedOnce(){
+
+    //a -> b, a -> c, b -> d, c -> d
+    QList<QPointer<FeatureWrapper> > features;
+    for(int i = 1; i <= 4; i++){
+        features.append(this->createPoint(i));
+    }
+    this->connectFeatures(features[0], features[1]);
+    this->connectFeatures(features[0], features[2]);
+    this->connectFeatures(features[1], features[3]);
+    this->connectFeatures(features[2], features[3]);
+
+    RecalcScheduler scheduler;
+    QSignalSpy featureSpy(&scheduler, SIGNAL(featureRecalculated(int)));
+    QSignalSpy featuresSpy(&scheduler, SIGNAL(featuresRecalculated()));
+
+    scheduler.invalidate(features[0]->getFeature());
+    scheduler.flush();
+
+    //each feature is recalculated exactly once and after the features it needs
+    QCOMPARE(featureSpy.count(), 4);
+    QCOMPARE(featuresSpy.count(), 1);
+    QCOMPARE(featureSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(featureSpy.at(3).at(0).toInt(), 4);
+
+    //invalidating a dependent only recalculates the dependent's subgraph
+    scheduler.invalidate(features[2]->getFeature());
+    scheduler.flush();
+    QCOMPARE(scheduler.getLastRecalcCount(), 2);
+
+    this->deleteFeatures(features);
+
+}
+
+void RecalcSchedulerTest::testInvalidationsAreCoalesced(){
+
+    //chain a -> b -> c
+    QList<QPointer<FeatureWrapper> > features;
+    for(int i = 1; i <= 3; i++){
+        features.append(this->createPoint(i));
+    }
+    this->connectFeatures(features[0], features[1]);
+    this->connectFeatures(features[1], features[2]);
+
+    RecalcScheduler scheduler;
+    QSignalSpy featureSpy(&scheduler, SIGNAL(featureRecalculated(int)));
+    QSignalSpy featuresSpy(&scheduler, SIGNAL(featuresRecalculated()));
+
+    //several invalidations within one event loop turn
+    scheduler.invalidate(features[1]->getFeature());
+    scheduler.invalidate(features[0]->getFeature());
+    scheduler.invalidate(features[0]->getFeature());
+    scheduler.invalidate(features[2]->getFeature());
+    QVERIFY(scheduler.getHasPendingRecalc());
+    QCOMPARE(featureSpy.count(), 0);
+
+    //the queued flush recalculates each feature once
+    QVERIFY(featuresSpy.wait(1000));
+    QVERIFY(!scheduler.getHasPendingRecalc());
+    QCOMPARE(featureSpy.count(), 3);
+    QCOMPARE(featuresSpy.count(), 1);
+    QCOMPARE(featureSpy.at(0).at(0).toInt(), 1);
+    QCOMPARE(featureSpy.at(1).at(0).toInt(), 2);
+    QCOMPARE(featureSpy.at(2).at(0).toInt(), 3);
+
+    this->deleteFeatures(features);
+
+}
+
+void RecalcSchedulerTest::testCycleDoesNotBlock(){
+
+    //a -> b -> a
+    QList<QPointer<FeatureWrapper> > features;
+    features.append(this->createPoint(1));
+    features.append(this->createPoint(2));
+    this->connectFeatures(features[0], features[1]);
+    this->connectFeatures(features[1], features[0]);
+
+    QList<QPointer<Feature> > sorted = RecalcScheduler::sortTopologically(
+                RecalcScheduler::getAffectedFeatures(QList<QPointer<Feature> >() << features[0]->getFeature()));
+    QCOMPARE(sorted.size(), 2);
+
+    //features of a cycle need each other and cannot be recalculated concurrently
+    QCOMPARE(RecalcScheduler::getIndependentGroups(sorted).size(), 1);
+
+    QVERIFY(RecalcScheduler::getIsPreviouslyNeeded(features[0]->getFeature(), features[1]->getFeature()));
+    QVERIFY(RecalcScheduler::getIsPreviouslyNeeded(features[0]->getFeature(), features[0]->getFeature()));
+
+    this->deleteFeatures(features);
+
+}
+
+void RecalcSchedulerTest::testParallelMatchesSerial(){
+
+    QList<QPointer<FeatureWrapper> > serialFeatures = this->createBoreCircles(400);
+    QList<QPointer<FeatureWrapper> > parallelFeatures = this->createBoreCircles(400);
+
+    //the circles only read the station, so they form one level and are split into one group each
+    QList<QList<QPointer<Feature> > > levels = RecalcScheduler::getDependencyLevels(
+                RecalcScheduler::getAffectedFeatures(QList<QPointer<Feature> >() << parallelFeatures.first()->getFeature()));
+    QCOMPARE(levels.size(), 3);
+    QCOMPARE(levels.at(1).size(), 400);
+    QCOMPARE(RecalcScheduler::getIndependentGroups(levels.at(1)).size(), 400);
+    QCOMPARE(levels.at(2).size(), 200);
+    QCOMPARE(RecalcScheduler::getIndependentGroups(levels.at(2)).size(), 200);
+
+    RecalcScheduler serialScheduler;
+    QSignalSpy serialSpy(&serialScheduler, SIGNAL(featureRecalculated(int)));
+    serialScheduler.invalidate(serialFeatures.first()->getFeature());
+    serialScheduler.flush();
+
+    RecalcScheduler parallelScheduler;
+    parallelScheduler.setParallelRecalc(true);
+    parallelScheduler.setMaxThreadCount(4);
+    QSignalSpy parallelSpy(&parallelScheduler, SIGNAL(featureRecalculated(int)));
+    parallelScheduler.invalidate(parallelFeatures.first()->getFeature());
+    parallelScheduler.flush();
+
+    //same results and same signal order
+    QCOMPARE(parallelSpy.count(), serialSpy.count());
+    QCOMPARE(parallelSpy.count(), serialFeatures.size());
+    for(int i = 0; i < serialSpy.count(); i++){
+        QCOMPARE(parallelSpy.at(i).at(0).toInt(), serialSpy.at(i).at(0).toInt());
+    }
+    for(int i = 0; i < serialFeatures.size(); i++){
+        ValuePoint *serial = dynamic_cast<ValuePoint *>(serialFeatures.at(i)->getFeature().data());
+        ValuePoint *parallel = dynamic_cast<ValuePoint *>(parallelFeatures.at(i)->getFeature().data());
+        QVERIFY(serial != NULL && parallel != NULL);
+        QCOMPARE(parallel->value, serial->value);
+    }
+
+    this->deleteFeatures(serialFeatures);
+    this->deleteFeatures(parallelFeatures);
+
+}
+
+void RecalcSchedulerTest::testParallelSignalsOnOwningThread(){
+
+    RecalcScheduler scheduler;
+    scheduler.setParallelRecalc(true);
+    scheduler.setMaxThreadCount(4);
+
+    SignalRecorder recorder;
+    QObject::connect(&scheduler, &RecalcScheduler::sendMessage, &recorder, &SignalRecorder::message, Qt::DirectConnection);
+
+    //independent points that are fitted from their own observations by a real function
+    QList<QPointer<FeatureWrapper> > features;
+    QList<Observation *> observations;
+    int id = 1;
+    for(int i = 0; i < 64; i++){
+
+        QPointer<FeatureWrapper> feature = this->createPoint(id++);
+        features.append(feature);
+
+        QPointer<Function> function = new MeanPointFunction();
+        function->init();
+        for(int j = 0; j < 3; j++){
+            OiVec xyz(4);
+            xyz.setAt(0, i);
+            xyz.setAt(1, j);
+            xyz.setAt(2, 1.0);
+            xyz.setAt(3, 1.0);
+            Observation *observation = new Observation(xyz, id++, true);
+            observations.append(observation);
+            InputElement element(observation->getId());
+            element.typeOfElement = eObservationElement;
+            element.setElement(QPointer<Observation>(observation));
+            function->addInputElement(element, 0);
+        }
+        feature->getFeature()->addFunction(function);
+
+        //functions are connected to the scheduler the same way OiJob does it
+        QObject::connect(function.data(), &Function::sendMessage, &scheduler, &RecalcScheduler::relayMessage, Qt::DirectConnection);
+        QObject::connect(feature->getGeometry().data(), &Geometry::geomParametersChanged, &recorder, &SignalRecorder::parametersChanged, Qt::DirectConnection);
+        QObject::connect(feature->getFeature().data(), &Feature::featureIsSolvedChanged, &recorder, &SignalRecorder::solvedChanged, Qt::DirectConnection);
+
+    }
+
+    QList<QPointer<Feature> > dirty;
+    foreach(const QPointer<FeatureWrapper> &feature, features){
+        dirty.append(feature->getFeature());
+    }
+    scheduler.invalidate(dirty);
+    scheduler.flush();
+
+    //all features were fitted, but every signal and message arrived on the owning thread
+    QCOMPARE(scheduler.getLastRecalcCount(), 64);
+    QCOMPARE(recorder.numForeignThread, 0);
+    QCOMPARE(recorder.numParametersChanged, 64);
+    QCOMPARE(recorder.numSolvedChanged, 64);
+    QCOMPARE(recorder.messages.size(), 64);
+    for(int i = 0; i < features.size(); i++){
+        QPointer<Point> point = features.at(i)->getPoint();
+        QVERIFY(point->getIsSolved());
+        QVERIFY(!point->signalsBlocked());
+        QCOMPARE(point->getPosition().getVector().getAt(0), (double)i);
+        QCOMPARE(point->getPosition().getVector().getAt(1), 1.0);
+        QVERIFY(recorder.messages.contains(QString("point %1 fitted").arg(point->getId())));
+    }
+
+    foreach(const QPointer<FeatureWrapper> &feature, features){
+        qDeleteAll(feature->getFeature()->getFunctions());
+    }
+    this->deleteFeatures(features);
+    qDeleteAll(observations);
+
+}
+
+void RecalcSchedulerTest::benchmarkChain(){
+
+    //3000 features where each one needs its predecessor
+    QList<QPointer<FeatureWrapper> > features;
+    for(int i = 1; i <= 3000; i++){
+        features.append(this->createPoint(i));
+        if(i > 1){
+            this->connectFeatures(features[i-2], features[i-1]);
+        }
+    }
+
+    RecalcScheduler scheduler;
+    QBENCHMARK{
+        for(int i = 0; i < 10; i++){
+            scheduler.invalidate(features[i]->getFeature());
+        }
+        scheduler.flush();
+    }
+    QCOMPARE(scheduler.getLastRecalcCount(), 3000);
+
+    this->deleteFeatures(features);
+
+}
+
+void RecalcSchedulerTest::benchmarkCycleCheck_data(){
+
+    QTest::addColumn<int>("numLayers");
+    QTest::addColumn<int>("layerWidth");
+    QTest::addColumn<bool>("recursive");
+
+    //the recursive check visits 2^layers paths on stacked diamonds
+    QTest::newRow("deep 5000x1 recursive") << 5000 << 1 << true;
+    QTest::newRow("deep 5000x1 visited set") << 5000 << 1 << false;
+    QTest::newRow("diamonds 18x2 recursive") << 18 << 2 << true;
+    QTest::newRow("diamonds 18x2 visited set") << 18 << 2 << false;
+    QTest::newRow("diamonds 1000x2 visited set") << 1000 << 2 << false;
+    QTest::newRow("wide 50x50 visited set") << 50 << 50 << false;
+
+}
+
+void RecalcSchedulerTest::benchmarkCycleCheck(){
+
+    QFETCH(int, numLayers);
+    QFETCH(int, layerWidth);
+    QFETCH(bool, recursive);
+
+    QList<QPointer<FeatureWrapper> > features = this->createLayeredGraph(numLayers, layerWidth);
+
+    //a new feature is checked against the whole ancestry of the last feature (worst case: no cycle)
+    QPointer<FeatureWrapper> newFeature = this->createPoint(features.size() + 1);
+    QPointer<Feature> last = features.last()->getFeature();
+    bool isCycle = true;
+    QBENCHMARK{
+        if(recursive){
+            isCycle = this->recursiveCycleCheck(newFeature->getFeature(), last);
+        }else{
+            isCycle = RecalcScheduler::getIsPreviouslyNeeded(last, newFeature->getFeature());
+        }
+    }
+    QVERIFY(!isCycle);
+
+    //the first feature is needed by the last one
+    QVERIFY(RecalcScheduler::getIsPreviouslyNeeded(last, features.first()->getFeature()));
+
+    features.append(newFeature);
+    this->deleteFeatures(features);
+
+}
+
+QTEST_GUILESS_MAIN(RecalcSchedulerTest)
+
+#include "tst_recalcscheduler.moc"
@@ -0,0 +1,465 @@
+#include <QString>
+#include <QtTest>
+#include <QThread>
+#include <QThreadPool>
+#include <random>
+
+#include "chooselalib.h"
+#include "fitfunction.h"
+#include "robustfit.h"
+
+#define COMPARE_DOUBLE(actual, expected, threshold) QVERIFY2(std::abs(actual-expected)< threshold, QString("actual: %1, expected: %2").arg(actual).arg(expected).toLatin1().data());
+
+using namespace oi;
+
+/*!
+ * \brief The RobustFitter class
+ * Makes the protected circle and cylinder fits accessible and holds an input element for each point
+ */
+class RobustFitter : public FitFunction, public BestFitCircleUtil, public BestFitCylinderUtil
+{
+public:
+    RobustFitter(const QList<IdPoint> &points){
+        this->init();
+        this->addPoints(points);
+    }
+    RobustFitter(const QList<IdPoint> &points, const QString &robustFit, const double &threshold, const QString &approximation = QString()){
+
+        this->init();
+        this->addPoints(points);
+
+        ScalarInputParams params;
+        params.isValid = true;
+        params.stringParameter.insert("robust fit", robustFit);
+        params.doubleParameter.insert("robust threshold", threshold);
+        if(!approximation.isEmpty()){
+            params.stringParameter.insert("approximation", approximation);
+        }
+        this->setScalarInputParams(params);
+
+    }
+
+    void init(){
+        this->addRobustFitParameters();
+    }
+
+    bool fit(Circle &circle, const QList<IdPoint> &points){
+        return this->bestFitCircleInPlane(this, circle, points, points);
+    }
+    bool fit(Cylinder &cylinder, const QList<IdPoint> &points){
+        return this->bestFitCylinder(this, cylinder, points, points);
+    }
+
+private:
+    void addPoints(const QList<IdPoint> &points){
+        QList<InputElement> elements;
+        foreach(const IdPoint &point, points){
+            InputElement element(point.id);
+            element.typeOfElement = eObservationElement;
+            elements.append(element);
+        }
+        this->addInputElements(elements, InputElementKey::eDefault);
+    }
+};
+
+/*!
+ * \brief The SlowCircleModel class
+ * Circle model that evaluates slowly and counts the calls that are running or done
+ */
+class SlowCircleModel : public RobustFitCircleModel{
+public:
+    bool estimate(const Vec3 *sample, RobustFitParameters &parameters) const{
+        this->running.ref();
+        QThread::msleep(2);
+        bool result = RobustFitCircleModel::estimate(sample, parameters);
+        this->calls.ref();
+        this->running.deref();
+        return result;
+    }
+
+    mutable QAtomicInt running;
+    mutable QAtomicInt calls;
+};
+
+class RobustFitTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    RobustFitTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testRequiredIterations();
+    void testParallelEvaluation();
+    void testModelLifetime();
+    void testRobustFitParameters();
+    void testRobustCircleFit_data();
+    void testRobustCircleFit();
+    void testRobustCylinderFit();
+    void testRobustCylinderFitTiltedAxis();
+    void benchmarkRobustCircleFit_data();
+    void benchmarkRobustCircleFit();
+
+private:
+    QList<IdPoint> createCirclePoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers);
+    QList<IdPoint> createCylinderPoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers);
+    QList<IdPoint> createTiltingCylinderPoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers);
+
+};
+
+RobustFitTest::RobustFitTest()
+{
+}
+
+void RobustFitTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+/*!
+ * \brief RobustFitTest::createCirclePoints
+ * Creates noisy points on a tilted circle with radius 5 around (1, 2, 3).
+ * Outliers are shifted by 1 cm up to 50 cm in radial direction and along the normal.
+ * \param numPoints
+ * \param outlierRate
+ * \param outliers
+ * \return
+ */
+QList<IdPoint> RobustFitTest::createCirclePoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * PI);
+    std::uniform_real_distribution<double> offset(0.01, 0.5);
+    std::bernoulli_distribution isOutlier(outlierRate);
+    std::normal_distribution<double> noise(0.0, 0.0001);
+
+    Mat3 r = Mat3::rotationY(0.3) * Mat3::rotationX(0.2);
+    QList<IdPoint> points;
+    points.reserve(numPoints);
+    outliers.clear();
+    for(int i = 0; i < numPoints; i++){
+        double a = angle(generator);
+        double radius = 5.0 + noise(generator);
+        double height = noise(generator);
+        if(isOutlier(generator)){
+            radius += (i % 2 == 0 ? 1.0 : -1.0) * offset(generator);
+            height += offset(generator);
+            outliers.insert(i + 1);
+        }
+
+        IdPoint point;
+        point.id = i + 1;
+        point.xyz = (r * Vec3(radius * qCos(a), radius * qSin(a), height) + Vec3(1.0, 2.0, 3.0)).toOiVecH();
+        points.append(point);
+    }
+    return points;
+
+}
+
+/*!
+ * \brief RobustFitTest::createCylinderPoints
+ * Creates noisy points on a cylinder with radius 5 and an axis parallel to z through (1, 2).
+ * The first two points are inliers on the same generatrix so that they define the approximate axis.
+ * \param numPoints
+ * \param outlierRate
+ * \param outliers
+ * \return
+ */
+QList<IdPoint> RobustFitTest::createCylinderPoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * PI);
+    std::uniform_real_distribution<double> height(-10.0, 10.0);
+    std::uniform_real_distribution<double> offset(0.01, 0.5);
+    std::bernoulli_distribution isOutlier(outlierRate);
+    std::normal_distribution<double> noise(0.0, 0.0001);
+
+    QList<IdPoint> points;
+    points.reserve(numPoints);
+    outliers.clear();
+    for(int i = 0; i < numPoints; i++){
+        double a = i < 2 ? 0.3 : angle(generator);
+        double r = 5.0 + noise(generator);
+        if(i >= 2 && isOutlier(generator)){
+            r += (i % 2 == 0 ? 1.0 : -1.0) * offset(generator);
+            outliers.insert(i + 1);
+        }
+
+        IdPoint point;
+        point.id = i + 1;
+        point.xyz = Vec3(1.0 + r * qCos(a), 2.0 + r * qSin(a), i == 0 ? -10.0 : (i == 1 ? 10.0 : height(generator))).toOiVecH();
+        points.append(point);
+    }
+    return points;
+
+}
+
+/*!
+ * \brief RobustFitTest::createTiltingCylinderPoints
+ * Creates noisy points on a cylinder with radius 5 and an axis parallel to z through (1, 2).
+ * All outliers lie at the upper end of the cylinder and are shifted by 0.5 m up to 2 m in x direction,
+ * so that they tilt an axis that is approximated using all points.
+ * \param numPoints
+ * \param outlierRate
+ * \param outliers
+ * \return
+ */
+QList<IdPoint> RobustFitTest::createTiltingCylinderPoints(const int &numPoints, const double &outlierRate, QSet<int> &outliers){
+
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> angle(0.0, 2.0 * PI);
+    std::uniform_real_distribution<double> height(-10.0, 10.0);
+    std::uniform_real_distribution<double> upperHeight(5.0, 10.0);
+    std::uniform_real_distribution<double> offset(0.5, 2.0);
+    std::bernoulli_distribution isOutlier(outlierRate);
+    std::normal_distribution<double> noise(0.0, 0.0001);
+
+    QList<IdPoint> points;
+    points.reserve(numPoints);
+    outliers.clear();
+    for(int i = 0; i < numPoints; i++){
+        double a = angle(generator);
+        double r = 5.0 + noise(generator);
+        Vec3 xyz(1.0 + r * qCos(a), 2.0 + r * qSin(a), height(generator));
+        if(isOutlier(generator)){
+            xyz = Vec3(xyz.x() + offset(generator), xyz.y(), upperHeight(generator));
+            outliers.insert(i + 1);
+        }
+
+        IdPoint point;
+        point.id = i + 1;
+        point.xyz = xyz.toOiVecH();
+        points.append(point);
+    }
+    return points;
+
+}
+
+void RobustFitTest::testRequiredIterations(){
+
+    QCOMPARE(RobustEstimator::getRequiredIterations(0.7, 3, 0.99, 1000), 11);
+    QCOMPARE(RobustEstimator::getRequiredIterations(0.5, 3, 0.99, 1000), 35);
+    QCOMPARE(RobustEstimator::getRequiredIterations(1.0, 3, 0.99, 1000), 1);
+    QCOMPARE(RobustEstimator::getRequiredIterations(0.0, 3, 0.99, 1000), 1000);
+    QCOMPARE(RobustEstimator::getRequiredIterations(0.01, 3, 0.99, 1000), 1000);
+
+}
+
+void RobustFitTest::testParallelEvaluation(){
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCirclePoints(5000, 0.3, outliers);
+    QVector<Vec3> xyz;
+    foreach(const IdPoint &point, points){
+        xyz.append(Vec3(point.xyz));
+    }
+
+    //the result only depends on the seed, not on the number of threads
+    RobustFitOptions options;
+    options.type = eMsacFit;
+    options.seed = 4711;
+    options.numThreads = 1;
+    RobustFitResult single = RobustEstimator::estimate(RobustFitCircleModel(), xyz, options);
+    options.numThreads = 8;
+    RobustFitResult parallel = RobustEstimator::estimate(RobustFitCircleModel(), xyz, options);
+
+    QVERIFY(single.isValid);
+    QVERIFY(parallel.isValid);
+    QCOMPARE(parallel.numHypotheses, single.numHypotheses);
+    QCOMPARE(parallel.numInliers, single.numInliers);
+    QCOMPARE(parallel.cost, single.cost);
+    QCOMPARE(parallel.inliers, single.inliers);
+    QCOMPARE(single.numInliers, points.size() - outliers.size());
+
+    //early termination
+    QVERIFY(single.numHypotheses < options.maxIterations);
+
+    //too few points
+    QVERIFY(!RobustEstimator::estimate(RobustFitCircleModel(), xyz.mid(0, 2), options).isValid);
+
+}
+
+void RobustFitTest::testModelLifetime(){
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCirclePoints(100, 0.0, outliers);
+    QVector<Vec3> xyz;
+    foreach(const IdPoint &point, points){
+        xyz.append(Vec3(point.xyz));
+    }
+
+    //the first hypothesis is outlier free and terminates the estimation while other threads still evaluate
+    RobustFitOptions options;
+    options.type = eRansacFit;
+    options.numThreads = 8;
+    for(int i = 0; i < 10; i++){
+
+        SlowCircleModel model;
+        options.seed = i;
+        RobustFitResult result = RobustEstimator::estimate(model, xyz, options);
+        QVERIFY(result.isValid);
+
+        //no thread uses the model after the estimation returned
+        QCOMPARE(model.running.load(), 0);
+        int calls = model.calls.load();
+        QThreadPool::globalInstance()->waitForDone();
+        QCOMPARE(model.calls.load(), calls);
+        QCOMPARE(model.running.load(), 0);
+
+    }
+
+}
+
+void RobustFitTest::testRobustFitParameters(){
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCirclePoints(1000, 0.1, outliers);
+
+    //the parameters are offered and the robust fit is disabled by default
+    RobustFitter fitter(points);
+    QList<QString> types = fitter.getStringParameter().values("robust fit");
+    QCOMPARE(types.size(), 3);
+    QVERIFY(types.contains("none"));
+    QVERIFY(types.contains("RANSAC"));
+    QVERIFY(types.contains("MSAC"));
+    QVERIFY(fitter.getDoubleParameter().contains("robust threshold"));
+    QVERIFY(fitter.getDoubleParameter().contains("robust confidence"));
+    QVERIFY(fitter.getIntegerParameter().contains("robust iterations"));
+    QVERIFY(fitter.getIntegerParameter().contains("robust threads"));
+    QVERIFY(fitter.getIntegerParameter().contains("robust seed"));
+
+    RobustFitOptions defaults;
+    RobustFitOptions options = RobustFitOptions::fromScalarInputParams(fitter.getScalarInputParams());
+    QCOMPARE(options.type, eNoRobustFit);
+    QCOMPARE(options.threshold, defaults.threshold);
+    QCOMPARE(options.confidence, defaults.confidence);
+    QCOMPARE(options.maxIterations, defaults.maxIterations);
+    QCOMPARE(options.numThreads, defaults.numThreads);
+    QCOMPARE(options.seed, defaults.seed);
+
+    //the default least squares fit uses all points
+    Circle circle(false);
+    QVERIFY(fitter.fit(circle, points));
+    foreach(const IdPoint &point, points){
+        QVERIFY(fitter.getIsUsed(InputElementKey::eDefault, point.id));
+    }
+
+}
+
+void RobustFitTest::testRobustCircleFit_data(){
+
+    QTest::addColumn<double>("outlierRate");
+    QTest::addColumn<QString>("robustFit");
+
+    QTest::newRow("1% RANSAC") << 0.01 << QString("RANSAC");
+    QTest::newRow("10% RANSAC") << 0.1 << QString("RANSAC");
+    QTest::newRow("30% RANSAC") << 0.3 << QString("RANSAC");
+    QTest::newRow("1% MSAC") << 0.01 << QString("MSAC");
+    QTest::newRow("10% MSAC") << 0.1 << QString("MSAC");
+    QTest::newRow("30% MSAC") << 0.3 << QString("MSAC");
+
+}
+
+void RobustFitTest::testRobustCircleFit(){
+
+    QFETCH(double, outlierRate);
+    QFETCH(QString, robustFit);
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCirclePoints(1000, outlierRate, outliers);
+    QVERIFY(outliers.size() > 0);
+
+    //the least squares fit is spoiled by the outliers
+    RobustFitter leastSquares(points, "none", 0.001);
+    Circle leastSquaresCircle(false);
+    QVERIFY(leastSquares.fit(leastSquaresCircle, points));
+    QVERIFY(qAbs(leastSquaresCircle.getRadius().getRadius() - 5.0) > 0.0001 || leastSquaresCircle.getStatistic().getStdev() > 0.001);
+
+    //the robust fit rejects exactly the outliers
+    RobustFitter robust(points, robustFit, 0.001);
+    Circle circle(false);
+    QVERIFY(robust.fit(circle, points));
+    COMPARE_DOUBLE(circle.getRadius().getRadius(), 5.0, 0.0001);
+    COMPARE_DOUBLE((circle.getPosition().getVec3() - Vec3(1.0, 2.0, 3.0)).length(), 0.0, 0.0001);
+    QVERIFY(circle.getStatistic().getStdev() < 0.0005);
+    foreach(const IdPoint &point, points){
+        QCOMPARE(robust.getIsUsed(InputElementKey::eDefault, point.id), !outliers.contains(point.id));
+        QVERIFY(robust.getShouldBeUsed(InputElementKey::eDefault, point.id));
+    }
+
+}
+
+void RobustFitTest::testRobustCylinderFit(){
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCylinderPoints(500, 0.1, outliers);
+
+    RobustFitter robust(points, "MSAC", 0.001);
+    Cylinder cylinder(false);
+    QVERIFY(robust.fit(cylinder, points));
+    COMPARE_DOUBLE(cylinder.getRadius().getRadius(), 5.0, 0.0001);
+    COMPARE_DOUBLE(qAbs(cylinder.getDirection().getVec3().z()), 1.0, 1.0e-6);
+    foreach(const IdPoint &point, points){
+        QCOMPARE(robust.getIsUsed(InputElementKey::eDefault, point.id), !outliers.contains(point.id));
+    }
+
+}
+
+void RobustFitTest::testRobustCylinderFitTiltedAxis(){
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createTiltingCylinderPoints(500, 0.15, outliers);
+    QVERIFY(outliers.size() > 0);
+
+    //the axis of the least squares fit is tilted by the outliers
+    RobustFitter leastSquares(points, "none", 0.001, "guess axis");
+    Cylinder leastSquaresCylinder(false);
+    QVERIFY(leastSquares.fit(leastSquaresCylinder, points));
+    QVERIFY(qAbs(leastSquaresCylinder.getDirection().getVec3().z()) < qCos(0.5 * PI / 180.0));
+
+    //the robust fit rejects exactly the outliers although the approximate axis is tilted
+    RobustFitter robust(points, "MSAC", 0.001, "guess axis");
+    Cylinder cylinder(false);
+    QVERIFY(robust.fit(cylinder, points));
+    COMPARE_DOUBLE(cylinder.getRadius().getRadius(), 5.0, 0.0001);
+    COMPARE_DOUBLE(qAbs(cylinder.getDirection().getVec3().z()), 1.0, 1.0e-6);
+    foreach(const IdPoint &point, points){
+        QCOMPARE(robust.getIsUsed(InputElementKey::eDefault, point.id), !outliers.contains(point.id));
+    }
+
+}
+
+void RobustFitTest::benchmarkRobustCircleFit_data(){
+
+    QTest::addColumn<double>("outlierRate");
+    QTest::addColumn<QString>("robustFit");
+
+    QTest::newRow("1% outliers, least squares") << 0.01 << QString("none");
+    QTest::newRow("1% outliers, MSAC") << 0.01 << QString("MSAC");
+    QTest::newRow("10% outliers, MSAC") << 0.1 << QString("MSAC");
+    QTest::newRow("30% outliers, RANSAC") << 0.3 << QString("RANSAC");
+    QTest::newRow("30% outliers, MSAC") << 0.3 << QString("MSAC");
+
+}
+
+void RobustFitTest::benchmarkRobustCircleFit(){
+
+    QFETCH(double, outlierRate);
+    QFETCH(QString, robustFit);
+
+    QSet<int> outliers;
+    QList<IdPoint> points = this->createCirclePoints(10000, outlierRate, outliers);
+    RobustFitter fitter(points, robustFit, 0.001);
+    Circle circle(false);
+
+    bool solved = false;
+    QBENCHMARK{
+        solved = fitter.fit(circle, points);
+    }
+    QVERIFY(solved);
+
+}
+
+QTEST_APPLESS_MAIN(RobustFitTest)
+
+#include "tst_robustfit.moc"
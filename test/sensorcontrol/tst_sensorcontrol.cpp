@@ -0,0 +1,282 @@
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+#include "sensorcontrol.h"
+#include "sensorstate.h"
+
+using namespace oi;
+
+/*!
+ * \brief The SlowSensor class
+ * Sensor whose status and stream requests block the sensor thread like a slow serial connection
+ * (the self defined action keeps the sensor busy for 200 ms)
+ */
+class SlowSensor : public Sensor
+{
+public:
+    SlowSensor() : isConnected(false){
+        this->supportedReadingTypes.append(eCartesianReading);
+        this->supportedConnectionTypes.append(eSerialConnection);
+        this->selfDefinedActions.append("slow action");
+    }
+
+    bool connectSensor(){
+        QThread::msleep(20);
+        this->isConnected = true;
+        return true;
+    }
+    bool disconnectSensor(){
+        this->isConnected = false;
+        return true;
+    }
+
+    bool getConnectionState(){
+        return this->isConnected;
+    }
+    bool getIsReadyForMeasurement(){
+        return true;
+    }
+    bool getIsBusy(){
+        return false;
+    }
+    QMap<QString, QString> getSensorStatus(){
+        QThread::msleep(20);
+        QMap<QString, QString> status;
+        status.insert("temperature", "20.0");
+        return status;
+    }
+
+    bool doSelfDefinedAction(const QString &action){
+        Q_UNUSED(action);
+        QThread::msleep(200);
+        return true;
+    }
+
+    QVariantMap readingStream(const ReadingTypes &streamFormat){
+        Q_UNUSED(streamFormat);
+        QThread::msleep(20);
+        QVariantMap reading;
+        reading.insert("x", 1.0);
+        reading.insert("y", 2.0);
+        reading.insert("z", 3.0);
+        return reading;
+    }
+
+private:
+    volatile bool isConnected;
+};
+
+/*!
+ * \brief The StateWriter class
+ * Publishes states whose attributes all depend on the state number
+ */
+class StateWriter : public QThread
+{
+public:
+    StateWriter(StatePublisher<SensorState> &publisher, const int &numStates) : publisher(publisher), numStates(numStates){}
+
+    void run(){
+        for(int i = 1; i <= this->numStates; i++){
+            SensorState state;
+            state.isBusy = (i % 2 == 1);
+            state.status.insert("state", QString::number(i));
+            for(int j = 0; j < i % 5; j++){
+                state.supportedReadingTypes.append(eCartesianReading);
+            }
+            this->publisher.publish(state);
+        }
+    }
+
+    StatePublisher<SensorState> &publisher;
+    int numStates;
+};
+
+/*!
+ * \brief The StateReader class
+ * Reads states until the last one was published and checks that each state is consistent
+ */
+class StateReader : public QThread
+{
+public:
+    StateReader(const StatePublisher<SensorState> &publisher, const int &numStates)
+        : publisher(publisher), numStates(numStates), numReads(0), isValid(true){}
+
+    void run(){
+        int last = 0;
+        while(last < this->numStates){
+            SensorState state = this->publisher.get();
+            int i = state.status.value("state", "0").toInt();
+            if(i == 0){
+                continue;
+            }
+            this->isValid = this->isValid && i >= last && state.isBusy == (i % 2 == 1)
+                    && state.supportedReadingTypes.size() == i % 5;
+            last = i;
+            this->numReads++;
+        }
+    }
+
+    const StatePublisher<SensorState> &publisher;
+    int numStates;
+    int numReads;
+    bool isValid;
+};
+
+class SensorControlTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SensorControlTest();
+
+private Q_SLOTS:
+    void testStatePublisher();
+    void testGettersDuringStreaming();
+    void testBusyDuringCommand();
+
+};
+
+SensorControlTest::SensorControlTest()
+{
+}
+
+void SensorControlTest::testStatePublisher(){
+
+    StatePublisher<SensorState> publisher;
+    QVERIFY(!publisher.get().isSensorSet);
+
+    //readers never see a partially written state
+    StateWriter writer(publisher, 100000);
+    QList<StateReader *> readers;
+    for(int i = 0; i < 4; i++){
+        readers.append(new StateReader(publisher, 100000));
+    }
+
+    writer.start();
+    foreach(StateReader *reader, readers){
+        reader->start();
+    }
+    writer.wait();
+    foreach(StateReader *reader, readers){
+        reader->wait();
+        QVERIFY(reader->isValid);
+        QVERIFY(reader->numReads > 0);
+    }
+    qDeleteAll(readers);
+
+    QCOMPARE(publisher.get().status.value("state"), QString("100000"));
+
+}
+
+void SensorControlTest::testGettersDuringStreaming(){
+
+    QPointer<Station> station;
+    SensorControl control(station);
+    QThread thread;
+    control.setSensorWorkerThread(&thread);
+    thread.start();
+
+    QPointer<Sensor> sensor(new SlowSensor());
+    sensor->moveToThread(&thread);
+    control.setSensor(sensor);
+    QVERIFY(control.getIsSensorSet());
+    QCOMPARE(control.getSupportedReadingTypes(), QList<ReadingTypes>() << eCartesianReading);
+    QCOMPARE(control.getSelfDefinedActions(), QStringList() << "slow action");
+
+    //connect and stream while the sensor thread is blocked by the sensor most of the time
+    control.connectSensor();
+    QTRY_VERIFY(control.getIsSensorConnected());
+    control.startStatusMonitoringStream();
+    control.startReadingStream();
+    QTRY_COMPARE(control.getSensorStatus().value("temperature"), QString("20.0"));
+
+    //hammer the getters: they must never wait for the sensor (a command is started in between)
+    int numCalls = 0;
+    int numBusyCalls = 0;
+    bool isCommandStarted = false;
+    qint64 maxDuration = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while(timer.elapsed() < 500){
+        if(!isCommandStarted && timer.elapsed() > 100){
+            control.selfDefinedAction("slow action");
+            isCommandStarted = true;
+        }
+
+        QElapsedTimer call;
+        call.start();
+        bool isConnected = control.getIsSensorConnected();
+        control.getIsReadyForMeasurement();
+        bool isBusy = control.getIsBusy();
+        QMap<QString, QString> status = control.getSensorStatus();
+        QList<ReadingTypes> types = control.getSupportedReadingTypes();
+        maxDuration = qMax(maxDuration, call.nsecsElapsed());
+
+        QVERIFY(isConnected);
+        QCOMPARE(status.size(), 1);
+        QCOMPARE(types.size(), 1);
+        numCalls++;
+        if(isBusy){
+            numBusyCalls++;
+        }
+    }
+    qDebug() << numCalls << "getter calls," << numBusyCalls << "while busy, max duration" << maxDuration / 1000 << "us";
+    QVERIFY(maxDuration < 10000000); //far less than one blocking sensor request (20 ms)
+
+    //the sensor is busy while the command runs and idle otherwise
+    QVERIFY(numBusyCalls > 0);
+    QVERIFY(numBusyCalls < numCalls);
+    QTRY_VERIFY(!control.getIsBusy());
+    QVERIFY(control.getIsReadyForMeasurement());
+
+    control.stopReadingStream();
+    control.stopStatusMonitoringStream();
+    control.resetSensor();
+    QTRY_VERIFY(!control.getIsSensorConnected());
+    thread.quit();
+    thread.wait();
+
+}
+
+void SensorControlTest::testBusyDuringCommand(){
+
+    QPointer<Station> station;
+    SensorControl control(station);
+    QThread thread;
+    control.setSensorWorkerThread(&thread);
+    thread.start();
+
+    QPointer<Sensor> sensor(new SlowSensor());
+    sensor->moveToThread(&thread);
+    control.setSensor(sensor);
+    QSignalSpy finished(&control, SIGNAL(commandFinished(bool,QString)));
+    control.connectSensor();
+    QTRY_COMPARE(finished.count(), 1);
+    QVERIFY(control.getIsSensorConnected());
+    QVERIFY(control.getIsReadyForMeasurement());
+    QVERIFY(!control.getIsBusy());
+    finished.clear();
+
+    //the busy state is published before the command is dispatched to the sensor
+    control.selfDefinedAction("slow action");
+    QTRY_VERIFY_WITH_TIMEOUT(control.getIsBusy(), 150);
+    QVERIFY(!control.getIsReadyForMeasurement());
+    QCOMPARE(finished.count(), 0);
+
+    //the state of the sensor is published when the command is finished
+    QTRY_COMPARE(finished.count(), 1);
+    QVERIFY(finished.first().at(0).toBool());
+    QVERIFY(!control.getIsBusy());
+    QVERIFY(control.getIsReadyForMeasurement());
+
+    control.resetSensor();
+    QTRY_VERIFY(!control.getIsSensorConnected());
+    thread.quit();
+    thread.wait();
+
+}
+
+QTEST_GUILESS_MAIN(SensorControlTest)
+
+#include "tst_sensorcontrol.moc"
@@ -0,0 +1,377 @@
+#include <QString>
+#include <QtTest>
+
+#include "sensorstream.h"
+
+using namespace oi;
+
+class SensorStreamTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SensorStreamTest();
+
+private Q_SLOTS:
+    void testNotifyOnlyWhenEmpty();
+    void testDropOldest();
+    void testDropNewest();
+    void testCoalesce();
+    void testLatency();
+    void testChannelNotifyOnlyWhenEmpty();
+    void testChannelOverflow();
+    void testChannelSettings();
+    void testChannelConcurrency();
+    void testVariantMapConversion();
+    void benchmarkReadingStream_data();
+    void benchmarkReadingStream();
+
+};
+
+/*!
+ * \brief The ChannelProducer class
+ * Pushes numbered cartesian samples (x = y = z = sample number) from a separate thread
+ */
+class ChannelProducer : public QThread
+{
+public:
+    ChannelProducer(RealTimeReadingChannel &channel, const int &numSamples) : channel(channel), numSamples(numSamples), numNotifications(0){}
+
+    void run(){
+        RealTimeReading sample;
+        sample.type = eCartesianReading;
+        for(int i = 0; i < this->numSamples; i++){
+            sample.cartesian.x = i;
+            sample.cartesian.y = i;
+            sample.cartesian.z = i;
+            if(this->channel.push(sample)){
+                this->numNotifications++;
+            }
+        }
+    }
+
+    RealTimeReadingChannel &channel;
+    int numSamples;
+    int numNotifications;
+};
+
+SensorStreamTest::SensorStreamTest()
+{
+}
+
+void SensorStreamTest::testNotifyOnlyWhenEmpty(){
+
+    StreamBuffer<int> buffer(StreamSettings(0.0, 8, eDropOldestSample));
+
+    //only the first sample requires a notification of the consumer
+    QVERIFY(buffer.push(1));
+    QVERIFY(!buffer.push(2));
+    QVERIFY(!buffer.push(3));
+    QCOMPARE(buffer.getSize(), 3);
+
+    QList<StreamSample<int> > samples = buffer.takeAll();
+    QCOMPARE(samples.size(), 3);
+    QCOMPARE(samples.at(0).data, 1);
+    QCOMPARE(samples.at(2).data, 3);
+    QCOMPARE(buffer.getSize(), 0);
+
+    //the buffer is empty again
+    QVERIFY(buffer.push(4));
+
+}
+
+void SensorStreamTest::testDropOldest(){
+
+    StreamBuffer<int> buffer(StreamSettings(0.0, 3, eDropOldestSample));
+    for(int i = 0; i < 10; i++){
+        buffer.push(i);
+    }
+
+    QList<StreamSample<int> > samples = buffer.takeAll();
+    QCOMPARE(samples.size(), 3);
+    QCOMPARE(samples.at(0).data, 7);
+    QCOMPARE(samples.at(1).data, 8);
+    QCOMPARE(samples.at(2).data, 9);
+
+    StreamStatistics statistics = buffer.getStatistics();
+    QCOMPARE(statistics.produced, qint64(10));
+    QCOMPARE(statistics.delivered, qint64(3));
+    QCOMPARE(statistics.dropped, qint64(7));
+    QCOMPARE(statistics.coalesced, qint64(0));
+
+}
+
+void SensorStreamTest::testDropNewest(){
+
+    StreamBuffer<int> buffer(StreamSettings(0.0, 3, eDropNewestSample));
+    for(int i = 0; i < 10; i++){
+        buffer.push(i);
+    }
+
+    QList<StreamSample<int> > samples = buffer.takeAll();
+    QCOMPARE(samples.size(), 3);
+    QCOMPARE(samples.at(0).data, 0);
+    QCOMPARE(samples.at(2).data, 2);
+    QCOMPARE(buffer.getStatistics().dropped, qint64(7));
+
+}
+
+void SensorStreamTest::testCoalesce(){
+
+    //a status stream only needs the latest sample
+    StreamBuffer<int> buffer(StreamSettings(0.0, 1, eCoalesceSamples));
+    for(int i = 0; i < 10; i++){
+        buffer.push(i);
+    }
+
+    QList<StreamSample<int> > samples = buffer.takeAll();
+    QCOMPARE(samples.size(), 1);
+    QCOMPARE(samples.at(0).data, 9);
+    QCOMPARE(buffer.getStatistics().coalesced, qint64(9));
+    QCOMPARE(buffer.getStatistics().dropped, qint64(0));
+
+}
+
+void SensorStreamTest::testLatency(){
+
+    StreamBuffer<int> buffer;
+    buffer.push(1, StreamBuffer<int>::getTimestamp() - 20);
+    buffer.push(2, StreamBuffer<int>::getTimestamp() - 10);
+    buffer.takeAll();
+
+    StreamStatistics statistics = buffer.getStatistics();
+    QVERIFY(statistics.maxLatency >= 20.0);
+    QVERIFY(statistics.meanLatency >= 15.0);
+    QVERIFY(statistics.meanLatency <= statistics.maxLatency);
+
+}
+
+void SensorStreamTest::testChannelNotifyOnlyWhenEmpty(){
+
+    RealTimeReadingChannel channel(StreamSettings(0.0, 8, eDropOldestSample));
+    RealTimeReading sample;
+    sample.type = eDistanceReading;
+
+    //only the first sample requires a notification of the consumer
+    sample.distance.distance = 1.0;
+    QVERIFY(channel.push(sample));
+    sample.distance.distance = 2.0;
+    QVERIFY(!channel.push(sample));
+    sample.distance.distance = 3.0;
+    QVERIFY(!channel.push(sample));
+    QCOMPARE(channel.getSize(), 3);
+
+    QVector<RealTimeReading> samples;
+    QCOMPARE(channel.takeAll(samples), 3);
+    QCOMPARE(samples.at(0).type, eDistanceReading);
+    QCOMPARE(samples.at(0).distance.distance, 1.0);
+    QCOMPARE(samples.at(2).distance.distance, 3.0);
+    QCOMPARE(channel.getSize(), 0);
+
+    //the consumer has taken all samples
+    QVERIFY(channel.push(sample));
+    QVERIFY(!channel.push(sample));
+
+}
+
+void SensorStreamTest::testChannelOverflow(){
+
+    RealTimeReading sample;
+    sample.type = eTemperatureReading;
+
+    //drop oldest (3 is no power of two, 4 is)
+    for(int bufferSize = 3; bufferSize <= 4; bufferSize++){
+        RealTimeReadingChannel channel(StreamSettings(0.0, bufferSize, eDropOldestSample));
+        for(int i = 0; i < 10; i++){
+            sample.temperature.temperature = i;
+            channel.push(sample);
+        }
+
+        QVector<RealTimeReading> samples;
+        QCOMPARE(channel.takeAll(samples), bufferSize);
+        QCOMPARE(samples.first().temperature.temperature, double(10 - bufferSize));
+        QCOMPARE(samples.last().temperature.temperature, 9.0);
+
+        StreamStatistics statistics = channel.getStatistics();
+        QCOMPARE(statistics.produced, qint64(10));
+        QCOMPARE(statistics.delivered, qint64(bufferSize));
+        QCOMPARE(statistics.dropped, qint64(10 - bufferSize));
+    }
+
+    //drop newest
+    RealTimeReadingChannel channel(StreamSettings(0.0, 3, eDropNewestSample));
+    for(int i = 0; i < 10; i++){
+        sample.temperature.temperature = i;
+        channel.push(sample);
+    }
+
+    QVector<RealTimeReading> samples;
+    QCOMPARE(channel.takeAll(samples), 3);
+    QCOMPARE(samples.at(0).temperature.temperature, 0.0);
+    QCOMPARE(samples.at(2).temperature.temperature, 2.0);
+    QCOMPARE(channel.getStatistics().dropped, qint64(7));
+
+}
+
+void SensorStreamTest::testChannelSettings(){
+
+    RealTimeReadingChannel channel(StreamSettings(100.0, 5, eDropNewestSample));
+    QCOMPARE(channel.getSettings().targetRate, 100.0);
+    QCOMPARE(channel.getSettings().bufferSize, 5);
+    QCOMPARE(channel.getSettings().overflowPolicy, eDropNewestSample);
+
+    //changing the settings discards buffered samples
+    RealTimeReading sample;
+    channel.push(sample);
+    channel.setSettings(StreamSettings(0.0, 0, eDropOldestSample));
+    QCOMPARE(channel.getSize(), 0);
+    QCOMPARE(channel.getSettings().bufferSize, 1);
+    QVERIFY(channel.push(sample));
+
+    //latency
+    QVector<RealTimeReading> samples;
+    channel.takeAll(samples);
+    channel.resetStatistics();
+    channel.push(sample, StreamBuffer<int>::getTimestamp() - 20);
+    channel.takeAll(samples);
+    QCOMPARE(channel.getStatistics().produced, qint64(1));
+    QCOMPARE(channel.getStatistics().delivered, qint64(1));
+    QVERIFY(channel.getStatistics().maxLatency >= 20.0);
+
+}
+
+void SensorStreamTest::testChannelConcurrency(){
+
+    //a small buffer so that the producer overtakes the consumer
+    RealTimeReadingChannel channel(StreamSettings(0.0, 16, eDropOldestSample));
+    ChannelProducer producer(channel, 1000000);
+    producer.start();
+
+    QVector<RealTimeReading> samples;
+    int numTaken = 0;
+    double last = -1.0;
+    bool isValid = true;
+    bool isFinished = false;
+    while(!isFinished){
+        isFinished = producer.isFinished();
+        samples.resize(0);
+        numTaken += channel.takeAll(samples);
+
+        //samples are neither torn nor reordered
+        foreach(const RealTimeReading &sample, samples){
+            isValid = isValid && sample.type == eCartesianReading
+                    && sample.cartesian.y == sample.cartesian.x && sample.cartesian.z == sample.cartesian.x
+                    && sample.cartesian.x > last;
+            last = sample.cartesian.x;
+        }
+    }
+    producer.wait();
+
+    QVERIFY(isValid);
+
+    StreamStatistics statistics = channel.getStatistics();
+    QCOMPARE(statistics.produced, qint64(1000000));
+    QCOMPARE(statistics.delivered, qint64(numTaken));
+    QCOMPARE(statistics.delivered + statistics.dropped, statistics.produced);
+    QCOMPARE(last, 999999.0);
+    QVERIFY(producer.numNotifications > 0);
+
+}
+
+void SensorStreamTest::testVariantMapConversion(){
+
+    QVariantMap reading;
+    reading.insert("azimuth", 1.0);
+    reading.insert("zenith", 2.0);
+    reading.insert("distance", 3.0);
+
+    RealTimeReading sample;
+    QVERIFY(RealTimeReading::fromVariantMap(ePolarReading, reading, sample));
+    QCOMPARE(sample.type, ePolarReading);
+    QCOMPARE(sample.polar.azimuth, 1.0);
+    QCOMPARE(sample.polar.zenith, 2.0);
+    QCOMPARE(sample.polar.distance, 3.0);
+    QCOMPARE(sample.toVariantMap(), reading);
+
+    //missing values
+    QVERIFY(!RealTimeReading::fromVariantMap(eCartesianReading, reading, sample));
+    QVERIFY(!RealTimeReading::fromVariantMap(eUndefinedReading, reading, sample));
+    QVERIFY(sample.toVariantMap().isEmpty());
+
+    reading.clear();
+    reading.insert("x", 1.0);
+    reading.insert("y", 2.0);
+    reading.insert("z", 3.0);
+    reading.insert("i", 0.0);
+    reading.insert("j", 0.0);
+    reading.insert("k", 1.0);
+    QVERIFY(RealTimeReading::fromVariantMap(eCartesianReading6D, reading, sample));
+    QCOMPARE(sample.toVariantMap(), reading);
+
+}
+
+void SensorStreamTest::benchmarkReadingStream_data(){
+
+    QTest::addColumn<int>("rate");
+    QTest::addColumn<bool>("isTyped");
+
+    QTest::newRow("1 kHz, QVariantMap") << 1000 << false;
+    QTest::newRow("1 kHz, typed") << 1000 << true;
+    QTest::newRow("10 kHz, QVariantMap") << 10000 << false;
+    QTest::newRow("10 kHz, typed") << 10000 << true;
+
+}
+
+/*!
+ * \brief SensorStreamTest::benchmarkReadingStream
+ * One second of a polar reading stream at the given rate that is taken by the consumer at 60 Hz
+ */
+void SensorStreamTest::benchmarkReadingStream(){
+
+    QFETCH(int, rate);
+    QFETCH(bool, isTyped);
+
+    int consumerInterval = rate / 60;
+    qint64 numDelivered = 0;
+
+    if(isTyped){
+        RealTimeReadingChannel channel(StreamSettings(rate, 1024, eDropOldestSample));
+        QVector<RealTimeReading> samples;
+        samples.reserve(1024);
+        QBENCHMARK{
+            RealTimeReading sample;
+            sample.type = ePolarReading;
+            for(int i = 0; i < rate; i++){
+                sample.polar.azimuth = i;
+                sample.polar.zenith = i;
+                sample.polar.distance = i;
+                channel.push(sample);
+                if(i % consumerInterval == 0){
+                    samples.resize(0);
+                    numDelivered += channel.takeAll(samples);
+                }
+            }
+        }
+    }else{
+        StreamBuffer<QVariantMap> buffer(StreamSettings(rate, 1024, eDropOldestSample));
+        QBENCHMARK{
+            for(int i = 0; i < rate; i++){
+                QVariantMap reading;
+                reading.insert("azimuth", double(i));
+                reading.insert("zenith", double(i));
+                reading.insert("distance", double(i));
+                buffer.push(reading);
+                if(i % consumerInterval == 0){
+                    numDelivered += buffer.takeAll().size();
+                }
+            }
+        }
+    }
+
+    QVERIFY(numDelivered > 0);
+
+}
+
+QTEST_APPLESS_MAIN(SensorStreamTest)
+
+#include "tst_sensorstream.moc"
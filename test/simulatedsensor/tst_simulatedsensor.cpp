@@ -0,0 +1,338 @@
+#include <QString>
+#include <QtTest>
+#include <QSignalSpy>
+
+#include "simulatedsensor.h"
+#include "chooselalib.h"
+#include "point.h"
+#include "plane.h"
+#include "sphere.h"
+#include "cylinder.h"
+
+using namespace oi;
+
+class SimulatedSensorTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    SimulatedSensorTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testSurfaceReadings();
+    void testPolarReadings();
+    void testDeterminism();
+    void testNoise();
+    void testAsyncCommands();
+    void testStreamRate();
+    void benchmarkReadingStream();
+
+private:
+    SensorConfiguration createConfiguration(const Sensor &sensor, const ReadingTypes &type, const int &seed,
+                                            const Accuracy &accuracy, const int &readingsPerMeasurement = 1) const;
+};
+
+SimulatedSensorTest::SimulatedSensorTest()
+{
+}
+
+void SimulatedSensorTest::initTestCase(){
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+    qRegisterMetaType<QList<QPointer<Reading> > >("QList<QPointer<Reading> >");
+    qRegisterMetaType<RealTimeReading>("RealTimeReading");
+}
+
+SensorConfiguration SimulatedSensorTest::createConfiguration(const Sensor &sensor, const ReadingTypes &type, const int &seed,
+                                                             const Accuracy &accuracy, const int &readingsPerMeasurement) const{
+
+    SensorConfiguration sConfig = sensor.getSensorConfiguration();
+    sConfig.setAccuracy(accuracy);
+
+    QMap<QString, int> integerParameter = sConfig.getIntegerParameter();
+    integerParameter.insert("seed", seed);
+    integerParameter.insert("readings per measurement", readingsPerMeasurement);
+    sConfig.setIntegerParameter(integerParameter);
+
+    QMap<QString, QString> stringParameter = sConfig.getStringParameter();
+    stringParameter.insert("reading type", getReadingTypeName(type));
+    sConfig.setStringParameter(stringParameter);
+
+    return sConfig;
+
+}
+
+void SimulatedSensorTest::testSurfaceReadings(){
+
+    SimulatedLaserTracker tracker;
+    tracker.setSensorConfiguration(this->createConfiguration(tracker, eCartesianReading6D, 1, Accuracy(), 100));
+    QVERIFY(tracker.connectSensor());
+
+    //plane
+    Plane plane(false, Position(1.0, 2.0, 3.0), Direction(0.0, 0.6, 0.8));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&plane));
+    QCOMPARE(tracker.getSurface().getTypeOfFeature(), ePlaneFeature);
+    QList<QPointer<Reading> > readings = tracker.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), 100);
+    foreach(const QPointer<Reading> &reading, readings){
+        Vec3 xyz(reading->getCartesianReading6D().xyz);
+        QVERIFY(qAbs((xyz - Vec3(1.0, 2.0, 3.0)).dot(Vec3(0.0, 0.6, 0.8))) < 1.0e-12);
+        QVERIFY((Vec3(reading->getCartesianReading6D().ijk) - Vec3(0.0, 0.6, 0.8)).length() < 1.0e-12);
+    }
+    qDeleteAll(readings);
+
+    //sphere
+    Sphere sphere(false, Position(-1.0, 0.5, 2.0), Radius(0.25));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&sphere));
+    readings = tracker.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), 100);
+    foreach(const QPointer<Reading> &reading, readings){
+        Vec3 xyz(reading->getCartesianReading6D().xyz);
+        QVERIFY(qAbs((xyz - Vec3(-1.0, 0.5, 2.0)).length() - 0.25) < 1.0e-12);
+    }
+    qDeleteAll(readings);
+
+    //cylinder
+    Cylinder cylinder(false, Position(0.0, 0.0, 1.0), Direction(1.0, 0.0, 0.0), Radius(0.1));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&cylinder));
+    readings = tracker.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), 100);
+    foreach(const QPointer<Reading> &reading, readings){
+        Vec3 xyz(reading->getCartesianReading6D().xyz);
+        QVERIFY(qAbs(qSqrt(xyz.y() * xyz.y() + (xyz.z() - 1.0) * (xyz.z() - 1.0)) - 0.1) < 1.0e-12);
+        QVERIFY(qAbs(xyz.x()) <= 0.5);
+    }
+    qDeleteAll(readings);
+
+    //no readings without a supported surface
+    tracker.setSurface(SimulatedSurface());
+    QVERIFY(tracker.measure(MeasurementConfig()).isEmpty());
+
+}
+
+void SimulatedSensorTest::testPolarReadings(){
+
+    SimulatedTotalStation station;
+    station.setSensorConfiguration(this->createConfiguration(station, ePolarReading, 2, Accuracy(), 10));
+    Sphere sphere(false, Position(3.0, -4.0, 1.0), Radius(0.5));
+    station.setSurface(SimulatedSurface::fromGeometry(&sphere));
+
+    //no readings before the sensor is connected
+    QVERIFY(station.measure(MeasurementConfig()).isEmpty());
+    QVERIFY(station.connectSensor());
+
+    QList<QPointer<Reading> > readings = station.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), 10);
+    foreach(const QPointer<Reading> &reading, readings){
+        QCOMPARE(reading->getTypeOfReading(), ePolarReading);
+        Vec3 xyz(reading->getCartesianReading().xyz);
+        QVERIFY(qAbs((xyz - Vec3(3.0, -4.0, 1.0)).length() - 0.5) < 1.0e-9);
+    }
+    qDeleteAll(readings);
+
+    //the total station does not support 6D readings
+    station.setSensorConfiguration(this->createConfiguration(station, eCartesianReading6D, 2, Accuracy()));
+    readings = station.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), 1);
+    QCOMPARE(readings.first()->getTypeOfReading(), ePolarReading);
+    qDeleteAll(readings);
+
+}
+
+void SimulatedSensorTest::testDeterminism(){
+
+    Plane plane(false, Position(0.0, 0.0, 2.0), Direction(0.0, 0.0, 1.0));
+    SimulatedLaserTracker first, second, third;
+    first.setSensorConfiguration(this->createConfiguration(first, eCartesianReading, 7, first.getDefaultAccuracy(), 5));
+    second.setSensorConfiguration(this->createConfiguration(second, eCartesianReading, 7, second.getDefaultAccuracy(), 5));
+    third.setSensorConfiguration(this->createConfiguration(third, eCartesianReading, 8, third.getDefaultAccuracy(), 5));
+    first.setSurface(SimulatedSurface::fromGeometry(&plane));
+    second.setSurface(SimulatedSurface::fromGeometry(&plane));
+    third.setSurface(SimulatedSurface::fromGeometry(&plane));
+    QVERIFY(first.connectSensor());
+    QVERIFY(second.connectSensor());
+    QVERIFY(third.connectSensor());
+
+    //stream samples do not change the readings of the measurements
+    RealTimeReading sample;
+    QVERIFY(second.readingStreamSample(eCartesianReading, sample));
+
+    QList<QPointer<Reading> > firstReadings = first.measure(MeasurementConfig());
+    QList<QPointer<Reading> > secondReadings = second.measure(MeasurementConfig());
+    QList<QPointer<Reading> > thirdReadings = third.measure(MeasurementConfig());
+    QCOMPARE(firstReadings.size(), 5);
+    Vec3 firstReading(firstReadings.first()->getCartesianReading().xyz);
+    for(int i = 0; i < firstReadings.size(); i++){
+        Vec3 firstXyz(firstReadings.at(i)->getCartesianReading().xyz);
+        QCOMPARE(Vec3(secondReadings.at(i)->getCartesianReading().xyz), firstXyz);
+        QVERIFY(!(Vec3(thirdReadings.at(i)->getCartesianReading().xyz) == firstXyz));
+    }
+    qDeleteAll(firstReadings);
+    qDeleteAll(secondReadings);
+    qDeleteAll(thirdReadings);
+
+    //the next measurement continues the sequence
+    firstReadings = first.measure(MeasurementConfig());
+    QVERIFY(!(Vec3(firstReadings.first()->getCartesianReading().xyz) == firstReading));
+    qDeleteAll(firstReadings);
+
+}
+
+void SimulatedSensorTest::testNoise(){
+
+    //noise of a point is the deviation from the point
+    Point point(false, Position(1.0, 1.0, 1.0));
+    SimulatedLaserTracker tracker;
+    Accuracy accuracy;
+    accuracy.sigmaXyz.setAt(0, 1.0e-3);
+    accuracy.sigmaXyz.setAt(1, 2.0e-3);
+    accuracy.sigmaXyz.setAt(2, 3.0e-3);
+    const int numReadings = 20000;
+    tracker.setSensorConfiguration(this->createConfiguration(tracker, eCartesianReading, 3, accuracy, numReadings));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&point));
+    QVERIFY(tracker.connectSensor());
+
+    QList<QPointer<Reading> > readings = tracker.measure(MeasurementConfig());
+    QCOMPARE(readings.size(), numReadings);
+    Vec3 sum, sumSquares;
+    foreach(const QPointer<Reading> &reading, readings){
+        Vec3 v = Vec3(reading->getCartesianReading().xyz) - Vec3(1.0, 1.0, 1.0);
+        sum += v;
+        sumSquares += Vec3(v.x() * v.x(), v.y() * v.y(), v.z() * v.z());
+    }
+    qDeleteAll(readings);
+
+    for(int i = 0; i < 3; i++){
+        double mean = sum.getAt(i) / numReadings;
+        double sigma = qSqrt(sumSquares.getAt(i) / numReadings - mean * mean);
+        QVERIFY(qAbs(mean) < 0.05 * accuracy.sigmaXyz.getAt(i));
+        QVERIFY(qAbs(sigma / accuracy.sigmaXyz.getAt(i) - 1.0) < 0.03);
+    }
+
+}
+
+void SimulatedSensorTest::testAsyncCommands(){
+
+    SimulatedLaserTracker tracker;
+    SensorConfiguration sConfig = this->createConfiguration(tracker, eCartesianReading6D, 4, Accuracy(), 3);
+    QMap<QString, int> integerParameter = sConfig.getIntegerParameter();
+    integerParameter.insert("asynchronous", 1);
+    sConfig.setIntegerParameter(integerParameter);
+    tracker.setSensorConfiguration(sConfig);
+    QVERIFY(tracker.isSensorAsync());
+
+    Plane plane(false, Position(0.0, 0.0, 2.0), Direction(0.0, 0.0, 1.0));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&plane));
+
+    QSignalSpy responseSpy(&tracker, SIGNAL(asyncSensorResponse(QJsonObject)));
+    QSignalSpy measurementSpy(&tracker, SIGNAL(asyncMeasurementResult(int,QList<QPointer<Reading> >)));
+    QSignalSpy streamSpy(&tracker, SIGNAL(asyncStreamSample(RealTimeReading)));
+
+    //commands fail before the sensor is connected
+    QJsonObject request;
+    request.insert("method", "measure");
+    request.insert("geomId", 12);
+    request.insert("id", 1);
+    QCOMPARE(tracker.performAsyncSensorCommand(request).value("status").toString(), QString("accepted"));
+    QCOMPARE(responseSpy.count(), 1);
+    QVERIFY(responseSpy.last().first().toJsonObject().contains("error"));
+    QCOMPARE(measurementSpy.count(), 0);
+
+    //connect
+    request = QJsonObject();
+    request.insert("method", "connect");
+    request.insert("id", 2);
+    tracker.performAsyncSensorCommand(request);
+    QCOMPARE(responseSpy.count(), 2);
+    QCOMPARE(responseSpy.last().first().toJsonObject().value("id").toInt(), 2);
+    QVERIFY(responseSpy.last().first().toJsonObject().contains("result"));
+    QVERIFY(tracker.getConnectionState());
+
+    //measure
+    request = QJsonObject();
+    request.insert("method", "measure");
+    request.insert("geomId", 12);
+    tracker.performAsyncSensorCommand(request);
+    QCOMPARE(measurementSpy.count(), 1);
+    QCOMPARE(measurementSpy.last().at(0).toInt(), 12);
+    QList<QPointer<Reading> > readings = measurementSpy.last().at(1).value<QList<QPointer<Reading> > >();
+    QCOMPARE(readings.size(), 3);
+    QCOMPARE(readings.first()->getTypeOfReading(), eCartesianReading6D);
+    qDeleteAll(readings);
+
+    //stream
+    request = QJsonObject();
+    request.insert("method", "stream");
+    request.insert("format", getReadingTypeName(ePolarReading));
+    tracker.performAsyncSensorCommand(request);
+    QCOMPARE(streamSpy.count(), 1);
+    RealTimeReading sample = streamSpy.last().first().value<RealTimeReading>();
+    QCOMPARE(sample.type, ePolarReading);
+    QVERIFY(qAbs(sample.polar.distance * qCos(sample.polar.zenith) - 2.0) < 1.0e-9);
+
+    //sensor actions and unknown methods
+    request = QJsonObject();
+    request.insert("method", "move (cartesian)");
+    request.insert("x", 1.0);
+    request.insert("y", 2.0);
+    request.insert("z", 3.0);
+    tracker.performAsyncSensorCommand(request);
+    QVERIFY(responseSpy.last().first().toJsonObject().contains("result"));
+    request.insert("method", "dance");
+    tracker.performAsyncSensorCommand(request);
+    QVERIFY(responseSpy.last().first().toJsonObject().contains("error"));
+
+}
+
+void SimulatedSensorTest::testStreamRate(){
+
+    SimulatedLaserTracker tracker;
+    SensorConfiguration sConfig = this->createConfiguration(tracker, eCartesianReading, 5, tracker.getDefaultAccuracy());
+    QMap<QString, double> doubleParameter = sConfig.getDoubleParameter();
+    doubleParameter.insert("stream rate", 2000.0);
+    sConfig.setDoubleParameter(doubleParameter);
+    tracker.setSensorConfiguration(sConfig);
+
+    Sphere sphere(false, Position(1.0, 0.0, 0.0), Radius(0.1));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&sphere));
+    QVERIFY(tracker.connectSensor());
+
+    //the samples are paced to the stream rate
+    const int numSamples = 200;
+    QElapsedTimer timer;
+    timer.start();
+    RealTimeReading sample;
+    for(int i = 0; i < numSamples; i++){
+        QVERIFY(tracker.readingStreamSample(eCartesianReading, sample));
+    }
+    qint64 elapsed = timer.nsecsElapsed();
+    QVERIFY(elapsed >= (numSamples - 1) * 500000);
+    QVERIFY(elapsed < numSamples * 500000 * 10);
+
+    //the untyped stream uses the keys of the XML measurements
+    QVariantMap reading = tracker.readingStream(eCartesianReading);
+    QVERIFY(!reading.isEmpty());
+
+}
+
+void SimulatedSensorTest::benchmarkReadingStream(){
+
+    SimulatedLaserTracker tracker;
+    tracker.setSensorConfiguration(this->createConfiguration(tracker, eCartesianReading6D, 6, tracker.getDefaultAccuracy()));
+    Cylinder cylinder(false, Position(0.0, 0.0, 1.0), Direction(0.0, 1.0, 0.0), Radius(0.2));
+    tracker.setSurface(SimulatedSurface::fromGeometry(&cylinder));
+    QVERIFY(tracker.connectSensor());
+
+    RealTimeReading sample;
+    QBENCHMARK{
+        for(int i = 0; i < 10000; i++){
+            tracker.readingStreamSample(eCartesianReading6D, sample);
+        }
+    }
+    QCOMPARE(sample.type, eCartesianReading6D);
+
+}
+
+QTEST_GUILESS_MAIN(SimulatedSensorTest)
+
+#include "tst_simulatedsensor.moc"
@@ -1,6 +1,23 @@
 TEMPLATE = subdirs
 
-SUBDIRS = reading
+SUBDIRS = \
+    reading \
+    cylinderfit \
+    observationstore \
+    recalcscheduler \
+    inputelement \
+    sensorstream \
+    xmlstream \
+    observationsidecar \
+    featurecontainer \
+    oijob \
+    fixedmath \
+    readingconversion \
+    robustfit \
+    sensorcontrol \
+    acquisitionmanager \
+    simulatedsensor \
+    pointcloud
 
 INSTALLS =
 
@@ -10,13 +27,61 @@ QMAKE_EXTRA_TARGETS += run-test
 win32-msvc* {
 run-test.commands = \
     if not exist reports mkdir reports & if not exist reports exit 1 $$escape_expand(\n\t)\
-    cd $$shell_quote($$OUT_PWD/reading) && $(MAKE) run-test
+    cd $$shell_quote($$OUT_PWD/reading) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/cylinderfit) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/observationstore) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/recalcscheduler) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/inputelement) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/sensorstream) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/xmlstream) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/observationsidecar) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/featurecontainer) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/oijob) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/fixedmath) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/readingconversion) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/robustfit) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/sensorcontrol) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/acquisitionmanager) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/simulatedsensor) && $(MAKE) run-test $$escape_expand(\n\t)\
+    cd $$shell_quote($$OUT_PWD/pointcloud) && $(MAKE) run-test
 } else:win32-g++ {
 run-test.commands = \
     [ -e "reports" ] || mkdir reports ; \
-    $(MAKE) -C $$shell_quote($$OUT_PWD/reading) run-test
+    $(MAKE) -C $$shell_quote($$OUT_PWD/reading) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/cylinderfit) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/observationstore) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/recalcscheduler) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/inputelement) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/sensorstream) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/xmlstream) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/observationsidecar) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/featurecontainer) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/oijob) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/fixedmath) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/readingconversion) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/robustfit) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/sensorcontrol) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/acquisitionmanager) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/simulatedsensor) run-test ; \
+    $(MAKE) -C $$shell_quote($$OUT_PWD/pointcloud) run-test
 } else:linux {
 run-test.commands = \
     [ -e "reports" ] || mkdir reports ; \
-    $(MAKE) -C reading run-test ;
+    $(MAKE) -C reading run-test ; \
+    $(MAKE) -C cylinderfit run-test ; \
+    $(MAKE) -C observationstore run-test ; \
+    $(MAKE) -C recalcscheduler run-test ; \
+    $(MAKE) -C inputelement run-test ; \
+    $(MAKE) -C sensorstream run-test ; \
+    $(MAKE) -C xmlstream run-test ; \
+    $(MAKE) -C observationsidecar run-test ; \
+    $(MAKE) -C featurecontainer run-test ; \
+    $(MAKE) -C oijob run-test ; \
+    $(MAKE) -C fixedmath run-test ; \
+    $(MAKE) -C readingconversion run-test ; \
+    $(MAKE) -C robustfit run-test ; \
+    $(MAKE) -C sensorcontrol run-test ; \
+    $(MAKE) -C acquisitionmanager run-test ; \
+    $(MAKE) -C simulatedsensor run-test ; \
+    $(MAKE) -C pointcloud run-test ;
 }
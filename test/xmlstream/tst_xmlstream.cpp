@@ -0,0 +1,363 @@
+#include <QString>
+#include <QtTest>
+
+#include "chooselalib.h"
+#include "observation.h"
+#include "reading.h"
+#include "oijob.h"
+
+using namespace oi;
+
+class XmlStreamTest : public QObject
+{
+    Q_OBJECT
+
+public:
+    XmlStreamTest();
+
+private Q_SLOTS:
+    void initTestCase();
+    void testReadingSchema_data();
+    void testReadingSchema();
+    void testObservationStreamToDom();
+    void testObservationDomToStream();
+    void testJobStreamToDom();
+    void benchmarkWriteObservations();
+
+private:
+    QPointer<Observation> createObservation(const double &offset);
+    QByteArray writeStream(const QPointer<Observation> &observation);
+    QByteArray writeDom(const QPointer<Observation> &observation);
+    void compareElements(const QDomElement &expected, const QDomElement &actual);
+};
+
+XmlStreamTest::XmlStreamTest()
+{
+}
+
+void XmlStreamTest::initTestCase() {
+    ChooseLALib::setLinearAlgebra(ChooseLALib::Armadillo);
+}
+
+QPointer<Observation> XmlStreamTest::createObservation(const double &offset){
+
+    ReadingPolar polar;
+    polar.isValid = true;
+    polar.azimuth = 0.5 + offset;
+    polar.zenith = 1.25;
+    polar.distance = 10.125;
+    polar.sigmaAzimuth = 0.0001;
+    polar.sigmaZenith = 0.0002;
+    polar.sigmaDistance = 0.003;
+
+    QPointer<Observation> observation = new Observation();
+    QPointer<Reading> reading = new Reading(polar);
+    reading->setSensorFace(eFrontSide);
+    reading->setObservation(observation);
+
+    return observation;
+
+}
+
+QByteArray XmlStreamTest::writeStream(const QPointer<Observation> &observation){
+
+    QByteArray xml;
+    QXmlStreamWriter writer(&xml);
+    observation->toOpenIndyXML(writer);
+    return xml;
+
+}
+
+QByteArray XmlStreamTest::writeDom(const QPointer<Observation> &observation){
+
+    QDomDocument document;
+    document.appendChild(observation->toOpenIndyXML(document));
+    return document.toByteArray();
+
+}
+
+void XmlStreamTest::compareElements(const QDomElement &expected, const QDomElement &actual){
+
+    QCOMPARE(actual.tagName(), expected.tagName());
+
+    //same attributes with the same text (the order of attributes is not defined by QDom)
+    QDomNamedNodeMap expectedAttributes = expected.attributes();
+    QCOMPARE(actual.attributes().count(), expectedAttributes.count());
+    for(int i = 0; i < expectedAttributes.count(); i++){
+        QDomAttr attribute = expectedAttributes.item(i).toAttr();
+        QVERIFY2(actual.hasAttribute(attribute.name()), qPrintable(attribute.name()));
+        QCOMPARE(actual.attribute(attribute.name()), attribute.value());
+    }
+
+    //same child elements in the same order
+    QDomElement expectedChild = expected.firstChildElement();
+    QDomElement actualChild = actual.firstChildElement();
+    while(!expectedChild.isNull()){
+        QVERIFY(!actualChild.isNull());
+        this->compareElements(expectedChild, actualChild);
+        expectedChild = expectedChild.nextSiblingElement();
+        actualChild = actualChild.nextSiblingElement();
+    }
+    QVERIFY(actualChild.isNull());
+
+}
+
+void XmlStreamTest::testReadingSchema_data(){
+
+    QTest::addColumn<int>("type");
+
+    QTest::newRow("polar") << (int)ePolarReading;
+    QTest::newRow("cartesian6D") << (int)eCartesianReading6D;
+    QTest::newRow("level") << (int)eLevelReading;
+    QTest::newRow("temperature") << (int)eTemperatureReading;
+
+}
+
+void XmlStreamTest::testReadingSchema(){
+
+    QFETCH(int, type);
+
+    QPointer<Reading> reading;
+    switch(type){
+    case ePolarReading:{
+        ReadingPolar polar;
+        polar.isValid = true;
+        polar.azimuth = 0.1;
+        polar.zenith = 1.2;
+        polar.distance = 3.4;
+        reading = new Reading(polar);
+        break;
+    }case eCartesianReading6D:{
+        ReadingCartesian6D cartesian;
+        cartesian.isValid = true;
+        cartesian.xyz.setAt(0, 1.5);
+        cartesian.xyz.setAt(1, -2.25);
+        cartesian.xyz.setAt(2, 1.0 / 3.0);
+        cartesian.ijk.setAt(2, 1.0);
+        reading = new Reading(cartesian);
+        break;
+    }case eLevelReading:{
+        ReadingLevel level;
+        level.isValid = true;
+        level.k = 1.0;
+        level.sigmaI = 0.001;
+        reading = new Reading(level);
+        break;
+    }default:{
+        ReadingTemperature temperature;
+        temperature.isValid = true;
+        temperature.temperature = 20.5;
+        reading = new Reading(temperature);
+        break;
+    }
+    }
+
+    QDomDocument document;
+    QDomElement expected = reading->toOpenIndyXML(document);
+
+    QByteArray xml;
+    QXmlStreamWriter writer(&xml);
+    reading->toOpenIndyXML(writer);
+
+    QDomDocument streamed;
+    QVERIFY(streamed.setContent(xml));
+    this->compareElements(expected, streamed.documentElement());
+
+    //read the streamed reading back
+    QXmlStreamReader reader(xml);
+    QVERIFY(reader.readNextStartElement());
+    ReadingUndefined undefined;
+    QPointer<Reading> inReading = new Reading(undefined);
+    QVERIFY(inReading->fromOpenIndyXML(reader));
+    QVERIFY(reader.isEndElement());
+    QCOMPARE(inReading->getTypeOfReading(), reading->getTypeOfReading());
+    QCOMPARE(inReading->getId(), reading->getId());
+
+    delete reading.data();
+    delete inReading.data();
+
+}
+
+void XmlStreamTest::testObservationStreamToDom(){
+
+    QPointer<Observation> observation = this->createObservation(0.0);
+    QByteArray xml = this->writeStream(observation);
+
+    //the streamed observation has the same schema as the DOM observation
+    QDomDocument expected;
+    QVERIFY(expected.setContent(this->writeDom(observation)));
+    QDomDocument actual;
+    QVERIFY(actual.setContent(xml));
+    this->compareElements(expected.documentElement(), actual.documentElement());
+
+    //and can be loaded by the DOM reader
+    QDomElement element = actual.documentElement();
+    QPointer<Observation> inObservation = new Observation();
+    QVERIFY(inObservation->fromOpenIndyXML(element));
+    QCOMPARE(inObservation->getId(), observation->getId());
+    QVERIFY(!inObservation->getReading().isNull());
+    QCOMPARE(inObservation->getReading()->getPolarReading().azimuth, 0.5);
+    QCOMPARE(inObservation->getReading()->getPolarReading().distance, 10.125);
+    QCOMPARE(inObservation->getReading()->getFace(), eFrontSide);
+
+    delete observation.data();
+    delete inObservation.data();
+
+}
+
+void XmlStreamTest::testObservationDomToStream(){
+
+    QPointer<Observation> observation = this->createObservation(0.0);
+    QByteArray xml = this->writeDom(observation);
+
+    QXmlStreamReader reader(xml);
+    QVERIFY(reader.readNextStartElement());
+    QCOMPARE(reader.name().toString(), QString("observation"));
+    QPointer<Observation> inObservation = new Observation();
+    QVERIFY(inObservation->fromOpenIndyXML(reader));
+    QVERIFY(!reader.hasError());
+
+    QCOMPARE(inObservation->getId(), observation->getId());
+    QCOMPARE(inObservation->getIsValid(), observation->getIsValid());
+    QVERIFY(!inObservation->getReading().isNull());
+    QCOMPARE(inObservation->getReading()->getPolarReading().zenith, 1.25);
+    QCOMPARE(inObservation->getReading()->getPolarReading().sigmaDistance, 0.003);
+
+    //writing the loaded observation again gives the same document
+    QDomDocument expected;
+    QVERIFY(expected.setContent(xml));
+    QDomDocument actual;
+    QVERIFY(actual.setContent(this->writeStream(inObservation)));
+    this->compareElements(expected.documentElement(), actual.documentElement());
+
+    delete observation.data();
+    delete inObservation.data();
+
+}
+
+void XmlStreamTest::testJobStreamToDom(){
+
+    //job with a station whose system holds the observations of a plane
+    QPointer<OiJob> job = new OiJob();
+    FeatureAttributes stationAttributes;
+    stationAttributes.typeOfFeature = eStationFeature;
+    stationAttributes.name = "STATION";
+    QPointer<Station> station = job->addFeatures(stationAttributes).first()->getStation();
+    station->setActiveStationState(true);
+    FeatureAttributes planeAttributes;
+    planeAttributes.typeOfFeature = ePlaneFeature;
+    planeAttributes.name = "PLANE";
+    planeAttributes.isActual = true;
+    QPointer<FeatureWrapper> plane = job->addFeatures(planeAttributes).first();
+    QPointer<Function> function = new Function();
+    plane->getFeature()->addFunction(function);
+
+    QList<QPointer<Reading> > readings;
+    for(int i = 0; i < 50; i++){
+        ReadingPolar polar;
+        polar.isValid = true;
+        polar.azimuth = 0.01 * i;
+        polar.zenith = 1.5;
+        polar.distance = 5.0;
+        readings.append(new Reading(polar));
+    }
+    job->addMeasurementResults(plane->getFeature()->getId(), readings);
+    QPointer<CoordinateSystem> stationSystem = station->getCoordinateSystem();
+    QCOMPARE(stationSystem->getObservations().size(), 50);
+    foreach(const QPointer<Observation> &observation, stationSystem->getObservations()){
+        InputElement element(observation->getId());
+        element.typeOfElement = eObservationElement;
+        element.setElement(observation);
+        function->addInputElement(element, 0);
+    }
+
+    //the streamed station system has the same schema as the DOM station system
+    QDomDocument expectedSystem;
+    expectedSystem.appendChild(stationSystem->toOpenIndyXML(expectedSystem));
+    QByteArray systemXml;
+    QXmlStreamWriter systemWriter(&systemXml);
+    stationSystem->toOpenIndyXML(systemWriter);
+    QDomDocument actualSystem;
+    QVERIFY(actualSystem.setContent(systemXml));
+    this->compareElements(expectedSystem.documentElement(), actualSystem.documentElement());
+    QCOMPARE(actualSystem.documentElement().firstChildElement("observations").childNodes().count(), 50);
+
+    //the same holds for the function and its input elements
+    QDomDocument expectedFunction;
+    QDomElement functionElement = function->toOpenIndyXML(expectedFunction);
+    functionElement.setAttribute("executionIndex", 0);
+    expectedFunction.appendChild(functionElement);
+    QByteArray functionXml;
+    QXmlStreamWriter functionWriter(&functionXml);
+    function->toOpenIndyXML(functionWriter, 0);
+    QDomDocument actualFunction;
+    QVERIFY(actualFunction.setContent(functionXml));
+    this->compareElements(expectedFunction.documentElement(), actualFunction.documentElement());
+    QCOMPARE(actualFunction.documentElement().firstChildElement("inputElements").childNodes().count(), 50);
+
+    //the observations of the job are written one after the other and can be read back
+    QByteArray observationsXml;
+    QXmlStreamWriter observationsWriter(&observationsXml);
+    job->writeObservationsXML(observationsWriter);
+    QDomDocument actualObservations;
+    QVERIFY(actualObservations.setContent(observationsXml));
+    QDomElement actualObservation = actualObservations.documentElement().firstChildElement();
+    foreach(const QPointer<Observation> &observation, stationSystem->getObservations()){
+        QDomDocument expectedObservation;
+        QVERIFY(expectedObservation.setContent(this->writeDom(observation)));
+        QVERIFY(!actualObservation.isNull());
+        this->compareElements(expectedObservation.documentElement(), actualObservation);
+        actualObservation = actualObservation.nextSiblingElement();
+    }
+    QVERIFY(actualObservation.isNull());
+
+    QXmlStreamReader reader(observationsXml);
+    QVERIFY(reader.readNextStartElement());
+    QList<QPointer<Observation> > inObservations;
+    QVERIFY(OiJob::readObservationsXML(reader, inObservations));
+    QCOMPARE(inObservations.size(), 50);
+    for(int i = 0; i < inObservations.size(); i++){
+        QCOMPARE(inObservations.at(i)->getId(), stationSystem->getObservations().at(i)->getId());
+        QCOMPARE(inObservations.at(i)->getReading()->getPolarReading().azimuth, 0.01 * i);
+    }
+
+    foreach(const QPointer<Observation> &observation, inObservations){
+        delete observation.data();
+    }
+    delete job.data();
+
+}
+
+void XmlStreamTest::benchmarkWriteObservations(){
+
+    QList<QPointer<Observation> > observations;
+    for(int i = 0; i < 100000; i++){
+        observations.append(this->createObservation(i * 0.00001));
+    }
+
+    //the observations are written to the file one after the other without building a document
+    QBENCHMARK_ONCE{
+
+        QTemporaryFile file;
+        QVERIFY(file.open());
+        QXmlStreamWriter writer(&file);
+        writer.writeStartDocument();
+        writer.writeStartElement("observations");
+        foreach(const QPointer<Observation> &observation, observations){
+            observation->toOpenIndyXML(writer);
+        }
+        writer.writeEndElement();
+        writer.writeEndDocument();
+        QVERIFY(!writer.hasError());
+
+    }
+
+    foreach(const QPointer<Observation> &observation, observations){
+        delete observation.data();
+    }
+
+}
+
+QTEST_APPLESS_MAIN(XmlStreamTest)
+
+#include "tst_xmlstream.moc"